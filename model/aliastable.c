@@ -0,0 +1,214 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "aliastable.h"
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ###### Initialize ##################################################### */
+void aliasTableNew(struct AliasTable* aliasTable)
+{
+   aliasTable->Entries   = 0;
+   aliasTable->Capacity  = 0;
+   aliasTable->ValueSum  = 0;
+   aliasTable->Slot      = NULL;
+   aliasTable->Value     = NULL;
+   aliasTable->Element   = NULL;
+   aliasTable->Work      = NULL;
+}
+
+
+/* ###### Invalidate ##################################################### */
+void aliasTableDelete(struct AliasTable* aliasTable)
+{
+   free(aliasTable->Slot);
+   free(aliasTable->Value);
+   free(aliasTable->Element);
+   free(aliasTable->Work);
+   aliasTableNew(aliasTable);
+}
+
+
+/* ###### Remove all elements ############################################ */
+void aliasTableClear(struct AliasTable* aliasTable)
+{
+   aliasTable->Entries  = 0;
+   aliasTable->ValueSum = 0;
+}
+
+
+/* ###### Grow array to given capacity ################################### */
+static int aliasTableGrow(void** array, const size_t capacity, const size_t elementSize)
+{
+   void* newArray = realloc(*array, capacity * elementSize);
+   if(newArray == NULL) {
+      return(0);
+   }
+   *array = newArray;
+   return(1);
+}
+
+
+/* ###### Append element (aliasTableBuild() has to be called after) ###### */
+int aliasTableAppend(struct AliasTable*        aliasTable,
+                     void*                     element,
+                     const AliasTableValueType value)
+{
+   size_t newCapacity;
+
+   if(aliasTable->Entries >= aliasTable->Capacity) {
+      newCapacity = (aliasTable->Capacity > 0) ? (2 * aliasTable->Capacity) : 16;
+      if( (!aliasTableGrow((void**)&aliasTable->Slot, newCapacity, sizeof(struct AliasTableSlot))) ||
+          (!aliasTableGrow((void**)&aliasTable->Value, newCapacity, sizeof(AliasTableValueType))) ||
+          (!aliasTableGrow((void**)&aliasTable->Element, newCapacity, sizeof(void*))) ||
+          (!aliasTableGrow((void**)&aliasTable->Work, newCapacity, sizeof(size_t))) ) {
+         return(0);
+      }
+      aliasTable->Capacity = newCapacity;
+   }
+
+   aliasTable->Value[aliasTable->Entries]   = value;
+   aliasTable->Element[aliasTable->Entries] = element;
+   aliasTable->Entries++;
+   return(1);
+}
+
+
+/* ###### Compute thresholds and aliases from values in O(n) ############ */
+/*
+   Vose's method, scaled by the number of entries n: each slot covers a
+   share of ValueSum; slot i keeps n * Value[i] of it for element i and
+   gives the rest to the element Alias of the slot. Returns 0, if the
+   scaled value sum exceeds ALIASTABLE_MAX_SCALED_VALUESUM; the table must
+   not be used then.
+*/
+int aliasTableBuild(struct AliasTable* aliasTable)
+{
+   const size_t           n        = aliasTable->Entries;
+   struct AliasTableSlot* slot     = aliasTable->Slot;
+   AliasTableValueType    valueSum = 0;
+   size_t                 small    = 0;   /* Work[0 .. small - 1]: share < ValueSum   */
+   size_t                 large    = n;   /* Work[large .. n - 1]: share >= ValueSum  */
+   size_t                 i, s, l;
+
+   for(i = 0;i < n;i++) {
+      valueSum += aliasTable->Value[i];
+   }
+   if((n > 0) && (valueSum > ALIASTABLE_MAX_SCALED_VALUESUM / n)) {
+      return(0);
+   }
+   aliasTable->ValueSum = valueSum;
+
+   /* ====== Split elements into small and large ones ==================== */
+   for(i = 0;i < n;i++) {
+      slot[i].Threshold = aliasTable->Value[i] * n;
+      slot[i].Alias     = i;
+      if(slot[i].Threshold < valueSum) {
+         aliasTable->Work[small++] = i;
+      }
+      else {
+         aliasTable->Work[--large] = i;
+      }
+   }
+
+   /* ====== Fill each small slot up from a large element ================ */
+   while((small > 0) && (large < n)) {
+      s = aliasTable->Work[--small];
+      l = aliasTable->Work[large++];
+      slot[s].Alias      = l;
+      slot[l].Threshold -= valueSum - slot[s].Threshold;
+      if(slot[l].Threshold < valueSum) {
+         aliasTable->Work[small++] = l;
+      }
+      else {
+         aliasTable->Work[--large] = l;
+      }
+   }
+
+   /* ====== Remaining slots are full ==================================== */
+   while(small > 0) {
+      slot[aliasTable->Work[--small]].Threshold = valueSum;
+   }
+   while(large < n) {
+      slot[aliasTable->Work[large++]].Threshold = valueSum;
+   }
+   return(1);
+}
+
+
+/* ###### Verify structure ############################################### */
+/*
+   Each element's share, summed up over its own slot and the slots it is
+   the alias of, has to be n * Value[i] of the n * ValueSum in total.
+*/
+void aliasTableVerify(const struct AliasTable* aliasTable)
+{
+   const size_t         n = aliasTable->Entries;
+   AliasTableValueType* share;
+   AliasTableValueType  valueSum = 0;
+   size_t               i;
+
+   CHECK(n <= aliasTable->Capacity);
+   for(i = 0;i < n;i++) {
+      valueSum += aliasTable->Value[i];
+   }
+   CHECK(aliasTable->ValueSum == valueSum);
+   if((valueSum > 0) &&
+      ((share = (AliasTableValueType*)calloc(n, sizeof(AliasTableValueType))) != NULL)) {
+      for(i = 0;i < n;i++) {
+         CHECK(aliasTable->Slot[i].Threshold <= valueSum);
+         CHECK(aliasTable->Slot[i].Alias < n);
+         share[i]                         += aliasTable->Slot[i].Threshold;
+         share[aliasTable->Slot[i].Alias] += valueSum - aliasTable->Slot[i].Threshold;
+      }
+      for(i = 0;i < n;i++) {
+         CHECK(share[i] == aliasTable->Value[i] * n);
+      }
+      free(share);
+   }
+}
+
+
+/* ###### Get number of bytes allocated for the arrays ################### */
+size_t aliasTableGetMemoryUsage(const struct AliasTable* aliasTable)
+{
+   return(aliasTable->Capacity * (sizeof(struct AliasTableSlot) +
+                                  sizeof(AliasTableValueType) +
+                                  sizeof(void*) +
+                                  sizeof(size_t)));
+}
+
+
+#ifdef __cplusplus
+}
+#endif
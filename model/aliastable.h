@@ -0,0 +1,124 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef ALIASTABLE_H
+#define ALIASTABLE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Alias table (Walker/Vose) over the values of a fixed sequence of
+   elements: draws an element with probability value / value sum in O(1).
+   The sequence is (re-)filled by aliasTableClear() and aliasTableAppend(),
+   followed by aliasTableBuild() in O(n). The table is built in integer
+   arithmetic, i.e. the probabilities are exact. A draw uses one 64-bit
+   random number for both the slot and the threshold; aliasTableBuild()
+   therefore refuses tables with elements * value sum above
+   ALIASTABLE_MAX_SCALED_VALUESUM, which keeps the modulo bias of the
+   threshold below 2^-16.
+*/
+typedef unsigned long long AliasTableValueType;
+
+#define ALIASTABLE_MAX_SCALED_VALUESUM (1ULL << 48)
+
+struct AliasTableSlot
+{
+   AliasTableValueType Threshold;     /* Keep element i if draw < Threshold ...  */
+   size_t              Alias;         /* ... else take element Alias             */
+};
+
+struct AliasTable
+{
+   size_t                 Entries;
+   size_t                 Capacity;
+   AliasTableValueType    ValueSum;
+   struct AliasTableSlot* Slot;       /* Slot[i] of element i                    */
+   AliasTableValueType*   Value;      /* Value[i] of element i                   */
+   void**                 Element;    /* Element[i] is the i-th element          */
+   size_t*                Work;       /* Scratch space for aliasTableBuild()     */
+};
+
+
+void aliasTableNew(struct AliasTable* aliasTable);
+void aliasTableDelete(struct AliasTable* aliasTable);
+void aliasTableClear(struct AliasTable* aliasTable);
+int aliasTableAppend(struct AliasTable*        aliasTable,
+                     void*                     element,
+                     const AliasTableValueType value);
+int aliasTableBuild(struct AliasTable* aliasTable);
+void aliasTableVerify(const struct AliasTable* aliasTable);
+size_t aliasTableGetMemoryUsage(const struct AliasTable* aliasTable);
+
+inline static size_t aliasTableGetEntries(const struct AliasTable* aliasTable)
+{
+   return(aliasTable->Entries);
+}
+
+inline static AliasTableValueType aliasTableGetValueSum(const struct AliasTable* aliasTable)
+{
+   return(aliasTable->ValueSum);
+}
+
+inline static AliasTableValueType aliasTableGetValue(const struct AliasTable* aliasTable,
+                                                     const size_t             index)
+{
+   return(aliasTable->Value[index]);
+}
+
+inline static void* aliasTableGetElement(const struct AliasTable* aliasTable,
+                                         const size_t             index)
+{
+   return(aliasTable->Element[index]);
+}
+
+/* Draw an element index, given a uniformly distributed random number.
+   The value sum must be greater than 0. */
+inline static size_t aliasTableDraw(const struct AliasTable* aliasTable,
+                                    const unsigned long long random)
+{
+   const size_t                 index = (size_t)(random % aliasTable->Entries);
+   const struct AliasTableSlot* slot  = &aliasTable->Slot[index];
+   if(((random / aliasTable->Entries) % aliasTable->ValueSum) < slot->Threshold) {
+      return(index);
+   }
+   return(slot->Alias);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -81,7 +81,7 @@ class AttackerProcess : public StatisticsWriterInterface,
    // ====== Private methods ================================================
    void sendASAPEndpointUnreachable(const unsigned int        registrarAddress,
                                     const unsigned int        registrarPort,
-                                    const char*               poolHandle,
+                                    const unsigned int        poolHandleID,
                                     PoolElementIdentifierType identifier);
 
    // ====== Private data ===================================================
@@ -98,7 +98,7 @@ class AttackerProcess : public StatisticsWriterInterface,
    cPeerList*                 TargetRegistrarTable;
    PoolElementIdentifierType  TargetIdentifier;
 
-   opp_string                 VictimPoolHandle;
+   unsigned int               VictimPoolHandleID;
    size_t                     VictimPoolElements;
    PoolElementIdentifierType* VictimPoolElementList;
    bool                       GotHandleResolutionResponse;
@@ -131,6 +131,7 @@ void AttackerProcess::initialize()
    RestartDelayTimer           = NULL;
    NextAttackTimer             = NULL;
 
+   VictimPoolHandleID          = 0;
    VictimPoolElements          = 0;
    VictimPoolElementList       = NULL;
    GotHandleResolutionResponse = false;
@@ -141,7 +142,7 @@ void AttackerProcess::initialize()
    TargetIdentifier            = (PoolElementIdentifierType)rint(uniform(1, 0xffffffff));
 
    // ------ Create registrar table -----------------------------------------
-   TargetRegistrarTable = new cPeerList(NULL, 0);
+   TargetRegistrarTable = cPeerList::create(DEFAULT_HANDLESPACE_BACKEND, 0);
    OPP_CHECK(TargetRegistrarTable);
 
    const char*  staticRegistrarsList = par("attackTargetRegistrarsList");
@@ -319,7 +320,7 @@ void AttackerProcess::handleNextAttackTimer()
             EV << "Sending endpoint unreachable for PE #"
                << VictimPoolElementList[i] << "..." << endl;
             sendASAPEndpointUnreachable(targetRegistrarAddress, RegistrarPort,
-                                        VictimPoolHandle.c_str(), VictimPoolElementList[i]);
+                                        VictimPoolHandleID, VictimPoolElementList[i]);
          }
       }
 
@@ -399,7 +400,7 @@ void AttackerProcess::handleNextAttackTimer()
 // ###### Send ASAP_ENDPOINT_UNREACHABLE ####################################
 void AttackerProcess::sendASAPEndpointUnreachable(const unsigned int        registrarAddress,
                                                   const unsigned int        registrarPort,
-                                                  const char*               poolHandle,
+                                                  const unsigned int        poolHandleID,
                                                   PoolElementIdentifierType identifier)
 {
    ASAPEndpointUnreachable* endpointUnreachable = new ASAPEndpointUnreachable("ASAP_ENDPOINT_UNREACHABLE", ASAP);
@@ -407,7 +408,7 @@ void AttackerProcess::sendASAPEndpointUnreachable(const unsigned int        regi
    endpointUnreachable->setDstAddress(registrarAddress);
    endpointUnreachable->setSrcPort(AttackerPort);
    endpointUnreachable->setDstPort(registrarPort);
-   endpointUnreachable->setPoolHandle(poolHandle);
+   endpointUnreachable->setPoolHandleID(poolHandleID);
    endpointUnreachable->setIdentifier(identifier);
 
    endpointUnreachable->setTimestamp(simTime());
@@ -419,7 +420,7 @@ void AttackerProcess::sendASAPEndpointUnreachable(const unsigned int        regi
 void AttackerProcess::handleASAPHandleResolutionResponse(ASAPHandleResolutionResponse* msg)
 {
    if(!msg->getRejectFlag()) {
-     VictimPoolHandle = msg->getPoolHandle();
+     VictimPoolHandleID = getMessagePoolHandleID(msg);
      if(VictimPoolElementList) {
         delete VictimPoolElementList;
      }
@@ -438,7 +439,7 @@ void AttackerProcess::handleASAPHandleResolutionResponse(ASAPHandleResolutionRes
             EV << "Sending endpoint unreachable for PE #"
                << msg->getPoolElementParameter(i).getIdentifier() << "..." << endl;
             sendASAPEndpointUnreachable(msg->getSrcAddress(), AttackerPort,
-                                        msg->getPoolHandle(),
+                                        VictimPoolHandleID,
                                         msg->getPoolElementParameter(i).getIdentifier());
 
             ASAPEndpointUnreachable* endpointUnreachable = new ASAPEndpointUnreachable("ASAP_ENDPOINT_UNREACHABLE", ASAP);
@@ -446,7 +447,7 @@ void AttackerProcess::handleASAPHandleResolutionResponse(ASAPHandleResolutionRes
             endpointUnreachable->setDstAddress(msg->getSrcAddress());
             endpointUnreachable->setSrcPort(AttackerPort);
             endpointUnreachable->setDstPort(msg->getSrcPort());
-            endpointUnreachable->setPoolHandle(msg->getPoolHandle());
+            endpointUnreachable->setPoolHandleID(VictimPoolHandleID);
             endpointUnreachable->setIdentifier(msg->getPoolElementParameter(i).getIdentifier());
 
             endpointUnreachable->setTimestamp(simTime());
@@ -479,7 +480,7 @@ void AttackerProcess::handleASAPEndpointKeepAlive(ASAPEndpointKeepAlive* msg)
       endpointKeepAliveAck->setDstAddress(msg->getSrcAddress());
       endpointKeepAliveAck->setSrcPort(AttackerPort);
       endpointKeepAliveAck->setDstPort(msg->getSrcPort());
-      endpointKeepAliveAck->setPoolHandle(msg->getPoolHandle());
+      endpointKeepAliveAck->setPoolHandleID(getMessagePoolHandleID(msg));
       endpointKeepAliveAck->setIdentifier(msg->getIdentifier());
 
       endpointKeepAliveAck->setTimestamp(simTime());
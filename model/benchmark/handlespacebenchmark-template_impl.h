@@ -0,0 +1,1451 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+/*
+   This file is included once per storage backend by handlespacebenchmark.cc,
+   with ST_CLASS(x) set to the backend's class name suffix.
+*/
+
+
+/* ###### Create benchmark handlespace ################################### */
+/* With -aliastable, the pools of all supporting policies use alias tables */
+static void ST_CLASS(newBenchmarkHandlespace)(
+               struct ST_CLASS(PoolHandlespaceManagement)* handlespace,
+               const BenchmarkParameters&                  parameters)
+{
+   ST_CLASS(poolHandlespaceManagementNew)(handlespace, 1, NULL, NULL, NULL);
+   if(parameters.AliasTable) {
+      for(size_t i = 0;i < ST_CLASS(PoolPolicies);i++) {
+         ST_CLASS(poolHandlespaceManagementSetAliasTableSelection)(
+            handlespace, ST_CLASS(PoolPolicyArray)[i].Type, 1);
+      }
+   }
+}
+
+
+/* ###### Register pool element of given slot ############################ */
+static void ST_CLASS(registerBenchmarkPoolElement)(
+               struct ST_CLASS(PoolHandlespaceManagement)* handlespace,
+               const struct PoolHandle*                    poolHandle,
+               const unsigned int                          policyType,
+               const size_t                                slot,
+               const PoolElementIdentifierType             identifier,
+               const unsigned long long                    expiryTimeout,
+               const unsigned long long                    currentTimeStamp,
+               struct ST_CLASS(PoolElementNode)**          poolElementNode,
+               LatencyStatistics&                          registrationStatistics,
+               LatencyStatistics&                          timerStatistics,
+               const RegistrarIdentifierType               homeRegistrarIdentifier = 1,
+               const struct PoolPolicySettings*            fixedPoolPolicySettings = NULL)
+{
+   struct sockaddr_testaddr address;
+   memset(&address, 0, sizeof(address));
+   address.ta_family = AF_TEST;
+   address.ta_addr   = (unsigned int)slot + 1;
+   address.ta_port   = 1;
+
+   char userTransportBuffer[transportAddressBlockGetSize(1)];
+   struct TransportAddressBlock* userTransport = (struct TransportAddressBlock*)&userTransportBuffer;
+   transportAddressBlockNew(userTransport,
+                            IPPROTO_SCTP, 1, TABF_CONTROLCHANNEL,
+                            (union sockaddr_union*)&address, 1, 1);
+
+   char registratorTransportBuffer[transportAddressBlockGetSize(1)];
+   struct TransportAddressBlock* registratorTransport = (struct TransportAddressBlock*)&registratorTransportBuffer;
+   transportAddressBlockNew(registratorTransport,
+                            IPPROTO_SCTP, 1, 0,
+                            (union sockaddr_union*)&address, 1, 1);
+
+   struct PoolPolicySettings poolPolicySettings;
+   if(fixedPoolPolicySettings != NULL) {
+      poolPolicySettings = *fixedPoolPolicySettings;
+   }
+   else {
+      poolPolicySettingsNew(&poolPolicySettings);
+      poolPolicySettings.Weight          = 1 + (unsigned int)(workloadRandom() % 1000);
+      poolPolicySettings.Load            = workloadLoad();
+      poolPolicySettings.LoadDegradation = (unsigned int)(workloadRandom() % 0x10000000);
+      poolPolicySettings.LoadDPF         = (unsigned int)(workloadRandom() % 0x10000000);
+      poolPolicySettings.WeightDPF       = (unsigned int)(workloadRandom() % 0x10000000);
+   }
+   poolPolicySettings.PolicyType = policyType;
+
+   unsigned long long startTimeStamp = getNanoTime();
+   const unsigned int result =
+      ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
+         handlespace, poolHandle,
+         homeRegistrarIdentifier, identifier, 30000,
+         &poolPolicySettings,
+         userTransport, registratorTransport,
+         -1, 0,
+         currentTimeStamp,
+         poolElementNode);
+   registrationStatistics.add(getNanoTime() - startTimeStamp);
+   CHECK(result == RSPERR_OKAY);
+
+   startTimeStamp = getNanoTime();
+   ST_CLASS(poolHandlespaceManagementRestartPoolElementExpiryTimer)(
+      handlespace, *poolElementNode, expiryTimeout);
+   timerStatistics.add(getNanoTime() - startTimeStamp);
+}
+
+
+/* ###### Create pool handles ############################################ */
+static void ST_CLASS(createBenchmarkPoolHandles)(const char*                     poolNamePrefix,
+                                                 std::vector<struct PoolHandle>& poolHandleArray)
+{
+   for(size_t i = 0;i < poolHandleArray.size();i++) {
+      char poolName[48];
+      snprintf(poolName, sizeof(poolName), "%s-%zu", poolNamePrefix, i);
+      poolHandleNew(&poolHandleArray[i], (const unsigned char*)poolName, strlen(poolName));
+   }
+}
+
+
+/* ###### Register pool elements of all slots ############################ */
+/*
+   Slot i belongs to pool i / PoolElementsPerPool and gets the PE ID i + 1.
+   The pools use the policies in the order of ST_CLASS(PoolPolicyArray).
+   The home PR is 1, unless given per slot by homeRegistrarArray.
+*/
+static void ST_CLASS(registerBenchmarkPoolElements)(
+               struct ST_CLASS(PoolHandlespaceManagement)*     handlespace,
+               const BenchmarkParameters&                      parameters,
+               const std::vector<struct PoolHandle>&           poolHandleArray,
+               std::vector<struct ST_CLASS(PoolElementNode)*>& poolElementNodeArray,
+               LatencyStatistics&                              registrationStatistics,
+               LatencyStatistics&                              timerStatistics,
+               const unsigned long long                        expiryTimeout           = 1000000000,
+               const unsigned long long                        currentTimeStamp        = 1000000,
+               const std::vector<RegistrarIdentifierType>*     homeRegistrarArray      = NULL,
+               const struct PoolPolicySettings*                fixedPoolPolicySettings = NULL)
+{
+   for(size_t slot = 0;slot < poolElementNodeArray.size();slot++) {
+      const size_t pool = slot / parameters.PoolElementsPerPool;
+      CHECK(pool < poolHandleArray.size());
+      ST_CLASS(registerBenchmarkPoolElement)(
+         handlespace, &poolHandleArray[pool],
+         ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+         slot, slot + 1, expiryTimeout, currentTimeStamp,
+         &poolElementNodeArray[slot],
+         registrationStatistics, timerStatistics,
+         (homeRegistrarArray != NULL) ? (*homeRegistrarArray)[slot] : 1,
+         fixedPoolPolicySettings);
+   }
+}
+
+
+/* ###### Run draw benchmark ############################################# */
+/*
+   Draw throughput of single-item WeightedRandom handle resolutions, for
+   one pool of 10, 100, ... pool elements. In the churning case, a random
+   pool element of the pool is re-registered with a new weight before
+   every draw.
+*/
+static void ST_CLASS(runDrawBenchmark)(const BenchmarkParameters& parameters)
+{
+   struct PoolHandle poolHandle;
+   poolHandleNew(&poolHandle, (const unsigned char*)"DrawPool", 8);
+
+   for(size_t poolElements = 10;poolElements <= parameters.MaxDrawPoolElements;poolElements *= 10) {
+      struct ST_CLASS(PoolHandlespaceManagement) handlespace;
+      ST_CLASS(newBenchmarkHandlespace)(&handlespace, parameters);
+
+      std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(poolElements, NULL);
+      LatencyStatistics                              registrationStatistics;
+      LatencyStatistics                              timerStatistics;
+      for(size_t slot = 0;slot < poolElements;slot++) {
+         ST_CLASS(registerBenchmarkPoolElement)(
+            &handlespace, &poolHandle, PPT_WEIGHTED_RANDOM,
+            slot, slot + 1, 1000000000, 1000000,
+            &poolElementNodeArray[slot],
+            registrationStatistics, timerStatistics);
+      }
+
+      for(unsigned int churning = 0;churning <= 1;churning++) {
+         LatencyStatistics drawStatistics;
+         for(size_t i = 0;i < parameters.Draws;i++) {
+            if(churning) {
+               const size_t slot = workloadRandom() % poolElements;
+               ST_CLASS(registerBenchmarkPoolElement)(
+                  &handlespace, &poolHandle, PPT_WEIGHTED_RANDOM,
+                  slot, slot + 1, 1000000000, 1000000,
+                  &poolElementNodeArray[slot],
+                  registrationStatistics, timerStatistics);
+            }
+
+            struct ST_CLASS(PoolElementNode)* poolElementNode;
+            size_t                            items;
+            const unsigned long long startTimeStamp = getNanoTime();
+            ST_CLASS(poolHandlespaceManagementHandleResolution)(
+               &handlespace, &poolHandle, &poolElementNode, &items, 1, 1);
+            drawStatistics.add(getNanoTime() - startTimeStamp);
+            CHECK(items == 1);
+         }
+
+         char name[128];
+         snprintf(name, sizeof(name), "Draw/WeightedRandom, %zu PEs%s",
+                  poolElements, (churning) ? ", churning" : "");
+         drawStatistics.print(name);
+      }
+
+      ST_CLASS(poolHandlespaceManagementDelete)(&handlespace);
+   }
+}
+
+
+/* ###### Reader thread of the concurrent benchmark ###################### */
+static void ST_CLASS(runConcurrentReader)(struct PoolHandlespaceViewPublisher*  publisher,
+                                          const std::vector<struct PoolHandle>* poolHandleArray,
+                                          const size_t                          maxHandleResolutionItems,
+                                          const unsigned long long              seed,
+                                          const std::atomic<bool>*              stop,
+                                          ConcurrentReaderResult*               result)
+{
+   std::vector<const struct PoolElementView*> selectionArray(maxHandleResolutionItems);
+   unsigned long long                         randomState = seed;
+   unsigned long long                         resolutions = 0;
+
+   const int readerID = poolHandlespaceViewPublisherRegisterReader(publisher);
+   CHECK(readerID >= 0);
+   const unsigned long long startTimeStamp = getNanoTime();
+   while(!stop->load(std::memory_order_relaxed)) {
+      const size_t pool = poolHandlespaceViewRandom(&randomState) % poolHandleArray->size();
+      const struct PoolHandlespaceView* poolHandlespaceView =
+         poolHandlespaceViewPublisherEnter(publisher, readerID);
+      const size_t items = poolHandlespaceViewHandleResolution(
+                              poolHandlespaceView, &(*poolHandleArray)[pool],
+                              &selectionArray[0], maxHandleResolutionItems,
+                              &randomState);
+      poolHandlespaceViewPublisherLeave(publisher, readerID);
+      CHECK(items > 0);
+      resolutions++;
+   }
+   result->Duration    = getNanoTime() - startTimeStamp;
+   result->Resolutions = resolutions;
+   poolHandlespaceViewPublisherUnregisterReader(publisher, readerID);
+}
+
+
+/* ###### Reader thread of the locked baseline ########################## */
+static void ST_CLASS(runLockedReader)(struct ST_CLASS(PoolHandlespaceManagement)* handlespace,
+                                      std::mutex*                                 handlespaceMutex,
+                                      const std::vector<struct PoolHandle>*       poolHandleArray,
+                                      const size_t                                maxHandleResolutionItems,
+                                      const unsigned long long                    seed,
+                                      const std::atomic<bool>*                    stop,
+                                      ConcurrentReaderResult*                     result)
+{
+   std::vector<struct ST_CLASS(PoolElementNode)*> selectionArray(maxHandleResolutionItems);
+   unsigned long long                             randomState = seed;
+   unsigned long long                             resolutions = 0;
+   size_t                                         items;
+
+   const unsigned long long startTimeStamp = getNanoTime();
+   while(!stop->load(std::memory_order_relaxed)) {
+      const size_t pool = poolHandlespaceViewRandom(&randomState) % poolHandleArray->size();
+      handlespaceMutex->lock();
+      ST_CLASS(poolHandlespaceManagementHandleResolution)(
+         handlespace, &(*poolHandleArray)[pool],
+         &selectionArray[0], &items, maxHandleResolutionItems, 0);
+      handlespaceMutex->unlock();
+      CHECK(items > 0);
+      resolutions++;
+   }
+   result->Duration    = getNanoTime() - startTimeStamp;
+   result->Resolutions = resolutions;
+}
+
+
+/* ###### Run concurrent benchmark ####################################### */
+/*
+   Handle resolution throughput of 1, 2, 4, ... reader threads on the
+   published views, while the benchmark thread as writer re-registers
+   pool elements and publishes a new view after every BurstSize changes.
+   As baseline, the same readers then resolve on the handlespace itself,
+   serialised with the writer's bursts of changes by a mutex. The view
+   readers do not apply the policies' per-selection updates, i.e. they
+   do less work than the locked ones. The rates only show scaling if
+   there are more CPUs than reader threads plus the writer.
+*/
+static void ST_CLASS(runConcurrentBenchmark)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement) handlespace;
+   ST_CLASS(poolHandlespaceManagementNew)(&handlespace, 1, NULL, NULL, NULL);
+
+   const size_t                                   poolElements = parameters.Pools * parameters.PoolElementsPerPool;
+   std::vector<struct PoolHandle>                 poolHandleArray(parameters.Pools);
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(poolElements, NULL);
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+
+   ST_CLASS(createBenchmarkPoolHandles)("BenchmarkPool", poolHandleArray);
+   ST_CLASS(registerBenchmarkPoolElements)(&handlespace, parameters, poolHandleArray, poolElementNodeArray,
+                                           registrationStatistics, timerStatistics);
+   CHECK(ST_CLASS(poolHandlespaceManagementEnableConcurrentReaders)(&handlespace));
+   struct PoolHandlespaceViewPublisher* publisher =
+      ST_CLASS(poolHandlespaceManagementGetViewPublisher)(&handlespace);
+
+   const size_t changesPerView = (parameters.BurstSize > 0) ? parameters.BurstSize : 1;
+   for(size_t readers = 1;;readers = std::min(2 * readers, parameters.ReaderThreads)) {
+      std::vector<ConcurrentReaderResult> resultArray(readers);
+      std::vector<std::thread>            threadArray;
+      std::atomic<bool>                   stop(false);
+      for(size_t i = 0;i < readers;i++) {
+         threadArray.push_back(std::thread(ST_CLASS(runConcurrentReader),
+                                           publisher, &poolHandleArray,
+                                           parameters.MaxHandleResolutionItems,
+                                           parameters.Seed + i + 1,
+                                           &stop, &resultArray[i]));
+      }
+
+      // ====== Writer: re-register pool elements and publish views ========
+      LatencyStatistics publishStatistics;
+      const unsigned long long endTimeStamp = getNanoTime() + parameters.ReaderDuration;
+      while(getNanoTime() < endTimeStamp) {
+         for(size_t i = 0;i < changesPerView;i++) {
+            const size_t slot = workloadRandom() % poolElements;
+            const size_t pool = slot / parameters.PoolElementsPerPool;
+            ST_CLASS(registerBenchmarkPoolElement)(
+               &handlespace, &poolHandleArray[pool],
+               ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+               slot, slot + 1, 1000000000, 1000000,
+               &poolElementNodeArray[slot],
+               registrationStatistics, timerStatistics);
+         }
+         const unsigned long long startTimeStamp = getNanoTime();
+         CHECK(ST_CLASS(poolHandlespaceManagementPublishView)(&handlespace));
+         publishStatistics.add(getNanoTime() - startTimeStamp);
+      }
+      stop.store(true);
+
+      unsigned long long resolutions = 0;
+      double             rate        = 0.0;
+      for(size_t i = 0;i < readers;i++) {
+         threadArray[i].join();
+         resolutions += resultArray[i].Resolutions;
+         rate        += (1000000000.0 * resultArray[i].Resolutions) / (double)resultArray[i].Duration;
+      }
+      ST_CLASS(poolHandlespaceManagementVerify)(&handlespace);
+
+      char name[128];
+      snprintf(name, sizeof(name), "PublishView (%zu changes), %zu readers", changesPerView, readers);
+      publishStatistics.print(name);
+      snprintf(name, sizeof(name), "HandleResolution on view, %zu readers", readers);
+      printf("%-56s %10llu %12.0f\n", name, resolutions, rate);
+
+      // ====== Baseline: readers on the handlespace, locked ===============
+      std::mutex handlespaceMutex;
+      threadArray.clear();
+      stop.store(false);
+      for(size_t i = 0;i < readers;i++) {
+         threadArray.push_back(std::thread(ST_CLASS(runLockedReader),
+                                           &handlespace, &handlespaceMutex,
+                                           &poolHandleArray,
+                                           parameters.MaxHandleResolutionItems,
+                                           parameters.Seed + i + 1,
+                                           &stop, &resultArray[i]));
+      }
+      const unsigned long long lockedEndTimeStamp = getNanoTime() + parameters.ReaderDuration;
+      while(getNanoTime() < lockedEndTimeStamp) {
+         handlespaceMutex.lock();
+         for(size_t i = 0;i < changesPerView;i++) {
+            const size_t slot = workloadRandom() % poolElements;
+            const size_t pool = slot / parameters.PoolElementsPerPool;
+            ST_CLASS(registerBenchmarkPoolElement)(
+               &handlespace, &poolHandleArray[pool],
+               ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+               slot, slot + 1, 1000000000, 1000000,
+               &poolElementNodeArray[slot],
+               registrationStatistics, timerStatistics);
+         }
+         handlespaceMutex.unlock();
+      }
+      stop.store(true);
+
+      resolutions = 0;
+      rate        = 0.0;
+      for(size_t i = 0;i < readers;i++) {
+         threadArray[i].join();
+         resolutions += resultArray[i].Resolutions;
+         rate        += (1000000000.0 * resultArray[i].Resolutions) / (double)resultArray[i].Duration;
+      }
+      ST_CLASS(poolHandlespaceManagementVerify)(&handlespace);
+      snprintf(name, sizeof(name), "HandleResolution locked, %zu readers", readers);
+      printf("%-56s %10llu %12.0f\n", name, resolutions, rate);
+      if(readers == parameters.ReaderThreads) {
+         break;
+      }
+   }
+
+   ST_CLASS(poolHandlespaceManagementDelete)(&handlespace);
+}
+
+
+/* ###### Worker thread of the sharded benchmark ######################### */
+/*
+   Each worker re-registers its own pool elements (the slots of index
+   thread modulo threads) and performs handle resolutions, 1 in 4
+   operations being a re-registration.
+*/
+static void ST_CLASS(runShardedWorker)(struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedHandlespace,
+                                       const std::vector<struct PoolHandle>*              poolHandleArray,
+                                       std::vector<struct ST_CLASS(PoolElementNode)*>*    poolElementNodeArray,
+                                       const BenchmarkParameters*                         parameters,
+                                       const size_t                                       thread,
+                                       const size_t                                       threads,
+                                       const std::atomic<bool>*                           stop,
+                                       ShardedWorkerResult*                               result)
+{
+   std::vector<struct ST_CLASS(PoolElementNode)*> selectionArray(parameters->MaxHandleResolutionItems);
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   unsigned long long                             operations = 0;
+
+   WorkloadRandomState    = parameters->Seed + thread + 1;
+   HandlespaceRandomState = parameters->Seed + thread + 1;
+   const size_t slotsPerThread = (poolElementNodeArray->size() + threads - 1) / threads;
+   const unsigned long long startTimeStamp = getNanoTime();
+   while(!stop->load(std::memory_order_relaxed)) {
+      const unsigned long long value = workloadRandom();
+      if((value & 3) == 0) {
+         const size_t slot = thread + threads * ((value >> 2) % slotsPerThread);
+         if(slot >= poolElementNodeArray->size()) {
+            continue;
+         }
+         const size_t pool  = slot / parameters->PoolElementsPerPool;
+         const size_t shard = ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                                 shardedHandlespace, &(*poolHandleArray)[pool]);
+         ST_CLASS(registerBenchmarkPoolElement)(
+            ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedHandlespace, shard),
+            &(*poolHandleArray)[pool],
+            ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+            slot, slot + 1, 1000000000, 1000000,
+            &(*poolElementNodeArray)[slot],
+            registrationStatistics, timerStatistics);
+         ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedHandlespace, shard);
+      }
+      else {
+         const size_t pool = (value >> 2) % poolHandleArray->size();
+         size_t       items;
+         ST_CLASS(shardedPoolHandlespaceManagementHandleResolution)(
+            shardedHandlespace, &(*poolHandleArray)[pool],
+            &selectionArray[0], &items,
+            parameters->MaxHandleResolutionItems, parameters->MaxIncrement);
+         CHECK(items > 0);
+      }
+      operations++;
+   }
+   result->Duration   = getNanoTime() - startTimeStamp;
+   result->Operations = operations;
+}
+
+
+/* ###### Run sharded benchmark ########################################## */
+/*
+   Throughput of 1, 2, 4, ... worker threads on a handlespace of 1 shard
+   and of the given number of shards.
+*/
+static void ST_CLASS(runShardedBenchmark)(const BenchmarkParameters& parameters)
+{
+   const size_t                   poolElements = parameters.Pools * parameters.PoolElementsPerPool;
+   std::vector<struct PoolHandle> poolHandleArray(parameters.Pools);
+
+   ST_CLASS(createBenchmarkPoolHandles)("BenchmarkPool", poolHandleArray);
+
+   for(size_t shards = 1;;shards = parameters.Shards) {
+      struct ST_CLASS(ShardedPoolHandlespaceManagement) shardedHandlespace;
+      CHECK(ST_CLASS(shardedPoolHandlespaceManagementNew)(&shardedHandlespace, shards, 1, NULL, NULL, NULL));
+
+      std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(poolElements, NULL);
+      LatencyStatistics                              registrationStatistics;
+      LatencyStatistics                              timerStatistics;
+      for(size_t slot = 0;slot < poolElements;slot++) {
+         const size_t pool  = slot / parameters.PoolElementsPerPool;
+         const size_t shard = ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                                 &shardedHandlespace, &poolHandleArray[pool]);
+         ST_CLASS(registerBenchmarkPoolElement)(
+            ST_CLASS(shardedPoolHandlespaceManagementLockShard)(&shardedHandlespace, shard),
+            &poolHandleArray[pool],
+            ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+            slot, slot + 1, 1000000000, 1000000,
+            &poolElementNodeArray[slot],
+            registrationStatistics, timerStatistics);
+         ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(&shardedHandlespace, shard);
+      }
+
+      for(size_t threads = 1;;threads = std::min(2 * threads, parameters.Shards)) {
+         std::vector<ShardedWorkerResult> resultArray(threads);
+         std::vector<std::thread>         threadArray;
+         std::atomic<bool>                stop(false);
+         for(size_t i = 0;i < threads;i++) {
+            threadArray.push_back(std::thread(ST_CLASS(runShardedWorker),
+                                              &shardedHandlespace, &poolHandleArray,
+                                              &poolElementNodeArray, &parameters,
+                                              i, threads, &stop, &resultArray[i]));
+         }
+         usleep((useconds_t)(parameters.ReaderDuration / 1000));
+         stop.store(true);
+
+         unsigned long long operations = 0;
+         double             rate       = 0.0;
+         for(size_t i = 0;i < threads;i++) {
+            threadArray[i].join();
+            operations += resultArray[i].Operations;
+            rate       += (1000000000.0 * resultArray[i].Operations) / (double)resultArray[i].Duration;
+         }
+
+         char name[128];
+         snprintf(name, sizeof(name), "Mixed operations, %zu shards, %zu threads", shards, threads);
+         printf("%-56s %10llu %12.0f\n", name, operations, rate);
+         if(threads == parameters.Shards) {
+            break;
+         }
+      }
+
+      ST_CLASS(shardedPoolHandlespaceManagementVerify)(&shardedHandlespace);
+      CHECK(ST_CLASS(shardedPoolHandlespaceManagementGetPoolElements)(&shardedHandlespace) == poolElements);
+      ST_CLASS(shardedPoolHandlespaceManagementDelete)(&shardedHandlespace);
+      if(shards == parameters.Shards) {
+         break;
+      }
+   }
+}
+
+
+/* ###### Check specialised against generic selection ################### */
+/*
+   In C++ builds, the pools select by the specialised selection functions
+   of ST_CLASS(PoolPolicyType). They have to choose the same PEs as the
+   generic selection functions. The same registrations are made in two
+   handlespaces, with one pool per policy; in the second handlespace, the
+   pools use copies of their policies with the generic selection function.
+   Each pair of handle resolutions is made with the same randomizer state.
+*/
+static void ST_CLASS(checkSelectionEquivalence)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)     handlespaceArray[2];
+   std::vector<struct ST_CLASS(PoolPolicy)>       genericPolicyArray(ST_CLASS(PoolPolicies));
+   std::vector<struct PoolHandle>                 poolHandleArray(ST_CLASS(PoolPolicies));
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray[2];
+   std::vector<struct ST_CLASS(PoolElementNode)*> selectionArray[2];
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   const size_t                                   poolElements = ST_CLASS(PoolPolicies) * parameters.PoolElementsPerPool;
+   unsigned long long                             randomState;
+   size_t                                         items[2];
+   size_t                                         resolutions = 0;
+
+   for(unsigned int h = 0;h < 2;h++) {
+      ST_CLASS(poolHandlespaceManagementNew)(&handlespaceArray[h], 1, NULL, NULL, NULL);
+      poolElementNodeArray[h].resize(poolElements, NULL);
+      selectionArray[h].resize(parameters.MaxHandleResolutionItems);
+   }
+   for(size_t i = 0;i < ST_CLASS(PoolPolicies);i++) {
+      genericPolicyArray[i] = ST_CLASS(PoolPolicyArray)[i];
+      genericPolicyArray[i].SelectionFunction =
+         (genericPolicyArray[i].SelectionByValueTree) ?
+            &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree) :
+            &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder);
+   }
+   ST_CLASS(createBenchmarkPoolHandles)("EquivalencePool", poolHandleArray);
+
+   for(size_t round = 0;round <= parameters.Rounds;round++) {
+      // ====== Register all PEs, then re-register churned ones =============
+      const size_t changes = (round == 0) ? poolElements : (size_t)rint(parameters.Churn * poolElements);
+      for(size_t i = 0;i < changes;i++) {
+         const size_t slot = (round == 0) ? i : (workloadRandom() % poolElements);
+         const size_t pool = slot / parameters.PoolElementsPerPool;
+         randomState = WorkloadRandomState;
+         for(unsigned int h = 0;h < 2;h++) {
+            WorkloadRandomState = randomState;
+            ST_CLASS(registerBenchmarkPoolElement)(
+               &handlespaceArray[h], &poolHandleArray[pool],
+               ST_CLASS(PoolPolicyArray)[pool].Type,
+               slot, slot + 1, 1000000000, 1000000,
+               &poolElementNodeArray[h][slot],
+               registrationStatistics, timerStatistics);
+         }
+         poolElementNodeArray[1][slot]->OwnerPoolNode->Policy = &genericPolicyArray[pool];
+      }
+
+      // ====== Compare handle resolutions ==================================
+      for(size_t pool = 0;pool < ST_CLASS(PoolPolicies);pool++) {
+         const size_t maxItems     = 1 + (workloadRandom() % parameters.MaxHandleResolutionItems);
+         const size_t maxIncrement = workloadRandom() % (parameters.MaxIncrement + 1);
+         randomState = HandlespaceRandomState;
+         for(unsigned int h = 0;h < 2;h++) {
+            HandlespaceRandomState = randomState;
+            ST_CLASS(poolHandlespaceManagementHandleResolution)(
+               &handlespaceArray[h], &poolHandleArray[pool],
+               &selectionArray[h][0], &items[h], maxItems, maxIncrement);
+         }
+         CHECK(items[0] == items[1]);
+         for(size_t i = 0;i < items[0];i++) {
+            if(selectionArray[0][i]->Identifier != selectionArray[1][i]->Identifier) {
+               fprintf(stderr, "ERROR: Selections of policy %s differ!\n",
+                       ST_CLASS(PoolPolicyArray)[pool].Name);
+               exit(1);
+            }
+         }
+         resolutions++;
+      }
+   }
+
+   for(unsigned int h = 0;h < 2;h++) {
+      ST_CLASS(poolHandlespaceManagementVerify)(&handlespaceArray[h]);
+      ST_CLASS(poolHandlespaceManagementDelete)(&handlespaceArray[h]);
+   }
+   printf("Specialised and generic selection identical in %zu handle resolutions\n", resolutions);
+}
+
+
+/* ###### Check ownership transfers ###################################### */
+/*
+   poolHandlespaceManagementTransferOwnershipOfPoolElementNodes() moves
+   all PEs of one home PR to another one, by re-inserting each node for a
+   small range and by rebuilding the ownership storage for a large one.
+   The registrar's home PR is 1. PR 2 has few PEs (re-insertion), PR 3 has
+   half of them (rebuild); the transfers move PEs from and to the home PR.
+   After each transfer, the ownership storage has to be in order, the
+   numbers of PEs per PR and of owned PEs have to be right, and the
+   handlespace checksum has to be unchanged. The previous owner's changes
+   have to report each moved PE as a tombstone.
+*/
+static void ST_CLASS(checkOwnershipTransfers)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)     handlespace;
+   std::vector<struct PoolHandle>                 poolHandleArray(parameters.Pools);
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(parameters.Pools * parameters.PoolElementsPerPool, NULL);
+   std::vector<RegistrarIdentifierType>           homeRegistrarArray(poolElementNodeArray.size(), 1);
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   const RegistrarIdentifierType                  transferArray[][2] = {
+      { 2, 5 }, { 3, 1 }, { 1, 4 }, { 5, 1 }, { 4, 3 }
+   };
+   size_t                                         moved = 0;
+
+   ST_CLASS(poolHandlespaceManagementNew)(&handlespace, 1, NULL, NULL, NULL);
+   ST_CLASS(createBenchmarkPoolHandles)("TransferPool", poolHandleArray);
+   for(size_t slot = 0;slot < homeRegistrarArray.size();slot++) {
+      homeRegistrarArray[slot] = (slot % 64 == 0) ? 2 : ((slot & 1) ? 3 : 1);
+   }
+   ST_CLASS(registerBenchmarkPoolElements)(&handlespace, parameters, poolHandleArray, poolElementNodeArray,
+                                           registrationStatistics, timerStatistics,
+                                           1000000000, 1000000, &homeRegistrarArray);
+   const HandlespaceChecksumType handlespaceChecksum =
+      ST_CLASS(poolHandlespaceManagementGetHandlespaceChecksum)(&handlespace);
+
+   for(size_t t = 0;t < sizeof(transferArray) / sizeof(transferArray[0]);t++) {
+      // ====== Transfer =====================================================
+      size_t expected = 0;
+      for(size_t slot = 0;slot < homeRegistrarArray.size();slot++) {
+         if(homeRegistrarArray[slot] == transferArray[t][0]) {
+            homeRegistrarArray[slot] = transferArray[t][1];
+            expected++;
+         }
+      }
+      const unsigned long long version =
+         ST_CLASS(poolHandlespaceManagementGetModificationSequence)(&handlespace);
+      const size_t transferred =
+         ST_CLASS(poolHandlespaceManagementTransferOwnershipOfPoolElementNodes)(
+            &handlespace, transferArray[t][0], transferArray[t][1]);
+      CHECK(transferred == expected);
+      moved += transferred;
+
+      // ====== Check the previous owner's tombstones =======================
+      if(ST_CLASS(poolHandlespaceManagementHasChangesSince)(&handlespace, version)) {
+         struct ST_CLASS(HandleTableChangesExtract) htce;
+         size_t                                     tombstones = 0;
+         unsigned int                               flags      = HTEF_START | HTEF_OWNCHILDSONLY;
+         while(ST_CLASS(poolHandlespaceManagementGetHandleTableChanges)(
+                  &handlespace, transferArray[t][0], version, &htce, flags,
+                  NTE_MAX_POOL_ELEMENT_NODES)) {
+            CHECK(htce.PoolElementNodes == 0);
+            for(size_t i = 0;i < htce.Tombstones;i++) {
+               CHECK(htce.TombstoneArray[i]->HomeRegistrarIdentifier == transferArray[t][0]);
+            }
+            tombstones += htce.Tombstones;
+            flags = HTEF_OWNCHILDSONLY;
+         }
+         CHECK(tombstones == transferred);
+      }
+
+      // ====== Check ownership order and numbers ===========================
+      size_t owned    = 0;
+      size_t elements = 0;
+      const struct ST_CLASS(PoolElementNode)* previousPoolElementNode = NULL;
+      struct ST_CLASS(PoolElementNode)* poolElementNode =
+         ST_CLASS(poolHandlespaceManagementGetFirstPoolElementOwnershipNode)(&handlespace);
+      while(poolElementNode != NULL) {
+         if(previousPoolElementNode != NULL) {
+            CHECK(ST_CLASS(poolElementOwnershipStorageNodeComparison)(
+                     &previousPoolElementNode->PoolElementOwnershipStorageNode,
+                     &poolElementNode->PoolElementOwnershipStorageNode) < 0);
+         }
+         if(poolElementNode->HomeRegistrarIdentifier == 1) {
+            owned++;
+         }
+         elements++;
+         previousPoolElementNode = poolElementNode;
+         poolElementNode = ST_CLASS(poolHandlespaceManagementGetNextPoolElementOwnershipNode)(
+                              &handlespace, poolElementNode);
+      }
+      CHECK(elements == poolElementNodeArray.size());
+      CHECK(owned == (size_t)std::count(homeRegistrarArray.begin(), homeRegistrarArray.end(), 1));
+      CHECK(owned == ST_CLASS(poolHandlespaceManagementGetOwnedPoolElements)(&handlespace));
+      for(size_t slot = 0;slot < poolElementNodeArray.size();slot++) {
+         CHECK(poolElementNodeArray[slot]->HomeRegistrarIdentifier == homeRegistrarArray[slot]);
+      }
+      CHECK(ST_CLASS(poolHandlespaceManagementGetHandlespaceChecksum)(&handlespace) ==
+               handlespaceChecksum);
+      ST_CLASS(poolHandlespaceManagementVerify)(&handlespace);
+   }
+
+   ST_CLASS(poolHandlespaceManagementDelete)(&handlespace);
+   printf("Ownership transfers correct for %zu moved pool elements\n", moved);
+}
+
+
+/* ###### Check marking and purging ##################################### */
+/*
+   As for a takeover of a peer PR, the PEs of a PR are marked, some of
+   them are refreshed by re-registrations, and the still marked ones are
+   purged. In every fourth round, none are refreshed: the PR's mark
+   generation then has to be freed together with its last PE.
+*/
+static void ST_CLASS(checkMarkAndPurge)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)     handlespace;
+   const RegistrarIdentifierType                  registrars = 8;
+   std::vector<struct PoolHandle>                 poolHandleArray(parameters.Pools);
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(parameters.Pools * parameters.PoolElementsPerPool, NULL);
+   std::vector<bool>                              refreshedArray(poolElementNodeArray.size(), false);
+   std::vector<RegistrarIdentifierType>           homeRegistrarArray(poolElementNodeArray.size());
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   char                                           description[4096];
+   size_t                                         purged    = 0;
+   size_t                                         refreshed = 0;
+
+   ST_CLASS(poolHandlespaceManagementNew)(&handlespace, 1, NULL, NULL, NULL);
+   ST_CLASS(createBenchmarkPoolHandles)("MarkPool", poolHandleArray);
+   for(size_t slot = 0;slot < homeRegistrarArray.size();slot++) {
+      homeRegistrarArray[slot] = 2 + (workloadRandom() % registrars);
+   }
+   ST_CLASS(registerBenchmarkPoolElements)(&handlespace, parameters, poolHandleArray, poolElementNodeArray,
+                                           registrationStatistics, timerStatistics,
+                                           1000000000, 1000000, &homeRegistrarArray);
+
+   for(size_t round = 0;round < 4 * parameters.Rounds;round++) {
+      const RegistrarIdentifierType ownerID = 2 + (workloadRandom() % registrars);
+      const bool                    refresh = ((round % 4) != 3);
+
+      // ====== Mark PR's PEs, then refresh some of them ====================
+      ST_CLASS(poolHandlespaceManagementMarkPoolElementNodes)(&handlespace, ownerID);
+      size_t expected = 0;
+      for(size_t slot = 0;slot < poolElementNodeArray.size();slot++) {
+         if(poolElementNodeArray[slot]->HomeRegistrarIdentifier == ownerID) {
+            refreshedArray[slot] = refresh && (workloadRandom() % 2);
+            if(refreshedArray[slot]) {
+               const size_t pool = slot / parameters.PoolElementsPerPool;
+               ST_CLASS(registerBenchmarkPoolElement)(
+                  &handlespace, &poolHandleArray[pool],
+                  ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+                  slot, poolElementNodeArray[slot]->Identifier, 1000000000, 1000000,
+                  &poolElementNodeArray[slot],
+                  registrationStatistics, timerStatistics, ownerID);
+               refreshed++;
+            }
+            else {
+               expected++;
+            }
+            ST_CLASS(poolElementNodeGetDescription)(poolElementNodeArray[slot],
+                                                    description, sizeof(description), 0);
+            CHECK((strstr(description, "[marked]") == NULL) == refreshedArray[slot]);
+         }
+         else {
+            refreshedArray[slot] = true;
+         }
+      }
+
+      // ====== Purge the still marked PEs ==================================
+      CHECK(ST_CLASS(poolHandlespaceManagementPurgeMarkedPoolElementNodes)(&handlespace, ownerID) ==
+               expected);
+      purged += expected;
+      if(!refresh) {
+         CHECK(identifierHashTableFind(&handlespace.Handlespace.OwnerGenerationIndex, ownerID) == NULL);
+      }
+      CHECK(identifierHashTableGetEntries(&handlespace.Handlespace.OwnerGenerationIndex) <= registrars);
+      CHECK(ST_CLASS(poolHandlespaceManagementGetPoolElements)(&handlespace) ==
+               poolElementNodeArray.size() - expected);
+      ST_CLASS(poolHandlespaceManagementVerify)(&handlespace);
+
+      // ====== Replace purged PEs by PEs of random PRs =====================
+      for(size_t slot = 0;slot < poolElementNodeArray.size();slot++) {
+         if(!refreshedArray[slot]) {
+            const size_t pool = slot / parameters.PoolElementsPerPool;
+            ST_CLASS(registerBenchmarkPoolElement)(
+               &handlespace, &poolHandleArray[pool],
+               ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+               slot, slot + 1, 1000000000, 1000000,
+               &poolElementNodeArray[slot],
+               registrationStatistics, timerStatistics,
+               2 + (workloadRandom() % registrars));
+         }
+      }
+   }
+
+   ST_CLASS(poolHandlespaceManagementClear)(&handlespace);
+   CHECK(identifierHashTableGetEntries(&handlespace.Handlespace.OwnerGenerationIndex) == 0);
+   ST_CLASS(poolHandlespaceManagementDelete)(&handlespace);
+   printf("Marking correct for %zu purged and %zu refreshed pool elements\n", purged, refreshed);
+}
+
+
+/* ###### Check bulk against sequential registration #################### */
+/*
+   poolHandlespaceManagementRegisterPoolElementsBulk() has to give the
+   same result as registering the array's entries one by one. The arrays
+   mix new PEs, updates of existing ones and PE IDs occurring more than
+   once. After each array, both handlespaces have to be equal, including
+   flags, selection order, modification order and the handle resolutions
+   made with the same randomizer state.
+*/
+static void ST_CLASS(checkBulkRegistration)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)               handlespaceArray[2];
+   std::vector<struct PoolHandle>                           poolHandleArray(parameters.Pools);
+   const size_t                                             registrations = std::max((size_t)1, parameters.Pools * parameters.PoolElementsPerPool / 4);
+   std::vector<struct ST_CLASS(PoolElementRegistration)>    registrationArray(registrations);
+   std::vector<struct PoolPolicySettings>                   poolPolicySettingsArray(registrations);
+   std::vector<char>                                        transportBuffer(2 * registrations * transportAddressBlockGetSize(1));
+   std::vector<struct ST_CLASS(PoolElementNode)*>           selectionArray[2];
+   size_t                                                   items[2];
+   unsigned long long                                       randomState;
+   size_t                                                   compared = 0;
+
+   for(unsigned int h = 0;h < 2;h++) {
+      ST_CLASS(poolHandlespaceManagementNew)(&handlespaceArray[h], 1, NULL, NULL, NULL);
+      selectionArray[h].resize(parameters.MaxHandleResolutionItems);
+   }
+   ST_CLASS(createBenchmarkPoolHandles)("BulkPool", poolHandleArray);
+
+   for(size_t round = 0;round <= parameters.Rounds;round++) {
+      // ====== Create registrations ========================================
+      for(size_t i = 0;i < registrations;i++) {
+         const size_t pool = workloadRandom() % parameters.Pools;
+
+         struct sockaddr_testaddr address;
+         memset(&address, 0, sizeof(address));
+         address.ta_family = AF_TEST;
+         address.ta_addr   = (unsigned int)i + 1;
+         address.ta_port   = 1;
+         struct TransportAddressBlock* userTransport =
+            (struct TransportAddressBlock*)&transportBuffer[(2 * i) * transportAddressBlockGetSize(1)];
+         struct TransportAddressBlock* registratorTransport =
+            (struct TransportAddressBlock*)&transportBuffer[(2 * i + 1) * transportAddressBlockGetSize(1)];
+         transportAddressBlockNew(userTransport,
+                                  IPPROTO_SCTP, 1, TABF_CONTROLCHANNEL,
+                                  (union sockaddr_union*)&address, 1, 1);
+         transportAddressBlockNew(registratorTransport,
+                                  IPPROTO_SCTP, 1, 0,
+                                  (union sockaddr_union*)&address, 1, 1);
+
+         struct PoolPolicySettings* poolPolicySettings = &poolPolicySettingsArray[i];
+         poolPolicySettingsNew(poolPolicySettings);
+         poolPolicySettings->PolicyType      = ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type;
+         poolPolicySettings->Weight          = 1 + (unsigned int)(workloadRandom() % 1000);
+         poolPolicySettings->Load            = workloadLoad();
+         poolPolicySettings->LoadDegradation = (unsigned int)(workloadRandom() % 0x10000000);
+         poolPolicySettings->LoadDPF         = (unsigned int)(workloadRandom() % 0x10000000);
+         poolPolicySettings->WeightDPF       = (unsigned int)(workloadRandom() % 0x10000000);
+
+         registrationArray[i].Handle                     = &poolHandleArray[pool];
+         registrationArray[i].HomeRegistrarIdentifier    = 1 + (workloadRandom() % 3);
+         registrationArray[i].Identifier                 = 1 + (workloadRandom() % (2 * parameters.PoolElementsPerPool));
+         registrationArray[i].RegistrationLife           = 30000;
+         registrationArray[i].PolicySettings             = poolPolicySettings;
+         registrationArray[i].UserTransport              = userTransport;
+         registrationArray[i].RegistratorTransport       = registratorTransport;
+         registrationArray[i].ConnectionSocketDescriptor = -1;
+         registrationArray[i].ConnectionAssocID          = 0;
+      }
+
+      // ====== Register sequentially and in bulk ===========================
+      for(size_t i = 0;i < registrations;i++) {
+         struct ST_CLASS(PoolElementNode)* poolElementNode;
+         const unsigned int errorCode = ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
+            &handlespaceArray[0],
+            registrationArray[i].Handle,
+            registrationArray[i].HomeRegistrarIdentifier,
+            registrationArray[i].Identifier,
+            registrationArray[i].RegistrationLife,
+            registrationArray[i].PolicySettings,
+            registrationArray[i].UserTransport,
+            registrationArray[i].RegistratorTransport,
+            -1, 0, 1000000 + round,
+            &poolElementNode);
+         CHECK(errorCode == RSPERR_OKAY);
+      }
+      CHECK(ST_CLASS(poolHandlespaceManagementRegisterPoolElementsBulk)(
+               &handlespaceArray[1], &registrationArray[0], registrations, 1000000 + round) == registrations);
+
+      // ====== Compare handlespaces ========================================
+      CHECK(ST_CLASS(poolHandlespaceManagementGetHandlespaceChecksum)(&handlespaceArray[0]) ==
+               ST_CLASS(poolHandlespaceManagementGetHandlespaceChecksum)(&handlespaceArray[1]));
+      CHECK(ST_CLASS(poolHandlespaceManagementGetOwnershipChecksum)(&handlespaceArray[0]) ==
+               ST_CLASS(poolHandlespaceManagementGetOwnershipChecksum)(&handlespaceArray[1]));
+      CHECK(handlespaceArray[0].Handlespace.ModificationSequence ==
+               handlespaceArray[1].Handlespace.ModificationSequence);
+      struct ST_CLASS(PoolNode)* poolNode[2];
+      for(unsigned int h = 0;h < 2;h++) {
+         poolNode[h] = ST_CLASS(poolHandlespaceManagementGetFirstPoolNode)(&handlespaceArray[h]);
+      }
+      while(poolNode[0] != NULL) {
+         CHECK(poolNode[1] != NULL);
+         CHECK(poolHandleComparison(&poolNode[0]->Handle, &poolNode[1]->Handle) == 0);
+         CHECK(poolNode[0]->GlobalSeqNumber == poolNode[1]->GlobalSeqNumber);
+         struct ST_CLASS(PoolElementNode)* poolElementNode[2];
+         for(unsigned int h = 0;h < 2;h++) {
+            poolElementNode[h] = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode[h]);
+         }
+         while(poolElementNode[0] != NULL) {
+            CHECK(poolElementNode[1] != NULL);
+            if( (poolElementNode[0]->Identifier              != poolElementNode[1]->Identifier) ||
+                (poolElementNode[0]->SeqNumber               != poolElementNode[1]->SeqNumber) ||
+                (poolElementNode[0]->Flags                   != poolElementNode[1]->Flags) ||
+                (poolElementNode[0]->HomeRegistrarIdentifier != poolElementNode[1]->HomeRegistrarIdentifier) ||
+                (poolElementNode[0]->ModificationSequence    != poolElementNode[1]->ModificationSequence) ||
+                (poolPolicySettingsComparison(&poolElementNode[0]->PolicySettings,
+                                              &poolElementNode[1]->PolicySettings) != 0) ) {
+               fprintf(stderr, "ERROR: Bulk registration differs for PE $%08x of pool %s!\n",
+                       poolElementNode[0]->Identifier, poolNode[0]->Policy->Name);
+               exit(1);
+            }
+            for(unsigned int h = 0;h < 2;h++) {
+               poolElementNode[h] = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(
+                                       poolNode[h], poolElementNode[h]);
+            }
+         }
+         CHECK(poolElementNode[1] == NULL);
+
+         randomState = HandlespaceRandomState;
+         for(unsigned int h = 0;h < 2;h++) {
+            HandlespaceRandomState = randomState;
+            ST_CLASS(poolHandlespaceManagementHandleResolution)(
+               &handlespaceArray[h], &poolNode[h]->Handle,
+               &selectionArray[h][0], &items[h],
+               parameters.MaxHandleResolutionItems, parameters.MaxIncrement);
+         }
+         CHECK(items[0] == items[1]);
+         for(size_t i = 0;i < items[0];i++) {
+            CHECK(selectionArray[0][i]->Identifier == selectionArray[1][i]->Identifier);
+         }
+         compared++;
+
+         for(unsigned int h = 0;h < 2;h++) {
+            poolNode[h] = ST_CLASS(poolHandlespaceManagementGetNextPoolNode)(&handlespaceArray[h], poolNode[h]);
+         }
+      }
+      CHECK(poolNode[1] == NULL);
+   }
+
+   for(unsigned int h = 0;h < 2;h++) {
+      ST_CLASS(poolHandlespaceManagementVerify)(&handlespaceArray[h]);
+      ST_CLASS(poolHandlespaceManagementDelete)(&handlespaceArray[h]);
+   }
+   printf("Bulk and sequential registration identical in %zu pool comparisons\n", compared);
+}
+
+
+/* ###### Check view selection of tied pool elements ##################### */
+/*
+   For each sorting order policy, a pool of PEs with equal policy settings
+   is registered into two handlespaces. The first one only publishes its
+   view, the second one resolves itself with a maximum increment of 1.
+   The view's selections have to be the same: the pool's PEs are all of
+   equal rank, and the view rotates through them as the sequence numbers
+   do in the handlespace.
+*/
+static void ST_CLASS(checkViewSelection)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)     handlespaceArray[2];
+   std::vector<struct PoolHandle>                 poolHandleArray(ST_CLASS(PoolPolicies));
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray[2];
+   std::vector<struct ST_CLASS(PoolElementNode)*> selectionArray(parameters.MaxHandleResolutionItems);
+   std::vector<const struct PoolElementView*>     viewSelectionArray(parameters.MaxHandleResolutionItems);
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   const size_t                                   poolElements = ST_CLASS(PoolPolicies) * parameters.PoolElementsPerPool;
+   unsigned long long                             randomState  = parameters.Seed + 1;
+   size_t                                         items;
+   size_t                                         resolutions  = 0;
+
+   struct PoolPolicySettings poolPolicySettings;
+   poolPolicySettingsNew(&poolPolicySettings);
+   poolPolicySettings.Weight          = 1;   /* WeightedRoundRobin rotates */
+   poolPolicySettings.Load            = 0x1000000;
+   poolPolicySettings.LoadDegradation = 0x100000;
+
+   ST_CLASS(createBenchmarkPoolHandles)("ViewPool", poolHandleArray);
+   for(unsigned int h = 0;h < 2;h++) {
+      ST_CLASS(poolHandlespaceManagementNew)(&handlespaceArray[h], 1, NULL, NULL, NULL);
+      poolElementNodeArray[h].resize(poolElements, NULL);
+      ST_CLASS(registerBenchmarkPoolElements)(&handlespaceArray[h], parameters, poolHandleArray, poolElementNodeArray[h],
+                                              registrationStatistics, timerStatistics,
+                                              1000000000, 1000000, NULL, &poolPolicySettings);
+   }
+   CHECK(ST_CLASS(poolHandlespaceManagementEnableConcurrentReaders)(&handlespaceArray[0]));
+   const struct PoolHandlespaceView* poolHandlespaceView =
+      ST_CLASS(poolHandlespaceManagementGetViewPublisher)(&handlespaceArray[0])->CurrentView;
+
+   for(size_t round = 0;round < parameters.Rounds * parameters.PoolElementsPerPool;round++) {
+      for(size_t pool = 0;pool < ST_CLASS(PoolPolicies);pool++) {
+         if(ST_CLASS(PoolPolicyArray)[pool].SelectionByValueTree) {
+            continue;
+         }
+         const size_t maxItems = 1 + (workloadRandom() % parameters.MaxHandleResolutionItems);
+         ST_CLASS(poolHandlespaceManagementHandleResolution)(
+            &handlespaceArray[1], &poolHandleArray[pool],
+            &selectionArray[0], &items, maxItems, 1);
+         CHECK(poolHandlespaceViewHandleResolution(poolHandlespaceView, &poolHandleArray[pool],
+                                                   &viewSelectionArray[0], maxItems,
+                                                   &randomState) == items);
+         for(size_t i = 0;i < items;i++) {
+            if(selectionArray[i]->Identifier != viewSelectionArray[i]->Identifier) {
+               fprintf(stderr, "ERROR: View selections of policy %s differ!\n",
+                       ST_CLASS(PoolPolicyArray)[pool].Name);
+               exit(1);
+            }
+         }
+         resolutions++;
+      }
+   }
+
+   for(unsigned int h = 0;h < 2;h++) {
+      ST_CLASS(poolHandlespaceManagementVerify)(&handlespaceArray[h]);
+      ST_CLASS(poolHandlespaceManagementDelete)(&handlespaceArray[h]);
+   }
+   printf("View and handlespace selection identical in %zu handle resolutions\n", resolutions);
+}
+
+
+/* ###### Check memory usage against the registered pool elements ####### */
+static void ST_CLASS(checkMemoryUsageOfHandlespace)(
+               struct ST_CLASS(PoolHandlespaceManagement)* handlespace,
+               const std::vector<struct PoolHandle>&       poolHandleArray,
+               const size_t                                poolElements)
+{
+   struct HandlespaceMemoryUsage memoryUsage;
+   size_t                        nodes = poolElements * sizeof(struct ST_CLASS(PoolElementNode));
+
+   for(size_t pool = 0;pool < poolHandleArray.size();pool++) {
+      if(ST_CLASS(poolHandlespaceNodeFindPoolNode)(&handlespace->Handlespace,
+                                                   &poolHandleArray[pool]) != NULL) {
+         nodes += sizeof(struct ST_CLASS(PoolNode));
+      }
+   }
+   if(handlespace->NewPoolNode != NULL) {
+      nodes += sizeof(struct ST_CLASS(PoolNode));
+   }
+   if(handlespace->NewPoolElementNode != NULL) {
+      nodes += sizeof(struct ST_CLASS(PoolElementNode));
+   }
+
+   ST_CLASS(poolHandlespaceManagementGetMemoryUsage)(handlespace, &memoryUsage);
+   CHECK(memoryUsage.Nodes == nodes);
+   // User and registrator transport of one address each, see registerBenchmarkPoolElement()
+   CHECK(memoryUsage.TransportAddressBlocks == poolElements * 2 * transportAddressBlockGetSize(1));
+   CHECK(memoryUsage.Other >= sizeof(struct ST_CLASS(PoolHandlespaceManagement)));
+   CHECK(handlespaceMemoryUsageGetTotal(&memoryUsage) ==
+            memoryUsage.Nodes + memoryUsage.TransportAddressBlocks +
+            memoryUsage.TimeStampHashTables + memoryUsage.PolicyState +
+            memoryUsage.Other + memoryUsage.AllocatorOverhead);
+   if(handlespace->Allocator.HeapObjectsInUse == 0) {
+      CHECK(memoryUsage.Nodes + memoryUsage.TransportAddressBlocks + memoryUsage.AllocatorOverhead ==
+               slabAllocatorGetAllocatedBytes(&handlespace->Allocator));
+   }
+}
+
+
+/* ###### Check memory usage ############################################# */
+/*
+   The byte counts of poolHandlespaceManagementGetMemoryUsage(), as
+   recorded by the registrar, have to follow registrations and
+   deregistrations: nodes and transport address blocks by their structure
+   sizes, the allocator overhead being the rest of the slabs.
+*/
+static void ST_CLASS(checkMemoryUsage)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)     handlespace;
+   std::vector<struct PoolHandle>                 poolHandleArray(parameters.Pools);
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(parameters.Pools * parameters.PoolElementsPerPool, NULL);
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   struct HandlespaceMemoryUsage                  memoryUsage;
+   size_t                                         poolElements = 0;
+   size_t                                         checks       = 0;
+
+   ST_CLASS(poolHandlespaceManagementNew)(&handlespace, 1, NULL, NULL, NULL);
+   ST_CLASS(createBenchmarkPoolHandles)("MemoryPool", poolHandleArray);
+   ST_CLASS(checkMemoryUsageOfHandlespace)(&handlespace, poolHandleArray, 0);
+
+   for(size_t round = 0;round < parameters.Rounds;round++) {
+      // ====== Register the missing PEs ====================================
+      for(size_t slot = 0;slot < poolElementNodeArray.size();slot++) {
+         if(poolElementNodeArray[slot] == NULL) {
+            const size_t pool = slot / parameters.PoolElementsPerPool;
+            ST_CLASS(registerBenchmarkPoolElement)(
+               &handlespace, &poolHandleArray[pool],
+               ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+               slot, slot + 1, 1000000000, 1000000,
+               &poolElementNodeArray[slot],
+               registrationStatistics, timerStatistics);
+            poolElements++;
+            if(slot % parameters.PoolElementsPerPool == 0) {
+               ST_CLASS(checkMemoryUsageOfHandlespace)(&handlespace, poolHandleArray, poolElements);
+               checks++;
+            }
+         }
+      }
+      ST_CLASS(checkMemoryUsageOfHandlespace)(&handlespace, poolHandleArray, poolElements);
+
+      // ====== Deregister random PEs, in every last round all of them ======
+      for(size_t slot = 0;slot < poolElementNodeArray.size();slot++) {
+         if( (round + 1 == parameters.Rounds) || (workloadRandom() % 2) ) {
+            const size_t pool = slot / parameters.PoolElementsPerPool;
+            CHECK(ST_CLASS(poolHandlespaceManagementDeregisterPoolElement)(
+                     &handlespace, &poolHandleArray[pool], slot + 1) == RSPERR_OKAY);
+            poolElementNodeArray[slot] = NULL;
+            poolElements--;
+         }
+      }
+      ST_CLASS(checkMemoryUsageOfHandlespace)(&handlespace, poolHandleArray, poolElements);
+      checks += 2;
+   }
+
+   // ====== Only the spare nodes and the allocator's slabs remain ==========
+   CHECK(poolElements == 0);
+   ST_CLASS(poolHandlespaceManagementGetMemoryUsage)(&handlespace, &memoryUsage);
+   CHECK(memoryUsage.TransportAddressBlocks == 0);
+   CHECK(memoryUsage.PolicyState == 0);
+
+   ST_CLASS(poolHandlespaceManagementDelete)(&handlespace);
+   printf("Memory usage byte counts correct in %zu checks\n", checks);
+}
+
+
+/* ###### Check alias table selection switch ############################ */
+/*
+   Only the pools of policies enabled by
+   poolHandlespaceManagementSetAliasTableSelection() may get an alias
+   table; policies without alias table support have to be refused. The
+   handle resolutions of all pools have to succeed either way.
+*/
+static void ST_CLASS(checkAliasTableSelection)(const BenchmarkParameters& parameters)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)     handlespace;
+   std::vector<struct PoolHandle>                 poolHandleArray(parameters.Pools);
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(parameters.Pools * parameters.PoolElementsPerPool, NULL);
+   std::vector<struct ST_CLASS(PoolElementNode)*> selectionArray(parameters.MaxHandleResolutionItems);
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   size_t                                         aliasTablePools = 0;
+
+   ST_CLASS(poolHandlespaceManagementNew)(&handlespace, 1, NULL, NULL, NULL);
+   for(size_t i = 0;i < ST_CLASS(PoolPolicies);i++) {
+      const unsigned int policyType = ST_CLASS(PoolPolicyArray)[i].Type;
+      CHECK(ST_CLASS(poolHandlespaceManagementSetAliasTableSelection)(
+               &handlespace, policyType, (policyType == PPT_WEIGHTED_RANDOM)) ==
+            ST_CLASS(PoolPolicyArray)[i].SelectionByAliasTable);
+   }
+   ST_CLASS(createBenchmarkPoolHandles)("AliasTablePool", poolHandleArray);
+   ST_CLASS(registerBenchmarkPoolElements)(&handlespace, parameters, poolHandleArray, poolElementNodeArray,
+                                           registrationStatistics, timerStatistics);
+
+   for(size_t pool = 0;pool < parameters.Pools;pool++) {
+      const struct ST_CLASS(PoolNode)* poolNode =
+         ST_CLASS(poolHandlespaceNodeFindPoolNode)(&handlespace.Handlespace, &poolHandleArray[pool]);
+      CHECK(poolNode != NULL);
+      if(poolNode->PoolElementSelectionAliasTable != NULL) {
+         CHECK(poolNode->Policy->Type == PPT_WEIGHTED_RANDOM);
+         aliasTablePools++;
+      }
+      for(size_t round = 0;round < parameters.Rounds;round++) {
+         size_t items = selectionArray.size();
+         CHECK(ST_CLASS(poolHandlespaceManagementHandleResolution)(
+                  &handlespace, &poolHandleArray[pool], selectionArray.data(), &items,
+                  selectionArray.size(), 1) == RSPERR_OKAY);
+         CHECK(items >= 1);
+      }
+   }
+
+   ST_CLASS(poolHandlespaceManagementVerify)(&handlespace);
+   ST_CLASS(poolHandlespaceManagementDelete)(&handlespace);
+   printf("Alias table selection correct for %zu of %zu pools\n",
+          aliasTablePools, parameters.Pools);
+}
+
+
+/* ###### Run layout benchmark ########################################### */
+/*
+   Prints the layout of the pool element node and checks that its hot
+   record, i.e. Identifier ... SelectionCounter, fits into one cache line.
+   Then, measures the handle resolution throughput over all pools of the
+   given handlespace, without timing each resolution. To compare layouts,
+   run it in builds with different LAYOUTFLAGS (see Makefile).
+*/
+static void ST_CLASS(runLayoutBenchmark)(const BenchmarkParameters&                  parameters,
+                                         struct ST_CLASS(PoolHandlespaceManagement)* handlespace,
+                                         const std::vector<struct PoolHandle>&       poolHandleArray)
+{
+   typedef struct ST_CLASS(PoolElementNode) PoolElementNode;
+   const size_t cacheLineSize   = 64;
+   const size_t hotRecordBegin  = offsetof(PoolElementNode, Identifier);
+   const size_t hotRecordEnd    = offsetof(PoolElementNode, SelectionCounter) +
+                                     sizeof(((PoolElementNode*)NULL)->SelectionCounter);
+   const size_t selectionBegin  = offsetof(PoolElementNode, PoolElementSelectionStorageNode);
+   const size_t selectionEnd    = selectionBegin + sizeof(((PoolElementNode*)NULL)->PoolElementSelectionStorageNode);
+   printf("PoolElementNode layout: %zu bytes, alignment %u, hot record at %zu-%zu, selection storage node at %zu-%zu\n",
+          sizeof(PoolElementNode), (unsigned int)POOLELEMENTNODE_ALIGNMENT,
+          hotRecordBegin, hotRecordEnd - 1, selectionBegin, selectionEnd - 1);
+   CHECK(hotRecordBegin == 0);
+   CHECK(hotRecordEnd <= cacheLineSize);
+   if( (POOLELEMENTNODE_ALIGNMENT > 0) && (POOLELEMENTNODE_ALIGNMENT % cacheLineSize == 0) ) {
+      // The node address itself is aligned, i.e. the hot record is in one line.
+      for(size_t pool = 0;pool < poolHandleArray.size();pool++) {
+         struct ST_CLASS(PoolNode)* poolNode = ST_CLASS(poolHandlespaceNodeFindPoolNode)(
+                                                  &handlespace->Handlespace, &poolHandleArray[pool]);
+         CHECK(poolNode != NULL);
+         struct ST_CLASS(PoolElementNode)* poolElementNode =
+            ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+         while(poolElementNode != NULL) {
+            CHECK((uintptr_t)poolElementNode % cacheLineSize == 0);
+            poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNode);
+         }
+      }
+   }
+
+   std::vector<struct ST_CLASS(PoolElementNode)*> selectionArray(parameters.MaxHandleResolutionItems);
+   const size_t             handleResolutions = std::max(parameters.HandleResolutions, (size_t)1);
+   const unsigned long long startTimeStamp    = getNanoTime();
+   for(size_t i = 0;i < handleResolutions;i++) {
+      const size_t pool = workloadRandom() % poolHandleArray.size();
+      size_t       items;
+      ST_CLASS(poolHandlespaceManagementHandleResolution)(
+         handlespace, &poolHandleArray[pool],
+         &selectionArray[0], &items,
+         parameters.MaxHandleResolutionItems, parameters.MaxIncrement);
+      CHECK(items > 0);
+   }
+   const unsigned long long duration = getNanoTime() - startTimeStamp;
+   printf("HandleResolution throughput (all policies): %1.0f/s\n",
+          (duration > 0) ? (1000000000.0 * handleResolutions) / (double)duration : 0.0);
+}
+
+
+/* ###### Run benchmark ################################################## */
+static void ST_CLASS(runBenchmark)(const BenchmarkParameters& parameters)
+{
+   // ====== Every policy needs at least one pool ===========================
+   // Pool i uses policy i % PoolPolicies, i.e. with fewer pools, the
+   // results of the remaining policies would be empty.
+   if(parameters.Pools < ST_CLASS(PoolPolicies)) {
+      fprintf(stderr, "ERROR: %zu pools for %zu pool policies, use at least -pools=%zu!\n",
+              parameters.Pools, ST_CLASS(PoolPolicies), ST_CLASS(PoolPolicies));
+      exit(1);
+   }
+
+   struct ST_CLASS(PoolHandlespaceManagement) handlespace;
+   ST_CLASS(newBenchmarkHandlespace)(&handlespace, parameters);
+
+   const size_t             poolElements  = parameters.Pools * parameters.PoolElementsPerPool;
+   const unsigned long long expiryTimeout = 1000000ULL * (parameters.Rounds + 1);
+   unsigned long long       now           = 1000000;
+   PoolElementIdentifierType nextIdentifier = poolElements + 1;
+
+   std::vector<struct PoolHandle>                 poolHandleArray(parameters.Pools);
+   std::vector<struct ST_CLASS(PoolElementNode)*> poolElementNodeArray(poolElements, NULL);
+   std::vector<struct ST_CLASS(PoolElementNode)*> selectionArray(parameters.MaxHandleResolutionItems);
+   std::vector<size_t>                            expiredSlotArray;
+   LatencyStatistics                              registrationStatistics;
+   LatencyStatistics                              reregistrationStatistics;
+   LatencyStatistics                              timerStatistics;
+   LatencyStatistics                              purgeStatistics;
+   std::vector<LatencyStatistics>                 handleResolutionStatistics(ST_CLASS(PoolPolicies));
+   std::vector<struct ST_CLASS(HandleResolutionRequest)> burstArray(parameters.BurstSize);
+   std::vector<struct ST_CLASS(PoolElementNode)*> burstSelectionArray(parameters.BurstSize *
+                                                                      parameters.MaxHandleResolutionItems);
+   LatencyStatistics                              burstStatistics;
+   LatencyStatistics                              batchedBurstStatistics;
+
+   // ====== Create pools ===================================================
+   ST_CLASS(createBenchmarkPoolHandles)("BenchmarkPool", poolHandleArray);
+   ST_CLASS(registerBenchmarkPoolElements)(&handlespace, parameters, poolHandleArray, poolElementNodeArray,
+                                           registrationStatistics, timerStatistics,
+                                           expiryTimeout, now);
+
+   // ====== Run rounds =====================================================
+   const size_t changes = (size_t)rint(parameters.Churn * poolElements);
+   for(size_t round = 0;round < parameters.Rounds;round++) {
+      // ====== Let churned pool elements expire ============================
+      expiredSlotArray.clear();
+      for(size_t i = 0;i < changes;i++) {
+         const size_t slot = workloadRandom() % poolElements;
+         if(poolElementNodeArray[slot] != NULL) {
+            const unsigned long long startTimeStamp = getNanoTime();
+            ST_CLASS(poolHandlespaceManagementRestartPoolElementExpiryTimer)(
+               &handlespace, poolElementNodeArray[slot], 0);
+            timerStatistics.add(getNanoTime() - startTimeStamp);
+            poolElementNodeArray[slot] = NULL;
+            expiredSlotArray.push_back(slot);
+         }
+      }
+
+      // ====== Re-register other pool elements =============================
+      for(size_t i = 0;i < changes;i++) {
+         const size_t slot = workloadRandom() % poolElements;
+         if(poolElementNodeArray[slot] != NULL) {
+            const size_t pool = slot / parameters.PoolElementsPerPool;
+            ST_CLASS(registerBenchmarkPoolElement)(
+               &handlespace, &poolHandleArray[pool],
+               ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+               slot, poolElementNodeArray[slot]->Identifier, expiryTimeout, now,
+               &poolElementNodeArray[slot],
+               reregistrationStatistics, timerStatistics);
+         }
+      }
+
+      // ====== Handle resolutions ==========================================
+      for(size_t i = 0;i < parameters.HandleResolutions;i++) {
+         const size_t pool = workloadRandom() % parameters.Pools;
+         size_t       items;
+         const unsigned long long startTimeStamp = getNanoTime();
+         ST_CLASS(poolHandlespaceManagementHandleResolution)(
+            &handlespace, &poolHandleArray[pool],
+            &selectionArray[0], &items,
+            parameters.MaxHandleResolutionItems, parameters.MaxIncrement);
+         handleResolutionStatistics[pool % ST_CLASS(PoolPolicies)].add(getNanoTime() - startTimeStamp);
+         CHECK(items > 0);
+      }
+
+      // ====== Handle resolution bursts for few pools ======================
+      if(parameters.BurstSize > 0) {
+         for(size_t i = 0;i < parameters.BurstSize;i++) {
+            // Like the registrar's, these pool handles are interned
+            const struct PoolHandle* poolHandle = &poolHandleArray[(workloadRandom() % parameters.Pools) & ~(size_t)3];
+            burstArray[i].Handle                   = poolHandleIntern(poolHandle->Handle, poolHandle->Size);
+            burstArray[i].MaxHandleResolutionItems = parameters.MaxHandleResolutionItems;
+            burstArray[i].MaxIncrement             = parameters.MaxIncrement;
+         }
+         unsigned long long startTimeStamp = getNanoTime();
+         for(size_t i = 0;i < parameters.BurstSize;i++) {
+            size_t items;
+            ST_CLASS(poolHandlespaceManagementHandleResolution)(
+               &handlespace, burstArray[i].Handle,
+               &burstSelectionArray[i * parameters.MaxHandleResolutionItems], &items,
+               burstArray[i].MaxHandleResolutionItems, burstArray[i].MaxIncrement);
+            CHECK(items > 0);
+         }
+         burstStatistics.add(getNanoTime() - startTimeStamp);
+
+         startTimeStamp = getNanoTime();
+         const size_t items = ST_CLASS(poolHandlespaceManagementHandleResolutions)(
+                                 &handlespace, &burstArray[0], parameters.BurstSize,
+                                 &burstSelectionArray[0], burstSelectionArray.size());
+         batchedBurstStatistics.add(getNanoTime() - startTimeStamp);
+         CHECK(items >= parameters.BurstSize);
+      }
+
+      // ====== Purge expired pool elements =================================
+      now += 1000000;
+      const unsigned long long startTimeStamp = getNanoTime();
+      const size_t purged = ST_CLASS(poolHandlespaceManagementPurgeExpiredPoolElements)(&handlespace, now);
+      purgeStatistics.add(getNanoTime() - startTimeStamp);
+      CHECK(purged == expiredSlotArray.size());
+
+      // ====== Replace them by new pool elements ===========================
+      for(size_t i = 0;i < expiredSlotArray.size();i++) {
+         const size_t slot = expiredSlotArray[i];
+         const size_t pool = slot / parameters.PoolElementsPerPool;
+         ST_CLASS(registerBenchmarkPoolElement)(
+            &handlespace, &poolHandleArray[pool],
+            ST_CLASS(PoolPolicyArray)[pool % ST_CLASS(PoolPolicies)].Type,
+            slot, nextIdentifier++, expiryTimeout, now,
+            &poolElementNodeArray[slot],
+            registrationStatistics, timerStatistics);
+      }
+   }
+   CHECK(ST_CLASS(poolHandlespaceManagementGetPoolElements)(&handlespace) == poolElements);
+
+   // ====== Print results ==================================================
+   printStatisticsHeader();
+   registrationStatistics.print("RegisterPoolElement (new)");
+   reregistrationStatistics.print("RegisterPoolElement (update)");
+   timerStatistics.print("RestartPoolElementExpiryTimer");
+   purgeStatistics.print("PurgeExpiredPoolElements");
+   for(size_t i = 0;i < ST_CLASS(PoolPolicies);i++) {
+      char name[128];
+      snprintf(name, sizeof(name), "HandleResolution/%s", ST_CLASS(PoolPolicyArray)[i].Name);
+      handleResolutionStatistics[i].print(name);
+   }
+   char name[128];
+   snprintf(name, sizeof(name), "HandleResolution burst of %zu (single)", parameters.BurstSize);
+   burstStatistics.print(name);
+   snprintf(name, sizeof(name), "HandleResolution burst of %zu (batched)", parameters.BurstSize);
+   batchedBurstStatistics.print(name);
+   ST_CLASS(runLayoutBenchmark)(parameters, &handlespace, poolHandleArray);
+
+   ST_CLASS(poolHandlespaceManagementDelete)(&handlespace);
+
+   ST_CLASS(runDrawBenchmark)(parameters);
+   if(parameters.ReaderThreads > 0) {
+      ST_CLASS(runConcurrentBenchmark)(parameters);
+   }
+   if(parameters.Shards > 0) {
+      ST_CLASS(runShardedBenchmark)(parameters);
+   }
+}
+
+
+/* ###### Run checks ##################################################### */
+/*
+   Correctness checks of the handlespace functions, for "-check". They are
+   not part of the benchmark, i.e. the benchmark itself only measures.
+*/
+static void ST_CLASS(runChecks)(const BenchmarkParameters& parameters)
+{
+   ST_CLASS(checkSelectionEquivalence)(parameters);
+   ST_CLASS(checkOwnershipTransfers)(parameters);
+   ST_CLASS(checkMarkAndPurge)(parameters);
+   ST_CLASS(checkBulkRegistration)(parameters);
+   ST_CLASS(checkViewSelection)(parameters);
+   ST_CLASS(checkMemoryUsage)(parameters);
+   ST_CLASS(checkAliasTableSelection)(parameters);
+}
@@ -0,0 +1,478 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "poolhandlespacemanagement.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+
+struct BenchmarkParameters
+{
+   size_t             Pools;
+   size_t             PoolElementsPerPool;
+   size_t             Rounds;
+   double             Churn;
+   size_t             HandleResolutions;
+   size_t             MaxHandleResolutionItems;
+   size_t             MaxIncrement;
+   size_t             BurstSize;
+   size_t             Draws;
+   size_t             MaxDrawPoolElements;
+   size_t             ReaderThreads;
+   unsigned long long ReaderDuration;
+   size_t             Shards;
+   unsigned long long Seed;
+   unsigned long long LoadRange;
+   bool               AliasTable;
+   bool               Check;
+};
+
+
+// ###### Workload random number generator (xorshift64*) ####################
+// One state per thread, for the worker threads of the sharded benchmark
+static thread_local unsigned long long WorkloadRandomState = 1;
+
+static unsigned long long workloadRandom()
+{
+   WorkloadRandomState ^= WorkloadRandomState >> 12;
+   WorkloadRandomState ^= WorkloadRandomState << 25;
+   WorkloadRandomState ^= WorkloadRandomState >> 27;
+   return(WorkloadRandomState * 2685821657736338717ULL);
+}
+
+// PE loads are drawn from [0, WorkloadLoadRange); a small range clusters
+// them, as for PEs of similar utilisation
+static unsigned long long WorkloadLoadRange = 0x100000000ULL;
+
+static unsigned int workloadLoad()
+{
+   return((unsigned int)(workloadRandom() % WorkloadLoadRange));
+}
+
+
+// ###### Handlespace random number generator (xorshift64*) #################
+// The benchmark provides the functions of randomizer.h itself, so that the
+// handlespace's draws are reproducible for a given seed
+static thread_local unsigned long long HandlespaceRandomState = 1;
+
+extern "C" uint64_t random64()
+{
+   HandlespaceRandomState ^= HandlespaceRandomState >> 12;
+   HandlespaceRandomState ^= HandlespaceRandomState << 25;
+   HandlespaceRandomState ^= HandlespaceRandomState >> 27;
+   return(HandlespaceRandomState * 2685821657736338717ULL);
+}
+
+extern "C" uint32_t random32()
+{
+   return((uint32_t)(random64() >> 32));
+}
+
+extern "C" uint16_t random16()
+{
+   return((uint16_t)random32());
+}
+
+extern "C" uint8_t random8()
+{
+   return((uint8_t)random32());
+}
+
+extern "C" double randomDouble()
+{
+   return((double)random32() / 4294967296.0);
+}
+
+extern "C" double randomExpDouble(const double p)
+{
+   return(-p * log(randomDouble()));
+}
+
+
+// ###### Get monotonic time stamp in nanoseconds ###########################
+static inline unsigned long long getNanoTime()
+{
+   timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return((unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec);
+}
+
+
+class LatencyStatistics
+{
+   public:
+   LatencyStatistics();
+
+   inline void add(const unsigned long long latency) {
+      Samples.push_back(latency);
+      Total += latency;
+   }
+   void print(const char* name);
+
+   private:
+   std::vector<unsigned long long> Samples;
+   unsigned long long              Total;
+};
+
+
+// ###### Constructor #######################################################
+LatencyStatistics::LatencyStatistics()
+{
+   Total = 0;
+}
+
+
+// ###### Print operation rate and latency percentiles ######################
+void LatencyStatistics::print(const char* name)
+{
+   if(Samples.size() == 0) {
+      printf("%-56s %10u %12s\n", name, 0, "-");
+      return;
+   }
+   std::sort(Samples.begin(), Samples.end());
+   const double percentiles[4] = { 0.50, 0.90, 0.99, 0.999 };
+   unsigned long long value[4];
+   for(unsigned int i = 0;i < 4;i++) {
+      value[i] = Samples[(size_t)(percentiles[i] * (Samples.size() - 1))];
+   }
+   printf("%-56s %10zu %12.0f %9llu %9llu %9llu %9llu %9llu\n",
+          name, Samples.size(),
+          (Total > 0) ? (1000000000.0 * Samples.size()) / (double)Total : 0.0,
+          value[0], value[1], value[2], value[3], Samples.back());
+}
+
+
+// Result of a reader thread of the concurrent benchmark, on its own cache line
+struct alignas(64) ConcurrentReaderResult
+{
+   unsigned long long Resolutions;
+   unsigned long long Duration;
+};
+
+// Result of a worker thread of the sharded benchmark, on its own cache line
+struct alignas(64) ShardedWorkerResult
+{
+   unsigned long long Operations;
+   unsigned long long Duration;
+};
+
+
+// ###### Print statistics table header #####################################
+static void printStatisticsHeader()
+{
+   printf("%-56s %10s %12s %9s %9s %9s %9s %9s\n",
+          "Operation", "Ops", "Ops/s",
+          "p50/ns", "p90/ns", "p99/ns", "p99.9/ns", "max/ns");
+}
+
+
+
+#ifdef INCLUDE_LINEARLIST
+#define ST_CLASS(x) x##_LinearList
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_SIMPLEBINARYTREE
+#define ST_CLASS(x) x##_SimpleBinaryTree
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_LEAFLINKEDBINARYTREE
+#define ST_CLASS(x) x##_LeafLinkedBinaryTree
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_SIMPLETREAP
+#define ST_CLASS(x) x##_SimpleTreap
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_LEAFLINKEDTREAP
+#define ST_CLASS(x) x##_LeafLinkedTreap
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_SIMPLEREDBLACKTREE
+#define ST_CLASS(x) x##_SimpleRedBlackTree
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_LEAFLINKEDREDBLACKTREE
+#define ST_CLASS(x) x##_LeafLinkedRedBlackTree
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_COMPACTREDBLACKTREE
+#define ST_CLASS(x) x##_CompactRedBlackTree
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_BPLUSTREE
+#define ST_CLASS(x) x##_BPlusTree
+#include "handlespacebenchmark-template_impl.h"
+#undef ST_CLASS
+#endif
+
+
+struct Backend
+{
+   const char* Name;
+   void (*BenchmarkFunction)(const BenchmarkParameters& parameters);
+   void (*CheckFunction)(const BenchmarkParameters& parameters);
+};
+
+static const Backend BackendArray[] =
+{
+#ifdef INCLUDE_LINEARLIST
+   { "LinearList",             &runBenchmark_LinearList,             &runChecks_LinearList             },
+#endif
+#ifdef INCLUDE_SIMPLEBINARYTREE
+   { "SimpleBinaryTree",       &runBenchmark_SimpleBinaryTree,       &runChecks_SimpleBinaryTree       },
+#endif
+#ifdef INCLUDE_LEAFLINKEDBINARYTREE
+   { "LeafLinkedBinaryTree",   &runBenchmark_LeafLinkedBinaryTree,   &runChecks_LeafLinkedBinaryTree   },
+#endif
+#ifdef INCLUDE_SIMPLETREAP
+   { "SimpleTreap",            &runBenchmark_SimpleTreap,            &runChecks_SimpleTreap            },
+#endif
+#ifdef INCLUDE_LEAFLINKEDTREAP
+   { "LeafLinkedTreap",        &runBenchmark_LeafLinkedTreap,        &runChecks_LeafLinkedTreap        },
+#endif
+#ifdef INCLUDE_SIMPLEREDBLACKTREE
+   { "SimpleRedBlackTree",     &runBenchmark_SimpleRedBlackTree,     &runChecks_SimpleRedBlackTree     },
+#endif
+#ifdef INCLUDE_LEAFLINKEDREDBLACKTREE
+   { "LeafLinkedRedBlackTree", &runBenchmark_LeafLinkedRedBlackTree, &runChecks_LeafLinkedRedBlackTree },
+#endif
+#ifdef INCLUDE_COMPACTREDBLACKTREE
+   { "CompactRedBlackTree",    &runBenchmark_CompactRedBlackTree,    &runChecks_CompactRedBlackTree    },
+#endif
+#ifdef INCLUDE_BPLUSTREE
+   { "BPlusTree",              &runBenchmark_BPlusTree,              &runChecks_BPlusTree              },
+#endif
+};
+static const size_t Backends = sizeof(BackendArray) / sizeof(BackendArray[0]);
+
+
+// ###### Run benchmark or checks of one backend in its own process #########
+static bool runBackend(const Backend& backend, const BenchmarkParameters& parameters)
+{
+   printf("\n====== %s%s: %zu pools x %zu pool elements, %zu rounds, churn %1.1f%% ======\n",
+          backend.Name, (parameters.Check) ? " checks" : "",
+          parameters.Pools, parameters.PoolElementsPerPool,
+          parameters.Rounds, 100.0 * parameters.Churn);
+   fflush(stdout);
+
+   // ====== Use a child process, to get the peak RSS of this backend ======
+   const pid_t pid = fork();
+   if(pid < 0) {
+      perror("fork() failed");
+      return(false);
+   }
+   else if(pid == 0) {
+      WorkloadRandomState    = parameters.Seed;
+      HandlespaceRandomState = parameters.Seed;
+      WorkloadLoadRange      = parameters.LoadRange;
+      if(parameters.Check) {
+         backend.CheckFunction(parameters);
+      }
+      else {
+         backend.BenchmarkFunction(parameters);
+      }
+      fflush(stdout);
+      _exit(0);
+   }
+
+   int           status;
+   struct rusage usage;
+   if(wait4(pid, &status, 0, &usage) != pid) {
+      perror("wait4() failed");
+      return(false);
+   }
+   if( (!WIFEXITED(status)) || (WEXITSTATUS(status) != 0) ) {
+      fprintf(stderr, "ERROR: Benchmark of %s failed!\n", backend.Name);
+      return(false);
+   }
+   printf("Peak RSS: %ld KiB\n", usage.ru_maxrss);
+   return(true);
+}
+
+
+// ###### Parse numeric option ##############################################
+static bool getNumberOption(const char* arg, const char* option,
+                            double& value, const double minValue, const double maxValue)
+{
+   const size_t length = strlen(option);
+   if(strncmp(arg, option, length) != 0) {
+      return(false);
+   }
+   char* endptr;
+   value = strtod(&arg[length], &endptr);
+   if( (endptr == &arg[length]) || (*endptr != 0x00) ||
+       (value < minValue) || (value > maxValue) ) {
+      fprintf(stderr, "ERROR: Invalid value for %s (must be in [%g, %g])!\n",
+              option, minValue, maxValue);
+      exit(1);
+   }
+   return(true);
+}
+
+
+
+int main(int argc, char** argv)
+{
+   BenchmarkParameters parameters;
+   parameters.Pools                    = 36;
+   parameters.PoolElementsPerPool      = 100;
+   parameters.Rounds                   = 100;
+   parameters.Churn                    = 0.1;
+   parameters.HandleResolutions        = 1000;
+   parameters.MaxHandleResolutionItems = 3;
+   parameters.MaxIncrement             = 1;
+   parameters.BurstSize                = 16;
+   parameters.Draws                    = 100000;
+   parameters.MaxDrawPoolElements      = 100000;
+   parameters.ReaderThreads            = 0;
+   parameters.ReaderDuration           = 1000000000ULL;
+   parameters.Shards                   = 0;
+   parameters.Seed                     = 1;
+   parameters.LoadRange                = 0x100000000ULL;
+   parameters.AliasTable               = false;
+   parameters.Check                    = false;
+
+   // ====== Handle arguments ===============================================
+   std::vector<const Backend*> selectedBackends;
+   for(int i = 1;i < argc;i++) {
+      double value;
+      if(getNumberOption(argv[i], "-pools=", value, 1, 1000000)) {
+         parameters.Pools = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-poolelements=", value, 1, 10000000)) {
+         parameters.PoolElementsPerPool = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-rounds=", value, 0, 1000000000)) {
+         parameters.Rounds = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-churn=", value, 0.0, 1.0)) {
+         parameters.Churn = value;
+      }
+      else if(getNumberOption(argv[i], "-handleresolutions=", value, 0, 1000000000)) {
+         parameters.HandleResolutions = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-maxhandleresolutionitems=", value, 1, 1000000)) {
+         parameters.MaxHandleResolutionItems = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-maxincrement=", value, 0, 1000000)) {
+         parameters.MaxIncrement = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-burstsize=", value, 0, 1000000)) {
+         parameters.BurstSize = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-draws=", value, 0, 1000000000)) {
+         parameters.Draws = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-maxdrawpoolelements=", value, 10, 10000000)) {
+         parameters.MaxDrawPoolElements = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-readerthreads=", value, 0, EPOCHRECLAMATION_MAX_READERS)) {
+         parameters.ReaderThreads = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-readerduration=", value, 0.001, 3600.0)) {
+         parameters.ReaderDuration = (unsigned long long)(value * 1000000000.0);
+      }
+      else if(getNumberOption(argv[i], "-shards=", value, 0, SHARDEDHANDLESPACE_MAX_SHARDS)) {
+         parameters.Shards = (size_t)value;
+      }
+      else if(getNumberOption(argv[i], "-seed=", value, 1, 1e18)) {
+         parameters.Seed = (unsigned long long)value;
+      }
+      else if(getNumberOption(argv[i], "-loadrange=", value, 1, 4294967296.0)) {
+         parameters.LoadRange = (unsigned long long)value;
+      }
+      else if(strcmp(argv[i], "-aliastable") == 0) {
+         parameters.AliasTable = true;
+      }
+      else if(strcmp(argv[i], "-check") == 0) {
+         parameters.Check = true;
+      }
+      else if(strncmp(argv[i], "-backend=", 9) == 0) {
+         size_t j;
+         for(j = 0;j < Backends;j++) {
+            if(strcmp(BackendArray[j].Name, &argv[i][9]) == 0) {
+               selectedBackends.push_back(&BackendArray[j]);
+               break;
+            }
+         }
+         if(j >= Backends) {
+            fprintf(stderr, "ERROR: Unknown backend %s! Available backends:", &argv[i][9]);
+            for(j = 0;j < Backends;j++) {
+               fprintf(stderr, " %s", BackendArray[j].Name);
+            }
+            fputs("\n", stderr);
+            exit(1);
+         }
+      }
+      else {
+         fprintf(stderr, "Usage: %s [-backend=name ...] [-check] [-pools=N] [-poolelements=N] [-rounds=N] [-churn=fraction] [-handleresolutions=N] [-maxhandleresolutionitems=N] [-maxincrement=N] [-burstsize=N] [-draws=N] [-maxdrawpoolelements=N] [-readerthreads=N] [-readerduration=seconds] [-shards=N] [-seed=N] [-loadrange=N] [-aliastable]\n",
+                 argv[0]);
+         exit(1);
+      }
+   }
+   if(selectedBackends.size() == 0) {
+      for(size_t j = 0;j < Backends;j++) {
+         selectedBackends.push_back(&BackendArray[j]);
+      }
+   }
+
+   // ====== Check vectorised checksum functions ============================
+   if( (parameters.Check) && (!handlespaceChecksumSelfTest()) ) {
+      fputs("ERROR: Handlespace checksum self-test failed!\n", stderr);
+      return(1);
+   }
+
+   // ====== Run benchmarks or checks =======================================
+   bool success = true;
+   for(size_t j = 0;j < selectedBackends.size();j++) {
+      success &= runBackend(*selectedBackends[j], parameters);
+   }
+   return(success ? 0 : 1);
+}
@@ -125,9 +125,13 @@ struct BT_DEFINITION(BinaryTreeNode)* BT_FUNCTION(BinaryTreeGetNearestNext)(
                                          const struct BT_DEFINITION(BinaryTree)*     bt,
                                          const struct BT_DEFINITION(BinaryTreeNode)* cmpNode);
 size_t BT_FUNCTION(BinaryTreeGetElements)(const struct BT_DEFINITION(BinaryTree)* bt);
+size_t BT_FUNCTION(BinaryTreeGetMemoryUsage)(const struct BT_DEFINITION(BinaryTree)* bt);
 struct BT_DEFINITION(BinaryTreeNode)* BT_FUNCTION(BinaryTreeInsert)(
                                          struct BT_DEFINITION(BinaryTree)*     bt,
                                          struct BT_DEFINITION(BinaryTreeNode)* node);
+void BT_FUNCTION(BinaryTreeBuild)(struct BT_DEFINITION(BinaryTree)*      bt,
+                                  struct BT_DEFINITION(BinaryTreeNode)** nodeArray,
+                                  const size_t                           nodes);
 struct BT_DEFINITION(BinaryTreeNode)* BT_FUNCTION(BinaryTreeRemove)(
                                          struct BT_DEFINITION(BinaryTree)*     bt,
                                          struct BT_DEFINITION(BinaryTreeNode)* node);
@@ -482,6 +482,15 @@ size_t BT_FUNCTION(BinaryTreeGetElements)(
 }
 
 
+/* ###### Get number of bytes allocated besides the nodes ################# */
+/* The tree only links the nodes embedded into the elements. */
+size_t BT_FUNCTION(BinaryTreeGetMemoryUsage)(
+          const struct BT_DEFINITION(BinaryTree)* bt)
+{
+   return(0);
+}
+
+
 /* ###### Get prev node by walking through the tree (does *not* use list!) */
 static struct BT_DEFINITION(BinaryTreeNode)* BT_FUNCTION(BinaryTreeInternalFindPrev)(
                                                 const struct BT_DEFINITION(BinaryTree)*     bt,
@@ -639,13 +648,68 @@ finished:
 #ifdef DEBUG
    BT_FUNCTION(BinaryTreePrint)(bt, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
    BT_FUNCTION(BinaryTreeVerify)(bt);
 #endif
    return(result);
 }
 
 
+/* ###### Build balanced subtree from sorted node array ################# */
+static struct BT_DEFINITION(BinaryTreeNode)* BT_FUNCTION(BinaryTreeInternalBuild)(
+                                                struct BT_DEFINITION(BinaryTree)*      bt,
+                                                struct BT_DEFINITION(BinaryTreeNode)*  parent,
+                                                struct BT_DEFINITION(BinaryTreeNode)** nodeArray,
+                                                const size_t                           nodes)
+{
+   struct BT_DEFINITION(BinaryTreeNode)* node;
+   const size_t                          middle = nodes / 2;
+
+   if(nodes == 0) {
+      return(&bt->NullNode);
+   }
+   node               = nodeArray[middle];
+   node->Parent       = parent;
+   node->LeftSubtree  = BT_FUNCTION(BinaryTreeInternalBuild)(bt, node, nodeArray, middle);
+   node->RightSubtree = BT_FUNCTION(BinaryTreeInternalBuild)(bt, node, &nodeArray[middle + 1],
+                                                             nodes - middle - 1);
+   BT_FUNCTION(BinaryTreeUpdateValueSum)(node);
+   return(node);
+}
+
+
+/* ###### Build tree from sorted node array ############################## */
+/*
+   nodeArray has to be sorted by the comparison function, without
+   duplicates. It has to contain all nodes currently in the tree.
+*/
+void BT_FUNCTION(BinaryTreeBuild)(struct BT_DEFINITION(BinaryTree)*      bt,
+                                  struct BT_DEFINITION(BinaryTreeNode)** nodeArray,
+                                  const size_t                           nodes)
+{
+#ifdef USE_LEAFLINKED
+   size_t i;
+
+   doubleLinkedRingListNew(&bt->List);
+   for(i = 0;i < nodes;i++) {
+      doubleLinkedRingListAddTail(&bt->List, &nodeArray[i]->ListNode);
+   }
+#endif
+   bt->NullNode.Parent       = &bt->NullNode;
+   bt->NullNode.RightSubtree = &bt->NullNode;
+   bt->NullNode.LeftSubtree  = BT_FUNCTION(BinaryTreeInternalBuild)(bt, &bt->NullNode,
+                                                                    nodeArray, nodes);
+   bt->Elements              = nodes;
+
+#ifdef DEBUG
+   BT_FUNCTION(BinaryTreePrint)(bt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   BT_FUNCTION(BinaryTreeVerify)(bt);
+#endif
+}
+
+
 /* ###### Remove ######################################################### */
 struct BT_DEFINITION(BinaryTreeNode)* BT_FUNCTION(BinaryTreeRemove)(
                                          struct BT_DEFINITION(BinaryTree)*     bt,
@@ -733,7 +797,7 @@ struct BT_DEFINITION(BinaryTreeNode)* BT_FUNCTION(BinaryTreeRemove)(
 #ifdef DEBUG
     BT_FUNCTION(BinaryTreePrint)(bt, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
     BT_FUNCTION(BinaryTreeVerify)(bt);
 #endif
    return(node);
@@ -0,0 +1,934 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bplustree.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ###### Initialize ##################################################### */
+void bPlusTreeNodeNew(struct BPlusTreeNode* node)
+{
+   node->Block = NULL;
+   node->Value = 0;
+   node->Slot  = 0;
+}
+
+
+/* ###### Invalidate ##################################################### */
+void bPlusTreeNodeDelete(struct BPlusTreeNode* node)
+{
+   node->Block = NULL;
+   node->Value = 0;
+   node->Slot  = 0;
+}
+
+
+/* ###### Is node linked? ################################################ */
+int bPlusTreeNodeIsLinked(const struct BPlusTreeNode* node)
+{
+   return(node->Block != NULL);
+}
+
+
+/* ###### Initialize ##################################################### */
+void bPlusTreeNew(struct BPlusTree* bpt,
+                  void              (*printFunction)(const void* node, FILE* fd),
+                  int               (*comparisonFunction)(const void* node1, const void* node2))
+{
+   bpt->Root               = NULL;
+   bpt->FirstLeaf          = NULL;
+   bpt->LastLeaf           = NULL;
+   bpt->Elements           = 0;
+   bpt->PrintFunction      = printFunction;
+   bpt->ComparisonFunction = comparisonFunction;
+}
+
+
+/* ###### Free block and all its children ################################ */
+static void bPlusTreeDeleteBlock(struct BPlusTreeBlock* block)
+{
+   unsigned int i;
+
+   if(block->IsLeaf) {
+      for(i = 0;i < block->Entries;i++) {
+         block->Node[i]->Block = NULL;
+      }
+   }
+   else {
+      for(i = 0;i < block->Entries;i++) {
+         bPlusTreeDeleteBlock(block->Child[i]);
+      }
+   }
+   free(block);
+}
+
+
+/* ###### Invalidate ##################################################### */
+void bPlusTreeDelete(struct BPlusTree* bpt)
+{
+   if(bpt->Root) {
+      bPlusTreeDeleteBlock(bpt->Root);
+   }
+   bpt->Root      = NULL;
+   bpt->FirstLeaf = NULL;
+   bpt->LastLeaf  = NULL;
+   bpt->Elements  = 0;
+}
+
+
+/* ###### Allocate new block ############################################# */
+static struct BPlusTreeBlock* bPlusTreeNewBlock(const unsigned int isLeaf)
+{
+   struct BPlusTreeBlock* block = (struct BPlusTreeBlock*)malloc(sizeof(struct BPlusTreeBlock));
+   CHECK(block != NULL);
+   block->Parent   = NULL;
+   block->PrevLeaf = NULL;
+   block->NextLeaf = NULL;
+   block->ValueSum = 0;
+   block->Entries    = 0;
+   block->IsLeaf     = isLeaf;
+   block->ParentSlot = 0;
+   return(block);
+}
+
+
+/* ###### Get slot of child block within its parent ###################### */
+inline static unsigned int bPlusTreeGetChildSlot(const struct BPlusTreeBlock* parent,
+                                                 const struct BPlusTreeBlock* child)
+{
+   CHECK(child->ParentSlot < parent->Entries);
+   CHECK(parent->Child[child->ParentSlot] == child);
+   return(child->ParentSlot);
+}
+
+
+/* ###### Renumber slots of the nodes of a leaf block ################### */
+inline static void bPlusTreeUpdateNodeSlots(struct BPlusTreeBlock* leaf,
+                                            unsigned int           slot)
+{
+   for(;slot < leaf->Entries;slot++) {
+      leaf->Node[slot]->Slot = slot;
+   }
+}
+
+
+/* ###### Renumber parent slots of the children of an inner block ####### */
+inline static void bPlusTreeUpdateChildSlots(struct BPlusTreeBlock* block,
+                                             unsigned int           slot)
+{
+   for(;slot < block->Entries;slot++) {
+      block->Child[slot]->ParentSlot = slot;
+   }
+}
+
+
+/* ###### Insert entry into block ######################################## */
+static void bPlusTreeInsertEntry(struct BPlusTreeBlock*       block,
+                                 const unsigned int           slot,
+                                 struct BPlusTreeNode*        node,
+                                 struct BPlusTreeBlock*       child,
+                                 const BPlusTreeNodeValueType sum)
+{
+   const size_t moved = block->Entries - slot;
+
+   CHECK(block->Entries < BPLUSTREE_MAX_ENTRIES);
+   CHECK(slot <= block->Entries);
+   memmove(&block->Sum[slot + 1], &block->Sum[slot], moved * sizeof(block->Sum[0]));
+   memmove(&block->Node[slot + 1], &block->Node[slot], moved * sizeof(block->Node[0]));
+   block->Sum[slot]  = sum;
+   block->Node[slot] = node;
+   block->Entries++;
+   block->ValueSum += sum;
+   if(block->IsLeaf) {
+      node->Block = block;
+      bPlusTreeUpdateNodeSlots(block, slot);
+   }
+   else {
+      memmove(&block->Child[slot + 1], &block->Child[slot], moved * sizeof(block->Child[0]));
+      block->Child[slot] = child;
+      child->Parent      = block;
+      bPlusTreeUpdateChildSlots(block, slot);
+   }
+}
+
+
+/* ###### Insert child block into inner block ############################ */
+inline static void bPlusTreeInsertChild(struct BPlusTreeBlock* block,
+                                        const unsigned int     slot,
+                                        struct BPlusTreeBlock* child)
+{
+   bPlusTreeInsertEntry(block, slot, child->Node[0], child, child->ValueSum);
+}
+
+
+/* ###### Remove entry from block ######################################## */
+static void bPlusTreeRemoveEntry(struct BPlusTreeBlock* block,
+                                 const unsigned int     slot)
+{
+   const size_t moved = block->Entries - slot - 1;
+
+   CHECK(slot < block->Entries);
+   block->ValueSum -= block->Sum[slot];
+   memmove(&block->Sum[slot], &block->Sum[slot + 1], moved * sizeof(block->Sum[0]));
+   memmove(&block->Node[slot], &block->Node[slot + 1], moved * sizeof(block->Node[0]));
+   block->Entries--;
+   if(block->IsLeaf) {
+      bPlusTreeUpdateNodeSlots(block, slot);
+   }
+   else {
+      memmove(&block->Child[slot], &block->Child[slot + 1], moved * sizeof(block->Child[0]));
+      bPlusTreeUpdateChildSlots(block, slot);
+   }
+}
+
+
+/* ###### Move entry from one block to another ########################### */
+static void bPlusTreeMoveEntry(struct BPlusTreeBlock* destination,
+                               const unsigned int     destinationSlot,
+                               struct BPlusTreeBlock* source,
+                               const unsigned int     sourceSlot)
+{
+   struct BPlusTreeNode*        node  = source->Node[sourceSlot];
+   struct BPlusTreeBlock*       child = (source->IsLeaf) ? NULL : source->Child[sourceSlot];
+   const BPlusTreeNodeValueType sum   = source->Sum[sourceSlot];
+
+   bPlusTreeRemoveEntry(source, sourceSlot);
+   bPlusTreeInsertEntry(destination, destinationSlot, node, child, sum);
+}
+
+
+/* ###### Update cached entry of child block in its parent ############### */
+inline static void bPlusTreeUpdateEntry(struct BPlusTreeBlock* parent,
+                                        const unsigned int     slot)
+{
+   const struct BPlusTreeBlock* child = parent->Child[slot];
+   parent->ValueSum    += child->ValueSum - parent->Sum[slot];
+   parent->Sum[slot]    = child->ValueSum;
+   parent->Node[slot]   = child->Node[0];
+}
+
+
+/* ###### Update cached entries from block up to the root ################ */
+static void bPlusTreeUpdateEntriesUpToRoot(struct BPlusTreeBlock* block)
+{
+   while(block->Parent != NULL) {
+      bPlusTreeUpdateEntry(block->Parent,
+                           bPlusTreeGetChildSlot(block->Parent, block));
+      block = block->Parent;
+   }
+}
+
+
+/* ###### Split full block into two halves ############################### */
+static struct BPlusTreeBlock* bPlusTreeSplitBlock(struct BPlusTree*      bpt,
+                                                  struct BPlusTreeBlock* block)
+{
+   struct BPlusTreeBlock* right = bPlusTreeNewBlock(block->IsLeaf);
+
+   while(block->Entries > BPLUSTREE_MIN_ENTRIES) {
+      bPlusTreeMoveEntry(right, right->Entries, block, BPLUSTREE_MIN_ENTRIES);
+   }
+   if(block->IsLeaf) {
+      right->PrevLeaf = block;
+      right->NextLeaf = block->NextLeaf;
+      if(block->NextLeaf) {
+         block->NextLeaf->PrevLeaf = right;
+      }
+      else {
+         bpt->LastLeaf = right;
+      }
+      block->NextLeaf = right;
+   }
+   return(right);
+}
+
+
+/* ###### Link new right sibling into the parent of a split block ######## */
+static void bPlusTreeInsertIntoParent(struct BPlusTree*      bpt,
+                                      struct BPlusTreeBlock* left,
+                                      struct BPlusTreeBlock* right)
+{
+   struct BPlusTreeBlock* parent = left->Parent;
+   struct BPlusTreeBlock* parentRight;
+   unsigned int           slot;
+
+   /* ====== Split of the root: tree grows by one level =================== */
+   if(parent == NULL) {
+      parent = bPlusTreeNewBlock(0);
+      bPlusTreeInsertChild(parent, 0, left);
+      bPlusTreeInsertChild(parent, 1, right);
+      bpt->Root = parent;
+      return;
+   }
+
+   slot = bPlusTreeGetChildSlot(parent, left) + 1;
+   if(parent->Entries < BPLUSTREE_MAX_ENTRIES) {
+      bPlusTreeInsertChild(parent, slot, right);
+      bPlusTreeUpdateEntry(parent, slot - 1);
+      bPlusTreeUpdateEntriesUpToRoot(parent);
+   }
+   else {
+      /* ====== Parent is full: split it as well ========================== */
+      parentRight = bPlusTreeSplitBlock(bpt, parent);
+      if(slot > parent->Entries) {
+         bPlusTreeInsertChild(parentRight, slot - parent->Entries, right);
+      }
+      else {
+         bPlusTreeInsertChild(parent, slot, right);
+      }
+      /* left and right always end up in the same half */
+      bPlusTreeUpdateEntry(left->Parent, bPlusTreeGetChildSlot(left->Parent, left));
+      bPlusTreeInsertIntoParent(bpt, parent, parentRight);
+   }
+}
+
+
+/* ###### Rebalance block after removal of an entry ###################### */
+static void bPlusTreeRebalance(struct BPlusTree*      bpt,
+                               struct BPlusTreeBlock* block)
+{
+   struct BPlusTreeBlock* parent = block->Parent;
+   struct BPlusTreeBlock* left;
+   struct BPlusTreeBlock* right;
+   unsigned int           slot;
+
+   /* ====== Root block: shrink tree, if necessary ======================== */
+   if(parent == NULL) {
+      if(block->Entries == 0) {
+         CHECK(block->IsLeaf);
+         bpt->Root      = NULL;
+         bpt->FirstLeaf = NULL;
+         bpt->LastLeaf  = NULL;
+         free(block);
+      }
+      else if((!block->IsLeaf) && (block->Entries == 1)) {
+         bpt->Root                   = block->Child[0];
+         block->Child[0]->Parent     = NULL;
+         block->Child[0]->ParentSlot = 0;
+         free(block);
+      }
+      return;
+   }
+
+   /* ====== Block is still filled sufficiently =========================== */
+   if(block->Entries >= BPLUSTREE_MIN_ENTRIES) {
+      bPlusTreeUpdateEntriesUpToRoot(block);
+      return;
+   }
+
+   slot  = bPlusTreeGetChildSlot(parent, block);
+   left  = (slot > 0) ? parent->Child[slot - 1] : NULL;
+   right = (slot + 1 < parent->Entries) ? parent->Child[slot + 1] : NULL;
+   CHECK((left != NULL) || (right != NULL));
+
+   /* ====== Borrow an entry from a sibling =============================== */
+   if((left != NULL) && (left->Entries > BPLUSTREE_MIN_ENTRIES)) {
+      bPlusTreeMoveEntry(block, 0, left, left->Entries - 1);
+      bPlusTreeUpdateEntry(parent, slot - 1);
+      bPlusTreeUpdateEntry(parent, slot);
+      bPlusTreeUpdateEntriesUpToRoot(parent);
+      return;
+   }
+   if((right != NULL) && (right->Entries > BPLUSTREE_MIN_ENTRIES)) {
+      bPlusTreeMoveEntry(block, block->Entries, right, 0);
+      bPlusTreeUpdateEntry(parent, slot);
+      bPlusTreeUpdateEntry(parent, slot + 1);
+      bPlusTreeUpdateEntriesUpToRoot(parent);
+      return;
+   }
+
+   /* ====== Merge with a sibling ========================================= */
+   if(left == NULL) {
+      left  = block;
+      slot++;
+   }
+   else {
+      right = block;
+   }
+   while(right->Entries > 0) {
+      bPlusTreeMoveEntry(left, left->Entries, right, 0);
+   }
+   if(right->IsLeaf) {
+      left->NextLeaf = right->NextLeaf;
+      if(right->NextLeaf) {
+         right->NextLeaf->PrevLeaf = left;
+      }
+      else {
+         bpt->LastLeaf = left;
+      }
+   }
+   bPlusTreeRemoveEntry(parent, slot);
+   free(right);
+   bPlusTreeUpdateEntry(parent, slot - 1);
+   bPlusTreeRebalance(bpt, parent);
+}
+
+
+/* ###### Internal verification function ################################# */
+static void bPlusTreeInternalVerify(struct BPlusTree*             bpt,
+                                    const struct BPlusTreeBlock*  block,
+                                    const unsigned int            depth,
+                                    unsigned int*                 leafDepth,
+                                    const struct BPlusTreeBlock** lastLeaf,
+                                    const struct BPlusTreeNode**  lastNode,
+                                    size_t*                       counter)
+{
+   BPlusTreeNodeValueType valueSum = 0;
+   unsigned int           i;
+
+   CHECK(block->Entries <= BPLUSTREE_MAX_ENTRIES);
+   if(block != bpt->Root) {
+      CHECK(block->Entries >= BPLUSTREE_MIN_ENTRIES);
+   }
+   else {
+      CHECK(block->Parent == NULL);
+      CHECK(block->Entries >= ((block->IsLeaf) ? 1 : 2));
+   }
+
+   for(i = 0;i < block->Entries;i++) {
+      valueSum += block->Sum[i];
+      if(block->IsLeaf) {
+         /* ====== Check node ============================================ */
+         CHECK(block->Node[i]->Block == block);
+         CHECK(block->Node[i]->Slot == i);
+         CHECK(block->Sum[i] == block->Node[i]->Value);
+         if(*lastNode != NULL) {
+            CHECK(bpt->ComparisonFunction(*lastNode, block->Node[i]) < 0);
+         }
+         *lastNode = block->Node[i];
+         (*counter)++;
+      }
+      else {
+         /* ====== Check child block ===================================== */
+         CHECK(block->Child[i]->Parent == block);
+         CHECK(block->Child[i]->ParentSlot == i);
+         CHECK(block->Child[i]->IsLeaf == block->Child[0]->IsLeaf);
+         CHECK(block->Child[i]->ValueSum == block->Sum[i]);
+         CHECK(block->Child[i]->Node[0] == block->Node[i]);
+         bPlusTreeInternalVerify(bpt, block->Child[i], depth + 1,
+                                 leafDepth, lastLeaf, lastNode, counter);
+      }
+   }
+   CHECK(valueSum == block->ValueSum);
+
+   /* ====== Check leaf depth and leaf links ============================== */
+   if(block->IsLeaf) {
+      if(*leafDepth == 0) {
+         *leafDepth = depth;
+      }
+      CHECK(*leafDepth == depth);
+      CHECK(block->PrevLeaf == *lastLeaf);
+      if(*lastLeaf != NULL) {
+         CHECK((*lastLeaf)->NextLeaf == block);
+      }
+      else {
+         CHECK(bpt->FirstLeaf == block);
+      }
+      *lastLeaf = block;
+   }
+}
+
+
+/* ###### Verify structures ############################################## */
+void bPlusTreeVerify(struct BPlusTree* bpt)
+{
+   size_t                       counter   = 0;
+   unsigned int                 leafDepth = 0;
+   const struct BPlusTreeBlock* lastLeaf  = NULL;
+   const struct BPlusTreeNode*  lastNode  = NULL;
+
+   if(bpt->Root != NULL) {
+      bPlusTreeInternalVerify(bpt, bpt->Root, 1, &leafDepth,
+                              &lastLeaf, &lastNode, &counter);
+      CHECK(lastLeaf == bpt->LastLeaf);
+      CHECK(lastLeaf->NextLeaf == NULL);
+   }
+   else {
+      CHECK(bpt->FirstLeaf == NULL);
+      CHECK(bpt->LastLeaf == NULL);
+   }
+   CHECK(counter == bpt->Elements);
+}
+
+
+/* ###### Print ########################################################## */
+void bPlusTreePrint(const struct BPlusTree* bpt, FILE* fd)
+{
+   const struct BPlusTreeBlock* leaf;
+   unsigned int                 i;
+
+   fprintf(fd, "B+ Tree: ");
+   for(leaf = bpt->FirstLeaf;leaf != NULL;leaf = leaf->NextLeaf) {
+#ifdef DEBUG
+      fprintf(fd, "\n[leaf=%p parent=%p vsum=%llu] ",
+              leaf, leaf->Parent, leaf->ValueSum);
+#endif
+      for(i = 0;i < leaf->Entries;i++) {
+         bpt->PrintFunction(leaf->Node[i], fd);
+         fprintf(fd, " ");
+#ifdef DEBUG
+         fprintf(fd, " v=%llu   ", leaf->Node[i]->Value);
+#endif
+      }
+   }
+   fputs("\n", fd);
+}
+
+
+/* ###### Is tree empty? ################################################# */
+int bPlusTreeIsEmpty(const struct BPlusTree* bpt)
+{
+   return(bpt->Root == NULL);
+}
+
+
+/* ###### Get first node ################################################# */
+struct BPlusTreeNode* bPlusTreeGetFirst(const struct BPlusTree* bpt)
+{
+   if(bpt->FirstLeaf != NULL) {
+      return(bpt->FirstLeaf->Node[0]);
+   }
+   return(NULL);
+}
+
+
+/* ###### Get last node ################################################## */
+struct BPlusTreeNode* bPlusTreeGetLast(const struct BPlusTree* bpt)
+{
+   if(bpt->LastLeaf != NULL) {
+      return(bpt->LastLeaf->Node[bpt->LastLeaf->Entries - 1]);
+   }
+   return(NULL);
+}
+
+
+/* ###### Get previous node ############################################## */
+struct BPlusTreeNode* bPlusTreeGetPrev(const struct BPlusTree*     bpt,
+                                       const struct BPlusTreeNode* node)
+{
+   const struct BPlusTreeBlock* leaf = node->Block;
+
+   (void)bpt;
+   if(node->Slot > 0) {
+      return(leaf->Node[node->Slot - 1]);
+   }
+   else if(leaf->PrevLeaf != NULL) {
+      return(leaf->PrevLeaf->Node[leaf->PrevLeaf->Entries - 1]);
+   }
+   return(NULL);
+}
+
+
+/* ###### Get next node ################################################## */
+struct BPlusTreeNode* bPlusTreeGetNext(const struct BPlusTree*     bpt,
+                                       const struct BPlusTreeNode* node)
+{
+   const struct BPlusTreeBlock* leaf = node->Block;
+
+   (void)bpt;
+   if(node->Slot + 1 < leaf->Entries) {
+      return(leaf->Node[node->Slot + 1]);
+   }
+   else if(leaf->NextLeaf != NULL) {
+      return(leaf->NextLeaf->Node[0]);
+   }
+   return(NULL);
+}
+
+
+/* ###### Get number of entries of block smaller or equal to cmpNode ##### */
+/*
+   Binary search within the block; *found is set if Node[result - 1]
+   is equal to cmpNode.
+*/
+static unsigned int bPlusTreeSearchBlock(const struct BPlusTree*      bpt,
+                                         const struct BPlusTreeBlock* block,
+                                         const struct BPlusTreeNode*  cmpNode,
+                                         int*                         found)
+{
+   unsigned int low  = 0;
+   unsigned int high = block->Entries;
+   unsigned int middle;
+   int          cmpResult;
+
+   *found = 0;
+   while(low < high) {
+      middle    = (low + high) / 2;
+      cmpResult = bpt->ComparisonFunction(cmpNode, block->Node[middle]);
+      if(cmpResult < 0) {
+         high = middle;
+      }
+      else {
+         low = middle + 1;
+         if(cmpResult == 0) {
+            *found = 1;
+            break;
+         }
+      }
+   }
+   return(low);
+}
+
+
+/* ###### Find leaf block which may contain cmpNode ###################### */
+static struct BPlusTreeBlock* bPlusTreeFindLeaf(const struct BPlusTree*     bpt,
+                                                const struct BPlusTreeNode* cmpNode)
+{
+   struct BPlusTreeBlock* block = bpt->Root;
+   unsigned int           slot;
+   int                    found;
+
+   while(!block->IsLeaf) {
+      slot  = bPlusTreeSearchBlock(bpt, block, cmpNode, &found);
+      block = block->Child[(slot > 0) ? (slot - 1) : 0];
+   }
+   return(block);
+}
+
+
+/* ###### Find nearest previous node ##################################### */
+struct BPlusTreeNode* bPlusTreeGetNearestPrev(
+                         const struct BPlusTree*     bpt,
+                         const struct BPlusTreeNode* cmpNode)
+{
+   const struct BPlusTreeBlock* leaf;
+   unsigned int                 slot;
+   int                          found;
+
+   if(bpt->Root == NULL) {
+      return(NULL);
+   }
+   leaf = bPlusTreeFindLeaf(bpt, cmpNode);
+   slot = bPlusTreeSearchBlock(bpt, leaf, cmpNode, &found);
+   if(found) {
+      slot--;
+   }
+   if(slot > 0) {
+      return(leaf->Node[slot - 1]);
+   }
+   else if(leaf->PrevLeaf != NULL) {
+      return(leaf->PrevLeaf->Node[leaf->PrevLeaf->Entries - 1]);
+   }
+   return(NULL);
+}
+
+
+/* ###### Find nearest next node ######################################### */
+struct BPlusTreeNode* bPlusTreeGetNearestNext(
+                         const struct BPlusTree*     bpt,
+                         const struct BPlusTreeNode* cmpNode)
+{
+   const struct BPlusTreeBlock* leaf;
+   unsigned int                 slot;
+   int                          found;
+
+   if(bpt->Root == NULL) {
+      return(NULL);
+   }
+   leaf = bPlusTreeFindLeaf(bpt, cmpNode);
+   slot = bPlusTreeSearchBlock(bpt, leaf, cmpNode, &found);
+   if(slot < leaf->Entries) {
+      return(leaf->Node[slot]);
+   }
+   else if(leaf->NextLeaf != NULL) {
+      return(leaf->NextLeaf->Node[0]);
+   }
+   return(NULL);
+}
+
+
+/* ###### Get number of bytes allocated for a subtree #################### */
+static size_t bPlusTreeGetBlockMemoryUsage(const struct BPlusTreeBlock* block)
+{
+   size_t       bytes = sizeof(struct BPlusTreeBlock);
+   unsigned int i;
+
+   if(!block->IsLeaf) {
+      for(i = 0;i < block->Entries;i++) {
+         bytes += bPlusTreeGetBlockMemoryUsage(block->Child[i]);
+      }
+   }
+   return(bytes);
+}
+
+
+/* ###### Get number of elements ######################################### */
+size_t bPlusTreeGetElements(const struct BPlusTree* bpt)
+{
+   return(bpt->Elements);
+}
+
+
+/* ###### Get number of bytes allocated besides the nodes ################ */
+size_t bPlusTreeGetMemoryUsage(const struct BPlusTree* bpt)
+{
+   if(bpt->Root) {
+      return(bPlusTreeGetBlockMemoryUsage(bpt->Root));
+   }
+   return(0);
+}
+
+
+/* ###### Insert node #################################################### */
+/*
+   returns node, if node has been inserted. Otherwise, duplicate node
+   already in tree is returned.
+*/
+struct BPlusTreeNode* bPlusTreeInsert(struct BPlusTree*     bpt,
+                                      struct BPlusTreeNode* node)
+{
+   struct BPlusTreeBlock* leaf;
+   struct BPlusTreeBlock* right;
+   unsigned int           slot;
+   int                    found;
+
+#ifdef DEBUG
+   printf("insert: ");
+   bpt->PrintFunction(node, stdout);
+   printf("\n");
+#endif
+
+   if(bpt->Root == NULL) {
+      leaf = bPlusTreeNewBlock(1);
+      bPlusTreeInsertEntry(leaf, 0, node, NULL, node->Value);
+      bpt->Root      = leaf;
+      bpt->FirstLeaf = leaf;
+      bpt->LastLeaf  = leaf;
+   }
+   else {
+      leaf = bPlusTreeFindLeaf(bpt, node);
+      slot = bPlusTreeSearchBlock(bpt, leaf, node, &found);
+      if(found) {
+         return(leaf->Node[slot - 1]);
+      }
+
+      if(leaf->Entries < BPLUSTREE_MAX_ENTRIES) {
+         bPlusTreeInsertEntry(leaf, slot, node, NULL, node->Value);
+         bPlusTreeUpdateEntriesUpToRoot(leaf);
+      }
+      else {
+         right = bPlusTreeSplitBlock(bpt, leaf);
+         if(slot > leaf->Entries) {
+            bPlusTreeInsertEntry(right, slot - leaf->Entries, node, NULL, node->Value);
+         }
+         else {
+            bPlusTreeInsertEntry(leaf, slot, node, NULL, node->Value);
+         }
+         bPlusTreeInsertIntoParent(bpt, leaf, right);
+      }
+   }
+   bpt->Elements++;
+
+#ifdef DEBUG
+   bPlusTreePrint(bpt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   bPlusTreeVerify(bpt);
+#endif
+   return(node);
+}
+
+
+/* ###### Build tree from sorted node array ############################## */
+/*
+   nodeArray has to be sorted by the comparison function, without
+   duplicates. It has to contain all nodes currently in the tree.
+   The blocks of each level are filled evenly, i.e. every block except
+   a single root gets at least BPLUSTREE_MIN_ENTRIES entries.
+*/
+void bPlusTreeBuild(struct BPlusTree*      bpt,
+                    struct BPlusTreeNode** nodeArray,
+                    const size_t           nodes)
+{
+   struct BPlusTreeBlock** blockArray;
+   struct BPlusTreeBlock*  block;
+   size_t                  blocks;
+   size_t                  children;
+   size_t                  entries;
+   size_t                  i, j, k;
+
+   if(bpt->Root) {
+      bPlusTreeDeleteBlock(bpt->Root);
+   }
+   bpt->Root      = NULL;
+   bpt->FirstLeaf = NULL;
+   bpt->LastLeaf  = NULL;
+   bpt->Elements  = nodes;
+
+   if(nodes > 0) {
+      /* ====== Create leaf blocks ======================================= */
+      blocks     = (nodes + BPLUSTREE_MAX_ENTRIES - 1) / BPLUSTREE_MAX_ENTRIES;
+      blockArray = (struct BPlusTreeBlock**)malloc(blocks * sizeof(struct BPlusTreeBlock*));
+      CHECK(blockArray != NULL);
+      k = 0;
+      for(i = 0;i < blocks;i++) {
+         block   = bPlusTreeNewBlock(1);
+         entries = (nodes / blocks) + ((i < nodes % blocks) ? 1 : 0);
+         for(j = 0;j < entries;j++) {
+            bPlusTreeInsertEntry(block, block->Entries, nodeArray[k], NULL, nodeArray[k]->Value);
+            k++;
+         }
+         block->PrevLeaf = bpt->LastLeaf;
+         if(bpt->LastLeaf) {
+            bpt->LastLeaf->NextLeaf = block;
+         }
+         else {
+            bpt->FirstLeaf = block;
+         }
+         bpt->LastLeaf = block;
+         blockArray[i] = block;
+      }
+
+      /* ====== Create inner blocks level by level ======================= */
+      while(blocks > 1) {
+         children = blocks;
+         blocks   = (children + BPLUSTREE_MAX_ENTRIES - 1) / BPLUSTREE_MAX_ENTRIES;
+         k = 0;
+         for(i = 0;i < blocks;i++) {
+            block   = bPlusTreeNewBlock(0);
+            entries = (children / blocks) + ((i < children % blocks) ? 1 : 0);
+            for(j = 0;j < entries;j++) {
+               bPlusTreeInsertChild(block, block->Entries, blockArray[k]);
+               k++;
+            }
+            blockArray[i] = block;   /* k > i -> entry already consumed */
+         }
+      }
+      bpt->Root         = blockArray[0];
+      bpt->Root->Parent = NULL;
+      free(blockArray);
+   }
+
+#ifdef DEBUG
+   bPlusTreePrint(bpt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   bPlusTreeVerify(bpt);
+#endif
+}
+
+
+/* ###### Remove node #################################################### */
+struct BPlusTreeNode* bPlusTreeRemove(struct BPlusTree*     bpt,
+                                      struct BPlusTreeNode* node)
+{
+   struct BPlusTreeBlock* leaf = node->Block;
+
+#ifdef DEBUG
+   printf("remove: ");
+   bpt->PrintFunction(node, stdout);
+   printf("\n");
+#endif
+
+   CHECK(leaf != NULL);
+   bPlusTreeRemoveEntry(leaf, node->Slot);
+   node->Block = NULL;
+   bpt->Elements--;
+   bPlusTreeRebalance(bpt, leaf);
+
+#ifdef DEBUG
+   bPlusTreePrint(bpt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   bPlusTreeVerify(bpt);
+#endif
+   return(node);
+}
+
+
+/* ###### Find node ###################################################### */
+struct BPlusTreeNode* bPlusTreeFind(const struct BPlusTree*     bpt,
+                                    const struct BPlusTreeNode* cmpNode)
+{
+   const struct BPlusTreeBlock* leaf;
+   unsigned int                 slot;
+   int                          found;
+
+#ifdef DEBUG
+   printf("find: ");
+   bpt->PrintFunction(cmpNode, stdout);
+   printf("\n");
+#endif
+
+   if(bpt->Root != NULL) {
+      leaf = bPlusTreeFindLeaf(bpt, cmpNode);
+      slot = bPlusTreeSearchBlock(bpt, leaf, cmpNode, &found);
+      if(found) {
+         return(leaf->Node[slot - 1]);
+      }
+   }
+   return(NULL);
+}
+
+
+/* ###### Get value sum ################################################## */
+BPlusTreeNodeValueType bPlusTreeGetValueSum(const struct BPlusTree* bpt)
+{
+   if(bpt->Root != NULL) {
+      return(bpt->Root->ValueSum);
+   }
+   return(0);
+}
+
+
+/* ###### Select node by value ########################################### */
+struct BPlusTreeNode* bPlusTreeGetNodeByValue(const struct BPlusTree* bpt,
+                                              BPlusTreeNodeValueType  value)
+{
+   const struct BPlusTreeBlock* block = bpt->Root;
+   unsigned int                 i;
+
+   if(block == NULL) {
+      return(NULL);
+   }
+   for(;;) {
+      for(i = 0;i + 1 < block->Entries;i++) {
+         if(value < block->Sum[i]) {
+            break;
+         }
+         value -= block->Sum[i];
+      }
+      if(block->IsLeaf) {
+         return(block->Node[i]);
+      }
+      block = block->Child[i];
+   }
+}
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   The B+ tree keeps up to BPLUSTREE_MAX_ENTRIES entries per block. Each
+   entry caches the smallest node of its subtree and the value sum of its
+   subtree (for GetNodeByValue()). The keys are the nodes themselves, i.e.
+   the comparisons of a descent still dereference one node per step. The
+   leaf blocks are linked for ordered iteration. Each node knows its slot
+   within its leaf block, and each block its slot within its parent, so
+   that updates towards the root do not search the parents.
+*/
+#define BPLUSTREE_MAX_ENTRIES 16
+#define BPLUSTREE_MIN_ENTRIES (BPLUSTREE_MAX_ENTRIES / 2)
+
+typedef unsigned long long BPlusTreeNodeValueType;
+
+
+struct BPlusTreeBlock;
+
+struct BPlusTreeNode
+{
+   struct BPlusTreeBlock* Block;   /* Leaf block containing this node */
+   BPlusTreeNodeValueType Value;
+   unsigned int           Slot;    /* Index of this node in Block->Node */
+};
+
+struct BPlusTreeBlock
+{
+   struct BPlusTreeBlock* Parent;
+   struct BPlusTreeBlock* PrevLeaf;
+   struct BPlusTreeBlock* NextLeaf;
+   BPlusTreeNodeValueType ValueSum;
+   unsigned int           Entries;
+   unsigned int           IsLeaf;
+   unsigned int           ParentSlot;   /* Index of this block in Parent->Child */
+
+   /* Leaf: Node[i] is the i-th node, Sum[i] its value.
+      Inner block: Node[i] is the smallest node of Child[i],
+      Sum[i] is the value sum of Child[i]. */
+   BPlusTreeNodeValueType Sum[BPLUSTREE_MAX_ENTRIES];
+   struct BPlusTreeNode*  Node[BPLUSTREE_MAX_ENTRIES];
+   struct BPlusTreeBlock* Child[BPLUSTREE_MAX_ENTRIES];
+};
+
+struct BPlusTree
+{
+   struct BPlusTreeBlock* Root;
+   struct BPlusTreeBlock* FirstLeaf;
+   struct BPlusTreeBlock* LastLeaf;
+   size_t                 Elements;
+   void                   (*PrintFunction)(const void* node, FILE* fd);
+   int                    (*ComparisonFunction)(const void* node1, const void* node2);
+};
+
+
+void bPlusTreeNodeNew(struct BPlusTreeNode* node);
+void bPlusTreeNodeDelete(struct BPlusTreeNode* node);
+int bPlusTreeNodeIsLinked(const struct BPlusTreeNode* node);
+
+void bPlusTreeNew(struct BPlusTree* bpt,
+                  void              (*printFunction)(const void* node, FILE* fd),
+                  int               (*comparisonFunction)(const void* node1, const void* node2));
+void bPlusTreeDelete(struct BPlusTree* bpt);
+void bPlusTreeVerify(struct BPlusTree* bpt);
+void bPlusTreePrint(const struct BPlusTree* bpt, FILE* fd);
+int bPlusTreeIsEmpty(const struct BPlusTree* bpt);
+struct BPlusTreeNode* bPlusTreeGetFirst(const struct BPlusTree* bpt);
+struct BPlusTreeNode* bPlusTreeGetLast(const struct BPlusTree* bpt);
+struct BPlusTreeNode* bPlusTreeGetPrev(const struct BPlusTree*     bpt,
+                                       const struct BPlusTreeNode* node);
+struct BPlusTreeNode* bPlusTreeGetNext(const struct BPlusTree*     bpt,
+                                       const struct BPlusTreeNode* node);
+struct BPlusTreeNode* bPlusTreeGetNearestPrev(
+                         const struct BPlusTree*     bpt,
+                         const struct BPlusTreeNode* cmpNode);
+struct BPlusTreeNode* bPlusTreeGetNearestNext(
+                         const struct BPlusTree*     bpt,
+                         const struct BPlusTreeNode* cmpNode);
+size_t bPlusTreeGetElements(const struct BPlusTree* bpt);
+size_t bPlusTreeGetMemoryUsage(const struct BPlusTree* bpt);
+struct BPlusTreeNode* bPlusTreeInsert(struct BPlusTree*     bpt,
+                                      struct BPlusTreeNode* node);
+void bPlusTreeBuild(struct BPlusTree*      bpt,
+                    struct BPlusTreeNode** nodeArray,
+                    const size_t           nodes);
+struct BPlusTreeNode* bPlusTreeRemove(struct BPlusTree*     bpt,
+                                      struct BPlusTreeNode* node);
+struct BPlusTreeNode* bPlusTreeFind(const struct BPlusTree*     bpt,
+                                    const struct BPlusTreeNode* cmpNode);
+BPlusTreeNodeValueType bPlusTreeGetValueSum(const struct BPlusTree* bpt);
+struct BPlusTreeNode* bPlusTreeGetNodeByValue(const struct BPlusTree* bpt,
+                                              BPlusTreeNodeValueType  value);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,547 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "bucketqueue.h"
+#include "debug.h"
+
+#include <string.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ###### Get index of lowest set bit ##################################### */
+inline static unsigned int bucketQueueLowestBit(const uint64_t bits)
+{
+#if defined(__GNUC__)
+   return((unsigned int)__builtin_ctzll(bits));
+#else
+   unsigned int i = 0;
+   while(!(bits & ((uint64_t)1 << i))) {
+      i++;
+   }
+   return(i);
+#endif
+}
+
+
+/* ###### Get number of set bits ########################################## */
+inline static unsigned int bucketQueueBitCount(uint64_t bits)
+{
+#if defined(__GNUC__)
+   return((unsigned int)__builtin_popcountll(bits));
+#else
+   unsigned int n = 0;
+   while(bits != 0) {
+      bits &= bits - 1;
+      n++;
+   }
+   return(n);
+#endif
+}
+
+
+/* ###### Get digit of key on given level ################################# */
+inline static unsigned int bucketQueueDigit(const BucketQueueKeyType key,
+                                            const unsigned int       depth)
+{
+   const unsigned int shift = (BUCKETQUEUE_LEVELS - 1 - depth) * BUCKETQUEUE_DIGITBITS;
+   return((unsigned int)(key >> shift) & ((1 << BUCKETQUEUE_DIGITBITS) - 1));
+}
+
+
+/* ###### Get index of digit's child in the dense child array ############# */
+inline static unsigned int bucketQueueChildIndex(const struct BucketQueueLevel* level,
+                                                 const unsigned int             digit)
+{
+   return(bucketQueueBitCount(level->Occupied & (((uint64_t)1 << digit) - 1)));
+}
+
+
+/* ###### Initialize level ################################################ */
+static void bucketQueueLevelNew(struct BucketQueueLevel* level)
+{
+   level->Occupied   = 0;
+   level->Children   = 0;
+   level->Capacity   = 0;
+   level->ChildArray = NULL;
+}
+
+
+/* ###### Insert child for digit into level ############################### */
+static void bucketQueueLevelInsertChild(struct BucketQueue*      bucketQueue,
+                                        struct BucketQueueLevel* level,
+                                        const unsigned int       digit,
+                                        void*                    child)
+{
+   const unsigned int index = bucketQueueChildIndex(level, digit);
+   unsigned int       newCapacity;
+   void**             newChildArray;
+
+   if(level->Children == level->Capacity) {
+      newCapacity   = (level->Capacity == 0) ? 2 : 2 * level->Capacity;
+      newChildArray = (void**)realloc(level->ChildArray, newCapacity * sizeof(void*));
+      CHECK(newChildArray != NULL);
+      bucketQueue->AllocatedBytes += (newCapacity - level->Capacity) * sizeof(void*);
+      level->ChildArray = newChildArray;
+      level->Capacity   = newCapacity;
+   }
+   memmove(&level->ChildArray[index + 1], &level->ChildArray[index],
+           (level->Children - index) * sizeof(void*));
+   level->ChildArray[index] = child;
+   level->Children++;
+   level->Occupied |= (uint64_t)1 << digit;
+}
+
+
+/* ###### Remove child for digit from level ############################### */
+static void bucketQueueLevelRemoveChild(struct BucketQueueLevel* level,
+                                        const unsigned int       digit)
+{
+   const unsigned int index = bucketQueueChildIndex(level, digit);
+
+   CHECK(level->Occupied & ((uint64_t)1 << digit));
+   level->Children--;
+   memmove(&level->ChildArray[index], &level->ChildArray[index + 1],
+           (level->Children - index) * sizeof(void*));
+   level->Occupied &= ~((uint64_t)1 << digit);
+}
+
+
+/* ###### Invalidate level ################################################ */
+static void bucketQueueLevelDelete(struct BucketQueue*      bucketQueue,
+                                   struct BucketQueueLevel* level)
+{
+   CHECK(level->Children == 0);
+   bucketQueue->AllocatedBytes -= level->Capacity * sizeof(void*);
+   free(level->ChildArray);
+   level->ChildArray = NULL;
+   level->Capacity   = 0;
+}
+
+
+/* ###### Find bucket of key and the levels on its path ################### */
+static struct BucketQueueBucket* bucketQueueFindBucket(
+                                    const struct BucketQueue* bucketQueue,
+                                    const BucketQueueKeyType  key,
+                                    struct BucketQueueLevel** path)
+{
+   struct BucketQueueLevel* level = (struct BucketQueueLevel*)&bucketQueue->Root;
+   unsigned int             depth;
+   unsigned int             digit;
+
+   for(depth = 0;;depth++) {
+      path[depth] = level;
+      digit = bucketQueueDigit(key, depth);
+      if(!(level->Occupied & ((uint64_t)1 << digit))) {
+         return(NULL);
+      }
+      if(depth == BUCKETQUEUE_LEVELS - 1) {
+         return((struct BucketQueueBucket*)level->ChildArray[bucketQueueChildIndex(level, digit)]);
+      }
+      level = (struct BucketQueueLevel*)level->ChildArray[bucketQueueChildIndex(level, digit)];
+   }
+}
+
+
+/* ###### Get first or last bucket below child of level ################### */
+static struct BucketQueueBucket* bucketQueueGetOuterBucket(
+                                    const struct BucketQueueLevel* level,
+                                    unsigned int                   depth,
+                                    unsigned int                   index,
+                                    const int                      last)
+{
+   while(depth < BUCKETQUEUE_LEVELS - 1) {
+      level = (const struct BucketQueueLevel*)level->ChildArray[index];
+      index = (last) ? level->Children - 1 : 0;
+      depth++;
+   }
+   return((struct BucketQueueBucket*)level->ChildArray[index]);
+}
+
+
+/* ###### Get bucket preceding the key's position ######################### */
+static struct BucketQueueBucket* bucketQueueGetPrevBucket(
+                                    struct BucketQueueLevel** path,
+                                    const BucketQueueKeyType  key)
+{
+   unsigned int depth = BUCKETQUEUE_LEVELS;
+   unsigned int index;
+
+   while(depth > 0) {
+      depth--;
+      index = bucketQueueChildIndex(path[depth], bucketQueueDigit(key, depth));
+      if(index > 0) {
+         return(bucketQueueGetOuterBucket(path[depth], depth, index - 1, 1));
+      }
+   }
+   return(NULL);
+}
+
+
+/* ###### Initialize ###################################################### */
+void bucketQueueNodeNew(struct BucketQueueNode* node)
+{
+   node->Prev     = NULL;
+   node->Next     = NULL;
+   node->Key      = 0;
+   node->Sequence = 0;
+}
+
+
+/* ###### Invalidate ###################################################### */
+void bucketQueueNodeDelete(struct BucketQueueNode* node)
+{
+   node->Prev = NULL;
+   node->Next = NULL;
+}
+
+
+/* ###### Initialize ###################################################### */
+void bucketQueueNew(struct BucketQueue* bucketQueue)
+{
+   bucketQueue->First = NULL;
+   bucketQueue->Last  = NULL;
+   bucketQueueLevelNew(&bucketQueue->Root);
+   bucketQueue->Elements       = 0;
+   bucketQueue->AllocatedBytes = 0;
+   bucketQueue->SpareLevels    = 0;
+   bucketQueue->SpareBucket    = NULL;
+}
+
+
+/* ###### Invalidate ###################################################### */
+void bucketQueueDelete(struct BucketQueue* bucketQueue)
+{
+   CHECK(bucketQueue->Elements == 0);
+   CHECK(bucketQueue->First == NULL);
+   CHECK(bucketQueue->Root.Occupied == 0);
+   while(bucketQueue->SpareLevels > 0) {
+      bucketQueue->SpareLevels--;
+      bucketQueueLevelDelete(bucketQueue, bucketQueue->SpareLevelArray[bucketQueue->SpareLevels]);
+      free(bucketQueue->SpareLevelArray[bucketQueue->SpareLevels]);
+      bucketQueue->AllocatedBytes -= sizeof(struct BucketQueueLevel);
+   }
+   if(bucketQueue->SpareBucket != NULL) {
+      free(bucketQueue->SpareBucket);
+      bucketQueue->SpareBucket = NULL;
+      bucketQueue->AllocatedBytes -= sizeof(struct BucketQueueBucket);
+   }
+   bucketQueueLevelDelete(bucketQueue, &bucketQueue->Root);
+   CHECK(bucketQueue->AllocatedBytes == 0);
+}
+
+
+/* ###### Insert node ##################################################### */
+void bucketQueueInsert(struct BucketQueue*           bucketQueue,
+                       struct BucketQueueNode*       node,
+                       const BucketQueueKeyType      key,
+                       const BucketQueueSequenceType sequence)
+{
+   struct BucketQueueLevel*  path[BUCKETQUEUE_LEVELS];
+   struct BucketQueueLevel*  level = &bucketQueue->Root;
+   struct BucketQueueLevel*  childLevel;
+   struct BucketQueueBucket* bucket;
+   struct BucketQueueBucket* prevBucket;
+   struct BucketQueueNode*   prev;
+   unsigned int              depth;
+   unsigned int              digit;
+
+   node->Key      = key;
+   node->Sequence = sequence;
+
+   /* ====== Find or create the key's bucket ============================= */
+   for(depth = 0;depth < BUCKETQUEUE_LEVELS - 1;depth++) {
+      path[depth] = level;
+      digit = bucketQueueDigit(key, depth);
+      if(level->Occupied & ((uint64_t)1 << digit)) {
+         level = (struct BucketQueueLevel*)level->ChildArray[bucketQueueChildIndex(level, digit)];
+      }
+      else {
+         if(bucketQueue->SpareLevels > 0) {
+            childLevel = bucketQueue->SpareLevelArray[--bucketQueue->SpareLevels];
+         }
+         else {
+            childLevel = (struct BucketQueueLevel*)malloc(sizeof(struct BucketQueueLevel));
+            CHECK(childLevel != NULL);
+            bucketQueue->AllocatedBytes += sizeof(struct BucketQueueLevel);
+            bucketQueueLevelNew(childLevel);
+         }
+         bucketQueueLevelInsertChild(bucketQueue, level, digit, childLevel);
+         level = childLevel;
+      }
+   }
+   path[depth] = level;
+   digit = bucketQueueDigit(key, depth);
+   if(level->Occupied & ((uint64_t)1 << digit)) {
+      /* ====== Find predecessor, from the bucket's tail ================== */
+      bucket = (struct BucketQueueBucket*)level->ChildArray[bucketQueueChildIndex(level, digit)];
+      prev   = bucket->Last;
+      while((prev != NULL) && (prev->Key == key) && (prev->Sequence > sequence)) {
+         prev = prev->Prev;
+      }
+   }
+   else {
+      /* ====== New bucket: its predecessor is the previous key's last ==== */
+      if(bucketQueue->SpareBucket != NULL) {
+         bucket = bucketQueue->SpareBucket;
+         bucketQueue->SpareBucket = NULL;
+      }
+      else {
+         bucket = (struct BucketQueueBucket*)malloc(sizeof(struct BucketQueueBucket));
+         CHECK(bucket != NULL);
+         bucketQueue->AllocatedBytes += sizeof(struct BucketQueueBucket);
+      }
+      bucket->First = NULL;
+      bucket->Last  = NULL;
+      bucketQueueLevelInsertChild(bucketQueue, level, digit, bucket);
+      prevBucket = bucketQueueGetPrevBucket(path, key);
+      prev       = (prevBucket != NULL) ? prevBucket->Last : NULL;
+   }
+
+   /* ====== Link node ==================================================== */
+   node->Prev = prev;
+   if(prev != NULL) {
+      node->Next = prev->Next;
+      prev->Next = node;
+   }
+   else {
+      node->Next         = bucketQueue->First;
+      bucketQueue->First = node;
+   }
+   if(node->Next != NULL) {
+      node->Next->Prev = node;
+   }
+   else {
+      bucketQueue->Last = node;
+   }
+   if((node->Prev == NULL) || (node->Prev->Key != key)) {
+      bucket->First = node;
+   }
+   if((node->Next == NULL) || (node->Next->Key != key)) {
+      bucket->Last = node;
+   }
+   bucketQueue->Elements++;
+}
+
+
+/* ###### Remove node ##################################################### */
+void bucketQueueRemove(struct BucketQueue*     bucketQueue,
+                       struct BucketQueueNode* node)
+{
+   struct BucketQueueLevel*  path[BUCKETQUEUE_LEVELS];
+   struct BucketQueueBucket* bucket = NULL;
+   unsigned int              depth;
+
+   CHECK(bucketQueue->Elements > 0);
+
+   /* ====== Only a node at a bucket's end requires the bucket ============ */
+   if( (node->Prev == NULL) || (node->Prev->Key != node->Key) ||
+       (node->Next == NULL) || (node->Next->Key != node->Key) ) {
+      bucket = bucketQueueFindBucket(bucketQueue, node->Key, path);
+      CHECK(bucket != NULL);
+   }
+
+   /* ====== Unlink node ================================================== */
+   if(node->Prev != NULL) {
+      node->Prev->Next = node->Next;
+   }
+   else {
+      CHECK(bucketQueue->First == node);
+      bucketQueue->First = node->Next;
+   }
+   if(node->Next != NULL) {
+      node->Next->Prev = node->Prev;
+   }
+   else {
+      CHECK(bucketQueue->Last == node);
+      bucketQueue->Last = node->Prev;
+   }
+   bucketQueue->Elements--;
+
+   /* ====== Update the bucket, free it and empty levels ================== */
+   if(bucket != NULL) {
+      if(bucket->First != bucket->Last) {
+         if(bucket->First == node) {
+            bucket->First = node->Next;
+         }
+         else {
+            CHECK(bucket->Last == node);
+            bucket->Last = node->Prev;
+         }
+      }
+      else {
+         CHECK(bucket->First == node);
+         if(bucketQueue->SpareBucket == NULL) {
+            bucketQueue->SpareBucket = bucket;
+         }
+         else {
+            free(bucket);
+            bucketQueue->AllocatedBytes -= sizeof(struct BucketQueueBucket);
+         }
+         depth = BUCKETQUEUE_LEVELS - 1;
+         for(;;) {
+            bucketQueueLevelRemoveChild(path[depth], bucketQueueDigit(node->Key, depth));
+            if((depth == 0) || (path[depth]->Children > 0)) {
+               break;
+            }
+            if(bucketQueue->SpareLevels < BUCKETQUEUE_LEVELS - 1) {
+               bucketQueue->SpareLevelArray[bucketQueue->SpareLevels++] = path[depth];
+            }
+            else {
+               bucketQueueLevelDelete(bucketQueue, path[depth]);
+               free(path[depth]);
+               bucketQueue->AllocatedBytes -= sizeof(struct BucketQueueLevel);
+            }
+            depth--;
+         }
+      }
+   }
+   node->Prev = NULL;
+   node->Next = NULL;
+}
+
+
+/* ###### Get first node ################################################## */
+struct BucketQueueNode* bucketQueueGetFirst(const struct BucketQueue* bucketQueue)
+{
+   return(bucketQueue->First);
+}
+
+
+/* ###### Get last node ################################################### */
+struct BucketQueueNode* bucketQueueGetLast(const struct BucketQueue* bucketQueue)
+{
+   return(bucketQueue->Last);
+}
+
+
+/* ###### Get next node ################################################### */
+struct BucketQueueNode* bucketQueueGetNext(const struct BucketQueue*     bucketQueue,
+                                           const struct BucketQueueNode* node)
+{
+   return(node->Next);
+}
+
+
+/* ###### Get previous node ############################################### */
+struct BucketQueueNode* bucketQueueGetPrev(const struct BucketQueue*     bucketQueue,
+                                           const struct BucketQueueNode* node)
+{
+   return(node->Prev);
+}
+
+
+/* ###### Verify level and its children ################################### */
+static void bucketQueueVerifyLevel(const struct BucketQueueLevel* level,
+                                   const unsigned int             depth,
+                                   const BucketQueueKeyType       prefix,
+                                   const struct BucketQueueNode** expected,
+                                   size_t*                        elements,
+                                   size_t*                        allocatedBytes)
+{
+   const struct BucketQueueBucket* bucket;
+   const struct BucketQueueNode*   node;
+   uint64_t                        occupied;
+   unsigned int                    index;
+   BucketQueueKeyType              key;
+
+   CHECK(level->Children == bucketQueueBitCount(level->Occupied));
+   CHECK(level->Children <= level->Capacity);
+   CHECK((level->Capacity == 0) == (level->ChildArray == NULL));
+   *allocatedBytes += level->Capacity * sizeof(void*);
+
+   occupied = level->Occupied;
+   for(index = 0;index < level->Children;index++) {
+      key = (prefix << BUCKETQUEUE_DIGITBITS) | bucketQueueLowestBit(occupied);
+      occupied &= occupied - 1;
+      if(depth < BUCKETQUEUE_LEVELS - 1) {
+         CHECK(((const struct BucketQueueLevel*)level->ChildArray[index])->Children > 0);
+         *allocatedBytes += sizeof(struct BucketQueueLevel);
+         bucketQueueVerifyLevel((const struct BucketQueueLevel*)level->ChildArray[index],
+                                depth + 1, key, expected, elements, allocatedBytes);
+      }
+      else {
+         /* The buckets, in key order, have to cover the list */
+         bucket = (const struct BucketQueueBucket*)level->ChildArray[index];
+         *allocatedBytes += sizeof(struct BucketQueueBucket);
+         CHECK(bucket->First == *expected);
+         for(node = bucket->First;;node = node->Next) {
+            CHECK(node != NULL);
+            CHECK(node->Key == key);
+            (*elements)++;
+            if(node == bucket->Last) {
+               break;
+            }
+         }
+         *expected = node->Next;
+      }
+   }
+}
+
+
+/* ###### Verify structure ################################################ */
+void bucketQueueVerify(const struct BucketQueue* bucketQueue)
+{
+   const struct BucketQueueNode* expected       = bucketQueue->First;
+   const struct BucketQueueNode* node;
+   const struct BucketQueueNode* prev           = NULL;
+   size_t                        elements       = 0;
+   size_t                        allocatedBytes = 0;
+   unsigned int                  i;
+
+   for(node = bucketQueue->First;node != NULL;node = node->Next) {
+      CHECK(node->Prev == prev);
+      CHECK( (prev == NULL) ||
+             (node->Key > prev->Key) ||
+             ((node->Key == prev->Key) && (node->Sequence > prev->Sequence)) );
+      prev = node;
+   }
+   CHECK(bucketQueue->Last == prev);
+
+   bucketQueueVerifyLevel(&bucketQueue->Root, 0, 0, &expected, &elements, &allocatedBytes);
+   CHECK(expected == NULL);
+   CHECK(bucketQueue->SpareLevels <= BUCKETQUEUE_LEVELS - 1);
+   for(i = 0;i < bucketQueue->SpareLevels;i++) {
+      CHECK(bucketQueue->SpareLevelArray[i]->Children == 0);
+      allocatedBytes += sizeof(struct BucketQueueLevel) +
+                        bucketQueue->SpareLevelArray[i]->Capacity * sizeof(void*);
+   }
+   if(bucketQueue->SpareBucket != NULL) {
+      allocatedBytes += sizeof(struct BucketQueueBucket);
+   }
+   CHECK(elements == bucketQueue->Elements);
+   CHECK(allocatedBytes == bucketQueue->AllocatedBytes);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
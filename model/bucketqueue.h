@@ -0,0 +1,139 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Bucket queue of nodes ordered by (Key, Sequence), both ascending.
+   All nodes form one doubly-linked list in this order, i.e. getting the
+   first, last, next or previous node is O(1). Each distinct key has its
+   own bucket, referring to the first and last node of the key in the
+   list: inserting a node having the highest sequence number of its key
+   (the usual case, since the sequence number is a FIFO counter) appends
+   it to its bucket in O(1); otherwise, insertion walks back over the
+   nodes of the same key only. The buckets are the leaves of a radix tree
+   over the 32-bit key, with BUCKETQUEUE_DIGITBITS bits per level. A level
+   has an occupancy bitmap and a dense array of its existing children in
+   digit order, so that sparse keys do not allocate full-width levels.
+   Finding the bucket of a key, or the bucket preceding a new key, takes
+   at most BUCKETQUEUE_LEVELS steps, however the keys are clustered. The
+   bucket and levels freed by a removal are kept for the next insertion,
+   since a selection usually re-inserts the node under a new key.
+*/
+#define BUCKETQUEUE_DIGITBITS 6
+#define BUCKETQUEUE_LEVELS    6   /* ceil(32 / BUCKETQUEUE_DIGITBITS) */
+
+typedef unsigned int       BucketQueueKeyType;
+typedef unsigned long long BucketQueueSequenceType;
+
+struct BucketQueueNode
+{
+   struct BucketQueueNode* Prev;
+   struct BucketQueueNode* Next;
+   BucketQueueKeyType      Key;
+   BucketQueueSequenceType Sequence;
+};
+
+struct BucketQueueBucket
+{
+   struct BucketQueueNode* First;
+   struct BucketQueueNode* Last;
+};
+
+struct BucketQueueLevel
+{
+   uint64_t                Occupied;   /* Bit i <=> child for digit i exists */
+   unsigned int            Children;
+   unsigned int            Capacity;
+   void**                  ChildArray; /* Levels; buckets on the last level */
+};
+
+struct BucketQueue
+{
+   struct BucketQueueNode*   First;
+   struct BucketQueueNode*   Last;
+   struct BucketQueueLevel   Root;
+   size_t                    Elements;
+   size_t                    AllocatedBytes;
+
+   struct BucketQueueLevel*  SpareLevelArray[BUCKETQUEUE_LEVELS - 1];
+   unsigned int              SpareLevels;
+   struct BucketQueueBucket* SpareBucket;
+};
+
+
+void bucketQueueNodeNew(struct BucketQueueNode* node);
+void bucketQueueNodeDelete(struct BucketQueueNode* node);
+
+void bucketQueueNew(struct BucketQueue* bucketQueue);
+void bucketQueueDelete(struct BucketQueue* bucketQueue);
+void bucketQueueInsert(struct BucketQueue*           bucketQueue,
+                       struct BucketQueueNode*       node,
+                       const BucketQueueKeyType      key,
+                       const BucketQueueSequenceType sequence);
+void bucketQueueRemove(struct BucketQueue*     bucketQueue,
+                       struct BucketQueueNode* node);
+struct BucketQueueNode* bucketQueueGetFirst(const struct BucketQueue* bucketQueue);
+struct BucketQueueNode* bucketQueueGetLast(const struct BucketQueue* bucketQueue);
+struct BucketQueueNode* bucketQueueGetNext(const struct BucketQueue*     bucketQueue,
+                                           const struct BucketQueueNode* node);
+struct BucketQueueNode* bucketQueueGetPrev(const struct BucketQueue*     bucketQueue,
+                                           const struct BucketQueueNode* node);
+void bucketQueueVerify(const struct BucketQueue* bucketQueue);
+
+inline static size_t bucketQueueGetMemoryUsage(const struct BucketQueue* bucketQueue)
+{
+   return(bucketQueue->AllocatedBytes);
+}
+
+inline static size_t bucketQueueGetElements(const struct BucketQueue* bucketQueue)
+{
+   return(bucketQueue->Elements);
+}
+
+inline static int bucketQueueIsEmpty(const struct BucketQueue* bucketQueue)
+{
+   return(bucketQueue->Elements == 0);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1020 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "compactredblacktree.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define CRBT_RED   1
+#define CRBT_BLACK 2
+
+#define CRBT_MIN_SLOTS 16
+
+
+/* ###### Get parent of slot ############################################# */
+inline static uint32_t compactRedBlackTreeGetParent(const struct CompactRedBlackTreeSlot* pool,
+                                                    const uint32_t                        slot)
+{
+   return(pool[slot].Parent & CRBT_PARENT_MASK);
+}
+
+
+/* ###### Set parent of slot ############################################# */
+inline static void compactRedBlackTreeSetParent(struct CompactRedBlackTreeSlot* pool,
+                                                const uint32_t                  slot,
+                                                const uint32_t                  parent)
+{
+   pool[slot].Parent = (pool[slot].Parent & CRBT_RED_BIT) | parent;
+}
+
+
+/* ###### Get color of slot ############################################## */
+inline static unsigned int compactRedBlackTreeGetColor(const struct CompactRedBlackTreeSlot* pool,
+                                                       const uint32_t                        slot)
+{
+   return((pool[slot].Parent & CRBT_RED_BIT) ? CRBT_RED : CRBT_BLACK);
+}
+
+
+/* ###### Set color of slot ############################################## */
+inline static void compactRedBlackTreeSetColor(struct CompactRedBlackTreeSlot* pool,
+                                               const uint32_t                  slot,
+                                               const unsigned int              color)
+{
+   if(color == CRBT_RED) {
+      pool[slot].Parent |= CRBT_RED_BIT;
+   }
+   else {
+      pool[slot].Parent &= CRBT_PARENT_MASK;
+   }
+}
+
+
+/* ###### Initialize ##################################################### */
+void compactRedBlackTreeNodeNew(struct CompactRedBlackTreeNode* node)
+{
+   node->Slot  = 0;
+   node->Value = 0;
+}
+
+
+/* ###### Invalidate ##################################################### */
+void compactRedBlackTreeNodeDelete(struct CompactRedBlackTreeNode* node)
+{
+   node->Slot  = 0;
+   node->Value = 0;
+}
+
+
+/* ###### Is node linked? ################################################ */
+int compactRedBlackTreeNodeIsLinked(const struct CompactRedBlackTreeNode* node)
+{
+   return(node->Slot != 0);
+}
+
+
+/* ##### Initialize ###################################################### */
+void compactRedBlackTreeNew(struct CompactRedBlackTree* crbt,
+                            void                        (*printFunction)(const void* node, FILE* fd),
+                            int                         (*comparisonFunction)(const void* node1, const void* node2))
+{
+   /* The slot pool is allocated on first insertion */
+   crbt->Pool               = NULL;
+   crbt->Slots              = 0;
+   crbt->FreeSlot           = 0;
+   crbt->Elements           = 0;
+   crbt->PrintFunction      = printFunction;
+   crbt->ComparisonFunction = comparisonFunction;
+}
+
+
+/* ##### Invalidate ###################################################### */
+void compactRedBlackTreeDelete(struct CompactRedBlackTree* crbt)
+{
+   free(crbt->Pool);
+   crbt->Pool     = NULL;
+   crbt->Slots    = 0;
+   crbt->FreeSlot = 0;
+   crbt->Elements = 0;
+}
+
+
+/* ##### Enlarge slot pool ############################################### */
+static void compactRedBlackTreeGrowPool(struct CompactRedBlackTree* crbt)
+{
+   struct CompactRedBlackTreeSlot* pool;
+   const uint32_t                  slots = (crbt->Slots >= CRBT_MIN_SLOTS) ?
+                                              (2 * crbt->Slots) : CRBT_MIN_SLOTS;
+   uint32_t                        i;
+
+   CHECK(slots > crbt->Slots);
+   CHECK(slots <= CRBT_PARENT_MASK);
+   pool = (struct CompactRedBlackTreeSlot*)realloc(crbt->Pool,
+                                                   (size_t)slots * sizeof(struct CompactRedBlackTreeSlot));
+   CHECK(pool != NULL);
+
+   if(crbt->Slots == 0) {
+      /* Slot 0 is the null node */
+      pool[0].Parent       = 0;   /* Black */
+      pool[0].LeftSubtree  = 0;
+      pool[0].RightSubtree = 0;
+      pool[0].ValueSum     = 0;
+      pool[0].Node         = NULL;
+      crbt->Slots          = 1;
+   }
+   for(i = slots - 1;i >= crbt->Slots;i--) {
+      pool[i].Parent = crbt->FreeSlot;
+      pool[i].Node   = NULL;
+      crbt->FreeSlot = i;
+   }
+   crbt->Pool  = pool;
+   crbt->Slots = slots;
+}
+
+
+/* ##### Update value sum ################################################ */
+inline static void compactRedBlackTreeUpdateValueSum(struct CompactRedBlackTreeSlot* pool,
+                                                     const uint32_t                  slot)
+{
+   pool[slot].ValueSum = pool[pool[slot].LeftSubtree].ValueSum +
+                         pool[slot].Node->Value +
+                         pool[pool[slot].RightSubtree].ValueSum;
+}
+
+
+/* ##### Update value sum for node and all parents up to tree root ####### */
+static void compactRedBlackTreeUpdateValueSumsUpToRoot(struct CompactRedBlackTreeSlot* pool,
+                                                       uint32_t                        slot)
+{
+   while(slot != 0) {
+      compactRedBlackTreeUpdateValueSum(pool, slot);
+      slot = compactRedBlackTreeGetParent(pool, slot);
+   }
+}
+
+
+/* ###### Internal method for printing a node ############################# */
+static void compactRedBlackTreePrintNode(const struct CompactRedBlackTree* crbt,
+                                         const uint32_t                    slot,
+                                         FILE*                             fd)
+{
+   const struct CompactRedBlackTreeSlot* pool = crbt->Pool;
+
+   crbt->PrintFunction(pool[slot].Node, fd);
+#ifdef DEBUG
+   fprintf(fd, " slot=%u c=%s v=%u vsum=%llu l=%u r=%u p=%u   \n",
+           slot, ((compactRedBlackTreeGetColor(pool, slot) == CRBT_RED) ? "Red" : "Black"),
+           pool[slot].Node->Value, pool[slot].ValueSum,
+           pool[slot].LeftSubtree, pool[slot].RightSubtree, compactRedBlackTreeGetParent(pool, slot));
+#endif
+}
+
+
+/* ##### Internal printing function ###################################### */
+static void compactRedBlackTreeInternalPrint(const struct CompactRedBlackTree* crbt,
+                                             const uint32_t                    slot,
+                                             FILE*                             fd)
+{
+   if(slot != 0) {
+      compactRedBlackTreeInternalPrint(crbt, crbt->Pool[slot].LeftSubtree, fd);
+      compactRedBlackTreePrintNode(crbt, slot, fd);
+      compactRedBlackTreeInternalPrint(crbt, crbt->Pool[slot].RightSubtree, fd);
+   }
+}
+
+
+/* ###### Print tree ##################################################### */
+void compactRedBlackTreePrint(const struct CompactRedBlackTree* crbt, FILE* fd)
+{
+   if(crbt->Pool != NULL) {
+#ifdef DEBUG
+      fprintf(fd, "\n\nroot=%u slots=%u\n", crbt->Pool[0].LeftSubtree, crbt->Slots);
+#endif
+      compactRedBlackTreeInternalPrint(crbt, crbt->Pool[0].LeftSubtree, fd);
+   }
+   fputs("\n", fd);
+}
+
+
+/* ###### Is tree empty? ################################################# */
+int compactRedBlackTreeIsEmpty(const struct CompactRedBlackTree* crbt)
+{
+   return(crbt->Elements == 0);
+}
+
+
+/* ###### Get node of slot ############################################### */
+inline static struct CompactRedBlackTreeNode* compactRedBlackTreeGetNodeOfSlot(
+                                                 const struct CompactRedBlackTree* crbt,
+                                                 const uint32_t                    slot)
+{
+   return((slot != 0) ? crbt->Pool[slot].Node : NULL);
+}
+
+
+/* ###### Get first node ################################################## */
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetFirst(
+                                   const struct CompactRedBlackTree* crbt)
+{
+   const struct CompactRedBlackTreeSlot* pool = crbt->Pool;
+   uint32_t                              slot;
+
+   if(crbt->Elements == 0) {
+      return(NULL);
+   }
+   slot = pool[0].LeftSubtree;
+   while(pool[slot].LeftSubtree != 0) {
+      slot = pool[slot].LeftSubtree;
+   }
+   return(pool[slot].Node);
+}
+
+
+/* ###### Get last node ################################################### */
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetLast(
+                                   const struct CompactRedBlackTree* crbt)
+{
+   const struct CompactRedBlackTreeSlot* pool = crbt->Pool;
+   uint32_t                              slot;
+
+   if(crbt->Elements == 0) {
+      return(NULL);
+   }
+   slot = pool[0].LeftSubtree;
+   while(pool[slot].RightSubtree != 0) {
+      slot = pool[slot].RightSubtree;
+   }
+   return(pool[slot].Node);
+}
+
+
+/* ###### Get previous slot by walking through the tree ################## */
+static uint32_t compactRedBlackTreeInternalFindPrev(const struct CompactRedBlackTreeSlot* pool,
+                                                    uint32_t                              slot)
+{
+   uint32_t parent;
+   uint32_t node = pool[slot].LeftSubtree;
+
+   if(node != 0) {
+      while(pool[node].RightSubtree != 0) {
+         node = pool[node].RightSubtree;
+      }
+      return(node);
+   }
+   node   = slot;
+   parent = compactRedBlackTreeGetParent(pool, slot);
+   while((parent != 0) && (node == pool[parent].LeftSubtree)) {
+      node   = parent;
+      parent = compactRedBlackTreeGetParent(pool, parent);
+   }
+   return(parent);
+}
+
+
+/* ###### Get next slot by walking through the tree ###################### */
+static uint32_t compactRedBlackTreeInternalFindNext(const struct CompactRedBlackTreeSlot* pool,
+                                                    uint32_t                              slot)
+{
+   uint32_t parent;
+   uint32_t node = pool[slot].RightSubtree;
+
+   if(node != 0) {
+      while(pool[node].LeftSubtree != 0) {
+         node = pool[node].LeftSubtree;
+      }
+      return(node);
+   }
+   node   = slot;
+   parent = compactRedBlackTreeGetParent(pool, slot);
+   while((parent != 0) && (node == pool[parent].RightSubtree)) {
+      node   = parent;
+      parent = compactRedBlackTreeGetParent(pool, parent);
+   }
+   return(parent);
+}
+
+
+/* ###### Get previous node ############################################### */
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetPrev(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* node)
+{
+   return(compactRedBlackTreeGetNodeOfSlot(crbt,
+             compactRedBlackTreeInternalFindPrev(crbt->Pool, node->Slot)));
+}
+
+
+/* ###### Get next node ################################################## */
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNext(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* node)
+{
+   return(compactRedBlackTreeGetNodeOfSlot(crbt,
+             compactRedBlackTreeInternalFindNext(crbt->Pool, node->Slot)));
+}
+
+
+/* ###### Find slot of node or its would-be parent ####################### */
+/*
+   Returns the slot of a node equal to cmpNode (*cmpResult == 0) or the
+   slot of the node whose left (*cmpResult < 0) or right (*cmpResult > 0)
+   child cmpNode would become.
+*/
+static uint32_t compactRedBlackTreeInternalFind(const struct CompactRedBlackTree*     crbt,
+                                                const struct CompactRedBlackTreeNode* cmpNode,
+                                                int*                                  cmpResult)
+{
+   const struct CompactRedBlackTreeSlot* pool   = crbt->Pool;
+   uint32_t                              parent = 0;
+   uint32_t                              slot   = pool[0].LeftSubtree;
+
+   *cmpResult = -1;
+   while(slot != 0) {
+      parent     = slot;
+      *cmpResult = crbt->ComparisonFunction(cmpNode, pool[slot].Node);
+      if(*cmpResult < 0) {
+         slot = pool[slot].LeftSubtree;
+      }
+      else if(*cmpResult > 0) {
+         slot = pool[slot].RightSubtree;
+      }
+      else {
+         break;
+      }
+   }
+   return(parent);
+}
+
+
+/* ###### Find nearest previous node ##################################### */
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNearestPrev(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* cmpNode)
+{
+   uint32_t slot;
+   int      cmpResult;
+
+   if(crbt->Elements == 0) {
+      return(NULL);
+   }
+   slot = compactRedBlackTreeInternalFind(crbt, cmpNode, &cmpResult);
+   if(cmpResult <= 0) {
+      /* Equal node found or cmpNode would be the left child of slot
+         => the nearest previous node is the predecessor of slot */
+      slot = compactRedBlackTreeInternalFindPrev(crbt->Pool, slot);
+   }
+   return(compactRedBlackTreeGetNodeOfSlot(crbt, slot));
+}
+
+
+/* ###### Find nearest next node ######################################### */
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNearestNext(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* cmpNode)
+{
+   uint32_t slot;
+   int      cmpResult;
+
+   if(crbt->Elements == 0) {
+      return(NULL);
+   }
+   slot = compactRedBlackTreeInternalFind(crbt, cmpNode, &cmpResult);
+   if(cmpResult >= 0) {
+      /* Equal node found or cmpNode would be the right child of slot
+         => the nearest next node is the successor of slot */
+      slot = compactRedBlackTreeInternalFindNext(crbt->Pool, slot);
+   }
+   return(compactRedBlackTreeGetNodeOfSlot(crbt, slot));
+}
+
+
+/* ###### Get number of elements ########################################## */
+size_t compactRedBlackTreeGetElements(const struct CompactRedBlackTree* crbt)
+{
+   return(crbt->Elements);
+}
+
+
+/* ###### Get number of bytes allocated besides the nodes ################# */
+size_t compactRedBlackTreeGetMemoryUsage(const struct CompactRedBlackTree* crbt)
+{
+   return((size_t)crbt->Slots * sizeof(struct CompactRedBlackTreeSlot));
+}
+
+
+/* ###### Find node ####################################################### */
+struct CompactRedBlackTreeNode* compactRedBlackTreeFind(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* cmpNode)
+{
+   uint32_t slot;
+   int      cmpResult;
+
+#ifdef DEBUG
+   printf("find: ");
+   crbt->PrintFunction(cmpNode, stdout);
+   printf("\n");
+#endif
+
+   if(crbt->Elements == 0) {
+      return(NULL);
+   }
+   slot = compactRedBlackTreeInternalFind(crbt, cmpNode, &cmpResult);
+   if(cmpResult == 0) {
+      return(crbt->Pool[slot].Node);
+   }
+   return(NULL);
+}
+
+
+/* ###### Get value sum from root node ################################### */
+CompactRedBlackTreeNodeValueType compactRedBlackTreeGetValueSum(
+                                    const struct CompactRedBlackTree* crbt)
+{
+   if(crbt->Elements == 0) {
+      return(0);
+   }
+   return(crbt->Pool[crbt->Pool[0].LeftSubtree].ValueSum);
+}
+
+
+/* ##### Rotation with left subtree ###################################### */
+static void compactRedBlackTreeRotateLeft(struct CompactRedBlackTreeSlot* pool,
+                                          const uint32_t                  slot)
+{
+   const uint32_t lower    = pool[slot].RightSubtree;
+   const uint32_t lowleft  = pool[lower].LeftSubtree;
+   const uint32_t upparent = compactRedBlackTreeGetParent(pool, slot);
+
+   pool[slot].RightSubtree = lowleft;
+   compactRedBlackTreeSetParent(pool, lowleft, slot);
+   compactRedBlackTreeSetParent(pool, lower, upparent);
+
+   if(slot == pool[upparent].LeftSubtree) {
+      pool[upparent].LeftSubtree = lower;
+   } else {
+      CHECK(slot == pool[upparent].RightSubtree);
+      pool[upparent].RightSubtree = lower;
+   }
+
+   pool[lower].LeftSubtree = slot;
+   compactRedBlackTreeSetParent(pool, slot, lower);
+
+   compactRedBlackTreeUpdateValueSum(pool, slot);
+   compactRedBlackTreeUpdateValueSum(pool, lower);
+}
+
+
+/* ##### Rotation with right subtree ##################################### */
+static void compactRedBlackTreeRotateRight(struct CompactRedBlackTreeSlot* pool,
+                                           const uint32_t                  slot)
+{
+   const uint32_t lower    = pool[slot].LeftSubtree;
+   const uint32_t lowright = pool[lower].RightSubtree;
+   const uint32_t upparent = compactRedBlackTreeGetParent(pool, slot);
+
+   pool[slot].LeftSubtree = lowright;
+   compactRedBlackTreeSetParent(pool, lowright, slot);
+   compactRedBlackTreeSetParent(pool, lower, upparent);
+
+   if(slot == pool[upparent].RightSubtree) {
+      pool[upparent].RightSubtree = lower;
+   } else {
+      CHECK(slot == pool[upparent].LeftSubtree);
+      pool[upparent].LeftSubtree = lower;
+   }
+
+   pool[lower].RightSubtree = slot;
+   compactRedBlackTreeSetParent(pool, slot, lower);
+
+   compactRedBlackTreeUpdateValueSum(pool, slot);
+   compactRedBlackTreeUpdateValueSum(pool, lower);
+}
+
+
+/* ###### Insert ######################################################### */
+/*
+   returns node, if node has been inserted. Otherwise, duplicate node
+   already in tree is returned.
+*/
+struct CompactRedBlackTreeNode* compactRedBlackTreeInsert(
+                                   struct CompactRedBlackTree*     crbt,
+                                   struct CompactRedBlackTreeNode* node)
+{
+   struct CompactRedBlackTreeSlot* pool;
+   uint32_t                        slot;
+   uint32_t                        parent;
+   uint32_t                        uncle;
+   uint32_t                        grandpa;
+   int                             cmpResult;
+
+#ifdef DEBUG
+   printf("insert: ");
+   crbt->PrintFunction(node, stdout);
+   printf("\n");
+#endif
+
+   /* ====== Find location of new node =================================== */
+   if(crbt->FreeSlot == 0) {
+      compactRedBlackTreeGrowPool(crbt);
+   }
+   pool   = crbt->Pool;
+   parent = compactRedBlackTreeInternalFind(crbt, node, &cmpResult);
+   if((parent != 0) && (cmpResult == 0)) {
+      /* Node with same key is already available -> return. */
+      return(pool[parent].Node);
+   }
+
+
+   /* ====== Link node =================================================== */
+   slot           = crbt->FreeSlot;
+   crbt->FreeSlot = compactRedBlackTreeGetParent(pool, slot);
+   node->Slot     = slot;
+
+   if(cmpResult < 0) {
+      pool[parent].LeftSubtree = slot;
+   }
+   else {
+      pool[parent].RightSubtree = slot;
+   }
+   compactRedBlackTreeSetParent(pool, slot, parent);
+   pool[slot].LeftSubtree  = 0;
+   pool[slot].RightSubtree = 0;
+   pool[slot].ValueSum     = node->Value;
+   pool[slot].Node         = node;
+   crbt->Elements++;
+
+
+   /* ====== Update parent's value sum =================================== */
+   compactRedBlackTreeUpdateValueSumsUpToRoot(pool, parent);
+
+
+   /* ====== Ensure red-black tree properties ============================ */
+   compactRedBlackTreeSetColor(pool, slot, CRBT_RED);
+   while(compactRedBlackTreeGetColor(pool, parent) == CRBT_RED) {
+      grandpa = compactRedBlackTreeGetParent(pool, parent);
+      if(parent == pool[grandpa].LeftSubtree) {
+         uncle = pool[grandpa].RightSubtree;
+         if(compactRedBlackTreeGetColor(pool, uncle) == CRBT_RED) {
+            compactRedBlackTreeSetColor(pool, parent, CRBT_BLACK);
+            compactRedBlackTreeSetColor(pool, uncle, CRBT_BLACK);
+            compactRedBlackTreeSetColor(pool, grandpa, CRBT_RED);
+            slot                = grandpa;
+            parent              = compactRedBlackTreeGetParent(pool, grandpa);
+         } else {
+            if(slot == pool[parent].RightSubtree) {
+               compactRedBlackTreeRotateLeft(pool, parent);
+               parent = slot;
+               CHECK(grandpa == compactRedBlackTreeGetParent(pool, parent));
+            }
+            compactRedBlackTreeSetColor(pool, parent, CRBT_BLACK);
+            compactRedBlackTreeSetColor(pool, grandpa, CRBT_RED);
+            compactRedBlackTreeRotateRight(pool, grandpa);
+            break;
+         }
+      } else {
+         uncle = pool[grandpa].LeftSubtree;
+         if(compactRedBlackTreeGetColor(pool, uncle) == CRBT_RED) {
+            compactRedBlackTreeSetColor(pool, parent, CRBT_BLACK);
+            compactRedBlackTreeSetColor(pool, uncle, CRBT_BLACK);
+            compactRedBlackTreeSetColor(pool, grandpa, CRBT_RED);
+            slot                = grandpa;
+            parent              = compactRedBlackTreeGetParent(pool, grandpa);
+         } else {
+            if(slot == pool[parent].LeftSubtree) {
+               compactRedBlackTreeRotateRight(pool, parent);
+               parent = slot;
+               CHECK(grandpa == compactRedBlackTreeGetParent(pool, parent));
+            }
+            compactRedBlackTreeSetColor(pool, parent, CRBT_BLACK);
+            compactRedBlackTreeSetColor(pool, grandpa, CRBT_RED);
+            compactRedBlackTreeRotateLeft(pool, grandpa);
+            break;
+         }
+      }
+   }
+   compactRedBlackTreeSetColor(pool, pool[0].LeftSubtree, CRBT_BLACK);
+
+#ifdef DEBUG
+   compactRedBlackTreePrint(crbt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   compactRedBlackTreeVerify(crbt);
+#endif
+   return(node);
+}
+
+
+/* ###### Build balanced subtree from slot range ######################## */
+static uint32_t compactRedBlackTreeInternalBuild(struct CompactRedBlackTreeSlot* pool,
+                                                 const uint32_t                  parent,
+                                                 const uint32_t                  firstSlot,
+                                                 const uint32_t                  slots,
+                                                 const unsigned int              depth,
+                                                 const unsigned int              redDepth)
+{
+   const uint32_t middle = slots / 2;
+   const uint32_t slot   = firstSlot + middle;
+
+   if(slots == 0) {
+      return(0);
+   }
+   compactRedBlackTreeSetParent(pool, slot, parent);
+   compactRedBlackTreeSetColor(pool, slot, (depth == redDepth) ? CRBT_RED : CRBT_BLACK);
+   pool[slot].LeftSubtree  = compactRedBlackTreeInternalBuild(
+                                pool, slot, firstSlot, middle, depth + 1, redDepth);
+   pool[slot].RightSubtree = compactRedBlackTreeInternalBuild(
+                                pool, slot, slot + 1, slots - middle - 1, depth + 1, redDepth);
+   compactRedBlackTreeUpdateValueSum(pool, slot);
+   return(slot);
+}
+
+
+/* ###### Build tree from sorted node array ############################## */
+/*
+   nodeArray has to be sorted by the comparison function, without
+   duplicates. It has to contain all nodes currently in the tree.
+   The nodes get the slots 1 to nodes in sorted order, which also makes
+   in-order traversal walk the slot pool sequentially.
+*/
+void compactRedBlackTreeBuild(struct CompactRedBlackTree*      crbt,
+                              struct CompactRedBlackTreeNode** nodeArray,
+                              const size_t                     nodes)
+{
+   struct CompactRedBlackTreeSlot* pool;
+   unsigned int                    redDepth = 0;
+   size_t                          i;
+
+   CHECK(nodes < CRBT_PARENT_MASK);
+   while(crbt->Slots < nodes + 1) {
+      compactRedBlackTreeGrowPool(crbt);
+   }
+   pool = crbt->Pool;
+
+   for(i = nodes;i > 1;i >>= 1) {
+      redDepth++;   /* redDepth = floor(log2(nodes)) = depth of deepest level */
+   }
+   for(i = 0;i < nodes;i++) {
+      nodeArray[i]->Slot = (uint32_t)(i + 1);
+      pool[i + 1].Node   = nodeArray[i];
+   }
+   compactRedBlackTreeSetParent(pool, 0, 0);
+   pool[0].RightSubtree = 0;
+   pool[0].LeftSubtree  = compactRedBlackTreeInternalBuild(pool, 0, 1, (uint32_t)nodes,
+                                                           0, redDepth);
+   compactRedBlackTreeSetColor(pool, pool[0].LeftSubtree, CRBT_BLACK);
+   compactRedBlackTreeSetColor(pool, 0, CRBT_BLACK);
+   pool[0].ValueSum     = 0;
+   crbt->Elements       = nodes;
+
+   /* ====== Rebuild free slot chain ===================================== */
+   crbt->FreeSlot = 0;
+   for(i = crbt->Slots - 1;i > nodes;i--) {
+      pool[i].Parent = crbt->FreeSlot;
+      pool[i].Node   = NULL;
+      crbt->FreeSlot = (uint32_t)i;
+   }
+
+#ifdef DEBUG
+   compactRedBlackTreePrint(crbt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   compactRedBlackTreeVerify(crbt);
+#endif
+}
+
+
+/* ###### Remove ######################################################### */
+struct CompactRedBlackTreeNode* compactRedBlackTreeRemove(
+                                   struct CompactRedBlackTree*     crbt,
+                                   struct CompactRedBlackTreeNode* node)
+{
+   struct CompactRedBlackTreeSlot* pool = crbt->Pool;
+   const uint32_t                  slot = node->Slot;
+   uint32_t                        child;
+   uint32_t                        delParent;
+   uint32_t                        parent;
+   uint32_t                        sister;
+   uint32_t                        next;
+   uint32_t                        nextParent;
+   unsigned int                    nextColor;
+
+#ifdef DEBUG
+   printf("remove: ");
+   crbt->PrintFunction(node, stdout);
+   printf("\n");
+#endif
+
+   CHECK(compactRedBlackTreeNodeIsLinked(node));
+   CHECK(pool[slot].Node == node);
+
+   /* ====== Unlink node ================================================= */
+   if((pool[slot].LeftSubtree != 0) && (pool[slot].RightSubtree != 0)) {
+      next       = compactRedBlackTreeInternalFindNext(pool, slot);
+      nextParent = compactRedBlackTreeGetParent(pool, next);
+      nextColor  = compactRedBlackTreeGetColor(pool, next);
+
+      CHECK(next != 0);
+      CHECK(nextParent != 0);
+      CHECK(pool[next].LeftSubtree == 0);
+
+      child = pool[next].RightSubtree;
+      compactRedBlackTreeSetParent(pool, child, nextParent);
+      if(pool[nextParent].LeftSubtree == next) {
+         pool[nextParent].LeftSubtree = child;
+      } else {
+         CHECK(pool[nextParent].RightSubtree == next);
+         pool[nextParent].RightSubtree = child;
+      }
+
+      delParent               = compactRedBlackTreeGetParent(pool, slot);
+      pool[next].LeftSubtree  = pool[slot].LeftSubtree;
+      pool[next].RightSubtree = pool[slot].RightSubtree;
+      compactRedBlackTreeSetParent(pool, next, delParent);
+      compactRedBlackTreeSetParent(pool, pool[next].LeftSubtree, next);
+      compactRedBlackTreeSetParent(pool, pool[next].RightSubtree, next);
+      compactRedBlackTreeSetColor(pool, next, compactRedBlackTreeGetColor(pool, slot));
+      compactRedBlackTreeSetColor(pool, slot, nextColor);
+
+      if(pool[delParent].LeftSubtree == slot) {
+         pool[delParent].LeftSubtree = next;
+      } else {
+         CHECK(pool[delParent].RightSubtree == slot);
+         pool[delParent].RightSubtree = next;
+      }
+
+      /* ====== Update parent's value sum ================================ */
+      compactRedBlackTreeUpdateValueSumsUpToRoot(pool, next);
+      /* nextParent may be the removed slot itself, which now is replaced by next */
+      compactRedBlackTreeUpdateValueSumsUpToRoot(pool, (nextParent != slot) ? nextParent : next);
+   } else {
+      child     = (pool[slot].LeftSubtree != 0) ? pool[slot].LeftSubtree : pool[slot].RightSubtree;
+      delParent = compactRedBlackTreeGetParent(pool, slot);
+      compactRedBlackTreeSetParent(pool, child, delParent);
+
+      if(slot == pool[delParent].LeftSubtree) {
+         pool[delParent].LeftSubtree = child;
+      } else {
+         CHECK(slot == pool[delParent].RightSubtree);
+         pool[delParent].RightSubtree = child;
+      }
+
+      /* ====== Update parent's value sum ================================ */
+      compactRedBlackTreeUpdateValueSumsUpToRoot(pool, delParent);
+   }
+   CHECK(crbt->Elements > 0);
+   crbt->Elements--;
+
+
+   /* ====== Ensure red-black properties ================================= */
+   if(compactRedBlackTreeGetColor(pool, slot) == CRBT_BLACK) {
+      compactRedBlackTreeSetColor(pool, pool[0].LeftSubtree, CRBT_RED);
+
+      while(compactRedBlackTreeGetColor(pool, child) == CRBT_BLACK) {
+         parent = compactRedBlackTreeGetParent(pool, child);
+         if(child == pool[parent].LeftSubtree) {
+            sister = pool[parent].RightSubtree;
+            CHECK(sister != 0);
+            if(compactRedBlackTreeGetColor(pool, sister) == CRBT_RED) {
+               compactRedBlackTreeSetColor(pool, sister, CRBT_BLACK);
+               compactRedBlackTreeSetColor(pool, parent, CRBT_RED);
+               compactRedBlackTreeRotateLeft(pool, parent);
+               sister = pool[parent].RightSubtree;
+               CHECK(sister != 0);
+            }
+            if((compactRedBlackTreeGetColor(pool, pool[sister].LeftSubtree) == CRBT_BLACK) &&
+               (compactRedBlackTreeGetColor(pool, pool[sister].RightSubtree) == CRBT_BLACK)) {
+               compactRedBlackTreeSetColor(pool, sister, CRBT_RED);
+               child = parent;
+            } else {
+               if(compactRedBlackTreeGetColor(pool, pool[sister].RightSubtree) == CRBT_BLACK) {
+                  CHECK(compactRedBlackTreeGetColor(pool, pool[sister].LeftSubtree) == CRBT_RED);
+                  compactRedBlackTreeSetColor(pool, pool[sister].LeftSubtree, CRBT_BLACK);
+                  compactRedBlackTreeSetColor(pool, sister, CRBT_RED);
+                  compactRedBlackTreeRotateRight(pool, sister);
+                  sister = pool[parent].RightSubtree;
+                  CHECK(sister != 0);
+               }
+               compactRedBlackTreeSetColor(pool, sister, compactRedBlackTreeGetColor(pool, parent));
+               compactRedBlackTreeSetColor(pool, pool[sister].RightSubtree, CRBT_BLACK);
+               compactRedBlackTreeSetColor(pool, parent, CRBT_BLACK);
+               compactRedBlackTreeRotateLeft(pool, parent);
+               break;
+            }
+         } else {
+            CHECK(child == pool[parent].RightSubtree);
+            sister = pool[parent].LeftSubtree;
+            CHECK(sister != 0);
+            if(compactRedBlackTreeGetColor(pool, sister) == CRBT_RED) {
+               compactRedBlackTreeSetColor(pool, sister, CRBT_BLACK);
+               compactRedBlackTreeSetColor(pool, parent, CRBT_RED);
+               compactRedBlackTreeRotateRight(pool, parent);
+               sister = pool[parent].LeftSubtree;
+               CHECK(sister != 0);
+            }
+            if((compactRedBlackTreeGetColor(pool, pool[sister].RightSubtree) == CRBT_BLACK) &&
+               (compactRedBlackTreeGetColor(pool, pool[sister].LeftSubtree) == CRBT_BLACK)) {
+               compactRedBlackTreeSetColor(pool, sister, CRBT_RED);
+               child = parent;
+            } else {
+               if(compactRedBlackTreeGetColor(pool, pool[sister].LeftSubtree) == CRBT_BLACK) {
+                  CHECK(compactRedBlackTreeGetColor(pool, pool[sister].RightSubtree) == CRBT_RED);
+                  compactRedBlackTreeSetColor(pool, pool[sister].RightSubtree, CRBT_BLACK);
+                  compactRedBlackTreeSetColor(pool, sister, CRBT_RED);
+                  compactRedBlackTreeRotateLeft(pool, sister);
+                  sister = pool[parent].LeftSubtree;
+                  CHECK(sister != 0);
+               }
+               compactRedBlackTreeSetColor(pool, sister, compactRedBlackTreeGetColor(pool, parent));
+               compactRedBlackTreeSetColor(pool, pool[sister].LeftSubtree, CRBT_BLACK);
+               compactRedBlackTreeSetColor(pool, parent, CRBT_BLACK);
+               compactRedBlackTreeRotateRight(pool, parent);
+               break;
+            }
+         }
+      }
+      compactRedBlackTreeSetColor(pool, child, CRBT_BLACK);
+      compactRedBlackTreeSetColor(pool, pool[0].LeftSubtree, CRBT_BLACK);
+   }
+   /* The null node's color may have been changed above */
+   compactRedBlackTreeSetColor(pool, 0, CRBT_BLACK);
+
+
+   /* ====== Free slot =================================================== */
+   pool[slot].Parent = crbt->FreeSlot;
+   pool[slot].Node   = NULL;
+   crbt->FreeSlot    = slot;
+   node->Slot        = 0;
+
+#ifdef DEBUG
+   compactRedBlackTreePrint(crbt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   compactRedBlackTreeVerify(crbt);
+#endif
+   return(node);
+}
+
+
+/* ##### Get node by value ############################################### */
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNodeByValue(
+                                   const struct CompactRedBlackTree* crbt,
+                                   CompactRedBlackTreeNodeValueType  value)
+{
+   const struct CompactRedBlackTreeSlot* pool = crbt->Pool;
+   uint32_t                              slot;
+
+   if(crbt->Elements == 0) {
+      return(NULL);
+   }
+   slot = pool[0].LeftSubtree;
+   for(;;) {
+      if(value < pool[pool[slot].LeftSubtree].ValueSum) {
+         if(pool[slot].LeftSubtree != 0) {
+            slot = pool[slot].LeftSubtree;
+         }
+         else {
+            break;
+         }
+      }
+      else if(value < pool[pool[slot].LeftSubtree].ValueSum + pool[slot].Node->Value) {
+         break;
+      }
+      else {
+         if(pool[slot].RightSubtree != 0) {
+            value -= pool[pool[slot].LeftSubtree].ValueSum + pool[slot].Node->Value;
+            slot = pool[slot].RightSubtree;
+         }
+         else {
+            break;
+         }
+      }
+   }
+   return(pool[slot].Node);
+}
+
+
+/* ##### Internal verification function ################################## */
+static size_t compactRedBlackTreeInternalVerify(struct CompactRedBlackTree* crbt,
+                                                const uint32_t              parent,
+                                                const uint32_t              slot,
+                                                uint32_t*                   lastSlot,
+                                                size_t*                     counter)
+{
+   const struct CompactRedBlackTreeSlot* pool = crbt->Pool;
+   size_t                                leftHeight;
+   size_t                                rightHeight;
+
+   if(slot != 0) {
+      /* ====== Correct parent and back-reference? ======================= */
+      CHECK(slot < crbt->Slots);
+      CHECK(compactRedBlackTreeGetParent(pool, slot) == parent);
+      CHECK(pool[slot].Node != NULL);
+      CHECK(pool[slot].Node->Slot == slot);
+
+      /* ====== Correct tree properties? ================================= */
+      if(pool[slot].LeftSubtree != 0) {
+         CHECK(crbt->ComparisonFunction(pool[slot].Node, pool[pool[slot].LeftSubtree].Node) > 0);
+      }
+      if(pool[slot].RightSubtree != 0) {
+         CHECK(crbt->ComparisonFunction(pool[slot].Node, pool[pool[slot].RightSubtree].Node) < 0);
+      }
+
+      /* ====== Is value sum okay? ======================================= */
+      CHECK(pool[slot].ValueSum == pool[pool[slot].LeftSubtree].ValueSum +
+                                   pool[slot].Node->Value +
+                                   pool[pool[slot].RightSubtree].ValueSum);
+
+      /* ====== Is left subtree okay? ==================================== */
+      leftHeight = compactRedBlackTreeInternalVerify(crbt, slot, pool[slot].LeftSubtree,
+                                                     lastSlot, counter);
+
+      /* ====== Is in-order walk okay? =================================== */
+      CHECK(compactRedBlackTreeInternalFindPrev(pool, slot) == *lastSlot);
+      *lastSlot = slot;
+      (*counter)++;
+
+      /* ====== Is right subtree okay? =================================== */
+      rightHeight = compactRedBlackTreeInternalVerify(crbt, slot, pool[slot].RightSubtree,
+                                                      lastSlot, counter);
+
+      /* ====== Verify red-black property ================================ */
+      CHECK((leftHeight != 0) || (rightHeight != 0));
+      CHECK(leftHeight == rightHeight);
+      if(compactRedBlackTreeGetColor(pool, slot) == CRBT_RED) {
+         CHECK(compactRedBlackTreeGetColor(pool, pool[slot].LeftSubtree) == CRBT_BLACK);
+         CHECK(compactRedBlackTreeGetColor(pool, pool[slot].RightSubtree) == CRBT_BLACK);
+         return(leftHeight);
+      }
+      CHECK(compactRedBlackTreeGetColor(pool, slot) == CRBT_BLACK);
+      return(leftHeight + 1);
+   }
+   return(1);
+}
+
+
+/* ##### Verify structures ############################################### */
+void compactRedBlackTreeVerify(struct CompactRedBlackTree* crbt)
+{
+   size_t   counter  = 0;
+   size_t   free     = 0;
+   uint32_t lastSlot = 0;
+   uint32_t slot;
+
+   if(crbt->Pool == NULL) {
+      CHECK(crbt->Elements == 0);
+      return;
+   }
+
+   CHECK(compactRedBlackTreeGetColor(crbt->Pool, 0) == CRBT_BLACK);
+   CHECK(crbt->Pool[0].ValueSum == 0);
+   CHECK(crbt->Pool[0].Node == NULL);
+   CHECK(compactRedBlackTreeInternalVerify(crbt, 0, crbt->Pool[0].LeftSubtree,
+                                           &lastSlot, &counter) != 0);
+   CHECK(counter == crbt->Elements);
+
+   /* ====== Check free slots ============================================= */
+   for(slot = crbt->FreeSlot;slot != 0;slot = compactRedBlackTreeGetParent(crbt->Pool, slot)) {
+      CHECK(slot < crbt->Slots);
+      CHECK(crbt->Pool[slot].Node == NULL);
+      free++;
+   }
+   CHECK(1 + counter + free == crbt->Slots);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
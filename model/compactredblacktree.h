@@ -0,0 +1,139 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef COMPACTREDBLACKTREE_H
+#define COMPACTREDBLACKTREE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Red-black tree whose topology is kept in a contiguous, growable slot
+   array of the tree, linked by 32-bit slot indices. The node embedded into
+   the element only contains its slot number and its value. Slot 0 is the
+   tree's null node; its left subtree is the root.
+
+   The color is the top bit of the parent link, and the slots are packed
+   to 4-byte alignment. A slot takes 28 bytes, i.e. an element takes 36
+   bytes with its embedded node, against 48 bytes for a node of the
+   SimpleRedBlackTree.
+*/
+typedef unsigned long long CompactRedBlackTreeNodeValueType;
+
+struct CompactRedBlackTreeNode
+{
+   uint32_t Slot;    /* 0 <=> not linked */
+   uint32_t Value;
+};
+
+#define CRBT_RED_BIT     0x80000000U
+#define CRBT_PARENT_MASK 0x7fffffffU
+
+#pragma pack(push, 4)
+struct CompactRedBlackTreeSlot
+{
+   uint32_t                         Parent;        /* Top bit: red; free slots: next free slot */
+   uint32_t                         LeftSubtree;
+   uint32_t                         RightSubtree;
+   CompactRedBlackTreeNodeValueType ValueSum;      /* ValueSum := LeftSubtree->ValueSum + Value + RightSubtree->ValueSum */
+   struct CompactRedBlackTreeNode*  Node;
+};
+#pragma pack(pop)
+
+struct CompactRedBlackTree
+{
+   struct CompactRedBlackTreeSlot* Pool;
+   uint32_t                        Slots;
+   uint32_t                        FreeSlot;
+   size_t                          Elements;
+   void                            (*PrintFunction)(const void* node, FILE* fd);
+   int                             (*ComparisonFunction)(const void* node1, const void* node2);
+};
+
+
+void compactRedBlackTreeNodeNew(struct CompactRedBlackTreeNode* node);
+void compactRedBlackTreeNodeDelete(struct CompactRedBlackTreeNode* node);
+int compactRedBlackTreeNodeIsLinked(const struct CompactRedBlackTreeNode* node);
+
+void compactRedBlackTreeNew(struct CompactRedBlackTree* crbt,
+                            void                        (*printFunction)(const void* node, FILE* fd),
+                            int                         (*comparisonFunction)(const void* node1, const void* node2));
+void compactRedBlackTreeDelete(struct CompactRedBlackTree* crbt);
+void compactRedBlackTreeVerify(struct CompactRedBlackTree* crbt);
+void compactRedBlackTreePrint(const struct CompactRedBlackTree* crbt, FILE* fd);
+int compactRedBlackTreeIsEmpty(const struct CompactRedBlackTree* crbt);
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetFirst(
+                                   const struct CompactRedBlackTree* crbt);
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetLast(
+                                   const struct CompactRedBlackTree* crbt);
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetPrev(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* node);
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNext(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* node);
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNearestPrev(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* cmpNode);
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNearestNext(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* cmpNode);
+size_t compactRedBlackTreeGetElements(const struct CompactRedBlackTree* crbt);
+size_t compactRedBlackTreeGetMemoryUsage(const struct CompactRedBlackTree* crbt);
+struct CompactRedBlackTreeNode* compactRedBlackTreeInsert(
+                                   struct CompactRedBlackTree*     crbt,
+                                   struct CompactRedBlackTreeNode* node);
+void compactRedBlackTreeBuild(struct CompactRedBlackTree*      crbt,
+                              struct CompactRedBlackTreeNode** nodeArray,
+                              const size_t                     nodes);
+struct CompactRedBlackTreeNode* compactRedBlackTreeRemove(
+                                   struct CompactRedBlackTree*     crbt,
+                                   struct CompactRedBlackTreeNode* node);
+struct CompactRedBlackTreeNode* compactRedBlackTreeFind(
+                                   const struct CompactRedBlackTree*     crbt,
+                                   const struct CompactRedBlackTreeNode* cmpNode);
+CompactRedBlackTreeNodeValueType compactRedBlackTreeGetValueSum(
+                                    const struct CompactRedBlackTree* crbt);
+struct CompactRedBlackTreeNode* compactRedBlackTreeGetNodeByValue(
+                                   const struct CompactRedBlackTree* crbt,
+                                   CompactRedBlackTreeNodeValueType  value);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -4,10 +4,50 @@
 #ifndef FAKE_ADDRESSCMP
 #define FAKE_ADDRESSCMP
 #endif
+#ifndef INCLUDE_LINEARLIST
+#define INCLUDE_LINEARLIST
+#endif
+#ifndef INCLUDE_SIMPLEBINARYTREE
+#define INCLUDE_SIMPLEBINARYTREE
+#endif
+#ifndef INCLUDE_LEAFLINKEDBINARYTREE
+#define INCLUDE_LEAFLINKEDBINARYTREE
+#endif
+#ifndef INCLUDE_SIMPLETREAP
+#define INCLUDE_SIMPLETREAP
+#endif
+#ifndef INCLUDE_LEAFLINKEDTREAP
+#define INCLUDE_LEAFLINKEDTREAP
+#endif
 #ifndef INCLUDE_SIMPLEREDBLACKTREE
 #define INCLUDE_SIMPLEREDBLACKTREE
 #endif
+#ifndef INCLUDE_LEAFLINKEDREDBLACKTREE
+#define INCLUDE_LEAFLINKEDREDBLACKTREE
+#endif
+/* Only the red-black tree has a compact variant with 32-bit slot links,
+   see compactredblacktree.h; there is no compact binary tree or treap */
+#ifndef INCLUDE_COMPACTREDBLACKTREE
+#define INCLUDE_COMPACTREDBLACKTREE
+#endif
+#ifndef INCLUDE_BPLUSTREE
+#define INCLUDE_BPLUSTREE
+#endif
 #ifndef USE_SIMPLEREDBLACKTREE
 #define USE_SIMPLEREDBLACKTREE
 #endif
+#ifndef USE_POOLELEMENT_IDENTIFIER_HASHINDEX
+#define USE_POOLELEMENT_IDENTIFIER_HASHINDEX
+#endif
+#ifndef USE_POOLHANDLE_HASHINDEX
+#define USE_POOLHANDLE_HASHINDEX
+#endif
+#ifndef USE_POOLELEMENT_SELECTION_BUCKETQUEUE
+#define USE_POOLELEMENT_SELECTION_BUCKETQUEUE
+#endif
+/* USE_POOLELEMENT_SELECTION_ALIASTABLE stays undefined: alias table draws
+   choose other PEs than the selection index for the same random numbers,
+   i.e. they would change the results of existing simulation setups.
+   Defining it enables them for all random policies; otherwise, they can
+   be enabled per policy by poolHandlespaceManagementSetAliasTableSelection() */
 #include <stdint.h>
@@ -0,0 +1,214 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "epochreclamation.h"
+#include "debug.h"
+
+#include <sched.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ###### Initialize ##################################################### */
+void epochReclamationNew(struct EpochReclamation* epochReclamation)
+{
+   size_t i;
+
+   epochReclamation->GlobalEpoch = 1;
+   for(i = 0;i < EPOCHRECLAMATION_MAX_READERS;i++) {
+      epochReclamation->Reader[i].Epoch = EPOCHRECLAMATION_IDLE;
+      epochReclamation->Reader[i].InUse = 0;
+   }
+   epochReclamation->RetiredListHead = NULL;
+   epochReclamation->RetiredListTail = NULL;
+   epochReclamation->RetiredItems    = 0;
+}
+
+
+/* ###### Invalidate ##################################################### */
+/*
+   All readers must have left their read-side sections; the remaining
+   retired items are freed.
+*/
+void epochReclamationDelete(struct EpochReclamation* epochReclamation)
+{
+   struct EpochRetiredItem* item;
+   size_t                   i;
+
+   for(i = 0;i < EPOCHRECLAMATION_MAX_READERS;i++) {
+      CHECK(__atomic_load_n(&epochReclamation->Reader[i].Epoch, __ATOMIC_ACQUIRE) == EPOCHRECLAMATION_IDLE);
+   }
+   while(epochReclamation->RetiredListHead != NULL) {
+      item = epochReclamation->RetiredListHead;
+      epochReclamation->RetiredListHead = item->Next;
+      item->FreeFunction(item->Pointer);
+      free(item);
+   }
+   epochReclamation->RetiredListTail = NULL;
+   epochReclamation->RetiredItems    = 0;
+}
+
+
+/* ###### Get reader ID for a new reader thread ########################## */
+/*
+   May be called by any thread. Returns -1, if there are already
+   EPOCHRECLAMATION_MAX_READERS readers.
+*/
+int epochReclamationRegisterReader(struct EpochReclamation* epochReclamation)
+{
+   int expected;
+   int i;
+
+   for(i = 0;i < EPOCHRECLAMATION_MAX_READERS;i++) {
+      expected = 0;
+      if(__atomic_compare_exchange_n(&epochReclamation->Reader[i].InUse, &expected, 1, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+         return(i);
+      }
+   }
+   return(-1);
+}
+
+
+/* ###### Release reader ID ############################################## */
+/* May be called by any thread, outside of a read-side section. */
+void epochReclamationUnregisterReader(struct EpochReclamation* epochReclamation,
+                                      const int                readerID)
+{
+   CHECK((readerID >= 0) && (readerID < EPOCHRECLAMATION_MAX_READERS));
+   CHECK(__atomic_load_n(&epochReclamation->Reader[readerID].Epoch, __ATOMIC_ACQUIRE) == EPOCHRECLAMATION_IDLE);
+   __atomic_store_n(&epochReclamation->Reader[readerID].InUse, 0, __ATOMIC_RELEASE);
+}
+
+
+/* ###### Try to advance the global epoch ################################ */
+static int epochReclamationTryAdvance(struct EpochReclamation* epochReclamation)
+{
+   const unsigned long long globalEpoch = epochReclamation->GlobalEpoch;
+   unsigned long long       epoch;
+   size_t                   i;
+
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+   for(i = 0;i < EPOCHRECLAMATION_MAX_READERS;i++) {
+      epoch = __atomic_load_n(&epochReclamation->Reader[i].Epoch, __ATOMIC_ACQUIRE);
+      if((epoch != EPOCHRECLAMATION_IDLE) && (epoch != globalEpoch)) {
+         return(0);
+      }
+   }
+   __atomic_store_n(&epochReclamation->GlobalEpoch, globalEpoch + 1, __ATOMIC_RELEASE);
+   return(1);
+}
+
+
+/* ###### Free retired items no reader can reference anymore ############# */
+static size_t epochReclamationFreeRetiredItems(struct EpochReclamation* epochReclamation)
+{
+   struct EpochRetiredItem* item;
+   size_t                   freed = 0;
+
+   while( (epochReclamation->RetiredListHead != NULL) &&
+          (epochReclamation->RetiredListHead->Epoch + 2 <= epochReclamation->GlobalEpoch) ) {
+      item = epochReclamation->RetiredListHead;
+      epochReclamation->RetiredListHead = item->Next;
+      item->FreeFunction(item->Pointer);
+      free(item);
+      freed++;
+   }
+   if(epochReclamation->RetiredListHead == NULL) {
+      epochReclamation->RetiredListTail = NULL;
+   }
+   epochReclamation->RetiredItems -= freed;
+   return(freed);
+}
+
+
+/* ###### Retire memory which has been unlinked by the writer ############ */
+/*
+   The pointer must not be reachable for readers entering from now on.
+   If no retirement record can be allocated, this waits for the readers
+   and frees the pointer immediately.
+*/
+void epochReclamationRetire(struct EpochReclamation* epochReclamation,
+                            void*                    pointer,
+                            void                   (*freeFunction)(void* pointer))
+{
+   struct EpochRetiredItem* item = (struct EpochRetiredItem*)malloc(sizeof(struct EpochRetiredItem));
+   if(item == NULL) {
+      epochReclamationSynchronize(epochReclamation);
+      freeFunction(pointer);
+      return;
+   }
+
+   item->Next         = NULL;
+   item->Pointer      = pointer;
+   item->FreeFunction = freeFunction;
+   item->Epoch        = epochReclamation->GlobalEpoch;
+   if(epochReclamation->RetiredListTail != NULL) {
+      epochReclamation->RetiredListTail->Next = item;
+   }
+   else {
+      epochReclamation->RetiredListHead = item;
+   }
+   epochReclamation->RetiredListTail = item;
+   epochReclamation->RetiredItems++;
+}
+
+
+/* ###### Advance the epoch if possible and free retired items ########### */
+/* Does not block; returns the number of freed items. */
+size_t epochReclamationReclaim(struct EpochReclamation* epochReclamation)
+{
+   if(epochReclamation->RetiredListHead != NULL) {
+      epochReclamationTryAdvance(epochReclamation);
+      return(epochReclamationFreeRetiredItems(epochReclamation));
+   }
+   return(0);
+}
+
+
+/* ###### Wait until all readers have left their current sections ####### */
+/* Afterwards, all items retired so far have been freed. */
+void epochReclamationSynchronize(struct EpochReclamation* epochReclamation)
+{
+   const unsigned long long targetEpoch = epochReclamation->GlobalEpoch + 2;
+
+   while(epochReclamation->GlobalEpoch < targetEpoch) {
+      while(!epochReclamationTryAdvance(epochReclamation)) {
+         sched_yield();
+      }
+   }
+   epochReclamationFreeRetiredItems(epochReclamation);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
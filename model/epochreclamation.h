@@ -0,0 +1,124 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef EPOCHRECLAMATION_H
+#define EPOCHRECLAMATION_H
+
+#include <stdlib.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Epoch-based reclamation for one writer and up to
+   EPOCHRECLAMATION_MAX_READERS concurrent reader threads. A reader
+   announces the global epoch while it is inside a read-side section;
+   memory which the writer has unlinked is retired with the current
+   epoch and freed once the global epoch has advanced twice, i.e. when no
+   reader can still hold a reference to it. The global epoch only
+   advances when all readers inside a read-side section have announced
+   the current one.
+
+   Reader functions may be called concurrently from the reader threads;
+   all other functions must be called by the writer only.
+*/
+#define EPOCHRECLAMATION_MAX_READERS 64
+#define EPOCHRECLAMATION_IDLE        0ULL
+
+struct EpochReader
+{
+   unsigned long long Epoch;      /* Announced epoch, or EPOCHRECLAMATION_IDLE */
+   int                InUse;
+   char               Padding[64 - sizeof(unsigned long long) - sizeof(int)];
+};
+
+struct EpochRetiredItem
+{
+   struct EpochRetiredItem* Next;
+   void*                    Pointer;
+   void                   (*FreeFunction)(void* pointer);
+   unsigned long long       Epoch;
+};
+
+struct EpochReclamation
+{
+   unsigned long long       GlobalEpoch;
+   char                     Padding[64 - sizeof(unsigned long long)];
+   struct EpochReader       Reader[EPOCHRECLAMATION_MAX_READERS];
+
+   struct EpochRetiredItem* RetiredListHead;   /* Oldest first */
+   struct EpochRetiredItem* RetiredListTail;
+   size_t                   RetiredItems;
+};
+
+
+void epochReclamationNew(struct EpochReclamation* epochReclamation);
+void epochReclamationDelete(struct EpochReclamation* epochReclamation);
+int epochReclamationRegisterReader(struct EpochReclamation* epochReclamation);
+void epochReclamationUnregisterReader(struct EpochReclamation* epochReclamation,
+                                      const int                readerID);
+void epochReclamationRetire(struct EpochReclamation* epochReclamation,
+                            void*                    pointer,
+                            void                   (*freeFunction)(void* pointer));
+size_t epochReclamationReclaim(struct EpochReclamation* epochReclamation);
+void epochReclamationSynchronize(struct EpochReclamation* epochReclamation);
+
+inline static size_t epochReclamationGetRetiredItems(const struct EpochReclamation* epochReclamation)
+{
+   return(epochReclamation->RetiredItems);
+}
+
+/* Enter read-side section: memory reachable from now on is not freed
+   before epochReclamationLeave(). The announcement has to be visible
+   before any shared pointer is loaded, hence the full barrier. */
+inline static void epochReclamationEnter(struct EpochReclamation* epochReclamation,
+                                         const int                readerID)
+{
+   __atomic_store_n(&epochReclamation->Reader[readerID].Epoch,
+                    __atomic_load_n(&epochReclamation->GlobalEpoch, __ATOMIC_ACQUIRE),
+                    __ATOMIC_SEQ_CST);
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/* Leave read-side section */
+inline static void epochReclamationLeave(struct EpochReclamation* epochReclamation,
+                                         const int                readerID)
+{
+   __atomic_store_n(&epochReclamation->Reader[readerID].Epoch,
+                    EPOCHRECLAMATION_IDLE, __ATOMIC_RELEASE);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
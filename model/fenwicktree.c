@@ -0,0 +1,204 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "fenwicktree.h"
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ###### Initialize ##################################################### */
+void fenwickTreeNew(struct FenwickTree* fenwickTree)
+{
+   fenwickTree->Entries  = 0;
+   fenwickTree->Capacity = 0;
+   fenwickTree->ValueSum = 0;
+   fenwickTree->Value    = NULL;
+   fenwickTree->Tree     = NULL;
+   fenwickTree->Element  = NULL;
+}
+
+
+/* ###### Invalidate ##################################################### */
+void fenwickTreeDelete(struct FenwickTree* fenwickTree)
+{
+   free(fenwickTree->Value);
+   free(fenwickTree->Tree);
+   free(fenwickTree->Element);
+   fenwickTreeNew(fenwickTree);
+}
+
+
+/* ###### Remove all elements ############################################ */
+void fenwickTreeClear(struct FenwickTree* fenwickTree)
+{
+   fenwickTree->Entries  = 0;
+   fenwickTree->ValueSum = 0;
+}
+
+
+/* ###### Append element (fenwickTreeBuild() has to be called after) ##### */
+int fenwickTreeAppend(struct FenwickTree*        fenwickTree,
+                      void*                      element,
+                      const FenwickTreeValueType value)
+{
+   FenwickTreeValueType* newValue;
+   FenwickTreeValueType* newTree;
+   void**                newElement;
+   size_t                newCapacity;
+
+   if(fenwickTree->Entries >= fenwickTree->Capacity) {
+      newCapacity = (fenwickTree->Capacity > 0) ? (2 * fenwickTree->Capacity) : 16;
+      newValue    = (FenwickTreeValueType*)realloc(fenwickTree->Value,
+                                                   newCapacity * sizeof(FenwickTreeValueType));
+      if(newValue == NULL) {
+         return(0);
+      }
+      fenwickTree->Value = newValue;
+      newElement  = (void**)realloc(fenwickTree->Element, newCapacity * sizeof(void*));
+      if(newElement == NULL) {
+         return(0);
+      }
+      fenwickTree->Element = newElement;
+      newTree     = (FenwickTreeValueType*)realloc(fenwickTree->Tree,
+                                                   (newCapacity + 1) * sizeof(FenwickTreeValueType));
+      if(newTree == NULL) {
+         return(0);
+      }
+      fenwickTree->Tree     = newTree;
+      fenwickTree->Capacity = newCapacity;
+   }
+
+   fenwickTree->Value[fenwickTree->Entries]   = value;
+   fenwickTree->Element[fenwickTree->Entries] = element;
+   fenwickTree->Entries++;
+   return(1);
+}
+
+
+/* ###### Compute partial sums from values in O(n) ####################### */
+void fenwickTreeBuild(struct FenwickTree* fenwickTree)
+{
+   size_t i, j;
+
+   fenwickTree->ValueSum = 0;
+   for(i = 1;i <= fenwickTree->Entries;i++) {
+      fenwickTree->Tree[i]   = fenwickTree->Value[i - 1];
+      fenwickTree->ValueSum += fenwickTree->Value[i - 1];
+   }
+   for(i = 1;i <= fenwickTree->Entries;i++) {
+      j = i + (i & (~i + 1));
+      if(j <= fenwickTree->Entries) {
+         fenwickTree->Tree[j] += fenwickTree->Tree[i];
+      }
+   }
+}
+
+
+/* ###### Verify structure ############################################### */
+void fenwickTreeVerify(const struct FenwickTree* fenwickTree)
+{
+   FenwickTreeValueType sum;
+   FenwickTreeValueType valueSum = 0;
+   size_t               i, j;
+
+   CHECK(fenwickTree->Entries <= fenwickTree->Capacity);
+   for(i = 1;i <= fenwickTree->Entries;i++) {
+      sum = 0;
+      for(j = i - (i & (~i + 1));j < i;j++) {
+         sum += fenwickTree->Value[j];
+      }
+      CHECK(fenwickTree->Tree[i] == sum);
+      valueSum += fenwickTree->Value[i - 1];
+   }
+   CHECK(fenwickTree->ValueSum == valueSum);
+}
+
+
+/* ###### Set value of element ########################################### */
+void fenwickTreeUpdate(struct FenwickTree*        fenwickTree,
+                       const size_t               index,
+                       const FenwickTreeValueType value)
+{
+   /* Unsigned arithmetic: adding the difference modulo 2^64 is correct
+      for decreasing values as well. */
+   const FenwickTreeValueType difference = value - fenwickTree->Value[index];
+   size_t                     i;
+
+   CHECK(index < fenwickTree->Entries);
+   fenwickTree->Value[index]  = value;
+   fenwickTree->ValueSum     += difference;
+   for(i = index + 1;i <= fenwickTree->Entries;i += (i & (~i + 1))) {
+      fenwickTree->Tree[i] += difference;
+   }
+}
+
+
+/* ###### Find first element whose prefix sum exceeds given value ####### */
+/*
+   This is the element GetNodeByValue() of the storage classes returns for
+   the same sequence. Returns fenwickTreeGetEntries(), if value is not
+   smaller than the value sum.
+*/
+size_t fenwickTreeFindByValue(const struct FenwickTree* fenwickTree,
+                              FenwickTreeValueType      value)
+{
+   size_t position = 0;
+   size_t step     = 1;
+
+   while(2 * step <= fenwickTree->Entries) {
+      step *= 2;
+   }
+   for(;step > 0;step /= 2) {
+      if((position + step <= fenwickTree->Entries) &&
+         (fenwickTree->Tree[position + step] <= value)) {
+         position += step;
+         value    -= fenwickTree->Tree[position];
+      }
+   }
+   return(position);
+}
+
+
+/* ###### Get number of bytes allocated for the arrays ################### */
+size_t fenwickTreeGetMemoryUsage(const struct FenwickTree* fenwickTree)
+{
+   if(fenwickTree->Capacity == 0) {
+      return(0);
+   }
+   return((fenwickTree->Capacity * (sizeof(FenwickTreeValueType) + sizeof(void*))) +
+          ((fenwickTree->Capacity + 1) * sizeof(FenwickTreeValueType)));
+}
+
+
+#ifdef __cplusplus
+}
+#endif
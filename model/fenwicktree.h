@@ -0,0 +1,102 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Binary indexed tree over the values of a fixed sequence of elements.
+   Supports prefix-sum search and in-place value updates in O(log n).
+   The sequence itself is (re-)filled by fenwickTreeClear() and
+   fenwickTreeAppend(), followed by fenwickTreeBuild() in O(n).
+*/
+typedef unsigned long long FenwickTreeValueType;
+
+struct FenwickTree
+{
+   size_t                Entries;
+   size_t                Capacity;
+   FenwickTreeValueType  ValueSum;
+   FenwickTreeValueType* Value;      /* Value[i] of element i             */
+   FenwickTreeValueType* Tree;       /* Partial sums, 1-based             */
+   void**                Element;    /* Element[i] is the i-th element    */
+};
+
+
+void fenwickTreeNew(struct FenwickTree* fenwickTree);
+void fenwickTreeDelete(struct FenwickTree* fenwickTree);
+void fenwickTreeClear(struct FenwickTree* fenwickTree);
+int fenwickTreeAppend(struct FenwickTree*        fenwickTree,
+                      void*                      element,
+                      const FenwickTreeValueType value);
+void fenwickTreeBuild(struct FenwickTree* fenwickTree);
+void fenwickTreeVerify(const struct FenwickTree* fenwickTree);
+void fenwickTreeUpdate(struct FenwickTree*        fenwickTree,
+                       const size_t               index,
+                       const FenwickTreeValueType value);
+size_t fenwickTreeFindByValue(const struct FenwickTree* fenwickTree,
+                              FenwickTreeValueType      value);
+size_t fenwickTreeGetMemoryUsage(const struct FenwickTree* fenwickTree);
+
+inline static size_t fenwickTreeGetEntries(const struct FenwickTree* fenwickTree)
+{
+   return(fenwickTree->Entries);
+}
+
+inline static FenwickTreeValueType fenwickTreeGetValueSum(const struct FenwickTree* fenwickTree)
+{
+   return(fenwickTree->ValueSum);
+}
+
+inline static FenwickTreeValueType fenwickTreeGetValue(const struct FenwickTree* fenwickTree,
+                                                       const size_t              index)
+{
+   return(fenwickTree->Value[index]);
+}
+
+inline static void* fenwickTreeGetElement(const struct FenwickTree* fenwickTree,
+                                          const size_t              index)
+{
+   return(fenwickTree->Element[index]);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
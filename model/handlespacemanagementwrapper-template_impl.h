@@ -0,0 +1,1589 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+/*
+   This file is included once per storage backend by
+   handlespacemanagementwrapper.cc, with ST_CLASS(x) set to the backend's
+   class name suffix.
+*/
+
+
+
+// ##########################################################################
+// #### Pool Element                                                     ####
+// ##########################################################################
+
+class ST_CLASS(cPoolElement) : public cPoolElement
+{
+   public:
+   ST_CLASS(cPoolElement)(struct ST_CLASS(PoolElementNode)* poolElementNode);
+   virtual void print(const bool full);
+
+   // ====== Set/Get methods ================================================
+   virtual unsigned int getHomeRegistrarIdentifier() const {
+      return(Node->HomeRegistrarIdentifier);
+   }
+   virtual void setHomeRegistrarIdentifier(unsigned int identifier) {
+      Node->HomeRegistrarIdentifier = identifier;
+   }
+   virtual unsigned int getIdentifier() const {
+      return(Node->Identifier);
+   }
+   virtual void setIdentifier(unsigned int identifier) {
+      Node->Identifier = identifier;
+   }
+   virtual unsigned int getRegistratorAddress() const {
+      return(Node->RegistratorTransport->AddressArray[0].ta.ta_addr);
+   }
+   virtual void setRegistratorAddress(unsigned int address) {
+      Node->RegistratorTransport->AddressArray[0].ta.ta_family = AF_TEST;
+      Node->RegistratorTransport->AddressArray[0].ta.ta_addr   = address;
+   }
+   virtual unsigned int getRegistratorPort() const {
+      return(Node->RegistratorTransport->AddressArray[0].ta.ta_port);
+   }
+   virtual void setRegistratorPort(unsigned int port) {
+      Node->RegistratorTransport->AddressArray[0].ta.ta_family = AF_TEST;
+      Node->RegistratorTransport->AddressArray[0].ta.ta_port   = port;
+   }
+   virtual unsigned int getRegistrationLife() const {
+      return(Node->RegistrationLife);
+   }
+   virtual void setRegistrationLife(unsigned int registrationLife) {
+      Node->RegistrationLife = registrationLife;
+   }
+   virtual unsigned int getSelectionCounter() const {
+      return(Node->SelectionCounter);
+   }
+   virtual void setSelectionCounter(unsigned int selectionCounter) {
+      Node->SelectionCounter = selectionCounter;
+   }
+   virtual unsigned int getVirtualCounter() const {
+      return(Node->VirtualCounter);
+   }
+   virtual void setVirtualCounter(unsigned int selectionCounter) {
+      Node->VirtualCounter = selectionCounter;
+   }
+   virtual unsigned int getUnreachabilityReports() const {
+      return(Node->UnreachabilityReports);
+   }
+   virtual void setUnreachabilityReports(unsigned int reports) {
+      Node->UnreachabilityReports = reports;
+   }
+
+   virtual unsigned int getPolicyType() const {
+      return(Node->PolicySettings.PolicyType);
+   }
+   virtual void setPolicyType(unsigned int policyType) {
+      Node->PolicySettings.PolicyType = policyType;
+   }
+   virtual unsigned int getWeight() const {
+      return(Node->PolicySettings.Weight);
+   }
+   virtual void setWeight(unsigned int weight) {
+      Node->PolicySettings.Weight = weight;
+   }
+   virtual unsigned int getLoad() const {
+      return(Node->PolicySettings.Load);
+   }
+   virtual void setLoad(unsigned int load) {
+      Node->PolicySettings.Load = load;
+   }
+   virtual unsigned int getLoadDegradation() const {
+      return(Node->PolicySettings.LoadDegradation);
+   }
+   virtual void setLoadDegradation(unsigned int loadDegradation) {
+      Node->PolicySettings.LoadDegradation = loadDegradation;
+   }
+   virtual unsigned int getLoadDPF() const {
+      return(Node->PolicySettings.LoadDPF);
+   }
+   virtual void setLoadDPF(unsigned int loadDPF) {
+      Node->PolicySettings.LoadDPF = loadDPF;
+   }
+   virtual unsigned int getWeightDPF() const {
+      return(Node->PolicySettings.WeightDPF);
+   }
+   virtual void setWeightDPF(unsigned int loadDPF) {
+      Node->PolicySettings.WeightDPF = loadDPF;
+   }
+   virtual unsigned int getDistance() const {
+      return(Node->PolicySettings.Distance);
+   }
+   virtual void setDistance(unsigned int distance) {
+      Node->PolicySettings.Distance = distance;
+   }
+   virtual unsigned int getAddress() const {
+      return(Node->UserTransport->AddressArray[0].ta.ta_addr);
+   }
+   virtual void setAddress(unsigned int address) {
+      Node->UserTransport->AddressArray[0].ta.ta_family = AF_TEST;
+      Node->UserTransport->AddressArray[0].ta.ta_addr   = address;
+   }
+   virtual unsigned int getPort() const {
+      return(Node->UserTransport->AddressArray[0].ta.ta_port);
+   }
+   virtual void setPort(unsigned int port) {
+      Node->UserTransport->AddressArray[0].ta.ta_family = AF_TEST;
+      Node->UserTransport->AddressArray[0].ta.ta_port   = port;
+   }
+   virtual const char* getOwnerPoolHandle() const {
+      return((const char*)Node->OwnerPoolNode->Handle.Handle);
+   }
+   virtual unsigned int getOwnerPoolHandleID() const {
+      return(Node->OwnerPoolNode->Handle.Identifier);
+   }
+
+
+   // ====== Public data ====================================================
+   public:
+   struct ST_CLASS(PoolElementNode)* Node;
+};
+
+
+
+// ##########################################################################
+// #### Handlespace                                                      ####
+// ##########################################################################
+
+class ST_CLASS(cPoolHandlespace) : public cPoolHandlespace
+{
+   public:
+   ST_CLASS(cPoolHandlespace)(const unsigned int homeRegistrarIdentifier);
+   virtual ~ST_CLASS(cPoolHandlespace)();
+
+   virtual cPeerList* createPeerList(const unsigned int registrarIdentifier);
+
+
+   // ====== Handlespace management =========================================
+   virtual void clear();
+   virtual void print(const unsigned int homeRegistrarIdentifier = 0);
+
+   using cPoolHandlespace::registerPoolElement;
+   using cPoolHandlespace::findPoolElement;
+   using cPoolHandlespace::deregisterPoolElement;
+   using cPoolHandlespace::getPoolElementsOfPool;
+   using cPoolHandlespace::selectPoolElementsByPolicy;
+
+   virtual unsigned int registerPoolElement(const unsigned int           poolHandleID,
+                                            const cPoolElementParameter& poolElementParameter,
+                                            const unsigned int           registratorAddress,
+                                            const unsigned int           registratorPort,
+                                            cPoolElement*&               poolElement,
+                                            bool&                        updated);
+   virtual size_t registerHandleTable(ENRPHandleTableResponse* handleTable,
+                                      cPoolElement**           poolElementArray);
+   virtual cPoolElement* findPoolElement(const unsigned int poolHandleID,
+                                         const unsigned int peIdentifier);
+   virtual unsigned int deregisterPoolElement(cPoolElement* poolElement);
+   virtual unsigned int deregisterPoolElement(const unsigned int poolHandleID,
+                                              const unsigned int peIdentifier);
+   virtual void updatePoolElementOwnership(cPoolElement*      poolElement,
+                                           const unsigned int registrarIdentifier);
+   virtual size_t transferPoolElementOwnership(const unsigned int oldRegistrarIdentifier,
+                                               const unsigned int newRegistrarIdentifier);
+
+
+   // ====== Set/Get methods ================================================
+   virtual unsigned int getHandlespaceChecksum() const {
+      return(ST_CLASS(poolHandlespaceManagementGetHandlespaceChecksum)(&Handlespace));
+   }
+   virtual unsigned int getOwnershipChecksum() const {
+      return(ST_CLASS(poolHandlespaceManagementGetOwnershipChecksum)(&Handlespace));
+   }
+   virtual size_t getPools() {
+      return(ST_CLASS(poolHandlespaceManagementGetPools)(&Handlespace));
+   }
+   virtual size_t getPoolElements() const {
+      return(ST_CLASS(poolHandlespaceManagementGetPoolElements)(&Handlespace));
+   }
+   virtual size_t getOwnedPoolElements() const {
+      return(ST_CLASS(poolHandlespaceManagementGetOwnedPoolElements)(&Handlespace));
+   }
+   virtual size_t getPoolElementsOfPool(const unsigned int poolHandleID);
+   virtual void getMemoryUsage(HandlespaceMemoryUsage& memoryUsage);
+
+   virtual cPoolElement* getFirstPoolElementNode() {
+      return(getPoolElement(
+                ST_CLASS(poolHandlespaceManagementGetFirstPoolElementOwnershipNode)(&Handlespace)));
+   }
+   virtual cPoolElement* getNextPoolElementNode(cPoolElement* node) {
+      return(getPoolElement(
+                ST_CLASS(poolHandlespaceManagementGetNextPoolElementOwnershipNode)(
+                   &Handlespace, getNode(node))));
+   }
+
+   virtual cPoolElement* getFirstPoolElementOwnedBy(const unsigned int homeRegistrarIdentifier);
+   virtual cPoolElement* getNextPoolElementOfSameOwner(cPoolElement* poolElement);
+
+   virtual void restartPoolElementExpiryTimer(cPoolElement*            poolElement,
+                                              const unsigned long long expiryTimeout);
+   virtual size_t purgeExpiredPoolElements();
+
+
+   virtual size_t selectPoolElementsByPolicy(const unsigned int poolHandleID,
+                                             cPoolElement**     selectionArray,
+                                             size_t&            items,
+                                             const size_t       maxHandleResolutionItems,
+                                             const size_t       maxIncrement);
+   virtual size_t selectPoolElementsByPolicy(cHandleResolutionRequest* requestArray,
+                                             const size_t              requests,
+                                             cPoolElement**            selectionArray,
+                                             const size_t              maxItems);
+   virtual cArray* exportToPoolEntries(const unsigned int homeRegistrarIdentifier);
+
+   virtual unsigned long long getHandlespaceVersion() const {
+      return(ST_CLASS(poolHandlespaceManagementGetModificationSequence)(&Handlespace));
+   }
+   virtual bool hasChangesSince(const unsigned long long version) const {
+      return(ST_CLASS(poolHandlespaceManagementHasChangesSince)(&Handlespace, version) != 0);
+   }
+   virtual cArray* exportChangesToPoolEntries(const unsigned int       homeRegistrarIdentifier,
+                                              const unsigned long long sinceVersion,
+                                              cArray*&                 deletedPoolEntryArray);
+
+   virtual void getOwnershipDigests(const unsigned int registrarIdentifier,
+                                    unsigned int*      digestArray);
+   virtual unsigned int getPoolOwnershipDigest(const unsigned int registrarIdentifier,
+                                               const unsigned int poolHandleID);
+   virtual unsigned int getOwnershipDigestBucket(const unsigned int poolHandleID) const;
+   virtual cArray* exportPoolDigests(const unsigned int* digestArray);
+   virtual cArray* exportPoolsToPoolEntries(const unsigned int  homeRegistrarIdentifier,
+                                            const unsigned int* poolHandleIDArray,
+                                            const size_t        poolHandleIDs);
+
+
+   // ====== Private data ===================================================
+   private:
+   friend class ST_CLASS(cPeerList);
+
+   inline static cPoolElement* getPoolElement(struct ST_CLASS(PoolElementNode)* poolElementNode) {
+      if(poolElementNode) {
+         return((cPoolElement*)poolElementNode->UserData);
+      }
+      return(NULL);
+   }
+   inline static struct ST_CLASS(PoolElementNode)* getNode(cPoolElement* poolElement) {
+      return(((ST_CLASS(cPoolElement)*)poolElement)->Node);
+   }
+   static cPoolElement* getPoolElementOfNode(struct ST_CLASS(PoolElementNode)* poolElementNode);
+   static void killPoolElementNode(struct ST_CLASS(PoolElementNode)* poolElementNode,
+                                   void*                             userData);
+
+   struct ST_CLASS(PoolHandlespaceManagement) Handlespace;
+
+   // Handle resolution space, kept for the next call
+   std::vector<struct ST_CLASS(PoolElementNode)*>         SelectionScratch;
+   std::vector<struct ST_CLASS(HandleResolutionRequest)> RequestScratch;
+};
+
+
+
+// ##########################################################################
+// #### Peer List Node                                                   ####
+// ##########################################################################
+
+class ST_CLASS(cPeerListNode) : public cPeerListNode
+{
+   public:
+   ST_CLASS(cPeerListNode)(struct ST_CLASS(PeerListNode)* peerListNode);
+   virtual void print(const bool full);
+
+
+   // ====== Set/Get methods ================================================
+   virtual unsigned int getIdentifier() const {
+      return((unsigned int)Node->Identifier);
+   }
+   virtual void setIdentifier(const unsigned int identifier) {
+      Node->Identifier = (RegistrarIdentifierType)identifier;
+   }
+   virtual unsigned int getStatus() const {
+      return(Node->Status);
+   }
+   virtual void setStatus(unsigned int status) {
+      Node->Status = status;
+   }
+   virtual unsigned int getAddress() const {
+      return(Node->AddressBlock->AddressArray[0].ta.ta_addr);
+   }
+   virtual void setAddress(unsigned int address) {
+      Node->AddressBlock->AddressArray[0].ta.ta_family = AF_TEST;
+      Node->AddressBlock->AddressArray[0].ta.ta_addr   = address;
+   }
+   virtual unsigned int getPort() const {
+      return(Node->AddressBlock->AddressArray[0].ta.ta_port);
+   }
+   virtual void setPort(unsigned int port) {
+      Node->AddressBlock->AddressArray[0].ta.ta_family = AF_TEST;
+      Node->AddressBlock->AddressArray[0].ta.ta_port   = port;
+   }
+   virtual bool getNewFlag() const {
+      return((Node->Flags & PLNF_NEW) != 0);
+   }
+   virtual simtime_t getLastHeared() const {
+      return((simtime_t)(Node->LastUpdateTimeStamp / 1000000.0));
+   }
+   virtual void setLastHeared(const simtime_t lastHeared) {
+      Node->LastUpdateTimeStamp = (unsigned long long)(1000000.0 * lastHeared.dbl());
+   }
+   virtual unsigned int getTakeoverRegistrarID() const {
+      return(Node->TakeoverRegistrarID);
+   }
+   virtual void setTakeoverRegistrarID(unsigned int registrarIdentifier) {
+      Node->TakeoverRegistrarID = (RegistrarIdentifierType)registrarIdentifier;
+   }
+   virtual unsigned int getOwnershipChecksum() const {
+      return(ST_CLASS(peerListNodeGetOwnershipChecksum)(Node));
+   }
+
+
+   // ====== Public data ====================================================
+   public:
+   struct ST_CLASS(PeerListNode)* Node;
+};
+
+
+
+// ##########################################################################
+// #### Peer List                                                        ####
+// ##########################################################################
+
+class ST_CLASS(cPeerList) : public cPeerList
+{
+   public:
+   ST_CLASS(cPeerList)(ST_CLASS(cPoolHandlespace)* handlespace,
+                       const unsigned int          registrarIdentifier);
+   virtual ~ST_CLASS(cPeerList)();
+
+
+   // ====== PeerList management ============================================
+   virtual void clear();
+   virtual void print();
+   virtual unsigned int registerPeerListNode(const ServerInformationParameter& serverInformationParameter,
+                                             cPeerListNode*&                   node);
+   virtual unsigned int deregisterPeerListNode(cPeerListNode* peerListEntry);
+   virtual unsigned int deregisterPeerListNode(unsigned int identifier);
+   virtual cPeerListNode* findPeerListNode(const unsigned int identifier);
+   virtual cPeerListNode* findPeerListNode(const unsigned int address,
+                                           const unsigned int port);
+   virtual void purge();
+   virtual cPeerListNode* getUsefulPeerForPE(const unsigned int identifier);
+
+
+   // ====== Set/Get methods ================================================
+   virtual unsigned int getOwnIdentifier() const {
+      return(List.List.OwnIdentifier);
+   }
+   virtual cPeerListNode* getRandomPeerListNode();
+   virtual size_t getPeers() const {
+      return(ST_CLASS(peerListManagementGetPeers)(&List));
+   }
+   virtual void getMemoryUsage(HandlespaceMemoryUsage& memoryUsage);
+   virtual cPeerListNode* getFirstPeerListNode() {
+      return(getPeerListNode(
+                ST_CLASS(peerListManagementGetFirstPeerListNodeFromIndexStorage)(&List)));
+   }
+   virtual cPeerListNode* getNextPeerListNode(cPeerListNode* node) {
+      return(getPeerListNode(
+                ST_CLASS(peerListManagementGetNextPeerListNodeFromIndexStorage)(
+                   &List, ((ST_CLASS(cPeerListNode)*)node)->Node)));
+   }
+
+
+   // ====== Private data ===================================================
+   private:
+   inline static cPeerListNode* getPeerListNode(struct ST_CLASS(PeerListNode)* peerListNode) {
+      if(peerListNode) {
+         return((cPeerListNode*)peerListNode->UserData);
+      }
+      return(NULL);
+   }
+   static void killPeerListNode(struct ST_CLASS(PeerListNode)* peerListNode,
+                                void*                          userData);
+
+   struct ST_CLASS(PeerListManagement) List;
+};
+
+
+
+// ##########################################################################
+// #### Pool User List                                                   ####
+// ##########################################################################
+
+class ST_CLASS(cPoolUserList) : public cPoolUserList
+{
+   public:
+   ST_CLASS(cPoolUserList)();
+   virtual ~ST_CLASS(cPoolUserList)();
+
+
+   // ====== PoolUserList management ========================================
+   virtual void clear();
+   virtual void print();
+
+   virtual void purge(const simtime_t minTime);
+   virtual double noteHandleResolutionOfPoolUser(const unsigned int poolHandleID,
+                                                 const unsigned int address,
+                                                 const unsigned int port,
+                                                 const size_t       buckets,
+                                                 const size_t       maxEntries);
+   virtual double noteEndpointUnreachableOfPoolUser(const unsigned int poolHandleID,
+                                                    const unsigned int address,
+                                                    const unsigned int port,
+                                                    const unsigned int peIdentifier,
+                                                    const size_t       buckets,
+                                                    const size_t       maxEntries);
+
+
+   // ====== Set/Get methods ================================================
+   virtual void getMemoryUsage(HandlespaceMemoryUsage& memoryUsage);
+
+
+   // ====== Private data ===================================================
+   private:
+   struct ST_CLASS(PoolUserNode)* registerPoolUser(const unsigned int address,
+                                                   const unsigned int port);
+
+   struct ST_CLASS(PoolUserList)  List;
+   struct ST_CLASS(PoolUserNode)* NewPoolUserNode;
+};
+
+
+
+// ##########################################################################
+// #### Pool Element                                                     ####
+// ##########################################################################
+
+// ###### Constructor #######################################################
+ST_CLASS(cPoolElement)::ST_CLASS(cPoolElement)(struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   Node = poolElementNode;
+}
+
+
+// ###### Print PoolElement #################################################
+void ST_CLASS(cPoolElement)::print(const bool full)
+{
+   char poolElementNodeDescription[1024];
+
+   ST_CLASS(poolElementNodeGetDescription)(
+      Node,
+      (char*)&poolElementNodeDescription, sizeof(poolElementNodeDescription),
+      ((full == true) ? PENPO_FULL : PENPO_ONLY_ID));
+   EV << poolElementNodeDescription;
+}
+
+
+
+// ##########################################################################
+// #### Handlespace                                                      ####
+// ##########################################################################
+
+// ###### Constructor #######################################################
+ST_CLASS(cPoolHandlespace)::ST_CLASS(cPoolHandlespace)(const unsigned int homeRegistrarIdentifier)
+{
+   ST_CLASS(poolHandlespaceManagementNew)(
+      &Handlespace, homeRegistrarIdentifier, NULL, killPoolElementNode, this);
+}
+
+
+// ###### Destructor ########################################################
+ST_CLASS(cPoolHandlespace)::~ST_CLASS(cPoolHandlespace)()
+{
+   clear();
+   ST_CLASS(poolHandlespaceManagementDelete)(&Handlespace);
+}
+
+
+// ###### Create peer list using this handlespace ###########################
+cPeerList* ST_CLASS(cPoolHandlespace)::createPeerList(const unsigned int registrarIdentifier)
+{
+   return(new ST_CLASS(cPeerList)(this, registrarIdentifier));
+}
+
+
+// ###### PoolElement disposal callback for handlespace cleanup ##############
+void ST_CLASS(cPoolHandlespace)::killPoolElementNode(struct ST_CLASS(PoolElementNode)* poolElementNode,
+                                                     void*                             userData)
+{
+   killPoolElement((cPoolElement*)poolElementNode->UserData);
+}
+
+
+// ###### Clear #############################################################
+void ST_CLASS(cPoolHandlespace)::clear()
+{
+   ST_CLASS(poolHandlespaceManagementClear)(&Handlespace);
+}
+
+
+// ###### Print #############################################################
+void ST_CLASS(cPoolHandlespace)::print(const unsigned int homeRegistrarIdentifier)
+{
+   struct ST_CLASS(PoolNode)*        poolNode;
+   struct ST_CLASS(PoolElementNode)* poolElementNodeS;
+   struct ST_CLASS(PoolElementNode)* poolElementNodeI;
+   cPoolElement*                     poolElementS;
+   cPoolElement*                     poolElementI;
+   char                              description[256];
+
+   ST_CLASS(poolHandlespaceManagementGetDescription)(
+      &Handlespace, (char*)&description, sizeof(description));
+
+   EV << description << endl;
+
+   poolNode = ST_CLASS(poolHandlespaceManagementGetFirstPoolNode)(&Handlespace);
+   while(poolNode != NULL) {
+      EV << "+--- ";
+      ST_CLASS(poolNodeGetDescription)(
+         poolNode,
+         (char*)&description, sizeof(description));
+      EV << description << endl;
+
+      poolElementNodeS = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+      poolElementNodeI = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+      while(poolElementNodeS != NULL) {
+         poolElementS = (cPoolElement*)poolElementNodeS->UserData;
+         poolElementI = (cPoolElement*)poolElementNodeI->UserData;
+         EV << "   - ";
+         poolElementI->print(false);
+         EV << "   ";
+         poolElementS->print(true);
+         poolElementNodeS = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNodeS);
+         poolElementNodeI = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNodeI);
+         EV << endl;
+      }
+
+      poolNode = ST_CLASS(poolHandlespaceManagementGetNextPoolNode)(&Handlespace, poolNode);
+   }
+}
+
+
+// ###### Get cPoolElement of registered pool element node ##################
+cPoolElement* ST_CLASS(cPoolHandlespace)::getPoolElementOfNode(struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   cPoolElement* poolElement;
+   if(poolElementNode->UserData != NULL) {
+      poolElement = (cPoolElement*)poolElementNode->UserData;
+   }
+   else {
+      poolElement = new ST_CLASS(cPoolElement)(poolElementNode);
+      OPP_CHECK(poolElement);
+      poolElementNode->UserData = (void*)poolElement;
+   }
+   return(poolElement);
+}
+
+
+// ###### Register pool element #############################################
+unsigned int ST_CLASS(cPoolHandlespace)::registerPoolElement(
+                                const unsigned int           poolHandleID,
+                                const cPoolElementParameter& poolElementParameter,
+                                const unsigned int           registratorAddress,
+                                const unsigned int           registratorPort,
+                                cPoolElement*&               poolElement,
+                                bool&                        updated)
+{
+   char userTransportBuffer[transportAddressBlockGetSize(1)];
+   struct TransportAddressBlock* userTransport = (struct TransportAddressBlock*)&userTransportBuffer;
+   getTransportAddressBlock(userTransport,
+                            poolElementParameter.getUserTransportParameter(),
+                            TABF_CONTROLCHANNEL);
+
+   char registratorTransportBuffer[transportAddressBlockGetSize(1)];
+   struct TransportAddressBlock* registratorTransport = (struct TransportAddressBlock*)&registratorTransportBuffer;
+   getTransportAddressBlock(registratorTransport,
+                            poolElementParameter.getRegistratorTransportParameter(),
+                            0);
+
+   struct PoolPolicySettings poolPolicySettings;
+   getPoolPolicySettings(&poolPolicySettings, poolElementParameter.getPoolPolicyParameter());
+
+   const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleID);
+   OPP_CHECK(poolHandle);
+
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   unsigned int errorCode = ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
+                               &Handlespace,
+                               poolHandle,
+                               poolElementParameter.getHomeRegistrarIdentifier(),
+                               poolElementParameter.getIdentifier(),
+                               poolElementParameter.getRegistrationLife(),
+                               &poolPolicySettings,
+                               userTransport,
+                               registratorTransport,
+                               -1, 0,
+                               (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
+                               &poolElementNode);
+   if(errorCode == RSPERR_OKAY) {
+      updated     = (poolElementNode->Flags &= PENF_UPDATED);
+      poolElement = getPoolElementOfNode(poolElementNode);
+   }
+   else {
+      updated     = false;
+      poolElement = NULL;
+   }
+
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, poolHandle);
+#endif
+   return(errorCode);
+}
+
+
+// ###### Register pool elements of handle table ############################
+size_t ST_CLASS(cPoolHandlespace)::registerHandleTable(ENRPHandleTableResponse* handleTable,
+                                                       cPoolElement**           poolElementArray)
+{
+   const size_t poolEntries   = handleTable->getPoolEntryArraySize();
+   const size_t transportSize = transportAddressBlockGetSize(1);
+
+   struct ST_CLASS(PoolElementRegistration)* registrationArray =
+      new struct ST_CLASS(PoolElementRegistration)[poolEntries];
+   struct PoolPolicySettings* poolPolicySettingsArray = new struct PoolPolicySettings[poolEntries];
+   char*                      transportBuffer         = new char[2 * poolEntries * transportSize];
+
+   for(size_t i = 0;i < poolEntries;i++) {
+      const cPoolEntry&            poolEntry            = handleTable->getPoolEntry(i);
+      const cPoolElementParameter& poolElementParameter = poolEntry.getPoolElementParameter();
+      struct TransportAddressBlock* userTransport =
+         (struct TransportAddressBlock*)&transportBuffer[(2 * i) * transportSize];
+      struct TransportAddressBlock* registratorTransport =
+         (struct TransportAddressBlock*)&transportBuffer[(2 * i + 1) * transportSize];
+
+      getTransportAddressBlock(userTransport,
+                               poolElementParameter.getUserTransportParameter(),
+                               TABF_CONTROLCHANNEL);
+      getTransportAddressBlock(registratorTransport,
+                               poolElementParameter.getRegistratorTransportParameter(),
+                               0);
+      getPoolPolicySettings(&poolPolicySettingsArray[i], poolElementParameter.getPoolPolicyParameter());
+
+      registrationArray[i].Handle                     = poolHandleGetInterned(getMessagePoolHandleID(&poolEntry));
+      registrationArray[i].HomeRegistrarIdentifier    = poolElementParameter.getHomeRegistrarIdentifier();
+      registrationArray[i].Identifier                 = poolElementParameter.getIdentifier();
+      registrationArray[i].RegistrationLife           = poolElementParameter.getRegistrationLife();
+      registrationArray[i].PolicySettings             = &poolPolicySettingsArray[i];
+      registrationArray[i].UserTransport              = userTransport;
+      registrationArray[i].RegistratorTransport       = registratorTransport;
+      registrationArray[i].ConnectionSocketDescriptor = -1;
+      registrationArray[i].ConnectionAssocID          = 0;
+   }
+
+   const size_t registered = ST_CLASS(poolHandlespaceManagementRegisterPoolElementsBulk)(
+                                &Handlespace,
+                                registrationArray, poolEntries,
+                                (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()));
+   for(size_t i = 0;i < poolEntries;i++) {
+      if(registrationArray[i].ErrorCode == RSPERR_OKAY) {
+         // Same flags as after registerPoolElement()
+         registrationArray[i].PoolElementNode->Flags &= PENF_UPDATED;
+         poolElementArray[i] = getPoolElementOfNode(registrationArray[i].PoolElementNode);
+      }
+      else {
+         poolElementArray[i] = NULL;
+      }
+   }
+
+   delete [] transportBuffer;
+   delete [] poolPolicySettingsArray;
+   delete [] registrationArray;
+
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, NULL);
+#endif
+   return(registered);
+}
+
+
+// ###### Find pool element #################################################
+cPoolElement* ST_CLASS(cPoolHandlespace)::findPoolElement(const unsigned int poolHandleID,
+                                                          const unsigned int peIdentifier)
+{
+   const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleID);
+   OPP_CHECK(poolHandle);
+
+   return(getPoolElement(
+             ST_CLASS(poolHandlespaceManagementFindPoolElement)(
+                &Handlespace,
+                poolHandle,
+                peIdentifier)));
+}
+
+
+// ###### Deregister pool element ###########################################
+unsigned int ST_CLASS(cPoolHandlespace)::deregisterPoolElement(cPoolElement* poolElement)
+{
+   unsigned int errorCode = ST_CLASS(poolHandlespaceManagementDeregisterPoolElementByPtr)(
+                               &Handlespace,
+                               getNode(poolElement));
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, NULL);
+#endif
+   return(errorCode);
+}
+
+
+// ###### Deregister pool element ###########################################
+unsigned int ST_CLASS(cPoolHandlespace)::deregisterPoolElement(const unsigned int poolHandleID,
+                                                               const unsigned int peIdentifier)
+{
+   const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleID);
+   OPP_CHECK(poolHandle);
+   unsigned int errorCode = ST_CLASS(poolHandlespaceManagementDeregisterPoolElement)(
+                               &Handlespace,
+                               poolHandle,
+                               peIdentifier);
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, poolHandle);
+#endif
+   return(errorCode);
+}
+
+
+// ###### Update pool element ownership #####################################
+void ST_CLASS(cPoolHandlespace)::updatePoolElementOwnership(cPoolElement*      poolElement,
+                                                            const unsigned int registrarIdentifier)
+{
+   ST_CLASS(poolHandlespaceManagementUpdateOwnershipOfPoolElementNode)(
+      &Handlespace, getNode(poolElement),
+      (RegistrarIdentifierType)registrarIdentifier);
+}
+
+
+// ###### Transfer ownership of all pool elements of a registrar ############
+size_t ST_CLASS(cPoolHandlespace)::transferPoolElementOwnership(const unsigned int oldRegistrarIdentifier,
+                                                                const unsigned int newRegistrarIdentifier)
+{
+   return(ST_CLASS(poolHandlespaceManagementTransferOwnershipOfPoolElementNodes)(
+             &Handlespace,
+             (RegistrarIdentifierType)oldRegistrarIdentifier,
+             (RegistrarIdentifierType)newRegistrarIdentifier));
+}
+
+
+// ###### Get number of pool element of certain pool ########################
+size_t ST_CLASS(cPoolHandlespace)::getPoolElementsOfPool(const unsigned int poolHandleID)
+{
+   const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleID);
+   OPP_CHECK(poolHandle);
+
+   return(ST_CLASS(poolHandlespaceManagementGetPoolElementsOfPool)(
+             &Handlespace,
+             poolHandle));
+}
+
+
+// ###### Get memory usage ##################################################
+void ST_CLASS(cPoolHandlespace)::getMemoryUsage(HandlespaceMemoryUsage& memoryUsage)
+{
+   ST_CLASS(poolHandlespaceManagementGetMemoryUsage)(&Handlespace, &memoryUsage);
+
+   // The management structure is already counted as part of the handlespace
+   memoryUsage.Nodes += ST_CLASS(poolHandlespaceManagementGetPoolElements)(&Handlespace) *
+                           sizeof(ST_CLASS(cPoolElement));
+   memoryUsage.Other += (sizeof(*this) - sizeof(Handlespace)) +
+                        (SelectionScratch.capacity() * sizeof(SelectionScratch[0])) +
+                        (RequestScratch.capacity() * sizeof(RequestScratch[0]));
+}
+
+
+// ###### Select pool elements by policy ####################################
+size_t ST_CLASS(cPoolHandlespace)::selectPoolElementsByPolicy(const unsigned int poolHandleID,
+                                                              cPoolElement**     selectionArray,
+                                                              size_t&            items,
+                                                              const size_t       maxHandleResolutionItems,
+                                                              const size_t       maxIncrement)
+{
+   // One more entry, so that front() is valid for maxHandleResolutionItems 0
+   if(SelectionScratch.size() <= maxHandleResolutionItems) {
+      SelectionScratch.resize(maxHandleResolutionItems + 1);
+   }
+
+   const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleID);
+   OPP_CHECK(poolHandle);
+
+   ST_CLASS(poolHandlespaceManagementHandleResolution)(
+      &Handlespace,
+      poolHandle,
+      &SelectionScratch.front(), &items,
+      maxHandleResolutionItems, maxIncrement);
+   for(size_t i = 0;i < items;i++) {
+      selectionArray[i] = (cPoolElement*)SelectionScratch[i]->UserData;
+   }
+
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, poolHandle);
+#endif
+   return(items);
+}
+
+
+// ###### Select pool elements for a batch of requests #####################
+size_t ST_CLASS(cPoolHandlespace)::selectPoolElementsByPolicy(cHandleResolutionRequest* requestArray,
+                                                              const size_t              requests,
+                                                              cPoolElement**            selectionArray,
+                                                              const size_t              maxItems)
+{
+   if(requests == 0) {
+      return(0);
+   }
+   if(SelectionScratch.size() <= maxItems) {
+      SelectionScratch.resize(maxItems + 1);
+   }
+   if(RequestScratch.size() < requests) {
+      RequestScratch.resize(requests);
+   }
+
+   for(size_t i = 0;i < requests;i++) {
+      RequestScratch[i].Handle                   = poolHandleGetInterned(requestArray[i].PoolHandleID);
+      RequestScratch[i].MaxHandleResolutionItems = requestArray[i].MaxHandleResolutionItems;
+      RequestScratch[i].MaxIncrement             = requestArray[i].MaxIncrement;
+      OPP_CHECK(RequestScratch[i].Handle);
+   }
+   const size_t items = ST_CLASS(poolHandlespaceManagementHandleResolutions)(
+                           &Handlespace,
+                           &RequestScratch.front(), requests,
+                           &SelectionScratch.front(), maxItems);
+   for(size_t i = 0;i < requests;i++) {
+      const struct ST_CLASS(HandleResolutionRequest)& request = RequestScratch[i];
+      requestArray[i].ErrorCode = request.ErrorCode;
+      requestArray[i].FirstItem = request.FirstPoolElementNode;
+      requestArray[i].Items     = request.PoolElementNodes;
+      for(size_t j = request.FirstPoolElementNode;
+          j < request.FirstPoolElementNode + request.PoolElementNodes;j++) {
+         selectionArray[j] = (cPoolElement*)SelectionScratch[j]->UserData;
+      }
+   }
+
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, NULL);
+#endif
+   return(items);
+}
+
+
+// ###### Restart pool element expiry timer #################################
+void ST_CLASS(cPoolHandlespace)::restartPoolElementExpiryTimer(
+        cPoolElement*            poolElement,
+        const unsigned long long expiryTimeout)
+{
+   /* poolHandlespaceManagementRestartPoolElementExpiryTimer() only takes expiry
+      timeout as parameter. Absolute expiry time is time stamp of last update +
+      given expiry timeout! */
+   ST_CLASS(poolHandlespaceManagementRestartPoolElementExpiryTimer)(
+      &Handlespace, getNode(poolElement), expiryTimeout);
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, &getNode(poolElement)->OwnerPoolNode->Handle);
+#endif
+}
+
+
+// ###### Purge expired pool elements from handlespace ######################
+size_t ST_CLASS(cPoolHandlespace)::purgeExpiredPoolElements()
+{
+   const size_t purged = ST_CLASS(poolHandlespaceManagementPurgeExpiredPoolElements)(
+                            &Handlespace,
+                            (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()));
+   // ST_CLASS(poolHandlespaceManagementPrint)(&Handlespace,stdout,~0);
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, NULL);
+#endif
+   return(purged);
+}
+
+
+// ###### Export PE list ####################################################
+cArray* ST_CLASS(cPoolHandlespace)::exportToPoolEntries(const unsigned int homeRegistrarIdentifier)
+{
+   struct ST_CLASS(HandleTableExtract) hte;
+   struct ST_CLASS(PoolElementNode)*   poolElementNode;
+   cPoolElement*                       poolElement;
+   cArray*                             poolEntryArray;
+   int                                 hasData;
+   size_t                              total;
+
+   poolEntryArray = new cArray("PoolEntryArray");
+   OPP_CHECK(poolEntryArray);
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(&Handlespace, NULL);
+#endif
+
+   total   = 0;
+   hasData = ST_CLASS(poolHandlespaceManagementGetHandleTable)(&Handlespace,
+                                                               homeRegistrarIdentifier,
+                                                               &hte,
+                                                               HTEF_START | ((homeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER) ? HTEF_OWNCHILDSONLY : 0),
+                                                               NTE_MAX_POOL_ELEMENT_NODES);
+   while(hasData) {
+      for(size_t i = 0;i < hte.PoolElementNodes;i++) {
+         cPoolEntry* poolEntry = new cPoolEntry;
+         OPP_CHECK(poolEntry);
+         poolEntry->setPoolHandleID(hte.PoolElementNodeArray[i]->OwnerPoolNode->Handle.Identifier);
+         poolElementNode = hte.PoolElementNodeArray[i];
+         poolElement = (cPoolElement*)poolElementNode->UserData;
+         poolEntry->setPoolElementParameter(poolElement->toPoolElementParameter());
+         poolEntryArray->add(poolEntry);
+      }
+      total += hte.PoolElementNodes;
+
+      if(hte.PoolElementNodes < NTE_MAX_POOL_ELEMENT_NODES) {
+         break;
+      }
+      hasData = ST_CLASS(poolHandlespaceManagementGetHandleTable)(&Handlespace,
+                                                                  homeRegistrarIdentifier,
+                                                                  &hte,
+                                                                  (homeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER) ? HTEF_OWNCHILDSONLY : 0,
+                                                                  NTE_MAX_POOL_ELEMENT_NODES);
+   }
+
+   if(total == 0) {
+      delete poolEntryArray;
+      return(NULL);
+   }
+   return(poolEntryArray);
+}
+
+
+// ###### Export changes since given handlespace version ####################
+cArray* ST_CLASS(cPoolHandlespace)::exportChangesToPoolEntries(const unsigned int       homeRegistrarIdentifier,
+                                                               const unsigned long long sinceVersion,
+                                                               cArray*&                 deletedPoolEntryArray)
+{
+   struct ST_CLASS(HandleTableChangesExtract)   htce;
+   const struct ST_CLASS(PoolElementTombstone)* tombstone;
+   cPoolElement*                                poolElement;
+   cArray*                                      poolEntryArray;
+   const unsigned int                           flags =
+      (homeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER) ? HTEF_OWNCHILDSONLY : 0;
+
+   OPP_CHECK(hasChangesSince(sinceVersion));
+   poolEntryArray        = new cArray("PoolEntryArray");
+   deletedPoolEntryArray = new cArray("DeletedPoolEntryArray");
+   OPP_CHECK(poolEntryArray && deletedPoolEntryArray);
+
+   ST_CLASS(poolHandlespaceManagementGetHandleTableChanges)(&Handlespace,
+                                                            homeRegistrarIdentifier,
+                                                            sinceVersion,
+                                                            &htce,
+                                                            HTEF_START | flags,
+                                                            NTE_MAX_POOL_ELEMENT_NODES);
+   for(;;) {
+      for(size_t i = 0;i < htce.PoolElementNodes;i++) {
+         cPoolEntry* poolEntry = new cPoolEntry;
+         OPP_CHECK(poolEntry);
+         poolEntry->setPoolHandleID(htce.PoolElementNodeArray[i]->OwnerPoolNode->Handle.Identifier);
+         poolElement = (cPoolElement*)htce.PoolElementNodeArray[i]->UserData;
+         poolEntry->setPoolElementParameter(poolElement->toPoolElementParameter());
+         poolEntryArray->add(poolEntry);
+      }
+      for(size_t i = 0;i < htce.Tombstones;i++) {
+         tombstone = htce.TombstoneArray[i];
+         cPoolEntry* poolEntry = new cPoolEntry;
+         OPP_CHECK(poolEntry);
+         poolEntry->setPoolHandleID(tombstone->Handle.Identifier);
+         cPoolElementParameter poolElementParameter;
+         poolElementParameter.setIdentifier(tombstone->Identifier);
+         poolElementParameter.setHomeRegistrarIdentifier(tombstone->HomeRegistrarIdentifier);
+         poolEntry->setPoolElementParameter(poolElementParameter);
+         deletedPoolEntryArray->add(poolEntry);
+      }
+
+      if(htce.PoolElementNodes + htce.Tombstones < NTE_MAX_POOL_ELEMENT_NODES) {
+         break;
+      }
+      ST_CLASS(poolHandlespaceManagementGetHandleTableChanges)(&Handlespace,
+                                                               homeRegistrarIdentifier,
+                                                               0,
+                                                               &htce,
+                                                               flags,
+                                                               NTE_MAX_POOL_ELEMENT_NODES);
+   }
+
+   if(deletedPoolEntryArray->size() == 0) {
+      delete deletedPoolEntryArray;
+      deletedPoolEntryArray = NULL;
+   }
+   if(poolEntryArray->size() == 0) {
+      delete poolEntryArray;
+      return(NULL);
+   }
+   return(poolEntryArray);
+}
+
+
+// ###### Get ownership digest tree buckets of registrar ####################
+void ST_CLASS(cPoolHandlespace)::getOwnershipDigests(const unsigned int registrarIdentifier,
+                                                     unsigned int*      digestArray)
+{
+   HandlespaceChecksumType digestTree[HANDLESPACE_DIGEST_BUCKETS];
+
+   ST_CLASS(poolHandlespaceManagementGetOwnershipDigestTree)(&Handlespace,
+                                                             (RegistrarIdentifierType)registrarIdentifier,
+                                                             digestTree);
+   for(unsigned int i = 0;i < HANDLESPACE_DIGEST_BUCKETS;i++) {
+      digestArray[i] = digestTree[i];
+   }
+}
+
+
+// ###### Get ownership digest of pool for registrar ########################
+unsigned int ST_CLASS(cPoolHandlespace)::getPoolOwnershipDigest(const unsigned int registrarIdentifier,
+                                                                const unsigned int poolHandleID)
+{
+   const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleID);
+   OPP_CHECK(poolHandle);
+
+   return(ST_CLASS(poolHandlespaceManagementGetPoolOwnershipDigest)(
+             &Handlespace, (RegistrarIdentifierType)registrarIdentifier, poolHandle));
+}
+
+
+// ###### Get ownership digest tree bucket of pool ##########################
+unsigned int ST_CLASS(cPoolHandlespace)::getOwnershipDigestBucket(const unsigned int poolHandleID) const
+{
+   const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleID);
+   OPP_CHECK(poolHandle);
+
+   return(ST_CLASS(poolHandlespaceManagementGetOwnershipDigestBucket)(poolHandle));
+}
+
+
+// ###### Export digests of own pools in differing buckets ##################
+cArray* ST_CLASS(cPoolHandlespace)::exportPoolDigests(const unsigned int* digestArray)
+{
+   HandlespaceChecksumType    digestTree[HANDLESPACE_DIGEST_BUCKETS];
+   struct ST_CLASS(PoolNode)* poolNode;
+   cArray*                    poolDigestArray;
+
+   ST_CLASS(poolHandlespaceManagementGetOwnershipDigestTree)(&Handlespace,
+                                                             Handlespace.Handlespace.HomeRegistrarIdentifier,
+                                                             digestTree);
+   poolDigestArray = new cArray("PoolDigestArray");
+   OPP_CHECK(poolDigestArray);
+
+   poolNode = ST_CLASS(poolHandlespaceManagementGetFirstPoolNode)(&Handlespace);
+   while(poolNode != NULL) {
+      if( (poolNode->OwnedPoolElements > 0) &&
+          (digestTree[poolNode->OwnershipDigestBucket] != digestArray[poolNode->OwnershipDigestBucket]) ) {
+         cPoolDigest* poolDigest = new cPoolDigest;
+         OPP_CHECK(poolDigest);
+         poolDigest->setPoolHandleID(poolNode->Handle.Identifier);
+         poolDigest->setDigest(handlespaceChecksumFinish(poolNode->OwnershipChecksum));
+         poolDigestArray->add(poolDigest);
+      }
+      poolNode = ST_CLASS(poolHandlespaceManagementGetNextPoolNode)(&Handlespace, poolNode);
+   }
+
+   if(poolDigestArray->size() == 0) {
+      delete poolDigestArray;
+      return(NULL);
+   }
+   return(poolDigestArray);
+}
+
+
+// ###### Export PEs of given pools #########################################
+cArray* ST_CLASS(cPoolHandlespace)::exportPoolsToPoolEntries(const unsigned int  homeRegistrarIdentifier,
+                                                             const unsigned int* poolHandleIDArray,
+                                                             const size_t        poolHandleIDs)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct ST_CLASS(PoolNode)*        poolNode;
+   cPoolElement*                     poolElement;
+   cArray*                           poolEntryArray;
+
+   poolEntryArray = new cArray("PoolEntryArray");
+   OPP_CHECK(poolEntryArray);
+
+   for(size_t i = 0;i < poolHandleIDs;i++) {
+      const struct PoolHandle* poolHandle = poolHandleGetInterned(poolHandleIDArray[i]);
+      OPP_CHECK(poolHandle);
+      poolNode = ST_CLASS(poolHandlespaceNodeFindPoolNode)(&Handlespace.Handlespace, poolHandle);
+      if(poolNode == NULL) {
+         continue;
+      }
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+      while(poolElementNode != NULL) {
+         if( (homeRegistrarIdentifier == UNDEFINED_REGISTRAR_IDENTIFIER) ||
+             (poolElementNode->HomeRegistrarIdentifier == homeRegistrarIdentifier) ) {
+            cPoolEntry* poolEntry = new cPoolEntry;
+            OPP_CHECK(poolEntry);
+            poolEntry->setPoolHandleID(poolNode->Handle.Identifier);
+            poolElement = (cPoolElement*)poolElementNode->UserData;
+            poolEntry->setPoolElementParameter(poolElement->toPoolElementParameter());
+            poolEntryArray->add(poolEntry);
+         }
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNode);
+      }
+   }
+
+   if(poolEntryArray->size() == 0) {
+      delete poolEntryArray;
+      return(NULL);
+   }
+   return(poolEntryArray);
+}
+
+
+// ###### Get first pool element of given owner #############################
+cPoolElement* ST_CLASS(cPoolHandlespace)::getFirstPoolElementOwnedBy(const unsigned int homeRegistrarIdentifier)
+{
+   return(getPoolElement(
+             ST_CLASS(poolHandlespaceManagementGetFirstPoolElementOwnershipNodeForIdentifier)(
+                &Handlespace, (RegistrarIdentifierType)homeRegistrarIdentifier)));
+}
+
+
+// ###### Get next pool element of same owner ###############################
+cPoolElement* ST_CLASS(cPoolHandlespace)::getNextPoolElementOfSameOwner(cPoolElement* poolElement)
+{
+   return(getPoolElement(
+             ST_CLASS(poolHandlespaceManagementGetNextPoolElementOwnershipNodeForSameIdentifier)(
+                &Handlespace, getNode(poolElement))));
+}
+
+
+
+// ##########################################################################
+// #### PoolUser List                                                    ####
+// ##########################################################################
+
+
+// ###### Constructor #######################################################
+ST_CLASS(cPoolUserList)::ST_CLASS(cPoolUserList)()
+{
+   ST_CLASS(poolUserListNew)(&List);
+   NewPoolUserNode = NULL;
+}
+
+
+// ###### Destructor ########################################################
+ST_CLASS(cPoolUserList)::~ST_CLASS(cPoolUserList)()
+{
+   clear();
+   ST_CLASS(poolUserListDelete)(&List);
+   if(NewPoolUserNode) {
+      free(NewPoolUserNode);
+      NewPoolUserNode = NULL;
+   }
+}
+
+
+// ###### Clear #############################################################
+void ST_CLASS(cPoolUserList)::clear()
+{
+   ST_CLASS(poolUserListClear)(&List);
+}
+
+
+// ###### Print #############################################################
+void ST_CLASS(cPoolUserList)::print()
+{
+   char                           description[256];
+   struct ST_CLASS(PoolUserNode)* poolUserNode;
+
+   ST_CLASS(poolUserListGetDescription)(
+      &List, (char*)&description, sizeof(description));
+   EV << description << endl;
+
+   poolUserNode = ST_CLASS(poolUserListGetFirstPoolUserNode)(&List);
+   while(poolUserNode != NULL) {
+      EV << "+--- ";
+      ST_CLASS(poolUserNodeGetDescription)(
+         poolUserNode,
+         (char*)&description, sizeof(description), ~0);
+      EV << description << endl;
+      poolUserNode = ST_CLASS(poolUserListGetNextPoolUserNode)(&List, poolUserNode);
+   }
+}
+
+
+// ###### Get memory usage ##################################################
+void ST_CLASS(cPoolUserList)::getMemoryUsage(HandlespaceMemoryUsage& memoryUsage)
+{
+   ST_CLASS(poolUserListGetMemoryUsage)(&List, &memoryUsage);
+   if(NewPoolUserNode) {
+      memoryUsage.Nodes += sizeof(struct ST_CLASS(PoolUserNode));
+   }
+   memoryUsage.Other += sizeof(*this) - sizeof(List);
+}
+
+
+// ###### Register pool user ################################################
+struct ST_CLASS(PoolUserNode)* ST_CLASS(cPoolUserList)::registerPoolUser(
+   const unsigned int address,
+   const unsigned int port)
+{
+   if(NewPoolUserNode == NULL) {
+      NewPoolUserNode = (struct ST_CLASS(PoolUserNode)*)malloc(sizeof(struct ST_CLASS(PoolUserNode)));
+   }
+   CHECK(NewPoolUserNode != NULL);
+   ST_CLASS(poolUserNodeNew)(NewPoolUserNode,
+      (int)address, (sctp_assoc_t)port);
+   struct ST_CLASS(PoolUserNode)* addedPoolUserNode =
+      ST_CLASS(poolUserListAddPoolUserNode)(
+         &List, NewPoolUserNode);
+   if(addedPoolUserNode == NewPoolUserNode) {
+      NewPoolUserNode = NULL;
+   }
+   addedPoolUserNode->LastUpdateTimeStamp = (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl());
+   return(addedPoolUserNode);
+}
+
+
+// ###### Purge pool users ##################################################
+void ST_CLASS(cPoolUserList)::purge(const simtime_t minTime)
+{
+   const unsigned long long minTimeStamp = (unsigned long long)(1000000.0 * minTime.dbl());
+
+   struct ST_CLASS(PoolUserNode)* poolUserNode =
+      ST_CLASS(poolUserListGetFirstPoolUserNode)(&List);
+   while(poolUserNode != NULL) {
+      struct ST_CLASS(PoolUserNode)* nextPoolUserNode = ST_CLASS(poolUserListGetNextPoolUserNode)(&List, poolUserNode);
+      if(poolUserNode->LastUpdateTimeStamp < minTimeStamp) {
+         char description[256];
+         ST_CLASS(poolUserNodeGetDescription)(
+            poolUserNode,
+            (char*)&description, sizeof(description), ~0);
+            EV << "Purging " << description << endl;
+
+         ST_CLASS(poolUserListRemovePoolUserNode)(
+            &List, poolUserNode);
+         free(poolUserNode);
+      }
+      poolUserNode = nextPoolUserNode;
+   }
+}
+
+
+// ###### Note a handle resolution ##########################################
+double ST_CLASS(cPoolUserList)::noteHandleResolutionOfPoolUser(const unsigned int poolHandleID,
+                                                               const unsigned int address,
+                                                               const unsigned int port,
+                                                               const size_t       buckets,
+                                                               const size_t       maxEntries)
+{
+   const struct PoolHandle*       poolHandle = poolHandleGetInterned(poolHandleID);
+   struct ST_CLASS(PoolUserNode)* poolUserNode =
+      registerPoolUser(address, port);
+
+   CHECK(poolHandle != NULL);
+   CHECK(poolUserNode != NULL);
+   const double rate = ST_CLASS(poolUserNodeNoteHandleResolution)(
+      poolUserNode,
+      poolHandle,
+      (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
+      buckets, maxEntries);
+   return(rate);
+}
+
+
+// ###### Note a handle resolution ##########################################
+double ST_CLASS(cPoolUserList)::noteEndpointUnreachableOfPoolUser(const unsigned int poolHandleID,
+                                                                  const unsigned int address,
+                                                                  const unsigned int port,
+                                                                  const unsigned int peIdentifier,
+                                                                  const size_t       buckets,
+                                                                  const size_t       maxEntries)
+{
+   const struct PoolHandle*       poolHandle = poolHandleGetInterned(poolHandleID);
+   struct ST_CLASS(PoolUserNode)* poolUserNode =
+      registerPoolUser(address, port);
+
+   CHECK(poolHandle != NULL);
+   CHECK(poolUserNode != NULL);
+   const double rate = ST_CLASS(poolUserNodeNoteEndpointUnreachable)(
+      poolUserNode,
+      poolHandle,
+      peIdentifier,
+      (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
+      buckets, maxEntries);
+   return(rate);
+}
+
+
+
+// ##########################################################################
+// #### Peer List Node                                                   ####
+// ##########################################################################
+
+// ###### Constructor #######################################################
+ST_CLASS(cPeerListNode)::ST_CLASS(cPeerListNode)(struct ST_CLASS(PeerListNode)* peerListNode)
+{
+   Node = peerListNode;
+}
+
+
+// ###### Print #############################################################
+void ST_CLASS(cPeerListNode)::print(const bool full)
+{
+   char peerListNodeDescription[1024];
+
+   ST_CLASS(peerListNodeGetDescription)(
+      Node,
+      (char*)&peerListNodeDescription, sizeof(peerListNodeDescription),
+      ((full == true) ? PLPO_FULL : PLPO_ONLY_INDEX));
+   EV << peerListNodeDescription;
+}
+
+
+
+// ##########################################################################
+// #### Peer List                                                        ####
+// ##########################################################################
+
+
+// ###### Constructor #######################################################
+ST_CLASS(cPeerList)::ST_CLASS(cPeerList)(ST_CLASS(cPoolHandlespace)* handlespace,
+                                         const unsigned int          registrarIdentifier)
+{
+   ST_CLASS(peerListManagementNew)(
+      &List, (handlespace != NULL) ? &handlespace->Handlespace : NULL,
+      registrarIdentifier,
+      killPeerListNode, NULL);
+}
+
+
+// ###### Destructor ########################################################
+ST_CLASS(cPeerList)::~ST_CLASS(cPeerList)()
+{
+   clear();
+   ST_CLASS(peerListManagementDelete)(&List);
+}
+
+
+// ###### PoolElement disposal callback for handlespace cleanup ##############
+void ST_CLASS(cPeerList)::killPeerListNode(struct ST_CLASS(PeerListNode)* peerListNode,
+                                           void*                          userData)
+{
+   cPeerListNode* node = (cPeerListNode*)peerListNode->UserData;
+   delete node;
+}
+
+
+// ###### Clear #############################################################
+void ST_CLASS(cPeerList)::clear()
+{
+   ST_CLASS(peerListManagementClear)(&List);
+}
+
+
+// ###### Print #############################################################
+void ST_CLASS(cPeerList)::print()
+{
+   char                           description[1024];
+   struct ST_CLASS(PeerListNode)* peerListNode;
+
+   ST_CLASS(peerListManagementGetDescription)(
+      &List, (char*)&description, sizeof(description));
+   EV << description << endl;
+
+   peerListNode = ST_CLASS(peerListManagementGetFirstPeerListNodeFromIndexStorage)(&List);
+   while(peerListNode != NULL) {
+      EV << "+--- ";
+      ST_CLASS(peerListNodeGetDescription)(
+         peerListNode,
+         (char*)&description, sizeof(description),
+         PLPO_FULL);
+      EV << description << endl;
+      peerListNode = ST_CLASS(peerListManagementGetNextPeerListNodeFromIndexStorage)(&List, peerListNode);
+   }
+}
+
+
+// ###### Register peer #####################################################
+unsigned int ST_CLASS(cPeerList)::registerPeerListNode(const ServerInformationParameter& serverInformationParameter,
+                                                       cPeerListNode*&                   node)
+{
+   struct sockaddr_testaddr address1;
+   address1.ta_family = AF_TEST;
+   address1.ta_addr   = serverInformationParameter.getAddress();
+   address1.ta_port   = serverInformationParameter.getPort();
+
+   char registrarTransportBuffer[transportAddressBlockGetSize(1)];
+   struct TransportAddressBlock* registrarTransport = (struct TransportAddressBlock*)&registrarTransportBuffer;
+   transportAddressBlockNew(registrarTransport,
+                            IPPROTO_SCTP,
+                            serverInformationParameter.getPort(),
+                            0,
+                            (sockaddr_union*)&address1, 1, 1);
+
+   struct ST_CLASS(PeerListNode)* peerListNode;
+   unsigned int errorCode = ST_CLASS(peerListManagementRegisterPeerListNode)(
+                               &List,
+                               serverInformationParameter.getServerID(),
+                               (serverInformationParameter.getServerID() == UNDEFINED_REGISTRAR_IDENTIFIER) ? 0 : PLNF_DYNAMIC,
+                               registrarTransport,
+                               (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
+                               &peerListNode);
+   if(errorCode == RSPERR_OKAY) {
+      if(peerListNode->UserData != NULL) {
+         node = (cPeerListNode*)peerListNode->UserData;
+      }
+      else {
+         node = new ST_CLASS(cPeerListNode)(peerListNode);
+         OPP_CHECK(node);
+         peerListNode->UserData = (void*)node;
+      }
+   }
+   else {
+      node = NULL;
+   }
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(List.Handlespace, NULL);
+   ST_CLASS(peerListManagementVerify)(&List);
+#endif
+   return(errorCode);
+}
+
+
+// ###### Deregister peer by pointer ########################################
+unsigned int ST_CLASS(cPeerList)::deregisterPeerListNode(cPeerListNode* peerListNode)
+{
+   unsigned int errorCode = ST_CLASS(peerListManagementDeregisterPeerListNodeByPtr)(
+                               &List,
+                               ((ST_CLASS(cPeerListNode)*)peerListNode)->Node);
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(List.Handlespace, NULL);
+   ST_CLASS(peerListManagementVerify)(&List);
+#endif
+   return(errorCode);
+}
+
+
+// ###### Deregister peer by ID #############################################
+unsigned int ST_CLASS(cPeerList)::deregisterPeerListNode(unsigned int identifier)
+{
+   unsigned int errorCode = ST_CLASS(peerListManagementDeregisterPeerListNode)(
+                               &List,
+                               identifier, NULL);
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(List.Handlespace, NULL);
+   ST_CLASS(peerListManagementVerify)(&List);
+#endif
+   return(errorCode);
+}
+
+
+// ###### Find entry by ID ##################################################
+cPeerListNode* ST_CLASS(cPeerList)::findPeerListNode(const unsigned int identifier)
+{
+   OPP_CHECK(identifier != UNDEFINED_REGISTRAR_IDENTIFIER);
+   return(getPeerListNode(
+             ST_CLASS(peerListManagementFindPeerListNode)(
+                &List, identifier, NULL)));
+}
+
+
+// ###### Find entry by address/port ########################################
+cPeerListNode* ST_CLASS(cPeerList)::findPeerListNode(const unsigned int address,
+                                                     const unsigned int port)
+{
+   struct sockaddr_testaddr address1;
+   address1.ta_family = AF_TEST;
+   address1.ta_addr   = address;
+   address1.ta_port   = port;
+   char registrarTransportBuffer[transportAddressBlockGetSize(1)];
+   struct TransportAddressBlock* registrarTransport = (struct TransportAddressBlock*)&registrarTransportBuffer;
+   transportAddressBlockNew(registrarTransport,
+                            IPPROTO_SCTP,
+                            port,
+                            0,
+                            (sockaddr_union*)&address1, 1, 1);
+
+   return(getPeerListNode(
+             ST_CLASS(peerListManagementFindPeerListNode)(
+                &List, 0, registrarTransport)));
+}
+
+
+// ###### Get random peer list node #########################################
+cPeerListNode* ST_CLASS(cPeerList)::getRandomPeerListNode()
+{
+   return(getPeerListNode(
+             ST_CLASS(peerListManagementGetRandomPeerListNode)(&List)));
+}
+
+
+// ###### Purge #############################################################
+void ST_CLASS(cPeerList)::purge()
+{
+   const unsigned long long now = (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl());
+
+   ST_CLASS(peerListManagementPurgeExpiredPeerListNodes)(
+      &List, now);
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceManagementVerifyChange)(List.Handlespace, NULL);
+   ST_CLASS(peerListManagementVerify)(&List);
+#endif
+}
+
+
+// ###### Get memory usage ##################################################
+void ST_CLASS(cPeerList)::getMemoryUsage(HandlespaceMemoryUsage& memoryUsage)
+{
+   ST_CLASS(peerListManagementGetMemoryUsage)(&List, &memoryUsage);
+   memoryUsage.Nodes += ST_CLASS(peerListManagementGetPeers)(&List) *
+                           sizeof(ST_CLASS(cPeerListNode));
+   memoryUsage.Other += sizeof(*this) - sizeof(List);
+}
+
+
+/* ###### Get better peer for PE ######################################### */
+cPeerListNode* ST_CLASS(cPeerList)::getUsefulPeerForPE(const unsigned int identifier)
+{
+   return(getPeerListNode(
+             ST_CLASS(peerListManagementGetUsefulPeerForPE)(&List, identifier)));
+}
+
+
+
+// ##########################################################################
+// #### Backend factories                                                ####
+// ##########################################################################
+
+// ###### Create handlespace #################################################
+static cPoolHandlespace* ST_CLASS(createPoolHandlespace)(const unsigned int homeRegistrarIdentifier)
+{
+   return(new ST_CLASS(cPoolHandlespace)(homeRegistrarIdentifier));
+}
+
+
+// ###### Create peer list without handlespace ##############################
+static cPeerList* ST_CLASS(createPeerList)(const unsigned int registrarIdentifier)
+{
+   return(new ST_CLASS(cPeerList)(NULL, registrarIdentifier));
+}
+
+
+// ###### Create pool user list #############################################
+static cPoolUserList* ST_CLASS(createPoolUserList)()
+{
+   return(new ST_CLASS(cPoolUserList)());
+}
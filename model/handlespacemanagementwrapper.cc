@@ -26,7 +26,7 @@
  * Contact: thomas.dreibholz@gmail.com
  */
 
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
 #warning Use VERIFY only for debugging purposes - it is very slow!
 #endif
 
@@ -112,39 +112,18 @@ cPoolElementParameter cPoolElement::toPoolElementParameter() const
 }
 
 
-// ###### Print PoolElement #################################################
-void cPoolElement::print(const bool full)
+// ###### Constructor #######################################################
+cPoolElement::cPoolElement()
 {
-   char poolElementNodeDescription[1024];
-
-   TMPL_CLASS(poolElementNodeGetDescription, SimpleRedBlackTree)(
-      Node,
-      (char*)&poolElementNodeDescription, sizeof(poolElementNodeDescription),
-      ((full == true) ? PENPO_FULL : PENPO_ONLY_ID));
-   EV << poolElementNodeDescription;
+   EndpointKeepAliveTransmissionTimer = NULL;
+   EndpointKeepAliveTimeoutTimer      = NULL;
+   LifetimeExpiryTimer                = NULL;
 }
 
 
-// ###### PoolElement disposal callback for handlespace cleanup ##############
-void cPoolHandlespace::killPoolElement(TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode,
-                                       void*                                            userData)
+// ###### Destructor ########################################################
+cPoolElement::~cPoolElement()
 {
-   cPoolElement* poolElement = (cPoolElement*)poolElementNode->UserData;
-   if(getSimulation()->getActivityModule()) {
-      // The endpoint keepalive timers may still be scheduled. If this is the
-      // case, it is now time to cancel them.
-      // NOTE: This may not be executed by getSimulation()->deleteNetwork(), since
-      //       the FES entries are already deleted when this part is executed!
-      if(poolElement->EndpointKeepAliveTransmissionTimer) {
-         delete getSimulation()->getActivityModule()->cancelEvent(poolElement->EndpointKeepAliveTransmissionTimer);
-         poolElement->EndpointKeepAliveTransmissionTimer = NULL;
-      }
-      if(poolElement->EndpointKeepAliveTimeoutTimer) {
-         delete getSimulation()->getActivityModule()->cancelEvent(poolElement->EndpointKeepAliveTimeoutTimer);
-         poolElement->EndpointKeepAliveTimeoutTimer = NULL;
-      }
-   }
-   delete poolElement;
 }
 
 
@@ -153,374 +132,140 @@ void cPoolHandlespace::killPoolElement(TMPL_CLASS(PoolElementNode, SimpleRedBlac
 // #### Handlespace                                                      ####
 // ##########################################################################
 
-// ###### Constructor #######################################################
-cPoolHandlespace::cPoolHandlespace(const unsigned int homeRegistrarIdentifier)
-{
-   TMPL_CLASS(poolHandlespaceManagementNew, SimpleRedBlackTree)(
-      &Handlespace, homeRegistrarIdentifier, NULL, killPoolElement, this);
-}
-
-
 // ###### Destructor ########################################################
 cPoolHandlespace::~cPoolHandlespace()
 {
-   clear();
-   TMPL_CLASS(poolHandlespaceManagementDelete, SimpleRedBlackTree)(&Handlespace);
 }
 
 
-// ###### Clear #############################################################
-void cPoolHandlespace::clear()
-{
-   TMPL_CLASS(poolHandlespaceManagementClear, SimpleRedBlackTree)(&Handlespace);
-}
-
-
-// ###### Print #############################################################
-void cPoolHandlespace::print(const unsigned int homeRegistrarIdentifier)
+// ###### PoolElement disposal callback for handlespace cleanup ##############
+void cPoolHandlespace::killPoolElement(cPoolElement* poolElement)
 {
-   TMPL_CLASS(PoolNode, SimpleRedBlackTree)*        poolNode;
-   TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNodeS;
-   TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNodeI;
-   cPoolElement*                                    poolElementS;
-   cPoolElement*                                    poolElementI;
-   char                                             description[256];
-
-   TMPL_CLASS(poolHandlespaceManagementGetDescription, SimpleRedBlackTree)(
-      &Handlespace, (char*)&description, sizeof(description));
-
-   EV << description << endl;
-
-   poolNode = TMPL_CLASS(poolHandlespaceManagementGetFirstPoolNode, SimpleRedBlackTree)(&Handlespace);
-   while(poolNode != NULL) {
-      EV << "+--- ";
-      TMPL_CLASS(poolNodeGetDescription, SimpleRedBlackTree)(
-         poolNode,
-         (char*)&description, sizeof(description));
-      EV << description << endl;
-
-      poolElementNodeS = TMPL_CLASS(poolNodeGetFirstPoolElementNodeFromSelection, SimpleRedBlackTree)(poolNode);
-      poolElementNodeI = TMPL_CLASS(poolNodeGetFirstPoolElementNodeFromIndex, SimpleRedBlackTree)(poolNode);
-      while(poolElementNodeS != NULL) {
-         poolElementS = (cPoolElement*)poolElementNodeS->UserData;
-         poolElementI = (cPoolElement*)poolElementNodeI->UserData;
-         EV << "   - ";
-         poolElementI->print(false);
-         EV << "   ";
-         poolElementS->print(true);
-         poolElementNodeS = TMPL_CLASS(poolNodeGetNextPoolElementNodeFromSelection, SimpleRedBlackTree)(poolNode, poolElementNodeS);
-         poolElementNodeI = TMPL_CLASS(poolNodeGetNextPoolElementNodeFromIndex, SimpleRedBlackTree)(poolNode, poolElementNodeI);
-         EV << endl;
+   if(getSimulation()->getActivityModule()) {
+      // The endpoint keepalive timers may still be scheduled. If this is the
+      // case, it is now time to cancel them.
+      // NOTE: This may not be executed by getSimulation()->deleteNetwork(), since
+      //       the FES entries are already deleted when this part is executed!
+      if(poolElement->EndpointKeepAliveTransmissionTimer) {
+         delete getSimulation()->getActivityModule()->cancelEvent(poolElement->EndpointKeepAliveTransmissionTimer);
+         poolElement->EndpointKeepAliveTransmissionTimer = NULL;
+      }
+      if(poolElement->EndpointKeepAliveTimeoutTimer) {
+         delete getSimulation()->getActivityModule()->cancelEvent(poolElement->EndpointKeepAliveTimeoutTimer);
+         poolElement->EndpointKeepAliveTimeoutTimer = NULL;
       }
-
-      poolNode = TMPL_CLASS(poolHandlespaceManagementGetNextPoolNode, SimpleRedBlackTree)(&Handlespace, poolNode);
    }
+   delete poolElement;
 }
 
 
-// ###### Register pool element #############################################
-unsigned int cPoolHandlespace::registerPoolElement(
-                                const char*                  poolHandle,
-                                const cPoolElementParameter& poolElementParameter,
-                                const unsigned int           registratorAddress,
-                                const unsigned int           registratorPort,
-                                cPoolElement*&               poolElement,
-                                bool&                        updated)
+// ###### Convert transport parameter into TransportAddressBlock ############
+static void getTransportAddressBlock(struct TransportAddressBlock* transportAddressBlock,
+                                     const cTransportParameter&    transportParameter,
+                                     const unsigned int            flags)
 {
    struct sockaddr_testaddr address1;
    address1.ta_family = AF_TEST;
-   address1.ta_addr   = poolElementParameter.getUserTransportParameter().getAddress();
-   address1.ta_port   = poolElementParameter.getUserTransportParameter().getPort();
-
-   char userTransportBuffer[transportAddressBlockGetSize(1)];
-   struct TransportAddressBlock* userTransport = (struct TransportAddressBlock*)&userTransportBuffer;
-   transportAddressBlockNew(userTransport,
-                            IPPROTO_SCTP,
-                            poolElementParameter.getUserTransportParameter().getPort(),
-                            TABF_CONTROLCHANNEL,
-                            (sockaddr_union*)&address1, 1, 1);
-
-   address1.ta_family = AF_TEST;
-   address1.ta_addr   = poolElementParameter.getRegistratorTransportParameter().getAddress();
-   address1.ta_port   = poolElementParameter.getRegistratorTransportParameter().getPort();
+   address1.ta_addr   = transportParameter.getAddress();
+   address1.ta_port   = transportParameter.getPort();
 
-   char registratorTransportBuffer[transportAddressBlockGetSize(1)];
-   struct TransportAddressBlock* registratorTransport = (struct TransportAddressBlock*)&registratorTransportBuffer;
-   transportAddressBlockNew(registratorTransport,
+   transportAddressBlockNew(transportAddressBlock,
                             IPPROTO_SCTP,
-                            poolElementParameter.getRegistratorTransportParameter().getPort(),
-                            0,
+                            transportParameter.getPort(),
+                            flags,
                             (sockaddr_union*)&address1, 1, 1);
-
-   struct PoolPolicySettings poolPolicySettings;
-   poolPolicySettingsNew(&poolPolicySettings);
-   poolPolicySettings.PolicyType      = poolElementParameter.getPoolPolicyParameter().getPolicyType();
-   poolPolicySettings.Weight          = poolElementParameter.getPoolPolicyParameter().getWeight();
-   poolPolicySettings.Load            = poolElementParameter.getPoolPolicyParameter().getLoad();
-   poolPolicySettings.LoadDegradation = poolElementParameter.getPoolPolicyParameter().getLoadDegradation();
-   poolPolicySettings.LoadDPF         = poolElementParameter.getPoolPolicyParameter().getLoadDPF();
-   poolPolicySettings.WeightDPF       = poolElementParameter.getPoolPolicyParameter().getWeightDPF();
-   poolPolicySettings.Distance        = poolElementParameter.getPoolPolicyParameter().getDistance();
-
-   struct PoolHandle myPoolHandle;
-   poolHandleNew(&myPoolHandle,
-                 (const unsigned char*)poolHandle,
-                 getPoolHandleSize(poolHandle));
-
-   TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode;
-   unsigned int errorCode = TMPL_CLASS(poolHandlespaceManagementRegisterPoolElement, SimpleRedBlackTree)(
-                               &Handlespace,
-                               &myPoolHandle,
-                               poolElementParameter.getHomeRegistrarIdentifier(),
-                               poolElementParameter.getIdentifier(),
-                               poolElementParameter.getRegistrationLife(),
-                               &poolPolicySettings,
-                               userTransport,
-                               registratorTransport,
-                               -1, 0,
-                               (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
-                               &poolElementNode);
-   if(errorCode == RSPERR_OKAY) {
-      updated = (poolElementNode->Flags &= PENF_UPDATED);
-      if(poolElementNode->UserData != NULL) {
-         poolElement = (cPoolElement*)poolElementNode->UserData;
-      }
-      else {
-         poolElement = new cPoolElement;
-         OPP_CHECK(poolElement);
-         poolElement->Node                               = poolElementNode;
-         poolElement->EndpointKeepAliveTransmissionTimer = NULL;
-         poolElement->EndpointKeepAliveTimeoutTimer      = NULL;
-         poolElement->LifetimeExpiryTimer                = NULL;
-
-         poolElementNode->UserData = (void*)poolElement;
-      }
-   }
-   else {
-      updated     = false;
-      poolElement = NULL;
-   }
-
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(&Handlespace);
-#endif
-   return(errorCode);
 }
 
 
-// ###### Find pool element #################################################
-cPoolElement* cPoolHandlespace::findPoolElement(const char*        poolHandle,
-                                                const unsigned int peIdentifier)
+// ###### Convert policy parameter into PoolPolicySettings ##################
+static void getPoolPolicySettings(struct PoolPolicySettings*  poolPolicySettings,
+                                  const cPoolPolicyParameter& poolPolicyParameter)
 {
-   struct PoolHandle myPoolHandle;
-   poolHandleNew(&myPoolHandle,
-                 (const unsigned char*)poolHandle,
-                 getPoolHandleSize(poolHandle));
-
-   struct TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode =
-       TMPL_CLASS(poolHandlespaceManagementFindPoolElement, SimpleRedBlackTree)(
-          &Handlespace,
-          &myPoolHandle,
-          peIdentifier);
-
-   if(poolElementNode) {
-      return((cPoolElement*)poolElementNode->UserData);
-   }
-   return(NULL);
+   poolPolicySettingsNew(poolPolicySettings);
+   poolPolicySettings->PolicyType      = poolPolicyParameter.getPolicyType();
+   poolPolicySettings->Weight          = poolPolicyParameter.getWeight();
+   poolPolicySettings->Load            = poolPolicyParameter.getLoad();
+   poolPolicySettings->LoadDegradation = poolPolicyParameter.getLoadDegradation();
+   poolPolicySettings->LoadDPF         = poolPolicyParameter.getLoadDPF();
+   poolPolicySettings->WeightDPF       = poolPolicyParameter.getWeightDPF();
+   poolPolicySettings->Distance        = poolPolicyParameter.getDistance();
 }
 
 
-// ###### Deregister pool element ###########################################
-unsigned int cPoolHandlespace::deregisterPoolElement(cPoolElement* poolElement)
-{
-   unsigned int errorCode = TMPL_CLASS(poolHandlespaceManagementDeregisterPoolElementByPtr, SimpleRedBlackTree)(
-                               &Handlespace,
-                               poolElement->Node);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(&Handlespace);
-#endif
-   return(errorCode);
-}
-
 
-// ###### Deregister pool element ###########################################
-unsigned int cPoolHandlespace::deregisterPoolElement(const char*        poolHandle,
-                                                     const unsigned int peIdentifier)
-{
-   struct PoolHandle myPoolHandle;
-   poolHandleNew(&myPoolHandle,
-                 (const unsigned char*)poolHandle,
-                 getPoolHandleSize(poolHandle));
-   unsigned int errorCode = TMPL_CLASS(poolHandlespaceManagementDeregisterPoolElement, SimpleRedBlackTree)(
-                               &Handlespace,
-                               &myPoolHandle,
-                               peIdentifier);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(&Handlespace);
-#endif
-   return(errorCode);
-}
 
+// ##########################################################################
+// #### Peer List Node                                                   ####
+// ##########################################################################
 
-// ###### Update pool element ownership #####################################
-void cPoolHandlespace::updatePoolElementOwnership(cPoolElement*      poolElement,
-                                                  const unsigned int registrarIdentifier)
+// ###### Constructor #######################################################
+cPeerListNode::cPeerListNode()
 {
-   ST_CLASS(poolHandlespaceManagementUpdateOwnershipOfPoolElementNode)(
-      &Handlespace, poolElement->Node,
-      (RegistrarIdentifierType)registrarIdentifier);
+   LastHeardTimeoutTimer  = NULL;
+   ResponseTimeoutTimer   = NULL;
+   TakeoverExpiryTimer    = NULL;
+   MentorTrials           = 0;
+   Takeover               = NULL;
+   HandlespaceVersion     = 0;
+   HandlespaceIncarnation = 0;
+   IncrementalSync        = false;
 }
 
 
-// ###### Get number of pool element of certain pool ########################
-size_t cPoolHandlespace::getPoolElementsOfPool(const char* poolHandle)
+// ###### Destructor ########################################################
+cPeerListNode::~cPeerListNode()
 {
-   struct PoolHandle myPoolHandle;
-   poolHandleNew(&myPoolHandle,
-                 (const unsigned char*)poolHandle,
-                 getPoolHandleSize(poolHandle));
-
-   return(TMPL_CLASS(poolHandlespaceManagementGetPoolElementsOfPool, SimpleRedBlackTree)(
-             &Handlespace,
-             &myPoolHandle));
 }
 
 
-// ###### Select pool elements by policy ####################################
-size_t cPoolHandlespace::selectPoolElementsByPolicy(const char*    poolHandle,
-                                                    cPoolElement** selectionArray,
-                                                    size_t&        items,
-                                                    const size_t   maxHandleResolutionItems,
-                                                    const size_t   maxIncrement)
+// ###### Export to ServerInformationParameter ##############################
+ServerInformationParameter cPeerListNode::toServerInformationParameter() const
 {
-   struct TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)** array =
-      new TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)*[maxHandleResolutionItems];
-   OPP_CHECK(array);
-
-   struct PoolHandle myPoolHandle;
-   poolHandleNew(&myPoolHandle,
-                 (const unsigned char*)poolHandle,
-                 getPoolHandleSize(poolHandle));
-
-   TMPL_CLASS(poolHandlespaceManagementHandleResolution, SimpleRedBlackTree)(
-      &Handlespace,
-      &myPoolHandle,
-      array, &items,
-      maxHandleResolutionItems, maxIncrement);
-   for(size_t i = 0;i < items;i++) {
-      selectionArray[i] = (cPoolElement*)array[i]->UserData;
-   }
-
-   delete [] array;
-
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(&Handlespace);
-#endif
-   return(items);
-}
+   ServerInformationParameter serverInformationParameter;
 
+   serverInformationParameter.setServerID(getIdentifier());
+   serverInformationParameter.setAddress(getAddress());
+   serverInformationParameter.setPort(getPort());
 
-// ###### Restart pool element expiry timer #################################
-void cPoolHandlespace::restartPoolElementExpiryTimer(
-        cPoolElement*            poolElement,
-        const unsigned long long expiryTimeout)
-{
-   /* poolHandlespaceManagementRestartPoolElementExpiryTimer() only takes expiry
-      timeout as parameter. Absolute expiry time is time stamp of last update +
-      given expiry timeout! */
-   TMPL_CLASS(poolHandlespaceManagementRestartPoolElementExpiryTimer, SimpleRedBlackTree)(
-      &Handlespace, poolElement->Node, expiryTimeout);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(&Handlespace);
-#endif
+   return(serverInformationParameter);
 }
 
 
-// ###### Purge expired pool elements from handlespace ######################
-size_t cPoolHandlespace::purgeExpiredPoolElements()
-{
-   const size_t purged = TMPL_CLASS(poolHandlespaceManagementPurgeExpiredPoolElements, SimpleRedBlackTree)(
-                            &Handlespace,
-                            (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()));
-   // TMPL_CLASS(poolHandlespaceManagementPrint, SimpleRedBlackTree)(&Handlespace,stdout,~0);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(&Handlespace);
-#endif
-   return(purged);
-}
 
+// ##########################################################################
+// #### Peer List                                                        ####
+// ##########################################################################
 
-// ###### Export PE list ####################################################
-cArray* cPoolHandlespace::exportToPoolEntries(const unsigned int homeRegistrarIdentifier)
+// ###### Destructor ########################################################
+cPeerList::~cPeerList()
 {
-   ST_CLASS(HandleTableExtract)                     hte;
-   TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode;
-   cPoolElement*                                    poolElement;
-   cArray*                                          poolEntryArray;
-   int                                              hasData;
-   size_t                                           total;
-
-   poolEntryArray = new cArray("PoolEntryArray");
-   OPP_CHECK(poolEntryArray);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(&Handlespace);
-#endif
-
-   total   = 0;
-   hasData = ST_CLASS(poolHandlespaceManagementGetHandleTable)(&Handlespace,
-                                                               homeRegistrarIdentifier,
-                                                               &hte,
-                                                               HTEF_START | ((homeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER) ? HTEF_OWNCHILDSONLY : 0),
-                                                               NTE_MAX_POOL_ELEMENT_NODES);
-   while(hasData) {
-      for(size_t i = 0;i < hte.PoolElementNodes;i++) {
-         cPoolEntry* poolEntry = new cPoolEntry;
-         OPP_CHECK(poolEntry);
-         poolEntry->setPoolHandle((const char*)&hte.PoolElementNodeArray[i]->OwnerPoolNode->Handle.Handle);
-         poolElementNode = hte.PoolElementNodeArray[i];
-         poolElement = (cPoolElement*)poolElementNode->UserData;
-         poolEntry->setPoolElementParameter(poolElement->toPoolElementParameter());
-         poolEntryArray->add(poolEntry);
-      }
-      total += hte.PoolElementNodes;
-
-      if(hte.PoolElementNodes < NTE_MAX_POOL_ELEMENT_NODES) {
-         break;
-      }
-      hasData = ST_CLASS(poolHandlespaceManagementGetHandleTable)(&Handlespace,
-                                                                  homeRegistrarIdentifier,
-                                                                  &hte,
-                                                                  (homeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER) ? HTEF_OWNCHILDSONLY : 0,
-                                                                  NTE_MAX_POOL_ELEMENT_NODES);
-   }
-
-   if(total == 0) {
-      delete poolEntryArray;
-      return(NULL);
-   }
-   return(poolEntryArray);
 }
 
 
-// ###### Get first pool element of given owner #############################
-cPoolElement* cPoolHandlespace::getFirstPoolElementOwnedBy(const unsigned int homeRegistrarIdentifier)
+// ###### Reset mentor selection information ################################
+void cPeerList::resetMentorSelection()
 {
-   TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode =
-      ST_CLASS(poolHandlespaceManagementGetFirstPoolElementOwnershipNodeForIdentifier)(&Handlespace, (RegistrarIdentifierType)homeRegistrarIdentifier);
-   if(poolElementNode) {
-      return((cPoolElement*)poolElementNode->UserData);
+   cPeerListNode* node = getFirstPeerListNode();
+   while(node != NULL) {
+      node->MentorTrials = 0;
+      node = getNextPeerListNode(node);
    }
-   return(NULL);
 }
 
 
-// ###### Get next pool element of same owner ###############################
-cPoolElement* cPoolHandlespace::getNextPoolElementOfSameOwner(struct cPoolElement* poolElement)
+// ###### Get mentor server #################################################
+cPeerListNode* cPeerList::findMentorServer(const unsigned int localAddress,
+                                           const unsigned int localPort,
+                                           const unsigned int maxTrials)
 {
-   TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode =
-      ST_CLASS(poolHandlespaceManagementGetNextPoolElementOwnershipNodeForSameIdentifier)(&Handlespace, poolElement->Node);
-   if(poolElementNode) {
-      return((cPoolElement*)poolElementNode->UserData);
+   cPeerListNode* node = getFirstPeerListNode();
+   while(node != NULL) {
+      if(((node->getAddress() != localAddress) || (node->getPort() != localPort)) &&
+         (node->MentorTrials < maxTrials)) {
+         node->MentorTrials++;
+         return(node);
+      }
+      node = getNextPeerListNode(node);
    }
    return(NULL);
 }
@@ -531,466 +276,196 @@ cPoolElement* cPoolHandlespace::getNextPoolElementOfSameOwner(struct cPoolElemen
 // #### PoolUser List                                                    ####
 // ##########################################################################
 
-
-// ###### Constructor #######################################################
-cPoolUserList::cPoolUserList()
-{
-   TMPL_CLASS(poolUserListNew, SimpleRedBlackTree)(&List);
-   NewPoolUserNode = NULL;
-}
-
-
 // ###### Destructor ########################################################
 cPoolUserList::~cPoolUserList()
 {
-   clear();
-   TMPL_CLASS(poolUserListDelete, SimpleRedBlackTree)(&List);
-   if(NewPoolUserNode) {
-      free(NewPoolUserNode);
-      NewPoolUserNode = NULL;
-   }
 }
 
 
-// ###### Clear #############################################################
-void cPoolUserList::clear()
-{
-   TMPL_CLASS(poolUserListClear, SimpleRedBlackTree)(&List);
-}
-
-
-// ###### Print #############################################################
-void cPoolUserList::print()
-{
-   char                                          description[256];
-   TMPL_CLASS(PoolUserNode, SimpleRedBlackTree)* poolUserNode;
-
-   TMPL_CLASS(poolUserListGetDescription, SimpleRedBlackTree)(
-      &List, (char*)&description, sizeof(description));
-   EV << description << endl;
-
-   poolUserNode = TMPL_CLASS(poolUserListGetFirstPoolUserNode, SimpleRedBlackTree)(&List);
-   while(poolUserNode != NULL) {
-      EV << "+--- ";
-      TMPL_CLASS(poolUserNodeGetDescription, SimpleRedBlackTree)(
-         poolUserNode,
-         (char*)&description, sizeof(description), ~0);
-      EV << description << endl;
-      poolUserNode = TMPL_CLASS(poolUserListGetNextPoolUserNode, SimpleRedBlackTree)(&List, poolUserNode);
-   }
-}
 
+// ##########################################################################
+// #### Takeover Process                                                 ####
+// ##########################################################################
 
-// ###### Register pool user ################################################
-TMPL_CLASS(PoolUserNode, SimpleRedBlackTree)* cPoolUserList::registerPoolUser(
-   const unsigned int address,
-   const unsigned int port)
+// ###### Constructor #######################################################
+cTakeoverProcess::cTakeoverProcess(const unsigned int targetID,
+                                   cPeerList*         peerList)
 {
-   if(NewPoolUserNode == NULL) {
-      NewPoolUserNode = (struct ST_CLASS(PoolUserNode)*)malloc(sizeof(struct ST_CLASS(PoolUserNode)));
-   }
-   CHECK(NewPoolUserNode != NULL);
-   TMPL_CLASS(poolUserNodeNew, SimpleRedBlackTree)(NewPoolUserNode,
-      (int)address, (sctp_assoc_t)port);
-   struct ST_CLASS(PoolUserNode)* addedPoolUserNode =
-      TMPL_CLASS(poolUserListAddPoolUserNode, SimpleRedBlackTree)(
-         &List, NewPoolUserNode);
-   if(addedPoolUserNode == NewPoolUserNode) {
-      NewPoolUserNode = NULL;
-   }
-   addedPoolUserNode->LastUpdateTimeStamp = (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl());
-   return(addedPoolUserNode);
-}
+   const size_t             peers       = peerList->getPeers();
+   RegistrarIdentifierType* peerIDArray = new RegistrarIdentifierType[peers + 1];
+   size_t                   i           = 0;
 
-
-// ###### Purge pool users ##################################################
-void cPoolUserList::purge(const simtime_t minTime)
-{
-   const unsigned long long minTimeStamp = (unsigned long long)(1000000.0 * minTime.dbl());
-
-   TMPL_CLASS(PoolUserNode, SimpleRedBlackTree)* poolUserNode =
-      TMPL_CLASS(poolUserListGetFirstPoolUserNode, SimpleRedBlackTree)(&List);
-   while(poolUserNode != NULL) {
-      TMPL_CLASS(PoolUserNode, SimpleRedBlackTree)* nextPoolUserNode = TMPL_CLASS(poolUserListGetNextPoolUserNode, SimpleRedBlackTree)(&List, poolUserNode);
-      if(poolUserNode->LastUpdateTimeStamp < minTimeStamp) {
-         char description[256];
-         TMPL_CLASS(poolUserNodeGetDescription, SimpleRedBlackTree)(
-            poolUserNode,
-            (char*)&description, sizeof(description), ~0);
-            EV << "Purging " << description << endl;
-
-         TMPL_CLASS(poolUserListRemovePoolUserNode, SimpleRedBlackTree)(
-            &List, poolUserNode);
-         free(poolUserNode);
-      }
-      poolUserNode = nextPoolUserNode;
+   cPeerListNode* node = peerList->getFirstPeerListNode();
+   while(node != NULL) {
+      OPP_CHECK(i < peers);
+      peerIDArray[i++] = (RegistrarIdentifierType)node->getIdentifier();
+      node = peerList->getNextPeerListNode(node);
    }
+   Takeover = takeoverProcessNew((RegistrarIdentifierType)targetID,
+                                 (RegistrarIdentifierType)peerList->getOwnIdentifier(),
+                                 peerIDArray, i);
+   OPP_CHECK(Takeover);
+   delete [] peerIDArray;
 }
 
 
-// ###### Note a handle resolution ##########################################
-double cPoolUserList::noteHandleResolutionOfPoolUser(const char*        poolHandle,
-                                                     const unsigned int address,
-                                                     const unsigned int port,
-                                                     const size_t       buckets,
-                                                     const size_t       maxEntries)
-{
-   struct PoolHandle                                    poolHandleStruct;
-   struct TMPL_CLASS(PoolUserNode, SimpleRedBlackTree)* poolUserNode =
-      registerPoolUser(address, port);
-
-   CHECK(poolUserNode != NULL);
-   poolHandleNew(&poolHandleStruct, (const unsigned char*)poolHandle, strlen(poolHandle));
-   const double rate = TMPL_CLASS(poolUserNodeNoteHandleResolution, SimpleRedBlackTree)(
-      poolUserNode,
-      &poolHandleStruct,
-      (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
-      buckets, maxEntries);
-   return(rate);
-}
-
-
-// ###### Note a handle resolution ##########################################
-double cPoolUserList::noteEndpointUnreachableOfPoolUser(const char*        poolHandle,
-                                                        const unsigned int address,
-                                                        const unsigned int port,
-                                                        const unsigned int peIdentifier,
-                                                        const size_t       buckets,
-                                                        const size_t       maxEntries)
-{
-   struct PoolHandle                                    poolHandleStruct;
-   struct TMPL_CLASS(PoolUserNode, SimpleRedBlackTree)* poolUserNode =
-      registerPoolUser(address, port);
-
-   CHECK(poolUserNode != NULL);
-   poolHandleNew(&poolHandleStruct, (const unsigned char*)poolHandle, strlen(poolHandle));
-   const double rate = TMPL_CLASS(poolUserNodeNoteEndpointUnreachable, SimpleRedBlackTree)(
-      poolUserNode,
-      &poolHandleStruct,
-      peIdentifier,
-      (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
-      buckets, maxEntries);
-   return(rate);
-}
-
-
-
-// ##########################################################################
-// #### Peer List Node                                                   ####
-// ##########################################################################
-
-// ###### Print #############################################################
-void cPeerListNode::print(const bool full)
+// ###### Destructor ########################################################
+cTakeoverProcess::~cTakeoverProcess()
 {
-   char peerListNodeDescription[1024];
-
-   TMPL_CLASS(peerListNodeGetDescription, SimpleRedBlackTree)(
-      Node,
-      (char*)&peerListNodeDescription, sizeof(peerListNodeDescription),
-      ((full == true) ? PLPO_FULL : PLPO_ONLY_INDEX));
-   EV << peerListNodeDescription;
+   takeoverProcessDelete(Takeover);
+   Takeover = NULL;
 }
 
 
-// ###### Export to ServerInformationParameter ##############################
-ServerInformationParameter cPeerListNode::toServerInformationParameter() const
+// ###### Acknowledge takeover ##############################################
+size_t cTakeoverProcess::acknowledge(const unsigned int targetID,
+                                     const unsigned int acknowledgerID)
 {
-   ServerInformationParameter serverInformationParameter;
-
-   serverInformationParameter.setServerID(getIdentifier());
-   serverInformationParameter.setAddress(getAddress());
-   serverInformationParameter.setPort(getPort());
-
-   return(serverInformationParameter);
+   return(takeoverProcessAcknowledge(Takeover,
+                                     (RegistrarIdentifierType)targetID,
+                                     (RegistrarIdentifierType)acknowledgerID));
 }
 
 
 
 // ##########################################################################
-// #### Peer List                                                        ####
+// #### Storage backends                                                 ####
 // ##########################################################################
 
-
-// ###### Constructor #######################################################
-cPeerList::cPeerList(cPoolHandlespace*  handlespace,
-                     const unsigned int registrarIdentifier)
-{
-   Handlespace = handlespace;
-   TMPL_CLASS(peerListManagementNew, SimpleRedBlackTree)(
-      &List, &Handlespace->Handlespace, registrarIdentifier,
-      killPeerListNode, NULL);
-}
-
-
-// ###### Destructor ########################################################
-cPeerList::~cPeerList()
-{
-   clear();
-   TMPL_CLASS(peerListManagementDelete, SimpleRedBlackTree)(&List);
-}
-
-
-// ###### PoolElement disposal callback for handlespace cleanup ##############
-void cPeerList::killPeerListNode(TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode,
-                                 void*                                         userData)
-{
-   cPeerListNode* node = (cPeerListNode*)peerListNode->UserData;
-   delete node;
-}
-
-
-// ###### Clear #############################################################
-void cPeerList::clear()
-{
-   TMPL_CLASS(peerListManagementClear, SimpleRedBlackTree)(&List);
-}
+#undef ST_CLASS
+#ifdef INCLUDE_LINEARLIST
+#define ST_CLASS(x) x##_LinearList
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_SIMPLEBINARYTREE
+#define ST_CLASS(x) x##_SimpleBinaryTree
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_LEAFLINKEDBINARYTREE
+#define ST_CLASS(x) x##_LeafLinkedBinaryTree
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_SIMPLETREAP
+#define ST_CLASS(x) x##_SimpleTreap
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_LEAFLINKEDTREAP
+#define ST_CLASS(x) x##_LeafLinkedTreap
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_SIMPLEREDBLACKTREE
+#define ST_CLASS(x) x##_SimpleRedBlackTree
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_LEAFLINKEDREDBLACKTREE
+#define ST_CLASS(x) x##_LeafLinkedRedBlackTree
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_COMPACTREDBLACKTREE
+#define ST_CLASS(x) x##_CompactRedBlackTree
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
+#ifdef INCLUDE_BPLUSTREE
+#define ST_CLASS(x) x##_BPlusTree
+#include "handlespacemanagementwrapper-template_impl.h"
+#undef ST_CLASS
+#endif
 
 
-// ###### Print #############################################################
-void cPeerList::print()
+struct HandlespaceBackend
 {
-   char                                          description[1024];
-   TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode;
-
-   TMPL_CLASS(peerListManagementGetDescription, SimpleRedBlackTree)(
-      &List, (char*)&description, sizeof(description));
-   EV << description << endl;
-
-   peerListNode = TMPL_CLASS(peerListManagementGetFirstPeerListNodeFromIndexStorage, SimpleRedBlackTree)(&List);
-   while(peerListNode != NULL) {
-      EV << "+--- ";
-      TMPL_CLASS(peerListNodeGetDescription, SimpleRedBlackTree)(
-         peerListNode,
-         (char*)&description, sizeof(description),
-         PLPO_FULL);
-      EV << description << endl;
-      peerListNode = TMPL_CLASS(peerListManagementGetNextPeerListNodeFromIndexStorage, SimpleRedBlackTree)(&List, peerListNode);
-   }
-}
+   const char*       Name;
+   cPoolHandlespace* (*CreatePoolHandlespace)(const unsigned int homeRegistrarIdentifier);
+   cPeerList*        (*CreatePeerList)(const unsigned int registrarIdentifier);
+   cPoolUserList*    (*CreatePoolUserList)();
+};
 
+#define HANDLESPACE_BACKEND(n) \
+   { #n, &createPoolHandlespace_##n, &createPeerList_##n, &createPoolUserList_##n }
 
-// ###### Register peer #####################################################
-unsigned int cPeerList::registerPeerListNode(const ServerInformationParameter& serverInformationParameter,
-                                             cPeerListNode*&                   node)
+static const HandlespaceBackend HandlespaceBackendArray[] =
 {
-   struct sockaddr_testaddr address1;
-   address1.ta_family = AF_TEST;
-   address1.ta_addr   = serverInformationParameter.getAddress();
-   address1.ta_port   = serverInformationParameter.getPort();
-
-   char registrarTransportBuffer[transportAddressBlockGetSize(1)];
-   struct TransportAddressBlock* registrarTransport = (struct TransportAddressBlock*)&registrarTransportBuffer;
-   transportAddressBlockNew(registrarTransport,
-                            IPPROTO_SCTP,
-                            serverInformationParameter.getPort(),
-                            0,
-                            (sockaddr_union*)&address1, 1, 1);
-
-   TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode;
-   unsigned int errorCode = TMPL_CLASS(peerListManagementRegisterPeerListNode, SimpleRedBlackTree)(
-                               &List,
-                               serverInformationParameter.getServerID(),
-                               (serverInformationParameter.getServerID() == UNDEFINED_REGISTRAR_IDENTIFIER) ? 0 : PLNF_DYNAMIC,
-                               registrarTransport,
-                               (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl()),
-                               &peerListNode);
-   if(errorCode == RSPERR_OKAY) {
-      if(peerListNode->UserData != NULL) {
-         node = (cPeerListNode*)peerListNode->UserData;
-      }
-      else {
-         node = new cPeerListNode;
-         OPP_CHECK(node);
-         node->Node                  = peerListNode;
-         node->Takeover              = NULL;
-         node->MentorTrials          = 0;
-         node->LastHeardTimeoutTimer = NULL;
-         node->ResponseTimeoutTimer  = NULL;
-         node->TakeoverExpiryTimer   = NULL;
-         peerListNode->UserData = (void*)node;
-      }
-   }
-   else {
-      node = NULL;
-   }
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(List.Handlespace);
-   TMPL_CLASS(peerListManagementVerify, SimpleRedBlackTree)(&List);
+#ifdef INCLUDE_LINEARLIST
+   HANDLESPACE_BACKEND(LinearList),
 #endif
-   return(errorCode);
-}
-
-
-// ###### Deregister peer by pointer ########################################
-unsigned int cPeerList::deregisterPeerListNode(cPeerListNode* peerListNode)
-{
-   unsigned int errorCode = TMPL_CLASS(peerListManagementDeregisterPeerListNodeByPtr, SimpleRedBlackTree)(
-                               &List,
-                               peerListNode->Node);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(List.Handlespace);
-   TMPL_CLASS(peerListManagementVerify, SimpleRedBlackTree)(&List);
+#ifdef INCLUDE_SIMPLEBINARYTREE
+   HANDLESPACE_BACKEND(SimpleBinaryTree),
 #endif
-   return(errorCode);
-}
-
-
-// ###### Deregister peer by ID #############################################
-unsigned int cPeerList::deregisterPeerListNode(unsigned int identifier)
-{
-   unsigned int errorCode = TMPL_CLASS(peerListManagementDeregisterPeerListNode, SimpleRedBlackTree)(
-                               &List,
-                               identifier, NULL);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(List.Handlespace);
-   TMPL_CLASS(peerListManagementVerify, SimpleRedBlackTree)(&List);
+#ifdef INCLUDE_LEAFLINKEDBINARYTREE
+   HANDLESPACE_BACKEND(LeafLinkedBinaryTree),
 #endif
-   return(errorCode);
-}
-
-
-// ###### Find entry by ID ##################################################
-cPeerListNode* cPeerList::findPeerListNode(const unsigned int identifier)
-{
-   OPP_CHECK(identifier != UNDEFINED_REGISTRAR_IDENTIFIER);
-   TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode =
-      TMPL_CLASS(peerListManagementFindPeerListNode, SimpleRedBlackTree)(
-         &List, identifier, NULL);
-   if(peerListNode) {
-      return((cPeerListNode*)peerListNode->UserData);
-   }
-   return(NULL);
-}
+#ifdef INCLUDE_SIMPLETREAP
+   HANDLESPACE_BACKEND(SimpleTreap),
+#endif
+#ifdef INCLUDE_LEAFLINKEDTREAP
+   HANDLESPACE_BACKEND(LeafLinkedTreap),
+#endif
+#ifdef INCLUDE_SIMPLEREDBLACKTREE
+   HANDLESPACE_BACKEND(SimpleRedBlackTree),
+#endif
+#ifdef INCLUDE_LEAFLINKEDREDBLACKTREE
+   HANDLESPACE_BACKEND(LeafLinkedRedBlackTree),
+#endif
+#ifdef INCLUDE_COMPACTREDBLACKTREE
+   HANDLESPACE_BACKEND(CompactRedBlackTree),
+#endif
+#ifdef INCLUDE_BPLUSTREE
+   HANDLESPACE_BACKEND(BPlusTree),
+#endif
+};
+static const size_t HandlespaceBackends = sizeof(HandlespaceBackendArray) / sizeof(HandlespaceBackendArray[0]);
 
 
-// ###### Find entry by address/port ########################################
-cPeerListNode* cPeerList::findPeerListNode(const unsigned int address,
-                                           const unsigned int port)
+// ###### Find storage backend by name ######################################
+static const HandlespaceBackend* findHandlespaceBackend(const char* backendName)
 {
-   struct sockaddr_testaddr address1;
-   address1.ta_family = AF_TEST;
-   address1.ta_addr   = address;
-   address1.ta_port   = port;
-   char registrarTransportBuffer[transportAddressBlockGetSize(1)];
-   struct TransportAddressBlock* registrarTransport = (struct TransportAddressBlock*)&registrarTransportBuffer;
-   transportAddressBlockNew(registrarTransport,
-                            IPPROTO_SCTP,
-                            port,
-                            0,
-                            (sockaddr_union*)&address1, 1, 1);
-
-   TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode =
-      TMPL_CLASS(peerListManagementFindPeerListNode, SimpleRedBlackTree)(
-         &List, 0, registrarTransport);
-   if(peerListNode) {
-      return((cPeerListNode*)peerListNode->UserData);
+   for(size_t i = 0;i < HandlespaceBackends;i++) {
+      if(strcmp(HandlespaceBackendArray[i].Name, backendName) == 0) {
+         return(&HandlespaceBackendArray[i]);
+      }
    }
    return(NULL);
 }
 
 
-// ###### Get random peer list node #########################################
-cPeerListNode* cPeerList::getRandomPeerListNode()
+// ###### Create handlespace using given backend ############################
+cPoolHandlespace* cPoolHandlespace::create(const char*        backendName,
+                                           const unsigned int homeRegistrarIdentifier)
 {
-   TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode =
-      TMPL_CLASS(peerListManagementGetRandomPeerListNode, SimpleRedBlackTree)(&List);
-   if(peerListNode) {
-      return((cPeerListNode*)peerListNode->UserData);
+   const HandlespaceBackend* backend = findHandlespaceBackend(backendName);
+   if(backend != NULL) {
+      return(backend->CreatePoolHandlespace(homeRegistrarIdentifier));
    }
    return(NULL);
 }
 
 
-// ###### Purge #############################################################
-void cPeerList::purge()
-{
-   const unsigned long long now = (unsigned long long)(1000000.0 * getSimulation()->getSimTime().dbl());
-
-   TMPL_CLASS(peerListManagementPurgeExpiredPeerListNodes, SimpleRedBlackTree)(
-      &List, now);
-#ifdef VERIFY
-   TMPL_CLASS(poolHandlespaceManagementVerify, SimpleRedBlackTree)(List.Handlespace);
-   TMPL_CLASS(peerListManagementVerify, SimpleRedBlackTree)(&List);
-#endif
-}
-
-
-// ###### Reset mentor selection information ################################
-void cPeerList::resetMentorSelection()
+// ###### Create peer list using given backend ##############################
+cPeerList* cPeerList::create(const char*        backendName,
+                             const unsigned int registrarIdentifier)
 {
-   TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode;
-
-   peerListNode = TMPL_CLASS(peerListManagementGetFirstPeerListNodeFromIndexStorage, SimpleRedBlackTree)(&List);
-   while(peerListNode != NULL) {
-      cPeerListNode* node = (cPeerListNode*)peerListNode->UserData;
-      node->MentorTrials = 0;
-      peerListNode = TMPL_CLASS(peerListManagementGetNextPeerListNodeFromIndexStorage, SimpleRedBlackTree)(&List, peerListNode);
-   }
-}
-
-
-// ###### Get mentor server #################################################
-cPeerListNode* cPeerList::findMentorServer(const unsigned int localAddress,
-                                           const unsigned int localPort,
-                                           const unsigned int maxTrials)
-{
-   TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode;
-
-   peerListNode = TMPL_CLASS(peerListManagementGetFirstPeerListNodeFromIndexStorage, SimpleRedBlackTree)(&List);
-   while(peerListNode != NULL) {
-      cPeerListNode* node = (cPeerListNode*)peerListNode->UserData;
-
-      if(((node->getAddress() != localAddress) || (node->getPort() != localPort)) &&
-         (node->MentorTrials < maxTrials)) {
-         node->MentorTrials++;
-         return(node);
-      }
-
-      peerListNode = TMPL_CLASS(peerListManagementGetNextPeerListNodeFromIndexStorage, SimpleRedBlackTree)(&List, peerListNode);
+   const HandlespaceBackend* backend = findHandlespaceBackend(backendName);
+   if(backend != NULL) {
+      return(backend->CreatePeerList(registrarIdentifier));
    }
    return(NULL);
 }
 
 
-/* ###### Get better peer for PE ######################################### */
-cPeerListNode* cPeerList::getUsefulPeerForPE(const unsigned int identifier)
+// ###### Create pool user list using given backend #########################
+cPoolUserList* cPoolUserList::create(const char* backendName)
 {
-   ST_CLASS(PeerListNode)* peerListNode = ST_CLASS(peerListManagementGetUsefulPeerForPE)(&List, identifier);
-   if(peerListNode) {
-      cPeerListNode* node = (cPeerListNode*)peerListNode->UserData;
-      return(node);
+   const HandlespaceBackend* backend = findHandlespaceBackend(backendName);
+   if(backend != NULL) {
+      return(backend->CreatePoolUserList());
    }
    return(NULL);
 }
-
-
-
-// ##########################################################################
-// #### Takeover Process                                                 ####
-// ##########################################################################
-
-// ###### Constructor #######################################################
-cTakeoverProcess::cTakeoverProcess(const unsigned int targetID,
-                                   cPeerList*         peerList)
-{
-   Takeover = takeoverProcessNew((RegistrarIdentifierType)targetID, &peerList->List);
-   OPP_CHECK(Takeover);
-}
-
-
-// ###### Destructor ########################################################
-cTakeoverProcess::~cTakeoverProcess()
-{
-   takeoverProcessDelete(Takeover);
-   Takeover = NULL;
-}
-
-
-// ###### Acknowledge takeover ##############################################
-size_t cTakeoverProcess::acknowledge(const unsigned int targetID,
-                                     const unsigned int acknowledgerID)
-{
-   return(takeoverProcessAcknowledge(Takeover,
-                                     (RegistrarIdentifierType)targetID,
-                                     (RegistrarIdentifierType)acknowledgerID));
-}
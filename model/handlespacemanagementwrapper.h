@@ -25,11 +25,11 @@
  *
  * Contact: thomas.dreibholz@gmail.com
  */
-
 #ifndef HANDLESPACEMANAGEMENTWRAPPER_H
 #define HANDLESPACEMANAGEMENTWRAPPER_H
 
 #include <omnetpp.h>
+#include <vector>
 
 #include "config.h"
 #include "utilities.h"
@@ -39,6 +39,16 @@
 #include "registrarmessages_m.h"
 
 
+/*
+   The classes below are a backend-neutral interface to the handlespace
+   library. For each storage backend compiled in (INCLUDE_* in config.h),
+   handlespacemanagementwrapper.cc instantiates subclasses from
+   handlespacemanagementwrapper-template_impl.h. The backend is selected
+   by name at run time, using the create() factories.
+*/
+#define DEFAULT_HANDLESPACE_BACKEND "SimpleRedBlackTree"
+
+
 
 // ##########################################################################
 // #### Pool Element                                                     ####
@@ -47,119 +57,47 @@
 class cPoolElement
 {
    public:
-   void print(const bool full);
+   virtual ~cPoolElement();
+   virtual void print(const bool full) = 0;
 
    // ====== Set/Get methods ================================================
-   inline unsigned int getHomeRegistrarIdentifier() const {
-      return(Node->HomeRegistrarIdentifier);
-   }
-   inline void setHomeRegistrarIdentifier(unsigned int identifier) {
-      Node->HomeRegistrarIdentifier = identifier;
-   }
-   inline unsigned int getIdentifier() const {
-      return(Node->Identifier);
-   }
-   inline void setIdentifier(unsigned int identifier) {
-      Node->Identifier = identifier;
-   }
-   inline unsigned int getRegistratorAddress() const {
-      return(Node->RegistratorTransport->AddressArray[0].ta.ta_addr);
-   }
-   inline void setRegistratorAddress(unsigned int address) {
-      Node->RegistratorTransport->AddressArray[0].ta.ta_family = AF_TEST;
-      Node->RegistratorTransport->AddressArray[0].ta.ta_addr   = address;
-   }
-   inline unsigned int getRegistratorPort() const {
-      return(Node->RegistratorTransport->AddressArray[0].ta.ta_port);
-   }
-   inline void setRegistratorPort(unsigned int port) {
-      Node->RegistratorTransport->AddressArray[0].ta.ta_family = AF_TEST;
-      Node->RegistratorTransport->AddressArray[0].ta.ta_port   = port;
-   }
-   inline unsigned int getRegistrationLife() const {
-      return(Node->RegistrationLife);
-   }
-   inline void setRegistrationLife(unsigned int registrationLife) {
-      Node->RegistrationLife = registrationLife;
-   }
-   inline unsigned int getSelectionCounter() const {
-      return(Node->SelectionCounter);
-   }
-   inline void setSelectionCounter(unsigned int selectionCounter) {
-      Node->SelectionCounter = selectionCounter;
-   }
-   inline unsigned int getVirtualCounter() const {
-      return(Node->VirtualCounter);
-   }
-   inline void setVirtualCounter(unsigned int selectionCounter) {
-      Node->VirtualCounter = selectionCounter;
-   }
-   inline unsigned int getUnreachabilityReports() const {
-      return(Node->UnreachabilityReports);
-   }
-   inline void setUnreachabilityReports(unsigned int reports) {
-      Node->UnreachabilityReports = reports;
-   }
-
-   inline unsigned int getPolicyType() const {
-      return(Node->PolicySettings.PolicyType);
-   }
-   inline void setPolicyType(unsigned int policyType) {
-      Node->PolicySettings.PolicyType = policyType;
-   }
-   inline unsigned int getWeight() const {
-      return(Node->PolicySettings.Weight);
-   }
-   inline void setWeight(unsigned int weight) {
-      Node->PolicySettings.Weight = weight;
-   }
-   inline unsigned int getLoad() const {
-      return(Node->PolicySettings.Load);
-   }
-   inline void setLoad(unsigned int load) {
-      Node->PolicySettings.Load = load;
-   }
-   inline unsigned int getLoadDegradation() const {
-      return(Node->PolicySettings.LoadDegradation);
-   }
-   inline void setLoadDegradation(unsigned int loadDegradation) {
-      Node->PolicySettings.LoadDegradation = loadDegradation;
-   }
-   inline unsigned int getLoadDPF() const {
-      return(Node->PolicySettings.LoadDPF);
-   }
-   inline void setLoadDPF(unsigned int loadDPF) {
-      Node->PolicySettings.LoadDPF = loadDPF;
-   }
-   inline unsigned int getWeightDPF() const {
-      return(Node->PolicySettings.WeightDPF);
-   }
-   inline void setWeightDPF(unsigned int loadDPF) {
-      Node->PolicySettings.WeightDPF = loadDPF;
-   }
-   inline unsigned int getDistance() const {
-      return(Node->PolicySettings.Distance);
-   }
-   inline void setDistance(unsigned int distance) {
-      Node->PolicySettings.Distance = distance;
-   }
-   inline unsigned int getAddress() const {
-      return(Node->UserTransport->AddressArray[0].ta.ta_addr);
-   }
-   inline void setAddress(unsigned int address) {
-      Node->UserTransport->AddressArray[0].ta.ta_family = AF_TEST;
-      Node->UserTransport->AddressArray[0].ta.ta_addr   = address;
-   }
-   inline unsigned int getPort() const {
-      return(Node->UserTransport->AddressArray[0].ta.ta_port);
-   }
-   inline void setPort(unsigned int port) {
-      Node->UserTransport->AddressArray[0].ta.ta_family = AF_TEST;
-      Node->UserTransport->AddressArray[0].ta.ta_port   = port;
-   }
-   inline const char* getOwnerPoolHandle() const {
-      return((const char*)Node->OwnerPoolNode->Handle.Handle);
-   }
+   virtual unsigned int getHomeRegistrarIdentifier() const = 0;
+   virtual void setHomeRegistrarIdentifier(unsigned int identifier) = 0;
+   virtual unsigned int getIdentifier() const = 0;
+   virtual void setIdentifier(unsigned int identifier) = 0;
+   virtual unsigned int getRegistratorAddress() const = 0;
+   virtual void setRegistratorAddress(unsigned int address) = 0;
+   virtual unsigned int getRegistratorPort() const = 0;
+   virtual void setRegistratorPort(unsigned int port) = 0;
+   virtual unsigned int getRegistrationLife() const = 0;
+   virtual void setRegistrationLife(unsigned int registrationLife) = 0;
+   virtual unsigned int getSelectionCounter() const = 0;
+   virtual void setSelectionCounter(unsigned int selectionCounter) = 0;
+   virtual unsigned int getVirtualCounter() const = 0;
+   virtual void setVirtualCounter(unsigned int selectionCounter) = 0;
+   virtual unsigned int getUnreachabilityReports() const = 0;
+   virtual void setUnreachabilityReports(unsigned int reports) = 0;
+
+   virtual unsigned int getPolicyType() const = 0;
+   virtual void setPolicyType(unsigned int policyType) = 0;
+   virtual unsigned int getWeight() const = 0;
+   virtual void setWeight(unsigned int weight) = 0;
+   virtual unsigned int getLoad() const = 0;
+   virtual void setLoad(unsigned int load) = 0;
+   virtual unsigned int getLoadDegradation() const = 0;
+   virtual void setLoadDegradation(unsigned int loadDegradation) = 0;
+   virtual unsigned int getLoadDPF() const = 0;
+   virtual void setLoadDPF(unsigned int loadDPF) = 0;
+   virtual unsigned int getWeightDPF() const = 0;
+   virtual void setWeightDPF(unsigned int loadDPF) = 0;
+   virtual unsigned int getDistance() const = 0;
+   virtual void setDistance(unsigned int distance) = 0;
+   virtual unsigned int getAddress() const = 0;
+   virtual void setAddress(unsigned int address) = 0;
+   virtual unsigned int getPort() const = 0;
+   virtual void setPort(unsigned int port) = 0;
+   virtual const char* getOwnerPoolHandle() const = 0;
+   virtual unsigned int getOwnerPoolHandleID() const = 0;
 
    cPoolElementParameter toPoolElementParameter() const;
 
@@ -170,11 +108,8 @@ class cPoolElement
    EndpointKeepAliveTimeoutMessage*      EndpointKeepAliveTimeoutTimer;
    LifetimeExpiryMessage*                LifetimeExpiryTimer;
 
-   // ====== Private data ===================================================
-   private:
-   friend class cPoolHandlespace;
-
-   struct TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* Node;
+   protected:
+   cPoolElement();
 };
 
 
@@ -187,106 +122,229 @@ opp_string getPoolElementDescription(cPoolElement& poolElement);
 // #### Handlespace                                                      ####
 // ##########################################################################
 
+class cPeerList;
+
+// Request for cPoolHandlespace::selectPoolElementsByPolicy() batches
+struct cHandleResolutionRequest
+{
+   unsigned int PoolHandleID;
+   size_t       MaxHandleResolutionItems;
+   size_t       MaxIncrement;
+
+   // Results: the selected PEs are selectionArray[FirstItem] to
+   // selectionArray[FirstItem + Items - 1]
+   unsigned int ErrorCode;
+   size_t       FirstItem;
+   size_t       Items;
+};
+
 class cPoolHandlespace
 {
    public:
-   cPoolHandlespace(const unsigned int homeRegistrarIdentifier = 0);
-   ~cPoolHandlespace();
+   static cPoolHandlespace* create(const char*        backendName,
+                                   const unsigned int homeRegistrarIdentifier = 0);
+   virtual ~cPoolHandlespace();
+
+   // A peer list always uses the backend of its handlespace.
+   virtual cPeerList* createPeerList(const unsigned int registrarIdentifier) = 0;
 
 
    // ====== Handlespace management =========================================
-   void clear();
-   void print(const unsigned int homeRegistrarIdentifier = 0);
-
-   unsigned int registerPoolElement(const char*                  poolHandle,
-                                    const cPoolElementParameter& poolElementParameter,
-                                    const unsigned int           registratorAddress,
-                                    const unsigned int           registratorPort,
-                                    cPoolElement*&               poolElement,
-                                    bool&                        updated);
-   cPoolElement* findPoolElement(const char*        poolHandle,
-                                 const unsigned int peIdentifier);
-   unsigned int deregisterPoolElement(cPoolElement* poolElement);
-   unsigned int deregisterPoolElement(const char*        poolHandle,
-                                      const unsigned int peIdentifier);
-   void updatePoolElementOwnership(cPoolElement*      poolElement,
-                                   const unsigned int registrarIdentifier);
+   virtual void clear() = 0;
+   virtual void print(const unsigned int homeRegistrarIdentifier = 0) = 0;
+
+   // Pools are identified by their interned pool handle ID (see
+   // getPoolHandleID()). The variants taking the pool handle string
+   // intern it first.
+   virtual unsigned int registerPoolElement(const unsigned int           poolHandleID,
+                                            const cPoolElementParameter& poolElementParameter,
+                                            const unsigned int           registratorAddress,
+                                            const unsigned int           registratorPort,
+                                            cPoolElement*&               poolElement,
+                                            bool&                        updated) = 0;
+   inline unsigned int registerPoolElement(const char*                  poolHandle,
+                                           const cPoolElementParameter& poolElementParameter,
+                                           const unsigned int           registratorAddress,
+                                           const unsigned int           registratorPort,
+                                           cPoolElement*&               poolElement,
+                                           bool&                        updated);
+   virtual size_t registerHandleTable(ENRPHandleTableResponse* handleTable,
+                                      cPoolElement**           poolElementArray) = 0;
+   virtual cPoolElement* findPoolElement(const unsigned int poolHandleID,
+                                         const unsigned int peIdentifier) = 0;
+   inline cPoolElement* findPoolElement(const char*        poolHandle,
+                                        const unsigned int peIdentifier);
+   virtual unsigned int deregisterPoolElement(cPoolElement* poolElement) = 0;
+   virtual unsigned int deregisterPoolElement(const unsigned int poolHandleID,
+                                              const unsigned int peIdentifier) = 0;
+   inline unsigned int deregisterPoolElement(const char*        poolHandle,
+                                             const unsigned int peIdentifier);
+   virtual void updatePoolElementOwnership(cPoolElement*      poolElement,
+                                           const unsigned int registrarIdentifier) = 0;
+   virtual size_t transferPoolElementOwnership(const unsigned int oldRegistrarIdentifier,
+                                               const unsigned int newRegistrarIdentifier) = 0;
 
 
    // ====== Set/Get methods ================================================
-   unsigned int getHandlespaceChecksum() const {
-      return(TMPL_CLASS(poolHandlespaceManagementGetHandlespaceChecksum, SimpleRedBlackTree)(
-               &Handlespace));
-   }
-   unsigned int getOwnershipChecksum() const {
-      return(TMPL_CLASS(poolHandlespaceManagementGetOwnershipChecksum, SimpleRedBlackTree)(
-               &Handlespace));
-   }
-   size_t getPools() {
-      return(TMPL_CLASS(poolHandlespaceManagementGetPools, SimpleRedBlackTree)(
-               &Handlespace));
-   }
-   size_t getPoolElements() const {
-      return(TMPL_CLASS(poolHandlespaceManagementGetPoolElements, SimpleRedBlackTree)(
-               &Handlespace));
-   }
-   size_t getOwnedPoolElements() const {
-      return(TMPL_CLASS(poolHandlespaceManagementGetOwnedPoolElements, SimpleRedBlackTree)(
-               &Handlespace));
-   }
-   size_t getPoolElementsOfPool(const char* poolHandle);
-
-   inline cPoolElement* getFirstPoolElementNode() {
-      struct TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode =
-         TMPL_CLASS(poolHandlespaceManagementGetFirstPoolElementOwnershipNode, SimpleRedBlackTree)(&Handlespace);
-      if(poolElementNode) {
-         return((cPoolElement*)poolElementNode->UserData);
-      }
-      return(NULL);
-   }
-   inline cPoolElement* getNextPoolElementNode(cPoolElement* node) {
-      struct TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode =
-         TMPL_CLASS(poolHandlespaceManagementGetNextPoolElementOwnershipNode, SimpleRedBlackTree)(
-            &Handlespace,
-            node->Node);
-      if(poolElementNode) {
-         return((cPoolElement*)poolElementNode->UserData);
-      }
-      return(NULL);
-   }
+   virtual unsigned int getHandlespaceChecksum() const = 0;
+   virtual unsigned int getOwnershipChecksum() const = 0;
+   virtual size_t getPools() = 0;
+   virtual size_t getPoolElements() const = 0;
+   virtual size_t getOwnedPoolElements() const = 0;
+   virtual size_t getPoolElementsOfPool(const unsigned int poolHandleID) = 0;
+   inline size_t getPoolElementsOfPool(const char* poolHandle);
+
+   // Memory used by the handlespace, including the wrapper objects of
+   // its PEs (see poolHandlespaceManagementGetMemoryUsage()).
+   virtual void getMemoryUsage(HandlespaceMemoryUsage& memoryUsage) = 0;
+
+   virtual cPoolElement* getFirstPoolElementNode() = 0;
+   virtual cPoolElement* getNextPoolElementNode(cPoolElement* node) = 0;
+
+   virtual cPoolElement* getFirstPoolElementOwnedBy(const unsigned int homeRegistrarIdentifier) = 0;
+   virtual cPoolElement* getNextPoolElementOfSameOwner(cPoolElement* poolElement) = 0;
+
+   virtual void restartPoolElementExpiryTimer(cPoolElement*            poolElement,
+                                              const unsigned long long expiryTimeout) = 0;
+   virtual size_t purgeExpiredPoolElements() = 0;
+
+
+   virtual size_t selectPoolElementsByPolicy(const unsigned int poolHandleID,
+                                             cPoolElement**     selectionArray,
+                                             size_t&            items,
+                                             const size_t       maxHandleResolutionItems,
+                                             const size_t       maxIncrement) = 0;
+   inline size_t selectPoolElementsByPolicy(const char*    poolHandle,
+                                            cPoolElement** selectionArray,
+                                            size_t&        items,
+                                            const size_t   maxHandleResolutionItems,
+                                            const size_t   maxIncrement);
+   // Resolves a batch of requests pool by pool, each one getting the next
+   // MaxHandleResolutionItems entries of selectionArray (see
+   // poolHandlespaceManagementHandleResolutions()). Returns the number
+   // of selected PEs.
+   virtual size_t selectPoolElementsByPolicy(cHandleResolutionRequest* requestArray,
+                                             const size_t              requests,
+                                             cPoolElement**            selectionArray,
+                                             const size_t              maxItems) = 0;
+   virtual cArray* exportToPoolEntries(const unsigned int homeRegistrarIdentifier) = 0;
+
+   // The handlespace version increases with each change of a PE. If
+   // hasChangesSince() accepts a version, exportChangesToPoolEntries()
+   // returns the PEs changed since then, and the PEs deleted since then
+   // in deletedPoolEntryArray (only pool handle, PE identifier and home
+   // registrar set). Both arrays are NULL if empty.
+   virtual unsigned long long getHandlespaceVersion() const = 0;
+   virtual bool hasChangesSince(const unsigned long long version) const = 0;
+   virtual cArray* exportChangesToPoolEntries(const unsigned int       homeRegistrarIdentifier,
+                                              const unsigned long long sinceVersion,
+                                              cArray*&                 deletedPoolEntryArray) = 0;
+
+   // A registrar's ownership checksum is the root of a digest tree. Its
+   // children are the digests of HANDLESPACE_DIGEST_BUCKETS buckets of
+   // pools, hashed by pool handle; the pools' digests are the leaves.
+   // getOwnershipDigests() fills digestArray with the bucket digests.
+   // exportPoolDigests() returns cPoolDigests of the own pools in buckets
+   // differing from digestArray, exportPoolsToPoolEntries() the PEs of the
+   // given pools. Both return NULL if empty.
+   virtual void getOwnershipDigests(const unsigned int registrarIdentifier,
+                                    unsigned int*      digestArray) = 0;
+   virtual unsigned int getPoolOwnershipDigest(const unsigned int registrarIdentifier,
+                                               const unsigned int poolHandleID) = 0;
+   virtual unsigned int getOwnershipDigestBucket(const unsigned int poolHandleID) const = 0;
+   virtual cArray* exportPoolDigests(const unsigned int* digestArray) = 0;
+   virtual cArray* exportPoolsToPoolEntries(const unsigned int  homeRegistrarIdentifier,
+                                            const unsigned int* poolHandleIDArray,
+                                            const size_t        poolHandleIDs) = 0;
+
+   protected:
+   static void killPoolElement(cPoolElement* poolElement);
+};
 
 
-   cPoolElement* getFirstPoolElementOwnedBy(const unsigned int homeRegistrarIdentifier);
-   cPoolElement* getNextPoolElementOfSameOwner(struct cPoolElement* poolElement);
+// ###### Get length of pool handle #########################################
+inline size_t getPoolHandleSize(const char* poolHandle)
+{
+   return(strlen(poolHandle) + 1);
+}
+
 
-   void restartPoolElementExpiryTimer(cPoolElement*            poolElement,
-                                      const unsigned long long expiryTimeout);
-   size_t purgeExpiredPoolElements();
+// ###### Get ID of interned pool handle ####################################
+inline unsigned int getPoolHandleID(const char* poolHandle)
+{
+   const struct PoolHandle* interned = poolHandleIntern((const unsigned char*)poolHandle,
+                                                        getPoolHandleSize(poolHandle));
+   if(interned == NULL) {
+      throw cRuntimeError("Unable to intern pool handle %s", poolHandle);
+   }
+   return(interned->Identifier);
+}
 
 
-   size_t selectPoolElementsByPolicy(const char*    poolHandle,
-                                     cPoolElement** selectionArray,
-                                     size_t&        items,
-                                     const size_t   maxHandleResolutionItems,
-                                     const size_t   maxIncrement);
-   cArray* exportToPoolEntries(const unsigned int homeRegistrarIdentifier);
+// ###### Get pool handle from ID of interned pool handle ###################
+inline const char* getPoolHandleByID(const unsigned int poolHandleID)
+{
+   const struct PoolHandle* interned = poolHandleGetInterned(poolHandleID);
+   if(interned == NULL) {
+      throw cRuntimeError("Invalid pool handle ID %u", poolHandleID);
+   }
+   return((const char*)interned->Handle);
+}
 
 
-   // ====== Private data ===================================================
-   private:
-   friend class cPeerList;
+// ###### Get pool handle ID of message #####################################
+// The ASAP and ENRP processes only set PoolHandleID; the pool handle string
+// is set only by applications and the attacker, i.e. PoolHandleID is unset
+// (0) and the pool handle is interned then. Use getPoolHandleByID() to get
+// the string for output.
+template<class T> inline unsigned int getMessagePoolHandleID(const T* msg)
+{
+   const unsigned int poolHandleID = msg->getPoolHandleID();
+   if(poolHandleID != 0) {
+      return(poolHandleID);
+   }
+   return(getPoolHandleID(msg->getPoolHandle()));
+}
 
-   static void killPoolElement(TMPL_CLASS(PoolElementNode, SimpleRedBlackTree)* poolElementNode,
-                               void*                                            userData);
 
-   struct TMPL_CLASS(PoolHandlespaceManagement, SimpleRedBlackTree) Handlespace;
-};
+// ###### Pool handle string variants of cPoolHandlespace methods ###########
+inline unsigned int cPoolHandlespace::registerPoolElement(const char*                  poolHandle,
+                                                          const cPoolElementParameter& poolElementParameter,
+                                                          const unsigned int           registratorAddress,
+                                                          const unsigned int           registratorPort,
+                                                          cPoolElement*&               poolElement,
+                                                          bool&                        updated)
+{
+   return(registerPoolElement(getPoolHandleID(poolHandle), poolElementParameter,
+                              registratorAddress, registratorPort,
+                              poolElement, updated));
+}
 
+inline cPoolElement* cPoolHandlespace::findPoolElement(const char*        poolHandle,
+                                                       const unsigned int peIdentifier)
+{
+   return(findPoolElement(getPoolHandleID(poolHandle), peIdentifier));
+}
 
-// ###### Get length of pool handle #########################################
-inline size_t getPoolHandleSize(const char* poolHandle)
+inline unsigned int cPoolHandlespace::deregisterPoolElement(const char*        poolHandle,
+                                                            const unsigned int peIdentifier)
 {
-   return(strlen(poolHandle) + 1);
+   return(deregisterPoolElement(getPoolHandleID(poolHandle), peIdentifier));
+}
+
+inline size_t cPoolHandlespace::getPoolElementsOfPool(const char* poolHandle)
+{
+   return(getPoolElementsOfPool(getPoolHandleID(poolHandle)));
+}
+
+inline size_t cPoolHandlespace::selectPoolElementsByPolicy(const char*    poolHandle,
+                                                           cPoolElement** selectionArray,
+                                                           size_t&        items,
+                                                           const size_t   maxHandleResolutionItems,
+                                                           const size_t   maxIncrement)
+{
+   return(selectPoolElementsByPolicy(getPoolHandleID(poolHandle), selectionArray, items,
+                                     maxHandleResolutionItems, maxIncrement));
 }
 
 
@@ -314,54 +372,25 @@ class cTakeoverProcess;
 class cPeerListNode
 {
    public:
-   void print(const bool full);
+   virtual ~cPeerListNode();
+   virtual void print(const bool full) = 0;
 
 
    // ====== Set/Get methods ================================================
-   unsigned int getIdentifier() const {
-      return((unsigned int)Node->Identifier);
-   }
-   void setIdentifier(const unsigned int identifier) {
-      Node->Identifier = (RegistrarIdentifierType)identifier;
-   }
-   inline unsigned int getStatus() const {
-      return(Node->Status);
-   }
-   inline void setStatus(unsigned int status) {
-      Node->Status = status;
-   }
-   inline unsigned int getAddress() const {
-      return(Node->AddressBlock->AddressArray[0].ta.ta_addr);
-   }
-   inline void setAddress(unsigned int address) {
-      Node->AddressBlock->AddressArray[0].ta.ta_family = AF_TEST;
-      Node->AddressBlock->AddressArray[0].ta.ta_addr   = address;
-   }
-   inline unsigned int getPort() const {
-      return(Node->AddressBlock->AddressArray[0].ta.ta_port);
-   }
-   inline void setPort(unsigned int port) {
-      Node->AddressBlock->AddressArray[0].ta.ta_family = AF_TEST;
-      Node->AddressBlock->AddressArray[0].ta.ta_port   = port;
-   }
-   inline bool getNewFlag() const {
-      return((Node->Flags & PLNF_NEW) != 0);
-   }
-   inline simtime_t getLastHeared() const {
-      return((simtime_t)(Node->LastUpdateTimeStamp / 1000000.0));
-   }
-   inline void setLastHeared(const simtime_t lastHeared) {
-      Node->LastUpdateTimeStamp = (unsigned long long)(1000000.0 * lastHeared.dbl());
-   }
-   inline unsigned int getTakeoverRegistrarID() const {
-      return(Node->TakeoverRegistrarID);
-   }
-   inline void setTakeoverRegistrarID(unsigned int registrarIdentifier) {
-      Node->TakeoverRegistrarID = (RegistrarIdentifierType)registrarIdentifier;
-   }
-   unsigned int getOwnershipChecksum() const {
-      return(TMPL_CLASS(peerListNodeGetOwnershipChecksum, SimpleRedBlackTree)(Node));
-   }
+   virtual unsigned int getIdentifier() const = 0;
+   virtual void setIdentifier(const unsigned int identifier) = 0;
+   virtual unsigned int getStatus() const = 0;
+   virtual void setStatus(unsigned int status) = 0;
+   virtual unsigned int getAddress() const = 0;
+   virtual void setAddress(unsigned int address) = 0;
+   virtual unsigned int getPort() const = 0;
+   virtual void setPort(unsigned int port) = 0;
+   virtual bool getNewFlag() const = 0;
+   virtual simtime_t getLastHeared() const = 0;
+   virtual void setLastHeared(const simtime_t lastHeared) = 0;
+   virtual unsigned int getTakeoverRegistrarID() const = 0;
+   virtual void setTakeoverRegistrarID(unsigned int registrarIdentifier) = 0;
+   virtual unsigned int getOwnershipChecksum() const = 0;
    ServerInformationParameter toServerInformationParameter() const;
 
 
@@ -371,9 +400,17 @@ class cPeerListNode
    ResponseTimeoutMessage*   ResponseTimeoutTimer;
    TakeoverExpiryMessage*    TakeoverExpiryTimer;
 
-   unsigned int                                         MentorTrials;
-   struct TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* Node;
-   cTakeoverProcess*                                    Takeover;
+   unsigned int              MentorTrials;
+   cTakeoverProcess*         Takeover;
+
+   // Peer's handlespace version and incarnation after the last handle
+   // table synchronization, and whether it has been incremental
+   unsigned long long        HandlespaceVersion;
+   unsigned int              HandlespaceIncarnation;
+   bool                      IncrementalSync;
+
+   protected:
+   cPeerListNode();
 };
 
 
@@ -385,64 +422,40 @@ class cPeerListNode
 class cPeerList
 {
    public:
-   cPeerList(cPoolHandlespace*  handlespace,
-             const unsigned int registrarIdentifier);
-   ~cPeerList();
+   // Creates a peer list without handlespace (e.g. a static registrar table).
+   static cPeerList* create(const char*        backendName,
+                            const unsigned int registrarIdentifier);
+   virtual ~cPeerList();
 
 
    // ====== PeerList management ============================================
-   void clear();
-   void print();
-   unsigned int registerPeerListNode(const ServerInformationParameter& serverInformationParameter,
-                                     cPeerListNode*&                   node);
-   unsigned int deregisterPeerListNode(cPeerListNode* peerListEntry);
-   unsigned int deregisterPeerListNode(unsigned int identifier);
-   cPeerListNode* findPeerListNode(const unsigned int identifier);
-   cPeerListNode* findPeerListNode(const unsigned int address,
-                                   const unsigned int port);
+   virtual void clear() = 0;
+   virtual void print() = 0;
+   virtual unsigned int registerPeerListNode(const ServerInformationParameter& serverInformationParameter,
+                                             cPeerListNode*&                   node) = 0;
+   virtual unsigned int deregisterPeerListNode(cPeerListNode* peerListEntry) = 0;
+   virtual unsigned int deregisterPeerListNode(unsigned int identifier) = 0;
+   virtual cPeerListNode* findPeerListNode(const unsigned int identifier) = 0;
+   virtual cPeerListNode* findPeerListNode(const unsigned int address,
+                                           const unsigned int port) = 0;
 
 
-   void purge();
+   virtual void purge() = 0;
 
    void resetMentorSelection();
    cPeerListNode* findMentorServer(const unsigned int localAddress,
                                    const unsigned int localPort,
                                    const unsigned int maxTrials);
-   cPeerListNode* getUsefulPeerForPE(const unsigned int identifier);
+   virtual cPeerListNode* getUsefulPeerForPE(const unsigned int identifier) = 0;
 
 
    // ====== Set/Get methods ================================================
-   cPeerListNode* getRandomPeerListNode();
-   inline size_t getPeers() const {
-      return(TMPL_CLASS(peerListManagementGetPeers, SimpleRedBlackTree)(&List));
-   }
-   inline cPeerListNode* getFirstPeerListNode() {
-      struct TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode =
-         TMPL_CLASS(peerListManagementGetFirstPeerListNodeFromIndexStorage, SimpleRedBlackTree)(&List);
-      if(peerListNode) {
-         return((cPeerListNode*)peerListNode->UserData);
-      }
-      return(NULL);
-   }
-   inline cPeerListNode* getNextPeerListNode(cPeerListNode* node) {
-      struct TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode =
-         TMPL_CLASS(peerListManagementGetNextPeerListNodeFromIndexStorage, SimpleRedBlackTree)(
-            &List, node->Node);
-      if(peerListNode) {
-         return((cPeerListNode*)peerListNode->UserData);
-      }
-      return(NULL);
-   }
-
-
-   // ====== Private data ===================================================
-   private:
-   friend class cTakeoverProcess;
-   static void killPeerListNode(TMPL_CLASS(PeerListNode, SimpleRedBlackTree)* peerListNode,
-                                void*                                         userData);
-
-   struct TMPL_CLASS(PeerListManagement, SimpleRedBlackTree) List;
-   cPoolHandlespace*                                         Handlespace;
+   virtual unsigned int getOwnIdentifier() const = 0;
+   virtual cPeerListNode* getRandomPeerListNode() = 0;
+   virtual size_t getPeers() const = 0;
+   virtual void getMemoryUsage(HandlespaceMemoryUsage& memoryUsage) = 0;
+   virtual cPeerListNode* getFirstPeerListNode() = 0;
+   virtual cPeerListNode* getNextPeerListNode(cPeerListNode* node) = 0;
 };
 
 
@@ -454,35 +467,30 @@ class cPeerList
 class cPoolUserList
 {
    public:
-   cPoolUserList();
-   ~cPoolUserList();
+   static cPoolUserList* create(const char* backendName);
+   virtual ~cPoolUserList();
 
 
    // ====== PoolUserList management ========================================
-   void clear();
-   void print();
-
-   TMPL_CLASS(PoolUserNode, SimpleRedBlackTree)* registerPoolUser(
-      const unsigned int address,
-      const unsigned int port);
-   void purge(const simtime_t minTime);
-   double noteHandleResolutionOfPoolUser(const char*        poolHandle,
-                                         const unsigned int address,
-                                         const unsigned int port,
-                                         const size_t       buckets,
-                                         const size_t       maxEntries);
-   double noteEndpointUnreachableOfPoolUser(const char*        poolHandle,
-                                            const unsigned int address,
-                                            const unsigned int port,
-                                            const unsigned int peIdentifier,
-                                            const size_t       buckets,
-                                            const size_t       maxEntries);
+   virtual void clear() = 0;
+   virtual void print() = 0;
+
+   virtual void purge(const simtime_t minTime) = 0;
+   virtual double noteHandleResolutionOfPoolUser(const unsigned int poolHandleID,
+                                                 const unsigned int address,
+                                                 const unsigned int port,
+                                                 const size_t       buckets,
+                                                 const size_t       maxEntries) = 0;
+   virtual double noteEndpointUnreachableOfPoolUser(const unsigned int poolHandleID,
+                                                    const unsigned int address,
+                                                    const unsigned int port,
+                                                    const unsigned int peIdentifier,
+                                                    const size_t       buckets,
+                                                    const size_t       maxEntries) = 0;
 
 
-   // ====== Private data ===================================================
-   private:
-   struct TMPL_CLASS(PoolUserList, SimpleRedBlackTree) List;
-   struct ST_CLASS(PoolUserNode)*                      NewPoolUserNode;
+   // ====== Set/Get methods ================================================
+   virtual void getMemoryUsage(HandlespaceMemoryUsage& memoryUsage) = 0;
 };
 
 
@@ -0,0 +1,215 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "identifierhashtable.h"
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ###### Initialize ##################################################### */
+void identifierHashTableNew(struct IdentifierHashTable* identifierHashTable)
+{
+   identifierHashTable->Entries    = 0;
+   identifierHashTable->Capacity   = 0;
+   identifierHashTable->Shift      = 64;
+   identifierHashTable->EntryArray = NULL;
+}
+
+
+/* ###### Invalidate ##################################################### */
+void identifierHashTableDelete(struct IdentifierHashTable* identifierHashTable)
+{
+   free(identifierHashTable->EntryArray);
+   identifierHashTableNew(identifierHashTable);
+}
+
+
+/* ###### Remove all elements ############################################ */
+void identifierHashTableClear(struct IdentifierHashTable* identifierHashTable)
+{
+   size_t i;
+
+   for(i = 0;i < identifierHashTable->Capacity;i++) {
+      identifierHashTable->EntryArray[i].Element = NULL;
+   }
+   identifierHashTable->Entries = 0;
+}
+
+
+/* ###### Store entry into its first free slot ########################### */
+static void identifierHashTablePlace(struct IdentifierHashTable*      identifierHashTable,
+                                     const IdentifierHashTableKeyType key,
+                                     void*                            element)
+{
+   size_t i;
+
+   for(i = identifierHashTableGetHomeSlot(identifierHashTable, key);
+       identifierHashTable->EntryArray[i].Element != NULL;
+       i = (i + 1) & (identifierHashTable->Capacity - 1)) {
+      CHECK(identifierHashTable->EntryArray[i].Key != key);
+   }
+   identifierHashTable->EntryArray[i].Key     = key;
+   identifierHashTable->EntryArray[i].Element = element;
+}
+
+
+/* ###### Resize table and rehash all entries ############################ */
+static int identifierHashTableResize(struct IdentifierHashTable* identifierHashTable,
+                                     const size_t                newCapacity)
+{
+   struct IdentifierHashTableEntry* oldEntryArray = identifierHashTable->EntryArray;
+   const size_t                     oldCapacity   = identifierHashTable->Capacity;
+   struct IdentifierHashTableEntry* newEntryArray;
+   unsigned int                     newShift;
+   size_t                           i;
+
+   newEntryArray = (struct IdentifierHashTableEntry*)calloc(newCapacity,
+                                                            sizeof(struct IdentifierHashTableEntry));
+   if(newEntryArray == NULL) {
+      return(0);
+   }
+   for(newShift = 64, i = newCapacity;i > 1;i /= 2) {
+      newShift--;
+   }
+
+   identifierHashTable->EntryArray = newEntryArray;
+   identifierHashTable->Capacity   = newCapacity;
+   identifierHashTable->Shift      = newShift;
+   for(i = 0;i < oldCapacity;i++) {
+      if(oldEntryArray[i].Element != NULL) {
+         identifierHashTablePlace(identifierHashTable,
+                                  oldEntryArray[i].Key, oldEntryArray[i].Element);
+      }
+   }
+   free(oldEntryArray);
+   return(1);
+}
+
+
+/* ###### Insert element ################################################# */
+/*
+   Returns 0, if the table could not be enlarged. The table is unchanged
+   in this case.
+*/
+int identifierHashTableInsert(struct IdentifierHashTable*      identifierHashTable,
+                              const IdentifierHashTableKeyType key,
+                              void*                            element)
+{
+   CHECK(element != NULL);
+   if(2 * (identifierHashTable->Entries + 1) > identifierHashTable->Capacity) {
+      if(!identifierHashTableResize(identifierHashTable,
+                                    (identifierHashTable->Capacity > 0) ?
+                                       (2 * identifierHashTable->Capacity) : 16)) {
+         return(0);
+      }
+   }
+   identifierHashTablePlace(identifierHashTable, key, element);
+   identifierHashTable->Entries++;
+   return(1);
+}
+
+
+/* ###### Remove element ################################################# */
+void* identifierHashTableRemove(struct IdentifierHashTable*      identifierHashTable,
+                                const IdentifierHashTableKeyType key)
+{
+   const size_t mask = identifierHashTable->Capacity - 1;
+   void*        element;
+   size_t       home;
+   size_t       i, j;
+
+   if(identifierHashTable->Capacity == 0) {
+      return(NULL);
+   }
+   for(i = identifierHashTableGetHomeSlot(identifierHashTable, key);
+       (identifierHashTable->EntryArray[i].Element != NULL) &&
+          (identifierHashTable->EntryArray[i].Key != key);
+       i = (i + 1) & mask) {
+   }
+   element = identifierHashTable->EntryArray[i].Element;
+   if(element == NULL) {
+      return(NULL);
+   }
+
+   /* Backward-shift deletion: move following entries of the probe
+      sequence into the gap, unless this would place them before
+      their home slot. No tombstones are necessary. */
+   for(j = (i + 1) & mask;identifierHashTable->EntryArray[j].Element != NULL;j = (j + 1) & mask) {
+      home = identifierHashTableGetHomeSlot(identifierHashTable,
+                                            identifierHashTable->EntryArray[j].Key);
+      if(((j - home) & mask) >= ((j - i) & mask)) {
+         identifierHashTable->EntryArray[i] = identifierHashTable->EntryArray[j];
+         i = j;
+      }
+   }
+   identifierHashTable->EntryArray[i].Element = NULL;
+   identifierHashTable->Entries--;
+   return(element);
+}
+
+
+/* ###### Verify structure ############################################### */
+void identifierHashTableVerify(const struct IdentifierHashTable* identifierHashTable)
+{
+   size_t entries = 0;
+   size_t i, j;
+
+   CHECK(2 * identifierHashTable->Entries <= identifierHashTable->Capacity);
+   for(i = 0;i < identifierHashTable->Capacity;i++) {
+      if(identifierHashTable->EntryArray[i].Element != NULL) {
+         /* The entry must be reachable from its home slot */
+         for(j = identifierHashTableGetHomeSlot(identifierHashTable,
+                                                identifierHashTable->EntryArray[i].Key);
+             j != i;
+             j = (j + 1) & (identifierHashTable->Capacity - 1)) {
+            CHECK(identifierHashTable->EntryArray[j].Element != NULL);
+         }
+         CHECK(identifierHashTableFind(identifierHashTable,
+                                       identifierHashTable->EntryArray[i].Key) ==
+                  identifierHashTable->EntryArray[i].Element);
+         entries++;
+      }
+   }
+   CHECK(entries == identifierHashTable->Entries);
+}
+
+
+/* ###### Get number of bytes allocated for the entry array ############## */
+size_t identifierHashTableGetMemoryUsage(const struct IdentifierHashTable* identifierHashTable)
+{
+   return(identifierHashTable->Capacity * sizeof(struct IdentifierHashTableEntry));
+}
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef IDENTIFIERHASHTABLE_H
+#define IDENTIFIERHASHTABLE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Open-addressing hash table (linear probing, backward-shift deletion)
+   mapping non-zero 32-bit identifiers to elements. The load factor is
+   kept at most 1/2, i.e. a lookup needs O(1) probes on average.
+   The table does not allow duplicate keys or NULL elements.
+*/
+typedef uint32_t IdentifierHashTableKeyType;
+
+struct IdentifierHashTableEntry
+{
+   IdentifierHashTableKeyType Key;
+   void*                      Element;    /* NULL for a free slot       */
+};
+
+struct IdentifierHashTable
+{
+   size_t                           Entries;
+   size_t                           Capacity;   /* 0 or a power of 2   */
+   unsigned int                     Shift;      /* 64 - log2(Capacity) */
+   struct IdentifierHashTableEntry* EntryArray;
+};
+
+
+void identifierHashTableNew(struct IdentifierHashTable* identifierHashTable);
+void identifierHashTableDelete(struct IdentifierHashTable* identifierHashTable);
+void identifierHashTableClear(struct IdentifierHashTable* identifierHashTable);
+int identifierHashTableInsert(struct IdentifierHashTable*      identifierHashTable,
+                              const IdentifierHashTableKeyType key,
+                              void*                            element);
+void* identifierHashTableRemove(struct IdentifierHashTable*      identifierHashTable,
+                                const IdentifierHashTableKeyType key);
+void identifierHashTableVerify(const struct IdentifierHashTable* identifierHashTable);
+size_t identifierHashTableGetMemoryUsage(const struct IdentifierHashTable* identifierHashTable);
+
+inline static size_t identifierHashTableGetEntries(const struct IdentifierHashTable* identifierHashTable)
+{
+   return(identifierHashTable->Entries);
+}
+
+inline static size_t identifierHashTableGetHomeSlot(const struct IdentifierHashTable* identifierHashTable,
+                                                    const IdentifierHashTableKeyType  key)
+{
+   /* Fibonacci hashing: the upper bits of the product are well mixed,
+      also for the sequential identifiers of a registrar. */
+   return((size_t)(((uint64_t)key * 0x9e3779b97f4a7c15ULL) >> identifierHashTable->Shift));
+}
+
+inline static void* identifierHashTableFind(const struct IdentifierHashTable* identifierHashTable,
+                                            const IdentifierHashTableKeyType  key)
+{
+   size_t i;
+
+   if(identifierHashTable->Capacity > 0) {
+      for(i = identifierHashTableGetHomeSlot(identifierHashTable, key);
+          identifierHashTable->EntryArray[i].Element != NULL;
+          i = (i + 1) & (identifierHashTable->Capacity - 1)) {
+         if(identifierHashTable->EntryArray[i].Key == key) {
+            return(identifierHashTable->EntryArray[i].Element);
+         }
+      }
+   }
+   return(NULL);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
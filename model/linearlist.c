@@ -229,6 +229,14 @@ size_t linearListGetElements(const struct LinearList* ll)
 }
 
 
+/* ###### Get number of bytes allocated besides the nodes ################ */
+/* The list only links the nodes embedded into the elements. */
+size_t linearListGetMemoryUsage(const struct LinearList* ll)
+{
+   return(0);
+}
+
+
 /* ###### Insert node #################################################### */
 /*
    returns node, if node has been inserted. Otherwise, duplicate node
@@ -256,7 +264,7 @@ struct LinearListNode* linearListInsert(struct LinearList*     ll,
 #ifdef DEBUG
          linearListPrint(ll, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
          linearListVerify(ll);
 #endif
          return(newNode);
@@ -272,13 +280,40 @@ struct LinearListNode* linearListInsert(struct LinearList*     ll,
 #ifdef DEBUG
    linearListPrint(ll, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
    linearListVerify(ll);
 #endif
    return(newNode);
 }
 
 
+/* ###### Build list from sorted node array ############################# */
+/*
+   nodeArray has to be sorted by the comparison function, without
+   duplicates. It has to contain all nodes currently in the list.
+*/
+void linearListBuild(struct LinearList*      ll,
+                     struct LinearListNode** nodeArray,
+                     const size_t            nodes)
+{
+   size_t i;
+
+   doubleLinkedRingListNew(&ll->List);
+   ll->ValueSum = 0;
+   for(i = 0;i < nodes;i++) {
+      doubleLinkedRingListAddTail(&ll->List, &nodeArray[i]->Node);
+      ll->ValueSum += nodeArray[i]->Value;
+   }
+   ll->Elements = nodes;
+#ifdef DEBUG
+   linearListPrint(ll, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   linearListVerify(ll);
+#endif
+}
+
+
 /* ###### Find node ###################################################### */
 struct LinearListNode* linearListFind(const struct LinearList*     ll,
                                       const struct LinearListNode* cmpNode)
@@ -83,8 +83,12 @@ struct LinearListNode* linearListGetNearestNext(
                           const struct LinearList*     ll,
                           const struct LinearListNode* cmpNode);
 size_t linearListGetElements(const struct LinearList* ll);
+size_t linearListGetMemoryUsage(const struct LinearList* ll);
 struct LinearListNode* linearListInsert(struct LinearList*     ll,
                                         struct LinearListNode* newNode);
+void linearListBuild(struct LinearList*      ll,
+                     struct LinearListNode** nodeArray,
+                     const size_t            nodes);
 struct LinearListNode* linearListFind(const struct LinearList*     ll,
                                       const struct LinearListNode* cmpNode);
 struct LinearListNode* linearListRemove(struct LinearList*     ll,
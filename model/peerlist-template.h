@@ -40,6 +40,7 @@ struct ST_CLASS(PeerList)
 {
    struct ST_CLASSNAME     PeerListIndexStorage;
    struct ST_CLASSNAME     PeerListTimerStorage;
+   struct TimingWheel      PeerListTimerWheel;   /* Timers beyond horizon */
 
    RegistrarIdentifierType OwnIdentifier;
 
@@ -64,6 +65,7 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetPrevPeerListNodeFromIndexStor
                                   struct ST_CLASS(PeerListNode)* peerListNode);
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetFirstPeerListNodeFromTimerStorage)(
                                   struct ST_CLASS(PeerList)* peerList);
+size_t ST_CLASS(peerListFetchAllTimers)(struct ST_CLASS(PeerList)* peerList);
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetLastPeerListNodeFromTimerStorage)(
                                   struct ST_CLASS(PeerList)* peerList);
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetNextPeerListNodeFromTimerStorage)(
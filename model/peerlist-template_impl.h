@@ -36,6 +36,7 @@ void ST_CLASS(peerListNew)(struct ST_CLASS(PeerList)*    peerList,
    ST_METHOD(New)(&peerList->PeerListTimerStorage,
                   ST_CLASS(peerListTimerStorageNodePrint),
                   ST_CLASS(peerListTimerStorageNodeComparison));
+   timingWheelNew(&peerList->PeerListTimerWheel, TIMINGWHEEL_DEFAULT_GRANULARITY);
    peerList->OwnIdentifier = ownIdentifier;
    peerList->UserData      = NULL;
 }
@@ -46,6 +47,7 @@ void ST_CLASS(peerListDelete)(struct ST_CLASS(PeerList)* peerList)
 {
    ST_METHOD(Delete)(&peerList->PeerListIndexStorage);
    ST_METHOD(Delete)(&peerList->PeerListTimerStorage);
+   timingWheelDelete(&peerList->PeerListTimerWheel);
 
    peerList->OwnIdentifier = UNDEFINED_REGISTRAR_IDENTIFIER;
 }
@@ -111,11 +113,38 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetPrevPeerListNodeFromIndexStor
 }
 
 
+/* ###### Move next tick of timer wheel into sorted timer storage ######## */
+static size_t ST_CLASS(peerListFetchTimers)(struct ST_CLASS(PeerList)* peerList)
+{
+   struct DoubleLinkedRingList      dueList;
+   struct DoubleLinkedRingListNode* listNode;
+   struct ST_CLASS(PeerListNode)*   peerListNode;
+   struct STN_CLASSNAME*            result;
+   size_t                           fetched;
+
+   doubleLinkedRingListNew(&dueList);
+   fetched = timingWheelAdvance(&peerList->PeerListTimerWheel, &dueList);
+   while(dueList.Node.Next != &dueList.Node) {
+      listNode = dueList.Node.Next;
+      doubleLinkedRingListRemNode(listNode);
+      peerListNode = ST_CLASS(getPeerListNodeFromPeerListTimerWheelNode)(listNode);
+      result = ST_METHOD(Insert)(&peerList->PeerListTimerStorage,
+                                 &peerListNode->PeerListTimerStorageNode);
+      CHECK(result == &peerListNode->PeerListTimerStorageNode);
+   }
+   doubleLinkedRingListDelete(&dueList);
+   return(fetched);
+}
+
+
 /* ###### Get first PeerListNode from Timer ############################## */
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetFirstPeerListNodeFromTimerStorage)(
                                   struct ST_CLASS(PeerList)* peerList)
 {
    struct STN_CLASSNAME* node = ST_METHOD(GetFirst)(&peerList->PeerListTimerStorage);
+   if((node == NULL) && (ST_CLASS(peerListFetchTimers)(peerList) > 0)) {
+      node = ST_METHOD(GetFirst)(&peerList->PeerListTimerStorage);
+   }
    if(node) {
       return(ST_CLASS(getPeerListNodeFromPeerListTimerStorageNode)(node));
    }
@@ -123,11 +152,33 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetFirstPeerListNodeFromTimerSto
 }
 
 
+/* ###### Move all timers of timer wheel into sorted timer storage ###### */
+/*
+   Required before iterating the timers backwards, i.e. by
+   peerListGetLastPeerListNodeFromTimerStorage(): the last timer may be
+   anywhere in the wheel. Returns the number of timers moved.
+*/
+size_t ST_CLASS(peerListFetchAllTimers)(struct ST_CLASS(PeerList)* peerList)
+{
+   size_t fetched = 0;
+   size_t count;
+
+   while((count = ST_CLASS(peerListFetchTimers)(peerList)) > 0) {
+      fetched += count;
+   }
+   return(fetched);
+}
+
+
 /* ###### Get last PeerListNode from Timer ############################### */
+/* All timers must be in the sorted storage, see peerListFetchAllTimers(). */
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetLastPeerListNodeFromTimerStorage)(
                                   struct ST_CLASS(PeerList)* peerList)
 {
-   struct STN_CLASSNAME* node = ST_METHOD(GetLast)(&peerList->PeerListTimerStorage);
+   struct STN_CLASSNAME* node;
+
+   CHECK(timingWheelIsEmpty(&peerList->PeerListTimerWheel));
+   node = ST_METHOD(GetLast)(&peerList->PeerListTimerStorage);
    if(node) {
       return(ST_CLASS(getPeerListNodeFromPeerListTimerStorageNode)(node));
    }
@@ -142,6 +193,10 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(peerListGetNextPeerListNodeFromTimerStor
 {
    struct STN_CLASSNAME* node = ST_METHOD(GetNext)(&peerList->PeerListTimerStorage,
                                                    &peerListNode->PeerListTimerStorageNode);
+   if((node == NULL) && (ST_CLASS(peerListFetchTimers)(peerList) > 0)) {
+      node = ST_METHOD(GetNext)(&peerList->PeerListTimerStorage,
+                                &peerListNode->PeerListTimerStorageNode);
+   }
    if(node) {
       return(ST_CLASS(getPeerListNodeFromPeerListTimerStorageNode)(node));
    }
@@ -173,11 +228,19 @@ void ST_CLASS(peerListActivateTimer)(
    struct STN_CLASSNAME* result;
 
    CHECK(!STN_METHOD(IsLinked)(&peerListNode->PeerListTimerStorageNode));
+   CHECK(!timingWheelNodeIsLinked(&peerListNode->PeerListTimerWheelNode));
    peerListNode->TimerCode      = timerCode;
    peerListNode->TimerTimeStamp = timerTimeStamp;
-   result = ST_METHOD(Insert)(&peerList->PeerListTimerStorage,
-                              &peerListNode->PeerListTimerStorageNode);
-   CHECK(result == &peerListNode->PeerListTimerStorageNode);
+   if(timingWheelAccepts(&peerList->PeerListTimerWheel, timerTimeStamp)) {
+      timingWheelInsert(&peerList->PeerListTimerWheel,
+                        &peerListNode->PeerListTimerWheelNode,
+                        timerTimeStamp);
+   }
+   else {
+      result = ST_METHOD(Insert)(&peerList->PeerListTimerStorage,
+                                 &peerListNode->PeerListTimerStorageNode);
+      CHECK(result == &peerListNode->PeerListTimerStorageNode);
+   }
 }
 
 
@@ -193,6 +256,10 @@ void ST_CLASS(peerListDeactivateTimer)(
                                  &peerListNode->PeerListTimerStorageNode);
       CHECK(result == &peerListNode->PeerListTimerStorageNode);
    }
+   else if(timingWheelNodeIsLinked(&peerListNode->PeerListTimerWheelNode)) {
+      timingWheelRemove(&peerList->PeerListTimerWheel,
+                        &peerListNode->PeerListTimerWheelNode);
+   }
 }
 
 
@@ -212,6 +279,7 @@ void ST_CLASS(peerListVerify)(struct ST_CLASS(PeerList)* peerList)
 {
    ST_METHOD(Verify)(&peerList->PeerListIndexStorage);
    ST_METHOD(Verify)(&peerList->PeerListTimerStorage);
+   timingWheelVerify(&peerList->PeerListTimerWheel);
 }
 
 
@@ -456,11 +524,7 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(peerListRemovePeerListNode)(
    result = ST_METHOD(Remove)(&peerList->PeerListIndexStorage,
                               &peerListNode->PeerListIndexStorageNode);
    CHECK(result == &peerListNode->PeerListIndexStorageNode);
-   if(STN_METHOD(IsLinked)(&peerListNode->PeerListTimerStorageNode)) {
-      result = ST_METHOD(Remove)(&peerList->PeerListTimerStorage,
-                                 &peerListNode->PeerListTimerStorageNode);
-      CHECK(result == &peerListNode->PeerListTimerStorageNode);
-   }
+   ST_CLASS(peerListDeactivateTimer)(peerList, peerListNode);
 
    peerListNode->OwnerPeerList = NULL;
    return(peerListNode);
@@ -72,6 +72,9 @@ void ST_CLASS(peerListManagementClear)(
         struct ST_CLASS(PeerListManagement)* peerListManagement);
 size_t ST_CLASS(peerListManagementGetPeers)(
           const struct ST_CLASS(PeerListManagement)* peerListManagement);
+void ST_CLASS(peerListManagementGetMemoryUsage)(
+        struct ST_CLASS(PeerListManagement)* peerListManagement,
+        struct HandlespaceMemoryUsage*       memoryUsage);
 
 void ST_CLASS(peerListManagementActivateTimer)(
         struct ST_CLASS(PeerListManagement)* peerListManagement,
@@ -95,6 +98,8 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(peerListManagementGetPrevPeerListNodeFro
 
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListManagementGetFirstPeerListNodeFromTimerStorage)(
                                   struct ST_CLASS(PeerListManagement)* peerListManagement);
+size_t ST_CLASS(peerListManagementFetchAllTimers)(
+          struct ST_CLASS(PeerListManagement)* peerListManagement);
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListManagementGetLastPeerListNodeFromTimerStorage)(
                                   struct ST_CLASS(PeerListManagement)* peerListManagement);
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListManagementGetNextPeerListNodeFromTimerStorage)(
@@ -176,6 +176,35 @@ size_t ST_CLASS(peerListManagementGetPeers)(
 }
 
 
+/* ###### Get memory usage ############################################## */
+void ST_CLASS(peerListManagementGetMemoryUsage)(
+        struct ST_CLASS(PeerListManagement)* peerListManagement,
+        struct HandlespaceMemoryUsage*       memoryUsage)
+{
+   struct ST_CLASS(PeerListNode)* peerListNode;
+
+   handlespaceMemoryUsageClear(memoryUsage);
+   memoryUsage->Nodes = ST_CLASS(peerListGetPeerListNodes)(&peerListManagement->List) *
+                           sizeof(struct ST_CLASS(PeerListNode));
+   if(peerListManagement->NewPeerListNode) {
+      memoryUsage->Nodes += sizeof(struct ST_CLASS(PeerListNode));
+   }
+   memoryUsage->Other = sizeof(struct ST_CLASS(PeerListManagement)) +
+                        ST_METHOD(GetMemoryUsage)(&peerListManagement->List.PeerListIndexStorage) +
+                        ST_METHOD(GetMemoryUsage)(&peerListManagement->List.PeerListTimerStorage);
+
+   peerListNode = ST_CLASS(peerListGetFirstPeerListNodeFromIndexStorage)(&peerListManagement->List);
+   while(peerListNode != NULL) {
+      if(peerListNode->AddressBlock != NULL) {
+         memoryUsage->TransportAddressBlocks +=
+            transportAddressBlockGetSize(peerListNode->AddressBlock->Addresses);
+      }
+      peerListNode = ST_CLASS(peerListGetNextPeerListNodeFromIndexStorage)(&peerListManagement->List,
+                                                                           peerListNode);
+   }
+}
+
+
 /* ###### Get first PeerListNode from Index ############################## */
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListManagementGetFirstPeerListNodeFromIndexStorage)(
                                   struct ST_CLASS(PeerListManagement)* peerListManagement)
@@ -218,6 +247,14 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(peerListManagementGetFirstPeerListNodeFr
 }
 
 
+/* ###### Move all timers into sorted timer storage ##################### */
+size_t ST_CLASS(peerListManagementFetchAllTimers)(
+          struct ST_CLASS(PeerListManagement)* peerListManagement)
+{
+   return(ST_CLASS(peerListFetchAllTimers)(&peerListManagement->List));
+}
+
+
 /* ###### Get last PeerListNode from Timer ############################### */
 struct ST_CLASS(PeerListNode)* ST_CLASS(peerListManagementGetLastPeerListNodeFromTimerStorage)(
                                   struct ST_CLASS(PeerListManagement)* peerListManagement)
@@ -422,10 +459,8 @@ unsigned int ST_CLASS(peerListManagementDeregisterPeerListNodeByPtr)(
    unsigned int errorCode;
    void*        userDataBackup;
 
-   if(STN_METHOD(IsLinked)(&peerListNode->PeerListTimerStorageNode)) {
-      ST_CLASS(peerListDeactivateTimer)(&peerListManagement->List,
-                                        peerListNode);
-   }
+   ST_CLASS(peerListDeactivateTimer)(&peerListManagement->List,
+                                     peerListNode);
 
    /* Check, if a static entry with ID should be turned into ID-less entry only */
    if((!(peerListNode->Flags & PLNF_DYNAMIC)) &&
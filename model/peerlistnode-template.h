@@ -61,6 +61,7 @@ struct ST_CLASS(PeerListNode)
 {
    struct STN_CLASSNAME               PeerListIndexStorageNode;
    struct STN_CLASSNAME               PeerListTimerStorageNode;
+   struct TimingWheelNode             PeerListTimerWheelNode;
    struct ST_CLASS(PeerList)*         OwnerPeerList;
 
    RegistrarIdentifierType            Identifier;
@@ -89,6 +90,7 @@ int ST_CLASS(peerListTimerStorageNodeComparison)(const void* nodePtr1, const voi
 
 struct ST_CLASS(PeerListNode)* ST_CLASS(getPeerListNodeFromPeerListIndexStorageNode)(void* node);
 struct ST_CLASS(PeerListNode)* ST_CLASS(getPeerListNodeFromPeerListTimerStorageNode)(void* node);
+struct ST_CLASS(PeerListNode)* ST_CLASS(getPeerListNodeFromPeerListTimerWheelNode)(void* node);
 
 void ST_CLASS(peerListNodeNew)(struct ST_CLASS(PeerListNode)* peerListNode,
                                const RegistrarIdentifierType  identifier,
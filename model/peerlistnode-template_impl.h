@@ -111,6 +111,7 @@ void ST_CLASS(peerListNodeNew)(struct ST_CLASS(PeerListNode)* peerListNode,
 {
    STN_METHOD(New)(&peerListNode->PeerListIndexStorageNode);
    STN_METHOD(New)(&peerListNode->PeerListTimerStorageNode);
+   timingWheelNodeNew(&peerListNode->PeerListTimerWheelNode);
 
    peerListNode->OwnerPeerList       = NULL;
 
@@ -136,6 +137,7 @@ void ST_CLASS(peerListNodeDelete)(struct ST_CLASS(PeerListNode)* peerListNode)
 {
    CHECK(!STN_METHOD(IsLinked)(&peerListNode->PeerListIndexStorageNode));
    CHECK(!STN_METHOD(IsLinked)(&peerListNode->PeerListTimerStorageNode));
+   timingWheelNodeDelete(&peerListNode->PeerListTimerWheelNode);
 
    peerListNode->Flags               = 0;
    peerListNode->LastUpdateTimeStamp = 0;
@@ -164,6 +166,15 @@ struct ST_CLASS(PeerListNode)* ST_CLASS(getPeerListNodeFromPeerListTimerStorageN
 }
 
 
+/* ###### Get PeerListNode from given Timer Wheel Node ################### */
+struct ST_CLASS(PeerListNode)* ST_CLASS(getPeerListNodeFromPeerListTimerWheelNode)(void* node)
+{
+   const struct ST_CLASS(PeerListNode)* dummy = (struct ST_CLASS(PeerListNode)*)node;
+   long n = (long)node - ((long)&dummy->PeerListTimerWheelNode - (long)dummy);
+   return((struct ST_CLASS(PeerListNode)*)n);
+}
+
+
 /* ###### Update ######################################################### */
 int ST_CLASS(peerListNodeUpdate)(struct ST_CLASS(PeerListNode)*       peerListNode,
                                  const struct ST_CLASS(PeerListNode)* source)
@@ -30,6 +30,7 @@
 
 #include "utilities.h"
 #include "messages_m.h"
+#include "handlespacemanagementwrapper.h"
 
 
 class PoolElementASAPProcess : public cSimpleModule
@@ -92,7 +93,7 @@ class PoolElementASAPProcess : public cSimpleModule
 
    // ====== Variables =======================================================
    unsigned int          LocalPort;
-   opp_string            PoolHandle;
+   unsigned int          PoolHandleID;
    cPoolElementParameter PoolElement;
    unsigned int          HomeRegistrarAddress;
    unsigned int          RegistrationAttempts;
@@ -115,6 +116,7 @@ void PoolElementASAPProcess::initialize()
    State.setName("State");
 
    LocalPort                     = PoolElementASAPPortStart;
+   PoolHandleID                  = 0;
    HomeRegistrarAddress          = 0;
    RegistrationAttempts          = 0;
    HasSentRegisterPoolElementAck = false;
@@ -140,7 +142,7 @@ void PoolElementASAPProcess::sendASAPRegistration()
    registration->setDstAddress(HomeRegistrarAddress);
    registration->setSrcPort(LocalPort);
    registration->setDstPort(RegistrarPort);
-   registration->setPoolHandle(PoolHandle.c_str());
+   registration->setPoolHandleID(PoolHandleID);
    registration->setPoolElementParameter(PoolElement);
 
    registration->setTimestamp(simTime());
@@ -156,7 +158,7 @@ void PoolElementASAPProcess::sendASAPDeregistration()
    deregistration->setDstAddress(HomeRegistrarAddress);
    deregistration->setSrcPort(LocalPort);
    deregistration->setDstPort(RegistrarPort);
-   deregistration->setPoolHandle(PoolHandle.c_str());
+   deregistration->setPoolHandleID(PoolHandleID);
    deregistration->setIdentifier(PoolElement.getIdentifier());
 
    deregistration->setTimestamp(simTime());
@@ -167,8 +169,7 @@ void PoolElementASAPProcess::sendASAPDeregistration()
 // ###### Handle ASAP_REGISTRATION_RESPONSE #################################
 bool PoolElementASAPProcess::handleASAPRegistrationResponse(ASAPRegistrationResponse* msg)
 {
-   const int cmpResult = opp_strcmp(msg->getPoolHandle(), PoolHandle.c_str());
-   if(cmpResult != 0) {
+   if(getMessagePoolHandleID(msg) != PoolHandleID) {
       error("ASAP_REGISTRATION_RESPONSE for unexpected pool handle!");
       return(false);
    }
@@ -184,8 +185,7 @@ bool PoolElementASAPProcess::handleASAPRegistrationResponse(ASAPRegistrationResp
 // ###### Handle ASAP_DEREGISTRATION_RESPONSE ###############################
 bool PoolElementASAPProcess::handleASAPDeregistrationResponse(ASAPDeregistrationResponse* msg)
 {
-   const int cmpResult = opp_strcmp(msg->getPoolHandle(), PoolHandle.c_str());
-   if(cmpResult != 0) {
+   if(getMessagePoolHandleID(msg) != PoolHandleID) {
       error("ASAP_DEREGISTRATION_RESPONSE for unexpected pool handle!");
       return(false);
    }
@@ -201,8 +201,7 @@ bool PoolElementASAPProcess::handleASAPDeregistrationResponse(ASAPDeregistration
 // ###### Handle ASAP_ENDPOINT_KEEP_ALIVE ###################################
 void PoolElementASAPProcess::handleASAPEndpointKeepAlive(ASAPEndpointKeepAlive* msg)
 {
-   const int cmpResult = opp_strcmp(msg->getPoolHandle(), PoolHandle.c_str());
-   if(cmpResult != 0) {
+   if(getMessagePoolHandleID(msg) != PoolHandleID) {
       error("ASAP_ENDPOINT_KEEP_ALIVE for unexpected pool handle!");
       return;
    }
@@ -219,7 +218,7 @@ void PoolElementASAPProcess::handleASAPEndpointKeepAlive(ASAPEndpointKeepAlive*
    endpointKeepAliveAck->setDstAddress(msg->getSrcAddress());
    endpointKeepAliveAck->setSrcPort(LocalPort);
    endpointKeepAliveAck->setDstPort(msg->getSrcPort());
-   endpointKeepAliveAck->setPoolHandle(PoolHandle.c_str());
+   endpointKeepAliveAck->setPoolHandleID(PoolHandleID);
    endpointKeepAliveAck->setIdentifier(PoolElement.getIdentifier());
 
    endpointKeepAliveAck->setTimestamp(simTime());
@@ -304,8 +303,8 @@ void PoolElementASAPProcess::updatePoolPolicy(PolicyUpdate* msg)
 // ###### Update pool element information ###################################
 void PoolElementASAPProcess::updatePoolElementParameter(RegisterPoolElement* msg)
 {
-   PoolHandle  = opp_string(msg->getPoolHandle());
-   PoolElement = msg->getPoolElementParameter();
+   PoolHandleID = getPoolHandleID(msg->getPoolHandle());
+   PoolElement  = msg->getPoolElementParameter();
 }
 
 
@@ -51,30 +51,55 @@ extern "C" {
 
 
 /* ====== Pool Element Node ============================================== */
+/*
+   Alignment of the pool element nodes allocated by the handlespace
+   management (0 for the allocator's default). With the cache line size
+   here (e.g. -DPOOLELEMENTNODE_ALIGNMENT=64), the hot record at the start
+   of the node occupies exactly one cache line, at the cost of some
+   padding per node.
+*/
+#ifndef POOLELEMENTNODE_ALIGNMENT
+#define POOLELEMENTNODE_ALIGNMENT 0
+#endif
+
 struct ST_CLASS(PoolNode);
 
 struct ST_CLASS(PoolElementNode)
 {
+   /* ====== Hot record: fields used by selection and the policies' ===== */
+   /* ======             comparisons                                ===== */
+   /* Identifier ... SelectionCounter take 64 bytes on LP64 platforms,
+      i.e. one cache line. Keep them together, at the start of the node. */
+   PoolElementIdentifierType          Identifier;
+   PoolElementSeqNumberType           SeqNumber;
+   PoolElementSeqNumberType           RoundCounter;
+   unsigned int                       VirtualCounter;
+   unsigned int                       Degradation;
+   struct PoolPolicySettings          PolicySettings;
+   struct ST_CLASS(PoolNode)*         OwnerPoolNode;
+   unsigned long long                 SelectionCounter;
+
+   /* ====== Selection storage ========================================== */
    struct STN_CLASSNAME               PoolElementSelectionStorageNode;
+   struct BucketQueueNode             PoolElementSelectionBucketNode;   /* Instead of the storage node, see PoolNode */
+   size_t                             SelectionIndexPosition;
+
+   /* ====== Other fields =============================================== */
    struct STN_CLASSNAME               PoolElementIndexStorageNode;
    struct STN_CLASSNAME               PoolElementTimerStorageNode;
+   struct TimingWheelNode             PoolElementTimerWheelNode;
    struct STN_CLASSNAME               PoolElementConnectionStorageNode;
    struct STN_CLASSNAME               PoolElementOwnershipStorageNode;
-   struct ST_CLASS(PoolNode)*         OwnerPoolNode;
+   struct DoubleLinkedRingListNode    PoolElementGenerationListNode;
+   struct DoubleLinkedRingListNode    PoolElementModificationListNode;
 
-   PoolElementIdentifierType          Identifier;
    HandlespaceChecksumAccumulatorType Checksum;
    RegistrarIdentifierType            HomeRegistrarIdentifier;
    unsigned int                       RegistrationLife;
-   struct PoolPolicySettings          PolicySettings;
    unsigned int                       Flags;
-
-   PoolElementSeqNumberType           SeqNumber;
-   PoolElementSeqNumberType           RoundCounter;
-   unsigned int                       VirtualCounter;
-   unsigned int                       Degradation;
+   unsigned int                       Generation;
+   unsigned long long                 ModificationSequence;    /* Handlespace version of last change */
    unsigned int                       UnreachabilityReports;
-   unsigned long long                 SelectionCounter;
    unsigned long long                 LastUpdateTimeStamp;
 
    unsigned int                       TimerCode;
@@ -115,14 +140,23 @@ HandlespaceChecksumAccumulatorType ST_CLASS(poolElementNodeComputeChecksum)(
 int ST_CLASS(poolElementNodeUpdate)(struct ST_CLASS(PoolElementNode)*       poolElementNode,
                                     const struct ST_CLASS(PoolElementNode)* source);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromPoolElementSelectionStorageNode)(void* node);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromPoolElementSelectionBucketNode)(struct BucketQueueNode* node);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromPoolElementIndexStorageNode)(void* node);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromTimerStorageNode)(void* node);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromTimerWheelNode)(void* node);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromOwnershipStorageNode)(void* node);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromConnectionStorageNode)(void* node);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromGenerationListNode)(void* node);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromModificationListNode)(void* node);
+void ST_CLASS(poolElementSelectionStorageNodePrint)(const void* nodePtr, FILE* fd);
+int ST_CLASS(poolElementSelectionStorageNodeComparison)(const void* nodePtr1, const void* nodePtr2);
 void ST_CLASS(poolElementTimerStorageNodePrint)(const void* nodePtr, FILE* fd);
 int ST_CLASS(poolElementTimerStorageNodeComparison)(const void* nodePtr1, const void* nodePtr2);
 void ST_CLASS(poolElementOwnershipStorageNodePrint)(const void* nodePtr, FILE* fd);
 int ST_CLASS(poolElementOwnershipStorageNodeComparison)(const void* nodePtr1, const void* nodePtr2);
+void ST_CLASS(poolElementStorageInsertNodes)(struct ST_CLASSNAME*   storage,
+                                             struct STN_CLASSNAME** nodeArray,
+                                             const size_t           nodes);
 
 
 #ifdef __cplusplus
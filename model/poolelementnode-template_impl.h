@@ -38,10 +38,14 @@ void ST_CLASS(poolElementNodeNew)(struct ST_CLASS(PoolElementNode)* poolElementN
                                   const sctp_assoc_t                connectionAssocID)
 {
    STN_METHOD(New)(&poolElementNode->PoolElementSelectionStorageNode);
+   bucketQueueNodeNew(&poolElementNode->PoolElementSelectionBucketNode);
    STN_METHOD(New)(&poolElementNode->PoolElementIndexStorageNode);
    STN_METHOD(New)(&poolElementNode->PoolElementTimerStorageNode);
+   timingWheelNodeNew(&poolElementNode->PoolElementTimerWheelNode);
    STN_METHOD(New)(&poolElementNode->PoolElementConnectionStorageNode);
    STN_METHOD(New)(&poolElementNode->PoolElementOwnershipStorageNode);
+   doubleLinkedRingListNodeNew(&poolElementNode->PoolElementGenerationListNode);
+   doubleLinkedRingListNodeNew(&poolElementNode->PoolElementModificationListNode);
 
    poolElementNode->OwnerPoolNode              = NULL;
 
@@ -51,11 +55,14 @@ void ST_CLASS(poolElementNodeNew)(struct ST_CLASS(PoolElementNode)* poolElementN
    poolElementNode->RegistrationLife           = registrationLife;
    poolElementNode->PolicySettings             = *pps;
    poolElementNode->Flags                      = 0;
+   poolElementNode->Generation                 = 0;
+   poolElementNode->ModificationSequence       = 0;
 
    poolElementNode->SeqNumber                  = 0;
    poolElementNode->RoundCounter               = 0;
    poolElementNode->VirtualCounter             = 0;
    poolElementNode->SelectionCounter           = 0;
+   poolElementNode->SelectionIndexPosition     = 0;
    poolElementNode->Degradation                = 0;
    poolElementNode->UnreachabilityReports      = 0;
 
@@ -81,8 +88,11 @@ void ST_CLASS(poolElementNodeDelete)(struct ST_CLASS(PoolElementNode)* poolEleme
    CHECK(!STN_METHOD(IsLinked)(&poolElementNode->PoolElementSelectionStorageNode));
    CHECK(!STN_METHOD(IsLinked)(&poolElementNode->PoolElementIndexStorageNode));
    CHECK(!STN_METHOD(IsLinked)(&poolElementNode->PoolElementTimerStorageNode));
+   CHECK(!timingWheelNodeIsLinked(&poolElementNode->PoolElementTimerWheelNode));
    CHECK(!STN_METHOD(IsLinked)(&poolElementNode->PoolElementOwnershipStorageNode));
    CHECK(!STN_METHOD(IsLinked)(&poolElementNode->PoolElementConnectionStorageNode));
+   CHECK(poolElementNode->PoolElementGenerationListNode.Next == NULL);
+   CHECK(poolElementNode->PoolElementModificationListNode.Next == NULL);
 
    poolElementNode->Checksum                    = 0;
    poolElementNode->RegistrationLife            = 0;
@@ -104,8 +114,10 @@ void ST_CLASS(poolElementNodeDelete)(struct ST_CLASS(PoolElementNode)* poolEleme
 
    STN_METHOD(Delete)(&poolElementNode->PoolElementConnectionStorageNode);
    STN_METHOD(Delete)(&poolElementNode->PoolElementOwnershipStorageNode);
+   timingWheelNodeDelete(&poolElementNode->PoolElementTimerWheelNode);
    STN_METHOD(Delete)(&poolElementNode->PoolElementTimerStorageNode);
    STN_METHOD(Delete)(&poolElementNode->PoolElementIndexStorageNode);
+   bucketQueueNodeDelete(&poolElementNode->PoolElementSelectionBucketNode);
    STN_METHOD(Delete)(&poolElementNode->PoolElementSelectionStorageNode);
    poolPolicySettingsDelete(&poolElementNode->PolicySettings);
 }
@@ -118,9 +130,20 @@ void ST_CLASS(poolElementNodeGetDescription)(
         const size_t                            bufferSize,
         const unsigned int                      fields)
 {
-   char tmp[536];
-   char poolPolicySettingsDescription[512];
-   char transportAddressDescription[1024];
+   const struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration = NULL;
+   char                                               tmp[536];
+   char                                               poolPolicySettingsDescription[512];
+   char                                               transportAddressDescription[1024];
+
+   /* A PE in its owner's generation list is marked while its generation
+      differs from the owner's; otherwise, PENF_MARKED is used. */
+   if( (poolElementNode->PoolElementGenerationListNode.Next != NULL) &&
+       (poolElementNode->OwnerPoolNode != NULL) &&
+       (poolElementNode->OwnerPoolNode->OwnerPoolHandlespaceNode != NULL) ) {
+      ownerGeneration = (const struct ST_CLASS(PoolElementOwnerGeneration)*)identifierHashTableFind(
+                           &poolElementNode->OwnerPoolNode->OwnerPoolHandlespaceNode->OwnerGenerationIndex,
+                           poolElementNode->HomeRegistrarIdentifier);
+   }
 
    snprintf(buffer, bufferSize, "$%08x flags=", poolElementNode->Identifier);
    if(poolElementNode->Flags & PENF_NEW) {
@@ -129,7 +152,8 @@ void ST_CLASS(poolElementNodeGetDescription)(
    if(poolElementNode->Flags & PENF_UPDATED) {
       safestrcat(buffer, "[updated]", bufferSize);
    }
-   if(poolElementNode->Flags & PENF_MARKED) {
+   if( (poolElementNode->Flags & PENF_MARKED) ||
+       ((ownerGeneration != NULL) && (poolElementNode->Generation != ownerGeneration->Generation)) ) {
       safestrcat(buffer, "[marked]", bufferSize);
    }
    if(fields & (PENPO_CONNECTION|PENPO_CHECKSUM|PENPO_HOME_PR|PENPO_REGLIFE|PENPO_UR_REPORTS|PENPO_LASTUPDATE)) {
@@ -177,7 +201,7 @@ void ST_CLASS(poolElementNodeGetDescription)(
    if(fields & PENPO_POLICYSTATE) {
       snprintf((char*)&tmp, sizeof(tmp), "\n     seq=%llu val=%llu rd=%u vrt=%u deg=$%x {sel=%llu s/w=%1.1f}",
                (unsigned long long)poolElementNode->SeqNumber,
-               poolElementNode->PoolElementSelectionStorageNode.Value,
+               (unsigned long long)poolElementNode->PoolElementSelectionStorageNode.Value,
                poolElementNode->RoundCounter,
                poolElementNode->VirtualCounter,
                poolElementNode->Degradation,
@@ -223,12 +247,10 @@ void ST_CLASS(poolElementNodePrint)(
 HandlespaceChecksumAccumulatorType ST_CLASS(poolElementNodeComputeChecksum)(
                                       const struct ST_CLASS(PoolElementNode)* poolElementNode)
 {
-   HandlespaceChecksumAccumulatorType checksum   = INITIAL_HANDLESPACE_CHECKSUM;
+   HandlespaceChecksumAccumulatorType checksum   = poolElementNode->OwnerPoolNode->HandleChecksum;
    PoolElementIdentifierType          identifier = htonl(poolElementNode->Identifier);
 
-   checksum = handlespaceChecksumCompute(checksum,
-                                         (const char*)&poolElementNode->OwnerPoolNode->Handle.Handle,
-                                         poolElementNode->OwnerPoolNode->Handle.Size);
+   /* The pool handle's part is precomputed by poolNodeNew(). */
    checksum = handlespaceChecksumCompute(checksum,
                                          (const char*)&identifier,
                                          sizeof(identifier));
@@ -432,6 +454,20 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromPoolElementSele
 }
 
 
+/* ###### Get PoolElementNode from given Selection Bucket Node ########### */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromPoolElementSelectionBucketNode)(struct BucketQueueNode* node)
+{
+   const struct ST_CLASS(PoolElementNode)* dummy = (struct ST_CLASS(PoolElementNode)*)node;
+   long n;
+
+   if(node == NULL) {
+      return(NULL);
+   }
+   n = (long)node - ((long)&dummy->PoolElementSelectionBucketNode - (long)dummy);
+   return((struct ST_CLASS(PoolElementNode)*)n);
+}
+
+
 /* ###### Get PoolElementNode from given Index Node ###################### */
 struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromPoolElementIndexStorageNode)(void* node)
 {
@@ -450,6 +486,15 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromTimerStorageNod
 }
 
 
+/* ###### Get PoolElementNode from given Timer Wheel Node ################ */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromTimerWheelNode)(void* node)
+{
+   const struct ST_CLASS(PoolElementNode)* dummy = (struct ST_CLASS(PoolElementNode)*)node;
+   long n = (long)node - ((long)&dummy->PoolElementTimerWheelNode - (long)dummy);
+   return((struct ST_CLASS(PoolElementNode)*)n);
+}
+
+
 /* ###### Get PoolElementNode from given Ownership Node ################### */
 struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromOwnershipStorageNode)(void* node)
 {
@@ -466,3 +511,141 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromConnectionStora
    long n = (long)node - ((long)&dummy->PoolElementConnectionStorageNode - (long)dummy);
    return((struct ST_CLASS(PoolElementNode)*)n);
 }
+
+
+/* ###### Get PoolElementNode from given Generation List Node ############# */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromGenerationListNode)(void* node)
+{
+   const struct ST_CLASS(PoolElementNode)* dummy = (struct ST_CLASS(PoolElementNode)*)node;
+   long n = (long)node - ((long)&dummy->PoolElementGenerationListNode - (long)dummy);
+   return((struct ST_CLASS(PoolElementNode)*)n);
+}
+
+
+/* ###### Get PoolElementNode from given Modification List Node ########### */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(getPoolElementNodeFromModificationListNode)(void* node)
+{
+   const struct ST_CLASS(PoolElementNode)* dummy = (struct ST_CLASS(PoolElementNode)*)node;
+   long n = (long)node - ((long)&dummy->PoolElementModificationListNode - (long)dummy);
+   return((struct ST_CLASS(PoolElementNode)*)n);
+}
+
+
+/* ###### Sort storage nodes by storage's comparison function ############ */
+static void ST_CLASS(poolElementStorageSortNodes)(
+               const struct ST_CLASSNAME* storage,
+               struct STN_CLASSNAME**     nodeArray,
+               struct STN_CLASSNAME**     buffer,
+               const size_t               nodes)
+{
+   struct STN_CLASSNAME** from = nodeArray;
+   struct STN_CLASSNAME** to   = buffer;
+   struct STN_CLASSNAME** swap;
+   size_t                 width, left, middle, right;
+   size_t                 i, j, k;
+
+   /* ====== Input usually is already sorted ============================= */
+   for(i = 1;i < nodes;i++) {
+      if(storage->ComparisonFunction(nodeArray[i - 1], nodeArray[i]) > 0) {
+         break;
+      }
+   }
+   if(i >= nodes) {
+      return;
+   }
+
+   /* ====== Bottom-up merge sort ======================================== */
+   for(width = 1;width < nodes;width *= 2) {
+      for(left = 0;left < nodes;left += 2 * width) {
+         middle = (left + width < nodes) ? (left + width) : nodes;
+         right  = (left + 2 * width < nodes) ? (left + 2 * width) : nodes;
+         i = left;
+         j = middle;
+         k = left;
+         while((i < middle) && (j < right)) {
+            if(storage->ComparisonFunction(from[j], from[i]) < 0) {
+               to[k++] = from[j++];
+            }
+            else {
+               to[k++] = from[i++];
+            }
+         }
+         while(i < middle) {
+            to[k++] = from[i++];
+         }
+         while(j < right) {
+            to[k++] = from[j++];
+         }
+      }
+      swap = from;
+      from = to;
+      to   = swap;
+   }
+   if(from != nodeArray) {
+      memcpy(nodeArray, from, nodes * sizeof(struct STN_CLASSNAME*));
+   }
+}
+
+
+/* ###### Insert multiple nodes into storage ############################# */
+/*
+   The nodes must not be linked yet and their keys must be unique within
+   the storage. If inserting them one by one (O(nodes * log(elements)))
+   is more expensive than a rebuild (O(elements + nodes)), they are sorted
+   and merged with the storage content, and the storage is rebuilt from
+   the merged sequence. nodeArray may be reordered.
+*/
+void ST_CLASS(poolElementStorageInsertNodes)(struct ST_CLASSNAME*   storage,
+                                             struct STN_CLASSNAME** nodeArray,
+                                             const size_t           nodes)
+{
+   const size_t           elements   = ST_METHOD(GetElements)(storage);
+   struct STN_CLASSNAME** mergeArray = NULL;
+   struct STN_CLASSNAME*  node;
+   struct STN_CLASSNAME*  result;
+   size_t                 depth;
+   size_t                 i, k;
+
+   depth = 0;
+   for(i = elements + nodes;i > 0;i >>= 1) {
+      depth++;
+   }
+   if((nodes > 1) && (nodes * depth >= elements + nodes)) {
+      mergeArray = (struct STN_CLASSNAME**)malloc((elements + 2 * nodes) * sizeof(struct STN_CLASSNAME*));
+   }
+
+   /* ====== Insert nodes one by one ===================================== */
+   if(mergeArray == NULL) {
+      for(i = 0;i < nodes;i++) {
+         result = ST_METHOD(Insert)(storage, nodeArray[i]);
+         CHECK(result == nodeArray[i]);
+      }
+      return;
+   }
+
+   /* ====== Merge sorted nodes with storage content and rebuild ========= */
+   ST_CLASS(poolElementStorageSortNodes)(storage, nodeArray, &mergeArray[elements + nodes], nodes);
+   node = ST_METHOD(GetFirst)(storage);
+   i    = 0;
+   k    = 0;
+   while((node != NULL) && (i < nodes)) {
+      if(storage->ComparisonFunction(node, nodeArray[i]) < 0) {
+         mergeArray[k++] = node;
+         node = ST_METHOD(GetNext)(storage, node);
+      }
+      else {
+         CHECK(storage->ComparisonFunction(node, nodeArray[i]) != 0);
+         mergeArray[k++] = nodeArray[i++];
+      }
+   }
+   while(node != NULL) {
+      mergeArray[k++] = node;
+      node = ST_METHOD(GetNext)(storage, node);
+   }
+   while(i < nodes) {
+      mergeArray[k++] = nodeArray[i++];
+   }
+   CHECK(k == elements + nodes);
+   ST_METHOD(Build)(storage, mergeArray, k);
+   free(mergeArray);
+}
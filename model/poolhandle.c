@@ -30,6 +30,8 @@
 #include "debug.h"
 #include "stringutilities.h"
 
+#include <pthread.h>
+
 
 /* ###### Initialize ##################################################### */
 void poolHandleNew(struct PoolHandle*   poolHandle,
@@ -38,7 +40,8 @@ void poolHandleNew(struct PoolHandle*   poolHandle,
 {
    CHECK(size > 0);
    CHECK(size <= MAX_POOLHANDLESIZE);
-   poolHandle->Size = size;
+   poolHandle->Size       = size;
+   poolHandle->Identifier = 0;
    memcpy(&poolHandle->Handle, handle, size);
 }
 
@@ -88,6 +91,10 @@ void poolHandlePrint(const struct PoolHandle* poolHandle,
 int poolHandleComparison(const struct PoolHandle* poolHandle1,
                          const struct PoolHandle* poolHandle2)
 {
+   if( (poolHandle1->Identifier == poolHandle2->Identifier) &&
+       (poolHandle1->Identifier != 0) ) {
+      return(0);
+   }
    if(poolHandle1->Size < poolHandle2->Size) {
       return(-1);
    }
@@ -97,3 +104,166 @@ int poolHandleComparison(const struct PoolHandle* poolHandle1,
    return(memcmp(poolHandle1->Handle, poolHandle2->Handle,
                  poolHandle1->Size));
 }
+
+
+/*
+   Interned pool handles: the handle with identifier i is
+   InternedPoolHandleArray[i - 1]. The hash slots contain identifiers
+   (0 for a free slot), using open addressing with linear probing.
+   The table is shared by all handlespaces of the process, i.e. also by
+   the shards of a sharded handlespace and by threads resolving handles.
+   Therefore, InternLock protects all of its variables.
+*/
+static pthread_mutex_t           InternLock                  = PTHREAD_MUTEX_INITIALIZER;
+static struct PoolHandle**       InternedPoolHandleArray     = NULL;
+static uint32_t*                 InternedPoolHandleHashArray = NULL;
+static size_t                    InternedPoolHandles         = 0;
+static size_t                    InternedPoolHandleCapacity  = 0;
+static PoolHandleIdentifierType* InternSlotArray             = NULL;
+static size_t                    InternSlots                 = 0;
+
+
+/* ###### Compute hash of pool handle (FNV-1a) ########################### */
+static uint32_t poolHandleComputeHash(const unsigned char* handle,
+                                      const size_t         size)
+{
+   uint32_t hash = 2166136261U;
+   size_t   i;
+
+   for(i = 0;i < size;i++) {
+      hash ^= handle[i];
+      hash *= 16777619U;
+   }
+   return(hash);
+}
+
+
+/* ###### Store identifier into its first free hash slot ################# */
+static void poolHandleInternPlace(const PoolHandleIdentifierType identifier)
+{
+   size_t i;
+
+   for(i = InternedPoolHandleHashArray[identifier - 1] & (InternSlots - 1);
+       InternSlotArray[i] != 0;
+       i = (i + 1) & (InternSlots - 1)) {
+   }
+   InternSlotArray[i] = identifier;
+}
+
+
+/* ###### Get interned copy of pool handle, with InternLock held ######## */
+static const struct PoolHandle* poolHandleInternLocked(const unsigned char* handle,
+                                                       const size_t         size)
+{
+   const uint32_t            hash = poolHandleComputeHash(handle, size);
+   struct PoolHandle*        interned;
+   struct PoolHandle**       newPoolHandleArray;
+   uint32_t*                 newHashArray;
+   PoolHandleIdentifierType* newSlotArray;
+   PoolHandleIdentifierType  identifier;
+   size_t                    newCapacity;
+   size_t                    i;
+
+   /* ====== Look up handle =============================================== */
+   if(InternSlots > 0) {
+      for(i = hash & (InternSlots - 1);InternSlotArray[i] != 0;i = (i + 1) & (InternSlots - 1)) {
+         identifier = InternSlotArray[i];
+         interned   = InternedPoolHandleArray[identifier - 1];
+         if( (InternedPoolHandleHashArray[identifier - 1] == hash) &&
+             (interned->Size == size) &&
+             (memcmp(interned->Handle, handle, size) == 0) ) {
+            return(interned);
+         }
+      }
+   }
+
+   /* ====== Make room for new handle ===================================== */
+   if(InternedPoolHandles >= InternedPoolHandleCapacity) {
+      newCapacity = (InternedPoolHandleCapacity > 0) ? (2 * InternedPoolHandleCapacity) : 64;
+      newPoolHandleArray = (struct PoolHandle**)realloc(InternedPoolHandleArray,
+                                                        newCapacity * sizeof(struct PoolHandle*));
+      if(newPoolHandleArray == NULL) {
+         return(NULL);
+      }
+      InternedPoolHandleArray = newPoolHandleArray;
+      newHashArray = (uint32_t*)realloc(InternedPoolHandleHashArray,
+                                        newCapacity * sizeof(uint32_t));
+      if(newHashArray == NULL) {
+         return(NULL);
+      }
+      InternedPoolHandleHashArray = newHashArray;
+      InternedPoolHandleCapacity  = newCapacity;
+   }
+   if(2 * (InternedPoolHandles + 1) > InternSlots) {
+      newCapacity  = (InternSlots > 0) ? (2 * InternSlots) : 128;
+      newSlotArray = (PoolHandleIdentifierType*)calloc(newCapacity, sizeof(PoolHandleIdentifierType));
+      if(newSlotArray == NULL) {
+         return(NULL);
+      }
+      free(InternSlotArray);
+      InternSlotArray = newSlotArray;
+      InternSlots     = newCapacity;
+      for(i = 0;i < InternedPoolHandles;i++) {
+         poolHandleInternPlace((PoolHandleIdentifierType)(i + 1));
+      }
+   }
+   interned = (struct PoolHandle*)malloc(sizeof(struct PoolHandle));
+   if(interned == NULL) {
+      return(NULL);
+   }
+
+   /* ====== Add new handle =============================================== */
+   poolHandleNew(interned, handle, size);
+   interned->Identifier = (PoolHandleIdentifierType)(InternedPoolHandles + 1);
+   InternedPoolHandleArray[InternedPoolHandles]     = interned;
+   InternedPoolHandleHashArray[InternedPoolHandles] = hash;
+   InternedPoolHandles++;
+   poolHandleInternPlace(interned->Identifier);
+   return(interned);
+}
+
+
+/* ###### Get interned copy of pool handle ############################### */
+/*
+   Returns NULL, if a new handle cannot be interned due to lack of memory.
+*/
+const struct PoolHandle* poolHandleIntern(const unsigned char* handle,
+                                          const size_t         size)
+{
+   const struct PoolHandle* interned;
+
+   CHECK(size > 0);
+   CHECK(size <= MAX_POOLHANDLESIZE);
+
+   pthread_mutex_lock(&InternLock);
+   interned = poolHandleInternLocked(handle, size);
+   pthread_mutex_unlock(&InternLock);
+   return(interned);
+}
+
+
+/* ###### Get interned pool handle by identifier ######################### */
+const struct PoolHandle* poolHandleGetInterned(const PoolHandleIdentifierType identifier)
+{
+   const struct PoolHandle* interned = NULL;
+
+   pthread_mutex_lock(&InternLock);
+   if((identifier >= 1) && (identifier <= InternedPoolHandles)) {
+      interned = InternedPoolHandleArray[identifier - 1];
+   }
+   pthread_mutex_unlock(&InternLock);
+   return(interned);
+}
+
+
+/* ###### Get identifier of pool handle, interning it if necessary ####### */
+PoolHandleIdentifierType poolHandleGetIdentifier(const struct PoolHandle* poolHandle)
+{
+   const struct PoolHandle* interned;
+
+   if(poolHandle->Identifier != 0) {
+      return(poolHandle->Identifier);
+   }
+   interned = poolHandleIntern(poolHandle->Handle, poolHandle->Size);
+   return((interned != NULL) ? interned->Identifier : 0);
+}
@@ -31,6 +31,7 @@
 
 #include <ctype.h>
 #include <stdio.h>
+#include <stdint.h>
 
 
 #ifdef __cplusplus
@@ -40,10 +41,13 @@ extern "C" {
 
 #define MAX_POOLHANDLESIZE 32
 
+typedef uint32_t PoolHandleIdentifierType;
+
 struct PoolHandle
 {
-   size_t        Size;
-   unsigned char Handle[MAX_POOLHANDLESIZE];
+   size_t                   Size;
+   unsigned char            Handle[MAX_POOLHANDLESIZE];
+   PoolHandleIdentifierType Identifier;   /* Interned handle's ID, or 0 */
 };
 
 
@@ -59,6 +63,19 @@ void poolHandlePrint(const struct PoolHandle* poolHandle,
 int poolHandleComparison(const struct PoolHandle* poolHandle1,
                          const struct PoolHandle* poolHandle2);
 
+/*
+   Pool handle interning: each distinct pool handle gets a stable, small
+   identifier (1, 2, ...) and a single interned copy, which is never
+   removed. Handles carrying their identifier can be looked up by a hash
+   probe instead of comparing the handle bytes. The intern table is
+   process-global and protected by a mutex, i.e. these functions may be
+   called from any thread. The interned copies are immutable.
+*/
+const struct PoolHandle* poolHandleIntern(const unsigned char* handle,
+                                          const size_t         size);
+const struct PoolHandle* poolHandleGetInterned(const PoolHandleIdentifierType identifier);
+PoolHandleIdentifierType poolHandleGetIdentifier(const struct PoolHandle* poolHandle);
+
 
 #ifdef __cplusplus
 }
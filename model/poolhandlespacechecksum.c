@@ -29,6 +29,10 @@
 #include "poolhandlespacechecksum.h"
 #include "debug.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 
 /* ###### Add checksums a and b ########################################## */
 HandlespaceChecksumAccumulatorType handlespaceChecksumAdd(const HandlespaceChecksumAccumulatorType a,
@@ -48,10 +52,10 @@ HandlespaceChecksumAccumulatorType handlespaceChecksumSub(const HandlespaceCheck
 }
 
 
-/* ###### Compute handlespace checksum ################################### */
-HandlespaceChecksumAccumulatorType handlespaceChecksumCompute(HandlespaceChecksumAccumulatorType sum,
-                                                              const char*                        buffer,
-                                                              size_t                             size)
+/* ###### Compute handlespace checksum (reference version) ############## */
+HandlespaceChecksumAccumulatorType handlespaceChecksumComputeScalar(HandlespaceChecksumAccumulatorType sum,
+                                                                    const char*                        buffer,
+                                                                    size_t                             size)
 {
    HandlespaceChecksumType* addr = (HandlespaceChecksumType*)buffer;
    HandlespaceChecksumType  tmp;
@@ -71,6 +75,122 @@ HandlespaceChecksumAccumulatorType handlespaceChecksumCompute(HandlespaceChecksu
 }
 
 
+/* ###### Compute handlespace checksum ################################### */
+/*
+   The accumulator is the plain sum of the buffer's 16-bit words modulo
+   2^32, so the words may be summed in any order and in any number of
+   partial sums. Wide blocks are summed into 32-bit lanes (SSE2) or into
+   the four 16-bit fields of a 64-bit word, then folded into sum; the
+   rest is handled like in handlespaceChecksumComputeScalar().
+*/
+HandlespaceChecksumAccumulatorType handlespaceChecksumCompute(HandlespaceChecksumAccumulatorType sum,
+                                                              const char*                        buffer,
+                                                              size_t                             size)
+{
+   uint64_t block;
+
+#ifdef __SSE2__
+   if(size >= 16) {
+      const __m128i zero  = _mm_setzero_si128();
+      __m128i       lanes = _mm_setzero_si128();
+      __m128i       words;
+      uint32_t      laneArray[4];
+      do {
+         words = _mm_loadu_si128((const __m128i*)buffer);
+         lanes = _mm_add_epi32(lanes, _mm_unpacklo_epi16(words, zero));
+         lanes = _mm_add_epi32(lanes, _mm_unpackhi_epi16(words, zero));
+         buffer += 16;
+         size   -= 16;
+      } while(size >= 16);
+      _mm_storeu_si128((__m128i*)&laneArray, lanes);
+      sum += laneArray[0] + laneArray[1] + laneArray[2] + laneArray[3];
+   }
+#endif
+   while(size >= sizeof(block)) {
+      memcpy(&block, buffer, sizeof(block));
+      /* Sum of the four 16-bit words, via two 32-bit halves which
+         cannot overflow. This does not depend on the byte order. */
+      block = (block & UINT64_C(0x0000ffff0000ffff)) + ((block >> 16) & UINT64_C(0x0000ffff0000ffff));
+      sum += (HandlespaceChecksumAccumulatorType)((block & 0xffffffff) + (block >> 32));
+      buffer += sizeof(block);
+      size   -= sizeof(block);
+   }
+   return(handlespaceChecksumComputeScalar(sum, buffer, size));
+}
+
+
+/* ###### Compute handlespace checksums of 32-bit values ################# */
+/*
+   Sets checksumArray[i] to handlespaceChecksumCompute(sum, &valueArray[i],
+   sizeof(uint32_t)), e.g. for PE identifiers following a common pool
+   handle checksum.
+*/
+void handlespaceChecksumComputeBatch(const HandlespaceChecksumAccumulatorType sum,
+                                     const uint32_t*                          valueArray,
+                                     const size_t                             values,
+                                     HandlespaceChecksumAccumulatorType*      checksumArray)
+{
+   size_t i = 0;
+
+#ifdef __SSE2__
+   const __m128i mask   = _mm_set1_epi32(0xffff);
+   const __m128i prefix = _mm_set1_epi32((int)sum);
+   __m128i       words;
+   for( ;i + 4 <= values;i += 4) {
+      words = _mm_loadu_si128((const __m128i*)&valueArray[i]);
+      words = _mm_add_epi32(_mm_and_si128(words, mask), _mm_srli_epi32(words, 16));
+      _mm_storeu_si128((__m128i*)&checksumArray[i], _mm_add_epi32(words, prefix));
+   }
+#endif
+   for( ;i < values;i++) {
+      checksumArray[i] = sum + (valueArray[i] & 0xffff) + (valueArray[i] >> 16);
+   }
+}
+
+
+/* ###### Check vectorised versions against reference version ########### */
+int handlespaceChecksumSelfTest(void)
+{
+   uint32_t                           valueArray[37];
+   HandlespaceChecksumAccumulatorType checksumArray[37];
+   char                               buffer[256 + 8];
+   uint32_t                           state = 0x12345678;
+   size_t                             offset;
+   size_t                             size;
+   size_t                             i;
+
+   for(i = 0;i < sizeof(buffer);i++) {
+      state = state * 1103515245 + 12345;
+      buffer[i] = (char)(state >> 16);
+   }
+   for(offset = 0;offset < 8;offset += sizeof(HandlespaceChecksumType)) {
+      for(size = 0;size <= sizeof(buffer) - 8;size++) {
+         if(handlespaceChecksumCompute(state, (const char*)&buffer[offset], size) !=
+            handlespaceChecksumComputeScalar(state, (const char*)&buffer[offset], size)) {
+            fprintf(stderr, "Checksum mismatch for offset %u, size %u!\n",
+                    (unsigned int)offset, (unsigned int)size);
+            return(0);
+         }
+      }
+   }
+
+   for(i = 0;i < sizeof(valueArray) / sizeof(valueArray[0]);i++) {
+      valueArray[i] = (i == 0) ? 0xffffffff : (uint32_t)(state * (i + 1));
+   }
+   handlespaceChecksumComputeBatch(state, (const uint32_t*)&valueArray,
+                                   sizeof(valueArray) / sizeof(valueArray[0]),
+                                   (HandlespaceChecksumAccumulatorType*)&checksumArray);
+   for(i = 0;i < sizeof(valueArray) / sizeof(valueArray[0]);i++) {
+      if(checksumArray[i] !=
+         handlespaceChecksumComputeScalar(state, (const char*)&valueArray[i], sizeof(valueArray[i]))) {
+         fprintf(stderr, "Batch checksum mismatch for value %u!\n", (unsigned int)i);
+         return(0);
+      }
+   }
+   return(1);
+}
+
+
 /* ###### Strip off carry part of the checksum ########################### */
 HandlespaceChecksumType handlespaceChecksumFinish(HandlespaceChecksumAccumulatorType sum)
 {
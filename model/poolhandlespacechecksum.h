@@ -59,6 +59,14 @@ HandlespaceChecksumAccumulatorType handlespaceChecksumSub(const HandlespaceCheck
 HandlespaceChecksumAccumulatorType handlespaceChecksumCompute(HandlespaceChecksumAccumulatorType sum,
                                                               const char*                        buffer,
                                                               size_t                             size);
+HandlespaceChecksumAccumulatorType handlespaceChecksumComputeScalar(HandlespaceChecksumAccumulatorType sum,
+                                                                    const char*                        buffer,
+                                                                    size_t                             size);
+void handlespaceChecksumComputeBatch(const HandlespaceChecksumAccumulatorType sum,
+                                     const uint32_t*                          valueArray,
+                                     const size_t                             values,
+                                     HandlespaceChecksumAccumulatorType*      checksumArray);
+int handlespaceChecksumSelfTest(void);
 HandlespaceChecksumType handlespaceChecksumFinish(HandlespaceChecksumAccumulatorType sum);
 
 
@@ -72,3 +72,35 @@ unsigned int computePHPEHash(const struct PoolHandle*        poolHandle,
    hash = hash ^ (uint32_t)identifier;
    return(hash);
 }
+
+
+/* ###### Clear memory usage ############################################# */
+void handlespaceMemoryUsageClear(struct HandlespaceMemoryUsage* memoryUsage)
+{
+   memset(memoryUsage, 0, sizeof(struct HandlespaceMemoryUsage));
+}
+
+
+/* ###### Add memory usage ############################################### */
+void handlespaceMemoryUsageAdd(struct HandlespaceMemoryUsage*       memoryUsage,
+                               const struct HandlespaceMemoryUsage* addend)
+{
+   memoryUsage->Nodes                  += addend->Nodes;
+   memoryUsage->TransportAddressBlocks += addend->TransportAddressBlocks;
+   memoryUsage->TimeStampHashTables    += addend->TimeStampHashTables;
+   memoryUsage->PolicyState            += addend->PolicyState;
+   memoryUsage->Other                  += addend->Other;
+   memoryUsage->AllocatorOverhead      += addend->AllocatorOverhead;
+}
+
+
+/* ###### Get total memory usage ######################################### */
+size_t handlespaceMemoryUsageGetTotal(const struct HandlespaceMemoryUsage* memoryUsage)
+{
+   return(memoryUsage->Nodes +
+          memoryUsage->TransportAddressBlocks +
+          memoryUsage->TimeStampHashTables +
+          memoryUsage->PolicyState +
+          memoryUsage->Other +
+          memoryUsage->AllocatorOverhead);
+}
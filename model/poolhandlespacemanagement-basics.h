@@ -102,12 +102,34 @@ enum PoolNodeUpdateAction
 };
 
 
+/*
+   Memory used by a handlespace, peer list or pool user list, in bytes by
+   category. Nodes and transport address blocks are counted by their
+   structure sizes; AllocatorOverhead is the rest of the slabs they are
+   allocated from, i.e. free objects, padding and slab headers.
+*/
+struct HandlespaceMemoryUsage
+{
+   size_t Nodes;                    /* Pool, PE, peer and pool user nodes     */
+   size_t TransportAddressBlocks;   /* Transport addresses of the nodes       */
+   size_t TimeStampHashTables;      /* Rate statistics of the pool users      */
+   size_t PolicyState;              /* Selection indexes of the pool policies */
+   size_t Other;                    /* Other indexes, change log and views    */
+   size_t AllocatorOverhead;        /* Slab space not used by nodes           */
+};
+
+
 const char* poolHandlespaceManagementGetErrorDescription(const unsigned int errorCode);
 PoolElementIdentifierType getPoolElementIdentifier();
 
 unsigned int computePHPEHash(const struct PoolHandle*        poolHandle,
                              const PoolElementIdentifierType identifier);
 
+void handlespaceMemoryUsageClear(struct HandlespaceMemoryUsage* memoryUsage);
+void handlespaceMemoryUsageAdd(struct HandlespaceMemoryUsage*       memoryUsage,
+                               const struct HandlespaceMemoryUsage* addend);
+size_t handlespaceMemoryUsageGetTotal(const struct HandlespaceMemoryUsage* memoryUsage);
+
 /*
  Starting value for seqence numbers. Set it to (~0) ^ 0xf to test
  sequence number warp.
@@ -36,12 +36,33 @@ extern "C" {
 #endif
 
 
+struct ST_CLASS(HandleResolutionRequest);
+
 struct ST_CLASS(PoolHandlespaceManagement)
 {
    struct ST_CLASS(PoolHandlespaceNode) Handlespace;
    struct ST_CLASS(PoolNode)*           NewPoolNode;
    struct ST_CLASS(PoolElementNode)*    NewPoolElementNode;
 
+   /* Pool nodes, pool element nodes and their transport address blocks
+      are allocated from here, to keep registration churn off the heap */
+   struct SlabAllocator                 Allocator;
+
+   /* Sorting space of poolHandlespaceManagementHandleResolutions(), kept
+      for the next call */
+   struct ST_CLASS(HandleResolutionRequest)** HandleResolutionScratch;
+   size_t                                     HandleResolutionScratchSize;
+
+   /* Published views for concurrent readers, NULL if not enabled; the
+      version is the handlespace version of the published view */
+   struct PoolHandlespaceViewPublisher* ViewPublisher;
+   unsigned long long                   ViewVersion;
+
+   /* Policies whose new pools draw from an alias table, bit i for
+      ST_CLASS(PoolPolicyArray)[i], see
+      poolHandlespaceManagementSetAliasTableSelection() */
+   unsigned int                         AliasTablePolicies;
+
    void (*PoolNodeUserDataDisposer)(struct ST_CLASS(PoolNode)* poolNode,
                                     void*                      userData);
    void (*PoolElementNodeUserDataDisposer)(struct ST_CLASS(PoolElementNode)* poolElementNode,
@@ -58,6 +79,41 @@ struct ST_CLASS(PoolHandlespaceManagement)
 };
 
 
+/* ====== Registration request for bulk registration ================== */
+struct ST_CLASS(PoolElementRegistration)
+{
+   const struct PoolHandle*            Handle;
+   RegistrarIdentifierType             HomeRegistrarIdentifier;
+   PoolElementIdentifierType           Identifier;
+   unsigned int                        RegistrationLife;
+   const struct PoolPolicySettings*    PolicySettings;
+   const struct TransportAddressBlock* UserTransport;
+   const struct TransportAddressBlock* RegistratorTransport;
+   int                                 ConnectionSocketDescriptor;
+   sctp_assoc_t                        ConnectionAssocID;
+
+   /* Results, set by poolHandlespaceManagementRegisterPoolElementsBulk() */
+   unsigned int                        ErrorCode;
+   struct ST_CLASS(PoolElementNode)*   PoolElementNode;
+};
+
+
+/* ====== Request for batched handle resolution ======================= */
+struct ST_CLASS(HandleResolutionRequest)
+{
+   const struct PoolHandle*            Handle;
+   size_t                              MaxHandleResolutionItems;
+   size_t                              MaxIncrement;
+
+   /* Results, set by poolHandlespaceManagementHandleResolutions():
+      the selected PEs are poolElementNodeArray[FirstPoolElementNode]
+      to poolElementNodeArray[FirstPoolElementNode + PoolElementNodes - 1] */
+   unsigned int                        ErrorCode;
+   size_t                              FirstPoolElementNode;
+   size_t                              PoolElementNodes;
+};
+
+
 void ST_CLASS(poolHandlespaceManagementNew)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
         const RegistrarIdentifierType               homeRegistrarIdentifier,
@@ -68,6 +124,11 @@ void ST_CLASS(poolHandlespaceManagementNew)(
         void* disposerUserData);
 void ST_CLASS(poolHandlespaceManagementDelete)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+const struct SlabAllocator* ST_CLASS(poolHandlespaceManagementGetAllocator)(
+        const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+void ST_CLASS(poolHandlespaceManagementGetMemoryUsage)(
+        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        struct HandlespaceMemoryUsage*              memoryUsage);
 void ST_CLASS(poolHandlespaceManagementGetDescription)(
         const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
         char*                                             buffer,
@@ -78,6 +139,9 @@ void ST_CLASS(poolHandlespaceManagementPrint)(
         const unsigned int                                fields);
 void ST_CLASS(poolHandlespaceManagementVerify)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+void ST_CLASS(poolHandlespaceManagementVerifyChange)(
+        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        const struct PoolHandle*                    poolHandle);
 void ST_CLASS(poolHandlespaceManagementClear)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
 
@@ -85,6 +149,16 @@ HandlespaceChecksumType ST_CLASS(poolHandlespaceManagementGetHandlespaceChecksum
                            const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
 HandlespaceChecksumType ST_CLASS(poolHandlespaceManagementGetOwnershipChecksum)(
                            const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+void ST_CLASS(poolHandlespaceManagementGetOwnershipDigestTree)(
+        const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        const RegistrarIdentifierType                     registrarIdentifier,
+        HandlespaceChecksumType*                          digestArray);
+HandlespaceChecksumType ST_CLASS(poolHandlespaceManagementGetPoolOwnershipDigest)(
+                           struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+                           const RegistrarIdentifierType               registrarIdentifier,
+                           const struct PoolHandle*                    poolHandle);
+unsigned int ST_CLASS(poolHandlespaceManagementGetOwnershipDigestBucket)(
+                const struct PoolHandle* poolHandle);
 size_t ST_CLASS(poolHandlespaceManagementGetPools)(
           const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
 size_t ST_CLASS(poolHandlespaceManagementGetPoolElements)(
@@ -149,10 +223,20 @@ unsigned int ST_CLASS(poolHandlespaceManagementRegisterPoolElementByPtr)(
                 const unsigned long long                    currentTimeStamp,
                 struct ST_CLASS(PoolElementNode)**          poolElementNode);
 
+size_t ST_CLASS(poolHandlespaceManagementRegisterPoolElementsBulk)(
+          struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+          struct ST_CLASS(PoolElementRegistration)*   registrationArray,
+          const size_t                                registrations,
+          const unsigned long long                    currentTimeStamp);
+
 void ST_CLASS(poolHandlespaceManagementUpdateOwnershipOfPoolElementNode)(
               struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
               struct ST_CLASS(PoolElementNode)*           poolElementNode,
               const RegistrarIdentifierType               newHomeRegistrarIdentifier);
+size_t ST_CLASS(poolHandlespaceManagementTransferOwnershipOfPoolElementNodes)(
+          struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+          const RegistrarIdentifierType               oldHomeRegistrarIdentifier,
+          const RegistrarIdentifierType               newHomeRegistrarIdentifier);
 void ST_CLASS(poolHandlespaceManagementUpdateConnectionOfPoolElementNode)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
         struct ST_CLASS(PoolElementNode)*           poolElementNode,
@@ -188,6 +272,12 @@ unsigned int ST_CLASS(poolHandlespaceManagementHandleResolution)(
                 size_t*                                     poolElementNodes,
                 const size_t                                maxHandleResolutionItems,
                 const size_t                                maxIncrement);
+size_t ST_CLASS(poolHandlespaceManagementHandleResolutions)(
+          struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+          struct ST_CLASS(HandleResolutionRequest)*   requestArray,
+          const size_t                                requests,
+          struct ST_CLASS(PoolElementNode)**          poolElementNodeArray,
+          const size_t                                maxPoolElementNodes);
 
 
 /*
@@ -222,6 +312,52 @@ int ST_CLASS(poolHandlespaceManagementGetHandleTable)(
        size_t                                      maxElements);
 
 
+/*
+   Changes since a handlespace version: PEs added or updated after it and
+   tombstones of PEs removed after it, in the order of their changes.
+   With HTEF_START, the extract begins after the given version; otherwise,
+   it continues after LastVersion of the previous extract. The version
+   must be accepted by poolHandlespaceManagementHasChangesSince().
+*/
+struct ST_CLASS(HandleTableChangesExtract)
+{
+   unsigned long long                           LastVersion;
+   size_t                                       PoolElementNodes;
+   struct ST_CLASS(PoolElementNode)*            PoolElementNodeArray[NTE_MAX_POOL_ELEMENT_NODES];
+   size_t                                       Tombstones;
+   const struct ST_CLASS(PoolElementTombstone)* TombstoneArray[NTE_MAX_POOL_ELEMENT_NODES];
+};
+
+
+unsigned long long ST_CLASS(poolHandlespaceManagementGetModificationSequence)(
+                      const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+void ST_CLASS(poolHandlespaceManagementSetMaxTombstones)(
+        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        const size_t                                maxTombstones);
+int ST_CLASS(poolHandlespaceManagementSetAliasTableSelection)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+       const unsigned int                          policyType,
+       const int                                   enable);
+int ST_CLASS(poolHandlespaceManagementHasChangesSince)(
+       const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+       const unsigned long long                          version);
+int ST_CLASS(poolHandlespaceManagementGetHandleTableChanges)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+       const RegistrarIdentifierType               homeRegistrarIdentifier,
+       const unsigned long long                    sinceVersion,
+       struct ST_CLASS(HandleTableChangesExtract)* handleTableChangesExtract,
+       const unsigned int                          flags,
+       size_t                                      maxElements);
+
+
+int ST_CLASS(poolHandlespaceManagementEnableConcurrentReaders)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+int ST_CLASS(poolHandlespaceManagementPublishView)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+struct PoolHandlespaceViewPublisher* ST_CLASS(poolHandlespaceManagementGetViewPublisher)(
+                                        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement);
+
+
 void ST_CLASS(poolHandlespaceManagementMarkPoolElementNodes)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
         const RegistrarIdentifierType ownerID);
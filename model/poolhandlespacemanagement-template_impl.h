@@ -75,6 +75,105 @@ void ST_CLASS(poolHandlespaceManagementNew)(
    poolHandlespaceManagement->DisposerUserData                = disposerUserData;
    poolHandlespaceManagement->PoolNodeUpdateNotification      = NULL;
    poolHandlespaceManagement->NotificationUserData            = NULL;
+   poolHandlespaceManagement->HandleResolutionScratch         = NULL;
+   poolHandlespaceManagement->HandleResolutionScratchSize     = 0;
+   poolHandlespaceManagement->ViewPublisher                   = NULL;
+   poolHandlespaceManagement->ViewVersion                     = 0;
+   CHECK(ST_CLASS(PoolPolicies) <= 8 * sizeof(poolHandlespaceManagement->AliasTablePolicies));
+#ifdef USE_POOLELEMENT_SELECTION_ALIASTABLE
+   poolHandlespaceManagement->AliasTablePolicies              = ~0U;
+#else
+   poolHandlespaceManagement->AliasTablePolicies              = 0;
+#endif
+
+   /* ====== Size classes for the allocator ============================== */
+   slabAllocatorNew(&poolHandlespaceManagement->Allocator);
+   slabAllocatorAddClass(&poolHandlespaceManagement->Allocator,
+                         sizeof(struct ST_CLASS(PoolNode)), 0, 0);
+   slabAllocatorAddClass(&poolHandlespaceManagement->Allocator,
+                         sizeof(struct ST_CLASS(PoolElementNode)), 0,
+                         POOLELEMENTNODE_ALIGNMENT);
+   slabAllocatorAddClass(&poolHandlespaceManagement->Allocator,
+                         transportAddressBlockGetSize(1), 0, 0);
+   slabAllocatorAddClass(&poolHandlespaceManagement->Allocator,
+                         transportAddressBlockGetSize(2), 0, 0);
+   slabAllocatorAddClass(&poolHandlespaceManagement->Allocator,
+                         transportAddressBlockGetSize(4), 0, 0);
+}
+
+
+/* ###### Get allocator ################################################## */
+const struct SlabAllocator* ST_CLASS(poolHandlespaceManagementGetAllocator)(
+                               const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement)
+{
+   return(&poolHandlespaceManagement->Allocator);
+}
+
+
+/* ###### Get memory usage ############################################## */
+void ST_CLASS(poolHandlespaceManagementGetMemoryUsage)(
+        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        struct HandlespaceMemoryUsage*              memoryUsage)
+{
+   size_t allocatedBytes;
+
+   handlespaceMemoryUsageClear(memoryUsage);
+   ST_CLASS(poolHandlespaceNodeAddMemoryUsage)(&poolHandlespaceManagement->Handlespace,
+                                               memoryUsage);
+   if(poolHandlespaceManagement->NewPoolNode) {
+      ST_CLASS(poolNodeAddMemoryUsage)(poolHandlespaceManagement->NewPoolNode,
+                                       memoryUsage);
+   }
+   if(poolHandlespaceManagement->NewPoolElementNode) {
+      memoryUsage->Nodes += sizeof(struct ST_CLASS(PoolElementNode));
+   }
+   memoryUsage->Other += sizeof(struct ST_CLASS(PoolHandlespaceManagement)) +
+                         (poolHandlespaceManagement->HandleResolutionScratchSize *
+                            sizeof(struct ST_CLASS(HandleResolutionRequest)*));
+   if(poolHandlespaceManagement->ViewPublisher) {
+      memoryUsage->Other += sizeof(struct PoolHandlespaceViewPublisher) +
+                            poolHandlespaceViewPublisherGetMemoryUsage(
+                               poolHandlespaceManagement->ViewPublisher);
+   }
+
+   /* All nodes and transport address blocks are allocated from the slabs */
+   allocatedBytes = slabAllocatorGetAllocatedBytes(&poolHandlespaceManagement->Allocator);
+   if(allocatedBytes > memoryUsage->Nodes + memoryUsage->TransportAddressBlocks) {
+      memoryUsage->AllocatorOverhead = allocatedBytes -
+                                          (memoryUsage->Nodes + memoryUsage->TransportAddressBlocks);
+   }
+}
+
+
+/* ###### Duplicate TransportAddressBlock using the allocator ############ */
+static struct TransportAddressBlock* ST_CLASS(poolHandlespaceManagementDuplicateTransportAddressBlock)(
+                                        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+                                        const struct TransportAddressBlock*         transportAddressBlock)
+{
+   struct TransportAddressBlock* duplicate;
+   size_t                        size;
+
+   if(transportAddressBlock) {
+      size      = transportAddressBlockGetSize(transportAddressBlock->Addresses);
+      duplicate = (struct TransportAddressBlock*)slabAllocatorAllocate(
+                     &poolHandlespaceManagement->Allocator, size);
+      if(duplicate) {
+         memcpy(duplicate, transportAddressBlock, size);
+         return(duplicate);
+      }
+   }
+   return(NULL);
+}
+
+
+/* ###### Free TransportAddressBlock using the allocator ################# */
+static void ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(
+               struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+               struct TransportAddressBlock*               transportAddressBlock)
+{
+   const size_t size = transportAddressBlockGetSize(transportAddressBlock->Addresses);
+   transportAddressBlockDelete(transportAddressBlock);
+   slabAllocatorFree(&poolHandlespaceManagement->Allocator, transportAddressBlock, size);
 }
 
 
@@ -89,15 +188,16 @@ static void ST_CLASS(poolHandlespaceManagementPoolElementNodeDisposer)(void* arg
                                                                  poolHandlespaceManagement->DisposerUserData);
       poolElementNode->UserData = NULL;
    }
-   transportAddressBlockDelete(poolElementNode->UserTransport);
-   free(poolElementNode->UserTransport);
+   ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                poolElementNode->UserTransport);
    poolElementNode->UserTransport = NULL;
    if(poolElementNode->RegistratorTransport) {
-      transportAddressBlockDelete(poolElementNode->RegistratorTransport);
-      free(poolElementNode->RegistratorTransport);
+      ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                   poolElementNode->RegistratorTransport);
       poolElementNode->RegistratorTransport = NULL;
    }
-   free(poolElementNode);
+   slabAllocatorFree(&poolHandlespaceManagement->Allocator,
+                     poolElementNode, sizeof(struct ST_CLASS(PoolElementNode)));
 }
 
 
@@ -112,7 +212,8 @@ static void ST_CLASS(poolHandlespaceManagementPoolNodeDisposer)(void* arg1,
                                                           poolHandlespaceManagement->DisposerUserData);
       poolNode->UserData = NULL;
    }
-   free(poolNode);
+   slabAllocatorFree(&poolHandlespaceManagement->Allocator,
+                     poolNode, sizeof(struct ST_CLASS(PoolNode)));
 }
 
 
@@ -122,14 +223,28 @@ void ST_CLASS(poolHandlespaceManagementDelete)(
 {
    ST_CLASS(poolHandlespaceManagementClear)(poolHandlespaceManagement);
    ST_CLASS(poolHandlespaceNodeDelete)(&poolHandlespaceManagement->Handlespace);
+   if(poolHandlespaceManagement->ViewPublisher) {
+      poolHandlespaceViewPublisherDelete(poolHandlespaceManagement->ViewPublisher);
+      free(poolHandlespaceManagement->ViewPublisher);
+      poolHandlespaceManagement->ViewPublisher = NULL;
+   }
    if(poolHandlespaceManagement->NewPoolNode) {
-      free(poolHandlespaceManagement->NewPoolNode);
+      ST_CLASS(poolNodeDelete)(poolHandlespaceManagement->NewPoolNode);
+      slabAllocatorFree(&poolHandlespaceManagement->Allocator,
+                        poolHandlespaceManagement->NewPoolNode,
+                        sizeof(struct ST_CLASS(PoolNode)));
       poolHandlespaceManagement->NewPoolNode = NULL;
    }
    if(poolHandlespaceManagement->NewPoolElementNode) {
-      free(poolHandlespaceManagement->NewPoolElementNode);
+      slabAllocatorFree(&poolHandlespaceManagement->Allocator,
+                        poolHandlespaceManagement->NewPoolElementNode,
+                        sizeof(struct ST_CLASS(PoolElementNode)));
       poolHandlespaceManagement->NewPoolElementNode = NULL;
    }
+   free(poolHandlespaceManagement->HandleResolutionScratch);
+   poolHandlespaceManagement->HandleResolutionScratch     = NULL;
+   poolHandlespaceManagement->HandleResolutionScratchSize = 0;
+   slabAllocatorDelete(&poolHandlespaceManagement->Allocator);
 }
 
 
@@ -141,6 +256,9 @@ void ST_CLASS(poolHandlespaceManagementClear)(
                                       ST_CLASS(poolHandlespaceManagementPoolNodeDisposer),
                                       ST_CLASS(poolHandlespaceManagementPoolElementNodeDisposer),
                                       (void*)poolHandlespaceManagement);
+   /* The handlespace version restarts, i.e. the published view's version
+      cannot be used to find the changes anymore */
+   poolHandlespaceManagement->ViewVersion = ~0ULL;
 }
 
 
@@ -160,6 +278,81 @@ HandlespaceChecksumType ST_CLASS(poolHandlespaceManagementGetOwnershipChecksum)(
 }
 
 
+/* ###### Get ownership digest tree buckets of PR ######################## */
+/*
+   Fills digestArray with the HANDLESPACE_DIGEST_BUCKETS bucket digests
+   of the PEs owned by the given PR. Before finishing, the buckets add up
+   to the PR's ownership checksum.
+*/
+void ST_CLASS(poolHandlespaceManagementGetOwnershipDigestTree)(
+        const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        const RegistrarIdentifierType                     registrarIdentifier,
+        HandlespaceChecksumType*                          digestArray)
+{
+   HandlespaceChecksumAccumulatorType        computedDigestTree[HANDLESPACE_DIGEST_BUCKETS];
+   const HandlespaceChecksumAccumulatorType* digestTree;
+   unsigned int                              bucket;
+
+   if(registrarIdentifier == poolHandlespaceManagement->Handlespace.HomeRegistrarIdentifier) {
+      digestTree = poolHandlespaceManagement->Handlespace.OwnershipDigestTree;
+   }
+   else {
+      ST_CLASS(poolHandlespaceNodeComputeOwnershipDigestTree)(&poolHandlespaceManagement->Handlespace,
+                                                              registrarIdentifier,
+                                                              computedDigestTree);
+      digestTree = computedDigestTree;
+   }
+   for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+      digestArray[bucket] = handlespaceChecksumFinish(digestTree[bucket]);
+   }
+}
+
+
+/* ###### Get ownership digest of pool for PR ############################ */
+HandlespaceChecksumType ST_CLASS(poolHandlespaceManagementGetPoolOwnershipDigest)(
+                           struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+                           const RegistrarIdentifierType               registrarIdentifier,
+                           const struct PoolHandle*                    poolHandle)
+{
+   const struct ST_CLASS(PoolNode)* poolNode =
+      ST_CLASS(poolHandlespaceNodeFindPoolNode)(&poolHandlespaceManagement->Handlespace,
+                                                poolHandle);
+   if(poolNode == NULL) {
+      return(handlespaceChecksumFinish(INITIAL_HANDLESPACE_CHECKSUM));
+   }
+   return(handlespaceChecksumFinish(
+             ST_CLASS(poolHandlespaceNodeComputePoolOwnershipChecksum)(
+                &poolHandlespaceManagement->Handlespace, poolNode, registrarIdentifier)));
+}
+
+
+/* ###### Get ownership digest tree bucket of pool handle ############### */
+unsigned int ST_CLASS(poolHandlespaceManagementGetOwnershipDigestBucket)(
+                const struct PoolHandle* poolHandle)
+{
+   return(ST_CLASS(poolHandlespaceNodeGetOwnershipDigestBucket)(poolHandle));
+}
+
+
+/* ###### Get flags for new pool ######################################### */
+static unsigned int ST_CLASS(poolHandlespaceManagementGetPoolNodeFlags)(
+                       const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+                       const struct ST_CLASS(PoolPolicy)*                poolPolicy,
+                       const struct TransportAddressBlock*               userTransport)
+{
+   unsigned int flags = 0;
+
+   if(userTransport->Flags & TABF_CONTROLCHANNEL) {
+      flags |= PNF_CONTROLCHANNEL;
+   }
+   if(poolHandlespaceManagement->AliasTablePolicies &
+         (1U << (unsigned int)(poolPolicy - ST_CLASS(PoolPolicyArray)))) {
+      flags |= PNF_SELECTION_ALIASTABLE;
+   }
+   return(flags);
+}
+
+
 /* ###### Registration ################################################### */
 unsigned int ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
                 struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
@@ -189,18 +382,27 @@ unsigned int ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
       return(RSPERR_INVALID_POOL_POLICY);
    }
    if(poolHandlespaceManagement->NewPoolNode == NULL) {
-      poolHandlespaceManagement->NewPoolNode = (struct ST_CLASS(PoolNode)*)malloc(sizeof(struct ST_CLASS(PoolNode)));
+      poolHandlespaceManagement->NewPoolNode = (struct ST_CLASS(PoolNode)*)slabAllocatorAllocate(
+                                                   &poolHandlespaceManagement->Allocator,
+                                                   sizeof(struct ST_CLASS(PoolNode)));
       if(poolHandlespaceManagement->NewPoolNode == NULL) {
          return(RSPERR_OUT_OF_MEMORY);
       }
    }
+   else {
+      /* Left over from a previous registration */
+      ST_CLASS(poolNodeDelete)(poolHandlespaceManagement->NewPoolNode);
+   }
    ST_CLASS(poolNodeNew)(poolHandlespaceManagement->NewPoolNode,
                          poolHandle, poolPolicy,
                          userTransport->Protocol,
-                         (userTransport->Flags & TABF_CONTROLCHANNEL) ? PNF_CONTROLCHANNEL : 0);
+                         ST_CLASS(poolHandlespaceManagementGetPoolNodeFlags)(
+                            poolHandlespaceManagement, poolPolicy, userTransport));
 
    if(poolHandlespaceManagement->NewPoolElementNode == NULL) {
-      poolHandlespaceManagement->NewPoolElementNode = (struct ST_CLASS(PoolElementNode)*)malloc(sizeof(struct ST_CLASS(PoolElementNode)));
+      poolHandlespaceManagement->NewPoolElementNode = (struct ST_CLASS(PoolElementNode)*)slabAllocatorAllocate(
+                                                          &poolHandlespaceManagement->Allocator,
+                                                          sizeof(struct ST_CLASS(PoolElementNode)));
       if(poolHandlespaceManagement->NewPoolElementNode == NULL) {
          return(RSPERR_OUT_OF_MEMORY);
       }
@@ -232,32 +434,34 @@ unsigned int ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
    if(errorCode == RSPERR_OKAY) {
       (*poolElementNode)->LastUpdateTimeStamp = currentTimeStamp;
 
-      userTransportCopy        = transportAddressBlockDuplicate(userTransport);
-      registratorTransportCopy = transportAddressBlockDuplicate(registratorTransport);
+      userTransportCopy        = ST_CLASS(poolHandlespaceManagementDuplicateTransportAddressBlock)(
+                                    poolHandlespaceManagement, userTransport);
+      registratorTransportCopy = ST_CLASS(poolHandlespaceManagementDuplicateTransportAddressBlock)(
+                                    poolHandlespaceManagement, registratorTransport);
 
       if((userTransportCopy != NULL) &&
          ((registratorTransportCopy != NULL) || (registratorTransport == NULL))) {
          if((*poolElementNode)->UserTransport != userTransport) {   /* see comment above! */
-            transportAddressBlockDelete((*poolElementNode)->UserTransport);
-            free((*poolElementNode)->UserTransport);
+            ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                         (*poolElementNode)->UserTransport);
          }
          (*poolElementNode)->UserTransport = userTransportCopy;
 
          if(((*poolElementNode)->RegistratorTransport != registratorTransport) &&
             ((*poolElementNode)->RegistratorTransport != NULL)) {   /* see comment above! */
-            transportAddressBlockDelete((*poolElementNode)->RegistratorTransport);
-            free((*poolElementNode)->RegistratorTransport);
+            ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                         (*poolElementNode)->RegistratorTransport);
          }
          (*poolElementNode)->RegistratorTransport = registratorTransportCopy;
       }
       else {
          if(userTransportCopy) {
-            transportAddressBlockDelete(userTransportCopy);
-            free(userTransportCopy);
+            ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                         userTransportCopy);
          }
          if(registratorTransportCopy) {
-            transportAddressBlockDelete(registratorTransportCopy);
-            free(registratorTransportCopy);
+            ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                         registratorTransportCopy);
          }
          ST_CLASS(poolHandlespaceManagementDeregisterPoolElement)(
             poolHandlespaceManagement,
@@ -270,12 +474,355 @@ unsigned int ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
 
 #ifdef VERIFY
 #warning VERIFY is on! The Handlespace Management will be very slow!
-   ST_CLASS(poolHandlespaceNodeVerify)(&poolHandlespaceManagement->Handlespace);
+   ST_CLASS(poolHandlespaceNodeVerifyChange)(&poolHandlespaceManagement->Handlespace, poolHandle);
 #endif
    return(errorCode);
 }
 
 
+/* ###### Registration sorting order: pool handle, PE ID, array order ### */
+static int ST_CLASS(poolElementRegistrationComparison)(const void* ptr1, const void* ptr2)
+{
+   const struct ST_CLASS(PoolElementRegistration)* registration1 =
+      *((const struct ST_CLASS(PoolElementRegistration)**)ptr1);
+   const struct ST_CLASS(PoolElementRegistration)* registration2 =
+      *((const struct ST_CLASS(PoolElementRegistration)**)ptr2);
+   const int cmpResult = poolHandleComparison(registration1->Handle, registration2->Handle);
+
+   if(cmpResult != 0) {
+      return(cmpResult);
+   }
+   if(registration1->Identifier < registration2->Identifier) {
+      return(-1);
+   }
+   else if(registration1->Identifier > registration2->Identifier) {
+      return(1);
+   }
+   if(registration1 < registration2) {
+      return(-1);
+   }
+   else if(registration1 > registration2) {
+      return(1);
+   }
+   return(0);
+}
+
+
+/* ###### Registration pool order: pool handle, array order ############# */
+static int ST_CLASS(poolElementRegistrationPoolOrderComparison)(const void* ptr1, const void* ptr2)
+{
+   const struct ST_CLASS(PoolElementRegistration)* registration1 =
+      *((const struct ST_CLASS(PoolElementRegistration)**)ptr1);
+   const struct ST_CLASS(PoolElementRegistration)* registration2 =
+      *((const struct ST_CLASS(PoolElementRegistration)**)ptr2);
+   const int cmpResult = poolHandleComparison(registration1->Handle, registration2->Handle);
+
+   if(cmpResult != 0) {
+      return(cmpResult);
+   }
+   if(registration1 < registration2) {
+      return(-1);
+   }
+   else if(registration1 > registration2) {
+      return(1);
+   }
+   return(0);
+}
+
+
+/* ###### Create new PoolElementNode for bulk registration ############### */
+static unsigned int ST_CLASS(poolHandlespaceManagementNewPoolElementNode)(
+                       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+                       struct ST_CLASS(PoolNode)*                  poolNode,
+                       struct ST_CLASS(PoolElementRegistration)*   registration,
+                       const unsigned long long                    currentTimeStamp)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct TransportAddressBlock*     userTransportCopy;
+   struct TransportAddressBlock*     registratorTransportCopy;
+   unsigned int                      errorCode;
+
+   poolElementNode = (struct ST_CLASS(PoolElementNode)*)slabAllocatorAllocate(
+                        &poolHandlespaceManagement->Allocator,
+                        sizeof(struct ST_CLASS(PoolElementNode)));
+   if(poolElementNode == NULL) {
+      return(RSPERR_OUT_OF_MEMORY);
+   }
+   ST_CLASS(poolElementNodeNew)(poolElementNode,
+                                registration->Identifier,
+                                registration->HomeRegistrarIdentifier,
+                                registration->RegistrationLife,
+                                registration->PolicySettings,
+                                (struct TransportAddressBlock*)registration->UserTransport,
+                                (struct TransportAddressBlock*)registration->RegistratorTransport,
+                                registration->ConnectionSocketDescriptor,
+                                registration->ConnectionAssocID);
+   errorCode = ST_CLASS(poolNodeCheckPoolElementNodeCompatibility)(poolNode, poolElementNode);
+   if(errorCode == RSPERR_OKAY) {
+      userTransportCopy        = ST_CLASS(poolHandlespaceManagementDuplicateTransportAddressBlock)(
+                                    poolHandlespaceManagement, registration->UserTransport);
+      registratorTransportCopy = ST_CLASS(poolHandlespaceManagementDuplicateTransportAddressBlock)(
+                                    poolHandlespaceManagement, registration->RegistratorTransport);
+      if((userTransportCopy != NULL) &&
+         ((registratorTransportCopy != NULL) || (registration->RegistratorTransport == NULL))) {
+         poolElementNode->UserTransport        = userTransportCopy;
+         poolElementNode->RegistratorTransport = registratorTransportCopy;
+         poolElementNode->LastUpdateTimeStamp  = currentTimeStamp;
+         registration->PoolElementNode         = poolElementNode;
+         return(RSPERR_OKAY);
+      }
+      if(userTransportCopy) {
+         ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                      userTransportCopy);
+      }
+      if(registratorTransportCopy) {
+         ST_CLASS(poolHandlespaceManagementFreeTransportAddressBlock)(poolHandlespaceManagement,
+                                                                      registratorTransportCopy);
+      }
+      errorCode = RSPERR_OUT_OF_MEMORY;
+   }
+   ST_CLASS(poolElementNodeDelete)(poolElementNode);
+   slabAllocatorFree(&poolHandlespaceManagement->Allocator,
+                     poolElementNode, sizeof(struct ST_CLASS(PoolElementNode)));
+   return(errorCode);
+}
+
+
+/* ###### Add registrations of new PEs in bulk ########################### */
+/*
+   Adds the new PEs of registrationArray pool by pool, so that each pool's
+   storages are rebuilt once instead of rebalancing on every insertion.
+   The entries must be registrations of distinct PEs not yet in the
+   handlespace. The result of each registration is stored in its
+   ErrorCode and PoolElementNode fields; the successful ones have to be
+   completed by poolHandlespaceNodeCompletePoolElementNodeAddition().
+*/
+static void ST_CLASS(poolHandlespaceManagementAddPoolElementsBulk)(
+               struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+               struct ST_CLASS(PoolElementRegistration)**  registrationArray,
+               const size_t                                registrations,
+               struct ST_CLASS(PoolElementNode)**          poolElementNodeArray,
+               const unsigned long long                    currentTimeStamp)
+{
+   struct ST_CLASS(PoolElementRegistration)* registration;
+   struct ST_CLASS(PoolNode)*                poolNode;
+   const struct ST_CLASS(PoolPolicy)*        poolPolicy;
+   int                                       newPoolNode;
+   size_t                                    newPoolElementNodes;
+   size_t                                    first, last, i;
+
+   qsort(registrationArray, registrations, sizeof(struct ST_CLASS(PoolElementRegistration)*),
+         ST_CLASS(poolElementRegistrationPoolOrderComparison));
+   for(first = 0;first < registrations;first = last) {
+      /* ====== Find registrations of this pool ========================== */
+      for(last = first + 1;last < registrations;last++) {
+         if(poolHandleComparison(registrationArray[first]->Handle, registrationArray[last]->Handle) != 0) {
+            break;
+         }
+      }
+
+      /* ====== Find pool or create it from its first registration ======= */
+      newPoolNode = 0;
+      poolNode    = ST_CLASS(poolHandlespaceNodeFindPoolNode)(&poolHandlespaceManagement->Handlespace,
+                                                              registrationArray[first]->Handle);
+      if(poolNode == NULL) {
+         if(poolHandlespaceManagement->NewPoolNode == NULL) {
+            poolHandlespaceManagement->NewPoolNode = (struct ST_CLASS(PoolNode)*)slabAllocatorAllocate(
+                                                         &poolHandlespaceManagement->Allocator,
+                                                         sizeof(struct ST_CLASS(PoolNode)));
+            if(poolHandlespaceManagement->NewPoolNode == NULL) {
+               for(i = first;i < last;i++) {
+                  registrationArray[i]->ErrorCode = RSPERR_OUT_OF_MEMORY;
+               }
+               continue;
+            }
+         }
+         else {
+            ST_CLASS(poolNodeDelete)(poolHandlespaceManagement->NewPoolNode);
+         }
+         registration = registrationArray[first];
+         poolPolicy   = ST_CLASS(poolPolicyGetPoolPolicyByType)(registration->PolicySettings->PolicyType);
+         ST_CLASS(poolNodeNew)(poolHandlespaceManagement->NewPoolNode,
+                               registration->Handle, poolPolicy,
+                               registration->UserTransport->Protocol,
+                               ST_CLASS(poolHandlespaceManagementGetPoolNodeFlags)(
+                                  poolHandlespaceManagement, poolPolicy, registration->UserTransport));
+         poolNode = ST_CLASS(poolHandlespaceNodeAddPoolNode)(&poolHandlespaceManagement->Handlespace,
+                                                             poolHandlespaceManagement->NewPoolNode);
+         CHECK(poolNode == poolHandlespaceManagement->NewPoolNode);
+         newPoolNode = 1;
+      }
+
+      /* ====== Create PE entries and add them in registration order ===== */
+      newPoolElementNodes = 0;
+      for(i = first;i < last;i++) {
+         registration = registrationArray[i];
+         registration->ErrorCode = ST_CLASS(poolHandlespaceManagementNewPoolElementNode)(
+                                      poolHandlespaceManagement, poolNode,
+                                      registration, currentTimeStamp);
+         if(registration->ErrorCode == RSPERR_OKAY) {
+            poolElementNodeArray[newPoolElementNodes++] = registration->PoolElementNode;
+         }
+      }
+      if(newPoolElementNodes > 0) {
+         ST_CLASS(poolHandlespaceNodeAddPoolElementNodes)(&poolHandlespaceManagement->Handlespace,
+                                                          poolNode,
+                                                          poolElementNodeArray,
+                                                          newPoolElementNodes);
+         if(newPoolNode) {
+            /* Keep the new pool, since it got elements. */
+            poolHandlespaceManagement->NewPoolNode = NULL;
+         }
+      }
+      else if(newPoolNode) {
+         /* A new pool has been created but no PE been registered.
+            Remove the empty pool now! */
+         CHECK(ST_CLASS(poolHandlespaceNodeRemovePoolNode)(&poolHandlespaceManagement->Handlespace, poolNode) ==
+                  poolNode);
+      }
+   }
+}
+
+
+/* ###### Bulk registration ############################################## */
+/*
+   Registers all PEs of registrationArray, with the same result as calling
+   poolHandlespaceManagementRegisterPoolElement() for each entry in array
+   order; the result of each registration is stored in its ErrorCode and
+   PoolElementNode fields. Each run of consecutive registrations of new
+   PEs is added in bulk, see poolHandlespaceManagementAddPoolElementsBulk(),
+   and then completed in array order. Re-registrations of existing PEs (or
+   PE IDs occurring more than once within the array) are handled by the
+   regular registration, in between. Returns the number of successful
+   registrations.
+*/
+size_t ST_CLASS(poolHandlespaceManagementRegisterPoolElementsBulk)(
+          struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+          struct ST_CLASS(PoolElementRegistration)*   registrationArray,
+          const size_t                                registrations,
+          const unsigned long long                    currentTimeStamp)
+{
+   struct ST_CLASS(PoolElementRegistration)** sortedArray;
+   struct ST_CLASS(PoolElementRegistration)*  registration;
+   struct ST_CLASS(PoolElementNode)**         poolElementNodeArray;
+   struct ST_CLASS(PoolNode)*                 poolNode;
+   size_t                                     sortedRegistrations;
+   size_t                                     successful;
+   size_t                                     first, last, i;
+
+   sortedArray          = (struct ST_CLASS(PoolElementRegistration)**)malloc(
+                             registrations * sizeof(struct ST_CLASS(PoolElementRegistration)*));
+   poolElementNodeArray = (struct ST_CLASS(PoolElementNode)**)malloc(
+                             registrations * sizeof(struct ST_CLASS(PoolElementNode)*));
+   if((sortedArray == NULL) || (poolElementNodeArray == NULL)) {
+      /* Out of memory -> register all PEs one by one */
+      free(sortedArray);
+      free(poolElementNodeArray);
+      sortedArray = NULL;
+      for(i = 0;i < registrations;i++) {
+         registrationArray[i].PoolElementNode = NULL;
+         registrationArray[i].ErrorCode       = RSPERR_DUPLICATE_ID;
+      }
+   }
+
+   /* ====== Check registrations and sort them by pool handle and PE ID == */
+   else {
+      sortedRegistrations = 0;
+      for(i = 0;i < registrations;i++) {
+         registration = &registrationArray[i];
+         registration->PoolElementNode = NULL;
+         if((registration->Handle->Size < 1) || (registration->Handle->Size > MAX_POOLHANDLESIZE)) {
+            registration->ErrorCode = RSPERR_INVALID_POOL_HANDLE;
+         }
+         else if(ST_CLASS(poolPolicyGetPoolPolicyByType)(registration->PolicySettings->PolicyType) == NULL) {
+            registration->ErrorCode = RSPERR_INVALID_POOL_POLICY;
+         }
+         else {
+            /* RSPERR_DUPLICATE_ID marks entries for the regular registration */
+            registration->ErrorCode = RSPERR_DUPLICATE_ID;
+            sortedArray[sortedRegistrations++] = registration;
+         }
+      }
+      qsort(sortedArray, sortedRegistrations, sizeof(struct ST_CLASS(PoolElementRegistration)*),
+            ST_CLASS(poolElementRegistrationComparison));
+
+      /* ====== Find registrations of new PEs ============================ */
+      /* RSPERR_OKAY marks the first registration of a PE not yet in the
+         handlespace, to be added in bulk. */
+      for(first = 0;first < sortedRegistrations;first = last) {
+         for(last = first + 1;last < sortedRegistrations;last++) {
+            if(poolHandleComparison(sortedArray[first]->Handle, sortedArray[last]->Handle) != 0) {
+               break;
+            }
+         }
+         poolNode = ST_CLASS(poolHandlespaceNodeFindPoolNode)(&poolHandlespaceManagement->Handlespace,
+                                                              sortedArray[first]->Handle);
+         for(i = first;i < last;i++) {
+            if( ((i == first) || (sortedArray[i - 1]->Identifier != sortedArray[i]->Identifier)) &&
+                ((poolNode == NULL) ||
+                 (ST_CLASS(poolNodeFindPoolElementNode)(poolNode, sortedArray[i]->Identifier) == NULL)) ) {
+               sortedArray[i]->ErrorCode = RSPERR_OKAY;
+            }
+         }
+      }
+   }
+
+   /* ====== Register in array order ===================================== */
+   successful = 0;
+   for(first = 0;first < registrations;first = last) {
+      /* ====== Add run of new PEs in bulk ================================ */
+      for(last = first;last < registrations;last++) {
+         if(registrationArray[last].ErrorCode != RSPERR_OKAY) {
+            break;
+         }
+         sortedArray[last - first] = &registrationArray[last];
+      }
+      if(last > first) {
+         ST_CLASS(poolHandlespaceManagementAddPoolElementsBulk)(
+            poolHandlespaceManagement, sortedArray, last - first,
+            poolElementNodeArray, currentTimeStamp);
+         for(i = first;i < last;i++) {
+            if(registrationArray[i].ErrorCode == RSPERR_OKAY) {
+               ST_CLASS(poolHandlespaceNodeCompletePoolElementNodeAddition)(
+                  &poolHandlespaceManagement->Handlespace,
+                  registrationArray[i].PoolElementNode);
+               successful++;
+            }
+         }
+         continue;
+      }
+
+      /* ====== Regular registration ====================================== */
+      registration = &registrationArray[last++];
+      if(registration->ErrorCode == RSPERR_DUPLICATE_ID) {
+         registration->ErrorCode = ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
+                                      poolHandlespaceManagement,
+                                      registration->Handle,
+                                      registration->HomeRegistrarIdentifier,
+                                      registration->Identifier,
+                                      registration->RegistrationLife,
+                                      registration->PolicySettings,
+                                      registration->UserTransport,
+                                      registration->RegistratorTransport,
+                                      registration->ConnectionSocketDescriptor,
+                                      registration->ConnectionAssocID,
+                                      currentTimeStamp,
+                                      &registration->PoolElementNode);
+      }
+      if(registration->ErrorCode == RSPERR_OKAY) {
+         successful++;
+      }
+   }
+   free(sortedArray);
+   free(poolElementNodeArray);
+
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceNodeVerifyChange)(&poolHandlespaceManagement->Handlespace, NULL);
+#endif
+   return(successful);
+}
+
+
 /* ###### Get textual description ######################################## */
 void ST_CLASS(poolHandlespaceManagementGetDescription)(
         const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
@@ -301,6 +848,35 @@ void ST_CLASS(poolHandlespaceManagementVerify)(
               struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement)
 {
    ST_CLASS(poolHandlespaceNodeVerify)(&poolHandlespaceManagement->Handlespace);
+   if( (poolHandlespaceManagement->ViewPublisher) &&
+       (poolHandlespaceManagement->ViewPublisher->CurrentView) ) {
+      poolHandlespaceViewVerify(poolHandlespaceManagement->ViewPublisher->CurrentView);
+   }
+}
+
+
+/* ###### Verify structures after a change ############################## */
+/*
+   poolHandle is the pool changed, or NULL. With VERIFY_BUDGET defined,
+   the verification is incremental, see
+   poolHandlespaceNodeVerifyIncremental(); the published view is verified
+   whenever a sweep over all pools has been completed.
+*/
+void ST_CLASS(poolHandlespaceManagementVerifyChange)(
+        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        const struct PoolHandle*                    poolHandle)
+{
+#ifdef VERIFY_BUDGET
+   if( (ST_CLASS(poolHandlespaceNodeVerifyIncremental)(&poolHandlespaceManagement->Handlespace,
+                                                       poolHandle, VERIFY_BUDGET)) &&
+       (poolHandlespaceManagement->ViewPublisher) &&
+       (poolHandlespaceManagement->ViewPublisher->CurrentView) ) {
+      poolHandlespaceViewVerify(poolHandlespaceManagement->ViewPublisher->CurrentView);
+   }
+#else
+   (void)poolHandle;
+   ST_CLASS(poolHandlespaceManagementVerify)(poolHandlespaceManagement);
+#endif
 }
 
 
@@ -333,10 +909,12 @@ unsigned int ST_CLASS(poolHandlespaceManagementDeregisterPoolElementByPtr)(
          &poolHandlespaceManagement->Handlespace, poolNode);
       ST_CLASS(poolNodeDelete)(poolNode);
       ST_CLASS(poolHandlespaceManagementPoolNodeDisposer)(poolNode, poolHandlespaceManagement);
+      poolNode = NULL;
    }
 #ifdef VERIFY
 #warning VERIFY is on! The Handlespace Management will be very slow!
-      ST_CLASS(poolHandlespaceNodeVerify)(&poolHandlespaceManagement->Handlespace);
+      ST_CLASS(poolHandlespaceNodeVerifyChange)(&poolHandlespaceManagement->Handlespace,
+                                                (poolNode != NULL) ? &poolNode->Handle : NULL);
 #endif
    return(RSPERR_OKAY);
 }
@@ -398,6 +976,19 @@ void ST_CLASS(poolHandlespaceManagementUpdateOwnershipOfPoolElementNode)(
 }
 
 
+/* ###### Transfer ownership of all PEs of a PR ######################### */
+size_t ST_CLASS(poolHandlespaceManagementTransferOwnershipOfPoolElementNodes)(
+          struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+          const RegistrarIdentifierType               oldHomeRegistrarIdentifier,
+          const RegistrarIdentifierType               newHomeRegistrarIdentifier)
+{
+   return(ST_CLASS(poolHandlespaceNodeTransferOwnershipOfPoolElementNodes)(
+             &poolHandlespaceManagement->Handlespace,
+             oldHomeRegistrarIdentifier,
+             newHomeRegistrarIdentifier));
+}
+
+
 /* ###### Update PoolElementNode's connection ############################ */
 void ST_CLASS(poolHandlespaceManagementUpdateConnectionOfPoolElementNode)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
@@ -431,7 +1022,7 @@ unsigned int ST_CLASS(poolHandlespaceManagementHandleResolution)(
                           &errorCode);
 #ifdef VERIFY
 #warning VERIFY is on! The Handlespace Management will be very slow!
-   ST_CLASS(poolHandlespaceNodeVerify)(&poolHandlespaceManagement->Handlespace);
+   ST_CLASS(poolHandlespaceNodeVerifyChange)(&poolHandlespaceManagement->Handlespace, poolHandle);
 #endif
 
 #ifdef PRINT_SELECTION_RESULT
@@ -452,6 +1043,180 @@ unsigned int ST_CLASS(poolHandlespaceManagementHandleResolution)(
 }
 
 
+/* ###### Request order of pool handles ################################# */
+/*
+   The requests only have to be grouped by pool, so interned pool handles
+   are simply ordered by their identifiers. If there is any pool handle
+   which is not interned, all requests are ordered by
+   poolHandleComparison() instead.
+*/
+static int ST_CLASS(handleResolutionRequestPoolComparison)(
+              const struct ST_CLASS(HandleResolutionRequest)* request1,
+              const struct ST_CLASS(HandleResolutionRequest)* request2,
+              const int                                       interned)
+{
+   if(interned) {
+      if(request1->Handle->Identifier < request2->Handle->Identifier) {
+         return(-1);
+      }
+      else if(request1->Handle->Identifier > request2->Handle->Identifier) {
+         return(1);
+      }
+      return(0);
+   }
+   return(poolHandleComparison(request1->Handle, request2->Handle));
+}
+
+
+/* ###### Request sorting order: pool handle, array order ################ */
+static int ST_CLASS(handleResolutionRequestOrder)(const void* ptr1, const void* ptr2,
+                                                  const int interned)
+{
+   const struct ST_CLASS(HandleResolutionRequest)* request1 =
+      *((const struct ST_CLASS(HandleResolutionRequest)**)ptr1);
+   const struct ST_CLASS(HandleResolutionRequest)* request2 =
+      *((const struct ST_CLASS(HandleResolutionRequest)**)ptr2);
+   const int cmpResult = ST_CLASS(handleResolutionRequestPoolComparison)(request1, request2, interned);
+
+   if(cmpResult != 0) {
+      return(cmpResult);
+   }
+   if(request1 < request2) {
+      return(-1);
+   }
+   else if(request1 > request2) {
+      return(1);
+   }
+   return(0);
+}
+
+static int ST_CLASS(handleResolutionRequestComparison)(const void* ptr1, const void* ptr2)
+{
+   return(ST_CLASS(handleResolutionRequestOrder)(ptr1, ptr2, 0));
+}
+
+static int ST_CLASS(handleResolutionRequestInternedComparison)(const void* ptr1, const void* ptr2)
+{
+   return(ST_CLASS(handleResolutionRequestOrder)(ptr1, ptr2, 1));
+}
+
+
+#define HANDLERESOLUTION_INSERTION_SORT_THRESHOLD 32
+
+/* ###### Batched handle resolution ###################################### */
+/*
+   Resolves all requests of requestArray. Each request gets the next
+   MaxHandleResolutionItems entries of poolElementNodeArray, in array
+   order; requests not fitting into maxPoolElementNodes entries fail with
+   RSPERR_BUFFERSIZE_EXCEEDED. The requests are handled pool by pool, so
+   each pool is looked up once; requests for the same pool are handled
+   in array order, i.e. with the same result as calling
+   poolHandlespaceManagementHandleResolution() for each of them (but
+   random numbers may be drawn in another order across pools).
+   Returns the total number of selected PEs.
+*/
+size_t ST_CLASS(poolHandlespaceManagementHandleResolutions)(
+          struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+          struct ST_CLASS(HandleResolutionRequest)*   requestArray,
+          const size_t                                requests,
+          struct ST_CLASS(PoolElementNode)**          poolElementNodeArray,
+          const size_t                                maxPoolElementNodes)
+{
+   struct ST_CLASS(HandleResolutionRequest)** sortedArray;
+   struct ST_CLASS(HandleResolutionRequest)*  request;
+   struct ST_CLASS(PoolNode)*                 poolNode;
+   size_t                                     sortedRequests;
+   size_t                                     poolElementNodes;
+   size_t                                     i, j;
+   int                                        interned;
+
+   /* ====== Get sorting space =========================================== */
+   if(poolHandlespaceManagement->HandleResolutionScratchSize < requests) {
+      sortedArray = (struct ST_CLASS(HandleResolutionRequest)**)realloc(
+                       poolHandlespaceManagement->HandleResolutionScratch,
+                       requests * sizeof(struct ST_CLASS(HandleResolutionRequest)*));
+      if(sortedArray == NULL) {
+         for(i = 0;i < requests;i++) {
+            requestArray[i].ErrorCode            = RSPERR_OUT_OF_MEMORY;
+            requestArray[i].FirstPoolElementNode = 0;
+            requestArray[i].PoolElementNodes     = 0;
+         }
+         return(0);
+      }
+      poolHandlespaceManagement->HandleResolutionScratch     = sortedArray;
+      poolHandlespaceManagement->HandleResolutionScratchSize = requests;
+   }
+   sortedArray = poolHandlespaceManagement->HandleResolutionScratch;
+
+   /* ====== Assign output space and sort requests by pool =============== */
+   poolElementNodes = 0;
+   sortedRequests   = 0;
+   interned         = 1;
+   for(i = 0;i < requests;i++) {
+      request = &requestArray[i];
+      if(request->Handle->Identifier == 0) {
+         interned = 0;
+      }
+      request->FirstPoolElementNode = poolElementNodes;
+      request->PoolElementNodes     = 0;
+      if(request->MaxHandleResolutionItems > maxPoolElementNodes - poolElementNodes) {
+         request->ErrorCode = RSPERR_BUFFERSIZE_EXCEEDED;
+      }
+      else {
+         poolElementNodes += request->MaxHandleResolutionItems;
+         sortedArray[sortedRequests++] = request;
+      }
+   }
+   if(sortedRequests <= HANDLERESOLUTION_INSERTION_SORT_THRESHOLD) {
+      /* Bursts are usually small: insertion sort, which keeps array order */
+      for(i = 1;i < sortedRequests;i++) {
+         request = sortedArray[i];
+         for(j = i;j > 0;j--) {
+            if(ST_CLASS(handleResolutionRequestPoolComparison)(sortedArray[j - 1], request, interned) <= 0) {
+               break;
+            }
+            sortedArray[j] = sortedArray[j - 1];
+         }
+         sortedArray[j] = request;
+      }
+   }
+   else {
+      qsort(sortedArray, sortedRequests, sizeof(struct ST_CLASS(HandleResolutionRequest)*),
+            (interned) ? ST_CLASS(handleResolutionRequestInternedComparison) :
+                         ST_CLASS(handleResolutionRequestComparison));
+   }
+
+   /* ====== Select PEs pool by pool ===================================== */
+   poolElementNodes = 0;
+   poolNode         = NULL;
+   for(i = 0;i < sortedRequests;i++) {
+      request = sortedArray[i];
+      if( (i == 0) ||
+          (ST_CLASS(handleResolutionRequestPoolComparison)(sortedArray[i - 1], request, interned) != 0) ) {
+         poolNode = ST_CLASS(poolHandlespaceNodeFindPoolNode)(&poolHandlespaceManagement->Handlespace,
+                                                              request->Handle);
+      }
+      if(poolNode != NULL) {
+         request->ErrorCode        = RSPERR_OKAY;
+         request->PoolElementNodes = poolNode->Policy->SelectionFunction(
+                                        poolNode,
+                                        &poolElementNodeArray[request->FirstPoolElementNode],
+                                        request->MaxHandleResolutionItems,
+                                        request->MaxIncrement);
+         poolElementNodes += request->PoolElementNodes;
+      }
+      else {
+         request->ErrorCode = RSPERR_NOT_FOUND;
+      }
+   }
+
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceNodeVerifyChange)(&poolHandlespaceManagement->Handlespace, NULL);
+#endif
+   return(poolElementNodes);
+}
+
+
 /* ###### Get name table from handlespace ################################## */
 static int ST_CLASS(getOwnershipHandleTable)(
               struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
@@ -627,6 +1392,370 @@ int ST_CLASS(poolHandlespaceManagementGetHandleTable)(
 }
 
 
+/* ###### Get handlespace version ######################################## */
+unsigned long long ST_CLASS(poolHandlespaceManagementGetModificationSequence)(
+                      const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement)
+{
+   return(ST_CLASS(poolHandlespaceNodeGetModificationSequence)(&poolHandlespaceManagement->Handlespace));
+}
+
+
+/* ###### Set maximum number of tombstones ############################### */
+void ST_CLASS(poolHandlespaceManagementSetMaxTombstones)(
+        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+        const size_t                                maxTombstones)
+{
+   ST_CLASS(poolHandlespaceNodeSetMaxTombstones)(&poolHandlespaceManagement->Handlespace,
+                                                 maxTombstones);
+}
+
+
+/* ###### Enable or disable alias table draws for policy ################ */
+/*
+   Applies to the pools created afterwards. For the same random numbers,
+   alias table draws choose other PEs than the selection index, i.e. the
+   simulation results change. Returns 0 for policies not supporting it.
+*/
+int ST_CLASS(poolHandlespaceManagementSetAliasTableSelection)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+       const unsigned int                          policyType,
+       const int                                   enable)
+{
+   const struct ST_CLASS(PoolPolicy)* poolPolicy = ST_CLASS(poolPolicyGetPoolPolicyByType)(policyType);
+   unsigned int                       bit;
+
+   if((poolPolicy == NULL) || (!poolPolicy->SelectionByAliasTable)) {
+      return(0);
+   }
+   bit = 1U << (unsigned int)(poolPolicy - ST_CLASS(PoolPolicyArray));
+   if(enable) {
+      poolHandlespaceManagement->AliasTablePolicies |= bit;
+   }
+   else {
+      poolHandlespaceManagement->AliasTablePolicies &= ~bit;
+   }
+   return(1);
+}
+
+
+/* ###### Check, if changes since given version are available ############ */
+int ST_CLASS(poolHandlespaceManagementHasChangesSince)(
+       const struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+       const unsigned long long                          version)
+{
+   return(ST_CLASS(poolHandlespaceNodeHasChangesSince)(&poolHandlespaceManagement->Handlespace,
+                                                       version));
+}
+
+
+/* ###### Get changes since given version from handlespace ############### */
+/*
+   Fills the extract with up to maxElements PEs and tombstones. Entries
+   not owned by homeRegistrarIdentifier are skipped with HTEF_OWNCHILDSONLY,
+   as well as tombstones of PEs which have been registered again at the same
+   owner (the PE itself is part of the changes then). An ownership transfer
+   leaves a tombstone of the previous owner, so that the changes of the
+   previous owner tell the peers to drop the PE. So, an extract with
+   less than maxElements entries is the last one.
+*/
+int ST_CLASS(poolHandlespaceManagementGetHandleTableChanges)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
+       const RegistrarIdentifierType               homeRegistrarIdentifier,
+       const unsigned long long                    sinceVersion,
+       struct ST_CLASS(HandleTableChangesExtract)* handleTableChangesExtract,
+       const unsigned int                          flags,
+       size_t                                      maxElements)
+{
+   struct ST_CLASS(PoolHandlespaceNode)*        poolHandlespaceNode = &poolHandlespaceManagement->Handlespace;
+   struct ST_CLASS(PoolElementNode)*            poolElementNode;
+   const struct ST_CLASS(PoolElementNode)*      currentPoolElementNode;
+   const struct ST_CLASS(PoolElementTombstone)* tombstone;
+
+   if(maxElements > NTE_MAX_POOL_ELEMENT_NODES) {
+      maxElements = NTE_MAX_POOL_ELEMENT_NODES;
+   }
+   else if(maxElements < 1) {
+      return(0);
+   }
+   if(flags & HTEF_START) {
+      handleTableChangesExtract->LastVersion = sinceVersion;
+   }
+   CHECK(ST_CLASS(poolHandlespaceNodeHasChangesSince)(poolHandlespaceNode,
+                                                      handleTableChangesExtract->LastVersion));
+   handleTableChangesExtract->PoolElementNodes = 0;
+   handleTableChangesExtract->Tombstones       = 0;
+
+   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementModifiedSince)(
+                        poolHandlespaceNode, handleTableChangesExtract->LastVersion);
+   tombstone       = ST_CLASS(poolHandlespaceNodeGetFirstTombstoneSince)(
+                        poolHandlespaceNode, handleTableChangesExtract->LastVersion);
+   while( ((poolElementNode != NULL) || (tombstone != NULL)) &&
+          (handleTableChangesExtract->PoolElementNodes + handleTableChangesExtract->Tombstones < maxElements) ) {
+      if( (tombstone == NULL) ||
+          ((poolElementNode != NULL) &&
+           (poolElementNode->ModificationSequence < tombstone->ModificationSequence)) ) {
+         if( (!(flags & HTEF_OWNCHILDSONLY)) ||
+             (poolElementNode->HomeRegistrarIdentifier == homeRegistrarIdentifier) ) {
+            handleTableChangesExtract->PoolElementNodeArray[handleTableChangesExtract->PoolElementNodes++] = poolElementNode;
+         }
+         handleTableChangesExtract->LastVersion = poolElementNode->ModificationSequence;
+         poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextModifiedPoolElementNode)(
+                              poolHandlespaceNode, poolElementNode);
+      }
+      else {
+         if( (!(flags & HTEF_OWNCHILDSONLY)) ||
+             (tombstone->HomeRegistrarIdentifier == homeRegistrarIdentifier) ) {
+            currentPoolElementNode = ST_CLASS(poolHandlespaceNodeFindPoolElementNode)(
+                                        poolHandlespaceNode, &tombstone->Handle, tombstone->Identifier);
+            if( (currentPoolElementNode == NULL) ||
+                (currentPoolElementNode->HomeRegistrarIdentifier != tombstone->HomeRegistrarIdentifier) ) {
+               handleTableChangesExtract->TombstoneArray[handleTableChangesExtract->Tombstones++] = tombstone;
+            }
+         }
+         handleTableChangesExtract->LastVersion = tombstone->ModificationSequence;
+         tombstone = ST_CLASS(poolHandlespaceNodeGetNextTombstone)(poolHandlespaceNode, tombstone);
+      }
+   }
+
+   return((handleTableChangesExtract->PoolElementNodes + handleTableChangesExtract->Tombstones) > 0);
+}
+
+
+/* ###### Mark pools changed since the published view ################### */
+static void ST_CLASS(poolHandlespaceManagementInvalidatePoolViews)(
+               struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement)
+{
+   struct ST_CLASS(PoolHandlespaceNode)*        poolHandlespaceNode = &poolHandlespaceManagement->Handlespace;
+   struct ST_CLASS(PoolNode)*                   poolNode;
+   struct ST_CLASS(PoolElementNode)*            poolElementNode;
+   const struct ST_CLASS(PoolElementTombstone)* tombstone;
+   const unsigned long long                     version = poolHandlespaceManagement->ViewVersion;
+
+   if( (poolHandlespaceManagement->ViewPublisher->CurrentView == NULL) ||
+       (!ST_CLASS(poolHandlespaceNodeHasChangesSince)(poolHandlespaceNode, version)) ) {
+      /* Changes are unknown -> all pools have to be rebuilt */
+      poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+      while(poolNode != NULL) {
+         poolNode->View = NULL;
+         poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
+      }
+      return;
+   }
+
+   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementModifiedSince)(poolHandlespaceNode, version);
+   while(poolElementNode != NULL) {
+      poolElementNode->OwnerPoolNode->View = NULL;
+      poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextModifiedPoolElementNode)(poolHandlespaceNode, poolElementNode);
+   }
+   tombstone = ST_CLASS(poolHandlespaceNodeGetFirstTombstoneSince)(poolHandlespaceNode, version);
+   while(tombstone != NULL) {
+      poolNode = ST_CLASS(poolHandlespaceNodeFindPoolNode)(poolHandlespaceNode, &tombstone->Handle);
+      if(poolNode != NULL) {
+         poolNode->View = NULL;
+      }
+      tombstone = ST_CLASS(poolHandlespaceNodeGetNextTombstone)(poolHandlespaceNode, tombstone);
+   }
+}
+
+
+/* ###### Count first PEs of equal rank ################################# */
+/*
+   The sorting order policies order by their keys and then by SeqNumber,
+   i.e. PEs of equal rank only differ in their sequence numbers.
+*/
+static size_t ST_CLASS(poolHandlespaceManagementCountTiedPoolElements)(
+                 struct ST_CLASS(PoolNode)* poolNode)
+{
+   const struct ST_CLASS(PoolElementNode)* firstPoolElementNode;
+   struct ST_CLASS(PoolElementNode)*       poolElementNode;
+   struct ST_CLASS(PoolElementNode)        rankedPoolElementNode;
+   size_t                                  tiedPoolElements = 0;
+
+   firstPoolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+   poolElementNode      = (struct ST_CLASS(PoolElementNode)*)firstPoolElementNode;
+   while(poolElementNode != NULL) {
+      rankedPoolElementNode           = *poolElementNode;
+      rankedPoolElementNode.SeqNumber = firstPoolElementNode->SeqNumber;
+      if(poolNode->Policy->ComparisonFunction(firstPoolElementNode, &rankedPoolElementNode) != 0) {
+         break;
+      }
+      tiedPoolElements++;
+      poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
+   }
+   return(tiedPoolElements);
+}
+
+
+/* ###### Build view of a pool ########################################### */
+/*
+   The rotation continues from previousPoolView, the pool's view in the
+   published handlespace view (if any).
+*/
+static struct PoolView* ST_CLASS(poolHandlespaceManagementNewPoolView)(
+                           struct ST_CLASS(PoolNode)* poolNode,
+                           const struct PoolView*     previousPoolView)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct PoolView*                  poolView;
+   unsigned int                      selectionMode;
+   size_t                            i;
+
+   if( (poolNode->Policy->Type == PPT_ROUNDROBIN) ||
+       (poolNode->Policy->Type == PPT_WEIGHTED_ROUNDROBIN) ) {
+      selectionMode = PVSM_ROTATING;
+   }
+   else if(poolNode->Policy->SelectionByValueTree) {
+      selectionMode = PVSM_BY_VALUE;
+   }
+   else {
+      selectionMode = PVSM_IN_ORDER;
+   }
+
+   poolView = poolViewNew(&poolNode->Handle, poolNode->Policy->Type,
+                          poolNode->Protocol, poolNode->Flags, selectionMode,
+                          ST_CLASS(poolNodeGetPoolElementNodes)(poolNode));
+   if(poolView != NULL) {
+      i = 0;
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+      while(poolElementNode != NULL) {
+         if(!poolViewSetPoolElement(poolView, i++,
+                                    poolElementNode->Identifier,
+                                    poolElementNode->HomeRegistrarIdentifier,
+                                    poolElementNode->RegistrationLife,
+                                    poolElementNode->PoolElementSelectionStorageNode.Value,
+                                    &poolElementNode->PolicySettings,
+                                    poolElementNode->UserTransport)) {
+            poolView->PoolElements = i - 1;
+            poolViewDelete(poolView);
+            return(NULL);
+         }
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
+      }
+      CHECK(i == poolView->PoolElements);
+      poolViewBuildSelectionTable(poolView);
+      if(selectionMode == PVSM_IN_ORDER) {
+         poolView->TiedPoolElements = ST_CLASS(poolHandlespaceManagementCountTiedPoolElements)(poolNode);
+      }
+      if(previousPoolView != NULL) {
+         poolView->RotationCounter = __atomic_load_n(&previousPoolView->RotationCounter, __ATOMIC_RELAXED);
+      }
+   }
+   return(poolView);
+}
+
+
+/* ###### Enable concurrent readers ###################################### */
+/*
+   Reader threads may then use the view publisher, see
+   poolhandlespaceview.h. The handlespace itself remains single-threaded:
+   changes become visible to the readers by
+   poolHandlespaceManagementPublishView(). The readers' selections are
+   an approximation, which does not update the handlespace.
+*/
+int ST_CLASS(poolHandlespaceManagementEnableConcurrentReaders)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement)
+{
+   if(poolHandlespaceManagement->ViewPublisher == NULL) {
+      poolHandlespaceManagement->ViewPublisher =
+         (struct PoolHandlespaceViewPublisher*)malloc(sizeof(struct PoolHandlespaceViewPublisher));
+      if(poolHandlespaceManagement->ViewPublisher == NULL) {
+         return(0);
+      }
+      poolHandlespaceViewPublisherNew(poolHandlespaceManagement->ViewPublisher);
+   }
+   return(ST_CLASS(poolHandlespaceManagementPublishView)(poolHandlespaceManagement));
+}
+
+
+/* ###### Publish view of current handlespace ############################ */
+/*
+   Only the pools changed since the last publication are rebuilt; the
+   views of the other ones are shared. A rebuilt pool is copied
+   completely, i.e. the costs are in the number of PEs of the changed
+   pools, not in the number of changes. Returns 0 if the view could not
+   be built; the previous one then remains published.
+*/
+int ST_CLASS(poolHandlespaceManagementPublishView)(
+       struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement)
+{
+   struct PoolHandlespaceViewPublisher* publisher = poolHandlespaceManagement->ViewPublisher;
+   struct PoolHandlespaceView*          poolHandlespaceView;
+   struct ST_CLASS(PoolNode)*           poolNode;
+   const unsigned long long             version =
+      ST_CLASS(poolHandlespaceNodeGetModificationSequence)(&poolHandlespaceManagement->Handlespace);
+   size_t                               i, j;
+
+   CHECK(publisher != NULL);
+   if( (publisher->CurrentView != NULL) &&
+       (version == poolHandlespaceManagement->ViewVersion) ) {
+      poolHandlespaceViewPublisherReclaim(publisher);
+      return(1);
+   }
+
+   ST_CLASS(poolHandlespaceManagementInvalidatePoolViews)(poolHandlespaceManagement);
+   poolHandlespaceView = poolHandlespaceViewNew(
+      ST_CLASS(poolHandlespaceNodeGetPoolNodes)(&poolHandlespaceManagement->Handlespace));
+   if(poolHandlespaceView == NULL) {
+      return(0);
+   }
+
+   /* ====== Collect pool views, building the outdated ones ============= */
+   i = 0;
+   poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(&poolHandlespaceManagement->Handlespace);
+   while(poolNode != NULL) {
+      if(poolNode->View != NULL) {
+         poolHandlespaceView->PoolArray[i] = poolNode->View;
+      }
+      else {
+         poolHandlespaceView->PoolArray[i] = ST_CLASS(poolHandlespaceManagementNewPoolView)(
+                                                poolNode,
+                                                (publisher->CurrentView != NULL) ?
+                                                   poolHandlespaceViewFindPool(publisher->CurrentView, &poolNode->Handle) :
+                                                   NULL);
+         if(poolHandlespaceView->PoolArray[i] == NULL) {
+            break;
+         }
+      }
+      poolHandlespaceView->PoolElements += poolHandlespaceView->PoolArray[i]->PoolElements;
+      i++;
+      poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(&poolHandlespaceManagement->Handlespace, poolNode);
+   }
+   if(poolNode != NULL) {
+      /* Out of memory -> undo */
+      poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(&poolHandlespaceManagement->Handlespace);
+      for(j = 0;j < i;j++) {
+         if(poolNode->View == NULL) {
+            poolViewDelete(poolHandlespaceView->PoolArray[j]);
+         }
+         poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(&poolHandlespaceManagement->Handlespace, poolNode);
+      }
+      poolHandlespaceViewDelete(poolHandlespaceView);
+      return(0);
+   }
+
+   /* ====== Publish ==================================================== */
+   i = 0;
+   poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(&poolHandlespaceManagement->Handlespace);
+   while(poolNode != NULL) {
+      poolNode->View = poolHandlespaceView->PoolArray[i++];
+      poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(&poolHandlespaceManagement->Handlespace, poolNode);
+   }
+   poolHandlespaceView->Version = version;
+   poolHandlespaceViewPublisherPublish(publisher, poolHandlespaceView);
+   poolHandlespaceManagement->ViewVersion = version;
+   return(1);
+}
+
+
+/* ###### Get view publisher ############################################# */
+/* NULL, if concurrent readers are not enabled */
+struct PoolHandlespaceViewPublisher* ST_CLASS(poolHandlespaceManagementGetViewPublisher)(
+                                        struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement)
+{
+   return(poolHandlespaceManagement->ViewPublisher);
+}
+
+
 /* ###### Restart PE expiry timer to last update TS + expiry timeout ##### */
 void ST_CLASS(poolHandlespaceManagementRestartPoolElementExpiryTimer)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
@@ -643,14 +1772,57 @@ void ST_CLASS(poolHandlespaceManagementRestartPoolElementExpiryTimer)(
 
 
 /* ###### Purge handlespace from expired PE entries ######################## */
+/*
+   First, the expired timers of the sorted timer storage are purged. Then,
+   all expired ticks of the timer wheel are purged in bulk, i.e. without
+   sorting their timers into the storage first; within a tick, the PEs are
+   purged in the order their timers have been started. Finally, the timers
+   of the tick containing currentTimeStamp are fetched and purged, as far
+   as they have expired.
+*/
 size_t ST_CLASS(poolHandlespaceManagementPurgeExpiredPoolElements)(
           struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
           const unsigned long long                    currentTimeStamp)
 {
+   struct DoubleLinkedRingList       expiredList;
+   struct DoubleLinkedRingListNode*  listNode;
    struct ST_CLASS(PoolElementNode)* poolElementNode;
    struct ST_CLASS(PoolElementNode)* nextPoolElementNode;
    size_t                            purgedPoolElements = 0;
 
+   /* ====== Purge expired timers of the timer storage =================== */
+   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstStoredPoolElementTimerNode)(&poolHandlespaceManagement->Handlespace);
+   while( (poolElementNode != NULL) && (poolElementNode->TimerTimeStamp <= currentTimeStamp) ) {
+      CHECK(poolElementNode->TimerCode == PENT_EXPIRY);
+      ST_CLASS(poolHandlespaceManagementDeregisterPoolElementByPtr)(
+         poolHandlespaceManagement,
+         poolElementNode);
+      purgedPoolElements++;
+      poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstStoredPoolElementTimerNode)(&poolHandlespaceManagement->Handlespace);
+   }
+   if(poolElementNode != NULL) {
+      /* The wheel's timers are behind this one, i.e. not expired either. */
+      return(purgedPoolElements);
+   }
+
+   /* ====== Purge expired ticks of the timer wheel in bulk ============== */
+   doubleLinkedRingListNew(&expiredList);
+   ST_CLASS(poolHandlespaceNodeTakeExpiredPoolElementTimers)(&poolHandlespaceManagement->Handlespace,
+                                                             currentTimeStamp, &expiredList);
+   while(expiredList.Node.Next != &expiredList.Node) {
+      listNode = expiredList.Node.Next;
+      doubleLinkedRingListRemNode(listNode);
+      poolElementNode = ST_CLASS(getPoolElementNodeFromTimerWheelNode)(listNode);
+      CHECK(poolElementNode->TimerCode == PENT_EXPIRY);
+      CHECK(poolElementNode->TimerTimeStamp <= currentTimeStamp);
+      ST_CLASS(poolHandlespaceManagementDeregisterPoolElementByPtr)(
+         poolHandlespaceManagement,
+         poolElementNode);
+      purgedPoolElements++;
+   }
+   doubleLinkedRingListDelete(&expiredList);
+
+   /* ====== Purge expired timers of the current tick ==================== */
    poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementTimerNode)(&poolHandlespaceManagement->Handlespace);
    while(poolElementNode != NULL) {
       nextPoolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementTimerNode)(&poolHandlespaceManagement->Handlespace, poolElementNode);
@@ -680,21 +1852,15 @@ void ST_CLASS(poolHandlespaceManagementMarkPoolElementNodes)(
         struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
         const RegistrarIdentifierType ownerID)
 {
-   struct ST_CLASS(PoolElementNode)* poolElementNode;
-   struct ST_CLASS(PoolElementNode)* nextPoolElementNode;
-
-   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
-                        &poolHandlespaceManagement->Handlespace, ownerID);
-   while(poolElementNode) {
-      nextPoolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
-                               &poolHandlespaceManagement->Handlespace, poolElementNode);
-      poolElementNode->Flags |= PENF_MARKED;
-      poolElementNode = nextPoolElementNode;
-   }
+   ST_CLASS(poolHandlespaceNodeMarkPoolElementNodes)(&poolHandlespaceManagement->Handlespace, ownerID);
 }
 
 
 /* ###### Purge marked pool element nodes owned by given PR ############## */
+/*
+   Only the marked PEs are visited, i.e. the PEs not re-registered
+   since the last marking.
+*/
 size_t ST_CLASS(poolHandlespaceManagementPurgeMarkedPoolElementNodes)(
           struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement,
           const RegistrarIdentifierType ownerID)
@@ -703,16 +1869,14 @@ size_t ST_CLASS(poolHandlespaceManagementPurgeMarkedPoolElementNodes)(
    struct ST_CLASS(PoolElementNode)* nextPoolElementNode;
    size_t                            count = 0;
 
-   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstMarkedPoolElementNode)(
                         &poolHandlespaceManagement->Handlespace, ownerID);
    while(poolElementNode) {
-      nextPoolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+      nextPoolElementNode = ST_CLASS(poolHandlespaceNodeGetNextMarkedPoolElementNode)(
                                &poolHandlespaceManagement->Handlespace, poolElementNode);
-      if(poolElementNode->Flags & PENF_MARKED) {
-         CHECK(ST_CLASS(poolHandlespaceManagementDeregisterPoolElementByPtr)(
-                  poolHandlespaceManagement, poolElementNode) == RSPERR_OKAY);
-         count++;
-      }
+      CHECK(ST_CLASS(poolHandlespaceManagementDeregisterPoolElementByPtr)(
+               poolHandlespaceManagement, poolElementNode) == RSPERR_OKAY);
+      count++;
       poolElementNode = nextPoolElementNode;
    }
    return(count);
@@ -40,10 +40,20 @@
 #include "poolhandlespacemanagement-basics.h"
 #include "poolhandle.h"
 #include "poolpolicysettings.h"
+#include "doublelinkedringlist.h"
+#include "fenwicktree.h"
+#include "bucketqueue.h"
+#include "aliastable.h"
+#include "epochreclamation.h"
+#include "poolhandlespaceview.h"
+#include "identifierhashtable.h"
+#include "slaballocator.h"
+#include "timingwheel.h"
 #include "transportaddressblock.h"
 #include "stringutilities.h"
 
 #include <math.h>
+#include <pthread.h>
 
 
 #ifdef INCLUDE_LINEARLIST
@@ -67,6 +77,12 @@
 #ifdef INCLUDE_LEAFLINKEDREDBLACKTREE
 #include "leaflinkedredblacktree.h"
 #endif
+#ifdef INCLUDE_BPLUSTREE
+#include "bplustree.h"
+#endif
+#ifdef INCLUDE_COMPACTREDBLACKTREE
+#include "compactredblacktree.h"
+#endif
 
 
 #define INTERNAL_POOLTEMPLATE
@@ -84,6 +100,7 @@
 #include "poolnode-template.h"
 #include "poolhandlespacenode-template.h"
 #include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
 #include "peerlistnode-template.h"
 #include "peerlist-template.h"
 #include "peerlistmanagement-template.h"
@@ -96,6 +113,7 @@
 #include "poolnode-template_impl.h"
 #include "poolhandlespacenode-template_impl.h"
 #include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
 #include "peerlistnode-template_impl.h"
 #include "peerlist-template_impl.h"
 #include "peerlistmanagement-template_impl.h"
@@ -124,6 +142,7 @@
 #include "poolnode-template.h"
 #include "poolhandlespacenode-template.h"
 #include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
 #include "peerlistnode-template.h"
 #include "peerlist-template.h"
 #include "peerlistmanagement-template.h"
@@ -136,6 +155,7 @@
 #include "poolnode-template_impl.h"
 #include "poolhandlespacenode-template_impl.h"
 #include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
 #include "peerlistnode-template_impl.h"
 #include "peerlist-template_impl.h"
 #include "peerlistmanagement-template_impl.h"
@@ -165,6 +185,7 @@
 #include "poolnode-template.h"
 #include "poolhandlespacenode-template.h"
 #include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
 #include "peerlistnode-template.h"
 #include "peerlist-template.h"
 #include "peerlistmanagement-template.h"
@@ -177,6 +198,7 @@
 #include "poolnode-template_impl.h"
 #include "poolhandlespacenode-template_impl.h"
 #include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
 #include "peerlistnode-template_impl.h"
 #include "peerlist-template_impl.h"
 #include "peerlistmanagement-template_impl.h"
@@ -206,6 +228,7 @@
 #include "poolnode-template.h"
 #include "poolhandlespacenode-template.h"
 #include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
 #include "peerlistnode-template.h"
 #include "peerlist-template.h"
 #include "peerlistmanagement-template.h"
@@ -218,6 +241,7 @@
 #include "poolnode-template_impl.h"
 #include "poolhandlespacenode-template_impl.h"
 #include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
 #include "peerlistnode-template_impl.h"
 #include "peerlist-template_impl.h"
 #include "peerlistmanagement-template_impl.h"
@@ -247,6 +271,7 @@
 #include "poolnode-template.h"
 #include "poolhandlespacenode-template.h"
 #include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
 #include "peerlistnode-template.h"
 #include "peerlist-template.h"
 #include "peerlistmanagement-template.h"
@@ -259,6 +284,7 @@
 #include "poolnode-template_impl.h"
 #include "poolhandlespacenode-template_impl.h"
 #include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
 #include "peerlistnode-template_impl.h"
 #include "peerlist-template_impl.h"
 #include "peerlistmanagement-template_impl.h"
@@ -288,6 +314,7 @@
 #include "poolnode-template.h"
 #include "poolhandlespacenode-template.h"
 #include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
 #include "peerlistnode-template.h"
 #include "peerlist-template.h"
 #include "peerlistmanagement-template.h"
@@ -300,6 +327,7 @@
 #include "poolnode-template_impl.h"
 #include "poolhandlespacenode-template_impl.h"
 #include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
 #include "peerlistnode-template_impl.h"
 #include "peerlist-template_impl.h"
 #include "peerlistmanagement-template_impl.h"
@@ -329,6 +357,50 @@
 #include "poolnode-template.h"
 #include "poolhandlespacenode-template.h"
 #include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
+#include "peerlistnode-template.h"
+#include "peerlist-template.h"
+#include "peerlistmanagement-template.h"
+#include "poolusernode-template.h"
+#include "pooluserlist-template.h"
+
+#ifdef INTERNAL_POOLTEMPLATE_IMPLEMENT_IT
+#include "poolpolicy-template_impl.h"
+#include "poolelementnode-template_impl.h"
+#include "poolnode-template_impl.h"
+#include "poolhandlespacenode-template_impl.h"
+#include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
+#include "peerlistnode-template_impl.h"
+#include "peerlist-template_impl.h"
+#include "peerlistmanagement-template_impl.h"
+#include "poolusernode-template_impl.h"
+#include "pooluserlist-template_impl.h"
+#endif
+
+#undef STN_CLASSNAME
+#undef STN_METHOD
+#undef ST_CLASSNAME
+#undef ST_CLASS
+#undef ST_METHOD
+#endif
+
+
+
+
+#ifdef INCLUDE_BPLUSTREE
+#define STN_CLASSNAME BPlusTreeNode
+#define STN_METHOD(x) bPlusTreeNode##x
+#define ST_CLASSNAME BPlusTree
+#define ST_CLASS(x) x##_BPlusTree
+#define ST_METHOD(x) bPlusTree##x
+
+#include "poolpolicy-template.h"
+#include "poolelementnode-template.h"
+#include "poolnode-template.h"
+#include "poolhandlespacenode-template.h"
+#include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
 #include "peerlistnode-template.h"
 #include "peerlist-template.h"
 #include "peerlistmanagement-template.h"
@@ -341,6 +413,50 @@
 #include "poolnode-template_impl.h"
 #include "poolhandlespacenode-template_impl.h"
 #include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
+#include "peerlistnode-template_impl.h"
+#include "peerlist-template_impl.h"
+#include "peerlistmanagement-template_impl.h"
+#include "poolusernode-template_impl.h"
+#include "pooluserlist-template_impl.h"
+#endif
+
+#undef STN_CLASSNAME
+#undef STN_METHOD
+#undef ST_CLASSNAME
+#undef ST_CLASS
+#undef ST_METHOD
+#endif
+
+
+
+
+#ifdef INCLUDE_COMPACTREDBLACKTREE
+#define STN_CLASSNAME CompactRedBlackTreeNode
+#define STN_METHOD(x) compactRedBlackTreeNode##x
+#define ST_CLASSNAME CompactRedBlackTree
+#define ST_CLASS(x) x##_CompactRedBlackTree
+#define ST_METHOD(x) compactRedBlackTree##x
+
+#include "poolpolicy-template.h"
+#include "poolelementnode-template.h"
+#include "poolnode-template.h"
+#include "poolhandlespacenode-template.h"
+#include "poolhandlespacemanagement-template.h"
+#include "shardedpoolhandlespacemanagement-template.h"
+#include "peerlistnode-template.h"
+#include "peerlist-template.h"
+#include "peerlistmanagement-template.h"
+#include "poolusernode-template.h"
+#include "pooluserlist-template.h"
+
+#ifdef INTERNAL_POOLTEMPLATE_IMPLEMENT_IT
+#include "poolpolicy-template_impl.h"
+#include "poolelementnode-template_impl.h"
+#include "poolnode-template_impl.h"
+#include "poolhandlespacenode-template_impl.h"
+#include "poolhandlespacemanagement-template_impl.h"
+#include "shardedpoolhandlespacemanagement-template_impl.h"
 #include "peerlistnode-template_impl.h"
 #include "peerlist-template_impl.h"
 #include "peerlistmanagement-template_impl.h"
@@ -411,6 +527,20 @@
 #define ST_CLASS(x) x##_LeafLinkedRedBlackTree
 #define ST_METHOD(x) leafLinkedRedBlackTree##x
 #endif
+#ifdef USE_BPLUSTREE
+#define STN_CLASSNAME BPlusTreeNode
+#define STN_METHOD(x) bPlusTreeNode##x
+#define ST_CLASSNAME BPlusTree
+#define ST_CLASS(x) x##_BPlusTree
+#define ST_METHOD(x) bPlusTree##x
+#endif
+#ifdef USE_COMPACTREDBLACKTREE
+#define STN_CLASSNAME CompactRedBlackTreeNode
+#define STN_METHOD(x) compactRedBlackTreeNode##x
+#define ST_CLASSNAME CompactRedBlackTree
+#define ST_CLASS(x) x##_CompactRedBlackTree
+#define ST_METHOD(x) compactRedBlackTree##x
+#endif
 
 
 #ifdef __cplusplus
@@ -36,18 +36,76 @@ extern "C" {
 #endif
 
 
+/*
+   Mark generation of the PEs owned by a registrar. Marking all of its
+   PEs just increments Generation; a PE is marked while its Generation
+   differs. The owner's PEs are listed in order of their last refresh,
+   i.e. the marked PEs are at the head of the list.
+*/
+struct ST_CLASS(PoolElementOwnerGeneration)
+{
+   RegistrarIdentifierType             OwnerIdentifier;
+   unsigned int                        Generation;
+   struct DoubleLinkedRingList         PoolElementList;
+};
+
+
+/*
+   Deletion record of a PE, for exporting the changes since a given
+   handlespace version. Only the newest MaxTombstones records are kept;
+   TombstoneHorizon is the version of the newest discarded one.
+*/
+struct ST_CLASS(PoolElementTombstone)
+{
+   struct DoubleLinkedRingListNode     TombstoneListNode;
+   struct PoolHandle                   Handle;
+   PoolElementIdentifierType           Identifier;
+   RegistrarIdentifierType             HomeRegistrarIdentifier;
+   unsigned long long                  ModificationSequence;
+};
+
+#define HANDLESPACE_DEFAULT_MAX_TOMBSTONES 16384
+
+
+/*
+   Ownership digest tree: its root is the ownership checksum, its inner
+   nodes are the checksums of HANDLESPACE_DIGEST_BUCKETS buckets, each
+   covering the pools whose handles hash to it, and its leaves are the
+   pools' ownership checksums. Comparing it top-down narrows a checksum
+   mismatch to the pools that actually differ.
+   The checksums are additive, so each node is just the sum of its
+   children, and the depth is fixed: one request/response exchanges the
+   buckets and the pool digests of differing buckets. Only the home PR's
+   buckets are maintained incrementally; a peer's are computed from its
+   range of the ownership storage, in O(PEs owned by that peer).
+*/
+#define HANDLESPACE_DIGEST_BUCKETS 64
+
+
 struct ST_CLASS(PoolHandlespaceNode)
 {
    struct ST_CLASSNAME                 PoolIndexStorage;             /* Pools                          */
+   struct IdentifierHashTable          PoolHandleIndex;              /* Pools by pool handle ID        */
+   int                                 PoolHandleIndexValid;         /* PoolHandleIndex is up to date  */
    struct ST_CLASSNAME                 PoolElementTimerStorage;      /* PEs with timer event scheduled */
+   struct TimingWheel                  PoolElementTimerWheel;        /* PEs with timer beyond horizon  */
    struct ST_CLASSNAME                 PoolElementConnectionStorage; /* PEs by connection              */
    struct ST_CLASSNAME                 PoolElementOwnershipStorage;  /* PEs by ownership               */
+   struct IdentifierHashTable          OwnerGenerationIndex;         /* Mark generations by owner      */
+   struct DoubleLinkedRingList         PoolElementModificationList;  /* PEs by last modification       */
+   struct DoubleLinkedRingList         TombstoneList;                /* Deleted PEs by deletion        */
 
    HandlespaceChecksumAccumulatorType  HandlespaceChecksum;          /* Handlespace checksum           */
    HandlespaceChecksumAccumulatorType  OwnershipChecksum;            /* Ownership checksum             */
+   HandlespaceChecksumAccumulatorType  OwnershipDigestTree[HANDLESPACE_DIGEST_BUCKETS]; /* Digest tree buckets */
    RegistrarIdentifierType             HomeRegistrarIdentifier;      /* This NS's Identifier           */
    size_t                              PoolElements;                 /* Number of Pool Elements        */
    size_t                              OwnedPoolElements;            /* Number of owned Pool Elements  */
+   unsigned long long                  ModificationSequence;         /* Handlespace version            */
+   unsigned long long                  TombstoneHorizon;             /* Newest discarded tombstone     */
+   size_t                              Tombstones;                   /* Number of tombstones           */
+   size_t                              MaxTombstones;                /* Maximum number of tombstones   */
+   struct PoolHandle                   VerificationCursor;           /* Last pool verified by sweep    */
 
    void* NotificationUserData;
    void (*PoolNodeUpdateNotification)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
@@ -69,6 +127,9 @@ void ST_CLASS(poolHandlespaceNodeNew)(struct ST_CLASS(PoolHandlespaceNode)* pool
                                                                          void*                                 userData),
                                       void* notificationUserData);
 void ST_CLASS(poolHandlespaceNodeDelete)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
+void ST_CLASS(poolHandlespaceNodeAddMemoryUsage)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        struct HandlespaceMemoryUsage*        memoryUsage);
 HandlespaceChecksumAccumulatorType ST_CLASS(poolHandlespaceNodeGetHandlespaceChecksum)(
                                       const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
 HandlespaceChecksumAccumulatorType ST_CLASS(poolHandlespaceNodeGetOwnershipChecksum)(
@@ -78,8 +139,26 @@ HandlespaceChecksumAccumulatorType ST_CLASS(poolHandlespaceNodeComputeHandlespac
 HandlespaceChecksumAccumulatorType ST_CLASS(poolHandlespaceNodeComputeOwnershipChecksum)(
                                       const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
                                       const RegistrarIdentifierType               registrarIdentifier);
+unsigned int ST_CLASS(poolHandlespaceNodeGetOwnershipDigestBucket)(
+                const struct PoolHandle* poolHandle);
+void ST_CLASS(poolHandlespaceNodeComputeOwnershipDigestTree)(
+        const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const RegistrarIdentifierType               registrarIdentifier,
+        HandlespaceChecksumAccumulatorType*         digestTree);
+HandlespaceChecksumAccumulatorType ST_CLASS(poolHandlespaceNodeComputePoolOwnershipChecksum)(
+                                      const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                      const struct ST_CLASS(PoolNode)*            poolNode,
+                                      const RegistrarIdentifierType               registrarIdentifier);
+void ST_CLASS(poolHandlespaceNodeVerifyOwnershipDigestTree)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
 size_t ST_CLASS(poolHandlespaceNodeGetTimerNodes)(
           const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
+size_t ST_CLASS(poolHandlespaceNodeTakeExpiredPoolElementTimers)(
+          struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+          const unsigned long long              currentTimeStamp,
+          struct DoubleLinkedRingList*          expiredList);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstStoredPoolElementTimerNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstPoolElementTimerNode)(
                                      struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetNextPoolElementTimerNode)(
@@ -148,6 +227,10 @@ struct ST_CLASS(PoolNode)* ST_CLASS(poolHandlespaceNodeAddPoolNode)(
 struct ST_CLASS(PoolNode)* ST_CLASS(poolHandlespaceNodeFindPoolNode)(
                               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
                               const struct PoolHandle*              poolHandle);
+int ST_CLASS(poolHandlespaceNodeUpdatePoolHandleIndex)(
+       struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
+void ST_CLASS(poolHandlespaceNodeVerifyPoolHandleIndex)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
 struct ST_CLASS(PoolNode)* ST_CLASS(poolHandlespaceNodeFindNearestNextPoolNode)(
                               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
                               const struct PoolHandle*              poolHandle);
@@ -159,6 +242,14 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeAddPoolElementNode
                                      struct ST_CLASS(PoolNode)*            poolNode,
                                      struct ST_CLASS(PoolElementNode)*     poolElementNode,
                                      unsigned int*                         errorCode);
+void ST_CLASS(poolHandlespaceNodeAddPoolElementNodes)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        struct ST_CLASS(PoolNode)*            poolNode,
+        struct ST_CLASS(PoolElementNode)**    poolElementNodeArray,
+        const size_t                          poolElementNodes);
+void ST_CLASS(poolHandlespaceNodeCompletePoolElementNodeAddition)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        struct ST_CLASS(PoolElementNode)*     poolElementNode);
 struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeFindPoolElementNode)(
                                      struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
                                      const struct PoolHandle*              poolHandle,
@@ -167,6 +258,30 @@ void ST_CLASS(poolHandlespaceNodeUpdateOwnershipOfPoolElementNode)(
         struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
         struct ST_CLASS(PoolElementNode)*     poolElementNode,
         const RegistrarIdentifierType         newHomeRegistrarIdentifier);
+size_t ST_CLASS(poolHandlespaceNodeTransferOwnershipOfPoolElementNodes)(
+          struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+          const RegistrarIdentifierType         oldHomeRegistrarIdentifier,
+          const RegistrarIdentifierType         newHomeRegistrarIdentifier);
+unsigned long long ST_CLASS(poolHandlespaceNodeGetModificationSequence)(
+                      const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
+void ST_CLASS(poolHandlespaceNodeSetMaxTombstones)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const size_t                          maxTombstones);
+int ST_CLASS(poolHandlespaceNodeHasChangesSince)(
+       const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+       const unsigned long long                    version);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstPoolElementModifiedSince)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     const unsigned long long              version);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetNextModifiedPoolElementNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     struct ST_CLASS(PoolElementNode)*     poolElementNode);
+const struct ST_CLASS(PoolElementTombstone)* ST_CLASS(poolHandlespaceNodeGetFirstTombstoneSince)(
+                                                const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                                const unsigned long long                    version);
+const struct ST_CLASS(PoolElementTombstone)* ST_CLASS(poolHandlespaceNodeGetNextTombstone)(
+                                                const struct ST_CLASS(PoolHandlespaceNode)*  poolHandlespaceNode,
+                                                const struct ST_CLASS(PoolElementTombstone)* tombstone);
 void ST_CLASS(poolHandlespaceNodeUpdateConnectionOfPoolElementNode)(
         struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
         struct ST_CLASS(PoolElementNode)*     poolElementNode,
@@ -203,7 +318,27 @@ void ST_CLASS(poolHandlespaceNodeActivateTimer)(
 void ST_CLASS(poolHandlespaceNodeDeactivateTimer)(
         struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
         struct ST_CLASS(PoolElementNode)*     poolElementNode);
+void ST_CLASS(poolHandlespaceNodeMarkPoolElementNodes)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const RegistrarIdentifierType         ownerID);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstMarkedPoolElementNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     const RegistrarIdentifierType         ownerID);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetNextMarkedPoolElementNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     struct ST_CLASS(PoolElementNode)*     poolElementNode);
+void ST_CLASS(poolHandlespaceNodeVerifyOwnerGenerations)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
+void ST_CLASS(poolHandlespaceNodeVerifyModifications)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
 void ST_CLASS(poolHandlespaceNodeVerify)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode);
+int ST_CLASS(poolHandlespaceNodeVerifyIncremental)(
+       struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+       const struct PoolHandle*              poolHandle,
+       const size_t                          budget);
+void ST_CLASS(poolHandlespaceNodeVerifyChange)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const struct PoolHandle*              poolHandle);
 void ST_CLASS(poolHandlespaceNodeClear)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
                                         void                                  (*poolNodeDisposer)(void* poolNode, void* userData),
                                         void                                  (*poolElementNodeDisposer)(void* poolElementNode, void* userData),
@@ -37,16 +37,32 @@ void ST_CLASS(poolHandlespaceNodeNew)(struct ST_CLASS(PoolHandlespaceNode)* pool
                                                                          void*                                 userData),
                                       void* notificationUserData)
 {
+   unsigned int i;
+
    ST_METHOD(New)(&poolHandlespaceNode->PoolIndexStorage, ST_CLASS(poolIndexStorageNodePrint), ST_CLASS(poolIndexStorageNodeComparison));
+   identifierHashTableNew(&poolHandlespaceNode->PoolHandleIndex);
+   poolHandlespaceNode->PoolHandleIndexValid = 0;
    ST_METHOD(New)(&poolHandlespaceNode->PoolElementTimerStorage, ST_CLASS(poolElementTimerStorageNodePrint), ST_CLASS(poolElementTimerStorageNodeComparison));
+   timingWheelNew(&poolHandlespaceNode->PoolElementTimerWheel, TIMINGWHEEL_DEFAULT_GRANULARITY);
    ST_METHOD(New)(&poolHandlespaceNode->PoolElementOwnershipStorage, ST_CLASS(poolElementOwnershipStorageNodePrint), ST_CLASS(poolElementOwnershipStorageNodeComparison));
+   identifierHashTableNew(&poolHandlespaceNode->OwnerGenerationIndex);
+   doubleLinkedRingListNew(&poolHandlespaceNode->PoolElementModificationList);
+   doubleLinkedRingListNew(&poolHandlespaceNode->TombstoneList);
    ST_METHOD(New)(&poolHandlespaceNode->PoolElementConnectionStorage, ST_CLASS(poolElementConnectionStorageNodePrint), ST_CLASS(poolElementConnectionStorageNodeComparison));
 
    poolHandlespaceNode->HomeRegistrarIdentifier    = homeRegistrarIdentifier;
    poolHandlespaceNode->HandlespaceChecksum        = INITIAL_HANDLESPACE_CHECKSUM;
    poolHandlespaceNode->OwnershipChecksum          = INITIAL_HANDLESPACE_CHECKSUM;
+   for(i = 0;i < HANDLESPACE_DIGEST_BUCKETS;i++) {
+      poolHandlespaceNode->OwnershipDigestTree[i] = INITIAL_HANDLESPACE_CHECKSUM;
+   }
    poolHandlespaceNode->PoolElements               = 0;
    poolHandlespaceNode->OwnedPoolElements          = 0;
+   poolHandlespaceNode->ModificationSequence       = 0;
+   poolHandlespaceNode->TombstoneHorizon           = 0;
+   poolHandlespaceNode->Tombstones                 = 0;
+   poolHandlespaceNode->MaxTombstones              = HANDLESPACE_DEFAULT_MAX_TOMBSTONES;
+   poolHandlespaceNode->VerificationCursor.Size    = 0;
 
    poolHandlespaceNode->PoolNodeUpdateNotification = poolNodeUpdateNotification;
    poolHandlespaceNode->NotificationUserData       = notificationUserData;
@@ -56,18 +72,69 @@ void ST_CLASS(poolHandlespaceNodeNew)(struct ST_CLASS(PoolHandlespaceNode)* pool
 /* ###### Invalidate ##################################################### */
 void ST_CLASS(poolHandlespaceNodeDelete)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
 {
+   struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration;
+   size_t                                       i;
+
    CHECK(ST_METHOD(IsEmpty)(&poolHandlespaceNode->PoolIndexStorage));
    CHECK(ST_METHOD(IsEmpty)(&poolHandlespaceNode->PoolElementTimerStorage));
+   CHECK(timingWheelIsEmpty(&poolHandlespaceNode->PoolElementTimerWheel));
    CHECK(ST_METHOD(IsEmpty)(&poolHandlespaceNode->PoolElementOwnershipStorage));
    CHECK(ST_METHOD(IsEmpty)(&poolHandlespaceNode->PoolElementConnectionStorage));
    ST_METHOD(Delete)(&poolHandlespaceNode->PoolIndexStorage);
+   identifierHashTableDelete(&poolHandlespaceNode->PoolHandleIndex);
+   poolHandlespaceNode->PoolHandleIndexValid = 0;
    ST_METHOD(Delete)(&poolHandlespaceNode->PoolElementTimerStorage);
+   timingWheelDelete(&poolHandlespaceNode->PoolElementTimerWheel);
    ST_METHOD(Delete)(&poolHandlespaceNode->PoolElementOwnershipStorage);
+   for(i = 0;i < poolHandlespaceNode->OwnerGenerationIndex.Capacity;i++) {
+      ownerGeneration = (struct ST_CLASS(PoolElementOwnerGeneration)*)
+                           poolHandlespaceNode->OwnerGenerationIndex.EntryArray[i].Element;
+      if(ownerGeneration != NULL) {
+         CHECK(ownerGeneration->PoolElementList.Node.Next == &ownerGeneration->PoolElementList.Node);
+         doubleLinkedRingListDelete(&ownerGeneration->PoolElementList);
+         free(ownerGeneration);
+      }
+   }
+   identifierHashTableDelete(&poolHandlespaceNode->OwnerGenerationIndex);
+   CHECK(poolHandlespaceNode->PoolElementModificationList.Node.Next ==
+            &poolHandlespaceNode->PoolElementModificationList.Node);
+   doubleLinkedRingListDelete(&poolHandlespaceNode->PoolElementModificationList);
+   ST_CLASS(poolHandlespaceNodeSetMaxTombstones)(poolHandlespaceNode, 0);
+   doubleLinkedRingListDelete(&poolHandlespaceNode->TombstoneList);
    ST_METHOD(Delete)(&poolHandlespaceNode->PoolElementConnectionStorage);
    poolHandlespaceNode->HandlespaceChecksum = 0;
    poolHandlespaceNode->OwnershipChecksum   = 0;
    poolHandlespaceNode->PoolElements        = 0;
    poolHandlespaceNode->OwnedPoolElements   = 0;
+   poolHandlespaceNode->ModificationSequence = 0;
+   poolHandlespaceNode->TombstoneHorizon     = 0;
+}
+
+
+/* ###### Add memory usage of handlespace node's pools and indexes ###### */
+/* The handlespace node structure itself is not counted. */
+void ST_CLASS(poolHandlespaceNodeAddMemoryUsage)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        struct HandlespaceMemoryUsage*        memoryUsage)
+{
+   struct ST_CLASS(PoolNode)* poolNode;
+
+   memoryUsage->Other +=
+      ST_METHOD(GetMemoryUsage)(&poolHandlespaceNode->PoolIndexStorage) +
+      ST_METHOD(GetMemoryUsage)(&poolHandlespaceNode->PoolElementTimerStorage) +
+      ST_METHOD(GetMemoryUsage)(&poolHandlespaceNode->PoolElementConnectionStorage) +
+      ST_METHOD(GetMemoryUsage)(&poolHandlespaceNode->PoolElementOwnershipStorage) +
+      identifierHashTableGetMemoryUsage(&poolHandlespaceNode->PoolHandleIndex) +
+      identifierHashTableGetMemoryUsage(&poolHandlespaceNode->OwnerGenerationIndex) +
+      (identifierHashTableGetEntries(&poolHandlespaceNode->OwnerGenerationIndex) *
+         sizeof(struct ST_CLASS(PoolElementOwnerGeneration))) +
+      (poolHandlespaceNode->Tombstones * sizeof(struct ST_CLASS(PoolElementTombstone)));
+
+   poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+   while(poolNode != NULL) {
+      ST_CLASS(poolNodeAddMemoryUsage)(poolNode, memoryUsage);
+      poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
+   }
 }
 
 
@@ -135,11 +202,199 @@ HandlespaceChecksumAccumulatorType ST_CLASS(poolHandlespaceNodeComputeOwnershipC
 }
 
 
+/* ###### Get ownership digest tree bucket of pool handle ############### */
+/*
+   The bucket only depends on the pool handle, so that all PRs agree on it.
+*/
+unsigned int ST_CLASS(poolHandlespaceNodeGetOwnershipDigestBucket)(
+                const struct PoolHandle* poolHandle)
+{
+   uint32_t hash = 2166136261U;   /* FNV-1a */
+   size_t   i;
+
+   for(i = 0;i < poolHandle->Size;i++) {
+      hash = (hash ^ poolHandle->Handle[i]) * 16777619U;
+   }
+   return((unsigned int)(hash % HANDLESPACE_DIGEST_BUCKETS));
+}
+
+
+/* ###### Compute ownership digest tree buckets of PR #################### */
+/*
+   For the home PR, the tree is maintained in OwnershipDigestTree. For
+   another PR, it is computed from the PR's PEs here, e.g. to compare it
+   with the tree reported by that PR. This only walks the PR's range of
+   the ownership storage.
+*/
+void ST_CLASS(poolHandlespaceNodeComputeOwnershipDigestTree)(
+        const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const RegistrarIdentifierType               registrarIdentifier,
+        HandlespaceChecksumAccumulatorType*         digestTree)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   unsigned int                      bucket;
+
+   for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+      digestTree[bucket] = INITIAL_HANDLESPACE_CHECKSUM;
+   }
+   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+                        (struct ST_CLASS(PoolHandlespaceNode)*)poolHandlespaceNode,
+                        registrarIdentifier);
+   while(poolElementNode != NULL) {
+      bucket = poolElementNode->OwnerPoolNode->OwnershipDigestBucket;
+      digestTree[bucket] = handlespaceChecksumAdd(digestTree[bucket],
+                                                  poolElementNode->Checksum);
+      poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+                           (struct ST_CLASS(PoolHandlespaceNode)*)poolHandlespaceNode,
+                           poolElementNode);
+   }
+}
+
+
+/* ###### Compute ownership checksum of pool for PR ###################### */
+HandlespaceChecksumAccumulatorType ST_CLASS(poolHandlespaceNodeComputePoolOwnershipChecksum)(
+                                      const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                      const struct ST_CLASS(PoolNode)*            poolNode,
+                                      const RegistrarIdentifierType               registrarIdentifier)
+{
+   struct ST_CLASS(PoolElementNode)*  poolElementNode;
+   HandlespaceChecksumAccumulatorType sum = INITIAL_HANDLESPACE_CHECKSUM;
+
+   if(registrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
+      return(poolNode->OwnershipChecksum);
+   }
+   poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(
+                        (struct ST_CLASS(PoolNode)*)poolNode);
+   while(poolElementNode != NULL) {
+      if(poolElementNode->HomeRegistrarIdentifier == registrarIdentifier) {
+         sum = handlespaceChecksumAdd(sum, poolElementNode->Checksum);
+      }
+      poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(
+                           (struct ST_CLASS(PoolNode)*)poolNode, poolElementNode);
+   }
+   return(sum);
+}
+
+
+/* ###### Verify ownership digest tree ################################### */
+void ST_CLASS(poolHandlespaceNodeVerifyOwnershipDigestTree)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   HandlespaceChecksumAccumulatorType digestTree[HANDLESPACE_DIGEST_BUCKETS];
+   HandlespaceChecksumAccumulatorType sum;
+   struct ST_CLASS(PoolElementNode)*  poolElementNode;
+   struct ST_CLASS(PoolNode)*         poolNode;
+   size_t                             ownedPEs;
+   unsigned int                       bucket;
+
+   for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+      digestTree[bucket] = INITIAL_HANDLESPACE_CHECKSUM;
+   }
+   poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+   while(poolNode != NULL) {
+      CHECK(poolNode->OwnershipDigestBucket ==
+               ST_CLASS(poolHandlespaceNodeGetOwnershipDigestBucket)(&poolNode->Handle));
+      sum      = INITIAL_HANDLESPACE_CHECKSUM;
+      ownedPEs = 0;
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+      while(poolElementNode != NULL) {
+         if(poolElementNode->HomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
+            sum = handlespaceChecksumAdd(sum, poolElementNode->Checksum);
+            ownedPEs++;
+         }
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNode);
+      }
+      CHECK(poolNode->OwnershipChecksum == sum);
+      CHECK(poolNode->OwnedPoolElements == ownedPEs);
+      digestTree[poolNode->OwnershipDigestBucket] = handlespaceChecksumAdd(
+                                                       digestTree[poolNode->OwnershipDigestBucket],
+                                                       sum);
+      poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
+   }
+
+   sum = INITIAL_HANDLESPACE_CHECKSUM;
+   for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+      CHECK(poolHandlespaceNode->OwnershipDigestTree[bucket] == digestTree[bucket]);
+      sum = handlespaceChecksumAdd(sum, digestTree[bucket]);
+   }
+   CHECK(poolHandlespaceNode->OwnershipChecksum == sum);
+
+   if(poolHandlespaceNode->HomeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER) {
+      ST_CLASS(poolHandlespaceNodeComputeOwnershipDigestTree)(poolHandlespaceNode,
+                                                              poolHandlespaceNode->HomeRegistrarIdentifier,
+                                                              digestTree);
+      for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+         CHECK(poolHandlespaceNode->OwnershipDigestTree[bucket] == digestTree[bucket]);
+      }
+   }
+}
+
+
 /* ###### Get number of timers ########################################### */
 size_t ST_CLASS(poolHandlespaceNodeGetTimerNodes)(
           const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
 {
-   return(ST_METHOD(GetElements)(&poolHandlespaceNode->PoolElementTimerStorage));
+   return(ST_METHOD(GetElements)(&poolHandlespaceNode->PoolElementTimerStorage) +
+          timingWheelGetElements(&poolHandlespaceNode->PoolElementTimerWheel));
+}
+
+
+/* ###### Move next tick of timer wheel into sorted timer storage ######## */
+static size_t ST_CLASS(poolHandlespaceNodeFetchPoolElementTimers)(
+                 struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   struct DoubleLinkedRingList       dueList;
+   struct DoubleLinkedRingListNode*  listNode;
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct STN_CLASSNAME*             result;
+   size_t                            fetched;
+
+   doubleLinkedRingListNew(&dueList);
+   fetched = timingWheelAdvance(&poolHandlespaceNode->PoolElementTimerWheel, &dueList);
+   while(dueList.Node.Next != &dueList.Node) {
+      listNode = dueList.Node.Next;
+      doubleLinkedRingListRemNode(listNode);
+      poolElementNode = ST_CLASS(getPoolElementNodeFromTimerWheelNode)(listNode);
+      result = ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementTimerStorage,
+                                 &poolElementNode->PoolElementTimerStorageNode);
+      CHECK(result == &poolElementNode->PoolElementTimerStorageNode);
+   }
+   doubleLinkedRingListDelete(&dueList);
+   return(fetched);
+}
+
+
+/* ###### Take expired timers from the timer wheel ####################### */
+/*
+   Moves the PEs of all expired ticks of the timer wheel into expiredList,
+   by their PoolElementTimerWheelNodes, without sorting them into the
+   timer storage. Their timers are inactive then. The timers of the
+   storage, and the ones of the tick containing currentTimeStamp, remain.
+*/
+size_t ST_CLASS(poolHandlespaceNodeTakeExpiredPoolElementTimers)(
+          struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+          const unsigned long long              currentTimeStamp,
+          struct DoubleLinkedRingList*          expiredList)
+{
+   return(timingWheelAdvanceExpired(&poolHandlespaceNode->PoolElementTimerWheel,
+                                    expiredList, currentTimeStamp));
+}
+
+
+/* ###### Get first timer in the timer storage ########################### */
+/*
+   Unlike poolHandlespaceNodeGetFirstPoolElementTimerNode(), this does not
+   fetch timers from the timer wheel, i.e. it returns NULL if the storage
+   is empty.
+*/
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstStoredPoolElementTimerNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   struct STN_CLASSNAME* node = ST_METHOD(GetFirst)(&poolHandlespaceNode->PoolElementTimerStorage);
+   if(node != NULL) {
+      return(ST_CLASS(getPoolElementNodeFromTimerStorageNode)(node));
+   }
+   return(NULL);
 }
 
 
@@ -148,6 +403,10 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstPoolElemen
                                      struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
 {
    struct STN_CLASSNAME* node = ST_METHOD(GetFirst)(&poolHandlespaceNode->PoolElementTimerStorage);
+   if((node == NULL) &&
+      (ST_CLASS(poolHandlespaceNodeFetchPoolElementTimers)(poolHandlespaceNode) > 0)) {
+      node = ST_METHOD(GetFirst)(&poolHandlespaceNode->PoolElementTimerStorage);
+   }
    if(node != NULL) {
       return(ST_CLASS(getPoolElementNodeFromTimerStorageNode)(node));
    }
@@ -162,6 +421,13 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetNextPoolElement
 {
    struct STN_CLASSNAME* node = ST_METHOD(GetNext)(&poolHandlespaceNode->PoolElementTimerStorage,
                                                    &poolElementNode->PoolElementTimerStorageNode);
+   if((node == NULL) &&
+      (ST_CLASS(poolHandlespaceNodeFetchPoolElementTimers)(poolHandlespaceNode) > 0)) {
+      /* Fetched timers are behind the previous horizon, i.e. after
+         poolElementNode's timer. */
+      node = ST_METHOD(GetNext)(&poolHandlespaceNode->PoolElementTimerStorage,
+                                &poolElementNode->PoolElementTimerStorageNode);
+   }
    if(node != NULL) {
       return(ST_CLASS(getPoolElementNodeFromTimerStorageNode)(node));
    }
@@ -356,7 +622,8 @@ int ST_CLASS(poolHandlespaceNodeHasActiveTimer)(
        const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
        const struct ST_CLASS(PoolElementNode)*     poolElementNode)
 {
-   return(STN_METHOD(IsLinked)(&poolElementNode->PoolElementTimerStorageNode));
+   return(STN_METHOD(IsLinked)(&poolElementNode->PoolElementTimerStorageNode) ||
+          timingWheelNodeIsLinked(&poolElementNode->PoolElementTimerWheelNode));
 }
 
 
@@ -369,12 +636,21 @@ void ST_CLASS(poolHandlespaceNodeActivateTimer)(
 {
    struct STN_CLASSNAME* result;
 
-   CHECK(!STN_METHOD(IsLinked)(&poolElementNode->PoolElementTimerStorageNode));
+   CHECK(!ST_CLASS(poolHandlespaceNodeHasActiveTimer)(poolHandlespaceNode, poolElementNode));
    poolElementNode->TimerCode      = timerCode;
    poolElementNode->TimerTimeStamp = timerTimeStamp;
-   result = ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementTimerStorage,
-                              &poolElementNode->PoolElementTimerStorageNode);
-   CHECK(result == &poolElementNode->PoolElementTimerStorageNode);
+   /* Timers behind the wheel's horizon are only bucketed; the sorted
+      storage keeps the timers before the horizon, i.e. the next ones. */
+   if(timingWheelAccepts(&poolHandlespaceNode->PoolElementTimerWheel, timerTimeStamp)) {
+      timingWheelInsert(&poolHandlespaceNode->PoolElementTimerWheel,
+                        &poolElementNode->PoolElementTimerWheelNode,
+                        timerTimeStamp);
+   }
+   else {
+      result = ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementTimerStorage,
+                                 &poolElementNode->PoolElementTimerStorageNode);
+      CHECK(result == &poolElementNode->PoolElementTimerStorageNode);
+   }
 }
 
 
@@ -390,6 +666,10 @@ void ST_CLASS(poolHandlespaceNodeDeactivateTimer)(
                                  &poolElementNode->PoolElementTimerStorageNode);
       CHECK(result == &poolElementNode->PoolElementTimerStorageNode);
    }
+   else if(timingWheelNodeIsLinked(&poolElementNode->PoolElementTimerWheelNode)) {
+      timingWheelRemove(&poolHandlespaceNode->PoolElementTimerWheel,
+                        &poolElementNode->PoolElementTimerWheelNode);
+   }
 }
 
 
@@ -408,7 +688,7 @@ size_t ST_CLASS(poolHandlespaceNodeSelectPoolElementNodesByPolicy)(
       *errorCode = RSPERR_OKAY;
       count = poolNode->Policy->SelectionFunction(poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement);
 #ifdef VERIFY
-      ST_CLASS(poolHandlespaceNodeVerify)(poolHandlespaceNode);
+      ST_CLASS(poolHandlespaceNodeVerifyChange)(poolHandlespaceNode, poolHandle);
 #endif
    }
    else {
@@ -419,16 +699,35 @@ size_t ST_CLASS(poolHandlespaceNodeSelectPoolElementNodesByPolicy)(
 
 
 /* ###### Add PoolNode ################################################### */
+/*
+   Returns the existing PoolNode, if there is already a pool with the
+   same handle.
+*/
 struct ST_CLASS(PoolNode)* ST_CLASS(poolHandlespaceNodeAddPoolNode)(
                               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
                               struct ST_CLASS(PoolNode)*            poolNode)
 {
-   struct STN_CLASSNAME* result = ST_METHOD(Insert)(&poolHandlespaceNode->PoolIndexStorage,
-                                                    &poolNode->PoolIndexStorageNode);
-   if(result == &poolNode->PoolIndexStorageNode) {
+   struct ST_CLASS(PoolNode)* result;
+
+   result = ST_CLASS(poolHandlespaceNodeFindPoolNode)(poolHandlespaceNode, &poolNode->Handle);
+   if(result == NULL) {
+      result = (struct ST_CLASS(PoolNode)*)ST_METHOD(Insert)(&poolHandlespaceNode->PoolIndexStorage,
+                                                              &poolNode->PoolIndexStorageNode);
+      CHECK(result == poolNode);
       poolNode->OwnerPoolHandlespaceNode = poolHandlespaceNode;
+      poolNode->OwnershipDigestBucket    = ST_CLASS(poolHandlespaceNodeGetOwnershipDigestBucket)(
+                                              &poolNode->Handle);
+
+      /* If the pool cannot be indexed, the index is rebuilt by the next lookup */
+      if(poolHandlespaceNode->PoolHandleIndexValid) {
+         if( (poolNode->Handle.Identifier == 0) ||
+             (!identifierHashTableInsert(&poolHandlespaceNode->PoolHandleIndex,
+                                         poolNode->Handle.Identifier, poolNode)) ) {
+            poolHandlespaceNode->PoolHandleIndexValid = 0;
+         }
+      }
    }
-   return((struct ST_CLASS(PoolNode)*)result);
+   return(result);
 }
 
 
@@ -447,6 +746,53 @@ size_t ST_CLASS(poolHandlespaceNodeGetPoolElementNodesOfPool)(
 }
 
 
+/* ###### Rebuild pool handle index, if necessary ######################## */
+/*
+   Returns 0, if the index cannot be built, i.e. a pool handle is not
+   interned or the index cannot be allocated.
+*/
+int ST_CLASS(poolHandlespaceNodeUpdatePoolHandleIndex)(
+       struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   struct ST_CLASS(PoolNode)* poolNode;
+
+   if(!poolHandlespaceNode->PoolHandleIndexValid) {
+      identifierHashTableClear(&poolHandlespaceNode->PoolHandleIndex);
+      poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+      while(poolNode != NULL) {
+         if( (poolNode->Handle.Identifier == 0) ||
+             (!identifierHashTableInsert(&poolHandlespaceNode->PoolHandleIndex,
+                                         poolNode->Handle.Identifier, poolNode)) ) {
+            return(0);
+         }
+         poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
+      }
+      poolHandlespaceNode->PoolHandleIndexValid = 1;
+   }
+   return(1);
+}
+
+
+/* ###### Verify pool handle index ####################################### */
+void ST_CLASS(poolHandlespaceNodeVerifyPoolHandleIndex)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   const struct IdentifierHashTable* index = &poolHandlespaceNode->PoolHandleIndex;
+   struct ST_CLASS(PoolNode)*        poolNode;
+
+   if(poolHandlespaceNode->PoolHandleIndexValid) {
+      identifierHashTableVerify(index);
+      CHECK(identifierHashTableGetEntries(index) ==
+               ST_CLASS(poolHandlespaceNodeGetPoolNodes)(poolHandlespaceNode));
+      poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+      while(poolNode != NULL) {
+         CHECK(identifierHashTableFind(index, poolNode->Handle.Identifier) == poolNode);
+         poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
+      }
+   }
+}
+
+
 /* ###### Find PoolNode ################################################## */
 struct ST_CLASS(PoolNode)* ST_CLASS(poolHandlespaceNodeFindPoolNode)(
                               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
@@ -455,6 +801,14 @@ struct ST_CLASS(PoolNode)* ST_CLASS(poolHandlespaceNodeFindPoolNode)(
    struct ST_CLASS(PoolNode)* poolNode;
    struct ST_CLASS(PoolNode)  cmpPoolNode;
 
+#ifdef USE_POOLHANDLE_HASHINDEX
+   if( (poolHandle->Identifier != 0) &&
+       (ST_CLASS(poolHandlespaceNodeUpdatePoolHandleIndex)(poolHandlespaceNode)) ) {
+      return((struct ST_CLASS(PoolNode)*)identifierHashTableFind(
+                &poolHandlespaceNode->PoolHandleIndex, poolHandle->Identifier));
+   }
+#endif
+
    poolHandleNew(&cmpPoolNode.Handle, poolHandle->Handle, poolHandle->Size);
    poolNode = (struct ST_CLASS(PoolNode)*)ST_METHOD(Find)(&poolHandlespaceNode->PoolIndexStorage,
                                                           &cmpPoolNode.PoolIndexStorageNode);
@@ -537,11 +891,229 @@ struct ST_CLASS(PoolNode)* ST_CLASS(poolHandlespaceNodeRemovePoolNode)(
    const struct STN_CLASSNAME* result = ST_METHOD(Remove)(&poolHandlespaceNode->PoolIndexStorage,
                                                           &poolNode->PoolIndexStorageNode);
    CHECK(result == &poolNode->PoolIndexStorageNode);
+   if(poolHandlespaceNode->PoolHandleIndexValid) {
+      CHECK(identifierHashTableRemove(&poolHandlespaceNode->PoolHandleIndex,
+                                      poolNode->Handle.Identifier) == poolNode);
+   }
    poolNode->OwnerPoolHandlespaceNode = NULL;
    return(poolNode);
 }
 
 
+/* ###### Get mark generation of owner ################################## */
+static struct ST_CLASS(PoolElementOwnerGeneration)* ST_CLASS(poolHandlespaceNodeFindOwnerGeneration)(
+                                                       const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                                       const RegistrarIdentifierType               ownerID)
+{
+   if(ownerID == UNDEFINED_REGISTRAR_IDENTIFIER) {
+      return(NULL);
+   }
+   return((struct ST_CLASS(PoolElementOwnerGeneration)*)identifierHashTableFind(
+             &poolHandlespaceNode->OwnerGenerationIndex, ownerID));
+}
+
+
+/* ###### Append PoolElementNode to its owner's generation list ########## */
+static void ST_CLASS(poolHandlespaceNodeLinkPoolElementNodeToOwnerGeneration)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+               struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration =
+      ST_CLASS(poolHandlespaceNodeFindOwnerGeneration)(poolHandlespaceNode,
+                                                       poolElementNode->HomeRegistrarIdentifier);
+   if(ownerGeneration != NULL) {
+      poolElementNode->Generation = ownerGeneration->Generation;
+      doubleLinkedRingListAddTail(&ownerGeneration->PoolElementList,
+                                  &poolElementNode->PoolElementGenerationListNode);
+   }
+}
+
+
+/* ###### Remove PoolElementNode from its owner's generation list ######## */
+/*
+   All PEs of an owner are in its generation list. The owner's generation
+   is therefore freed with its last PE; the next marking creates a new one.
+*/
+static void ST_CLASS(poolHandlespaceNodeUnlinkPoolElementNodeFromOwnerGeneration)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+               struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration;
+
+   if(poolElementNode->PoolElementGenerationListNode.Next != NULL) {
+      doubleLinkedRingListRemNode(&poolElementNode->PoolElementGenerationListNode);
+      ownerGeneration = ST_CLASS(poolHandlespaceNodeFindOwnerGeneration)(
+                           poolHandlespaceNode, poolElementNode->HomeRegistrarIdentifier);
+      CHECK(ownerGeneration != NULL);
+      if(ownerGeneration->PoolElementList.Node.Next == &ownerGeneration->PoolElementList.Node) {
+         CHECK(identifierHashTableRemove(&poolHandlespaceNode->OwnerGenerationIndex,
+                                         ownerGeneration->OwnerIdentifier) == ownerGeneration);
+         doubleLinkedRingListDelete(&ownerGeneration->PoolElementList);
+         free(ownerGeneration);
+      }
+   }
+}
+
+
+/* ###### Move refreshed PoolElementNode to tail of generation list ###### */
+static void ST_CLASS(poolHandlespaceNodeRefreshPoolElementNodeGeneration)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+               struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration;
+
+   if(poolElementNode->PoolElementGenerationListNode.Next != NULL) {
+      ownerGeneration = ST_CLASS(poolHandlespaceNodeFindOwnerGeneration)(
+                           poolHandlespaceNode, poolElementNode->HomeRegistrarIdentifier);
+      CHECK(ownerGeneration != NULL);
+      doubleLinkedRingListRemNode(&poolElementNode->PoolElementGenerationListNode);
+      poolElementNode->Generation = ownerGeneration->Generation;
+      doubleLinkedRingListAddTail(&ownerGeneration->PoolElementList,
+                                  &poolElementNode->PoolElementGenerationListNode);
+   }
+}
+
+
+/* ###### Move PoolElementNode to tail of modification list ############ */
+static void ST_CLASS(poolHandlespaceNodeNotePoolElementNodeModification)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+               struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   poolElementNode->ModificationSequence = ++poolHandlespaceNode->ModificationSequence;
+   if(poolElementNode->PoolElementModificationListNode.Next != NULL) {
+      doubleLinkedRingListRemNode(&poolElementNode->PoolElementModificationListNode);
+   }
+   doubleLinkedRingListAddTail(&poolHandlespaceNode->PoolElementModificationList,
+                               &poolElementNode->PoolElementModificationListNode);
+}
+
+
+/* ###### Get tombstone from given Tombstone List Node ################### */
+static struct ST_CLASS(PoolElementTombstone)* ST_CLASS(getTombstoneFromTombstoneListNode)(
+                                                 const struct DoubleLinkedRingListNode* node)
+{
+   const struct ST_CLASS(PoolElementTombstone)* dummy = (struct ST_CLASS(PoolElementTombstone)*)node;
+   long n = (long)node - ((long)&dummy->TombstoneListNode - (long)dummy);
+   return((struct ST_CLASS(PoolElementTombstone)*)n);
+}
+
+
+/* ###### Record removal of PoolElementNode from given owner ############# */
+static void ST_CLASS(poolHandlespaceNodeRecordTombstone)(
+               struct ST_CLASS(PoolHandlespaceNode)*   poolHandlespaceNode,
+               const struct ST_CLASS(PoolElementNode)* poolElementNode,
+               const RegistrarIdentifierType           homeRegistrarIdentifier)
+{
+   struct ST_CLASS(PoolElementTombstone)* tombstone = NULL;
+
+   poolHandlespaceNode->ModificationSequence++;
+
+   if(poolHandlespaceNode->MaxTombstones > 0) {
+      tombstone = (struct ST_CLASS(PoolElementTombstone)*)malloc(sizeof(struct ST_CLASS(PoolElementTombstone)));
+   }
+   if(tombstone != NULL) {
+      tombstone->Handle                  = poolElementNode->OwnerPoolNode->Handle;
+      tombstone->Identifier              = poolElementNode->Identifier;
+      tombstone->HomeRegistrarIdentifier = homeRegistrarIdentifier;
+      tombstone->ModificationSequence    = poolHandlespaceNode->ModificationSequence;
+      doubleLinkedRingListAddTail(&poolHandlespaceNode->TombstoneList,
+                                  &tombstone->TombstoneListNode);
+      poolHandlespaceNode->Tombstones++;
+      ST_CLASS(poolHandlespaceNodeSetMaxTombstones)(poolHandlespaceNode,
+                                                    poolHandlespaceNode->MaxTombstones);
+   }
+   else {
+      /* Without the record, older versions cannot be served any more */
+      poolHandlespaceNode->TombstoneHorizon = poolHandlespaceNode->ModificationSequence;
+   }
+}
+
+
+/* ###### Record deletion of PoolElementNode ############################# */
+static void ST_CLASS(poolHandlespaceNodeAddTombstone)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+               struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   if(poolElementNode->PoolElementModificationListNode.Next != NULL) {
+      doubleLinkedRingListRemNode(&poolElementNode->PoolElementModificationListNode);
+   }
+   ST_CLASS(poolHandlespaceNodeRecordTombstone)(poolHandlespaceNode, poolElementNode,
+                                                poolElementNode->HomeRegistrarIdentifier);
+}
+
+
+/* ###### Add owned PE to ownership checksums ########################### */
+static void ST_CLASS(poolHandlespaceNodeAddOwnedPoolElementNode)(
+               struct ST_CLASS(PoolHandlespaceNode)*   poolHandlespaceNode,
+               const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   struct ST_CLASS(PoolNode)* poolNode = poolElementNode->OwnerPoolNode;
+   const unsigned int         bucket   = poolNode->OwnershipDigestBucket;
+
+   poolHandlespaceNode->OwnedPoolElements++;
+   poolHandlespaceNode->OwnershipChecksum = handlespaceChecksumAdd(
+                                               poolHandlespaceNode->OwnershipChecksum,
+                                               poolElementNode->Checksum);
+   poolHandlespaceNode->OwnershipDigestTree[bucket] = handlespaceChecksumAdd(
+                                                         poolHandlespaceNode->OwnershipDigestTree[bucket],
+                                                         poolElementNode->Checksum);
+   poolNode->OwnedPoolElements++;
+   poolNode->OwnershipChecksum = handlespaceChecksumAdd(poolNode->OwnershipChecksum,
+                                                        poolElementNode->Checksum);
+}
+
+
+/* ###### Remove owned PE from ownership checksums ####################### */
+static void ST_CLASS(poolHandlespaceNodeRemoveOwnedPoolElementNode)(
+               struct ST_CLASS(PoolHandlespaceNode)*   poolHandlespaceNode,
+               const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   struct ST_CLASS(PoolNode)* poolNode = poolElementNode->OwnerPoolNode;
+   const unsigned int         bucket   = poolNode->OwnershipDigestBucket;
+
+   CHECK(poolHandlespaceNode->OwnedPoolElements > 0);
+   CHECK(poolNode->OwnedPoolElements > 0);
+   poolHandlespaceNode->OwnedPoolElements--;
+   poolHandlespaceNode->OwnershipChecksum = handlespaceChecksumSub(
+                                               poolHandlespaceNode->OwnershipChecksum,
+                                               poolElementNode->Checksum);
+   poolHandlespaceNode->OwnershipDigestTree[bucket] = handlespaceChecksumSub(
+                                                         poolHandlespaceNode->OwnershipDigestTree[bucket],
+                                                         poolElementNode->Checksum);
+   poolNode->OwnedPoolElements--;
+   poolNode->OwnershipChecksum = handlespaceChecksumSub(poolNode->OwnershipChecksum,
+                                                        poolElementNode->Checksum);
+}
+
+
+/* ###### Account for new PoolElementNode ############################### */
+/*
+   Adds the new PE's checksum, which has to be set already, to the
+   handlespace and ownership checksums, notifies and flags the PE as new.
+*/
+static void ST_CLASS(poolHandlespaceNodeAccountForNewPoolElementNode)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+               struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   poolHandlespaceNode->HandlespaceChecksum = handlespaceChecksumAdd(
+                                                 poolHandlespaceNode->HandlespaceChecksum,
+                                                 poolElementNode->Checksum);
+   if(poolElementNode->HomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
+      ST_CLASS(poolHandlespaceNodeAddOwnedPoolElementNode)(poolHandlespaceNode,
+                                                           poolElementNode);
+   }
+   if(poolHandlespaceNode->PoolNodeUpdateNotification) {
+      poolHandlespaceNode->PoolNodeUpdateNotification(poolHandlespaceNode,
+                                                      poolElementNode,
+                                                      PNUA_Create,
+                                                      INITIAL_HANDLESPACE_CHECKSUM,
+                                                      UNDEFINED_REGISTRAR_IDENTIFIER,
+                                                      poolHandlespaceNode->NotificationUserData);
+   }
+   poolElementNode->Flags |= PENF_NEW;
+}
+
+
 /* ###### Add PoolElementNode ############################################ */
 struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeAddPoolElementNode)(
                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
@@ -556,11 +1128,15 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeAddPoolElementNode
    if(result == poolElementNode) {
       CHECK(*errorCode == RSPERR_OKAY);
       poolHandlespaceNode->PoolElements++;
+      ST_CLASS(poolHandlespaceNodeNotePoolElementNodeModification)(poolHandlespaceNode,
+                                                                   poolElementNode);
 
       if(poolElementNode->HomeRegistrarIdentifier != 0) {
          result2 = ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementOwnershipStorage,
                                      &poolElementNode->PoolElementOwnershipStorageNode);
          CHECK(result2 == &poolElementNode->PoolElementOwnershipStorageNode);
+         ST_CLASS(poolHandlespaceNodeLinkPoolElementNodeToOwnerGeneration)(poolHandlespaceNode,
+                                                                           poolElementNode);
       }
       if(poolElementNode->ConnectionSocketDescriptor > 0) {
          result2 = ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementConnectionStorage,
@@ -572,6 +1148,130 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeAddPoolElementNode
 }
 
 
+/* ###### Add multiple new PoolElementNodes ############################## */
+/*
+   Adds new PoolElementNodes to a pool, with the same preconditions as
+   poolNodeAddPoolElementNodes(). The ownership and connection storages
+   are filled in bulk, too, and the PE checksums are computed. The
+   addition has to be completed by
+   poolHandlespaceNodeCompletePoolElementNodeAddition() for each PE, in
+   the order the PEs would have been added one by one, before the
+   handlespace is used otherwise.
+*/
+void ST_CLASS(poolHandlespaceNodeAddPoolElementNodes)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        struct ST_CLASS(PoolNode)*            poolNode,
+        struct ST_CLASS(PoolElementNode)**    poolElementNodeArray,
+        const size_t                          poolElementNodes)
+{
+   struct ST_CLASS(PoolElementNode)*   poolElementNode;
+   struct STN_CLASSNAME**              storageNodeArray;
+   uint32_t*                           identifierArray;
+   HandlespaceChecksumAccumulatorType* checksumArray;
+   size_t                              ownershipNodes;
+   size_t                              connectionNodes;
+   size_t                              i;
+
+   ST_CLASS(poolNodeAddPoolElementNodes)(poolNode, poolElementNodeArray, poolElementNodes);
+   poolHandlespaceNode->PoolElements += poolElementNodes;
+
+   /* ====== Link PE entries to ownership and connection storages ======== */
+   storageNodeArray = (struct STN_CLASSNAME**)malloc(poolElementNodes * sizeof(struct STN_CLASSNAME*));
+   ownershipNodes   = 0;
+   connectionNodes  = 0;
+   for(i = 0;i < poolElementNodes;i++) {
+      poolElementNode = poolElementNodeArray[i];
+      if(poolElementNode->HomeRegistrarIdentifier != 0) {
+         if(storageNodeArray != NULL) {
+            storageNodeArray[ownershipNodes++] = &poolElementNode->PoolElementOwnershipStorageNode;
+         }
+         else {
+            CHECK(ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementOwnershipStorage,
+                                    &poolElementNode->PoolElementOwnershipStorageNode) ==
+                     &poolElementNode->PoolElementOwnershipStorageNode);
+         }
+      }
+      if(poolElementNode->ConnectionSocketDescriptor > 0) {
+         connectionNodes++;
+      }
+   }
+   if(storageNodeArray != NULL) {
+      ST_CLASS(poolElementStorageInsertNodes)(&poolHandlespaceNode->PoolElementOwnershipStorage,
+                                              storageNodeArray, ownershipNodes);
+   }
+   if(connectionNodes > 0) {
+      connectionNodes = 0;
+      for(i = 0;i < poolElementNodes;i++) {
+         poolElementNode = poolElementNodeArray[i];
+         if(poolElementNode->ConnectionSocketDescriptor > 0) {
+            if(storageNodeArray != NULL) {
+               storageNodeArray[connectionNodes++] = &poolElementNode->PoolElementConnectionStorageNode;
+            }
+            else {
+               CHECK(ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementConnectionStorage,
+                                       &poolElementNode->PoolElementConnectionStorageNode) ==
+                        &poolElementNode->PoolElementConnectionStorageNode);
+            }
+         }
+      }
+      if(storageNodeArray != NULL) {
+         ST_CLASS(poolElementStorageInsertNodes)(&poolHandlespaceNode->PoolElementConnectionStorage,
+                                                 storageNodeArray, connectionNodes);
+      }
+   }
+   free(storageNodeArray);
+
+   /* ====== Compute PE checksums in one batch =========================== */
+   /* All PEs share the pool handle part of the checksum; only the
+      identifiers remain (see poolElementNodeComputeChecksum()). */
+   identifierArray = (uint32_t*)malloc(poolElementNodes * sizeof(uint32_t));
+   checksumArray   = (HandlespaceChecksumAccumulatorType*)malloc(poolElementNodes * sizeof(HandlespaceChecksumAccumulatorType));
+   if( (identifierArray != NULL) && (checksumArray != NULL) ) {
+      for(i = 0;i < poolElementNodes;i++) {
+         identifierArray[i] = htonl(poolElementNodeArray[i]->Identifier);
+      }
+      handlespaceChecksumComputeBatch(poolNode->HandleChecksum,
+                                      identifierArray, poolElementNodes, checksumArray);
+   }
+   else {
+      free(checksumArray);
+      checksumArray = NULL;
+   }
+   free(identifierArray);
+
+   for(i = 0;i < poolElementNodes;i++) {
+      poolElementNode = poolElementNodeArray[i];
+      poolElementNode->Checksum = (checksumArray != NULL) ?
+                                     checksumArray[i] :
+                                     ST_CLASS(poolElementNodeComputeChecksum)(poolElementNode);
+   }
+   free(checksumArray);
+}
+
+
+/* ###### Complete addition of PoolElementNode ########################### */
+/*
+   Completes the addition of a PE added by
+   poolHandlespaceNodeAddPoolElementNodes(): the PE is noted as modified
+   and linked to its owner's mark generation, checksums, notification
+   and flags are updated as for a new entry in
+   poolHandlespaceNodeAddOrUpdatePoolElementNode().
+*/
+void ST_CLASS(poolHandlespaceNodeCompletePoolElementNodeAddition)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   ST_CLASS(poolHandlespaceNodeNotePoolElementNodeModification)(poolHandlespaceNode,
+                                                                poolElementNode);
+   if(poolElementNode->HomeRegistrarIdentifier != 0) {
+      ST_CLASS(poolHandlespaceNodeLinkPoolElementNodeToOwnerGeneration)(poolHandlespaceNode,
+                                                                        poolElementNode);
+   }
+   ST_CLASS(poolHandlespaceNodeAccountForNewPoolElementNode)(poolHandlespaceNode,
+                                                             poolElementNode);
+}
+
+
 /* ###### Update PoolElementNode's ownership ############################# */
 void ST_CLASS(poolHandlespaceNodeUpdateOwnershipOfPoolElementNode)(
               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
@@ -593,11 +1293,24 @@ void ST_CLASS(poolHandlespaceNodeUpdateOwnershipOfPoolElementNode)(
                                     &poolElementNode->PoolElementOwnershipStorageNode);
          CHECK(result == &poolElementNode->PoolElementOwnershipStorageNode);
       }
-      poolElementNode->Flags |= PENF_UPDATED;
+      ST_CLASS(poolHandlespaceNodeUnlinkPoolElementNodeFromOwnerGeneration)(poolHandlespaceNode,
+                                                                            poolElementNode);
+      /* The previous owner's changes have to tell the peers that it lost
+         the PE; the modification below only reaches the new owner's ones */
+      if(preUpdateHomeRegistrar != UNDEFINED_REGISTRAR_IDENTIFIER) {
+         ST_CLASS(poolHandlespaceNodeRecordTombstone)(poolHandlespaceNode, poolElementNode,
+                                                      preUpdateHomeRegistrar);
+      }
+      poolElementNode->Flags = (poolElementNode->Flags & ~PENF_MARKED) | PENF_UPDATED;
       poolElementNode->HomeRegistrarIdentifier = newHomeRegistrarIdentifier;
       result = ST_METHOD(Insert)(&poolHandlespaceNode->PoolElementOwnershipStorage,
                                  &poolElementNode->PoolElementOwnershipStorageNode);
       CHECK(result == &poolElementNode->PoolElementOwnershipStorageNode);
+      /* A PE taken over is unmarked for its new owner */
+      ST_CLASS(poolHandlespaceNodeLinkPoolElementNodeToOwnerGeneration)(poolHandlespaceNode,
+                                                                        poolElementNode);
+      ST_CLASS(poolHandlespaceNodeNotePoolElementNodeModification)(poolHandlespaceNode,
+                                                                   poolElementNode);
    }
    else {
       poolElementNode->Flags &= ~PENF_UPDATED;
@@ -608,11 +1321,8 @@ void ST_CLASS(poolHandlespaceNodeUpdateOwnershipOfPoolElementNode)(
                                                    poolHandlespaceNode->HandlespaceChecksum,
                                                    poolElementNode->Checksum);
    if(preUpdateHomeRegistrar == poolHandlespaceNode->HomeRegistrarIdentifier) {
-      CHECK(poolHandlespaceNode->OwnedPoolElements > 0);
-      poolHandlespaceNode->OwnedPoolElements--;
-      poolHandlespaceNode->OwnershipChecksum = handlespaceChecksumSub(
-                                                   poolHandlespaceNode->OwnershipChecksum,
-                                                   poolElementNode->Checksum);
+      ST_CLASS(poolHandlespaceNodeRemoveOwnedPoolElementNode)(poolHandlespaceNode,
+                                                              poolElementNode);
    }
 
    poolElementNode->Checksum = ST_CLASS(poolElementNodeComputeChecksum)(poolElementNode);
@@ -621,10 +1331,8 @@ void ST_CLASS(poolHandlespaceNodeUpdateOwnershipOfPoolElementNode)(
                                                    poolHandlespaceNode->HandlespaceChecksum,
                                                    poolElementNode->Checksum);
    if(poolElementNode->HomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
-      poolHandlespaceNode->OwnedPoolElements++;
-      poolHandlespaceNode->OwnershipChecksum = handlespaceChecksumAdd(
-                                                   poolHandlespaceNode->OwnershipChecksum,
-                                                   poolElementNode->Checksum);
+      ST_CLASS(poolHandlespaceNodeAddOwnedPoolElementNode)(poolHandlespaceNode,
+                                                           poolElementNode);
    }
    if(poolHandlespaceNode->PoolNodeUpdateNotification) {
       poolHandlespaceNode->PoolNodeUpdateNotification(poolHandlespaceNode,
@@ -637,6 +1345,164 @@ void ST_CLASS(poolHandlespaceNodeUpdateOwnershipOfPoolElementNode)(
 }
 
 
+/* ###### Transfer ownership of all PEs of a PR ######################### */
+/*
+   Moves all PEs owned by oldHomeRegistrarIdentifier to
+   newHomeRegistrarIdentifier, with the same effect as calling
+   poolHandlespaceNodeUpdateOwnershipOfPoolElementNode() for each of them.
+   Since the ownership storage is sorted by home PR first, the PEs form
+   a contiguous range, which keeps its order. For a large range, the
+   storage is rebuilt in one pass from the merge of the remaining nodes
+   and the moved range, instead of removing and re-inserting each node.
+   Returns the number of transferred PEs.
+*/
+size_t ST_CLASS(poolHandlespaceNodeTransferOwnershipOfPoolElementNodes)(
+          struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+          const RegistrarIdentifierType         oldHomeRegistrarIdentifier,
+          const RegistrarIdentifierType         newHomeRegistrarIdentifier)
+{
+   struct ST_CLASSNAME*               storage = &poolHandlespaceNode->PoolElementOwnershipStorage;
+   struct ST_CLASS(PoolElementNode)** poolElementNodeArray;
+   struct ST_CLASS(PoolElementNode)*  poolElementNode;
+   struct ST_CLASS(PoolElementNode)*  nextPoolElementNode;
+   struct STN_CLASSNAME**             nodeArray;
+   struct STN_CLASSNAME*              node;
+   struct STN_CLASSNAME*              result;
+   size_t                             elements;
+   size_t                             transferred;
+   size_t                             depth;
+   size_t                             i, j, k;
+
+   CHECK(oldHomeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER);
+   CHECK(newHomeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER);
+   if(oldHomeRegistrarIdentifier == newHomeRegistrarIdentifier) {
+      return(0);
+   }
+   transferred = ST_CLASS(poolHandlespaceNodeGetOwnershipNodesForIdentifier)(
+                    poolHandlespaceNode, oldHomeRegistrarIdentifier);
+   if(transferred == 0) {
+      return(0);
+   }
+
+   /* ====== Get PEs to transfer ========================================= */
+   poolElementNodeArray = (struct ST_CLASS(PoolElementNode)**)malloc(
+                             transferred * sizeof(struct ST_CLASS(PoolElementNode)*));
+   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+                        poolHandlespaceNode, oldHomeRegistrarIdentifier);
+   if(poolElementNodeArray == NULL) {
+      /* Fall back to moving the PEs one by one */
+      while(poolElementNode != NULL) {
+         nextPoolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+                                  poolHandlespaceNode, poolElementNode);
+         ST_CLASS(poolHandlespaceNodeUpdateOwnershipOfPoolElementNode)(
+            poolHandlespaceNode, poolElementNode, newHomeRegistrarIdentifier);
+         poolElementNode = nextPoolElementNode;
+      }
+      return(transferred);
+   }
+   for(i = 0;i < transferred;i++) {
+      poolElementNodeArray[i] = poolElementNode;
+      poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+                           poolHandlespaceNode, poolElementNode);
+   }
+   CHECK(poolElementNode == NULL);
+   for(i = 0;i < transferred;i++) {
+      ST_CLASS(poolHandlespaceNodeUnlinkPoolElementNodeFromOwnerGeneration)(poolHandlespaceNode,
+                                                                            poolElementNodeArray[i]);
+   }
+
+   /* ====== Relink ownership range ====================================== */
+   elements = ST_METHOD(GetElements)(storage);
+   depth    = 0;
+   for(i = elements;i > 0;i >>= 1) {
+      depth++;
+   }
+   nodeArray = NULL;
+   if(transferred * depth >= elements) {
+      nodeArray = (struct STN_CLASSNAME**)malloc((elements + transferred) * sizeof(struct STN_CLASSNAME*));
+   }
+   if(nodeArray != NULL) {
+      /* The remaining nodes go to [0, elements - transferred), the moved
+         range to [elements, elements + transferred). Merging backwards
+         then fills [0, elements) in place. */
+      i    = 0;
+      node = ST_METHOD(GetFirst)(storage);
+      while(node != NULL) {
+         if(ST_CLASS(getPoolElementNodeFromOwnershipStorageNode)(node)->HomeRegistrarIdentifier !=
+               oldHomeRegistrarIdentifier) {
+            nodeArray[i++] = node;
+         }
+         node = ST_METHOD(GetNext)(storage, node);
+      }
+      CHECK(i == elements - transferred);
+      for(k = 0;k < transferred;k++) {
+         poolElementNodeArray[k]->HomeRegistrarIdentifier = newHomeRegistrarIdentifier;
+         nodeArray[elements + k] = &poolElementNodeArray[k]->PoolElementOwnershipStorageNode;
+      }
+      j = elements;
+      while(k > 0) {
+         if((i > 0) &&
+            (storage->ComparisonFunction(nodeArray[i - 1], nodeArray[elements + k - 1]) > 0)) {
+            nodeArray[--j] = nodeArray[--i];
+         }
+         else {
+            nodeArray[--j] = nodeArray[elements + (--k)];
+         }
+      }
+      CHECK(j == i);
+      ST_METHOD(Build)(storage, nodeArray, elements);
+      free(nodeArray);
+   }
+   else {
+      for(k = 0;k < transferred;k++) {
+         poolElementNode = poolElementNodeArray[k];
+         result = ST_METHOD(Remove)(storage, &poolElementNode->PoolElementOwnershipStorageNode);
+         CHECK(result == &poolElementNode->PoolElementOwnershipStorageNode);
+         poolElementNode->HomeRegistrarIdentifier = newHomeRegistrarIdentifier;
+         result = ST_METHOD(Insert)(storage, &poolElementNode->PoolElementOwnershipStorageNode);
+         CHECK(result == &poolElementNode->PoolElementOwnershipStorageNode);
+      }
+   }
+
+   /* ====== Update PEs, checksums and notify ============================ */
+   for(k = 0;k < transferred;k++) {
+      poolElementNode = poolElementNodeArray[k];
+      ST_CLASS(poolHandlespaceNodeLinkPoolElementNodeToOwnerGeneration)(poolHandlespaceNode,
+                                                                        poolElementNode);
+      ST_CLASS(poolHandlespaceNodeRecordTombstone)(poolHandlespaceNode, poolElementNode,
+                                                   oldHomeRegistrarIdentifier);
+      ST_CLASS(poolHandlespaceNodeNotePoolElementNodeModification)(poolHandlespaceNode,
+                                                                   poolElementNode);
+      poolElementNode->Flags = (poolElementNode->Flags & ~PENF_MARKED) | PENF_UPDATED;
+
+      /* The PE checksum does not cover the home PR, i.e. the handlespace
+         checksum remains unchanged. Only the ownership checksums move. */
+      if(oldHomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
+         ST_CLASS(poolHandlespaceNodeRemoveOwnedPoolElementNode)(poolHandlespaceNode,
+                                                                 poolElementNode);
+      }
+      if(newHomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
+         ST_CLASS(poolHandlespaceNodeAddOwnedPoolElementNode)(poolHandlespaceNode,
+                                                              poolElementNode);
+      }
+      if(poolHandlespaceNode->PoolNodeUpdateNotification) {
+         poolHandlespaceNode->PoolNodeUpdateNotification(poolHandlespaceNode,
+                                                         poolElementNode,
+                                                         PNUA_Update,
+                                                         poolElementNode->Checksum,
+                                                         oldHomeRegistrarIdentifier,
+                                                         poolHandlespaceNode->NotificationUserData);
+      }
+   }
+   free(poolElementNodeArray);
+
+#ifdef VERIFY
+   ST_CLASS(poolHandlespaceNodeVerifyChange)(poolHandlespaceNode, NULL);
+#endif
+   return(transferred);
+}
+
+
 /* ###### Update PoolElementNode's connection ############################ */
 void ST_CLASS(poolHandlespaceNodeUpdateConnectionOfPoolElementNode)(
         struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
@@ -687,11 +1553,19 @@ void ST_CLASS(poolHandlespaceNodeUpdatePoolElementNode)(
          poolHandlespaceNode, poolElementNode,
          source->HomeRegistrarIdentifier);
 
+      /* ====== Refresh mark generation ================================== */
+      ST_CLASS(poolHandlespaceNodeRefreshPoolElementNodeGeneration)(poolHandlespaceNode,
+                                                                    poolElementNode);
+
+      /* ====== Note modification for peers' synchronization ============ */
+      ST_CLASS(poolHandlespaceNodeNotePoolElementNodeModification)(poolHandlespaceNode,
+                                                                   poolElementNode);
+
       poolElementNode->Flags &= ~PENF_NEW;
    }
 
 #ifdef VERIFY
-   ST_CLASS(poolHandlespaceNodeVerify)(poolHandlespaceNode);
+   ST_CLASS(poolHandlespaceNodeVerifyChange)(poolHandlespaceNode, &poolElementNode->OwnerPoolNode->Handle);
 #endif
 }
 
@@ -728,24 +1602,8 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeAddOrUpdatePoolEle
 
          /* ====== Update handlespace checksum =========================== */
          newPoolElementNode->Checksum = ST_CLASS(poolElementNodeComputeChecksum)(newPoolElementNode);
-         poolHandlespaceNode->HandlespaceChecksum = handlespaceChecksumAdd(
-                                                       poolHandlespaceNode->HandlespaceChecksum,
-                                                       newPoolElementNode->Checksum);
-         if(newPoolElementNode->HomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
-            poolHandlespaceNode->OwnedPoolElements++;
-            poolHandlespaceNode->OwnershipChecksum = handlespaceChecksumAdd(
-                                                        poolHandlespaceNode->OwnershipChecksum,
-                                                        newPoolElementNode->Checksum);
-         }
-         if(poolHandlespaceNode->PoolNodeUpdateNotification) {
-            poolHandlespaceNode->PoolNodeUpdateNotification(poolHandlespaceNode,
-                                                            newPoolElementNode,
-                                                            PNUA_Create,
-                                                            INITIAL_HANDLESPACE_CHECKSUM,
-                                                            UNDEFINED_REGISTRAR_IDENTIFIER,
-                                                            poolHandlespaceNode->NotificationUserData);
-         }
-         newPoolElementNode->Flags |= PENF_NEW;
+         ST_CLASS(poolHandlespaceNodeAccountForNewPoolElementNode)(poolHandlespaceNode,
+                                                                   newPoolElementNode);
       }
    }
    if(newPoolNode == *poolNode) {
@@ -775,21 +1633,25 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeRemovePoolElementN
    struct ST_CLASS(PoolElementNode)* result2;
 
    /* ====== Unlink PE entry ============================================= */
-   if(STN_METHOD(IsLinked)(&poolElementNode->PoolElementTimerStorageNode)) {
-      result = ST_METHOD(Remove)(&poolHandlespaceNode->PoolElementTimerStorage,
-                                 &poolElementNode->PoolElementTimerStorageNode);
-      CHECK(result == &poolElementNode->PoolElementTimerStorageNode);
-   }
+   ST_CLASS(poolHandlespaceNodeDeactivateTimer)(poolHandlespaceNode, poolElementNode);
    if(STN_METHOD(IsLinked)(&poolElementNode->PoolElementOwnershipStorageNode)) {
       result = ST_METHOD(Remove)(&poolHandlespaceNode->PoolElementOwnershipStorage,
                                  &poolElementNode->PoolElementOwnershipStorageNode);
       CHECK(result == &poolElementNode->PoolElementOwnershipStorageNode);
    }
+   ST_CLASS(poolHandlespaceNodeUnlinkPoolElementNodeFromOwnerGeneration)(poolHandlespaceNode,
+                                                                         poolElementNode);
    if(STN_METHOD(IsLinked)(&poolElementNode->PoolElementConnectionStorageNode)) {
       result = ST_METHOD(Remove)(&poolHandlespaceNode->PoolElementConnectionStorage,
                                  &poolElementNode->PoolElementConnectionStorageNode);
       CHECK(result == &poolElementNode->PoolElementConnectionStorageNode);
    }
+   ST_CLASS(poolHandlespaceNodeAddTombstone)(poolHandlespaceNode, poolElementNode);
+   /* The pool's ownership checksum needs the PE's pool */
+   if(poolElementNode->HomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
+      ST_CLASS(poolHandlespaceNodeRemoveOwnedPoolElementNode)(poolHandlespaceNode,
+                                                              poolElementNode);
+   }
    result2 = ST_CLASS(poolNodeRemovePoolElementNode)(poolElementNode->OwnerPoolNode,
                                                      poolElementNode);
    CHECK(result2 == poolElementNode);
@@ -800,13 +1662,6 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeRemovePoolElementN
    poolHandlespaceNode->HandlespaceChecksum = handlespaceChecksumSub(
                                                  poolHandlespaceNode->HandlespaceChecksum,
                                                  poolElementNode->Checksum);
-   if(poolElementNode->HomeRegistrarIdentifier == poolHandlespaceNode->HomeRegistrarIdentifier) {
-      CHECK(poolHandlespaceNode->OwnedPoolElements > 0);
-      poolHandlespaceNode->OwnedPoolElements--;
-      poolHandlespaceNode->OwnershipChecksum = handlespaceChecksumSub(
-                                                  poolHandlespaceNode->OwnershipChecksum,
-                                                  poolElementNode->Checksum);
-   }
    if(poolHandlespaceNode->PoolNodeUpdateNotification) {
       poolHandlespaceNode->PoolNodeUpdateNotification(poolHandlespaceNode,
                                                       poolElementNode,
@@ -923,11 +1778,61 @@ void ST_CLASS(poolHandlespaceNodePrint)(
 }
 
 
-/* ###### Verify ######################################################### */
-void ST_CLASS(poolHandlespaceNodeVerify)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+/* ###### Verify pool ################################################### */
+static void ST_CLASS(poolHandlespaceNodeVerifyPoolNode)(
+               struct ST_CLASS(PoolNode)* poolNode)
+{
+   ST_METHOD(Verify)(&poolNode->PoolElementIndexStorage);
+   ST_METHOD(Verify)(&poolNode->PoolElementSelectionStorage);
+   ST_CLASS(poolNodeVerifySelectionIndex)(poolNode);
+   ST_CLASS(poolNodeVerifySelectionBuckets)(poolNode);
+   ST_CLASS(poolNodeVerifyIdentifierIndex)(poolNode);
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      CHECK(ST_METHOD(IsEmpty)(&poolNode->PoolElementSelectionStorage));
+      CHECK(bucketQueueGetElements(poolNode->PoolElementSelectionBuckets)
+               == ST_METHOD(GetElements)(&poolNode->PoolElementIndexStorage));
+   }
+   else {
+      CHECK(ST_METHOD(GetElements)(&poolNode->PoolElementSelectionStorage)
+               == ST_METHOD(GetElements)(&poolNode->PoolElementIndexStorage));
+   }
+   CHECK(ST_CLASS(poolNodeGetPoolElementNodes)(poolNode) > 0);
+}
+
+
+/* ###### Verify links of pool into handlespace-wide storages ############ */
+/*
+   Covered by the checks of the complete storages in
+   poolHandlespaceNodeVerify(); needed by the incremental verification
+   only.
+*/
+static void ST_CLASS(poolHandlespaceNodeVerifyPoolNodeLinks)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+               struct ST_CLASS(PoolNode)*            poolNode)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+
+   CHECK(ST_CLASS(poolHandlespaceNodeFindPoolNode)(poolHandlespaceNode, &poolNode->Handle) == poolNode);
+   poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+   while(poolElementNode != NULL) {
+      CHECK(poolElementNode->OwnerPoolNode == poolNode);
+      if(poolElementNode->HomeRegistrarIdentifier != UNDEFINED_REGISTRAR_IDENTIFIER) {
+         CHECK(ST_METHOD(Find)(&poolHandlespaceNode->PoolElementOwnershipStorage,
+                               &poolElementNode->PoolElementOwnershipStorageNode) ==
+                  &poolElementNode->PoolElementOwnershipStorageNode);
+      }
+      poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNode);
+   }
+}
+
+
+/* ###### Verify handlespace-wide structures ############################# */
+static void ST_CLASS(poolHandlespaceNodeVerifyHandlespace)(
+               struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
 {
    struct ST_CLASS(PoolNode)*        poolNode;
    struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct STN_CLASSNAME*             timerNode;
    size_t                            i, j;
    size_t                            ownedPEs;
 
@@ -943,13 +1848,23 @@ void ST_CLASS(poolHandlespaceNodeVerify)(struct ST_CLASS(PoolHandlespaceNode)* p
 */
 
    ST_METHOD(Verify)(&poolHandlespaceNode->PoolIndexStorage);
+   ST_CLASS(poolHandlespaceNodeVerifyPoolHandleIndex)(poolHandlespaceNode);
    ST_METHOD(Verify)(&poolHandlespaceNode->PoolElementTimerStorage);
    ST_METHOD(Verify)(&poolHandlespaceNode->PoolElementOwnershipStorage);
-
-   i = 0;
-   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementTimerNode)(poolHandlespaceNode);
-   while(poolElementNode != NULL) {
-      poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementTimerNode)(poolHandlespaceNode, poolElementNode);
+   ST_CLASS(poolHandlespaceNodeVerifyOwnerGenerations)(poolHandlespaceNode);
+   ST_CLASS(poolHandlespaceNodeVerifyModifications)(poolHandlespaceNode);
+   ST_CLASS(poolHandlespaceNodeVerifyOwnershipDigestTree)(poolHandlespaceNode);
+   timingWheelVerify(&poolHandlespaceNode->PoolElementTimerWheel);
+
+   /* Do not use GetFirst/GetNext here: they would fetch from the wheel */
+   i = timingWheelGetElements(&poolHandlespaceNode->PoolElementTimerWheel);
+   timerNode = ST_METHOD(GetFirst)(&poolHandlespaceNode->PoolElementTimerStorage);
+   while(timerNode != NULL) {
+      poolElementNode = ST_CLASS(getPoolElementNodeFromTimerStorageNode)(timerNode);
+      CHECK(!timingWheelNodeIsLinked(&poolElementNode->PoolElementTimerWheelNode));
+      CHECK(!timingWheelAccepts(&poolHandlespaceNode->PoolElementTimerWheel,
+                                poolElementNode->TimerTimeStamp));
+      timerNode = ST_METHOD(GetNext)(&poolHandlespaceNode->PoolElementTimerStorage, timerNode);
       i++;
    }
    CHECK(i == timers);
@@ -971,10 +1886,6 @@ void ST_CLASS(poolHandlespaceNodeVerify)(struct ST_CLASS(PoolHandlespaceNode)* p
    i = 0; j = 0;
    poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
    while(poolNode != NULL) {
-      ST_METHOD(Verify)(&poolNode->PoolElementIndexStorage);
-      ST_METHOD(Verify)(&poolNode->PoolElementSelectionStorage);
-      CHECK(ST_METHOD(GetElements)(&poolNode->PoolElementSelectionStorage)
-               == ST_METHOD(GetElements)(&poolNode->PoolElementIndexStorage));
       CHECK(ST_CLASS(poolNodeGetPoolElementNodes)(poolNode) > 0);
       j += ST_CLASS(poolNodeGetPoolElementNodes)(poolNode);
       poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
@@ -999,6 +1910,92 @@ void ST_CLASS(poolHandlespaceNodeVerify)(struct ST_CLASS(PoolHandlespaceNode)* p
 }
 
 
+/* ###### Verify ######################################################### */
+void ST_CLASS(poolHandlespaceNodeVerify)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   struct ST_CLASS(PoolNode)* poolNode;
+
+   ST_CLASS(poolHandlespaceNodeVerifyHandlespace)(poolHandlespaceNode);
+   poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+   while(poolNode != NULL) {
+      ST_CLASS(poolHandlespaceNodeVerifyPoolNode)(poolNode);
+      poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
+   }
+}
+
+
+/* ###### Verify incrementally ########################################### */
+/*
+   Verifies the pool of the given handle (if poolHandle is not NULL and
+   the pool still exists), followed by further pools of a sweep over all
+   pools, until about budget PEs have been verified. When the sweep
+   reaches the end, the handlespace-wide structures are verified and the
+   sweep starts again; the function returns 1 then. So, the cost of an
+   incremental verification is proportional to the budget on average,
+   and every inconsistency is found within one sweep.
+*/
+int ST_CLASS(poolHandlespaceNodeVerifyIncremental)(
+       struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+       const struct PoolHandle*              poolHandle,
+       const size_t                          budget)
+{
+   struct ST_CLASS(PoolNode)* poolNode;
+   size_t                     poolElements = 0;
+
+   CHECK(ST_METHOD(GetElements)(&poolHandlespaceNode->PoolElementOwnershipStorage) <=
+            ST_CLASS(poolHandlespaceNodeGetPoolElementNodes)(poolHandlespaceNode));
+
+   if(poolHandle != NULL) {
+      poolNode = ST_CLASS(poolHandlespaceNodeFindPoolNode)(poolHandlespaceNode, poolHandle);
+      if(poolNode != NULL) {
+         ST_CLASS(poolHandlespaceNodeVerifyPoolNode)(poolNode);
+         ST_CLASS(poolHandlespaceNodeVerifyPoolNodeLinks)(poolHandlespaceNode, poolNode);
+         poolElements += ST_CLASS(poolNodeGetPoolElementNodes)(poolNode);
+      }
+   }
+
+   while(poolElements < budget) {
+      if(poolHandlespaceNode->VerificationCursor.Size == 0) {
+         poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+      }
+      else {
+         poolNode = ST_CLASS(poolHandlespaceNodeFindNearestNextPoolNode)(
+                       poolHandlespaceNode, &poolHandlespaceNode->VerificationCursor);
+      }
+      if(poolNode == NULL) {
+         /* ====== Sweep completed ========================================= */
+         ST_CLASS(poolHandlespaceNodeVerifyHandlespace)(poolHandlespaceNode);
+         poolHandlespaceNode->VerificationCursor.Size = 0;
+         return(1);
+      }
+      ST_CLASS(poolHandlespaceNodeVerifyPoolNode)(poolNode);
+      ST_CLASS(poolHandlespaceNodeVerifyPoolNodeLinks)(poolHandlespaceNode, poolNode);
+      poolElements += ST_CLASS(poolNodeGetPoolElementNodes)(poolNode);
+      poolHandlespaceNode->VerificationCursor = poolNode->Handle;
+   }
+   return(0);
+}
+
+
+/* ###### Verify after a change ########################################## */
+/*
+   With VERIFY_BUDGET defined, the verification is incremental, see
+   poolHandlespaceNodeVerifyIncremental(); otherwise, it is complete.
+   poolHandle is the pool changed, or NULL.
+*/
+void ST_CLASS(poolHandlespaceNodeVerifyChange)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const struct PoolHandle*              poolHandle)
+{
+#ifdef VERIFY_BUDGET
+   ST_CLASS(poolHandlespaceNodeVerifyIncremental)(poolHandlespaceNode, poolHandle, VERIFY_BUDGET);
+#else
+   (void)poolHandle;
+   ST_CLASS(poolHandlespaceNodeVerify)(poolHandlespaceNode);
+#endif
+}
+
+
 /* ###### Clear ########################################################## */
 void ST_CLASS(poolHandlespaceNodeClear)(struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
                                         void                                (*poolNodeDisposer)(void* poolNode, void* userData),
@@ -1072,6 +2069,318 @@ size_t ST_CLASS(poolHandlespaceNodeGetOwnershipNodesForIdentifier)(
 }
 
 
+/* ###### Mark pool element nodes owned by given PR ###################### */
+/*
+   The first marking for an owner creates its mark generation, linking
+   its PEs once. Afterwards, marking is O(1). If the mark generation
+   cannot be allocated, the PEs are marked by PENF_MARKED instead.
+*/
+void ST_CLASS(poolHandlespaceNodeMarkPoolElementNodes)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const RegistrarIdentifierType         ownerID)
+{
+   struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration;
+   struct ST_CLASS(PoolElementNode)*            poolElementNode;
+
+   ownerGeneration = ST_CLASS(poolHandlespaceNodeFindOwnerGeneration)(poolHandlespaceNode, ownerID);
+   if((ownerGeneration == NULL) && (ownerID != UNDEFINED_REGISTRAR_IDENTIFIER) &&
+      (ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+          poolHandlespaceNode, ownerID) != NULL)) {
+      ownerGeneration = (struct ST_CLASS(PoolElementOwnerGeneration)*)
+                           malloc(sizeof(struct ST_CLASS(PoolElementOwnerGeneration)));
+      if(ownerGeneration != NULL) {
+         ownerGeneration->OwnerIdentifier = ownerID;
+         ownerGeneration->Generation      = 0;
+         doubleLinkedRingListNew(&ownerGeneration->PoolElementList);
+         if(identifierHashTableInsert(&poolHandlespaceNode->OwnerGenerationIndex,
+                                      ownerID, ownerGeneration)) {
+            poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+                                 poolHandlespaceNode, ownerID);
+            while(poolElementNode != NULL) {
+               poolElementNode->Flags &= ~PENF_MARKED;   /* Replaced by generation */
+               ST_CLASS(poolHandlespaceNodeLinkPoolElementNodeToOwnerGeneration)(
+                  poolHandlespaceNode, poolElementNode);
+               poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+                                    poolHandlespaceNode, poolElementNode);
+            }
+         }
+         else {
+            doubleLinkedRingListDelete(&ownerGeneration->PoolElementList);
+            free(ownerGeneration);
+            ownerGeneration = NULL;
+         }
+      }
+   }
+
+   if(ownerGeneration != NULL) {
+      ownerGeneration->Generation++;
+   }
+   else {
+      poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+                           poolHandlespaceNode, ownerID);
+      while(poolElementNode != NULL) {
+         poolElementNode->Flags |= PENF_MARKED;
+         poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+                              poolHandlespaceNode, poolElementNode);
+      }
+   }
+}
+
+
+/* ###### Get first marked pool element node of given PR ################# */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstMarkedPoolElementNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     const RegistrarIdentifierType         ownerID)
+{
+   struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration;
+   struct ST_CLASS(PoolElementNode)*            poolElementNode;
+
+   ownerGeneration = ST_CLASS(poolHandlespaceNodeFindOwnerGeneration)(poolHandlespaceNode, ownerID);
+   if(ownerGeneration != NULL) {
+      /* The marked PEs are at the head of the generation list */
+      if(ownerGeneration->PoolElementList.Node.Next != &ownerGeneration->PoolElementList.Node) {
+         poolElementNode = ST_CLASS(getPoolElementNodeFromGenerationListNode)(
+                              ownerGeneration->PoolElementList.Node.Next);
+         if(poolElementNode->Generation != ownerGeneration->Generation) {
+            return(poolElementNode);
+         }
+      }
+      return(NULL);
+   }
+
+   poolElementNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+                        poolHandlespaceNode, ownerID);
+   if((poolElementNode != NULL) && (!(poolElementNode->Flags & PENF_MARKED))) {
+      poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextMarkedPoolElementNode)(
+                           poolHandlespaceNode, poolElementNode);
+   }
+   return(poolElementNode);
+}
+
+
+/* ###### Get next marked pool element node of same PR ################### */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetNextMarkedPoolElementNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration;
+
+   ownerGeneration = ST_CLASS(poolHandlespaceNodeFindOwnerGeneration)(
+                        poolHandlespaceNode, poolElementNode->HomeRegistrarIdentifier);
+   if(ownerGeneration != NULL) {
+      if(poolElementNode->PoolElementGenerationListNode.Next != &ownerGeneration->PoolElementList.Node) {
+         poolElementNode = ST_CLASS(getPoolElementNodeFromGenerationListNode)(
+                              poolElementNode->PoolElementGenerationListNode.Next);
+         if(poolElementNode->Generation != ownerGeneration->Generation) {
+            return(poolElementNode);
+         }
+      }
+      return(NULL);
+   }
+
+   do {
+      poolElementNode = ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+                           poolHandlespaceNode, poolElementNode);
+   } while((poolElementNode != NULL) && (!(poolElementNode->Flags & PENF_MARKED)));
+   return(poolElementNode);
+}
+
+
+/* ###### Verify mark generations ######################################## */
+void ST_CLASS(poolHandlespaceNodeVerifyOwnerGenerations)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   const struct IdentifierHashTable*                  index = &poolHandlespaceNode->OwnerGenerationIndex;
+   const struct ST_CLASS(PoolElementOwnerGeneration)* ownerGeneration;
+   const struct DoubleLinkedRingListNode*             node;
+   const struct ST_CLASS(PoolElementNode)*            poolElementNode;
+   size_t                                             i, n;
+   int                                                refreshed;
+
+   identifierHashTableVerify(index);
+   for(i = 0;i < index->Capacity;i++) {
+      ownerGeneration = (const struct ST_CLASS(PoolElementOwnerGeneration)*)index->EntryArray[i].Element;
+      if(ownerGeneration != NULL) {
+         CHECK(index->EntryArray[i].Key == ownerGeneration->OwnerIdentifier);
+         n         = 0;
+         refreshed = 0;
+         node      = ownerGeneration->PoolElementList.Node.Next;
+         while(node != &ownerGeneration->PoolElementList.Node) {
+            poolElementNode = ST_CLASS(getPoolElementNodeFromGenerationListNode)((void*)node);
+            CHECK(poolElementNode->HomeRegistrarIdentifier == ownerGeneration->OwnerIdentifier);
+            CHECK(!(poolElementNode->Flags & PENF_MARKED));
+            /* Marked PEs must precede the refreshed ones */
+            if(poolElementNode->Generation == ownerGeneration->Generation) {
+               refreshed = 1;
+            }
+            else {
+               CHECK(!refreshed);
+            }
+            node = node->Next;
+            n++;
+         }
+         CHECK(n == ST_CLASS(poolHandlespaceNodeGetOwnershipNodesForIdentifier)(
+                       poolHandlespaceNode, ownerGeneration->OwnerIdentifier));
+      }
+   }
+}
+
+
+/* ###### Get handlespace version ######################################## */
+/*
+   The handlespace version is incremented by each addition, update,
+   ownership change and removal of a PE. Each PE stores the version of
+   its last change and is kept in a list ordered by it; removals leave a
+   tombstone. So, the changes since a given version can be found by
+   walking back from the tails of both lists.
+*/
+unsigned long long ST_CLASS(poolHandlespaceNodeGetModificationSequence)(
+                      const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   return(poolHandlespaceNode->ModificationSequence);
+}
+
+
+/* ###### Set maximum number of tombstones ############################### */
+void ST_CLASS(poolHandlespaceNodeSetMaxTombstones)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+        const size_t                          maxTombstones)
+{
+   struct ST_CLASS(PoolElementTombstone)* tombstone;
+
+   poolHandlespaceNode->MaxTombstones = maxTombstones;
+   while(poolHandlespaceNode->Tombstones > maxTombstones) {
+      tombstone = ST_CLASS(getTombstoneFromTombstoneListNode)(
+                     poolHandlespaceNode->TombstoneList.Node.Next);
+      poolHandlespaceNode->TombstoneHorizon = tombstone->ModificationSequence;
+      doubleLinkedRingListRemNode(&tombstone->TombstoneListNode);
+      free(tombstone);
+      poolHandlespaceNode->Tombstones--;
+   }
+}
+
+
+/* ###### Check, if changes since given version are available ############ */
+int ST_CLASS(poolHandlespaceNodeHasChangesSince)(
+       const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+       const unsigned long long                    version)
+{
+   /* A version beyond the current one is from another handlespace
+      instance, e.g. of a restarted PR. */
+   return( (version >= poolHandlespaceNode->TombstoneHorizon) &&
+           (version <= poolHandlespaceNode->ModificationSequence) );
+}
+
+
+/* ###### Get first PE modified after given version ###################### */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstPoolElementModifiedSince)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     const unsigned long long              version)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct ST_CLASS(PoolElementNode)* firstPoolElementNode = NULL;
+   struct DoubleLinkedRingListNode*  node;
+
+   node = poolHandlespaceNode->PoolElementModificationList.Node.Prev;
+   while(node != &poolHandlespaceNode->PoolElementModificationList.Node) {
+      poolElementNode = ST_CLASS(getPoolElementNodeFromModificationListNode)(node);
+      if(poolElementNode->ModificationSequence <= version) {
+         break;
+      }
+      firstPoolElementNode = poolElementNode;
+      node = node->Prev;
+   }
+   return(firstPoolElementNode);
+}
+
+
+/* ###### Get next modified PE ########################################### */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetNextModifiedPoolElementNode)(
+                                     struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                     struct ST_CLASS(PoolElementNode)*     poolElementNode)
+{
+   struct DoubleLinkedRingListNode* node = poolElementNode->PoolElementModificationListNode.Next;
+   if(node != &poolHandlespaceNode->PoolElementModificationList.Node) {
+      return(ST_CLASS(getPoolElementNodeFromModificationListNode)(node));
+   }
+   return(NULL);
+}
+
+
+/* ###### Get first tombstone after given version ######################## */
+const struct ST_CLASS(PoolElementTombstone)* ST_CLASS(poolHandlespaceNodeGetFirstTombstoneSince)(
+                                                const struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
+                                                const unsigned long long                    version)
+{
+   const struct ST_CLASS(PoolElementTombstone)* tombstone;
+   const struct ST_CLASS(PoolElementTombstone)* firstTombstone = NULL;
+   const struct DoubleLinkedRingListNode*       node;
+
+   node = poolHandlespaceNode->TombstoneList.Node.Prev;
+   while(node != &poolHandlespaceNode->TombstoneList.Node) {
+      tombstone = ST_CLASS(getTombstoneFromTombstoneListNode)(node);
+      if(tombstone->ModificationSequence <= version) {
+         break;
+      }
+      firstTombstone = tombstone;
+      node = node->Prev;
+   }
+   return(firstTombstone);
+}
+
+
+/* ###### Get next tombstone ############################################# */
+const struct ST_CLASS(PoolElementTombstone)* ST_CLASS(poolHandlespaceNodeGetNextTombstone)(
+                                                const struct ST_CLASS(PoolHandlespaceNode)*  poolHandlespaceNode,
+                                                const struct ST_CLASS(PoolElementTombstone)* tombstone)
+{
+   const struct DoubleLinkedRingListNode* node = tombstone->TombstoneListNode.Next;
+   if(node != &poolHandlespaceNode->TombstoneList.Node) {
+      return(ST_CLASS(getTombstoneFromTombstoneListNode)(node));
+   }
+   return(NULL);
+}
+
+
+/* ###### Verify modification list and tombstones ######################## */
+void ST_CLASS(poolHandlespaceNodeVerifyModifications)(
+        struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode)
+{
+   const struct DoubleLinkedRingListNode*       node;
+   const struct ST_CLASS(PoolElementNode)*      poolElementNode;
+   const struct ST_CLASS(PoolElementTombstone)* tombstone;
+   unsigned long long                           lastSequence;
+   size_t                                       n;
+
+   n            = 0;
+   lastSequence = 0;
+   node         = poolHandlespaceNode->PoolElementModificationList.Node.Next;
+   while(node != &poolHandlespaceNode->PoolElementModificationList.Node) {
+      poolElementNode = ST_CLASS(getPoolElementNodeFromModificationListNode)((void*)node);
+      CHECK(poolElementNode->ModificationSequence > lastSequence);
+      lastSequence = poolElementNode->ModificationSequence;
+      node = node->Next;
+      n++;
+   }
+   CHECK(lastSequence <= poolHandlespaceNode->ModificationSequence);
+   CHECK(n == poolHandlespaceNode->PoolElements);
+
+   n            = 0;
+   lastSequence = poolHandlespaceNode->TombstoneHorizon;
+   node         = poolHandlespaceNode->TombstoneList.Node.Next;
+   while(node != &poolHandlespaceNode->TombstoneList.Node) {
+      tombstone = ST_CLASS(getTombstoneFromTombstoneListNode)(node);
+      CHECK(tombstone->ModificationSequence > lastSequence);
+      lastSequence = tombstone->ModificationSequence;
+      node = node->Next;
+      n++;
+   }
+   CHECK(lastSequence <= poolHandlespaceNode->ModificationSequence);
+   CHECK(n == poolHandlespaceNode->Tombstones);
+   CHECK(n <= poolHandlespaceNode->MaxTombstones);
+}
+
+
 /* ###### Get first connection node of given connection ################## */
 struct ST_CLASS(PoolElementNode)* ST_CLASS(poolHandlespaceNodeGetFirstPoolElementConnectionNodeForConnection)(
                                      struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode,
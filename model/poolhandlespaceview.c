@@ -0,0 +1,493 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "poolhandlespaceview.h"
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ###### Constructor #################################################### */
+/*
+   The PEs have to be set by poolViewSetPoolElement(), followed by
+   poolViewBuildSelectionTable().
+*/
+struct PoolView* poolViewNew(const struct PoolHandle* poolHandle,
+                             const unsigned int       policyType,
+                             const int                protocol,
+                             const int                flags,
+                             const unsigned int       selectionMode,
+                             const size_t             poolElements)
+{
+   struct PoolView* poolView = (struct PoolView*)malloc(sizeof(struct PoolView));
+   if(poolView != NULL) {
+      poolView->PoolElementArray = (struct PoolElementView*)calloc(
+                                      (poolElements > 0) ? poolElements : 1,
+                                      sizeof(struct PoolElementView));
+      if(poolView->PoolElementArray == NULL) {
+         free(poolView);
+         return(NULL);
+      }
+      poolHandleNew(&poolView->Handle, poolHandle->Handle, poolHandle->Size);
+      poolView->Handle.Identifier   = poolHandle->Identifier;
+      poolView->PolicyType          = policyType;
+      poolView->Protocol            = protocol;
+      poolView->Flags               = flags;
+      poolView->SelectionMode       = selectionMode;
+      poolView->PoolElements        = poolElements;
+      poolView->SelectionTableValid = 0;
+      poolView->RotationCounter     = 0;
+      poolView->TiedPoolElements    = 0;
+      poolView->References          = 0;
+      aliasTableNew(&poolView->SelectionTable);
+   }
+   return(poolView);
+}
+
+
+/* ###### Destructor ##################################################### */
+void poolViewDelete(void* poolViewPtr)
+{
+   struct PoolView* poolView = (struct PoolView*)poolViewPtr;
+   size_t           i;
+
+   for(i = 0;i < poolView->PoolElements;i++) {
+      free(poolView->PoolElementArray[i].UserTransport);
+   }
+   aliasTableDelete(&poolView->SelectionTable);
+   free(poolView->PoolElementArray);
+   free(poolView);
+}
+
+
+/* ###### Set PE of given selection order position ####################### */
+int poolViewSetPoolElement(struct PoolView*                    poolView,
+                           const size_t                        index,
+                           const PoolElementIdentifierType     identifier,
+                           const RegistrarIdentifierType       homeRegistrarIdentifier,
+                           const unsigned int                  registrationLife,
+                           const unsigned long long            selectionValue,
+                           const struct PoolPolicySettings*    policySettings,
+                           const struct TransportAddressBlock* userTransport)
+{
+   struct PoolElementView* poolElementView = &poolView->PoolElementArray[index];
+
+   CHECK(index < poolView->PoolElements);
+   poolElementView->Identifier              = identifier;
+   poolElementView->HomeRegistrarIdentifier = homeRegistrarIdentifier;
+   poolElementView->RegistrationLife        = registrationLife;
+   poolElementView->SelectionValue          = selectionValue;
+   poolElementView->PolicySettings          = *policySettings;
+   poolElementView->UserTransport           = transportAddressBlockDuplicate(userTransport);
+   return(poolElementView->UserTransport != NULL);
+}
+
+
+/* ###### Build alias table for PVSM_BY_VALUE selection ################## */
+/* If it cannot be built, selections use the linear scan. */
+void poolViewBuildSelectionTable(struct PoolView* poolView)
+{
+   size_t i;
+
+   poolView->SelectionTableValid = 0;
+   if(poolView->SelectionMode == PVSM_BY_VALUE) {
+      aliasTableClear(&poolView->SelectionTable);
+      for(i = 0;i < poolView->PoolElements;i++) {
+         if(!aliasTableAppend(&poolView->SelectionTable,
+                              &poolView->PoolElementArray[i],
+                              poolView->PoolElementArray[i].SelectionValue)) {
+            return;
+         }
+      }
+      poolView->SelectionTableValid = aliasTableBuild(&poolView->SelectionTable);
+   }
+}
+
+
+/* ###### Check, whether PE view has already been chosen ################# */
+static int poolViewIsChosen(const struct PoolElementView** poolElementViewArray,
+                            const size_t                   poolElementViews,
+                            const struct PoolElementView*  poolElementView)
+{
+   size_t i;
+
+   for(i = 0;i < poolElementViews;i++) {
+      if(poolElementViewArray[i] == poolElementView) {
+         return(1);
+      }
+   }
+   return(0);
+}
+
+
+/* ###### Select PEs by their selection values ########################### */
+/*
+   Draws from the alias table; already chosen PEs are drawn again. When
+   most of the value sum has been chosen, the remaining PEs are chosen by
+   a linear scan over the values.
+*/
+static size_t poolViewSelectPoolElementsByValue(struct PoolView*               poolView,
+                                                const struct PoolElementView** poolElementViewArray,
+                                                const size_t                   maxPoolElementViews,
+                                                unsigned long long*            randomState)
+{
+   const size_t                  toChoose = (poolView->PoolElements < maxPoolElementViews) ?
+                                               poolView->PoolElements : maxPoolElementViews;
+   const struct PoolElementView* poolElementView;
+   size_t                        poolElementViews = 0;
+   size_t                        rejections       = 0;
+   unsigned long long            valueSum;
+   unsigned long long            value;
+   size_t                        i;
+
+   if( (poolView->SelectionTableValid) &&
+       (aliasTableGetValueSum(&poolView->SelectionTable) > 0) ) {
+      while( (poolElementViews < toChoose) && (rejections < POOLVIEW_MAX_REJECTIONS) ) {
+         poolElementView = (const struct PoolElementView*)aliasTableGetElement(
+                              &poolView->SelectionTable,
+                              aliasTableDraw(&poolView->SelectionTable,
+                                             poolHandlespaceViewRandom(randomState)));
+         if(poolViewIsChosen(poolElementViewArray, poolElementViews, poolElementView)) {
+            rejections++;
+         }
+         else {
+            poolElementViewArray[poolElementViews++] = poolElementView;
+            rejections = 0;
+         }
+      }
+   }
+
+   while(poolElementViews < toChoose) {
+      valueSum = 0;
+      for(i = 0;i < poolView->PoolElements;i++) {
+         if(!poolViewIsChosen(poolElementViewArray, poolElementViews, &poolView->PoolElementArray[i])) {
+            valueSum += poolView->PoolElementArray[i].SelectionValue;
+         }
+      }
+      if(valueSum < 1) {
+         break;
+      }
+      value = poolHandlespaceViewRandom(randomState) % valueSum;
+      for(i = 0;i < poolView->PoolElements;i++) {
+         poolElementView = &poolView->PoolElementArray[i];
+         if(!poolViewIsChosen(poolElementViewArray, poolElementViews, poolElementView)) {
+            if(value < poolElementView->SelectionValue) {
+               poolElementViewArray[poolElementViews++] = poolElementView;
+               break;
+            }
+            value -= poolElementView->SelectionValue;
+         }
+      }
+   }
+   return(poolElementViews);
+}
+
+
+/* ###### Select PEs ##################################################### */
+/* May be called concurrently by reader threads. */
+size_t poolViewSelectPoolElements(struct PoolView*               poolView,
+                                  const struct PoolElementView** poolElementViewArray,
+                                  const size_t                   maxPoolElementViews,
+                                  unsigned long long*            randomState)
+{
+   const size_t toChoose = (poolView->PoolElements < maxPoolElementViews) ?
+                              poolView->PoolElements : maxPoolElementViews;
+   size_t       position = 0;
+   size_t       i;
+
+   if(toChoose == 0) {
+      return(0);
+   }
+   if(poolView->SelectionMode == PVSM_BY_VALUE) {
+      return(poolViewSelectPoolElementsByValue(poolView, poolElementViewArray,
+                                               maxPoolElementViews, randomState));
+   }
+   else if(poolView->SelectionMode == PVSM_ROTATING) {
+      position = __atomic_fetch_add(&poolView->RotationCounter, 1, __ATOMIC_RELAXED) %
+                    poolView->PoolElements;
+   }
+   else if(poolView->TiedPoolElements > 1) {
+      /* Rotate through the PEs of equal rank, then continue in order */
+      position = __atomic_fetch_add(&poolView->RotationCounter, 1, __ATOMIC_RELAXED) %
+                    poolView->TiedPoolElements;
+      for(i = 0;i < toChoose;i++) {
+         if(i < poolView->TiedPoolElements) {
+            poolElementViewArray[i] = &poolView->PoolElementArray[position];
+            if(++position >= poolView->TiedPoolElements) {
+               position = 0;
+            }
+         }
+         else {
+            poolElementViewArray[i] = &poolView->PoolElementArray[i];
+         }
+      }
+      return(toChoose);
+   }
+   for(i = 0;i < toChoose;i++) {
+      poolElementViewArray[i] = &poolView->PoolElementArray[position];
+      if(++position >= poolView->PoolElements) {
+         position = 0;
+      }
+   }
+   return(toChoose);
+}
+
+
+/* ###### Get number of bytes allocated for a pool view ################## */
+size_t poolViewGetMemoryUsage(const struct PoolView* poolView)
+{
+   size_t bytes = sizeof(struct PoolView) +
+                     (((poolView->PoolElements > 0) ? poolView->PoolElements : 1) *
+                        sizeof(struct PoolElementView)) +
+                     aliasTableGetMemoryUsage(&poolView->SelectionTable);
+   size_t i;
+
+   for(i = 0;i < poolView->PoolElements;i++) {
+      if(poolView->PoolElementArray[i].UserTransport != NULL) {
+         bytes += transportAddressBlockGetSize(
+                     poolView->PoolElementArray[i].UserTransport->Addresses);
+      }
+   }
+   return(bytes);
+}
+
+
+/* ###### Constructor #################################################### */
+/* The pools have to be set in pool handle order. */
+struct PoolHandlespaceView* poolHandlespaceViewNew(const size_t pools)
+{
+   struct PoolHandlespaceView* poolHandlespaceView =
+      (struct PoolHandlespaceView*)malloc(sizeof(struct PoolHandlespaceView));
+   if(poolHandlespaceView != NULL) {
+      poolHandlespaceView->PoolArray = (struct PoolView**)calloc((pools > 0) ? pools : 1,
+                                                                 sizeof(struct PoolView*));
+      if(poolHandlespaceView->PoolArray == NULL) {
+         free(poolHandlespaceView);
+         return(NULL);
+      }
+      poolHandlespaceView->Version      = 0;
+      poolHandlespaceView->PoolElements = 0;
+      poolHandlespaceView->Pools        = pools;
+   }
+   return(poolHandlespaceView);
+}
+
+
+/* ###### Destructor ##################################################### */
+/* The pool views are not deleted, since they may be shared. */
+void poolHandlespaceViewDelete(void* poolHandlespaceViewPtr)
+{
+   struct PoolHandlespaceView* poolHandlespaceView = (struct PoolHandlespaceView*)poolHandlespaceViewPtr;
+   free(poolHandlespaceView->PoolArray);
+   free(poolHandlespaceView);
+}
+
+
+/* ###### Find pool view ################################################# */
+struct PoolView* poolHandlespaceViewFindPool(const struct PoolHandlespaceView* poolHandlespaceView,
+                                             const struct PoolHandle*          poolHandle)
+{
+   size_t low  = 0;
+   size_t high = poolHandlespaceView->Pools;
+   size_t middle;
+   int    result;
+
+   while(low < high) {
+      middle = low + (high - low) / 2;
+      result = poolHandleComparison(&poolHandlespaceView->PoolArray[middle]->Handle, poolHandle);
+      if(result < 0) {
+         low = middle + 1;
+      }
+      else if(result > 0) {
+         high = middle;
+      }
+      else {
+         return(poolHandlespaceView->PoolArray[middle]);
+      }
+   }
+   return(NULL);
+}
+
+
+/* ###### Handle resolution ############################################## */
+/* May be called concurrently by reader threads. */
+size_t poolHandlespaceViewHandleResolution(const struct PoolHandlespaceView* poolHandlespaceView,
+                                           const struct PoolHandle*          poolHandle,
+                                           const struct PoolElementView**    poolElementViewArray,
+                                           const size_t                      maxPoolElementViews,
+                                           unsigned long long*               randomState)
+{
+   struct PoolView* poolView = poolHandlespaceViewFindPool(poolHandlespaceView, poolHandle);
+   if(poolView != NULL) {
+      return(poolViewSelectPoolElements(poolView, poolElementViewArray,
+                                        maxPoolElementViews, randomState));
+   }
+   return(0);
+}
+
+
+/* ###### Verify structure ############################################### */
+void poolHandlespaceViewVerify(const struct PoolHandlespaceView* poolHandlespaceView)
+{
+   const struct PoolView* poolView;
+   size_t                 poolElements = 0;
+   size_t                 i, j;
+
+   for(i = 0;i < poolHandlespaceView->Pools;i++) {
+      poolView = poolHandlespaceView->PoolArray[i];
+      CHECK(poolView != NULL);
+      if(i > 0) {
+         CHECK(poolHandleComparison(&poolHandlespaceView->PoolArray[i - 1]->Handle,
+                                    &poolView->Handle) < 0);
+      }
+      CHECK(poolView->References > 0);
+      for(j = 0;j < poolView->PoolElements;j++) {
+         CHECK(poolView->PoolElementArray[j].UserTransport != NULL);
+      }
+      CHECK(poolView->TiedPoolElements <= poolView->PoolElements);
+      if(poolView->SelectionTableValid) {
+         CHECK(poolView->SelectionMode == PVSM_BY_VALUE);
+         aliasTableVerify(&poolView->SelectionTable);
+         CHECK(aliasTableGetEntries(&poolView->SelectionTable) == poolView->PoolElements);
+      }
+      poolElements += poolView->PoolElements;
+   }
+   CHECK(poolElements == poolHandlespaceView->PoolElements);
+}
+
+
+/* ###### Get number of bytes allocated for a view and its pool views ### */
+size_t poolHandlespaceViewGetMemoryUsage(const struct PoolHandlespaceView* poolHandlespaceView)
+{
+   size_t bytes = sizeof(struct PoolHandlespaceView) +
+                     (((poolHandlespaceView->Pools > 0) ? poolHandlespaceView->Pools : 1) *
+                        sizeof(struct PoolView*));
+   size_t i;
+
+   for(i = 0;i < poolHandlespaceView->Pools;i++) {
+      bytes += poolViewGetMemoryUsage(poolHandlespaceView->PoolArray[i]);
+   }
+   return(bytes);
+}
+
+
+/* ###### Constructor #################################################### */
+void poolHandlespaceViewPublisherNew(struct PoolHandlespaceViewPublisher* publisher)
+{
+   epochReclamationNew(&publisher->Reclamation);
+   publisher->CurrentView = NULL;
+}
+
+
+/* ###### Destructor ##################################################### */
+/* All readers must have left their read-side sections. */
+void poolHandlespaceViewPublisherDelete(struct PoolHandlespaceViewPublisher* publisher)
+{
+   struct PoolHandlespaceView* poolHandlespaceView = publisher->CurrentView;
+   size_t                      i;
+
+   epochReclamationDelete(&publisher->Reclamation);
+   if(poolHandlespaceView != NULL) {
+      for(i = 0;i < poolHandlespaceView->Pools;i++) {
+         poolViewDelete(poolHandlespaceView->PoolArray[i]);
+      }
+      poolHandlespaceViewDelete(poolHandlespaceView);
+      publisher->CurrentView = NULL;
+   }
+}
+
+
+/* ###### Retire view no longer published ############################## */
+/*
+   Its pool views not used by any other view are retired as well; they
+   are freed after all readers still using them have left their sections.
+*/
+static void poolHandlespaceViewPublisherRetire(struct PoolHandlespaceViewPublisher* publisher,
+                                               struct PoolHandlespaceView*          poolHandlespaceView)
+{
+   size_t i;
+
+   for(i = 0;i < poolHandlespaceView->Pools;i++) {
+      CHECK(poolHandlespaceView->PoolArray[i]->References > 0);
+      if(--poolHandlespaceView->PoolArray[i]->References == 0) {
+         epochReclamationRetire(&publisher->Reclamation,
+                                poolHandlespaceView->PoolArray[i], poolViewDelete);
+      }
+   }
+   epochReclamationRetire(&publisher->Reclamation,
+                          poolHandlespaceView, poolHandlespaceViewDelete);
+}
+
+
+/* ###### Publish new view ############################################### */
+/*
+   Readers entering from now on get the new view. The previous view is
+   retired, together with its pool views not shared with the new one.
+*/
+void poolHandlespaceViewPublisherPublish(struct PoolHandlespaceViewPublisher* publisher,
+                                         struct PoolHandlespaceView*          poolHandlespaceView)
+{
+   struct PoolHandlespaceView* oldPoolHandlespaceView = publisher->CurrentView;
+   size_t                      i;
+
+   for(i = 0;i < poolHandlespaceView->Pools;i++) {
+      poolHandlespaceView->PoolArray[i]->References++;
+   }
+   __atomic_store_n(&publisher->CurrentView, poolHandlespaceView, __ATOMIC_RELEASE);
+
+   if(oldPoolHandlespaceView != NULL) {
+      poolHandlespaceViewPublisherRetire(publisher, oldPoolHandlespaceView);
+   }
+   epochReclamationReclaim(&publisher->Reclamation);
+}
+
+
+/* ###### Free retired views no reader can use anymore ################### */
+size_t poolHandlespaceViewPublisherReclaim(struct PoolHandlespaceViewPublisher* publisher)
+{
+   return(epochReclamationReclaim(&publisher->Reclamation));
+}
+
+
+/* ###### Get number of bytes allocated for the current view ############# */
+/* Retired views still waiting for readers to leave are not counted. */
+size_t poolHandlespaceViewPublisherGetMemoryUsage(const struct PoolHandlespaceViewPublisher* publisher)
+{
+   if(publisher->CurrentView != NULL) {
+      return(poolHandlespaceViewGetMemoryUsage(publisher->CurrentView));
+   }
+   return(0);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,238 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef POOLHANDLESPACEVIEW_H
+#define POOLHANDLESPACEVIEW_H
+
+#include "poolhandlespacemanagement-basics.h"
+#include "poolhandle.h"
+#include "poolpolicysettings.h"
+#include "transportaddressblock.h"
+#include "aliastable.h"
+#include "epochreclamation.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Immutable view of a handlespace, for concurrent readers. The writer
+   builds it from the handlespace and publishes it by
+   poolHandlespaceViewPublisherPublish(); readers take the current view
+   in a read-side section of the publisher's epoch-based reclamation
+   and may use it, and all pool and PE views reachable from it, until
+   they leave the section. Views of unchanged pools are shared between
+   successive handlespace views, but a pool view is not updated
+   incrementally: any change of a pool copies all of its PEs into a new
+   view.
+
+   The view is a read-only approximation of the handlespace, not a
+   concurrent mode of its handle resolution. Readers select PEs by the
+   copied selection order and values: the value tree policies draw by
+   the PEs' selection values, the round robin policies rotate through
+   the selection order by an atomic counter, and all other policies
+   rotate the same way through their first PEs of equal rank, as the
+   sequence numbers would in the handlespace, followed by the next PEs
+   of the selection order. A rebuilt pool view continues the rotation of
+   the previous one. Readers rotate by one PE per selection, i.e. as for
+   a maximum increment of 1. Their selections do not change the
+   handlespace: the policies' per-selection updates (degradation, the
+   virtual counters of weighted round robin, DPF) are not applied, so
+   the selections differ from the ones of the handlespace's own handle
+   resolution.
+*/
+#define PVSM_BY_VALUE     1   /* Weighted random draws                  */
+#define PVSM_ROTATING     2   /* Rotate through the selection order     */
+#define PVSM_IN_ORDER     3   /* First PEs of the selection order       */
+
+/* Consecutive draws of already chosen PEs, before a PVSM_BY_VALUE
+   selection continues by a linear scan */
+#define POOLVIEW_MAX_REJECTIONS 16
+
+struct PoolElementView
+{
+   PoolElementIdentifierType     Identifier;
+   RegistrarIdentifierType       HomeRegistrarIdentifier;
+   unsigned int                  RegistrationLife;
+   unsigned long long            SelectionValue;
+   struct PoolPolicySettings     PolicySettings;
+   struct TransportAddressBlock* UserTransport;
+};
+
+struct PoolView
+{
+   struct PoolHandle             Handle;
+   unsigned int                  PolicyType;
+   int                           Protocol;
+   int                           Flags;
+   unsigned int                  SelectionMode;
+   size_t                        PoolElements;
+   struct PoolElementView*       PoolElementArray;   /* In selection order           */
+   struct AliasTable             SelectionTable;     /* PVSM_BY_VALUE, if buildable  */
+   int                           SelectionTableValid;
+   size_t                        RotationCounter;    /* Not PVSM_BY_VALUE, atomic    */
+   size_t                        TiedPoolElements;   /* PVSM_IN_ORDER: of equal rank */
+
+   size_t                        References;         /* Writer only: views using it  */
+};
+
+struct PoolHandlespaceView
+{
+   unsigned long long            Version;            /* Handlespace version          */
+   size_t                        PoolElements;
+   size_t                        Pools;
+   struct PoolView**             PoolArray;          /* In pool handle order         */
+};
+
+struct PoolHandlespaceViewPublisher
+{
+   struct EpochReclamation       Reclamation;
+   struct PoolHandlespaceView*   CurrentView;        /* Atomic                       */
+};
+
+
+struct PoolView* poolViewNew(const struct PoolHandle* poolHandle,
+                             const unsigned int       policyType,
+                             const int                protocol,
+                             const int                flags,
+                             const unsigned int       selectionMode,
+                             const size_t             poolElements);
+void poolViewDelete(void* poolViewPtr);
+int poolViewSetPoolElement(struct PoolView*                    poolView,
+                           const size_t                        index,
+                           const PoolElementIdentifierType     identifier,
+                           const RegistrarIdentifierType       homeRegistrarIdentifier,
+                           const unsigned int                  registrationLife,
+                           const unsigned long long            selectionValue,
+                           const struct PoolPolicySettings*    policySettings,
+                           const struct TransportAddressBlock* userTransport);
+void poolViewBuildSelectionTable(struct PoolView* poolView);
+size_t poolViewGetMemoryUsage(const struct PoolView* poolView);
+size_t poolViewSelectPoolElements(struct PoolView*               poolView,
+                                  const struct PoolElementView** poolElementViewArray,
+                                  const size_t                   maxPoolElementViews,
+                                  unsigned long long*            randomState);
+
+struct PoolHandlespaceView* poolHandlespaceViewNew(const size_t pools);
+void poolHandlespaceViewDelete(void* poolHandlespaceViewPtr);
+struct PoolView* poolHandlespaceViewFindPool(const struct PoolHandlespaceView* poolHandlespaceView,
+                                             const struct PoolHandle*          poolHandle);
+size_t poolHandlespaceViewHandleResolution(const struct PoolHandlespaceView* poolHandlespaceView,
+                                           const struct PoolHandle*          poolHandle,
+                                           const struct PoolElementView**    poolElementViewArray,
+                                           const size_t                      maxPoolElementViews,
+                                           unsigned long long*               randomState);
+void poolHandlespaceViewVerify(const struct PoolHandlespaceView* poolHandlespaceView);
+size_t poolHandlespaceViewGetMemoryUsage(const struct PoolHandlespaceView* poolHandlespaceView);
+
+void poolHandlespaceViewPublisherNew(struct PoolHandlespaceViewPublisher* publisher);
+void poolHandlespaceViewPublisherDelete(struct PoolHandlespaceViewPublisher* publisher);
+void poolHandlespaceViewPublisherPublish(struct PoolHandlespaceViewPublisher* publisher,
+                                         struct PoolHandlespaceView*          poolHandlespaceView);
+size_t poolHandlespaceViewPublisherReclaim(struct PoolHandlespaceViewPublisher* publisher);
+size_t poolHandlespaceViewPublisherGetMemoryUsage(const struct PoolHandlespaceViewPublisher* publisher);
+
+
+inline static unsigned long long poolHandlespaceViewGetVersion(const struct PoolHandlespaceView* poolHandlespaceView)
+{
+   return(poolHandlespaceView->Version);
+}
+
+inline static size_t poolHandlespaceViewGetPoolElements(const struct PoolHandlespaceView* poolHandlespaceView)
+{
+   return(poolHandlespaceView->PoolElements);
+}
+
+inline static size_t poolHandlespaceViewGetPools(const struct PoolHandlespaceView* poolHandlespaceView)
+{
+   return(poolHandlespaceView->Pools);
+}
+
+inline static struct PoolView* poolHandlespaceViewGetPool(const struct PoolHandlespaceView* poolHandlespaceView,
+                                                          const size_t                      index)
+{
+   return(poolHandlespaceView->PoolArray[index]);
+}
+
+inline static size_t poolViewGetPoolElements(const struct PoolView* poolView)
+{
+   return(poolView->PoolElements);
+}
+
+inline static const struct PoolElementView* poolViewGetPoolElement(const struct PoolView* poolView,
+                                                                   const size_t           index)
+{
+   return(&poolView->PoolElementArray[index]);
+}
+
+/* Random numbers of a reader thread (xorshift64*); the state must not be 0 */
+inline static unsigned long long poolHandlespaceViewRandom(unsigned long long* randomState)
+{
+   *randomState ^= *randomState >> 12;
+   *randomState ^= *randomState << 25;
+   *randomState ^= *randomState >> 27;
+   return(*randomState * 0x2545f4914f6cdd1dULL);
+}
+
+/* ###### Reader thread functions ###################################### */
+inline static int poolHandlespaceViewPublisherRegisterReader(struct PoolHandlespaceViewPublisher* publisher)
+{
+   return(epochReclamationRegisterReader(&publisher->Reclamation));
+}
+
+inline static void poolHandlespaceViewPublisherUnregisterReader(struct PoolHandlespaceViewPublisher* publisher,
+                                                                const int                            readerID)
+{
+   epochReclamationUnregisterReader(&publisher->Reclamation, readerID);
+}
+
+/* Enter read-side section and get the current view (NULL, if none has
+   been published yet) */
+inline static const struct PoolHandlespaceView* poolHandlespaceViewPublisherEnter(
+                                                   struct PoolHandlespaceViewPublisher* publisher,
+                                                   const int                            readerID)
+{
+   epochReclamationEnter(&publisher->Reclamation, readerID);
+   return(__atomic_load_n(&publisher->CurrentView, __ATOMIC_ACQUIRE));
+}
+
+/* Leave read-side section; the view must not be used anymore */
+inline static void poolHandlespaceViewPublisherLeave(struct PoolHandlespaceViewPublisher* publisher,
+                                                     const int                            readerID)
+{
+   epochReclamationLeave(&publisher->Reclamation, readerID);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -39,7 +39,11 @@ extern "C" {
 struct ST_CLASS(PoolHandlespaceNode);
 
 
-#define PNF_CONTROLCHANNEL (1 << 0)
+#define PNF_CONTROLCHANNEL       (1 << 0)
+/* Draws may use an alias table, if the policy supports it */
+#define PNF_SELECTION_ALIASTABLE (1 << 1)
+
+#define POOLNODE_ALIASTABLE_REBUILD_DIVISOR 16
 
 struct ST_CLASS(PoolNode)
 {
@@ -48,7 +52,48 @@ struct ST_CLASS(PoolNode)
    struct ST_CLASSNAME                   PoolElementIndexStorage;
    struct ST_CLASS(PoolHandlespaceNode)* OwnerPoolHandlespaceNode;
 
+   /* Prefix sums over the selection storage values, in selection storage
+      order. Used by the value tree policies; rebuilt on demand after
+      the selection storage has changed. */
+   struct FenwickTree                    PoolElementSelectionIndex;
+   int                                   PoolElementSelectionIndexValid;
+
+   /* Hash index over the PE identifiers, used for point lookups by
+      poolNodeFindPoolElementNode(). Ordered access still uses the
+      PoolElementIndexStorage. Built on demand by the first lookup. */
+   struct IdentifierHashTable            PoolElementIdentifierIndex;
+   int                                   PoolElementIdentifierIndexValid;
+
+   /* Selection storage of pools whose policy has a SelectionKeyFunction:
+      a bucket queue in the same (key, SeqNumber) order as the tree. The
+      PoolElementSelectionStorage tree is left empty then. NULL for other
+      policies, or if the allocation has failed. */
+   struct BucketQueue*                   PoolElementSelectionBuckets;
+
+   /* Alias table over the selection storage values, in selection storage
+      order, for pools of policies with SelectionByAliasTable. A rebuild
+      takes O(n): it is deferred until n / POOLNODE_ALIASTABLE_REBUILD_DIVISOR
+      selections have been made since the last one; until then, selections
+      use the selection index. NULL for other policies, or if the
+      allocation has failed. */
+   struct AliasTable*                    PoolElementSelectionAliasTable;
+   int                                   PoolElementSelectionAliasTableValid;
+   size_t                                PoolElementSelectionsSinceAliasTableBuild;
+
+   /* Checksum over the PEs owned by the handlespace's home PR, i.e. this
+      pool's leaf of the ownership digest tree. The tree bucket is set
+      when the pool is added to a handlespace. */
+   HandlespaceChecksumAccumulatorType    OwnershipChecksum;
+   size_t                                OwnedPoolElements;
+   unsigned int                          OwnershipDigestBucket;
+
+   /* View of this pool in the handlespace's published view, to be shared
+      by the next one. NULL, if the pool has changed since (or if there is
+      no published view). The view is owned by the view publisher. */
+   struct PoolView*                      View;
+
    struct PoolHandle                     Handle;
+   HandlespaceChecksumAccumulatorType    HandleChecksum;   /* Common part of the PE checksums */
    const struct ST_CLASS(PoolPolicy)*    Policy;
    int                                   Protocol;
    int                                   Flags;
@@ -68,6 +113,8 @@ void ST_CLASS(poolNodeNew)(struct ST_CLASS(PoolNode)*         poolNode,
                            const int                          protocol,
                            const int                          flags);
 void ST_CLASS(poolNodeDelete)(struct ST_CLASS(PoolNode)* poolNode);
+void ST_CLASS(poolNodeAddMemoryUsage)(struct ST_CLASS(PoolNode)*     poolNode,
+                                      struct HandlespaceMemoryUsage* memoryUsage);
 
 void ST_CLASS(poolNodeResequence)(struct ST_CLASS(PoolNode)* poolNode);
 size_t ST_CLASS(poolNodeGetPoolElementNodes)(
@@ -93,6 +140,15 @@ void ST_CLASS(poolNodeUnlinkPoolElementNodeFromSelection)(
 void ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(
         struct ST_CLASS(PoolNode)*        poolNode,
         struct ST_CLASS(PoolElementNode)* poolElementNode);
+void ST_CLASS(poolNodeRelinkPoolElementNodeToSelection)(
+        struct ST_CLASS(PoolNode)*        poolNode,
+        struct ST_CLASS(PoolElementNode)* poolElementNode);
+int ST_CLASS(poolNodeUpdateSelectionIndex)(struct ST_CLASS(PoolNode)* poolNode);
+int ST_CLASS(poolNodeUpdateSelectionAliasTable)(struct ST_CLASS(PoolNode)* poolNode);
+void ST_CLASS(poolNodeVerifySelectionIndex)(struct ST_CLASS(PoolNode)* poolNode);
+void ST_CLASS(poolNodeVerifySelectionBuckets)(struct ST_CLASS(PoolNode)* poolNode);
+int ST_CLASS(poolNodeUpdateIdentifierIndex)(struct ST_CLASS(PoolNode)* poolNode);
+void ST_CLASS(poolNodeVerifyIdentifierIndex)(struct ST_CLASS(PoolNode)* poolNode);
 unsigned int ST_CLASS(poolNodeCheckPoolElementNodeCompatibility)(
                 struct ST_CLASS(PoolNode)*          poolNode,
                 struct ST_CLASS(PoolElementNode)*   poolElementNode);
@@ -100,6 +156,10 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeAddPoolElementNode)(
                                      struct ST_CLASS(PoolNode)*        poolNode,
                                      struct ST_CLASS(PoolElementNode)* poolElementNode,
                                      unsigned int*                     errorCode);
+void ST_CLASS(poolNodeAddPoolElementNodes)(
+        struct ST_CLASS(PoolNode)*         poolNode,
+        struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+        const size_t                       poolElementNodes);
 void ST_CLASS(poolNodeUpdatePoolElementNode)(
         struct ST_CLASS(PoolNode)*              poolNode,
         struct ST_CLASS(PoolElementNode)*       poolElementNode,
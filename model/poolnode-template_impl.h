@@ -56,13 +56,43 @@ void ST_CLASS(poolNodeNew)(struct ST_CLASS(PoolNode)*         poolNode,
    poolHandleNew(&poolNode->Handle,
                  poolHandle->Handle,
                  poolHandle->Size);
+   poolNode->Handle.Identifier = poolHandleGetIdentifier(poolHandle);
+   poolNode->HandleChecksum    = handlespaceChecksumCompute(INITIAL_HANDLESPACE_CHECKSUM,
+                                                            (const char*)&poolNode->Handle.Handle,
+                                                            poolNode->Handle.Size);
    poolNode->Policy                 = poolPolicy;
    poolNode->Protocol               = protocol;
    poolNode->Flags                  = flags;
    poolNode->GlobalSeqNumber        = SeqNumberStart;
    poolNode->UserData               = NULL;
    poolNode->OwnerPoolHandlespaceNode = NULL;
-   ST_METHOD(New)(&poolNode->PoolElementSelectionStorage, ST_CLASS(poolElementSelectionStorageNodePrint), ST_CLASS(poolElementSelectionStorageNodeComparison));
+   poolNode->OwnershipChecksum      = INITIAL_HANDLESPACE_CHECKSUM;
+   poolNode->OwnedPoolElements      = 0;
+   poolNode->OwnershipDigestBucket  = 0;
+   poolNode->View                   = NULL;
+   fenwickTreeNew(&poolNode->PoolElementSelectionIndex);
+   poolNode->PoolElementSelectionIndexValid = 0;
+   poolNode->PoolElementSelectionAliasTableValid = 0;
+   identifierHashTableNew(&poolNode->PoolElementIdentifierIndex);
+   poolNode->PoolElementIdentifierIndexValid = 0;
+   poolNode->PoolElementSelectionBuckets = NULL;
+#ifdef USE_POOLELEMENT_SELECTION_BUCKETQUEUE
+   if(poolPolicy->SelectionKeyFunction != NULL) {
+      poolNode->PoolElementSelectionBuckets = (struct BucketQueue*)malloc(sizeof(struct BucketQueue));
+      if(poolNode->PoolElementSelectionBuckets != NULL) {
+         bucketQueueNew(poolNode->PoolElementSelectionBuckets);
+      }
+   }
+#endif
+   poolNode->PoolElementSelectionAliasTable = NULL;
+   poolNode->PoolElementSelectionsSinceAliasTableBuild = ~((size_t)0) >> 1;
+   if((flags & PNF_SELECTION_ALIASTABLE) && (poolPolicy->SelectionByAliasTable)) {
+      poolNode->PoolElementSelectionAliasTable = (struct AliasTable*)malloc(sizeof(struct AliasTable));
+      if(poolNode->PoolElementSelectionAliasTable != NULL) {
+         aliasTableNew(poolNode->PoolElementSelectionAliasTable);
+      }
+   }
+   ST_METHOD(New)(&poolNode->PoolElementSelectionStorage, ST_CLASS(poolElementSelectionStorageNodePrint), poolPolicy->SelectionStorageNodeComparisonFunction);
    ST_METHOD(New)(&poolNode->PoolElementIndexStorage, ST_CLASS(poolElementIndexStorageNodePrint), ST_CLASS(poolElementIndexStorageNodeComparison));
 }
 
@@ -75,11 +105,61 @@ void ST_CLASS(poolNodeDelete)(struct ST_CLASS(PoolNode)* poolNode)
    poolHandleDelete(&poolNode->Handle);
    ST_METHOD(Delete)(&poolNode->PoolElementSelectionStorage);
    ST_METHOD(Delete)(&poolNode->PoolElementIndexStorage);
+   fenwickTreeDelete(&poolNode->PoolElementSelectionIndex);
+   poolNode->PoolElementSelectionIndexValid = 0;
+   poolNode->PoolElementSelectionAliasTableValid = 0;
+   identifierHashTableDelete(&poolNode->PoolElementIdentifierIndex);
+   poolNode->PoolElementIdentifierIndexValid = 0;
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      bucketQueueDelete(poolNode->PoolElementSelectionBuckets);
+      free(poolNode->PoolElementSelectionBuckets);
+      poolNode->PoolElementSelectionBuckets = NULL;
+   }
+   if(poolNode->PoolElementSelectionAliasTable != NULL) {
+      aliasTableDelete(poolNode->PoolElementSelectionAliasTable);
+      free(poolNode->PoolElementSelectionAliasTable);
+      poolNode->PoolElementSelectionAliasTable = NULL;
+   }
    poolNode->Protocol = 0;
    poolNode->UserData = NULL;
 }
 
 
+/* ###### Add memory usage of pool node and its PE nodes ################ */
+void ST_CLASS(poolNodeAddMemoryUsage)(struct ST_CLASS(PoolNode)*     poolNode,
+                                      struct HandlespaceMemoryUsage* memoryUsage)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+
+   memoryUsage->Nodes       += sizeof(struct ST_CLASS(PoolNode)) +
+                                  (ST_CLASS(poolNodeGetPoolElementNodes)(poolNode) *
+                                     sizeof(struct ST_CLASS(PoolElementNode)));
+   memoryUsage->PolicyState += ST_METHOD(GetMemoryUsage)(&poolNode->PoolElementSelectionStorage) +
+                               fenwickTreeGetMemoryUsage(&poolNode->PoolElementSelectionIndex);
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      memoryUsage->PolicyState += sizeof(struct BucketQueue) +
+                                  bucketQueueGetMemoryUsage(poolNode->PoolElementSelectionBuckets);
+   }
+   if(poolNode->PoolElementSelectionAliasTable != NULL) {
+      memoryUsage->PolicyState += sizeof(struct AliasTable) +
+                                  aliasTableGetMemoryUsage(poolNode->PoolElementSelectionAliasTable);
+   }
+   memoryUsage->Other       += ST_METHOD(GetMemoryUsage)(&poolNode->PoolElementIndexStorage) +
+                               identifierHashTableGetMemoryUsage(&poolNode->PoolElementIdentifierIndex);
+
+   poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+   while(poolElementNode != NULL) {
+      memoryUsage->TransportAddressBlocks +=
+         transportAddressBlockGetSize(poolElementNode->UserTransport->Addresses);
+      if(poolElementNode->RegistratorTransport != NULL) {
+         memoryUsage->TransportAddressBlocks +=
+            transportAddressBlockGetSize(poolElementNode->RegistratorTransport->Addresses);
+      }
+      poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNode);
+   }
+}
+
+
 /* ###### Get textual description ######################################## */
 void ST_CLASS(poolNodeGetDescription)(const struct ST_CLASS(PoolNode)* poolNode,
                                       char*                            buffer,
@@ -275,7 +355,13 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeGetNextPoolElementNodeFromInd
 struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(
                                      struct ST_CLASS(PoolNode)* poolNode)
 {
-   struct STN_CLASSNAME* node = ST_METHOD(GetFirst)(&poolNode->PoolElementSelectionStorage);
+   struct STN_CLASSNAME* node;
+
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionBucketNode)(
+                bucketQueueGetFirst(poolNode->PoolElementSelectionBuckets)));
+   }
+   node = ST_METHOD(GetFirst)(&poolNode->PoolElementSelectionStorage);
    if(node) {
       return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionStorageNode)(node));
    }
@@ -287,7 +373,13 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeGetFirstPoolElementNodeFromSe
 struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeGetLastPoolElementNodeFromSelection)(
                                      struct ST_CLASS(PoolNode)* poolNode)
 {
-   struct STN_CLASSNAME* node = ST_METHOD(GetLast)(&poolNode->PoolElementSelectionStorage);
+   struct STN_CLASSNAME* node;
+
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionBucketNode)(
+                bucketQueueGetLast(poolNode->PoolElementSelectionBuckets)));
+   }
+   node = ST_METHOD(GetLast)(&poolNode->PoolElementSelectionStorage);
    if(node) {
       return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionStorageNode)(node));
    }
@@ -300,8 +392,15 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeGetNextPoolElementNodeFromSel
                                      struct ST_CLASS(PoolNode)*        poolNode,
                                      struct ST_CLASS(PoolElementNode)* poolElementNode)
 {
-   struct STN_CLASSNAME* node = ST_METHOD(GetNext)(&poolNode->PoolElementSelectionStorage,
-                                                   &poolElementNode->PoolElementSelectionStorageNode);
+   struct STN_CLASSNAME* node;
+
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionBucketNode)(
+                bucketQueueGetNext(poolNode->PoolElementSelectionBuckets,
+                                   &poolElementNode->PoolElementSelectionBucketNode)));
+   }
+   node = ST_METHOD(GetNext)(&poolNode->PoolElementSelectionStorage,
+                            &poolElementNode->PoolElementSelectionStorageNode);
    if(node) {
       return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionStorageNode)(node));
    }
@@ -314,8 +413,15 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeGetPrevPoolElementNodeFromSel
                                      struct ST_CLASS(PoolNode)*        poolNode,
                                      struct ST_CLASS(PoolElementNode)* poolElementNode)
 {
-   struct STN_CLASSNAME* node = ST_METHOD(GetPrev)(&poolNode->PoolElementSelectionStorage,
-                                                   &poolElementNode->PoolElementSelectionStorageNode);
+   struct STN_CLASSNAME* node;
+
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionBucketNode)(
+                bucketQueueGetPrev(poolNode->PoolElementSelectionBuckets,
+                                   &poolElementNode->PoolElementSelectionBucketNode)));
+   }
+   node = ST_METHOD(GetPrev)(&poolNode->PoolElementSelectionStorage,
+                            &poolElementNode->PoolElementSelectionStorageNode);
    if(node) {
       return(ST_CLASS(getPoolElementNodeFromPoolElementSelectionStorageNode)(node));
    }
@@ -328,9 +434,19 @@ void ST_CLASS(poolNodeUnlinkPoolElementNodeFromSelection)(
         struct ST_CLASS(PoolNode)*        poolNode,
         struct ST_CLASS(PoolElementNode)* poolElementNode)
 {
-   struct STN_CLASSNAME* node = ST_METHOD(Remove)(&poolNode->PoolElementSelectionStorage,
-                                                  &poolElementNode->PoolElementSelectionStorageNode);
-   CHECK(node == &poolElementNode->PoolElementSelectionStorageNode);
+   struct STN_CLASSNAME* node;
+
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      bucketQueueRemove(poolNode->PoolElementSelectionBuckets,
+                        &poolElementNode->PoolElementSelectionBucketNode);
+   }
+   else {
+      node = ST_METHOD(Remove)(&poolNode->PoolElementSelectionStorage,
+                               &poolElementNode->PoolElementSelectionStorageNode);
+      CHECK(node == &poolElementNode->PoolElementSelectionStorageNode);
+   }
+   poolNode->PoolElementSelectionIndexValid = 0;
+   poolNode->PoolElementSelectionAliasTableValid = 0;
 }
 
 
@@ -347,9 +463,229 @@ void ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(
       (*poolNode->Policy->UpdatePoolElementNodeFunction)(poolElementNode);
    }
 
-   node = ST_METHOD(Insert)(&poolNode->PoolElementSelectionStorage,
-                            &poolElementNode->PoolElementSelectionStorageNode);
-   CHECK(node == &poolElementNode->PoolElementSelectionStorageNode);
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      bucketQueueInsert(poolNode->PoolElementSelectionBuckets,
+                        &poolElementNode->PoolElementSelectionBucketNode,
+                        poolNode->Policy->SelectionKeyFunction(poolElementNode),
+                        poolElementNode->SeqNumber);
+   }
+   else {
+      node = ST_METHOD(Insert)(&poolNode->PoolElementSelectionStorage,
+                               &poolElementNode->PoolElementSelectionStorageNode);
+      CHECK(node == &poolElementNode->PoolElementSelectionStorageNode);
+   }
+   poolNode->PoolElementSelectionIndexValid = 0;
+   poolNode->PoolElementSelectionAliasTableValid = 0;
+}
+
+
+/* ###### Re-link PoolElementNode into Selection ######################### */
+/*
+   Re-inserts the node after a change of its policy information. The
+   policies selecting by value order their selection storage by PE
+   identifier, i.e. the node keeps its position: a valid selection index
+   is then updated in place, in O(log n), instead of being invalidated.
+*/
+void ST_CLASS(poolNodeRelinkPoolElementNodeToSelection)(
+        struct ST_CLASS(PoolNode)*        poolNode,
+        struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   const int updateSelectionIndex =
+      (poolNode->PoolElementSelectionIndexValid) &&
+      (poolNode->Policy->SelectionByValueTree);
+
+   ST_CLASS(poolNodeUnlinkPoolElementNodeFromSelection)(poolNode, poolElementNode);
+   ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(poolNode, poolElementNode);
+   if(updateSelectionIndex) {
+      CHECK(fenwickTreeGetElement(&poolNode->PoolElementSelectionIndex,
+                                  poolElementNode->SelectionIndexPosition) == poolElementNode);
+      fenwickTreeUpdate(&poolNode->PoolElementSelectionIndex,
+                        poolElementNode->SelectionIndexPosition,
+                        poolElementNode->PoolElementSelectionStorageNode.Value);
+      poolNode->PoolElementSelectionIndexValid = 1;
+   }
+}
+
+
+/* ###### Rebuild selection index, if necessary ########################## */
+int ST_CLASS(poolNodeUpdateSelectionIndex)(struct ST_CLASS(PoolNode)* poolNode)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+
+   if(!poolNode->PoolElementSelectionIndexValid) {
+      fenwickTreeClear(&poolNode->PoolElementSelectionIndex);
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+      while(poolElementNode != NULL) {
+         poolElementNode->SelectionIndexPosition =
+            fenwickTreeGetEntries(&poolNode->PoolElementSelectionIndex);
+         if(!fenwickTreeAppend(&poolNode->PoolElementSelectionIndex,
+                               poolElementNode,
+                               poolElementNode->PoolElementSelectionStorageNode.Value)) {
+            return(0);
+         }
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
+      }
+      fenwickTreeBuild(&poolNode->PoolElementSelectionIndex);
+      poolNode->PoolElementSelectionIndexValid = 1;
+   }
+   return(1);
+}
+
+
+/* ###### Rebuild selection alias table, if necessary and worthwhile ##### */
+int ST_CLASS(poolNodeUpdateSelectionAliasTable)(struct ST_CLASS(PoolNode)* poolNode)
+{
+   struct AliasTable*                aliasTable = poolNode->PoolElementSelectionAliasTable;
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+
+   CHECK(aliasTable != NULL);
+   poolNode->PoolElementSelectionsSinceAliasTableBuild++;
+   if(!poolNode->PoolElementSelectionAliasTableValid) {
+      /* The pool is churning: leave the selection to the selection index */
+      if(poolNode->PoolElementSelectionsSinceAliasTableBuild <
+            ST_METHOD(GetElements)(&poolNode->PoolElementSelectionStorage) / POOLNODE_ALIASTABLE_REBUILD_DIVISOR) {
+         return(0);
+      }
+
+      aliasTableClear(aliasTable);
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+      while(poolElementNode != NULL) {
+         if(!aliasTableAppend(aliasTable, poolElementNode,
+                              poolElementNode->PoolElementSelectionStorageNode.Value)) {
+            return(0);
+         }
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
+      }
+      if(!aliasTableBuild(aliasTable)) {
+         return(0);
+      }
+      poolNode->PoolElementSelectionAliasTableValid       = 1;
+      poolNode->PoolElementSelectionsSinceAliasTableBuild = 0;
+   }
+   return(1);
+}
+
+
+/* ###### Verify selection index ######################################### */
+void ST_CLASS(poolNodeVerifySelectionIndex)(struct ST_CLASS(PoolNode)* poolNode)
+{
+   const struct FenwickTree*         index      = &poolNode->PoolElementSelectionIndex;
+   const struct AliasTable*          aliasTable = poolNode->PoolElementSelectionAliasTable;
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   size_t                            i;
+
+   if((poolNode->PoolElementSelectionAliasTableValid) && (aliasTable != NULL)) {
+      aliasTableVerify(aliasTable);
+      CHECK(aliasTableGetEntries(aliasTable) ==
+               ST_METHOD(GetElements)(&poolNode->PoolElementSelectionStorage));
+      i = 0;
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+      while(poolElementNode != NULL) {
+         CHECK(aliasTableGetElement(aliasTable, i) == poolElementNode);
+         CHECK(aliasTableGetValue(aliasTable, i) ==
+                  poolElementNode->PoolElementSelectionStorageNode.Value);
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
+         i++;
+      }
+   }
+   if(poolNode->PoolElementSelectionIndexValid) {
+      fenwickTreeVerify(index);
+      CHECK(fenwickTreeGetEntries(index) ==
+               ST_METHOD(GetElements)(&poolNode->PoolElementSelectionStorage));
+      i = 0;
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+      while(poolElementNode != NULL) {
+         CHECK(fenwickTreeGetElement(index, i) == poolElementNode);
+         CHECK(poolElementNode->SelectionIndexPosition == i);
+         CHECK(fenwickTreeGetValue(index, i) ==
+                  poolElementNode->PoolElementSelectionStorageNode.Value);
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
+         i++;
+      }
+   }
+}
+
+
+/* ###### Verify selection bucket queue ################################## */
+void ST_CLASS(poolNodeVerifySelectionBuckets)(struct ST_CLASS(PoolNode)* poolNode)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct ST_CLASS(PoolElementNode)* prevPoolElementNode;
+
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      bucketQueueVerify(poolNode->PoolElementSelectionBuckets);
+
+      /* The bucket queue order has to be the policy's sorting order */
+      prevPoolElementNode = NULL;
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
+      while(poolElementNode != NULL) {
+         CHECK(poolElementNode->PoolElementSelectionBucketNode.Key ==
+                  poolNode->Policy->SelectionKeyFunction(poolElementNode));
+         CHECK(poolElementNode->PoolElementSelectionBucketNode.Sequence == poolElementNode->SeqNumber);
+         CHECK((prevPoolElementNode == NULL) ||
+               (poolNode->Policy->ComparisonFunction(prevPoolElementNode, poolElementNode) < 0));
+         CHECK(ST_CLASS(poolNodeGetPrevPoolElementNodeFromSelection)(poolNode, poolElementNode) ==
+                  prevPoolElementNode);
+         prevPoolElementNode = poolElementNode;
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
+      }
+      CHECK(ST_CLASS(poolNodeGetLastPoolElementNodeFromSelection)(poolNode) == prevPoolElementNode);
+   }
+}
+
+
+/* ###### Rebuild identifier index, if necessary ######################### */
+int ST_CLASS(poolNodeUpdateIdentifierIndex)(struct ST_CLASS(PoolNode)* poolNode)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+
+   if(!poolNode->PoolElementIdentifierIndexValid) {
+      identifierHashTableClear(&poolNode->PoolElementIdentifierIndex);
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+      while(poolElementNode != NULL) {
+         if(!identifierHashTableInsert(&poolNode->PoolElementIdentifierIndex,
+                                       poolElementNode->Identifier, poolElementNode)) {
+            return(0);
+         }
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNode);
+      }
+      poolNode->PoolElementIdentifierIndexValid = 1;
+   }
+   return(1);
+}
+
+
+/* ###### Verify identifier index ######################################## */
+void ST_CLASS(poolNodeVerifyIdentifierIndex)(struct ST_CLASS(PoolNode)* poolNode)
+{
+   const struct IdentifierHashTable* index = &poolNode->PoolElementIdentifierIndex;
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+
+   if(poolNode->PoolElementIdentifierIndexValid) {
+      identifierHashTableVerify(index);
+      CHECK(identifierHashTableGetEntries(index) ==
+               ST_METHOD(GetElements)(&poolNode->PoolElementIndexStorage));
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+      while(poolElementNode != NULL) {
+         CHECK(identifierHashTableFind(index, poolElementNode->Identifier) == poolElementNode);
+         poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolNode, poolElementNode);
+      }
+   }
+}
+
+
+/* ###### Add PoolElementNode to identifier index ######################## */
+static void ST_CLASS(poolNodeLinkPoolElementNodeToIdentifierIndex)(
+               struct ST_CLASS(PoolNode)*        poolNode,
+               struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   /* If the index cannot grow, it is rebuilt by the next lookup */
+   if(poolNode->PoolElementIdentifierIndexValid) {
+      if(!identifierHashTableInsert(&poolNode->PoolElementIdentifierIndex,
+                                    poolElementNode->Identifier, poolElementNode)) {
+         poolNode->PoolElementIdentifierIndexValid = 0;
+      }
+   }
 }
 
 
@@ -383,6 +719,7 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeAddPoolElementNode)(
       if(poolNode->Policy->InitializePoolElementNodeFunction) {
          poolNode->Policy->InitializePoolElementNodeFunction(poolElementNode);
       }
+      ST_CLASS(poolNodeLinkPoolElementNodeToIdentifierIndex)(poolNode, poolElementNode);
       ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(poolNode, poolElementNode);
       *errorCode = RSPERR_OKAY;
       return(poolElementNode);
@@ -392,6 +729,111 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeAddPoolElementNode)(
 }
 
 
+/* ###### Link initialized PoolElementNodes to index and selection ###### */
+static void ST_CLASS(poolNodeLinkPoolElementNodes)(
+               struct ST_CLASS(PoolNode)*         poolNode,
+               struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+               const size_t                       poolElementNodes,
+               struct STN_CLASSNAME**             storageNodeArray)
+{
+   size_t i;
+
+   for(i = 0;i < poolElementNodes;i++) {
+      ST_CLASS(poolNodeLinkPoolElementNodeToIdentifierIndex)(poolNode, poolElementNodeArray[i]);
+   }
+   if(storageNodeArray != NULL) {
+      for(i = 0;i < poolElementNodes;i++) {
+         storageNodeArray[i] = &poolElementNodeArray[i]->PoolElementIndexStorageNode;
+      }
+      ST_CLASS(poolElementStorageInsertNodes)(&poolNode->PoolElementIndexStorage,
+                                              storageNodeArray, poolElementNodes);
+      if(poolNode->PoolElementSelectionBuckets == NULL) {
+         for(i = 0;i < poolElementNodes;i++) {
+            storageNodeArray[i] = &poolElementNodeArray[i]->PoolElementSelectionStorageNode;
+         }
+         ST_CLASS(poolElementStorageInsertNodes)(&poolNode->PoolElementSelectionStorage,
+                                                 storageNodeArray, poolElementNodes);
+      }
+   }
+   else {
+      for(i = 0;i < poolElementNodes;i++) {
+         CHECK(ST_METHOD(Insert)(&poolNode->PoolElementIndexStorage,
+                                 &poolElementNodeArray[i]->PoolElementIndexStorageNode) ==
+                  &poolElementNodeArray[i]->PoolElementIndexStorageNode);
+         if(poolNode->PoolElementSelectionBuckets == NULL) {
+            CHECK(ST_METHOD(Insert)(&poolNode->PoolElementSelectionStorage,
+                                    &poolElementNodeArray[i]->PoolElementSelectionStorageNode) ==
+                     &poolElementNodeArray[i]->PoolElementSelectionStorageNode);
+         }
+      }
+   }
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      for(i = 0;i < poolElementNodes;i++) {
+         bucketQueueInsert(poolNode->PoolElementSelectionBuckets,
+                           &poolElementNodeArray[i]->PoolElementSelectionBucketNode,
+                           poolNode->Policy->SelectionKeyFunction(poolElementNodeArray[i]),
+                           poolElementNodeArray[i]->SeqNumber);
+      }
+   }
+}
+
+
+/* ###### Add multiple PoolElementNodes ################################## */
+/*
+   The PoolElementNodes must be compatible to the pool (see
+   poolNodeCheckPoolElementNodeCompatibility()), and their identifiers
+   must be unique and not yet used in the pool. Sequence numbers are
+   assigned in array order, i.e. the result equals adding the nodes one
+   by one by poolNodeAddPoolElementNode().
+*/
+void ST_CLASS(poolNodeAddPoolElementNodes)(
+        struct ST_CLASS(PoolNode)*         poolNode,
+        struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+        const size_t                       poolElementNodes)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   struct STN_CLASSNAME**            storageNodeArray;
+   size_t                            first, last;
+
+   storageNodeArray = (struct STN_CLASSNAME**)malloc(poolElementNodes * sizeof(struct STN_CLASSNAME*));
+   for(first = 0;first < poolElementNodes;first = last) {
+      /* ====== Initialize PE entries up to sequence number wrap ========= */
+      for(last = first;last < poolElementNodes;last++) {
+         if((PoolElementSeqNumberType)(poolNode->GlobalSeqNumber + 1) <
+            poolNode->GlobalSeqNumber) {
+            break;
+         }
+         poolElementNode = poolElementNodeArray[last];
+         CHECK(ST_CLASS(poolNodeCheckPoolElementNodeCompatibility)(poolNode, poolElementNode) == RSPERR_OKAY);
+         poolElementNode->Flags |= PENF_UPDATED;
+         poolElementNode->SeqNumber        = poolNode->GlobalSeqNumber++;
+         poolElementNode->VirtualCounter   = 0;
+         poolElementNode->RoundCounter     = 0;
+         poolElementNode->SelectionCounter = 0;
+         poolElementNode->Degradation      = 0;
+         poolElementNode->OwnerPoolNode    = poolNode;
+         if(poolNode->Policy->InitializePoolElementNodeFunction) {
+            poolNode->Policy->InitializePoolElementNodeFunction(poolElementNode);
+         }
+         CHECK(poolPolicySettingsIsValid(&poolElementNode->PolicySettings));
+         if(poolNode->Policy->UpdatePoolElementNodeFunction) {
+            (*poolNode->Policy->UpdatePoolElementNodeFunction)(poolElementNode);
+         }
+      }
+
+      /* ====== Link PE entries to index and selection storages ========== */
+      ST_CLASS(poolNodeLinkPoolElementNodes)(poolNode, &poolElementNodeArray[first],
+                                             last - first, storageNodeArray);
+      if(last < poolElementNodes) {
+         ST_CLASS(poolNodeResequence)(poolNode);
+      }
+   }
+   free(storageNodeArray);
+   poolNode->PoolElementSelectionIndexValid = 0;
+   poolNode->PoolElementSelectionAliasTableValid = 0;
+}
+
+
 /* ###### Update PoolElementNode ######################################### */
 void ST_CLASS(poolNodeUpdatePoolElementNode)(
         struct ST_CLASS(PoolNode)*              poolNode,
@@ -406,8 +848,7 @@ void ST_CLASS(poolNodeUpdatePoolElementNode)(
             Policy information has changed. Now, the node has to be re-inserted (Selection only).
             Currently, the node's position may be incorrect now!
          */
-         ST_CLASS(poolNodeUnlinkPoolElementNodeFromSelection)(poolNode, poolElementNode);
-         ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(poolNode, poolElementNode);
+         ST_CLASS(poolNodeRelinkPoolElementNodeToSelection)(poolNode, poolElementNode);
       }
    }
 }
@@ -421,6 +862,14 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeFindPoolElementNode)(
    struct ST_CLASS(PoolElementNode) cmpElement;
    struct STN_CLASSNAME*            result;
 
+#ifdef USE_POOLELEMENT_IDENTIFIER_HASHINDEX
+   if(ST_CLASS(poolNodeUpdateIdentifierIndex)(poolNode)) {
+      return((struct ST_CLASS(PoolElementNode)*)identifierHashTableFind(
+                &poolNode->PoolElementIdentifierIndex, identifier));
+   }
+#endif
+
+   STN_METHOD(New)(&cmpElement.PoolElementIndexStorageNode);
    cmpElement.Identifier = identifier;
    result = ST_METHOD(Find)(&poolNode->PoolElementIndexStorage,
                             &cmpElement.PoolElementIndexStorageNode);
@@ -439,6 +888,7 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeFindNearestNextPoolElementNod
    struct ST_CLASS(PoolElementNode) cmpElement;
    struct STN_CLASSNAME*            result;
 
+   STN_METHOD(New)(&cmpElement.PoolElementIndexStorageNode);
    cmpElement.Identifier = identifier;
    result = ST_METHOD(GetNearestNext)(&poolNode->PoolElementIndexStorage,
                                       &cmpElement.PoolElementIndexStorageNode);
@@ -459,9 +909,21 @@ struct ST_CLASS(PoolElementNode)* ST_CLASS(poolNodeRemovePoolElementNode)(
    result = ST_METHOD(Remove)(&poolNode->PoolElementIndexStorage,
                               &poolElementNode->PoolElementIndexStorageNode);
    CHECK(result == &poolElementNode->PoolElementIndexStorageNode);
-   result = ST_METHOD(Remove)(&poolNode->PoolElementSelectionStorage,
-                              &poolElementNode->PoolElementSelectionStorageNode);
-   CHECK(result != NULL);
+   if(poolNode->PoolElementIdentifierIndexValid) {
+      CHECK(identifierHashTableRemove(&poolNode->PoolElementIdentifierIndex,
+                                      poolElementNode->Identifier) == poolElementNode);
+   }
+   if(poolNode->PoolElementSelectionBuckets != NULL) {
+      bucketQueueRemove(poolNode->PoolElementSelectionBuckets,
+                        &poolElementNode->PoolElementSelectionBucketNode);
+   }
+   else {
+      result = ST_METHOD(Remove)(&poolNode->PoolElementSelectionStorage,
+                                 &poolElementNode->PoolElementSelectionStorageNode);
+      CHECK(result != NULL);
+   }
+   poolNode->PoolElementSelectionIndexValid = 0;
+   poolNode->PoolElementSelectionAliasTableValid = 0;
    poolElementNode->OwnerPoolNode = NULL;
    return(poolElementNode);
 }
@@ -484,6 +946,7 @@ void ST_CLASS(poolNodeResequence)(struct ST_CLASS(PoolNode)* poolNode)
    poolNode->GlobalSeqNumber = 0;
    while(poolElementNode != NULL) {
       poolElementNode->SeqNumber = poolNode->GlobalSeqNumber++;
+      poolElementNode->PoolElementSelectionBucketNode.Sequence = poolElementNode->SeqNumber;
       poolElementNode = ST_CLASS(poolNodeGetNextPoolElementNodeFromSelection)(poolNode, poolElementNode);
    }
 }
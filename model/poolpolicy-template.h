@@ -55,6 +55,26 @@ struct ST_CLASS(PoolPolicy)
    void (*InitializePoolElementNodeFunction)(struct ST_CLASS(PoolElementNode)* poolElementNode);
    void (*UpdatePoolElementNodeFunction)(struct ST_CLASS(PoolElementNode)* poolElementNode);
    void (*PrepareSelectionFunction)(struct ST_CLASS(PoolNode)* poolNode);
+
+   /* Comparison function for the pool's selection storage nodes. Called
+      by the storage through this pointer, also in C++ builds: there, it is
+      the policy's instantiation of ST_CLASS(PoolPolicyType), which only
+      calls ComparisonFunction directly. */
+   int (*SelectionStorageNodeComparisonFunction)(const void* nodePtr1,
+                                                 const void* nodePtr2);
+
+   /* For policies whose ComparisonFunction orders by a per-node key and
+      then by SeqNumber: the key. The pool's selection storage is then
+      kept in a bucket queue instead of the tree. NULL otherwise. */
+   unsigned int (*SelectionKeyFunction)(const struct ST_CLASS(PoolElementNode)* poolElementNode);
+
+   /* Selection by the PEs' selection values (value tree policies) */
+   int          SelectionByValueTree;
+
+   /* For value tree policies whose values only change on updates of the
+      policy settings: draws may use an alias table instead of the
+      selection index. */
+   int          SelectionByAliasTable;
 };
 
 
@@ -62,6 +82,17 @@ extern const struct ST_CLASS(PoolPolicy) ST_CLASS(PoolPolicyArray)[];
 extern const size_t ST_CLASS(PoolPolicies);
 
 
+size_t ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder)(
+          struct ST_CLASS(PoolNode)*         poolNode,
+          struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+          const size_t                       maxPoolElementNodes,
+          size_t                             maxIncrement);
+size_t ST_CLASS(poolPolicySelectPoolElementNodesByValueTree)(
+          struct ST_CLASS(PoolNode)*         poolNode,
+          struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+          const size_t                       maxPoolElementNodes,
+          size_t                             maxIncrement);
+
 const struct ST_CLASS(PoolPolicy)* ST_CLASS(poolPolicyGetPoolPolicyByName)(const char* policyName);
 const struct ST_CLASS(PoolPolicy)* ST_CLASS(poolPolicyGetPoolPolicyByType)(const unsigned int policyType);
 
@@ -32,6 +32,10 @@
 #define COMPARE_KEY_ASCENDING(a, b)  if((a) < (b)) { return(-1); } else if ((a) > (b)) { return(1); }
 #define COMPARE_KEY_DESCENDING(a, b) if((a) > (b)) { return(-1); } else if ((a) < (b)) { return(1); }
 
+/* Consecutive draws of already chosen nodes, before an alias table
+   selection continues on the value tree */
+#define POOLPOLICY_ALIASTABLE_MAX_REJECTIONS 16
+
 
 /* ###### Calculate sum of 3 values and ensure datatype limit ############ */
 static unsigned int ST_CLASS(getSum)(const unsigned int v1,
@@ -82,23 +86,28 @@ static unsigned long long ST_CLASS(getValueFraction)(
 */
 
 
-/* ###### Select PoolElementNodes from Storage in Order ################## */
-size_t ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder)(
-          struct ST_CLASS(PoolNode)*         poolNode,
-          struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
-          const size_t                       maxPoolElementNodes,
-          size_t                             maxIncrement)
-{
-   struct ST_CLASS(PoolElementNode)* poolElementNode;
-   size_t                            poolElementNodes;
-   size_t                            i;
-   size_t                            elementsToUpdate;
+/*
+   The selection functions take the policy's update function as parameter:
+   the generic ones below pass the function of poolNode->Policy, the
+   instantiations of ST_CLASS(PoolPolicyType) in C++ builds pass their
+   template parameter. Being inline, they are compiled with the policy's
+   function as constant there, i.e. it is called directly.
+*/
+typedef void (*ST_CLASS(PoolPolicyUpdateFunction))(struct ST_CLASS(PoolElementNode)* poolElementNode);
+typedef void (*ST_CLASS(PoolPolicyPrepareFunction))(struct ST_CLASS(PoolNode)* poolNode);
 
-   /* Set maxIncrement to default, if maxIncrement == 0. */
-   if(maxIncrement == 0) {
-      maxIncrement = poolNode->Policy->DefaultMaxIncrement;
-   }
 
+/* ###### Prepare selection ############################################## */
+/*
+   Returns the maxIncrement to use, i.e. defaultMaxIncrement for 0.
+*/
+inline static size_t ST_CLASS(poolPolicyPrepareSelection)(
+                        struct ST_CLASS(PoolNode)*          poolNode,
+                        const size_t                        maxPoolElementNodes,
+                        const size_t                        maxIncrement,
+                        const size_t                        defaultMaxIncrement,
+                        ST_CLASS(PoolPolicyPrepareFunction) prepareSelectionFunction)
+{
    /* Check, if resequencing is necessary. However, using 64 bit counters,
       this should (almost) never be necessary */
    CHECK(maxPoolElementNodes >= 1);
@@ -108,10 +117,27 @@ size_t ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder)(
    }
 
    /* Policy-specifc pool element node updates (e.g. counter changes) */
-   if(poolNode->Policy->PrepareSelectionFunction) {
-      poolNode->Policy->PrepareSelectionFunction(poolNode);
+   if(prepareSelectionFunction) {
+      prepareSelectionFunction(poolNode);
    }
 
+   /* Set maxIncrement to default, if maxIncrement == 0. */
+   return((maxIncrement == 0) ? defaultMaxIncrement : maxIncrement);
+}
+
+
+/* ###### Select PoolElementNodes from Storage in Order ################## */
+inline static size_t ST_CLASS(poolPolicySelectPoolElementNodesInOrder)(
+                        struct ST_CLASS(PoolNode)*         poolNode,
+                        struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+                        const size_t                       maxPoolElementNodes,
+                        const size_t                       maxIncrement,
+                        ST_CLASS(PoolPolicyUpdateFunction) updatePoolElementNodeFunction)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   size_t                            poolElementNodes;
+   size_t                            i;
+   size_t                            elementsToUpdate;
 
    poolElementNodes = 0;
    poolElementNode  = ST_CLASS(poolNodeGetFirstPoolElementNodeFromSelection)(poolNode);
@@ -139,8 +165,8 @@ size_t ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder)(
       poolElementNodeArray[i]->SelectionCounter++;
 
       /* Policy-specifc pool element node updates (e.g. counter changes) */
-      if(poolNode->Policy->UpdatePoolElementNodeFunction) {
-         poolNode->Policy->UpdatePoolElementNodeFunction(poolElementNodeArray[i]);
+      if(updatePoolElementNodeFunction) {
+         updatePoolElementNodeFunction(poolElementNodeArray[i]);
       }
 
       ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(poolNode, poolElementNodeArray[i]);
@@ -150,49 +176,112 @@ size_t ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder)(
 }
 
 
-/* ###### Select PoolElementNodes from Storage Randomly ################## */
-size_t ST_CLASS(poolPolicySelectPoolElementNodesByValueTree)(
-          struct ST_CLASS(PoolNode)*         poolNode,
-          struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
-          const size_t                       maxPoolElementNodes,
-          size_t                             maxIncrement)
+/* ###### Select PoolElementNodes using the pool's selection index ####### */
+/*
+   The selection index contains the values of the selection storage in
+   selection storage order, i.e. the node found for a value is the same as
+   ST_METHOD(GetNodeByValue)() would return. Chosen nodes are excluded from
+   further draws by setting their index value to 0, instead of unlinking
+   them from the selection storage. The first poolElementNodes entries of
+   poolElementNodeArray have already been chosen.
+*/
+inline static size_t ST_CLASS(poolPolicySelectPoolElementNodesBySelectionIndex)(
+                 struct ST_CLASS(PoolNode)*         poolNode,
+                 struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+                 const size_t                       maxPoolElementNodes,
+                 const size_t                       maxIncrement,
+                 size_t                             poolElementNodes,
+                 ST_CLASS(PoolPolicyUpdateFunction) updatePoolElementNodeFunction)
 {
-   unsigned long long maxValue;
-   unsigned long long value;
-   const size_t       poolElements     = ST_METHOD(GetElements)(&poolNode->PoolElementSelectionStorage);
-   size_t             poolElementNodes = 0;
-   size_t             i;
+   struct FenwickTree*               index        = &poolNode->PoolElementSelectionIndex;
+   const size_t                      poolElements = fenwickTreeGetEntries(index);
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   unsigned long long                maxValue;
+   unsigned long long                value;
+   size_t                            position;
+   size_t                            i;
 
-   /* Set maxIncrement to default, if maxIncrement == 0. */
-   if(maxIncrement == 0) {
-      maxIncrement = poolNode->Policy->DefaultMaxIncrement;
+   for(i = 0;i < poolElementNodes;i++) {
+      fenwickTreeUpdate(index, poolElementNodeArray[i]->SelectionIndexPosition, 0);
    }
+   for(i = poolElementNodes;i < ((poolElements < maxPoolElementNodes) ? poolElements : maxPoolElementNodes);i++) {
+      maxValue = fenwickTreeGetValueSum(index);
+      if(maxValue < 1) {
+         break;
+      }
 
-   /* Check, if resequencing is necessary. However, using 64 bit counters,
-      this should (almost) never be necessary */
-   CHECK(maxPoolElementNodes >= 1);
-   if((PoolElementSeqNumberType)(poolNode->GlobalSeqNumber + maxPoolElementNodes) <
-      poolNode->GlobalSeqNumber) {
-      ST_CLASS(poolNodeResequence)(poolNode);
+      value    = random64() % maxValue;
+      position = fenwickTreeFindByValue(index, value);
+      CHECK(position < poolElements);
+      poolElementNode = (struct ST_CLASS(PoolElementNode)*)fenwickTreeGetElement(index, position);
+      poolElementNodeArray[poolElementNodes] = poolElementNode;
+
+      /* Common update functionality: SeqNumber increment and Selection Counter */
+      poolElementNode->SeqNumber = poolNode->GlobalSeqNumber++;
+      poolElementNode->SelectionCounter++;
+
+      /* Update PE entries with respect to maxIncrement setting. */
+      if(poolElementNodes < maxIncrement) {
+         /* Policy-specifc pool element node updates (e.g. counter changes) */
+         if(updatePoolElementNodeFunction) {
+            updatePoolElementNodeFunction(poolElementNode);
+
+            /* The value has been changed -> the selection storage has to
+               be updated. The node keeps its index position. */
+            if(poolElementNode->PoolElementSelectionStorageNode.Value !=
+                  fenwickTreeGetValue(index, position)) {
+               ST_CLASS(poolNodeRelinkPoolElementNodeToSelection)(poolNode, poolElementNode);
+            }
+         }
+      }
+
+      /* Setting the value to 0 excludes the node from further draws */
+      fenwickTreeUpdate(index, position, 0);
+      poolElementNodes++;
    }
 
-   /* Policy-specifc pool element node updates (e.g. counter changes) */
-   if(poolNode->Policy->PrepareSelectionFunction) {
-      poolNode->Policy->PrepareSelectionFunction(poolNode);
+   /* Restore the values of all previously chosen nodes */
+   for(i = 0;i < poolElementNodes;i++) {
+      poolElementNode = poolElementNodeArray[i];
+      fenwickTreeUpdate(index, poolElementNode->SelectionIndexPosition,
+                        poolElementNode->PoolElementSelectionStorageNode.Value);
    }
 
+   return(poolElementNodes);
+}
 
-   for(i = 0;i < ((poolElements < maxPoolElementNodes) ? poolElements : maxPoolElementNodes);i++) {
+
+/* ###### Select PoolElementNodes from Storage Randomly ################## */
+/*
+   The first poolElementNodes entries of poolElementNodeArray have already
+   been chosen and unlinked from the selection storage.
+*/
+inline static size_t ST_CLASS(poolPolicySelectPoolElementNodesFromValueTree)(
+                 struct ST_CLASS(PoolNode)*         poolNode,
+                 struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+                 const size_t                       maxPoolElementNodes,
+                 const size_t                       maxIncrement,
+                 size_t                             poolElementNodes,
+                 ST_CLASS(PoolPolicyUpdateFunction) updatePoolElementNodeFunction)
+{
+   struct STN_CLASSNAME* node;
+   unsigned long long    maxValue;
+   unsigned long long    value;
+   const size_t          poolElements = ST_METHOD(GetElements)(&poolNode->PoolElementSelectionStorage) +
+                                           poolElementNodes;
+   size_t                i;
+
+   for(i = poolElementNodes;i < ((poolElements < maxPoolElementNodes) ? poolElements : maxPoolElementNodes);i++) {
       maxValue = ST_METHOD(GetValueSum)(&poolNode->PoolElementSelectionStorage);
       if(maxValue < 1) {
          break;
       }
 
       value = random64() % maxValue;
-      poolElementNodeArray[poolElementNodes] =
-         (struct ST_CLASS(PoolElementNode)*)ST_METHOD(GetNodeByValue)(
-            &poolNode->PoolElementSelectionStorage, value);
-      if(poolElementNodeArray[poolElementNodes]) {
+      node = ST_METHOD(GetNodeByValue)(&poolNode->PoolElementSelectionStorage, value);
+      if(node) {
+         poolElementNodeArray[poolElementNodes] =
+            ST_CLASS(getPoolElementNodeFromPoolElementSelectionStorageNode)(node);
 
          /* Common update functionality: SeqNumber increment and Selection Counter */
          poolElementNodeArray[poolElementNodes]->SeqNumber =
@@ -202,8 +291,8 @@ size_t ST_CLASS(poolPolicySelectPoolElementNodesByValueTree)(
          /* Update PE entries with respect to maxIncrement setting. */
          if(poolElementNodes < maxIncrement) {
             /* Policy-specifc pool element node updates (e.g. counter changes) */
-            if(poolNode->Policy->UpdatePoolElementNodeFunction) {
-               poolNode->Policy->UpdatePoolElementNodeFunction(poolElementNodeArray[poolElementNodes]);
+            if(updatePoolElementNodeFunction) {
+               updatePoolElementNodeFunction(poolElementNodeArray[poolElementNodes]);
             }
          }
 
@@ -226,6 +315,156 @@ size_t ST_CLASS(poolPolicySelectPoolElementNodesByValueTree)(
 }
 
 
+/* ###### Select PoolElementNodes using the pool's alias table ########### */
+/*
+   Draws are made from the alias table of all PEs; nodes already chosen
+   by this selection, i.e. nodes with a SeqNumber of this selection, are
+   drawn again. When most of the value sum has been chosen, these
+   rejections become frequent: the selection then continues on the
+   selection index, with the chosen nodes excluded.
+*/
+inline static size_t ST_CLASS(poolPolicySelectPoolElementNodesFromAliasTable)(
+                 struct ST_CLASS(PoolNode)*         poolNode,
+                 struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+                 const size_t                       maxPoolElementNodes,
+                 const size_t                       maxIncrement,
+                 ST_CLASS(PoolPolicyUpdateFunction) updatePoolElementNodeFunction)
+{
+   const struct AliasTable*          aliasTable     = poolNode->PoolElementSelectionAliasTable;
+   const size_t                      poolElements   = aliasTableGetEntries(aliasTable);
+   const PoolElementSeqNumberType    firstSeqNumber = poolNode->GlobalSeqNumber;
+   struct ST_CLASS(PoolElementNode)* poolElementNode;
+   size_t                            poolElementNodes = 0;
+   size_t                            rejections;
+   size_t                            position;
+   size_t                            i;
+
+   if(aliasTableGetValueSum(aliasTable) < 1) {
+      return(0);
+   }
+
+   while(poolElementNodes < ((poolElements < maxPoolElementNodes) ? poolElements : maxPoolElementNodes)) {
+      rejections = 0;
+      do {
+         if(rejections++ >= POOLPOLICY_ALIASTABLE_MAX_REJECTIONS) {
+            for(i = 0;i < poolElementNodes;i++) {
+               if(!STN_METHOD(IsLinked)(&poolElementNodeArray[i]->PoolElementSelectionStorageNode)) {
+                  ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(poolNode, poolElementNodeArray[i]);
+               }
+            }
+            if(ST_CLASS(poolNodeUpdateSelectionIndex)(poolNode)) {
+               return(ST_CLASS(poolPolicySelectPoolElementNodesBySelectionIndex)(
+                         poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement,
+                         poolElementNodes, updatePoolElementNodeFunction));
+            }
+            for(i = 0;i < poolElementNodes;i++) {
+               ST_CLASS(poolNodeUnlinkPoolElementNodeFromSelection)(poolNode, poolElementNodeArray[i]);
+            }
+            return(ST_CLASS(poolPolicySelectPoolElementNodesFromValueTree)(
+                      poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement,
+                      poolElementNodes, updatePoolElementNodeFunction));
+         }
+         position        = aliasTableDraw(aliasTable, random64());
+         poolElementNode = (struct ST_CLASS(PoolElementNode)*)aliasTableGetElement(aliasTable, position);
+      } while(poolElementNode->SeqNumber >= firstSeqNumber);
+      poolElementNodeArray[poolElementNodes] = poolElementNode;
+
+      /* Common update functionality: SeqNumber increment and Selection Counter */
+      poolElementNode->SeqNumber = poolNode->GlobalSeqNumber++;
+      poolElementNode->SelectionCounter++;
+
+      /* Update PE entries with respect to maxIncrement setting. */
+      if(poolElementNodes < maxIncrement) {
+         /* Policy-specifc pool element node updates (e.g. counter changes) */
+         if(updatePoolElementNodeFunction) {
+            updatePoolElementNodeFunction(poolElementNode);
+
+            /* The value has been changed -> the selection storage has to
+               be updated, which also invalidates the alias table. */
+            if(poolElementNode->PoolElementSelectionStorageNode.Value !=
+                  aliasTableGetValue(aliasTable, position)) {
+               ST_CLASS(poolNodeUnlinkPoolElementNodeFromSelection)(poolNode, poolElementNode);
+            }
+         }
+      }
+      poolElementNodes++;
+   }
+
+   /* Re-linking of all nodes unlinked due to a value change */
+   for(i = 0;i < poolElementNodes;i++) {
+      if(!STN_METHOD(IsLinked)(&poolElementNodeArray[i]->PoolElementSelectionStorageNode)) {
+         ST_CLASS(poolNodeLinkPoolElementNodeToSelection)(poolNode, poolElementNodeArray[i]);
+      }
+   }
+
+   return(poolElementNodes);
+}
+
+
+/* ###### Select PoolElementNodes by value ############################## */
+inline static size_t ST_CLASS(poolPolicySelectPoolElementNodesByValue)(
+                        struct ST_CLASS(PoolNode)*         poolNode,
+                        struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+                        const size_t                       maxPoolElementNodes,
+                        const size_t                       maxIncrement,
+                        ST_CLASS(PoolPolicyUpdateFunction) updatePoolElementNodeFunction)
+{
+   /* Use the alias table of the pool, if there is one and the pool is
+      not churning */
+   if( (poolNode->PoolElementSelectionAliasTable != NULL) &&
+       (ST_CLASS(poolNodeUpdateSelectionAliasTable)(poolNode)) ) {
+      return(ST_CLASS(poolPolicySelectPoolElementNodesFromAliasTable)(
+                poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement,
+                updatePoolElementNodeFunction));
+   }
+
+   /* Use the selection index, unless it cannot be allocated */
+   if(ST_CLASS(poolNodeUpdateSelectionIndex)(poolNode)) {
+      return(ST_CLASS(poolPolicySelectPoolElementNodesBySelectionIndex)(
+                poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement, 0,
+                updatePoolElementNodeFunction));
+   }
+
+   return(ST_CLASS(poolPolicySelectPoolElementNodesFromValueTree)(
+             poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement, 0,
+             updatePoolElementNodeFunction));
+}
+
+
+/* ###### Select PoolElementNodes from Storage in Order ################## */
+size_t ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder)(
+          struct ST_CLASS(PoolNode)*         poolNode,
+          struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+          const size_t                       maxPoolElementNodes,
+          size_t                             maxIncrement)
+{
+   maxIncrement = ST_CLASS(poolPolicyPrepareSelection)(
+                     poolNode, maxPoolElementNodes, maxIncrement,
+                     poolNode->Policy->DefaultMaxIncrement,
+                     poolNode->Policy->PrepareSelectionFunction);
+   return(ST_CLASS(poolPolicySelectPoolElementNodesInOrder)(
+             poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement,
+             poolNode->Policy->UpdatePoolElementNodeFunction));
+}
+
+
+/* ###### Select PoolElementNodes from Storage Randomly ################## */
+size_t ST_CLASS(poolPolicySelectPoolElementNodesByValueTree)(
+          struct ST_CLASS(PoolNode)*         poolNode,
+          struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+          const size_t                       maxPoolElementNodes,
+          size_t                             maxIncrement)
+{
+   maxIncrement = ST_CLASS(poolPolicyPrepareSelection)(
+                     poolNode, maxPoolElementNodes, maxIncrement,
+                     poolNode->Policy->DefaultMaxIncrement,
+                     poolNode->Policy->PrepareSelectionFunction);
+   return(ST_CLASS(poolPolicySelectPoolElementNodesByValue)(
+             poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement,
+             poolNode->Policy->UpdatePoolElementNodeFunction));
+}
+
+
 /*
    #######################################################################
    #### Round Robin Policy                                            ####
@@ -433,12 +672,22 @@ static int ST_CLASS(priorityComparison)(
    #######################################################################
 */
 
+/* ###### Selection Key ################################################## */
+static unsigned int ST_CLASS(leastUsedSelectionKey)(
+   const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   return(poolElementNode->PolicySettings.Load);
+}
+
+
 /* ###### Sorting Order ################################################## */
 static int ST_CLASS(leastUsedComparison)(
    const struct ST_CLASS(PoolElementNode)* poolElementNode1,
    const struct ST_CLASS(PoolElementNode)* poolElementNode2)
 {
-   COMPARE_KEY_ASCENDING(poolElementNode1->PolicySettings.Load, poolElementNode2->PolicySettings.Load);
+   const unsigned int v1 = ST_CLASS(leastUsedSelectionKey)(poolElementNode1);
+   const unsigned int v2 = ST_CLASS(leastUsedSelectionKey)(poolElementNode2);
+   COMPARE_KEY_ASCENDING(v1, v2);
    COMPARE_KEY_ASCENDING(poolElementNode1->SeqNumber, poolElementNode2->SeqNumber);
    return(0);
 }
@@ -450,38 +699,28 @@ static int ST_CLASS(leastUsedComparison)(
    #######################################################################
 */
 
+/* ###### Selection Key ################################################## */
+static unsigned int ST_CLASS(leastUsedDPFSelectionKey)(
+   const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   const double dpf = (double)poolElementNode->PolicySettings.Distance * ((double)poolElementNode->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF);
+   unsigned long long v = (unsigned long long)rint(
+      (double)poolElementNode->PolicySettings.Load +
+      (dpf * (double)PPV_MAX_LOAD));
+   if(v > (long long)PPV_MAX_LOAD) {
+      v = (long long)PPV_MAX_LOAD;
+   }
+   return((unsigned int)v);
+}
+
+
 /* ###### Sorting Order ################################################## */
 static int ST_CLASS(leastUsedDPFComparison)(
    const struct ST_CLASS(PoolElementNode)* poolElementNode1,
    const struct ST_CLASS(PoolElementNode)* poolElementNode2)
 {
-   const double dpf1 = (double)poolElementNode1->PolicySettings.Distance * ((double)poolElementNode1->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF);
-   const double dpf2 = (double)poolElementNode2->PolicySettings.Distance * ((double)poolElementNode2->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF);
-
-   unsigned long long v1 = (unsigned long long)rint((double)poolElementNode1->PolicySettings.Load + (dpf1 * (double)PPV_MAX_LOAD));
-   if(v1 > (long long)PPV_MAX_LOAD) {
-      v1 = (long long)PPV_MAX_LOAD;
-   }
-   unsigned long long v2 = (unsigned long long)rint((double)poolElementNode2->PolicySettings.Load + (dpf2 * (double)PPV_MAX_LOAD));
-   if(v2 > (long long)PPV_MAX_LOAD) {
-      v2 = (long long)PPV_MAX_LOAD;
-   }
-
-/*
-   printf("dpf1=%1.6lf l1=$%x ldpf1=%1.8lf d1=%3u v1=$%x ; ",
-          dpf1,
-          poolElementNode1->PolicySettings.Load,
-          ((double)poolElementNode1->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF),
-          poolElementNode1->PolicySettings.Distance,
-          v1);
-   printf("dpf2=%1.6lf l2=$%x ldpf2=%1.8lf d2=%3u v2=$%x\n",
-          dpf2,
-          poolElementNode2->PolicySettings.Load,
-          ((double)poolElementNode2->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF),
-          poolElementNode2->PolicySettings.Distance,
-          v2);
-*/
-
+   const unsigned int v1 = ST_CLASS(leastUsedDPFSelectionKey)(poolElementNode1);
+   const unsigned int v2 = ST_CLASS(leastUsedDPFSelectionKey)(poolElementNode2);
    COMPARE_KEY_ASCENDING(v1, v2);
    COMPARE_KEY_ASCENDING(poolElementNode1->SeqNumber, poolElementNode2->SeqNumber);
    return(0);
@@ -494,48 +733,29 @@ static int ST_CLASS(leastUsedDPFComparison)(
    #######################################################################
 */
 
+/* ###### Selection Key ################################################## */
+static unsigned int ST_CLASS(priorityLeastUsedDPFSelectionKey)(
+   const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   const double dpf = (double)poolElementNode->PolicySettings.Distance * ((double)poolElementNode->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF);
+   unsigned long long v = (unsigned long long)rint(
+      (double)poolElementNode->PolicySettings.Load +
+      (double)poolElementNode->PolicySettings.LoadDegradation +
+      (dpf * (double)PPV_MAX_LOAD));
+   if(v > (long long)PPV_MAX_LOAD) {
+      v = (long long)PPV_MAX_LOAD;
+   }
+   return((unsigned int)v);
+}
+
+
 /* ###### Sorting Order ################################################## */
 static int ST_CLASS(priorityLeastUsedDPFComparison)(
    const struct ST_CLASS(PoolElementNode)* poolElementNode1,
    const struct ST_CLASS(PoolElementNode)* poolElementNode2)
 {
-   const double dpf1 = (double)poolElementNode1->PolicySettings.Distance * ((double)poolElementNode1->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF);
-   const double dpf2 = (double)poolElementNode2->PolicySettings.Distance * ((double)poolElementNode2->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF);
-
-   unsigned long long v1 = (unsigned long long)rint(
-      (double)poolElementNode1->PolicySettings.Load +
-      (double)poolElementNode1->PolicySettings.LoadDegradation +
-      (dpf1 * (double)PPV_MAX_LOAD));
-   if(v1 > (long long)PPV_MAX_LOAD) {
-      v1 = (long long)PPV_MAX_LOAD;
-   }
-   unsigned long long v2 = (unsigned long long)rint(
-      (double)poolElementNode2->PolicySettings.Load +
-      (double)poolElementNode2->PolicySettings.LoadDegradation +
-      (dpf2 * (double)PPV_MAX_LOAD));
-   if(v2 > (long long)PPV_MAX_LOAD) {
-      v2 = (long long)PPV_MAX_LOAD;
-   }
-
-/*
-   printf("I1=$%08x dpf1=%1.6lf l1=$%x ldeg1=$%x ldpf1=%1.8lf d1=%3u v1=$%Lx ; ",
-          poolElementNode1->Identifier,
-          dpf1,
-          poolElementNode1->PolicySettings.Load,
-          poolElementNode1->PolicySettings.LoadDegradation,
-          ((double)poolElementNode1->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF),
-          poolElementNode1->PolicySettings.Distance,
-          v1);
-   printf("I2=$%08x dpf2=%1.6lf l2=$%x ldeg2=$%x ldpf2=%1.8lf d2=%3u v2=$%Lx\n",
-          poolElementNode2->Identifier,
-          dpf2,
-          poolElementNode2->PolicySettings.Load,
-          poolElementNode2->PolicySettings.LoadDegradation,
-          ((double)poolElementNode2->PolicySettings.LoadDPF / (double)PPV_MAX_LOADDPF),
-          poolElementNode2->PolicySettings.Distance,
-          v2);
-*/
-
+   const unsigned int v1 = ST_CLASS(priorityLeastUsedDPFSelectionKey)(poolElementNode1);
+   const unsigned int v2 = ST_CLASS(priorityLeastUsedDPFSelectionKey)(poolElementNode2);
    COMPARE_KEY_ASCENDING(v1, v2);
    COMPARE_KEY_ASCENDING(poolElementNode1->SeqNumber, poolElementNode2->SeqNumber);
    return(0);
@@ -548,15 +768,22 @@ static int ST_CLASS(priorityLeastUsedDPFComparison)(
    #######################################################################
 */
 
+/* ###### Selection Key ################################################## */
+static unsigned int ST_CLASS(leastUsedDegradationSelectionKey)(
+   const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   return(ST_CLASS(getSum)(poolElementNode->PolicySettings.Load,
+                           poolElementNode->Degradation, 0));
+}
+
+
 /* ###### Sorting Order ################################################## */
 static int ST_CLASS(leastUsedDegradationComparison)(
    const struct ST_CLASS(PoolElementNode)* poolElementNode1,
    const struct ST_CLASS(PoolElementNode)* poolElementNode2)
 {
-   const unsigned int v1 = ST_CLASS(getSum)(poolElementNode1->PolicySettings.Load,
-                                            poolElementNode1->Degradation, 0);
-   const unsigned int v2 = ST_CLASS(getSum)(poolElementNode2->PolicySettings.Load,
-                                            poolElementNode2->Degradation, 0);
+   const unsigned int v1 = ST_CLASS(leastUsedDegradationSelectionKey)(poolElementNode1);
+   const unsigned int v2 = ST_CLASS(leastUsedDegradationSelectionKey)(poolElementNode2);
    COMPARE_KEY_ASCENDING(v1, v2);
    COMPARE_KEY_ASCENDING(poolElementNode1->SeqNumber, poolElementNode2->SeqNumber);
    return(0);
@@ -632,15 +859,22 @@ static int ST_CLASS(leastUsedDegradationDPFComparison)(
    #######################################################################
 */
 
+/* ###### Selection Key ################################################## */
+static unsigned int ST_CLASS(priorityLeastUsedSelectionKey)(
+   const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   return(ST_CLASS(getSum)(poolElementNode->PolicySettings.Load,
+                           poolElementNode->PolicySettings.LoadDegradation, 0));
+}
+
+
 /* ###### Sorting Order ################################################## */
 static int ST_CLASS(priorityLeastUsedComparison)(
    const struct ST_CLASS(PoolElementNode)* poolElementNode1,
    const struct ST_CLASS(PoolElementNode)* poolElementNode2)
 {
-   const unsigned int v1 = ST_CLASS(getSum)(poolElementNode1->PolicySettings.Load,
-                                            poolElementNode1->PolicySettings.LoadDegradation, 0);
-   const unsigned int v2 = ST_CLASS(getSum)(poolElementNode2->PolicySettings.Load,
-                                            poolElementNode2->PolicySettings.LoadDegradation, 0);
+   const unsigned int v1 = ST_CLASS(priorityLeastUsedSelectionKey)(poolElementNode1);
+   const unsigned int v2 = ST_CLASS(priorityLeastUsedSelectionKey)(poolElementNode2);
    COMPARE_KEY_ASCENDING(v1, v2);
    COMPARE_KEY_ASCENDING(poolElementNode1->SeqNumber, poolElementNode2->SeqNumber);
    return(0);
@@ -653,17 +887,23 @@ static int ST_CLASS(priorityLeastUsedComparison)(
    #######################################################################
 */
 
+/* ###### Selection Key ################################################## */
+static unsigned int ST_CLASS(priorityLeastUsedDegradationSelectionKey)(
+   const struct ST_CLASS(PoolElementNode)* poolElementNode)
+{
+   return(ST_CLASS(getSum)(poolElementNode->PolicySettings.Load,
+                           poolElementNode->PolicySettings.LoadDegradation,
+                           poolElementNode->Degradation));
+}
+
+
 /* ###### Sorting Order ################################################## */
 static int ST_CLASS(priorityLeastUsedDegradationComparison)(
    const struct ST_CLASS(PoolElementNode)* poolElementNode1,
    const struct ST_CLASS(PoolElementNode)* poolElementNode2)
 {
-   const unsigned int v1 = ST_CLASS(getSum)(poolElementNode1->PolicySettings.Load,
-                                            poolElementNode1->PolicySettings.LoadDegradation,
-                                            poolElementNode1->Degradation);
-   const unsigned int v2 = ST_CLASS(getSum)(poolElementNode2->PolicySettings.Load,
-                                            poolElementNode2->PolicySettings.LoadDegradation,
-                                            poolElementNode2->Degradation);
+   const unsigned int v1 = ST_CLASS(priorityLeastUsedDegradationSelectionKey)(poolElementNode1);
+   const unsigned int v2 = ST_CLASS(priorityLeastUsedDegradationSelectionKey)(poolElementNode2);
    COMPARE_KEY_ASCENDING(v1, v2);
    COMPARE_KEY_ASCENDING(poolElementNode1->SeqNumber, poolElementNode2->SeqNumber);
    return(0);
@@ -834,174 +1074,266 @@ static void ST_CLASS(randomizedPriorityLeastUsedDegradationUpdatePoolElementNode
 }
 
 
-const struct ST_CLASS(PoolPolicy) ST_CLASS(PoolPolicyArray)[] =
+#ifdef __cplusplus
+/*
+   #######################################################################
+   #### Compile-time Specialised Policies                             ####
+   #######################################################################
+*/
+
+/*
+   In C++ builds, ST_CLASS(PoolPolicyType) instantiates the selection
+   function and the selection storage comparison of each policy of
+   ST_CLASS(PoolPolicyArray), with the policy's functions and its selection
+   kind (value tree or sorting order) and default max increment as
+   template parameters. This is not a full compile-time specialisation:
+
+   - The selection uses the same inline functions as the generic selection
+     functions above, with the update and prepare hooks and the selection
+     kind as constants, i.e. the hooks are called directly and the
+     selection results are identical.
+   - The policy's comparison is called directly by the instantiated
+     selectionStorageNodeComparison().
+     But the storage backends are C code: they still call this wrapper
+     through SelectionStorageNodeComparisonFunction. The only saving is
+     the lookup of the comparison via the PE's pool node.
+   - The handlespace still calls the selection through SelectionFunction,
+     and the index and timer storages are not specialised at all.
+*/
+template<int (*Comparison)(const struct ST_CLASS(PoolElementNode)* poolElementNode1,
+                           const struct ST_CLASS(PoolElementNode)* poolElementNode2),
+         void (*Update)(struct ST_CLASS(PoolElementNode)* poolElementNode),
+         void (*Prepare)(struct ST_CLASS(PoolNode)* poolNode),
+         bool   ValueTree,
+         size_t MaxIncrement>
+struct ST_CLASS(PoolPolicyType)
 {
+   /* ###### Selection storage comparison ############################### */
+   static int selectionStorageNodeComparison(const void* nodePtr1, const void* nodePtr2)
    {
-      PPT_ROUNDROBIN, "RoundRobin",
-      1,
-      &ST_CLASS(roundRobinComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      NULL,
-      NULL
-   },
-   {
-      PPT_WEIGHTED_ROUNDROBIN, "WeightedRoundRobin",
-      1,
-      &ST_CLASS(weightedRoundRobinComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      &ST_CLASS(weightedRoundRobinInitializePoolElementNode),
-      &ST_CLASS(weightedRoundRobinUpdatePoolElementNode),
-      &ST_CLASS(weightedRoundRobinPrepareSelection)
-   },
-   {
-      PPT_RANDOM, "Random",
-      0,
-      &ST_CLASS(randomComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree),
-      NULL,
-      &ST_CLASS(randomUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_WEIGHTED_RANDOM, "WeightedRandom",
-      0,
-      &ST_CLASS(weightedRandomComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree),
-      NULL,
-      &ST_CLASS(weightedRandomUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_WEIGHTED_RANDOM_DPF, "WeightedRandomDPF",
-      0,
-      &ST_CLASS(weightedRandomDPFComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree),
-      NULL,
-      &ST_CLASS(weightedRandomDPFUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_PRIORITY, "Priority",
-      1,
-      &ST_CLASS(priorityComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      NULL,
-      NULL
-   },
+      return(Comparison(getPoolElementNode(nodePtr1), getPoolElementNode(nodePtr2)));
+   }
 
-   {
-      PPT_LEASTUSED, "LeastUsed",
-      1,
-      &ST_CLASS(leastUsedComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      NULL,
-      NULL
-   },
-   {
-      PPT_LEASTUSED_DPF, "LeastUsedDPF",
-      1,
-      &ST_CLASS(leastUsedDPFComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      NULL,
-      NULL
-   },
-   {
-      PPT_PRIORITY_LEASTUSED_DPF, "PriorityLeastUsedDPF",
-      1,
-      &ST_CLASS(priorityLeastUsedDPFComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      NULL,
-      NULL
-   },
-   {
-      PPT_PRIORITY_LEASTUSED_DEGRADATION_DPF, "PriorityLeastUsedDegradationDPF",
-      1,
-      &ST_CLASS(priorityLeastUsedDegradationDPFComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_LEASTUSED_DEGRADATION, "LeastUsedDegradation",
-      1,
-      &ST_CLASS(leastUsedDegradationComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_LEASTUSED_DEGRADATION_DPF, "LeastUsedDegradationDPF",
-      1,
-      &ST_CLASS(leastUsedDegradationDPFComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_PRIORITY_LEASTUSED, "PriorityLeastUsed",
-      1,
-      &ST_CLASS(priorityLeastUsedComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      NULL,
-      NULL
-   },
-   {
-      PPT_PRIORITY_LEASTUSED_DEGRADATION, "PriorityLeastUsedDegradation",
-      1,
-      &ST_CLASS(priorityLeastUsedDegradationComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder),
-      NULL,
-      &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
-      NULL
-   },
 
+   /* ###### Select PoolElementNodes ##################################### */
+   static size_t selectPoolElementNodes(struct ST_CLASS(PoolNode)*         poolNode,
+                                        struct ST_CLASS(PoolElementNode)** poolElementNodeArray,
+                                        const size_t                       maxPoolElementNodes,
+                                        size_t                             maxIncrement)
    {
-      PPT_RANDOMIZED_LEASTUSED, "RandomizedLeastUsed",
-      1,
-      &ST_CLASS(randomizedLeastUsedComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree),
-      NULL,
-      &ST_CLASS(randomizedLeastUsedUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_RANDOMIZED_LEASTUSED_DEGRADATION, "RandomizedLeastUsedDegradation",
-      1,
-      &ST_CLASS(randomizedLeastUsedDegradationComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree),
-      NULL,
-      &ST_CLASS(randomizedLeastUsedDegradationUpdatePoolElementNode),
-      NULL
-   },
-   {
-      PPT_RANDOMIZED_PRIORITY_LEASTUSED, "RandomizedPriorityLeastUsed",
-      1,
-      &ST_CLASS(randomizedPriorityLeastUsedComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree),
-      NULL,
-      &ST_CLASS(randomizedPriorityLeastUsedUpdatePoolElementNode),
-      NULL
-   },
+      maxIncrement = ST_CLASS(poolPolicyPrepareSelection)(
+                        poolNode, maxPoolElementNodes, maxIncrement,
+                        MaxIncrement, Prepare);
+      if(ValueTree) {
+         return(ST_CLASS(poolPolicySelectPoolElementNodesByValue)(
+                   poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement,
+                   Update));
+      }
+      return(ST_CLASS(poolPolicySelectPoolElementNodesInOrder)(
+                poolNode, poolElementNodeArray, maxPoolElementNodes, maxIncrement,
+                Update));
+   }
+
+
+   private:
+   /* ###### Get PoolElementNode from given Selection Node ############### */
+   inline static const struct ST_CLASS(PoolElementNode)* getPoolElementNode(const void* nodePtr)
    {
-      PPT_RANDOMIZED_PRIORITY_LEASTUSED_DEGRADATION, "RandomizedPriorityLeastUsedDegradation",
-      1,
-      &ST_CLASS(randomizedPriorityLeastUsedDegradationComparison),
-      &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree),
-      NULL,
-      &ST_CLASS(randomizedPriorityLeastUsedDegradationUpdatePoolElementNode),
-      NULL
+      const struct ST_CLASS(PoolElementNode)* dummy = (const struct ST_CLASS(PoolElementNode)*)nodePtr;
+      long n = (long)nodePtr - ((long)&dummy->PoolElementSelectionStorageNode - (long)dummy);
+      return((const struct ST_CLASS(PoolElementNode)*)n);
    }
 };
 
+
+#define NO_FUNCTION nullptr
+#define POOLPOLICY(type, name, defaultMaxIncrement, selection, comparison, selectionKey, initialize, update, prepare) \
+   { type, name, defaultMaxIncrement, comparison,                                                      \
+     &ST_CLASS(PoolPolicyType)<comparison, update, prepare,                                            \
+                               POOLPOLICY_USES_VALUETREE_##selection,                                  \
+                               defaultMaxIncrement>::selectPoolElementNodes,                           \
+     initialize, update, prepare,                                                                      \
+     &ST_CLASS(PoolPolicyType)<comparison, update, prepare,                                            \
+                               POOLPOLICY_USES_VALUETREE_##selection,                                  \
+                               defaultMaxIncrement>::selectionStorageNodeComparison,                   \
+     selectionKey, POOLPOLICY_SELECTS_BY_VALUE_##selection,                                            \
+     POOLPOLICY_USES_ALIASTABLE_##selection }
+#define POOLPOLICY_USES_VALUETREE_BySortingOrder false
+#define POOLPOLICY_USES_VALUETREE_ByValueTree    true
+#define POOLPOLICY_USES_VALUETREE_ByAliasTable   true
+
+#else
+
+#define NO_FUNCTION NULL
+#define POOLPOLICY(type, name, defaultMaxIncrement, selection, comparison, selectionKey, initialize, update, prepare) \
+   { type, name, defaultMaxIncrement, comparison,                                                      \
+     POOLPOLICY_SELECTIONFUNCTION_##selection,                                                         \
+     initialize, update, prepare,                                                                      \
+     &ST_CLASS(poolElementSelectionStorageNodeComparison),                                             \
+     selectionKey, POOLPOLICY_SELECTS_BY_VALUE_##selection,                                            \
+     POOLPOLICY_USES_ALIASTABLE_##selection }
+#define POOLPOLICY_SELECTIONFUNCTION_BySortingOrder &ST_CLASS(poolPolicySelectPoolElementNodesBySortingOrder)
+#define POOLPOLICY_SELECTIONFUNCTION_ByValueTree    &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree)
+#define POOLPOLICY_SELECTIONFUNCTION_ByAliasTable   &ST_CLASS(poolPolicySelectPoolElementNodesByValueTree)
+
+#endif
+
+/* ByAliasTable is ByValueTree, with an alias table for the pools */
+#define POOLPOLICY_USES_ALIASTABLE_BySortingOrder 0
+#define POOLPOLICY_USES_ALIASTABLE_ByValueTree    0
+#define POOLPOLICY_USES_ALIASTABLE_ByAliasTable   1
+#define POOLPOLICY_SELECTS_BY_VALUE_BySortingOrder 0
+#define POOLPOLICY_SELECTS_BY_VALUE_ByValueTree    1
+#define POOLPOLICY_SELECTS_BY_VALUE_ByAliasTable   1
+
+
+const struct ST_CLASS(PoolPolicy) ST_CLASS(PoolPolicyArray)[] =
+{
+   POOLPOLICY(PPT_ROUNDROBIN, "RoundRobin",
+              1, BySortingOrder,
+              &ST_CLASS(roundRobinComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION),
+   POOLPOLICY(PPT_WEIGHTED_ROUNDROBIN, "WeightedRoundRobin",
+              1, BySortingOrder,
+              &ST_CLASS(weightedRoundRobinComparison),
+              NO_FUNCTION,
+              &ST_CLASS(weightedRoundRobinInitializePoolElementNode),
+              &ST_CLASS(weightedRoundRobinUpdatePoolElementNode),
+              &ST_CLASS(weightedRoundRobinPrepareSelection)),
+   POOLPOLICY(PPT_RANDOM, "Random",
+              0, ByAliasTable,
+              &ST_CLASS(randomComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(randomUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_WEIGHTED_RANDOM, "WeightedRandom",
+              0, ByAliasTable,
+              &ST_CLASS(weightedRandomComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(weightedRandomUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_WEIGHTED_RANDOM_DPF, "WeightedRandomDPF",
+              0, ByAliasTable,
+              &ST_CLASS(weightedRandomDPFComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(weightedRandomDPFUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_PRIORITY, "Priority",
+              1, BySortingOrder,
+              &ST_CLASS(priorityComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION),
+
+   POOLPOLICY(PPT_LEASTUSED, "LeastUsed",
+              1, BySortingOrder,
+              &ST_CLASS(leastUsedComparison),
+              &ST_CLASS(leastUsedSelectionKey),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION),
+   POOLPOLICY(PPT_LEASTUSED_DPF, "LeastUsedDPF",
+              1, BySortingOrder,
+              &ST_CLASS(leastUsedDPFComparison),
+              &ST_CLASS(leastUsedDPFSelectionKey),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION),
+   POOLPOLICY(PPT_PRIORITY_LEASTUSED_DPF, "PriorityLeastUsedDPF",
+              1, BySortingOrder,
+              &ST_CLASS(priorityLeastUsedDPFComparison),
+              &ST_CLASS(priorityLeastUsedDPFSelectionKey),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION),
+   POOLPOLICY(PPT_PRIORITY_LEASTUSED_DEGRADATION_DPF, "PriorityLeastUsedDegradationDPF",
+              1, BySortingOrder,
+              &ST_CLASS(priorityLeastUsedDegradationDPFComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_LEASTUSED_DEGRADATION, "LeastUsedDegradation",
+              1, BySortingOrder,
+              &ST_CLASS(leastUsedDegradationComparison),
+              &ST_CLASS(leastUsedDegradationSelectionKey),
+              NO_FUNCTION,
+              &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_LEASTUSED_DEGRADATION_DPF, "LeastUsedDegradationDPF",
+              1, BySortingOrder,
+              &ST_CLASS(leastUsedDegradationDPFComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_PRIORITY_LEASTUSED, "PriorityLeastUsed",
+              1, BySortingOrder,
+              &ST_CLASS(priorityLeastUsedComparison),
+              &ST_CLASS(priorityLeastUsedSelectionKey),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              NO_FUNCTION),
+   POOLPOLICY(PPT_PRIORITY_LEASTUSED_DEGRADATION, "PriorityLeastUsedDegradation",
+              1, BySortingOrder,
+              &ST_CLASS(priorityLeastUsedDegradationComparison),
+              &ST_CLASS(priorityLeastUsedDegradationSelectionKey),
+              NO_FUNCTION,
+              &ST_CLASS(leastUsedDegradationUpdatePoolElementNode),
+              NO_FUNCTION),
+
+   POOLPOLICY(PPT_RANDOMIZED_LEASTUSED, "RandomizedLeastUsed",
+              1, ByValueTree,
+              &ST_CLASS(randomizedLeastUsedComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(randomizedLeastUsedUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_RANDOMIZED_LEASTUSED_DEGRADATION, "RandomizedLeastUsedDegradation",
+              1, ByValueTree,
+              &ST_CLASS(randomizedLeastUsedDegradationComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(randomizedLeastUsedDegradationUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_RANDOMIZED_PRIORITY_LEASTUSED, "RandomizedPriorityLeastUsed",
+              1, ByValueTree,
+              &ST_CLASS(randomizedPriorityLeastUsedComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(randomizedPriorityLeastUsedUpdatePoolElementNode),
+              NO_FUNCTION),
+   POOLPOLICY(PPT_RANDOMIZED_PRIORITY_LEASTUSED_DEGRADATION, "RandomizedPriorityLeastUsedDegradation",
+              1, ByValueTree,
+              &ST_CLASS(randomizedPriorityLeastUsedDegradationComparison),
+              NO_FUNCTION,
+              NO_FUNCTION,
+              &ST_CLASS(randomizedPriorityLeastUsedDegradationUpdatePoolElementNode),
+              NO_FUNCTION)
+};
+
+#undef NO_FUNCTION
+#undef POOLPOLICY
+#undef POOLPOLICY_USES_VALUETREE_BySortingOrder
+#undef POOLPOLICY_USES_VALUETREE_ByValueTree
+#undef POOLPOLICY_USES_VALUETREE_ByAliasTable
+#undef POOLPOLICY_USES_ALIASTABLE_BySortingOrder
+#undef POOLPOLICY_USES_ALIASTABLE_ByValueTree
+#undef POOLPOLICY_USES_ALIASTABLE_ByAliasTable
+#undef POOLPOLICY_SELECTS_BY_VALUE_BySortingOrder
+#undef POOLPOLICY_SELECTS_BY_VALUE_ByValueTree
+#undef POOLPOLICY_SELECTS_BY_VALUE_ByAliasTable
+#undef POOLPOLICY_SELECTIONFUNCTION_BySortingOrder
+#undef POOLPOLICY_SELECTIONFUNCTION_ByValueTree
+#undef POOLPOLICY_SELECTIONFUNCTION_ByAliasTable
+
 const size_t ST_CLASS(PoolPolicies) = sizeof(ST_CLASS(PoolPolicyArray)) /
                                          sizeof(struct ST_CLASS(PoolPolicy));
 
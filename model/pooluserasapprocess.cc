@@ -30,14 +30,19 @@
 
 #include "utilities.h"
 #include "messages_m.h"
+#include "statisticswriterinterface.h"
 #include "handlespacemanagementwrapper.h"
 
 
-class PoolUserASAPProcess : public cSimpleModule
+class PoolUserASAPProcess : public StatisticsWriterInterface,
+                            public cSimpleModule
 {
    // ====== Methods ========================================================
    virtual void initialize();
+   virtual void finish();
    virtual void handleMessage(cMessage* msg);
+   virtual void resetStatistics();
+   virtual void writeStatistics();
 
    void selectPoolElement();
    bool selectPoolElementFromCache();
@@ -69,6 +74,8 @@ class PoolUserASAPProcess : public cSimpleModule
    void stopT1HandleResolutionRequestTimer();
    void startServerHuntRetryTimer();
    void stopServerHuntRetryTimer();
+   void startMemoryUsageTimer();
+   void handleMemoryUsageTimer();
 
    // ====== ASAP Protocol ==================================================
    void handleServerSelectionRequest(ServerSelectionRequest* msg);
@@ -82,14 +89,21 @@ class PoolUserASAPProcess : public cSimpleModule
    // ====== Timers =========================================================
    cMessage*        T1HandleResolutionRequestTimer;
    cMessage*        ServerHuntRetryTimer;
+   cMessage*        MemoryUsageTimer;
 
 
    // ====== Variables ======================================================
-   unsigned int     HandleResolutionRequestsSent;
-   unsigned int     RegistrarAddress;
-   opp_string       PoolHandle;
-   cPoolHandlespace Cache;
-   opp_string       Description;
+   unsigned int      HandleResolutionRequestsSent;
+   unsigned int      RegistrarAddress;
+   unsigned int      PoolHandleID;
+   cPoolHandlespace* Cache;
+   opp_string        Description;
+
+   cOutVector*            CacheMemoryUsageVector;
+   cOutVector*            CacheMemoryUsagePerPEVector;
+   HandlespaceMemoryUsage CacheMemoryUsageSum;   // Sum over the samples
+   unsigned int           MemoryUsageSamples;
+   cStdDev                CacheMemoryUsagePerPEStat;
 };
 
 Define_Module(PoolUserASAPProcess);
@@ -105,8 +119,25 @@ void PoolUserASAPProcess::initialize()
 
    RegistrarAddress               = 0;
    HandleResolutionRequestsSent   = 0;
+   PoolHandleID                   = 0;
    T1HandleResolutionRequestTimer = NULL;
    ServerHuntRetryTimer           = NULL;
+   MemoryUsageTimer               = NULL;
+
+   const char* cacheBackend = par("asapCacheBackend");
+   Cache = cPoolHandlespace::create(cacheBackend);
+   if(Cache == NULL) {
+      throw cRuntimeError("Bad asapCacheBackend: %s", cacheBackend);
+   }
+
+   CacheMemoryUsageVector = new cOutVector("CacheMemoryUsage");
+   OPP_CHECK(CacheMemoryUsageVector);
+   CacheMemoryUsagePerPEVector = new cOutVector("CacheMemoryUsagePerPoolElement");
+   OPP_CHECK(CacheMemoryUsagePerPEVector);
+   if((simtime_t)par("asapMemoryUsageInterval") > 0) {
+      startMemoryUsageTimer();
+   }
+   resetStatistics();
 
    // ------ Bind to port ---------------------------------------------------
    BindMessage* msg = new BindMessage("Bind");
@@ -118,6 +149,76 @@ void PoolUserASAPProcess::initialize()
 }
 
 
+// ###### Clean up ##########################################################
+void PoolUserASAPProcess::finish()
+{
+   delete CacheMemoryUsageVector;
+   CacheMemoryUsageVector = NULL;
+   delete CacheMemoryUsagePerPEVector;
+   CacheMemoryUsagePerPEVector = NULL;
+   delete Cache;
+   Cache = NULL;
+}
+
+
+// ###### Reset statistics ##################################################
+void PoolUserASAPProcess::resetStatistics()
+{
+   handlespaceMemoryUsageClear(&CacheMemoryUsageSum);
+   MemoryUsageSamples = 0;
+   CacheMemoryUsagePerPEStat.clear();
+}
+
+
+// ###### Write statistics ##################################################
+void PoolUserASAPProcess::writeStatistics()
+{
+   if(MemoryUsageSamples > 0) {
+      recordScalar("PoolUserASAP Average Cache Memory Usage",
+                   (double)handlespaceMemoryUsageGetTotal(&CacheMemoryUsageSum) / MemoryUsageSamples);
+      recordScalar("PoolUserASAP Average Cache Node Memory Usage",
+                   (double)CacheMemoryUsageSum.Nodes / MemoryUsageSamples);
+      recordScalar("PoolUserASAP Average Cache Transport Address Memory Usage",
+                   (double)CacheMemoryUsageSum.TransportAddressBlocks / MemoryUsageSamples);
+      recordScalar("PoolUserASAP Average Cache Policy State Memory Usage",
+                   (double)CacheMemoryUsageSum.PolicyState / MemoryUsageSamples);
+      recordScalar("PoolUserASAP Average Cache Memory Usage Per Pool Element",
+                   CacheMemoryUsagePerPEStat.getMean());
+   }
+}
+
+
+// ###### Start Memory Usage timer ##########################################
+void PoolUserASAPProcess::startMemoryUsageTimer()
+{
+   OPP_CHECK(MemoryUsageTimer == NULL);
+   MemoryUsageTimer = new cMessage("MemoryUsageTimer");
+   scheduleAt(simTime() + (simtime_t)par("asapMemoryUsageInterval"), MemoryUsageTimer);
+}
+
+
+// ###### Handle Memory Usage timer #########################################
+void PoolUserASAPProcess::handleMemoryUsageTimer()
+{
+   HandlespaceMemoryUsage cacheMemoryUsage;
+
+   MemoryUsageTimer = NULL;
+   Cache->getMemoryUsage(cacheMemoryUsage);
+
+   const size_t cacheBytes   = handlespaceMemoryUsageGetTotal(&cacheMemoryUsage);
+   const size_t poolElements = Cache->getPoolElements();
+   CacheMemoryUsageVector->record(cacheBytes);
+   if(poolElements > 0) {
+      CacheMemoryUsagePerPEVector->record((double)cacheBytes / poolElements);
+      CacheMemoryUsagePerPEStat.collect((double)cacheBytes / poolElements);
+   }
+   handlespaceMemoryUsageAdd(&CacheMemoryUsageSum, &cacheMemoryUsage);
+   MemoryUsageSamples++;
+
+   startMemoryUsageTimer();
+}
+
+
 // ###### Start Handle Resolution Request timer #############################
 void PoolUserASAPProcess::startT1HandleResolutionRequestTimer()
 {
@@ -157,7 +258,7 @@ void PoolUserASAPProcess::stopServerHuntRetryTimer()
 // ###### Handle ServerSelection request from application ###################
 void PoolUserASAPProcess::handleServerSelectionRequest(ServerSelectionRequest* msg)
 {
-   PoolHandle = msg->getPoolHandle();
+   PoolHandleID = getMessagePoolHandleID(msg);
 }
 
 
@@ -169,7 +270,7 @@ void PoolUserASAPProcess::sendASAPHandleResolution()
    handleResolution->setDstAddress(RegistrarAddress);
    handleResolution->setSrcPort(PoolUserASAPPort);
    handleResolution->setDstPort(RegistrarPort);
-   handleResolution->setPoolHandle(PoolHandle.c_str());
+   handleResolution->setPoolHandleID(PoolHandleID);
 
    handleResolution->setTimestamp(simTime());
    send(handleResolution, "toTransport");
@@ -184,25 +285,26 @@ bool PoolUserASAPProcess::handleASAPHandleResolutionResponse(ASAPHandleResolutio
          Ensure, that no outdated elements remain in the cache. After adding
          the new elements below, the cache is ready for a
          selectPoolElements() call. */
-      size_t purged = Cache.purgeExpiredPoolElements();
+      size_t purged = Cache->purgeExpiredPoolElements();
       if(purged > 0) {
          EV << Description << "Purged " << purged << " entries in cache" << endl;
       }
-      const size_t oldElementCount = Cache.getPoolElementsOfPool(msg->getPoolHandle());
+      const unsigned int poolHandleID    = getMessagePoolHandleID(msg);
+      const size_t       oldElementCount = Cache->getPoolElementsOfPool(poolHandleID);
 
       const unsigned int items = msg->getPoolElementParameterArraySize();
       for(unsigned int i = 0;i < items;i++) {
          cPoolElement* poolElement;
          bool          updated;
-         Cache.registerPoolElement(msg->getPoolHandle(),
+         Cache->registerPoolElement(poolHandleID,
                                    msg->getPoolElementParameter(i),
                                    0, 0,
                                    poolElement, updated);
-         Cache.restartPoolElementExpiryTimer(poolElement,
+         Cache->restartPoolElementExpiryTimer(poolElement,
                                              (unsigned long long)(1000000.0 * (double)par("asapStaleCacheValue")));
       }
       if(oldElementCount == 0) {
-         OPP_CHECK(Cache.getPoolElementsOfPool(msg->getPoolHandle()) == items);
+         OPP_CHECK(Cache->getPoolElementsOfPool(poolHandleID) == items);
       }
       return(true);
    }
@@ -215,19 +317,19 @@ bool PoolUserASAPProcess::selectPoolElementFromCache()
 {
    cPoolElement* selectionArray[1];
    size_t        items  = 1;
-   const size_t  purged = Cache.purgeExpiredPoolElements();
+   const size_t  purged = Cache->purgeExpiredPoolElements();
    if(purged > 0) {
       EV << Description << "Purged " << purged << " entries in cache" << endl;
    }
-   Cache.selectPoolElementsByPolicy(PoolHandle.c_str(), (cPoolElement**)&selectionArray, items, 1, 1000000000);
+   Cache->selectPoolElementsByPolicy(PoolHandleID, (cPoolElement**)&selectionArray, items, 1, 1000000000);
    if(items > 0) {
       EV << Description << "Successfully selected pool element from cache: " << endl;
       selectionArray[0]->print(true);
       EV << "Cache content:" << endl;
-      Cache.print();
+      Cache->print();
 
       ServerSelectionSuccess* response = new ServerSelectionSuccess("ServerSelectionSuccess");
-      response->setPoolHandle(PoolHandle.c_str());
+      response->setPoolHandleID(PoolHandleID);
       response->setPoolElementParameter(selectionArray[0]->toPoolElementParameter());
       send(response, "toApplication");
       return(true);
@@ -248,12 +350,12 @@ void PoolUserASAPProcess::selectPoolElement()
       this would clear the list just received from the NS.
       Instead, purging is done before the ServerSelectionResponse is handled.
       This ensures, that all cached elements are gone. */
-   Cache.selectPoolElementsByPolicy(PoolHandle.c_str(), (cPoolElement**)&selectionArray, items, 1, 1000000000);
+   Cache->selectPoolElementsByPolicy(PoolHandleID, (cPoolElement**)&selectionArray, items, 1, 1000000000);
    if(items > 0) {
       EV << Description << "Successfully selected pool element after nameserver query: " << endl;
       selectionArray[0]->print(true);
       EV << "Cache contents:" << endl;
-      Cache.print();
+      Cache->print();
 
 /*
       std::cerr << Description << ": Queried "
@@ -262,7 +364,7 @@ void PoolUserASAPProcess::selectPoolElement()
 */
 
       ServerSelectionSuccess* response = new ServerSelectionSuccess("ServerSelectionSuccess");
-      response->setPoolHandle(PoolHandle.c_str());
+      response->setPoolHandleID(PoolHandleID);
       response->setPoolElementParameter(selectionArray[0]->toPoolElementParameter());
       send(response, "toApplication");
    }
@@ -277,16 +379,17 @@ void PoolUserASAPProcess::selectPoolElement()
 // ###### Handle EndpointUnreachable from application #######################
 void PoolUserASAPProcess::handleEndpointUnreachable(EndpointUnreachable* msg)
 {
+   const unsigned int poolHandleID = getMessagePoolHandleID(msg);
    EV << Description << "Endpoint unreachable for " << msg->getIdentifier()
-      << " in pool " << msg->getPoolHandle() << endl;
-   Cache.deregisterPoolElement(msg->getPoolHandle(), msg->getIdentifier());
+      << " in pool " << getPoolHandleByID(poolHandleID) << endl;
+   Cache->deregisterPoolElement(poolHandleID, msg->getIdentifier());
 
    ASAPEndpointUnreachable* endpointUnreachable = new ASAPEndpointUnreachable("ASAP_ENDPOINT_UNREACHABLE", ASAP);
    endpointUnreachable->setProtocol(ASAP);
    endpointUnreachable->setDstAddress(RegistrarAddress);
    endpointUnreachable->setSrcPort(PoolUserASAPPort);
    endpointUnreachable->setDstPort(RegistrarPort);
-   endpointUnreachable->setPoolHandle(msg->getPoolHandle());
+   endpointUnreachable->setPoolHandleID(poolHandleID);
    endpointUnreachable->setIdentifier(msg->getIdentifier());
 
    endpointUnreachable->setTimestamp(simTime());
@@ -297,9 +400,10 @@ void PoolUserASAPProcess::handleEndpointUnreachable(EndpointUnreachable* msg)
 // ###### Handle CachePurge from application ################################
 void PoolUserASAPProcess::handleCachePurge(CachePurge* msg)
 {
+   const unsigned int poolHandleID = getMessagePoolHandleID(msg);
    EV << Description << "Cache purge for " << msg->getIdentifier()
-      << " in pool " << msg->getPoolHandle() << endl;
-   Cache.deregisterPoolElement(msg->getPoolHandle(), msg->getIdentifier());
+      << " in pool " << getPoolHandleByID(poolHandleID) << endl;
+   Cache->deregisterPoolElement(poolHandleID, msg->getIdentifier());
 }
 
 
@@ -326,6 +430,12 @@ void PoolUserASAPProcess::handleMessage(cMessage* msg)
    EV << Description << "Received message \"" << msg->getName()
       << "\" in state " << State.getStateName() << endl;
 
+   if(msg == MemoryUsageTimer) {
+      handleMemoryUsageTimer();
+      delete msg;
+      return;
+   }
+
    FSM_Switch(State) {
 
       case FSM_Exit(INIT):
@@ -46,6 +46,8 @@ void ST_CLASS(poolUserListNew)(struct ST_CLASS(PoolUserList)* poolUserList);
 void ST_CLASS(poolUserListDelete)(struct ST_CLASS(PoolUserList)* poolUserList);
 size_t ST_CLASS(poolUserListGetPoolUserNodes)(
           const struct ST_CLASS(PoolUserList)* poolUserList);
+void ST_CLASS(poolUserListGetMemoryUsage)(struct ST_CLASS(PoolUserList)* poolUserList,
+                                          struct HandlespaceMemoryUsage* memoryUsage);
 struct ST_CLASS(PoolUserNode)* ST_CLASS(poolUserListGetFirstPoolUserNode)(
                                   struct ST_CLASS(PoolUserList)* poolUserList);
 struct ST_CLASS(PoolUserNode)* ST_CLASS(poolUserListGetNextPoolUserNode)(
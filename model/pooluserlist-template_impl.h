@@ -51,6 +51,33 @@ size_t ST_CLASS(poolUserListGetPoolUserNodes)(
 }
 
 
+/* ###### Get memory usage ############################################## */
+void ST_CLASS(poolUserListGetMemoryUsage)(struct ST_CLASS(PoolUserList)* poolUserList,
+                                          struct HandlespaceMemoryUsage* memoryUsage)
+{
+   struct ST_CLASS(PoolUserNode)* poolUserNode;
+
+   handlespaceMemoryUsageClear(memoryUsage);
+   memoryUsage->Nodes = ST_CLASS(poolUserListGetPoolUserNodes)(poolUserList) *
+                           sizeof(struct ST_CLASS(PoolUserNode));
+   memoryUsage->Other = sizeof(struct ST_CLASS(PoolUserList)) +
+                        ST_METHOD(GetMemoryUsage)(&poolUserList->PoolUserListStorage);
+
+   poolUserNode = ST_CLASS(poolUserListGetFirstPoolUserNode)(poolUserList);
+   while(poolUserNode != NULL) {
+      if(poolUserNode->HandleResolutionHash != NULL) {
+         memoryUsage->TimeStampHashTables +=
+            timeStampHashTableGetMemoryUsage(poolUserNode->HandleResolutionHash);
+      }
+      if(poolUserNode->EndpointUnreachableHash != NULL) {
+         memoryUsage->TimeStampHashTables +=
+            timeStampHashTableGetMemoryUsage(poolUserNode->EndpointUnreachableHash);
+      }
+      poolUserNode = ST_CLASS(poolUserListGetNextPoolUserNode)(poolUserList, poolUserNode);
+   }
+}
+
+
 /* ###### Get first PoolUserNode ######################################### */
 struct ST_CLASS(PoolUserNode)* ST_CLASS(poolUserListGetFirstPoolUserNode)(
                                       struct ST_CLASS(PoolUserList)* poolUserList)
@@ -122,9 +122,13 @@ struct RB_DEFINITION(RedBlackTreeNode)* RB_FUNCTION(RedBlackTreeGetNearestNext)(
                                            const struct RB_DEFINITION(RedBlackTree)*     rbt,
                                            const struct RB_DEFINITION(RedBlackTreeNode)* cmpNode);
 size_t RB_FUNCTION(RedBlackTreeGetElements)(const struct RB_DEFINITION(RedBlackTree)* rbt);
+size_t RB_FUNCTION(RedBlackTreeGetMemoryUsage)(const struct RB_DEFINITION(RedBlackTree)* rbt);
 struct RB_DEFINITION(RedBlackTreeNode)* RB_FUNCTION(RedBlackTreeInsert)(
                                            struct RB_DEFINITION(RedBlackTree)*     rbt,
                                            struct RB_DEFINITION(RedBlackTreeNode)* node);
+void RB_FUNCTION(RedBlackTreeBuild)(struct RB_DEFINITION(RedBlackTree)*      rbt,
+                                    struct RB_DEFINITION(RedBlackTreeNode)** nodeArray,
+                                    const size_t                             nodes);
 struct RB_DEFINITION(RedBlackTreeNode)* RB_FUNCTION(RedBlackTreeRemove)(
                                            struct RB_DEFINITION(RedBlackTree)*     rbt,
                                            struct RB_DEFINITION(RedBlackTreeNode)* node);
@@ -486,6 +486,15 @@ size_t RB_FUNCTION(RedBlackTreeGetElements)(
 }
 
 
+/* ###### Get number of bytes allocated besides the nodes ################# */
+/* The tree only links the nodes embedded into the elements. */
+size_t RB_FUNCTION(RedBlackTreeGetMemoryUsage)(
+          const struct RB_DEFINITION(RedBlackTree)* rbt)
+{
+   return(0);
+}
+
+
 /* ###### Get prev node by walking through the tree (does *not* use list!) */
 static struct RB_DEFINITION(RedBlackTreeNode)* RB_FUNCTION(RedBlackTreeInternalFindPrev)(
                                                   const struct RB_DEFINITION(RedBlackTree)*     rbt,
@@ -750,13 +759,81 @@ finished:
 #ifdef DEBUG
    RB_FUNCTION(RedBlackTreePrint)(rbt, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
    RB_FUNCTION(RedBlackTreeVerify)(rbt);
 #endif
    return(result);
 }
 
 
+/* ###### Build balanced subtree from sorted node array ################# */
+static struct RB_DEFINITION(RedBlackTreeNode)* RB_FUNCTION(RedBlackTreeInternalBuild)(
+                                                  struct RB_DEFINITION(RedBlackTree)*      rbt,
+                                                  struct RB_DEFINITION(RedBlackTreeNode)*  parent,
+                                                  struct RB_DEFINITION(RedBlackTreeNode)** nodeArray,
+                                                  const size_t                             nodes,
+                                                  const unsigned int                       depth,
+                                                  const unsigned int                       redDepth)
+{
+   struct RB_DEFINITION(RedBlackTreeNode)* node;
+   const size_t                            middle = nodes / 2;
+
+   if(nodes == 0) {
+      return(&rbt->NullNode);
+   }
+   node               = nodeArray[middle];
+   node->Parent       = parent;
+   node->Color        = (depth == redDepth) ? Red : Black;
+   node->LeftSubtree  = RB_FUNCTION(RedBlackTreeInternalBuild)(
+                           rbt, node, nodeArray, middle, depth + 1, redDepth);
+   node->RightSubtree = RB_FUNCTION(RedBlackTreeInternalBuild)(
+                           rbt, node, &nodeArray[middle + 1], nodes - middle - 1, depth + 1, redDepth);
+   RB_FUNCTION(RedBlackTreeUpdateValueSum)(node);
+   return(node);
+}
+
+
+/* ###### Build tree from sorted node array ############################## */
+/*
+   nodeArray has to be sorted by the comparison function, without
+   duplicates. It has to contain all nodes currently in the tree.
+   Splitting at the middle gives a tree whose levels are complete except
+   for the deepest one; colouring only that level red satisfies the
+   red-black properties.
+*/
+void RB_FUNCTION(RedBlackTreeBuild)(struct RB_DEFINITION(RedBlackTree)*      rbt,
+                                    struct RB_DEFINITION(RedBlackTreeNode)** nodeArray,
+                                    const size_t                             nodes)
+{
+   unsigned int redDepth = 0;
+   size_t       i;
+
+   for(i = nodes;i > 1;i >>= 1) {
+      redDepth++;   /* redDepth = floor(log2(nodes)) = depth of deepest level */
+   }
+#ifdef USE_LEAFLINKED
+   doubleLinkedRingListNew(&rbt->List);
+   for(i = 0;i < nodes;i++) {
+      doubleLinkedRingListAddTail(&rbt->List, &nodeArray[i]->ListNode);
+   }
+#endif
+   rbt->NullNode.Parent       = &rbt->NullNode;
+   rbt->NullNode.RightSubtree = &rbt->NullNode;
+   rbt->NullNode.Color        = Black;
+   rbt->NullNode.LeftSubtree  = RB_FUNCTION(RedBlackTreeInternalBuild)(
+                                   rbt, &rbt->NullNode, nodeArray, nodes, 0, redDepth);
+   rbt->NullNode.LeftSubtree->Color = Black;
+   rbt->Elements              = nodes;
+
+#ifdef DEBUG
+   RB_FUNCTION(RedBlackTreePrint)(rbt, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   RB_FUNCTION(RedBlackTreeVerify)(rbt);
+#endif
+}
+
+
 /* ###### Remove ######################################################### */
 struct RB_DEFINITION(RedBlackTreeNode)* RB_FUNCTION(RedBlackTreeRemove)(
                                            struct RB_DEFINITION(RedBlackTree)*     rbt,
@@ -923,7 +1000,7 @@ struct RB_DEFINITION(RedBlackTreeNode)* RB_FUNCTION(RedBlackTreeRemove)(
 #ifdef DEBUG
     RB_FUNCTION(RedBlackTreePrint)(rbt, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
     RB_FUNCTION(RedBlackTreeVerify)(rbt);
 #endif
    return(node);
@@ -28,6 +28,8 @@
 
 #include <omnetpp.h>
 #include <algorithm>
+#include <set>
+#include <vector>
 
 #include "utilities.h"
 #include "messages_m.h"
@@ -54,9 +56,10 @@ class RegistrarProcess : public StatisticsWriterInterface,
    void printHandlespace();
    void beginNormalOperation(const bool initializedFromMentor);
    unsigned int randomizeMaxHandleResolutionItems(const unsigned int maxHandleResolutionItems,
-                                                  const char*        poolHandle);
+                                                  const unsigned int poolHandleID);
 
    void updateNumberStatistics();
+   void updateMemoryUsageStatistics();
 
    // ====== States =========================================================
    private:
@@ -75,6 +78,8 @@ class RegistrarProcess : public StatisticsWriterInterface,
    void startStartupTimer();
    void startShutdownTimer();
    void startRestartDelayTimer();
+   void startMemoryUsageTimer();
+   void handleMemoryUsageTimer();
 
    // ====== ENRP Timers ====================================================
    void startPeerHeartbeatCycleTimer();
@@ -121,10 +126,16 @@ class RegistrarProcess : public StatisticsWriterInterface,
    void sendENRPListRequest(cPeerListNode* node);
    void handleENRPListRequest(ENRPListRequest* msg);
    bool handleENRPListResponse(ENRPListResponse* msg);
+   ENRPHandleTableRequest* createENRPHandleTableRequest(cPeerListNode* node);
    void sendENRPHandleTableRequest(cPeerListNode* node,
                                    const bool     ownChildrenOnly);
+   void sendENRPHandleTableDigestRequest(cPeerListNode* node);
+   void sendENRPHandleTablePoolsRequest(cPeerListNode*                  node,
+                                        const std::vector<cPoolDigest>& poolDigests);
    void handleENRPHandleTableRequest(ENRPHandleTableRequest* msg);
    bool handleENRPHandleTableResponse(ENRPHandleTableResponse* msg);
+   void handleENRPHandleTableDigests(cPeerListNode*           node,
+                                     ENRPHandleTableResponse* msg);
 
    void sendENRPPresence(const cPeerListNode* node,
                          const bool           replyRequired);
@@ -146,6 +157,12 @@ class RegistrarProcess : public StatisticsWriterInterface,
 
    // ====== Parameters =====================================================
    unsigned int               MyIdentifier;
+   enum HandleTableSyncModes {
+      HTSM_FULL        = 0,   // Request the complete handle table
+      HTSM_INCREMENTAL = 1,   // Request the changes since the last sync
+      HTSM_DIGEST      = 2    // Request the pools differing in the digest tree
+   };
+   HandleTableSyncModes       HandleTableSyncMode;
 
 
    // ====== Timers =========================================================
@@ -154,6 +171,7 @@ class RegistrarProcess : public StatisticsWriterInterface,
    cMessage*                  RestartDelayTimer;
    cMessage*                  MentorDiscoveryTimeoutTimer;
    cMessage*                  PeerHeartbeatCycleTimer;
+   cMessage*                  MemoryUsageTimer;
 
 
    // ====== Variables ======================================================
@@ -173,6 +191,8 @@ class RegistrarProcess : public StatisticsWriterInterface,
    unsigned int               TotalRequestedPresences;
    unsigned int               TotalPeerListRequests;
    unsigned int               TotalHandleTableRequests;
+   unsigned int               TotalIncrementalHandleTablesSent;
+   unsigned int               TotalDigestHandleTablesSent;
    unsigned int               TotalTakeoversStarted;
    unsigned int               TotalTakeoversByConsent;
    unsigned int               TotalTakeoversByTimeout;
@@ -181,7 +201,7 @@ class RegistrarProcess : public StatisticsWriterInterface,
    unsigned int               LocalAddress;
    cPoolHandlespace*          Handlespace;
    cPeerList*                 PeerList;
-   cPoolUserList              UserList;
+   cPoolUserList*             UserList;
    ServerInformationParameter OwnServerInfo;
    opp_string                 Description;
    StatusChangeList           ComponentStatusChanges;
@@ -189,6 +209,10 @@ class RegistrarProcess : public StatisticsWriterInterface,
 
    cOutVector*                PoolElementCountVector;
    cOutVector*                OwnedPoolElementCountVector;
+   cOutVector*                HandlespaceMemoryUsageVector;
+   cOutVector*                HandlespaceMemoryUsagePerPEVector;
+   cOutVector*                PeerListMemoryUsageVector;
+   cOutVector*                UserListMemoryUsageVector;
 
    WeightedStdDev             NumberOfPoolsStat;
    WeightedStdDev             NumberOfPEsStat;
@@ -199,6 +223,13 @@ class RegistrarProcess : public StatisticsWriterInterface,
    size_t                     NumberOfPEs;
    size_t                     NumberOfOwnedPEs;
    size_t                     NumberOfPeers;
+
+   // Sums over the memory usage samples, in bytes
+   HandlespaceMemoryUsage     HandlespaceMemoryUsageSum;
+   HandlespaceMemoryUsage     PeerListMemoryUsageSum;
+   HandlespaceMemoryUsage     UserListMemoryUsageSum;
+   unsigned int               MemoryUsageSamples;
+   cStdDev                    HandlespaceMemoryUsagePerPEStat;
 };
 
 
@@ -214,16 +245,36 @@ void RegistrarProcess::initialize()
    Description  = format("RegistrarProcess at %u:%u [id=%u]> ",
                          getLocalAddress(this), RegistrarPort, MyIdentifier);
 
-   Handlespace = new cPoolHandlespace(MyIdentifier);
-   OPP_CHECK(Handlespace);
-   PeerList = new cPeerList(Handlespace, MyIdentifier);
+   const char* handlespaceBackend = par("registrarHandlespaceBackend");
+   Handlespace = cPoolHandlespace::create(handlespaceBackend, MyIdentifier);
+   if(Handlespace == NULL) {
+      throw cRuntimeError("Bad registrarHandlespaceBackend: %s", handlespaceBackend);
+   }
+   PeerList = Handlespace->createPeerList(MyIdentifier);
    OPP_CHECK(PeerList);
+   UserList = cPoolUserList::create(handlespaceBackend);
+   OPP_CHECK(UserList);
+
+   const char* handleTableSyncMode = par("enrpHandleTableSyncMode");
+   if(!strcmp(handleTableSyncMode, "full")) {
+      HandleTableSyncMode = HTSM_FULL;
+   }
+   else if(!strcmp(handleTableSyncMode, "incremental")) {
+      HandleTableSyncMode = HTSM_INCREMENTAL;
+   }
+   else if(!strcmp(handleTableSyncMode, "digest")) {
+      HandleTableSyncMode = HTSM_DIGEST;
+   }
+   else {
+      throw cRuntimeError("Bad enrpHandleTableSyncMode: %s", handleTableSyncMode);
+   }
 
    StartupTimer                = NULL;
    ShutdownTimer               = NULL;
    RestartDelayTimer           = NULL;
    MentorDiscoveryTimeoutTimer = NULL;
    PeerHeartbeatCycleTimer     = NULL;
+   MemoryUsageTimer            = NULL;
 
    Run                         = 1;
    LocalAddress                = getLocalAddress(this);
@@ -242,6 +293,18 @@ void RegistrarProcess::initialize()
    OPP_CHECK(OwnedPoolElementCountVector);
    OwnedPoolElementCountVector->record(0);
 
+   HandlespaceMemoryUsageVector = new cOutVector("HandlespaceMemoryUsage");
+   OPP_CHECK(HandlespaceMemoryUsageVector);
+   HandlespaceMemoryUsagePerPEVector = new cOutVector("HandlespaceMemoryUsagePerPoolElement");
+   OPP_CHECK(HandlespaceMemoryUsagePerPEVector);
+   PeerListMemoryUsageVector = new cOutVector("PeerListMemoryUsage");
+   OPP_CHECK(PeerListMemoryUsageVector);
+   UserListMemoryUsageVector = new cOutVector("PoolUserListMemoryUsage");
+   OPP_CHECK(UserListMemoryUsageVector);
+   if((simtime_t)par("registrarMemoryUsageInterval") > 0) {
+      startMemoryUsageTimer();
+   }
+
    // ------ Create peer table ----------------------------------------------
    const char*  staticRegistrarsList = par("enrpStaticPeersList");
    unsigned int registrarAddress;
@@ -289,6 +352,16 @@ void RegistrarProcess::finish()
    PoolElementCountVector = NULL;
    delete OwnedPoolElementCountVector;
    OwnedPoolElementCountVector = NULL;
+   delete HandlespaceMemoryUsageVector;
+   HandlespaceMemoryUsageVector = NULL;
+   delete HandlespaceMemoryUsagePerPEVector;
+   HandlespaceMemoryUsagePerPEVector = NULL;
+   delete PeerListMemoryUsageVector;
+   PeerListMemoryUsageVector = NULL;
+   delete UserListMemoryUsageVector;
+   UserListMemoryUsageVector = NULL;
+   delete UserList;
+   UserList = NULL;
    delete PeerList;
    PeerList = NULL;
    Handlespace->clear();
@@ -316,6 +389,8 @@ void RegistrarProcess::resetStatistics()
    TotalRequestedPresences            = 0;
    TotalPeerListRequests              = 0;
    TotalHandleTableRequests           = 0;
+   TotalIncrementalHandleTablesSent   = 0;
+   TotalDigestHandleTablesSent        = 0;
    TotalTakeoversStarted              = 0;
    TotalTakeoversByConsent            = 0;
    TotalTakeoversByTimeout            = 0;
@@ -329,6 +404,12 @@ void RegistrarProcess::resetStatistics()
    NumberOfPEs      = Handlespace->getPoolElements();
    NumberOfOwnedPEs = Handlespace->getOwnedPoolElements();
    NumberOfPeers    = PeerList->getPeers();
+
+   handlespaceMemoryUsageClear(&HandlespaceMemoryUsageSum);
+   handlespaceMemoryUsageClear(&PeerListMemoryUsageSum);
+   handlespaceMemoryUsageClear(&UserListMemoryUsageSum);
+   MemoryUsageSamples = 0;
+   HandlespaceMemoryUsagePerPEStat.clear();
 }
 
 
@@ -351,6 +432,8 @@ void RegistrarProcess::writeStatistics()
    recordScalar("Registrar Total Requested Presences",              TotalRequestedPresences);
    recordScalar("Registrar Total Peer List Requests",               TotalPeerListRequests);
    recordScalar("Registrar Total Handle Table Requests",            TotalHandleTableRequests);
+   recordScalar("Registrar Total Incremental Handle Tables Sent",   TotalIncrementalHandleTablesSent);
+   recordScalar("Registrar Total Digest Handle Tables Sent",        TotalDigestHandleTablesSent);
    recordScalar("Registrar Total Takeovers Started",                TotalTakeoversStarted);
    recordScalar("Registrar Total Takeovers By Consent",             TotalTakeoversByConsent);
    recordScalar("Registrar Total Takeovers By Timeout",             TotalTakeoversByTimeout);
@@ -360,6 +443,29 @@ void RegistrarProcess::writeStatistics()
    recordScalar("Registrar Average Number Of Owned Pool Elements", NumberOfOwnedPEsStat.getMean());
    recordScalar("Registrar Average Number Of Peers", NumberOfPeersStat.getMean());
 
+   if(MemoryUsageSamples > 0) {
+      recordScalar("Registrar Average Handlespace Memory Usage",
+                   (double)handlespaceMemoryUsageGetTotal(&HandlespaceMemoryUsageSum) / MemoryUsageSamples);
+      recordScalar("Registrar Average Handlespace Node Memory Usage",
+                   (double)HandlespaceMemoryUsageSum.Nodes / MemoryUsageSamples);
+      recordScalar("Registrar Average Handlespace Transport Address Memory Usage",
+                   (double)HandlespaceMemoryUsageSum.TransportAddressBlocks / MemoryUsageSamples);
+      recordScalar("Registrar Average Handlespace Policy State Memory Usage",
+                   (double)HandlespaceMemoryUsageSum.PolicyState / MemoryUsageSamples);
+      recordScalar("Registrar Average Handlespace Other Memory Usage",
+                   (double)HandlespaceMemoryUsageSum.Other / MemoryUsageSamples);
+      recordScalar("Registrar Average Handlespace Allocator Overhead",
+                   (double)HandlespaceMemoryUsageSum.AllocatorOverhead / MemoryUsageSamples);
+      recordScalar("Registrar Average Handlespace Memory Usage Per Pool Element",
+                   HandlespaceMemoryUsagePerPEStat.getMean());
+      recordScalar("Registrar Average Peer List Memory Usage",
+                   (double)handlespaceMemoryUsageGetTotal(&PeerListMemoryUsageSum) / MemoryUsageSamples);
+      recordScalar("Registrar Average Pool User List Memory Usage",
+                   (double)handlespaceMemoryUsageGetTotal(&UserListMemoryUsageSum) / MemoryUsageSamples);
+      recordScalar("Registrar Average Pool User List Time Stamp Hash Table Memory Usage",
+                   (double)UserListMemoryUsageSum.TimeStampHashTables / MemoryUsageSamples);
+   }
+
    AbstractController* controller = AbstractController::getController();
    if(controller) {
       controller->GlobalStartupsWithMentor            += TotalStartupsWithMentor;
@@ -406,6 +512,34 @@ void RegistrarProcess::updateNumberStatistics()
 }
 
 
+// ###### Update memory usage statistics ####################################
+void RegistrarProcess::updateMemoryUsageStatistics()
+{
+   HandlespaceMemoryUsage handlespaceMemoryUsage;
+   HandlespaceMemoryUsage peerListMemoryUsage;
+   HandlespaceMemoryUsage userListMemoryUsage;
+
+   Handlespace->getMemoryUsage(handlespaceMemoryUsage);
+   PeerList->getMemoryUsage(peerListMemoryUsage);
+   UserList->getMemoryUsage(userListMemoryUsage);
+
+   const size_t handlespaceBytes = handlespaceMemoryUsageGetTotal(&handlespaceMemoryUsage);
+   const size_t poolElements     = Handlespace->getPoolElements();
+   HandlespaceMemoryUsageVector->record(handlespaceBytes);
+   PeerListMemoryUsageVector->record(handlespaceMemoryUsageGetTotal(&peerListMemoryUsage));
+   UserListMemoryUsageVector->record(handlespaceMemoryUsageGetTotal(&userListMemoryUsage));
+   if(poolElements > 0) {
+      HandlespaceMemoryUsagePerPEVector->record((double)handlespaceBytes / poolElements);
+      HandlespaceMemoryUsagePerPEStat.collect((double)handlespaceBytes / poolElements);
+   }
+
+   handlespaceMemoryUsageAdd(&HandlespaceMemoryUsageSum, &handlespaceMemoryUsage);
+   handlespaceMemoryUsageAdd(&PeerListMemoryUsageSum, &peerListMemoryUsage);
+   handlespaceMemoryUsageAdd(&UserListMemoryUsageSum, &userListMemoryUsage);
+   MemoryUsageSamples++;
+}
+
+
 // ###### Start Startup timer ###############################################
 void RegistrarProcess::startStartupTimer()
 {
@@ -446,6 +580,27 @@ void RegistrarProcess::startRestartDelayTimer()
 }
 
 
+// ###### Start Memory Usage timer ##########################################
+void RegistrarProcess::startMemoryUsageTimer()
+{
+   OPP_CHECK(MemoryUsageTimer == NULL);
+   MemoryUsageTimer = new cMessage("MemoryUsageTimer");
+   scheduleAt(simTime() + (simtime_t)par("registrarMemoryUsageInterval"), MemoryUsageTimer);
+}
+
+
+// ###### Handle Memory Usage timer #########################################
+// Samples are taken in all states, until the registrar has finished.
+void RegistrarProcess::handleMemoryUsageTimer()
+{
+   MemoryUsageTimer = NULL;
+   updateMemoryUsageStatistics();
+   if(State.getState() != FINISHED) {
+      startMemoryUsageTimer();
+   }
+}
+
+
 // ###### Start Peer Heartbeat Cycle timer ##################################
 void RegistrarProcess::startPeerHeartbeatCycleTimer()
 {
@@ -781,7 +936,8 @@ void RegistrarProcess::handleASAPRegistration(ASAPRegistration* msg)
    response->setDstAddress(msg->getSrcAddress());
    response->setSrcPort(RegistrarPort);
    response->setDstPort(msg->getSrcPort());
-   response->setPoolHandle(msg->getPoolHandle());
+   const unsigned int poolHandleID = getMessagePoolHandleID(msg);
+   response->setPoolHandleID(poolHandleID);
    response->setIdentifier(poolElementParameter.getIdentifier());
 
    if( (!inStartupPhase()) || ((bool)par("asapNoServiceDuringStartup") == false) ) {
@@ -800,7 +956,7 @@ void RegistrarProcess::handleASAPRegistration(ASAPRegistration* msg)
       // ====== Register pool element ==========================================
       cPoolElement* poolElement;
       bool          updated;
-      response->setError(Handlespace->registerPoolElement(msg->getPoolHandle(),
+      response->setError(Handlespace->registerPoolElement(poolHandleID,
                                                           poolElementParameter,
                                                           msg->getSrcAddress(),
                                                           msg->getSrcPort(),
@@ -847,10 +1003,11 @@ void RegistrarProcess::handleASAPDeregistration(ASAPDeregistration* msg)
    response->setDstAddress(msg->getSrcAddress());
    response->setSrcPort(RegistrarPort);
    response->setDstPort(msg->getSrcPort());
-   response->setPoolHandle(msg->getPoolHandle());
+   const unsigned int poolHandleID = getMessagePoolHandleID(msg);
+   response->setPoolHandleID(poolHandleID);
    response->setIdentifier(msg->getIdentifier());
 
-   cPoolElement* poolElement = Handlespace->findPoolElement(msg->getPoolHandle(),
+   cPoolElement* poolElement = Handlespace->findPoolElement(poolHandleID,
                                                             msg->getIdentifier());
    if(poolElement) {
       EV << Description << "Removing pool element "
@@ -878,7 +1035,7 @@ void RegistrarProcess::handleASAPDeregistration(ASAPDeregistration* msg)
    }
    else {
       EV << Description << "Pool element "
-         << msg->getIdentifier() << " of pool " << msg->getPoolHandle()
+         << msg->getIdentifier() << " of pool " << getPoolHandleByID(poolHandleID)
          << " is found, it seems to be already removed" << endl;
       response->setError(RSPERR_OKAY);
    }
@@ -894,9 +1051,9 @@ void RegistrarProcess::handleASAPDeregistration(ASAPDeregistration* msg)
 
 // ###### Randomize MaxHandleResolutionItems ################################
 unsigned int RegistrarProcess::randomizeMaxHandleResolutionItems(const unsigned int maxHandleResolutionItems,
-                                                                 const char*        poolHandle)
+                                                                 const unsigned int poolHandleID)
 {
-   unsigned int maxItems = std::min((unsigned int)Handlespace->getPoolElementsOfPool(poolHandle),
+   unsigned int maxItems = std::min((unsigned int)Handlespace->getPoolElementsOfPool(poolHandleID),
                                     maxHandleResolutionItems + 1);
    if(maxItems > 1) {
       maxItems--;
@@ -916,7 +1073,7 @@ void RegistrarProcess::handleASAPHandleResolution(ASAPHandleResolution* msg)
 
    if((double)par("registrarMaxHandleResolutionRate") > 0.0) {
       const double handleResolutionRate =
-         UserList.noteHandleResolutionOfPoolUser(msg->getPoolHandle(),
+         UserList->noteHandleResolutionOfPoolUser(getMessagePoolHandleID(msg),
                                                  msg->getSrcAddress(),
                                                  msg->getSrcPort(),
                                                  par("registrarHandleResolutionRateBuckets"),
@@ -934,26 +1091,27 @@ void RegistrarProcess::handleASAPHandleResolution(ASAPHandleResolution* msg)
    response->setDstAddress(msg->getSrcAddress());
    response->setSrcPort(RegistrarPort);
    response->setDstPort(msg->getSrcPort());
-   response->setPoolHandle(msg->getPoolHandle());
+   const unsigned int poolHandleID = getMessagePoolHandleID(msg);
+   response->setPoolHandleID(poolHandleID);
 
    if( (!inStartupPhase()) || ((bool)par("asapNoServiceDuringStartup") == false) ) {
       size_t items;
       if((bool)par("registrarRandomizeMaxHandleResolutionItems") == true) {
          items = randomizeMaxHandleResolutionItems(
                   (unsigned int)par("registrarMaxHandleResolutionItems"),
-                  msg->getPoolHandle());
+                  poolHandleID);
       }
       else {
          items = (unsigned int)par("registrarMaxHandleResolutionItems");
       }
 
       EV << Description << "Selecting up to " << items << " of pool "
-         << msg->getPoolHandle() << " ..." << endl;
+         << getPoolHandleByID(poolHandleID) << " ..." << endl;
 
       cPoolElement** selectionArray = new cPoolElement*[items];
       OPP_CHECK(selectionArray);
       unsigned int policyType = Handlespace->selectPoolElementsByPolicy(
-                                 msg->getPoolHandle(),
+                                 poolHandleID,
                                  selectionArray, items,
                                  items,
                                  (unsigned int)par("registrarMaxIncrement"));
@@ -965,7 +1123,6 @@ void RegistrarProcess::handleASAPHandleResolution(ASAPHandleResolution* msg)
          EV << endl;
       }
 
-      response->setPoolHandle(msg->getPoolHandle());
       cPoolPolicyParameter overallPoolElementSelectionPolicy;
       overallPoolElementSelectionPolicy.setPolicyType(policyType);
       response->setOverallPoolElementSelectionPolicy(overallPoolElementSelectionPolicy);
@@ -993,7 +1150,7 @@ void RegistrarProcess::handleASAPEndpointUnreachable(ASAPEndpointUnreachable* ms
 
    if((double)par("registrarMaxEndpointUnreachableRate") > 0.0) {
       const double endpointUnreachableRate =
-         UserList.noteEndpointUnreachableOfPoolUser(msg->getPoolHandle(),
+         UserList->noteEndpointUnreachableOfPoolUser(getMessagePoolHandleID(msg),
                                                     msg->getSrcAddress(),
                                                     msg->getSrcPort(),
                                                     0, /* msg->getIdentifier(), --- only for full pool! --- */
@@ -1008,7 +1165,7 @@ void RegistrarProcess::handleASAPEndpointUnreachable(ASAPEndpointUnreachable* ms
       }
    }
 
-   cPoolElement* poolElement = Handlespace->findPoolElement(msg->getPoolHandle(),
+   cPoolElement* poolElement = Handlespace->findPoolElement(getMessagePoolHandleID(msg),
                                                             msg->getIdentifier());
    if(poolElement) {
       poolElement->setUnreachabilityReports(poolElement->getUnreachabilityReports() + 1);
@@ -1048,7 +1205,7 @@ void RegistrarProcess::sendASAPEndpointKeepAlive(const cPoolElement* poolElement
    endpointKeepAlive->setDstAddress(poolElement->getRegistratorAddress());
    endpointKeepAlive->setDstPort(poolElement->getRegistratorPort());
    endpointKeepAlive->setSrcPort(RegistrarPort);
-   endpointKeepAlive->setPoolHandle(poolElement->getOwnerPoolHandle());
+   endpointKeepAlive->setPoolHandleID(poolElement->getOwnerPoolHandleID());
    endpointKeepAlive->setIdentifier(poolElement->getIdentifier());
    endpointKeepAlive->setHomeFlag(homeFlag);
 
@@ -1061,7 +1218,7 @@ void RegistrarProcess::sendASAPEndpointKeepAlive(const cPoolElement* poolElement
 // ###### Handle ASAP_ENDPOINT_KEEP_ALIVE_ACK message #######################
 void RegistrarProcess::handleASAPEndpointKeepAliveAck(ASAPEndpointKeepAliveAck* msg)
 {
-   cPoolElement* poolElement = Handlespace->findPoolElement(msg->getPoolHandle(),
+   cPoolElement* poolElement = Handlespace->findPoolElement(getMessagePoolHandleID(msg),
                                                             msg->getIdentifier());
    if((poolElement) && (poolElement->EndpointKeepAliveTimeoutTimer)) {
       stopEndpointKeepAliveTimeoutTimer(poolElement);
@@ -1145,6 +1302,9 @@ bool RegistrarProcess::handleENRPListResponse(ENRPListResponse* msg)
          if(serverInfo.getServerID() != MyIdentifier) {
             OPP_CHECK(PeerList->registerPeerListNode(serverInfo, node) == RSPERR_OKAY);
             if(node->getNewFlag())  {
+               node->HandlespaceVersion     = 0;
+               node->HandlespaceIncarnation = 0;
+               node->IncrementalSync        = false;
                EV << Description << "Sending Presence to new peer "
                   << node->getIdentifier() << endl;
                sendENRPPresence(node, true);
@@ -1161,9 +1321,8 @@ bool RegistrarProcess::handleENRPListResponse(ENRPListResponse* msg)
 }
 
 
-// ###### Send ENRP_HANDLE_TABLE_REQUEST message ############################
-void RegistrarProcess::sendENRPHandleTableRequest(cPeerListNode* node,
-                                                  const bool     ownChildrenOnly)
+// ###### Create ENRP_HANDLE_TABLE_REQUEST message ##########################
+ENRPHandleTableRequest* RegistrarProcess::createENRPHandleTableRequest(cPeerListNode* node)
 {
    OPP_CHECK(!(node->getStatus() & PLNS_HTSYNC));
    node->setStatus(node->getStatus() | PLNS_HTSYNC);
@@ -1175,7 +1334,55 @@ void RegistrarProcess::sendENRPHandleTableRequest(cPeerListNode* node,
    handleTableRequest->setSrcPort(RegistrarPort);
    handleTableRequest->setSenderServerID(MyIdentifier);
    handleTableRequest->setReceiverServerID(node->getIdentifier());
+   return(handleTableRequest);
+}
+
+
+// ###### Send ENRP_HANDLE_TABLE_REQUEST message ############################
+void RegistrarProcess::sendENRPHandleTableRequest(cPeerListNode* node,
+                                                  const bool     ownChildrenOnly)
+{
+   ENRPHandleTableRequest* handleTableRequest = createENRPHandleTableRequest(node);
    handleTableRequest->setOwnChildrenOnlyFlag(ownChildrenOnly);
+   // Only ask for the changes since the last synchronization, if possible
+   if( (ownChildrenOnly) && (HandleTableSyncMode == HTSM_INCREMENTAL) ) {
+      handleTableRequest->setSinceVersion(node->HandlespaceVersion);
+      handleTableRequest->setSinceIncarnation(node->HandlespaceIncarnation);
+   }
+
+   handleTableRequest->setTimestamp(simTime());
+   send(handleTableRequest, "toTransport");
+}
+
+
+// ###### Send ENRP_HANDLE_TABLE_REQUEST for peer's pool digests ############
+void RegistrarProcess::sendENRPHandleTableDigestRequest(cPeerListNode* node)
+{
+   unsigned int digestArray[HANDLESPACE_DIGEST_BUCKETS];
+   Handlespace->getOwnershipDigests(node->getIdentifier(), (unsigned int*)&digestArray);
+
+   ENRPHandleTableRequest* handleTableRequest = createENRPHandleTableRequest(node);
+   handleTableRequest->setOwnChildrenOnlyFlag(true);
+   handleTableRequest->setOwnershipDigestArraySize(HANDLESPACE_DIGEST_BUCKETS);
+   for(unsigned int i = 0;i < HANDLESPACE_DIGEST_BUCKETS;i++) {
+      handleTableRequest->setOwnershipDigest(i, digestArray[i]);
+   }
+
+   handleTableRequest->setTimestamp(simTime());
+   send(handleTableRequest, "toTransport");
+}
+
+
+// ###### Send ENRP_HANDLE_TABLE_REQUEST for peer's PEs of given pools ######
+void RegistrarProcess::sendENRPHandleTablePoolsRequest(cPeerListNode*                  node,
+                                                       const std::vector<cPoolDigest>& poolDigests)
+{
+   ENRPHandleTableRequest* handleTableRequest = createENRPHandleTableRequest(node);
+   handleTableRequest->setOwnChildrenOnlyFlag(true);
+   handleTableRequest->setPoolDigestArraySize(poolDigests.size());
+   for(size_t i = 0;i < poolDigests.size();i++) {
+      handleTableRequest->setPoolDigest(i, poolDigests[i]);
+   }
 
    handleTableRequest->setTimestamp(simTime());
    send(handleTableRequest, "toTransport");
@@ -1197,8 +1404,67 @@ void RegistrarProcess::handleENRPHandleTableRequest(ENRPHandleTableRequest* msg)
    handleTableResponse->setRejectFlag(false);
    handleTableResponse->setMoreToSendFlag(false);
 
-   cArray* poolEntryArray = Handlespace->exportToPoolEntries(
-                               msg->getOwnChildrenOnlyFlag() ? MyIdentifier : 0);
+   const unsigned int homeRegistrarIdentifier = msg->getOwnChildrenOnlyFlag() ? MyIdentifier : 0;
+   cArray*            deletedPoolEntryArray   = NULL;
+   cArray*            poolEntryArray;
+   if(msg->getOwnershipDigestArraySize() == HANDLESPACE_DIGEST_BUCKETS) {
+      // ====== Digests of own pools in differing buckets ==================
+      unsigned int digestArray[HANDLESPACE_DIGEST_BUCKETS];
+      handleTableResponse->setDigestFlag(true);
+      Handlespace->getOwnershipDigests(MyIdentifier, (unsigned int*)&digestArray);
+      handleTableResponse->setOwnershipDigestArraySize(HANDLESPACE_DIGEST_BUCKETS);
+      for(unsigned int i = 0;i < HANDLESPACE_DIGEST_BUCKETS;i++) {
+         handleTableResponse->setOwnershipDigest(i, digestArray[i]);
+         digestArray[i] = msg->getOwnershipDigest(i);
+      }
+      cArray* poolDigestArray = Handlespace->exportPoolDigests((const unsigned int*)&digestArray);
+      if(poolDigestArray) {
+         handleTableResponse->setPoolDigestArraySize(poolDigestArray->size());
+         for(int i = 0;i < poolDigestArray->size();i++) {
+            handleTableResponse->setPoolDigest(i, *(cPoolDigest*)(*poolDigestArray)[i]);
+         }
+         delete poolDigestArray;
+      }
+      poolEntryArray = NULL;
+   }
+   else if(msg->getPoolDigestArraySize() > 0) {
+      // ====== Own PEs of pools still differing ===========================
+      TotalDigestHandleTablesSent++;
+      std::vector<unsigned int> poolHandleIDs;
+      for(unsigned int i = 0;i < msg->getPoolDigestArraySize();i++) {
+         const cPoolDigest& poolDigest   = msg->getPoolDigest(i);
+         const unsigned int poolHandleID = getMessagePoolHandleID(&poolDigest);
+         const unsigned int digest       = Handlespace->getPoolOwnershipDigest(MyIdentifier, poolHandleID);
+         if(digest != poolDigest.getDigest()) {
+            poolHandleIDs.push_back(poolHandleID);
+            cPoolDigest ownPoolDigest(poolDigest);
+            ownPoolDigest.setDigest(digest);
+            handleTableResponse->setPoolDigestArraySize(poolHandleIDs.size());
+            handleTableResponse->setPoolDigest(poolHandleIDs.size() - 1, ownPoolDigest);
+         }
+      }
+      handleTableResponse->setIncrementalFlag(true);
+      poolEntryArray = (poolHandleIDs.size() > 0) ?
+                          Handlespace->exportPoolsToPoolEntries(MyIdentifier,
+                                                                &poolHandleIDs.front(),
+                                                                poolHandleIDs.size()) : NULL;
+   }
+   else if( (msg->getSinceVersion() != 0) &&
+            (msg->getSinceIncarnation() == Run) &&
+            (Handlespace->hasChangesSince(msg->getSinceVersion())) ) {
+      // The versions restart after a restart of this registrar, i.e. a
+      // version of an older incarnation requires the complete handle table
+      TotalIncrementalHandleTablesSent++;
+      handleTableResponse->setIncrementalFlag(true);
+      poolEntryArray = Handlespace->exportChangesToPoolEntries(homeRegistrarIdentifier,
+                                                               msg->getSinceVersion(),
+                                                               deletedPoolEntryArray);
+   }
+   else {
+      poolEntryArray = Handlespace->exportToPoolEntries(homeRegistrarIdentifier);
+   }
+   handleTableResponse->setHandlespaceVersion(Handlespace->getHandlespaceVersion());
+   handleTableResponse->setHandlespaceIncarnation(Run);
    if(poolEntryArray) {
       handleTableResponse->setPoolEntryArraySize(poolEntryArray->size());
       for(int i = 0;i < poolEntryArray->size();i++) {
@@ -1207,6 +1473,14 @@ void RegistrarProcess::handleENRPHandleTableRequest(ENRPHandleTableRequest* msg)
       }
       delete poolEntryArray;
    }
+   if(deletedPoolEntryArray) {
+      handleTableResponse->setDeletedPoolEntryArraySize(deletedPoolEntryArray->size());
+      for(int i = 0;i < deletedPoolEntryArray->size();i++) {
+         cPoolEntry* poolEntry = (cPoolEntry*)(*deletedPoolEntryArray)[i];
+         handleTableResponse->setDeletedPoolEntry(i, *poolEntry);
+      }
+      delete deletedPoolEntryArray;
+   }
 
    handleTableResponse->setTimestamp(simTime());
    send(handleTableResponse, "toTransport");
@@ -1223,21 +1497,51 @@ bool RegistrarProcess::handleENRPHandleTableResponse(ENRPHandleTableResponse* ms
       node->setStatus(node->getStatus() & ~PLNS_HTSYNC);
    }
 
-   if(msg->getRejectFlag() == 0) {
+   if( (msg->getRejectFlag() == 0) && (msg->getDigestFlag()) ) {
+      if(node) {
+         handleENRPHandleTableDigests(node, msg);
+      }
+      return(true);
+   }
+   else if(msg->getRejectFlag() == 0) {
+      // ====== Remove PEs deleted since last synchronization ===============
+      for(unsigned int i = 0;i < msg->getDeletedPoolEntryArraySize();i++) {
+         const cPoolEntry&            poolEntry            = msg->getDeletedPoolEntry(i);
+         const cPoolElementParameter& poolElementParameter = poolEntry.getPoolElementParameter();
+         cPoolElement* poolElement = Handlespace->findPoolElement(
+                                        getMessagePoolHandleID(&poolEntry),
+                                        poolElementParameter.getIdentifier());
+         if( (poolElement) &&
+             (poolElement->getHomeRegistrarIdentifier() == poolElementParameter.getHomeRegistrarIdentifier()) ) {
+            EV << "Removing pool element " << poolElementParameter.getIdentifier()
+               << " of pool " << getPoolHandleByID(getMessagePoolHandleID(&poolEntry)) << " ..." << endl;
+            if(poolElement->EndpointKeepAliveTransmissionTimer) {
+               stopEndpointKeepAliveTransmissionTimer(poolElement);
+            }
+            if(poolElement->EndpointKeepAliveTimeoutTimer) {
+               stopEndpointKeepAliveTimeoutTimer(poolElement);
+            }
+            if(poolElement->LifetimeExpiryTimer) {
+               stopLifetimeExpiryTimer(poolElement);
+            }
+            Handlespace->deregisterPoolElement(poolElement);
+         }
+      }
+
       // ====== Update handlespace ==========================================
       EV << Description << "Adding handle table content to handlespace ..." << endl;
       for(unsigned int i = 0;i < msg->getPoolEntryArraySize();i++) {
          EV << "Adding pool element "
             << msg->getPoolEntry(i).getPoolElementParameter().getIdentifier()
-            << " of pool " << msg->getPoolEntry(i).getPoolHandle() << " ..." << endl;
-
+            << " of pool " << getPoolHandleByID(getMessagePoolHandleID(&msg->getPoolEntry(i))) << " ..." << endl;
          OPP_CHECK(msg->getPoolEntry(i).getPoolElementParameter().getHomeRegistrarIdentifier() != MyIdentifier);
-         cPoolElement* poolElement;
-         bool          updated;
-         if(Handlespace->registerPoolElement(msg->getPoolEntry(i).getPoolHandle(),
-                                             msg->getPoolEntry(i).getPoolElementParameter(),
-                                             0, 0,
-                                             poolElement, updated) == RSPERR_OKAY) {
+      }
+
+      cPoolElement** poolElementArray = new cPoolElement*[msg->getPoolEntryArraySize()];
+      Handlespace->registerHandleTable(msg, poolElementArray);
+      for(unsigned int i = 0;i < msg->getPoolEntryArraySize();i++) {
+         cPoolElement* poolElement = poolElementArray[i];
+         if(poolElement != NULL) {
             if(poolElement->EndpointKeepAliveTransmissionTimer) {
                stopEndpointKeepAliveTransmissionTimer(poolElement);
             }
@@ -1257,8 +1561,57 @@ bool RegistrarProcess::handleENRPHandleTableResponse(ENRPHandleTableResponse* ms
             }
          }
       }
+      delete [] poolElementArray;
+
+      // ====== Remove stale PEs of the pools covered by a digest sync ======
+      if(msg->getPoolDigestArraySize() > 0) {
+         std::set<unsigned int>                           coveredPools;
+         std::set<std::pair<unsigned int, unsigned int> > receivedPoolElements;
+         for(unsigned int i = 0;i < msg->getPoolDigestArraySize();i++) {
+            coveredPools.insert(getMessagePoolHandleID(&msg->getPoolDigest(i)));
+         }
+         for(unsigned int i = 0;i < msg->getPoolEntryArraySize();i++) {
+            const cPoolEntry& poolEntry = msg->getPoolEntry(i);
+            receivedPoolElements.insert(std::pair<unsigned int, unsigned int>(
+                                           getMessagePoolHandleID(&poolEntry),
+                                           poolEntry.getPoolElementParameter().getIdentifier()));
+         }
+
+         std::vector<cPoolElement*> stalePoolElements;
+         cPoolElement* poolElement = Handlespace->getFirstPoolElementOwnedBy(msg->getSenderServerID());
+         while(poolElement != NULL) {
+            if( (coveredPools.find(poolElement->getOwnerPoolHandleID()) != coveredPools.end()) &&
+                (receivedPoolElements.find(std::pair<unsigned int, unsigned int>(
+                                              poolElement->getOwnerPoolHandleID(),
+                                              poolElement->getIdentifier())) == receivedPoolElements.end()) ) {
+               stalePoolElements.push_back(poolElement);
+            }
+            poolElement = Handlespace->getNextPoolElementOfSameOwner(poolElement);
+         }
+         for(size_t i = 0;i < stalePoolElements.size();i++) {
+            poolElement = stalePoolElements[i];
+            EV << "Removing stale pool element " << poolElement->getIdentifier()
+               << " of pool " << poolElement->getOwnerPoolHandleID() << " ..." << endl;
+            if(poolElement->EndpointKeepAliveTransmissionTimer) {
+               stopEndpointKeepAliveTransmissionTimer(poolElement);
+            }
+            if(poolElement->EndpointKeepAliveTimeoutTimer) {
+               stopEndpointKeepAliveTimeoutTimer(poolElement);
+            }
+            if(poolElement->LifetimeExpiryTimer) {
+               stopLifetimeExpiryTimer(poolElement);
+            }
+            Handlespace->deregisterPoolElement(poolElement);
+         }
+      }
+
       PoolElementCountVector->record(Handlespace->getPoolElements());
       OwnedPoolElementCountVector->record(Handlespace->getOwnedPoolElements());
+      if(node) {
+         node->HandlespaceVersion     = msg->getHandlespaceVersion();
+         node->HandlespaceIncarnation = msg->getHandlespaceIncarnation();
+         node->IncrementalSync        = msg->getIncrementalFlag();
+      }
 
       // ====== Handlespace learned from mentor =============================
       if( (inStartupPhase()) && (node->getStatus() & PLNS_MENTOR) ) {
@@ -1279,6 +1632,61 @@ bool RegistrarProcess::handleENRPHandleTableResponse(ENRPHandleTableResponse* ms
 }
 
 
+// ###### Handle ENRP_HANDLE_TABLE_RESPONSE with peer's pool digests #######
+void RegistrarProcess::handleENRPHandleTableDigests(cPeerListNode*           node,
+                                                    ENRPHandleTableResponse* msg)
+{
+   // ====== Find the buckets differing from the peer's ones ================
+   unsigned int digestArray[HANDLESPACE_DIGEST_BUCKETS];
+   bool         differingBuckets[HANDLESPACE_DIGEST_BUCKETS];
+   Handlespace->getOwnershipDigests(node->getIdentifier(), (unsigned int*)&digestArray);
+   for(unsigned int i = 0;i < HANDLESPACE_DIGEST_BUCKETS;i++) {
+      differingBuckets[i] = (msg->getOwnershipDigestArraySize() != HANDLESPACE_DIGEST_BUCKETS) ||
+                            (msg->getOwnershipDigest(i) != digestArray[i]);
+   }
+
+   // ====== Request the pools differing from the peer's ones ===============
+   // Pools listed by the peer are differing if their digests do not match,
+   // pools only known locally are differing if they are in a differing
+   // bucket (the peer owns no PEs in them anymore).
+   std::vector<cPoolDigest> poolDigests;
+   std::set<unsigned int>   listedPools;
+   for(unsigned int i = 0;i < msg->getPoolDigestArraySize();i++) {
+      const cPoolDigest& poolDigest   = msg->getPoolDigest(i);
+      const unsigned int poolHandleID = getMessagePoolHandleID(&poolDigest);
+      listedPools.insert(poolHandleID);
+      const unsigned int digest = Handlespace->getPoolOwnershipDigest(node->getIdentifier(), poolHandleID);
+      if(digest != poolDigest.getDigest()) {
+         cPoolDigest ownPoolDigest(poolDigest);
+         ownPoolDigest.setDigest(digest);
+         poolDigests.push_back(ownPoolDigest);
+      }
+   }
+   const cPoolElement* poolElement = Handlespace->getFirstPoolElementOwnedBy(node->getIdentifier());
+   while(poolElement != NULL) {
+      const unsigned int poolHandleID = poolElement->getOwnerPoolHandleID();
+      if( (differingBuckets[Handlespace->getOwnershipDigestBucket(poolHandleID)]) &&
+          (listedPools.find(poolHandleID) == listedPools.end()) ) {
+         listedPools.insert(poolHandleID);
+         cPoolDigest ownPoolDigest;
+         ownPoolDigest.setPoolHandleID(poolHandleID);
+         ownPoolDigest.setDigest(Handlespace->getPoolOwnershipDigest(node->getIdentifier(), poolHandleID));
+         poolDigests.push_back(ownPoolDigest);
+      }
+      poolElement = Handlespace->getNextPoolElementOfSameOwner((cPoolElement*)poolElement);
+   }
+
+   if(poolDigests.size() > 0) {
+      TotalHandleTableRequests++;
+      sendENRPHandleTablePoolsRequest(node, poolDigests);
+   }
+   else {
+      // Nothing differs anymore -> a full sync will follow on mismatch
+      node->IncrementalSync = true;
+   }
+}
+
+
 // ###### Send ENRP_PRESENCE ################################################
 void RegistrarProcess::sendENRPPresence(const cPeerListNode* node,
                                         const bool           replyRequired)
@@ -1306,6 +1714,12 @@ void RegistrarProcess::handleENRPPresence(ENRPPresence* msg)
    // ====== Add/update peer node ===========================================
    cPeerListNode* node;
    OPP_CHECK(PeerList->registerPeerListNode(msg->getServerInformation(), node) == RSPERR_OKAY);
+   if(node->getNewFlag()) {
+      // Newly learned or re-learned peer -> start with a full synchronization
+      node->HandlespaceVersion     = 0;
+      node->HandlespaceIncarnation = 0;
+      node->IncrementalSync        = false;
+   }
    EV << Description << "New peer list is: " << endl;
    PeerList->print();
 
@@ -1371,8 +1785,21 @@ void RegistrarProcess::handleENRPPresence(ENRPPresence* msg)
                      node->getIdentifier(), node->getAddress(), node->getPort());
             getParentModule()->bubble(str);
          }
+         // The last incremental or digest synchronization has not resolved
+         // the inconsistency -> request the complete handle table now
          TotalHandleTableRequests++;
-         sendENRPHandleTableRequest(node, true);
+         if( (HandleTableSyncMode == HTSM_DIGEST) && (!node->IncrementalSync) ) {
+            sendENRPHandleTableDigestRequest(node);
+         }
+         else {
+            if(node->IncrementalSync) {
+               node->HandlespaceVersion = 0;
+            }
+            sendENRPHandleTableRequest(node, true);
+         }
+      }
+      else {
+         node->IncrementalSync = false;
       }
    }
 
@@ -1425,7 +1852,7 @@ void RegistrarProcess::sendENRPHandleUpdates(const cPoolElement* poolElement,
          handleUpdate->setSenderServerID(MyIdentifier);
          handleUpdate->setReceiverServerID(node->getIdentifier());
          handleUpdate->setUpdateAction(updateAction);
-         handleUpdate->setPoolHandle(poolElement->getOwnerPoolHandle());
+         handleUpdate->setPoolHandleID(poolElement->getOwnerPoolHandleID());
          handleUpdate->setPoolElementParameter(poolElement->toPoolElementParameter());
 
          handleUpdate->setTakeoverSuggested( (node == betterPeerForPE) );
@@ -1455,7 +1882,7 @@ void RegistrarProcess::handleENRPHandleUpdate(ENRPHandleUpdate* msg)
    EV << Description << "Received Handle Update: "
       << ((msg->getUpdateAction() == ADD_PE) ? "ADD_PE" : "DEL_PE")
       << " for pool element " << poolElementParameter.getIdentifier()
-      << " of pool " << msg->getPoolHandle() << endl;
+      << " of pool " << getPoolHandleByID(getMessagePoolHandleID(msg)) << endl;
    OPP_CHECK(poolElementParameter.getHomeRegistrarIdentifier() != MyIdentifier);
 
    if(msg->getUpdateAction() == ADD_PE) {
@@ -1470,7 +1897,7 @@ void RegistrarProcess::handleENRPHandleUpdate(ENRPHandleUpdate* msg)
       // ====== Register pool element =======================================
       cPoolElement* poolElement;
       bool          updated;
-      if(Handlespace->registerPoolElement(msg->getPoolHandle(), poolElementParameter,
+      if(Handlespace->registerPoolElement(getMessagePoolHandleID(msg), poolElementParameter,
                                           0, 0, poolElement, updated) == RSPERR_OKAY) {
          if(poolElement->EndpointKeepAliveTransmissionTimer) {
             stopEndpointKeepAliveTransmissionTimer(poolElement);
@@ -1491,7 +1918,7 @@ void RegistrarProcess::handleENRPHandleUpdate(ENRPHandleUpdate* msg)
    }
    else {
       cPoolElement* poolElement = Handlespace->findPoolElement(
-                                     msg->getPoolHandle(),
+                                     getMessagePoolHandleID(msg),
                                      poolElementParameter.getIdentifier());
       if(poolElement) {
          if(poolElement->EndpointKeepAliveTransmissionTimer) {
@@ -1758,10 +2185,9 @@ void RegistrarProcess::handleENRPTakeoverServer(ENRPTakeoverServer* msg)
    }
 
    // ====== Update PEs' home PR identifier =================================
+   std::vector<cPoolElement*> poolElementArray;
    cPoolElement* poolElement = Handlespace->getFirstPoolElementOwnedBy(msg->getTargetServerID());
    while(poolElement) {
-      cPoolElement* nextPoolElement = Handlespace->getNextPoolElementOfSameOwner(poolElement);
-
       EV << Description << "Changing ownership of pool element "
          << poolElement->getIdentifier() << " in pool "
          << poolElement->getOwnerPoolHandle() << endl;
@@ -1776,14 +2202,19 @@ void RegistrarProcess::handleENRPTakeoverServer(ENRPTakeoverServer* msg)
       if(poolElement->LifetimeExpiryTimer) {
          stopLifetimeExpiryTimer(poolElement);
       }
+      poolElementArray.push_back(poolElement);
 
-      // Update handlespace
-      Handlespace->updatePoolElementOwnership(poolElement, msg->getSenderServerID());
+      poolElement = Handlespace->getNextPoolElementOfSameOwner(poolElement);
+   }
 
-      // Start LifetimeExpiry timer
-      startLifetimeExpiryTimer(poolElement);
+   // Update handlespace
+   OPP_CHECK(Handlespace->transferPoolElementOwnership(msg->getTargetServerID(),
+                                                       msg->getSenderServerID()) ==
+                poolElementArray.size());
 
-      poolElement = nextPoolElement;
+   // Start LifetimeExpiry timers
+   for(size_t i = 0;i < poolElementArray.size();i++) {
+      startLifetimeExpiryTimer(poolElementArray[i]);
    }
 
    PoolElementCountVector->record(Handlespace->getPoolElements());
@@ -1798,24 +2229,28 @@ void RegistrarProcess::finishTakeover(cPeerListNode* node)
       << " confirmed. Taking it over now." << endl;
 
    // ====== Take over PEs ==================================================
+   std::vector<cPoolElement*> poolElementArray;
    cPoolElement* poolElement = Handlespace->getFirstPoolElementOwnedBy(node->getIdentifier());
    while(poolElement) {
-      cPoolElement* nextPoolElement = Handlespace->getNextPoolElementOfSameOwner(poolElement);
-
       EV << Description << "Taking ownership of pool element "
          << poolElement->getIdentifier() << " in pool "
          << poolElement->getOwnerPoolHandle() << endl;
 
       // Deactivate expiry timer
       stopLifetimeExpiryTimer(poolElement);
+      poolElementArray.push_back(poolElement);
+
+      poolElement = Handlespace->getNextPoolElementOfSameOwner(poolElement);
+   }
 
-      // Update handlespace
-      Handlespace->updatePoolElementOwnership(poolElement, MyIdentifier);
+   // Update handlespace
+   OPP_CHECK(Handlespace->transferPoolElementOwnership(node->getIdentifier(), MyIdentifier) ==
+                poolElementArray.size());
 
-      // Tell node about new home PR and schedule endpoint keep-alive timeout
-      sendASAPEndpointKeepAlive(poolElement, true);
-      startEndpointKeepAliveTimeoutTimer(poolElement);
-      poolElement = nextPoolElement;
+   // Tell nodes about new home PR and schedule endpoint keep-alive timeouts
+   for(size_t i = 0;i < poolElementArray.size();i++) {
+      sendASAPEndpointKeepAlive(poolElementArray[i], true);
+      startEndpointKeepAliveTimeoutTimer(poolElementArray[i]);
    }
 
    // ====== Inform other registrars of takeover ============================
@@ -1910,6 +2345,9 @@ void RegistrarProcess::shutdownService()
    cPeerListNode* node = PeerList->getFirstPeerListNode();
    while(node != NULL) {
       node->setStatus(node->getStatus() & ~(PLNS_LISTSYNC|PLNS_HTSYNC|PLNS_MENTOR));
+      node->HandlespaceVersion     = 0;
+      node->HandlespaceIncarnation = 0;
+      node->IncrementalSync        = false;
       if(node->LastHeardTimeoutTimer) {
          stopLastHeardTimeoutTimer(node);
       }
@@ -1942,6 +2380,12 @@ void RegistrarProcess::handleMessage(cMessage* msg)
    EV << Description << "Received message \"" << msg->getName()
       << "\" in state " << State.getStateName() << endl;
 
+   if(msg == MemoryUsageTimer) {
+      handleMemoryUsageTimer();
+      delete msg;
+      return;
+   }
+
    FSM_Switch(State) {
 
       // ====================================================================
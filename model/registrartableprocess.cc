@@ -57,7 +57,7 @@ Define_Module(RegistrarTableProcess);
 // ###### Initialize ########################################################
 void RegistrarTableProcess::initialize()
 {
-   RegistrarTable = new cPeerList(NULL, 0);
+   RegistrarTable = cPeerList::create(DEFAULT_HANDLESPACE_BACKEND, 0);
    OPP_CHECK(RegistrarTable);
 
    Description = format("RegistrarTableProcess at %u:%u> ",
@@ -0,0 +1,204 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef INTERNAL_POOLTEMPLATE
+#error Do not include this file directly, use poolhandlespacemanagement.h
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Handlespace partitioned into shards by pool handle hash. Each shard is
+   a handlespace management of its own, i.e. it has its own pool index,
+   timer, ownership and connection storages and allocator, protected by
+   its own lock. So, operations on pools of different shards may run in
+   parallel threads.
+
+   The single-call functions below lock the pool's shard (or, for
+   handlespace-wide operations, all shards in index order) for the
+   duration of the call, and have the same semantics as the
+   poolHandlespaceManagement functions of the same name. PE nodes
+   returned by them may only be used as long as no other thread changes
+   their pool; otherwise, the caller has to lock the shard by
+   shardedPoolHandlespaceManagementLockShard() and use the shard's
+   handlespace management directly.
+*/
+#define SHARDEDHANDLESPACE_MAX_SHARDS 64
+
+struct ST_CLASS(PoolHandlespaceManagementShard)
+{
+   struct ST_CLASS(PoolHandlespaceManagement) Management;
+   pthread_mutex_t                            Lock;
+};
+
+struct ST_CLASS(ShardedPoolHandlespaceManagement)
+{
+   size_t                                          Shards;
+   struct ST_CLASS(PoolHandlespaceManagementShard)* ShardArray;
+};
+
+
+/*
+   Iterator over the PEs of all shards, in the order of the unsharded
+   handlespace: by pool handle and PE identifier, optionally only over
+   the PEs owned by a given PR. All shards must be locked while using it.
+*/
+struct ST_CLASS(ShardedPoolElementIterator)
+{
+   struct ST_CLASS(ShardedPoolHandlespaceManagement)* ShardedHandlespace;
+   int                                                OwnedOnly;
+   RegistrarIdentifierType                            OwnerIdentifier;
+   struct ST_CLASS(PoolElementNode)*                  CursorArray[SHARDEDHANDLESPACE_MAX_SHARDS];
+};
+
+
+int ST_CLASS(shardedPoolHandlespaceManagementNew)(
+       struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+       const size_t                                       shards,
+       const RegistrarIdentifierType                      homeRegistrarIdentifier,
+       void (*poolNodeUserDataDisposer)(struct ST_CLASS(PoolNode)* poolElementNode,
+                                        void*                      userData),
+       void (*poolElementNodeUserDataDisposer)(struct ST_CLASS(PoolElementNode)* poolElementNode,
+                                               void*                             userData),
+       void* disposerUserData);
+void ST_CLASS(shardedPoolHandlespaceManagementDelete)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+void ST_CLASS(shardedPoolHandlespaceManagementClear)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+void ST_CLASS(shardedPoolHandlespaceManagementVerify)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+          const struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const struct PoolHandle*                                 poolHandle);
+struct ST_CLASS(PoolHandlespaceManagement)* ST_CLASS(shardedPoolHandlespaceManagementLockShard)(
+                                               struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                                               const size_t                                       shard);
+void ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const size_t                                       shard);
+void ST_CLASS(shardedPoolHandlespaceManagementLockAllShards)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+void ST_CLASS(shardedPoolHandlespaceManagementUnlockAllShards)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetPools)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetPoolElements)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+void ST_CLASS(shardedPoolHandlespaceManagementGetMemoryUsage)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        struct HandlespaceMemoryUsage*                     memoryUsage);
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetPoolElementsOfConnection)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const int                                          socketDescriptor,
+          const sctp_assoc_t                                 assocID);
+HandlespaceChecksumType ST_CLASS(shardedPoolHandlespaceManagementGetHandlespaceChecksum)(
+                           struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+HandlespaceChecksumType ST_CLASS(shardedPoolHandlespaceManagementGetOwnershipChecksum)(
+                           struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+void ST_CLASS(shardedPoolHandlespaceManagementGetOwnershipDigestTree)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const RegistrarIdentifierType                      registrarIdentifier,
+        HandlespaceChecksumType*                           digestArray);
+
+unsigned int ST_CLASS(shardedPoolHandlespaceManagementRegisterPoolElement)(
+                struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                const struct PoolHandle*                           poolHandle,
+                const RegistrarIdentifierType                      homeRegistrarIdentifier,
+                const PoolElementIdentifierType                    poolElementIdentifier,
+                const unsigned int                                 registrationLife,
+                const struct PoolPolicySettings*                   poolPolicySettings,
+                const struct TransportAddressBlock*                userTransport,
+                const struct TransportAddressBlock*                registratorTransport,
+                const int                                          connectionSocketDescriptor,
+                const sctp_assoc_t                                 connectionAssocID,
+                const unsigned long long                           currentTimeStamp,
+                struct ST_CLASS(PoolElementNode)**                 poolElementNode);
+unsigned int ST_CLASS(shardedPoolHandlespaceManagementDeregisterPoolElement)(
+                struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                const struct PoolHandle*                           poolHandle,
+                const PoolElementIdentifierType                    poolElementIdentifier);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(shardedPoolHandlespaceManagementFindPoolElement)(
+                                     struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                                     const struct PoolHandle*                           poolHandle,
+                                     const PoolElementIdentifierType                    poolElementIdentifier);
+unsigned int ST_CLASS(shardedPoolHandlespaceManagementHandleResolution)(
+                struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                const struct PoolHandle*                           poolHandle,
+                struct ST_CLASS(PoolElementNode)**                 poolElementNodeArray,
+                size_t*                                            poolElementNodes,
+                const size_t                                       maxHandleResolutionItems,
+                const size_t                                       maxIncrement);
+
+void ST_CLASS(shardedPoolHandlespaceManagementRestartPoolElementExpiryTimer)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        struct ST_CLASS(PoolElementNode)*                  poolElementNode,
+        const unsigned long long                           expiryTimeout);
+unsigned long long ST_CLASS(shardedPoolHandlespaceManagementGetNextTimerTimeStamp)(
+                      struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement);
+size_t ST_CLASS(shardedPoolHandlespaceManagementPurgeExpiredPoolElements)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const unsigned long long                           currentTimeStamp);
+
+void ST_CLASS(shardedPoolHandlespaceManagementMarkPoolElementNodes)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const RegistrarIdentifierType                      ownerID);
+size_t ST_CLASS(shardedPoolHandlespaceManagementPurgeMarkedPoolElementNodes)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const RegistrarIdentifierType                      ownerID);
+size_t ST_CLASS(shardedPoolHandlespaceManagementTransferOwnershipOfPoolElementNodes)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const RegistrarIdentifierType                      oldHomeRegistrarIdentifier,
+          const RegistrarIdentifierType                      newHomeRegistrarIdentifier);
+
+void ST_CLASS(shardedPoolElementIteratorNew)(
+        struct ST_CLASS(ShardedPoolElementIterator)*       shardedPoolElementIterator,
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const int                                          ownedOnly,
+        const RegistrarIdentifierType                      ownerIdentifier,
+        const struct PoolHandle*                           lastPoolHandle,
+        const PoolElementIdentifierType                    lastPoolElementIdentifier);
+struct ST_CLASS(PoolElementNode)* ST_CLASS(shardedPoolElementIteratorGetNext)(
+                                     struct ST_CLASS(ShardedPoolElementIterator)* shardedPoolElementIterator);
+
+int ST_CLASS(shardedPoolHandlespaceManagementGetHandleTable)(
+       struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+       const RegistrarIdentifierType                      homeRegistrarIdentifier,
+       struct ST_CLASS(HandleTableExtract)*               handleTableExtract,
+       const unsigned int                                 flags,
+       size_t                                             maxElements);
+
+
+#ifdef __cplusplus
+}
+#endif
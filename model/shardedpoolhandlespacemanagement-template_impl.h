@@ -0,0 +1,717 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef INTERNAL_POOLTEMPLATE
+#error Do not include this file directly, use poolhandlespacemanagement.h
+#endif
+
+
+/* ###### Initialize ##################################################### */
+/* Returns 0, if the shards could not be allocated. */
+int ST_CLASS(shardedPoolHandlespaceManagementNew)(
+       struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+       const size_t                                       shards,
+       const RegistrarIdentifierType                      homeRegistrarIdentifier,
+       void (*poolNodeUserDataDisposer)(struct ST_CLASS(PoolNode)* poolElementNode,
+                                        void*                      userData),
+       void (*poolElementNodeUserDataDisposer)(struct ST_CLASS(PoolElementNode)* poolElementNode,
+                                               void*                             userData),
+       void* disposerUserData)
+{
+   size_t i;
+
+   CHECK((shards >= 1) && (shards <= SHARDEDHANDLESPACE_MAX_SHARDS));
+   shardedPoolHandlespaceManagement->ShardArray =
+      (struct ST_CLASS(PoolHandlespaceManagementShard)*)malloc(
+         shards * sizeof(struct ST_CLASS(PoolHandlespaceManagementShard)));
+   if(shardedPoolHandlespaceManagement->ShardArray == NULL) {
+      shardedPoolHandlespaceManagement->Shards = 0;
+      return(0);
+   }
+   shardedPoolHandlespaceManagement->Shards = shards;
+   for(i = 0;i < shards;i++) {
+      ST_CLASS(poolHandlespaceManagementNew)(&shardedPoolHandlespaceManagement->ShardArray[i].Management,
+                                             homeRegistrarIdentifier,
+                                             poolNodeUserDataDisposer,
+                                             poolElementNodeUserDataDisposer,
+                                             disposerUserData);
+      pthread_mutex_init(&shardedPoolHandlespaceManagement->ShardArray[i].Lock, NULL);
+   }
+   return(1);
+}
+
+
+/* ###### Invalidate ##################################################### */
+void ST_CLASS(shardedPoolHandlespaceManagementDelete)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      ST_CLASS(poolHandlespaceManagementDelete)(&shardedPoolHandlespaceManagement->ShardArray[i].Management);
+      pthread_mutex_destroy(&shardedPoolHandlespaceManagement->ShardArray[i].Lock);
+   }
+   free(shardedPoolHandlespaceManagement->ShardArray);
+   shardedPoolHandlespaceManagement->ShardArray = NULL;
+   shardedPoolHandlespaceManagement->Shards     = 0;
+}
+
+
+/* ###### Get shard of pool ############################################## */
+/*
+   The shard only depends on the pool handle bytes, i.e. an interned
+   handle and a non-interned copy of it get the same shard.
+*/
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+          const struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const struct PoolHandle*                                 poolHandle)
+{
+   uint32_t hash = 2166136261U;   /* FNV-1a */
+   size_t   i;
+
+   for(i = 0;i < poolHandle->Size;i++) {
+      hash = (hash ^ poolHandle->Handle[i]) * 16777619U;
+   }
+   return((size_t)(hash % shardedPoolHandlespaceManagement->Shards));
+}
+
+
+/* ###### Lock shard and get its handlespace management ################## */
+struct ST_CLASS(PoolHandlespaceManagement)* ST_CLASS(shardedPoolHandlespaceManagementLockShard)(
+                                               struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                                               const size_t                                       shard)
+{
+   CHECK(shard < shardedPoolHandlespaceManagement->Shards);
+   pthread_mutex_lock(&shardedPoolHandlespaceManagement->ShardArray[shard].Lock);
+   return(&shardedPoolHandlespaceManagement->ShardArray[shard].Management);
+}
+
+
+/* ###### Unlock shard ################################################### */
+void ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const size_t                                       shard)
+{
+   pthread_mutex_unlock(&shardedPoolHandlespaceManagement->ShardArray[shard].Lock);
+}
+
+
+/* ###### Lock all shards ################################################ */
+/* Shards are always locked in index order, to avoid deadlocks. */
+void ST_CLASS(shardedPoolHandlespaceManagementLockAllShards)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      pthread_mutex_lock(&shardedPoolHandlespaceManagement->ShardArray[i].Lock);
+   }
+}
+
+
+/* ###### Unlock all shards ############################################## */
+void ST_CLASS(shardedPoolHandlespaceManagementUnlockAllShards)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   size_t i = shardedPoolHandlespaceManagement->Shards;
+
+   while(i > 0) {
+      pthread_mutex_unlock(&shardedPoolHandlespaceManagement->ShardArray[--i].Lock);
+   }
+}
+
+
+/* ###### Clear handlespace ############################################## */
+void ST_CLASS(shardedPoolHandlespaceManagementClear)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      ST_CLASS(poolHandlespaceManagementClear)(
+         ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i));
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+}
+
+
+/* ###### Verify structures ############################################## */
+void ST_CLASS(shardedPoolHandlespaceManagementVerify)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement;
+   struct ST_CLASS(PoolNode)*                  poolNode;
+   size_t                                      i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      poolHandlespaceManagement = ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i);
+      ST_CLASS(poolHandlespaceManagementVerify)(poolHandlespaceManagement);
+      poolNode = ST_CLASS(poolHandlespaceManagementGetFirstPoolNode)(poolHandlespaceManagement);
+      while(poolNode != NULL) {
+         CHECK(ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                  shardedPoolHandlespaceManagement, &poolNode->Handle) == i);
+         poolNode = ST_CLASS(poolHandlespaceManagementGetNextPoolNode)(poolHandlespaceManagement, poolNode);
+      }
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+}
+
+
+/* ###### Get number of pools ############################################ */
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetPools)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   size_t pools = 0;
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      pools += ST_CLASS(poolHandlespaceManagementGetPools)(
+                  ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i));
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(pools);
+}
+
+
+/* ###### Get number of pool elements #################################### */
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetPoolElements)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   size_t poolElements = 0;
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      poolElements += ST_CLASS(poolHandlespaceManagementGetPoolElements)(
+                         ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i));
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(poolElements);
+}
+
+
+/* ###### Get memory usage ############################################## */
+void ST_CLASS(shardedPoolHandlespaceManagementGetMemoryUsage)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        struct HandlespaceMemoryUsage*                     memoryUsage)
+{
+   struct HandlespaceMemoryUsage shardMemoryUsage;
+   size_t                        i;
+
+   handlespaceMemoryUsageClear(memoryUsage);
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      ST_CLASS(poolHandlespaceManagementGetMemoryUsage)(
+         ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i),
+         &shardMemoryUsage);
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+      handlespaceMemoryUsageAdd(memoryUsage, &shardMemoryUsage);
+
+      /* Lock of the shard; its management is counted above */
+      memoryUsage->Other += sizeof(struct ST_CLASS(PoolHandlespaceManagementShard)) -
+                               sizeof(struct ST_CLASS(PoolHandlespaceManagement));
+   }
+}
+
+
+/* ###### Get number of pool elements of connection ###################### */
+size_t ST_CLASS(shardedPoolHandlespaceManagementGetPoolElementsOfConnection)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const int                                          socketDescriptor,
+          const sctp_assoc_t                                 assocID)
+{
+   size_t poolElements = 0;
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      poolElements += ST_CLASS(poolHandlespaceManagementGetPoolElementsOfConnection)(
+                         ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i),
+                         socketDescriptor, assocID);
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(poolElements);
+}
+
+
+/* ###### Get handlespace checksum ####################################### */
+/* The checksums are sums, i.e. the shards' sums add up to the total. */
+HandlespaceChecksumType ST_CLASS(shardedPoolHandlespaceManagementGetHandlespaceChecksum)(
+                           struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   HandlespaceChecksumAccumulatorType checksum = INITIAL_HANDLESPACE_CHECKSUM;
+   size_t                             i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      checksum = handlespaceChecksumAdd(checksum,
+                    ST_CLASS(poolHandlespaceNodeGetHandlespaceChecksum)(
+                       &ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i)->Handlespace));
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(handlespaceChecksumFinish(checksum));
+}
+
+
+/* ###### Get ownership checksum ######################################### */
+HandlespaceChecksumType ST_CLASS(shardedPoolHandlespaceManagementGetOwnershipChecksum)(
+                           struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   HandlespaceChecksumAccumulatorType checksum = INITIAL_HANDLESPACE_CHECKSUM;
+   size_t                             i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      checksum = handlespaceChecksumAdd(checksum,
+                    ST_CLASS(poolHandlespaceNodeGetOwnershipChecksum)(
+                       &ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i)->Handlespace));
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(handlespaceChecksumFinish(checksum));
+}
+
+
+/* ###### Get ownership digest tree buckets of PR ######################## */
+void ST_CLASS(shardedPoolHandlespaceManagementGetOwnershipDigestTree)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const RegistrarIdentifierType                      registrarIdentifier,
+        HandlespaceChecksumType*                           digestArray)
+{
+   HandlespaceChecksumAccumulatorType          digestTree[HANDLESPACE_DIGEST_BUCKETS];
+   HandlespaceChecksumAccumulatorType          shardDigestTree[HANDLESPACE_DIGEST_BUCKETS];
+   struct ST_CLASS(PoolHandlespaceManagement)* poolHandlespaceManagement;
+   unsigned int                                bucket;
+   size_t                                      i;
+
+   for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+      digestTree[bucket] = INITIAL_HANDLESPACE_CHECKSUM;
+   }
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      poolHandlespaceManagement = ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i);
+      if(registrarIdentifier == poolHandlespaceManagement->Handlespace.HomeRegistrarIdentifier) {
+         for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+            digestTree[bucket] = handlespaceChecksumAdd(digestTree[bucket],
+                                    poolHandlespaceManagement->Handlespace.OwnershipDigestTree[bucket]);
+         }
+      }
+      else {
+         ST_CLASS(poolHandlespaceNodeComputeOwnershipDigestTree)(&poolHandlespaceManagement->Handlespace,
+                                                                 registrarIdentifier,
+                                                                 shardDigestTree);
+         for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+            digestTree[bucket] = handlespaceChecksumAdd(digestTree[bucket], shardDigestTree[bucket]);
+         }
+      }
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   for(bucket = 0;bucket < HANDLESPACE_DIGEST_BUCKETS;bucket++) {
+      digestArray[bucket] = handlespaceChecksumFinish(digestTree[bucket]);
+   }
+}
+
+
+/* ###### Registration ################################################### */
+unsigned int ST_CLASS(shardedPoolHandlespaceManagementRegisterPoolElement)(
+                struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                const struct PoolHandle*                           poolHandle,
+                const RegistrarIdentifierType                      homeRegistrarIdentifier,
+                const PoolElementIdentifierType                    poolElementIdentifier,
+                const unsigned int                                 registrationLife,
+                const struct PoolPolicySettings*                   poolPolicySettings,
+                const struct TransportAddressBlock*                userTransport,
+                const struct TransportAddressBlock*                registratorTransport,
+                const int                                          connectionSocketDescriptor,
+                const sctp_assoc_t                                 connectionAssocID,
+                const unsigned long long                           currentTimeStamp,
+                struct ST_CLASS(PoolElementNode)**                 poolElementNode)
+{
+   const size_t shard = ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                           shardedPoolHandlespaceManagement, poolHandle);
+   const unsigned int result = ST_CLASS(poolHandlespaceManagementRegisterPoolElement)(
+                                  ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, shard),
+                                  poolHandle, homeRegistrarIdentifier, poolElementIdentifier,
+                                  registrationLife, poolPolicySettings,
+                                  userTransport, registratorTransport,
+                                  connectionSocketDescriptor, connectionAssocID,
+                                  currentTimeStamp, poolElementNode);
+   ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, shard);
+   return(result);
+}
+
+
+/* ###### Deregistration ################################################# */
+unsigned int ST_CLASS(shardedPoolHandlespaceManagementDeregisterPoolElement)(
+                struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                const struct PoolHandle*                           poolHandle,
+                const PoolElementIdentifierType                    poolElementIdentifier)
+{
+   const size_t shard = ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                           shardedPoolHandlespaceManagement, poolHandle);
+   const unsigned int result = ST_CLASS(poolHandlespaceManagementDeregisterPoolElement)(
+                                  ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, shard),
+                                  poolHandle, poolElementIdentifier);
+   ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, shard);
+   return(result);
+}
+
+
+/* ###### Find pool element ############################################## */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(shardedPoolHandlespaceManagementFindPoolElement)(
+                                     struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                                     const struct PoolHandle*                           poolHandle,
+                                     const PoolElementIdentifierType                    poolElementIdentifier)
+{
+   const size_t shard = ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                           shardedPoolHandlespaceManagement, poolHandle);
+   struct ST_CLASS(PoolElementNode)* poolElementNode =
+      ST_CLASS(poolHandlespaceManagementFindPoolElement)(
+         ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, shard),
+         poolHandle, poolElementIdentifier);
+   ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, shard);
+   return(poolElementNode);
+}
+
+
+/* ###### Handle resolution ############################################## */
+unsigned int ST_CLASS(shardedPoolHandlespaceManagementHandleResolution)(
+                struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+                const struct PoolHandle*                           poolHandle,
+                struct ST_CLASS(PoolElementNode)**                 poolElementNodeArray,
+                size_t*                                            poolElementNodes,
+                const size_t                                       maxHandleResolutionItems,
+                const size_t                                       maxIncrement)
+{
+   const size_t shard = ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                           shardedPoolHandlespaceManagement, poolHandle);
+   const unsigned int result = ST_CLASS(poolHandlespaceManagementHandleResolution)(
+                                  ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, shard),
+                                  poolHandle, poolElementNodeArray, poolElementNodes,
+                                  maxHandleResolutionItems, maxIncrement);
+   ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, shard);
+   return(result);
+}
+
+
+/* ###### Restart PE expiry timer ######################################## */
+void ST_CLASS(shardedPoolHandlespaceManagementRestartPoolElementExpiryTimer)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        struct ST_CLASS(PoolElementNode)*                  poolElementNode,
+        const unsigned long long                           expiryTimeout)
+{
+   const size_t shard = ST_CLASS(shardedPoolHandlespaceManagementGetShardOfPool)(
+                           shardedPoolHandlespaceManagement, &poolElementNode->OwnerPoolNode->Handle);
+   ST_CLASS(poolHandlespaceManagementRestartPoolElementExpiryTimer)(
+      ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, shard),
+      poolElementNode, expiryTimeout);
+   ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, shard);
+}
+
+
+/* ###### Get next timer time stamp ###################################### */
+unsigned long long ST_CLASS(shardedPoolHandlespaceManagementGetNextTimerTimeStamp)(
+                      struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement)
+{
+   unsigned long long nextTimeStamp = ~0ULL;
+   unsigned long long timeStamp;
+   size_t             i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      timeStamp = ST_CLASS(poolHandlespaceManagementGetNextTimerTimeStamp)(
+                     ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i));
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+      if(timeStamp < nextTimeStamp) {
+         nextTimeStamp = timeStamp;
+      }
+   }
+   return(nextTimeStamp);
+}
+
+
+/* ###### Purge expired pool elements #################################### */
+size_t ST_CLASS(shardedPoolHandlespaceManagementPurgeExpiredPoolElements)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const unsigned long long                           currentTimeStamp)
+{
+   size_t purged = 0;
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      purged += ST_CLASS(poolHandlespaceManagementPurgeExpiredPoolElements)(
+                   ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i),
+                   currentTimeStamp);
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(purged);
+}
+
+
+/* ###### Mark pool element nodes owned by given PR ###################### */
+void ST_CLASS(shardedPoolHandlespaceManagementMarkPoolElementNodes)(
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const RegistrarIdentifierType                      ownerID)
+{
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      ST_CLASS(poolHandlespaceManagementMarkPoolElementNodes)(
+         ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i),
+         ownerID);
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+}
+
+
+/* ###### Purge marked pool element nodes owned by given PR ############## */
+size_t ST_CLASS(shardedPoolHandlespaceManagementPurgeMarkedPoolElementNodes)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const RegistrarIdentifierType                      ownerID)
+{
+   size_t purged = 0;
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      purged += ST_CLASS(poolHandlespaceManagementPurgeMarkedPoolElementNodes)(
+                   ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i),
+                   ownerID);
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(purged);
+}
+
+
+/* ###### Transfer ownership of all PEs of a PR ########################## */
+size_t ST_CLASS(shardedPoolHandlespaceManagementTransferOwnershipOfPoolElementNodes)(
+          struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+          const RegistrarIdentifierType                      oldHomeRegistrarIdentifier,
+          const RegistrarIdentifierType                      newHomeRegistrarIdentifier)
+{
+   size_t transferred = 0;
+   size_t i;
+
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      transferred += ST_CLASS(poolHandlespaceManagementTransferOwnershipOfPoolElementNodes)(
+                        ST_CLASS(shardedPoolHandlespaceManagementLockShard)(shardedPoolHandlespaceManagement, i),
+                        oldHomeRegistrarIdentifier, newHomeRegistrarIdentifier);
+      ST_CLASS(shardedPoolHandlespaceManagementUnlockShard)(shardedPoolHandlespaceManagement, i);
+   }
+   return(transferred);
+}
+
+
+/* ###### Get first PE of a shard after the given position ############### */
+/* The position is (pool handle, PE identifier); NULL handle: from the start */
+static struct ST_CLASS(PoolElementNode)* ST_CLASS(shardedPoolElementIteratorSeek)(
+                                            struct ST_CLASS(ShardedPoolElementIterator)* shardedPoolElementIterator,
+                                            struct ST_CLASS(PoolHandlespaceNode)*        poolHandlespaceNode,
+                                            const struct PoolHandle*                     lastPoolHandle,
+                                            const PoolElementIdentifierType              lastPoolElementIdentifier)
+{
+   struct ST_CLASS(PoolElementNode)* poolElementNode = NULL;
+   struct ST_CLASS(PoolNode)*        poolNode;
+
+   if(shardedPoolElementIterator->OwnedOnly) {
+      if(lastPoolHandle == NULL) {
+         return(ST_CLASS(poolHandlespaceNodeGetFirstPoolElementOwnershipNodeForIdentifier)(
+                   poolHandlespaceNode, shardedPoolElementIterator->OwnerIdentifier));
+      }
+      poolElementNode = ST_CLASS(poolHandlespaceNodeFindNearestNextPoolElementOwnershipNode)(
+                           poolHandlespaceNode, shardedPoolElementIterator->OwnerIdentifier,
+                           lastPoolHandle, lastPoolElementIdentifier);
+      if( (poolElementNode != NULL) &&
+          (poolElementNode->HomeRegistrarIdentifier != shardedPoolElementIterator->OwnerIdentifier) ) {
+         poolElementNode = NULL;
+      }
+      return(poolElementNode);
+   }
+
+   if(lastPoolHandle == NULL) {
+      poolNode = ST_CLASS(poolHandlespaceNodeGetFirstPoolNode)(poolHandlespaceNode);
+   }
+   else {
+      poolNode = ST_CLASS(poolHandlespaceNodeFindPoolNode)(poolHandlespaceNode, lastPoolHandle);
+      if(poolNode != NULL) {
+         poolElementNode = ST_CLASS(poolNodeFindNearestNextPoolElementNode)(poolNode, lastPoolElementIdentifier);
+         if(poolElementNode != NULL) {
+            return(poolElementNode);
+         }
+         poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode, poolNode);
+      }
+      else {
+         poolNode = ST_CLASS(poolHandlespaceNodeFindNearestNextPoolNode)(poolHandlespaceNode, lastPoolHandle);
+      }
+   }
+   if(poolNode != NULL) {
+      poolElementNode = ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+   }
+   return(poolElementNode);
+}
+
+
+/* ###### Initialize iterator ############################################ */
+/*
+   The iterator starts after the PE given by pool handle and identifier,
+   or at the beginning if lastPoolHandle is NULL.
+*/
+void ST_CLASS(shardedPoolElementIteratorNew)(
+        struct ST_CLASS(ShardedPoolElementIterator)*       shardedPoolElementIterator,
+        struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+        const int                                          ownedOnly,
+        const RegistrarIdentifierType                      ownerIdentifier,
+        const struct PoolHandle*                           lastPoolHandle,
+        const PoolElementIdentifierType                    lastPoolElementIdentifier)
+{
+   size_t i;
+
+   shardedPoolElementIterator->ShardedHandlespace = shardedPoolHandlespaceManagement;
+   shardedPoolElementIterator->OwnedOnly          = ownedOnly;
+   shardedPoolElementIterator->OwnerIdentifier    = ownerIdentifier;
+   for(i = 0;i < shardedPoolHandlespaceManagement->Shards;i++) {
+      shardedPoolElementIterator->CursorArray[i] = ST_CLASS(shardedPoolElementIteratorSeek)(
+         shardedPoolElementIterator,
+         &shardedPoolHandlespaceManagement->ShardArray[i].Management.Handlespace,
+         lastPoolHandle, lastPoolElementIdentifier);
+   }
+}
+
+
+/* ###### Compare PEs of different shards in iteration order ############# */
+static int ST_CLASS(shardedPoolElementIteratorComparison)(
+              const struct ST_CLASS(ShardedPoolElementIterator)* shardedPoolElementIterator,
+              const struct ST_CLASS(PoolElementNode)*            poolElementNode1,
+              const struct ST_CLASS(PoolElementNode)*            poolElementNode2)
+{
+   /* Same order as the storage iterated by the unsharded handlespace:
+      ownership storage (PE ID, pool handle) or pool index (pool handle,
+      PE ID). Shards have disjoint pools, so the pool handles differ. */
+   if(shardedPoolElementIterator->OwnedOnly) {
+      if(poolElementNode1->Identifier < poolElementNode2->Identifier) {
+         return(-1);
+      }
+      else if(poolElementNode1->Identifier > poolElementNode2->Identifier) {
+         return(1);
+      }
+   }
+   return(poolHandleComparison(&poolElementNode1->OwnerPoolNode->Handle,
+                               &poolElementNode2->OwnerPoolNode->Handle));
+}
+
+
+/* ###### Get next PE of iteration ####################################### */
+struct ST_CLASS(PoolElementNode)* ST_CLASS(shardedPoolElementIteratorGetNext)(
+                                     struct ST_CLASS(ShardedPoolElementIterator)* shardedPoolElementIterator)
+{
+   struct ST_CLASS(PoolHandlespaceNode)* poolHandlespaceNode;
+   struct ST_CLASS(PoolElementNode)*     poolElementNode = NULL;
+   struct ST_CLASS(PoolNode)*            poolNode;
+   size_t                                shard           = 0;
+   size_t                                i;
+
+   /* ====== Smallest cursor of all shards ================================ */
+   for(i = 0;i < shardedPoolElementIterator->ShardedHandlespace->Shards;i++) {
+      if( (shardedPoolElementIterator->CursorArray[i] != NULL) &&
+          ( (poolElementNode == NULL) ||
+            (ST_CLASS(shardedPoolElementIteratorComparison)(shardedPoolElementIterator,
+                                                            shardedPoolElementIterator->CursorArray[i],
+                                                            poolElementNode) < 0) ) ) {
+         poolElementNode = shardedPoolElementIterator->CursorArray[i];
+         shard           = i;
+      }
+   }
+   if(poolElementNode == NULL) {
+      return(NULL);
+   }
+
+   /* ====== Advance its cursor =========================================== */
+   poolHandlespaceNode = &shardedPoolElementIterator->ShardedHandlespace->ShardArray[shard].Management.Handlespace;
+   if(shardedPoolElementIterator->OwnedOnly) {
+      shardedPoolElementIterator->CursorArray[shard] =
+         ST_CLASS(poolHandlespaceNodeGetNextPoolElementOwnershipNodeForSameIdentifier)(
+            poolHandlespaceNode, poolElementNode);
+   }
+   else {
+      shardedPoolElementIterator->CursorArray[shard] =
+         ST_CLASS(poolNodeGetNextPoolElementNodeFromIndex)(poolElementNode->OwnerPoolNode, poolElementNode);
+      if(shardedPoolElementIterator->CursorArray[shard] == NULL) {
+         poolNode = ST_CLASS(poolHandlespaceNodeGetNextPoolNode)(poolHandlespaceNode,
+                                                                 poolElementNode->OwnerPoolNode);
+         if(poolNode != NULL) {
+            shardedPoolElementIterator->CursorArray[shard] =
+               ST_CLASS(poolNodeGetFirstPoolElementNodeFromIndex)(poolNode);
+         }
+      }
+   }
+   return(poolElementNode);
+}
+
+
+/* ###### Get name table from handlespace ################################ */
+/*
+   Like poolHandlespaceManagementGetHandleTable(): the extract has the
+   same contents as for an unsharded handlespace with the same PEs.
+   All shards are locked while it is filled.
+*/
+int ST_CLASS(shardedPoolHandlespaceManagementGetHandleTable)(
+       struct ST_CLASS(ShardedPoolHandlespaceManagement)* shardedPoolHandlespaceManagement,
+       const RegistrarIdentifierType                      homeRegistrarIdentifier,
+       struct ST_CLASS(HandleTableExtract)*               handleTableExtract,
+       const unsigned int                                 flags,
+       size_t                                             maxElements)
+{
+   struct ST_CLASS(ShardedPoolElementIterator) shardedPoolElementIterator;
+   struct ST_CLASS(PoolElementNode)*           poolElementNode;
+
+   if(maxElements > NTE_MAX_POOL_ELEMENT_NODES) {
+      maxElements = NTE_MAX_POOL_ELEMENT_NODES;
+   }
+   else if(maxElements < 1) {
+      return(0);
+   }
+   if(flags & HTEF_START) {
+      handleTableExtract->LastPoolElementIdentifier = 0;
+      handleTableExtract->LastPoolHandle.Size       = 0;
+   }
+
+   ST_CLASS(shardedPoolHandlespaceManagementLockAllShards)(shardedPoolHandlespaceManagement);
+   ST_CLASS(shardedPoolElementIteratorNew)(&shardedPoolElementIterator,
+                                           shardedPoolHandlespaceManagement,
+                                           (flags & HTEF_OWNCHILDSONLY) ? 1 : 0,
+                                           homeRegistrarIdentifier,
+                                           (flags & HTEF_START) ? NULL : &handleTableExtract->LastPoolHandle,
+                                           handleTableExtract->LastPoolElementIdentifier);
+   handleTableExtract->PoolElementNodes = 0;
+   while(handleTableExtract->PoolElementNodes < maxElements) {
+      poolElementNode = ST_CLASS(shardedPoolElementIteratorGetNext)(&shardedPoolElementIterator);
+      if(poolElementNode == NULL) {
+         break;
+      }
+      handleTableExtract->PoolElementNodeArray[handleTableExtract->PoolElementNodes++] = poolElementNode;
+   }
+   if(handleTableExtract->PoolElementNodes > 0) {
+      poolElementNode = handleTableExtract->PoolElementNodeArray[handleTableExtract->PoolElementNodes - 1];
+      handleTableExtract->LastPoolHandle            = poolElementNode->OwnerPoolNode->Handle;
+      handleTableExtract->LastPoolElementIdentifier = poolElementNode->Identifier;
+   }
+   ST_CLASS(shardedPoolHandlespaceManagementUnlockAllShards)(shardedPoolHandlespaceManagement);
+
+   return(handleTableExtract->PoolElementNodes > 0);
+}
@@ -0,0 +1,378 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include <string.h>
+#include <stdint.h>
+
+#include "slaballocator.h"
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define SLABALLOCATOR_ALIGN_TO(size, alignment) \
+   ((((size) + (alignment) - 1) / (alignment)) * (alignment))
+#define SLABALLOCATOR_ALIGN(size) SLABALLOCATOR_ALIGN_TO(size, SLABALLOCATOR_ALIGNMENT)
+
+
+/* ###### Initialize ##################################################### */
+void slabAllocatorNew(struct SlabAllocator* slabAllocator)
+{
+   slabAllocator->Classes          = 0;
+   slabAllocator->HeapObjectsInUse = 0;
+   slabAllocator->HeapAllocations  = 0;
+}
+
+
+/* ###### Invalidate ##################################################### */
+void slabAllocatorDelete(struct SlabAllocator* slabAllocator)
+{
+   struct SlabAllocatorClass* slabAllocatorClass;
+   struct SlabAllocatorSlab*  slab;
+   size_t                     i;
+
+   for(i = 0;i < slabAllocator->Classes;i++) {
+      slabAllocatorClass = &slabAllocator->Class[i];
+      CHECK(slabAllocatorClass->ObjectsInUse == 0);
+      while(slabAllocatorClass->SlabList != NULL) {
+         slab = slabAllocatorClass->SlabList;
+         slabAllocatorClass->SlabList = slab->Next;
+         free(slab);
+      }
+   }
+   CHECK(slabAllocator->HeapObjectsInUse == 0);
+   slabAllocatorNew(slabAllocator);
+}
+
+
+/* ###### Add size class ################################################# */
+int slabAllocatorAddClass(struct SlabAllocator* slabAllocator,
+                          const size_t          objectSize,
+                          const size_t          objectsPerSlab,
+                          const size_t          alignment)
+{
+   const size_t align = SLABALLOCATOR_ALIGN((alignment > 0) ? alignment : 1);
+   const size_t size  = SLABALLOCATOR_ALIGN_TO((objectSize >= sizeof(struct SlabAllocatorFreeObject)) ?
+                                                  objectSize : sizeof(struct SlabAllocatorFreeObject),
+                                               align);
+   size_t       i;
+
+   /* ====== Find position, classes are sorted by object size ============ */
+   for(i = 0;i < slabAllocator->Classes;i++) {
+      if(slabAllocator->Class[i].ObjectSize == size) {
+         /* There is already a class of this size */
+         if((slabAllocator->Class[i].Alignment < align) &&
+            (slabAllocator->Class[i].Slabs == 0)) {
+            slabAllocator->Class[i].Alignment = align;
+         }
+         return(slabAllocator->Class[i].Alignment >= align);
+      }
+      else if(slabAllocator->Class[i].ObjectSize > size) {
+         break;
+      }
+   }
+   if(slabAllocator->Classes >= SLABALLOCATOR_MAX_CLASSES) {
+      return(0);
+   }
+
+   /* ====== Insert new class ============================================ */
+   memmove(&slabAllocator->Class[i + 1], &slabAllocator->Class[i],
+           (slabAllocator->Classes - i) * sizeof(struct SlabAllocatorClass));
+   slabAllocator->Class[i].ObjectSize      = size;
+   slabAllocator->Class[i].Alignment       = align;
+   slabAllocator->Class[i].ObjectsPerSlab  = (objectsPerSlab > 0) ? objectsPerSlab :
+                                                SLABALLOCATOR_DEFAULT_OBJECTS_PER_SLAB;
+   slabAllocator->Class[i].NextObjectsPerSlab =
+      (slabAllocator->Class[i].ObjectsPerSlab < SLABALLOCATOR_FIRST_OBJECTS_PER_SLAB) ?
+         slabAllocator->Class[i].ObjectsPerSlab : SLABALLOCATOR_FIRST_OBJECTS_PER_SLAB;
+   slabAllocator->Class[i].SlabList        = NULL;
+   slabAllocator->Class[i].FreeList        = NULL;
+   slabAllocator->Class[i].Slabs           = 0;
+   slabAllocator->Class[i].Objects         = 0;
+   slabAllocator->Class[i].AllocatedBytes  = 0;
+   slabAllocator->Class[i].ObjectsInUse    = 0;
+   slabAllocator->Class[i].MaxObjectsInUse = 0;
+   slabAllocator->Class[i].Allocations     = 0;
+   slabAllocator->Classes++;
+   return(1);
+}
+
+
+/* ###### Get size of a slab ############################################# */
+inline static size_t slabAllocatorGetSlabSize(const struct SlabAllocatorClass* slabAllocatorClass,
+                                              const size_t                     objects)
+{
+   /* Header and padding, to align the object area at the class' alignment */
+   return(SLABALLOCATOR_ALIGN(sizeof(struct SlabAllocatorSlab)) +
+          slabAllocatorClass->Alignment +
+          (objects * slabAllocatorClass->ObjectSize));
+}
+
+
+/* ###### Get size class for given object size ########################### */
+inline static struct SlabAllocatorClass* slabAllocatorFindClass(
+                                            struct SlabAllocator* slabAllocator,
+                                            const size_t          size)
+{
+   size_t i;
+   for(i = 0;i < slabAllocator->Classes;i++) {
+      if(slabAllocator->Class[i].ObjectSize >= size) {
+         return(&slabAllocator->Class[i]);
+      }
+   }
+   return(NULL);
+}
+
+
+/* ###### Allocate new slab for size class ############################### */
+static int slabAllocatorGrowClass(struct SlabAllocatorClass* slabAllocatorClass)
+{
+   const size_t                    objects  = slabAllocatorClass->NextObjectsPerSlab;
+   const size_t                    slabSize = slabAllocatorGetSlabSize(slabAllocatorClass, objects);
+   struct SlabAllocatorSlab*       slab;
+   struct SlabAllocatorFreeObject* object;
+   char*                           objectArea;
+   size_t                          i;
+
+   slab = (struct SlabAllocatorSlab*)malloc(slabSize);
+   if(slab == NULL) {
+      return(0);
+   }
+   slab->Next                   = slabAllocatorClass->SlabList;
+   slab->Objects                = objects;
+   slabAllocatorClass->SlabList = slab;
+   slabAllocatorClass->Slabs++;
+   slabAllocatorClass->Objects        += objects;
+   slabAllocatorClass->AllocatedBytes += slabSize;
+
+   /* ====== Grow geometrically, up to ObjectsPerSlab ==================== */
+   slabAllocatorClass->NextObjectsPerSlab =
+      (2 * objects < slabAllocatorClass->ObjectsPerSlab) ?
+         2 * objects : slabAllocatorClass->ObjectsPerSlab;
+
+   /* ====== Put new objects into free list, lowest address first ======== */
+   objectArea = (char*)SLABALLOCATOR_ALIGN_TO((uintptr_t)slab + sizeof(struct SlabAllocatorSlab),
+                                              (uintptr_t)slabAllocatorClass->Alignment);
+   for(i = objects;i > 0;i--) {
+      object = (struct SlabAllocatorFreeObject*)(objectArea + ((i - 1) * slabAllocatorClass->ObjectSize));
+      object->Next                 = slabAllocatorClass->FreeList;
+      slabAllocatorClass->FreeList = object;
+   }
+   return(1);
+}
+
+
+/* ###### Allocate object ################################################ */
+void* slabAllocatorAllocate(struct SlabAllocator* slabAllocator,
+                            const size_t          size)
+{
+   struct SlabAllocatorClass*      slabAllocatorClass;
+   struct SlabAllocatorFreeObject* object;
+
+   slabAllocatorClass = slabAllocatorFindClass(slabAllocator, size);
+   if(slabAllocatorClass == NULL) {
+      object = (struct SlabAllocatorFreeObject*)malloc(size);
+      if(object != NULL) {
+         slabAllocator->HeapObjectsInUse++;
+         slabAllocator->HeapAllocations++;
+      }
+      return((void*)object);
+   }
+
+   if(slabAllocatorClass->FreeList == NULL) {
+      if(!slabAllocatorGrowClass(slabAllocatorClass)) {
+         return(NULL);
+      }
+   }
+   object = slabAllocatorClass->FreeList;
+   slabAllocatorClass->FreeList = object->Next;
+   slabAllocatorClass->ObjectsInUse++;
+   slabAllocatorClass->Allocations++;
+   if(slabAllocatorClass->ObjectsInUse > slabAllocatorClass->MaxObjectsInUse) {
+      slabAllocatorClass->MaxObjectsInUse = slabAllocatorClass->ObjectsInUse;
+   }
+   return((void*)object);
+}
+
+
+/* ###### Free object #################################################### */
+/*
+   The size must be the same as given to slabAllocatorAllocate().
+*/
+void slabAllocatorFree(struct SlabAllocator* slabAllocator,
+                       void*                 object,
+                       const size_t          size)
+{
+   struct SlabAllocatorClass*      slabAllocatorClass;
+   struct SlabAllocatorFreeObject* freeObject = (struct SlabAllocatorFreeObject*)object;
+
+   if(object != NULL) {
+      slabAllocatorClass = slabAllocatorFindClass(slabAllocator, size);
+      if(slabAllocatorClass == NULL) {
+         CHECK(slabAllocator->HeapObjectsInUse > 0);
+         slabAllocator->HeapObjectsInUse--;
+         free(object);
+      }
+      else {
+         CHECK(slabAllocatorClass->ObjectsInUse > 0);
+         slabAllocatorClass->ObjectsInUse--;
+         freeObject->Next             = slabAllocatorClass->FreeList;
+         slabAllocatorClass->FreeList = freeObject;
+      }
+   }
+}
+
+
+/* ###### Get fraction of slab objects in use ############################ */
+double slabAllocatorGetOccupancy(const struct SlabAllocatorClass* slabAllocatorClass)
+{
+   if(slabAllocatorClass->Objects == 0) {
+      return(0.0);
+   }
+   return((double)slabAllocatorClass->ObjectsInUse /
+             (double)slabAllocatorClass->Objects);
+}
+
+
+/* ###### Get number of bytes allocated for slabs ######################## */
+size_t slabAllocatorGetAllocatedBytes(const struct SlabAllocator* slabAllocator)
+{
+   size_t bytes = 0;
+   size_t i;
+
+   for(i = 0;i < slabAllocator->Classes;i++) {
+      bytes += slabAllocator->Class[i].AllocatedBytes;
+   }
+   return(bytes);
+}
+
+
+/* ###### Get textual description ######################################## */
+void slabAllocatorGetDescription(const struct SlabAllocator* slabAllocator,
+                                 char*                       buffer,
+                                 const size_t                bufferSize)
+{
+   size_t objectsInUse = 0;
+   size_t slabs        = 0;
+   size_t i;
+
+   for(i = 0;i < slabAllocator->Classes;i++) {
+      objectsInUse += slabAllocator->Class[i].ObjectsInUse;
+      slabs        += slabAllocator->Class[i].Slabs;
+   }
+   snprintf(buffer, bufferSize,
+            "SlabAllocator: (%u Classes, %u Slabs, %u Bytes, %u Objects in Use, %u Heap Objects)",
+            (unsigned int)slabAllocator->Classes,
+            (unsigned int)slabs,
+            (unsigned int)slabAllocatorGetAllocatedBytes(slabAllocator),
+            (unsigned int)objectsInUse,
+            (unsigned int)slabAllocator->HeapObjectsInUse);
+}
+
+
+/* ###### Print ########################################################## */
+void slabAllocatorPrint(const struct SlabAllocator* slabAllocator,
+                        FILE*                       fd)
+{
+   const struct SlabAllocatorClass* slabAllocatorClass;
+   char                             slabAllocatorDescription[256];
+   size_t                           i;
+
+   slabAllocatorGetDescription(slabAllocator,
+                               (char*)&slabAllocatorDescription,
+                               sizeof(slabAllocatorDescription));
+   fputs(slabAllocatorDescription, fd);
+   fputs("\n", fd);
+   for(i = 0;i < slabAllocator->Classes;i++) {
+      slabAllocatorClass = &slabAllocator->Class[i];
+      fprintf(fd, " - size=%u slabs=%u inUse=%u/%u (%1.1f%%) maxInUse=%u allocs=%llu\n",
+              (unsigned int)slabAllocatorClass->ObjectSize,
+              (unsigned int)slabAllocatorClass->Slabs,
+              (unsigned int)slabAllocatorClass->ObjectsInUse,
+              (unsigned int)slabAllocatorClass->Objects,
+              100.0 * slabAllocatorGetOccupancy(slabAllocatorClass),
+              (unsigned int)slabAllocatorClass->MaxObjectsInUse,
+              slabAllocatorClass->Allocations);
+   }
+   fprintf(fd, " - heap: inUse=%u allocs=%llu\n",
+           (unsigned int)slabAllocator->HeapObjectsInUse,
+           slabAllocator->HeapAllocations);
+}
+
+
+/* ###### Verify structures ############################################## */
+void slabAllocatorVerify(const struct SlabAllocator* slabAllocator)
+{
+   const struct SlabAllocatorClass*      slabAllocatorClass;
+   const struct SlabAllocatorSlab*       slab;
+   const struct SlabAllocatorFreeObject* object;
+   size_t                                slabs;
+   size_t                                objects;
+   size_t                                allocatedBytes;
+   size_t                                freeObjects;
+   size_t                                i;
+
+   CHECK(slabAllocator->Classes <= SLABALLOCATOR_MAX_CLASSES);
+   for(i = 0;i < slabAllocator->Classes;i++) {
+      slabAllocatorClass = &slabAllocator->Class[i];
+      if(i > 0) {
+         CHECK(slabAllocator->Class[i - 1].ObjectSize < slabAllocatorClass->ObjectSize);
+      }
+      CHECK(slabAllocatorClass->ObjectSize % slabAllocatorClass->Alignment == 0);
+      CHECK(slabAllocatorClass->ObjectsInUse <= slabAllocatorClass->MaxObjectsInUse);
+
+      CHECK(slabAllocatorClass->NextObjectsPerSlab <= slabAllocatorClass->ObjectsPerSlab);
+      slabs          = 0;
+      objects        = 0;
+      allocatedBytes = 0;
+      for(slab = slabAllocatorClass->SlabList;slab != NULL;slab = slab->Next) {
+         CHECK(slab->Objects <= slabAllocatorClass->ObjectsPerSlab);
+         slabs++;
+         objects        += slab->Objects;
+         allocatedBytes += slabAllocatorGetSlabSize(slabAllocatorClass, slab->Objects);
+      }
+      CHECK(slabs == slabAllocatorClass->Slabs);
+      CHECK(objects == slabAllocatorClass->Objects);
+      CHECK(allocatedBytes == slabAllocatorClass->AllocatedBytes);
+
+      freeObjects = 0;
+      for(object = slabAllocatorClass->FreeList;object != NULL;object = object->Next) {
+         CHECK((uintptr_t)object % slabAllocatorClass->Alignment == 0);
+         freeObjects++;
+      }
+      CHECK(freeObjects + slabAllocatorClass->ObjectsInUse == slabAllocatorClass->Objects);
+   }
+}
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,134 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef SLABALLOCATOR_H
+#define SLABALLOCATOR_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Allocator for small fixed-size objects. Each size class hands out
+   objects from slabs allocated from the heap on demand. The first slab
+   of a class holds SLABALLOCATOR_FIRST_OBJECTS_PER_SLAB objects, each
+   further one twice as many as the previous one, up to ObjectsPerSlab.
+   Small handlespaces, like the PU caches, therefore do not reserve
+   whole slabs of large nodes. Objects are aligned to the class'
+   alignment, which is at least SLABALLOCATOR_ALIGNMENT. Freed objects
+   are kept on a per-class free list for reuse; slabs are only returned
+   to the heap by slabAllocatorDelete(). Requests larger than the
+   largest size class are passed to malloc().
+*/
+#define SLABALLOCATOR_MAX_CLASSES              8
+#define SLABALLOCATOR_FIRST_OBJECTS_PER_SLAB   2
+#define SLABALLOCATOR_DEFAULT_OBJECTS_PER_SLAB 64
+#define SLABALLOCATOR_ALIGNMENT                16
+
+
+struct SlabAllocatorFreeObject
+{
+   struct SlabAllocatorFreeObject* Next;
+};
+
+struct SlabAllocatorSlab
+{
+   struct SlabAllocatorSlab* Next;
+   size_t                    Objects;
+};
+
+struct SlabAllocatorClass
+{
+   size_t                          ObjectSize;
+   size_t                          Alignment;
+   size_t                          ObjectsPerSlab;       /* Maximum       */
+   size_t                          NextObjectsPerSlab;   /* For next slab */
+   struct SlabAllocatorSlab*       SlabList;
+   struct SlabAllocatorFreeObject* FreeList;
+
+   size_t                          Slabs;
+   size_t                          Objects;
+   size_t                          AllocatedBytes;
+   size_t                          ObjectsInUse;
+   size_t                          MaxObjectsInUse;
+   unsigned long long              Allocations;
+};
+
+struct SlabAllocator
+{
+   struct SlabAllocatorClass Class[SLABALLOCATOR_MAX_CLASSES];
+   size_t                    Classes;
+
+   size_t                    HeapObjectsInUse;
+   unsigned long long        HeapAllocations;
+};
+
+
+void slabAllocatorNew(struct SlabAllocator* slabAllocator);
+void slabAllocatorDelete(struct SlabAllocator* slabAllocator);
+int slabAllocatorAddClass(struct SlabAllocator* slabAllocator,
+                          const size_t          objectSize,
+                          const size_t          objectsPerSlab,
+                          const size_t          alignment);
+void* slabAllocatorAllocate(struct SlabAllocator* slabAllocator,
+                            const size_t          size);
+void slabAllocatorFree(struct SlabAllocator* slabAllocator,
+                       void*                 object,
+                       const size_t          size);
+double slabAllocatorGetOccupancy(const struct SlabAllocatorClass* slabAllocatorClass);
+size_t slabAllocatorGetAllocatedBytes(const struct SlabAllocator* slabAllocator);
+void slabAllocatorGetDescription(const struct SlabAllocator* slabAllocator,
+                                 char*                       buffer,
+                                 const size_t                bufferSize);
+void slabAllocatorPrint(const struct SlabAllocator* slabAllocator,
+                        FILE*                       fd);
+void slabAllocatorVerify(const struct SlabAllocator* slabAllocator);
+
+inline static size_t slabAllocatorGetClasses(const struct SlabAllocator* slabAllocator)
+{
+   return(slabAllocator->Classes);
+}
+
+inline static const struct SlabAllocatorClass* slabAllocatorGetClass(
+                                                  const struct SlabAllocator* slabAllocator,
+                                                  const size_t                index)
+{
+   return(&slabAllocator->Class[index]);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -31,29 +31,28 @@
 
 /* ###### Constructor #################################################### */
 struct TakeoverProcess* takeoverProcessNew(
-                           const RegistrarIdentifierType        targetID,
-                           struct ST_CLASS(PeerListManagement)* peerList)
+                           const RegistrarIdentifierType  targetID,
+                           const RegistrarIdentifierType  ownIdentifier,
+                           const RegistrarIdentifierType* peerIDArray,
+                           const size_t                   peers)
 {
-   struct TakeoverProcess*        takeoverProcess;
-   struct ST_CLASS(PeerListNode)* peerListNode;
-   const size_t                   peers = ST_CLASS(peerListManagementGetPeers)(peerList);
+   struct TakeoverProcess* takeoverProcess;
+   size_t                  i;
 
    CHECK(targetID != 0);
-   CHECK(targetID != peerList->List.OwnIdentifier);
+   CHECK(targetID != ownIdentifier);
 
    takeoverProcess = (struct TakeoverProcess*)malloc(sizeof(struct TakeoverProcess) +
                                                      sizeof(RegistrarIdentifierType) * peers);
    if(takeoverProcess != NULL) {
       takeoverProcess->OutstandingAcks = 0;
-      peerListNode = ST_CLASS(peerListGetFirstPeerListNodeFromIndexStorage)(&peerList->List);
-      while(peerListNode != NULL) {
-         if((peerListNode->Identifier != targetID) &&
-            (peerListNode->Identifier != peerList->List.OwnIdentifier) &&
-            (peerListNode->Identifier != 0)) {
+      for(i = 0;i < peers;i++) {
+         if((peerIDArray[i] != targetID) &&
+            (peerIDArray[i] != ownIdentifier) &&
+            (peerIDArray[i] != 0)) {
             takeoverProcess->PeerIDArray[takeoverProcess->OutstandingAcks++] =
-               peerListNode->Identifier;
+               peerIDArray[i];
          }
-         peerListNode = ST_CLASS(peerListGetNextPeerListNodeFromIndexStorage)(&peerList->List, peerListNode);
       }
    }
 
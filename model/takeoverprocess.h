@@ -44,8 +44,10 @@ struct TakeoverProcess
 
 
 struct TakeoverProcess* takeoverProcessNew(
-                           const RegistrarIdentifierType        targetID,
-                           struct ST_CLASS(PeerListManagement)* peerList);
+                           const RegistrarIdentifierType  targetID,
+                           const RegistrarIdentifierType  ownIdentifier,
+                           const RegistrarIdentifierType* peerIDArray,
+                           const size_t                   peers);
 void takeoverProcessDelete(struct TakeoverProcess* takeoverProcess);
 
 size_t takeoverProcessGetOutstandingAcks(const struct TakeoverProcess* takeoverProcess);
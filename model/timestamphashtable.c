@@ -149,3 +149,14 @@ double timeStampHashTableGetRate(const struct TimeStampHashTable* timeStampHashT
    }
    return(0.0);
 }
+
+
+/* ###### Get number of bytes allocated for the hash table ############### */
+size_t timeStampHashTableGetMemoryUsage(const struct TimeStampHashTable* timeStampHashTable)
+{
+   return(sizeof(struct TimeStampHashTable) +
+          timeStampHashTable->Buckets * (sizeof(timeStampHashTable->BucketArray[0]) +
+                                         sizeof(struct TimeStampBucket) +
+                                         (timeStampHashTable->MaxEntries *
+                                            sizeof(timeStampHashTable->BucketArray[0]->TimeStamp[0]))));
+}
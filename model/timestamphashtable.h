@@ -64,6 +64,7 @@ bool timeStampHashTableAddTimeStamp(struct TimeStampHashTable* timeStampHashTabl
                                     const unsigned long long   newTimeStamp);
 double timeStampHashTableGetRate(const struct TimeStampHashTable* timeStampHashTable,
                                  const unsigned long              hashValue);
+size_t timeStampHashTableGetMemoryUsage(const struct TimeStampHashTable* timeStampHashTable);
 
 
 #ifdef __cplusplus
@@ -0,0 +1,431 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#include "timingwheel.h"
+#include "debug.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define TIMINGWHEEL_SLOTMASK  ((unsigned long long)(TIMINGWHEEL_SLOTS - 1))
+
+
+/* ###### Get index of lowest set bit ##################################### */
+inline static unsigned int timingWheelLowestBit(const uint64_t bits)
+{
+#if defined(__GNUC__)
+   return((unsigned int)__builtin_ctzll(bits));
+#else
+   unsigned int i = 0;
+   while(!(bits & ((uint64_t)1 << i))) {
+      i++;
+   }
+   return(i);
+#endif
+}
+
+
+/* ###### Check, if list is empty ######################################### */
+inline static int timingWheelListIsEmpty(const struct DoubleLinkedRingList* list)
+{
+   return(list->Node.Next == &list->Node);
+}
+
+
+/* ###### Get slot index of tick on given level ########################### */
+inline static unsigned int timingWheelSlotOf(const unsigned long long tick,
+                                             const unsigned int       level)
+{
+   return((unsigned int)((tick >> (TIMINGWHEEL_SLOTBITS * level)) & TIMINGWHEEL_SLOTMASK));
+}
+
+
+/* ###### Check, if ticks are in same window of given level ############### */
+inline static int timingWheelSameWindow(const unsigned long long tick1,
+                                        const unsigned long long tick2,
+                                        const unsigned int       level)
+{
+   return((tick1 >> (TIMINGWHEEL_SLOTBITS * (level + 1))) ==
+          (tick2 >> (TIMINGWHEEL_SLOTBITS * (level + 1))));
+}
+
+
+/* ###### Initialize ###################################################### */
+void timingWheelNodeNew(struct TimingWheelNode* node)
+{
+   doubleLinkedRingListNodeNew(&node->ListNode);
+   node->Tick     = 0;
+   node->Location = TIMINGWHEEL_NOT_LINKED;
+}
+
+
+/* ###### Invalidate ###################################################### */
+void timingWheelNodeDelete(struct TimingWheelNode* node)
+{
+   CHECK(node->Location == TIMINGWHEEL_NOT_LINKED);
+   doubleLinkedRingListNodeDelete(&node->ListNode);
+   node->Tick = 0;
+}
+
+
+/* ###### Check, if node is linked into a wheel ########################### */
+int timingWheelNodeIsLinked(const struct TimingWheelNode* node)
+{
+   return(node->Location != TIMINGWHEEL_NOT_LINKED);
+}
+
+
+/* ###### Initialize ###################################################### */
+void timingWheelNew(struct TimingWheel*      timingWheel,
+                    const unsigned long long granularity)
+{
+   unsigned int level;
+   unsigned int slot;
+
+   CHECK(granularity > 0);
+   for(level = 0;level < TIMINGWHEEL_LEVELS;level++) {
+      for(slot = 0;slot < TIMINGWHEEL_SLOTS;slot++) {
+         doubleLinkedRingListNew(&timingWheel->Slot[level][slot]);
+      }
+      timingWheel->Occupied[level] = 0;
+   }
+   doubleLinkedRingListNew(&timingWheel->Overflow);
+   timingWheel->Granularity = granularity;
+   timingWheel->Horizon     = 0;
+   timingWheel->Elements    = 0;
+}
+
+
+/* ###### Invalidate ###################################################### */
+void timingWheelDelete(struct TimingWheel* timingWheel)
+{
+   unsigned int level;
+   unsigned int slot;
+
+   CHECK(timingWheel->Elements == 0);
+   for(level = 0;level < TIMINGWHEEL_LEVELS;level++) {
+      for(slot = 0;slot < TIMINGWHEEL_SLOTS;slot++) {
+         doubleLinkedRingListDelete(&timingWheel->Slot[level][slot]);
+      }
+      timingWheel->Occupied[level] = 0;
+   }
+   doubleLinkedRingListDelete(&timingWheel->Overflow);
+   timingWheel->Horizon = 0;
+}
+
+
+/* ###### Check, if time stamp is behind the horizon ###################### */
+int timingWheelAccepts(const struct TimingWheel* timingWheel,
+                       const unsigned long long  timeStamp)
+{
+   return(timeStamp / timingWheel->Granularity >= timingWheel->Horizon);
+}
+
+
+/* ###### Link node into level slot or overflow list ###################### */
+static void timingWheelPlace(struct TimingWheel*     timingWheel,
+                             struct TimingWheelNode* node)
+{
+   unsigned int level;
+   unsigned int slot;
+
+   for(level = 0;level < TIMINGWHEEL_LEVELS;level++) {
+      if(timingWheelSameWindow(node->Tick, timingWheel->Horizon, level)) {
+         slot = timingWheelSlotOf(node->Tick, level);
+         doubleLinkedRingListAddTail(&timingWheel->Slot[level][slot], &node->ListNode);
+         timingWheel->Occupied[level] |= (uint64_t)1 << slot;
+         node->Location = TIMINGWHEEL_FIRST_SLOT + (level * TIMINGWHEEL_SLOTS) + slot;
+         return;
+      }
+   }
+   doubleLinkedRingListAddTail(&timingWheel->Overflow, &node->ListNode);
+   node->Location = TIMINGWHEEL_OVERFLOW;
+}
+
+
+/* ###### Re-place all nodes of a list #################################### */
+static void timingWheelCascade(struct TimingWheel*          timingWheel,
+                               struct DoubleLinkedRingList* list)
+{
+   struct DoubleLinkedRingList      pending;
+   struct DoubleLinkedRingListNode* listNode;
+
+   /* Unlink first: nodes may be re-placed into the list being cascaded
+      (only possible for the overflow list). */
+   doubleLinkedRingListNew(&pending);
+   while(!timingWheelListIsEmpty(list)) {
+      listNode = list->Node.Next;
+      doubleLinkedRingListRemNode(listNode);
+      doubleLinkedRingListAddTail(&pending, listNode);
+   }
+   while(!timingWheelListIsEmpty(&pending)) {
+      listNode = pending.Node.Next;
+      doubleLinkedRingListRemNode(listNode);
+      timingWheelPlace(timingWheel, (struct TimingWheelNode*)listNode);
+   }
+   doubleLinkedRingListDelete(&pending);
+}
+
+
+/* ###### Move horizon forward and cascade the now-current slots ######### */
+static void timingWheelSetHorizon(struct TimingWheel*      timingWheel,
+                                  const unsigned long long horizon)
+{
+   const unsigned long long oldHorizon = timingWheel->Horizon;
+   unsigned int             level;
+   unsigned int             slot;
+
+   CHECK(horizon >= oldHorizon);
+   timingWheel->Horizon = horizon;
+
+   /* ====== Top window changed: pull in overflow timers ================= */
+   if(!timingWheelSameWindow(oldHorizon, horizon, TIMINGWHEEL_LEVELS - 1)) {
+      timingWheelCascade(timingWheel, &timingWheel->Overflow);
+   }
+
+   /* ====== Distribute the current slot of each upper level ============= */
+   /* Re-placed nodes never land in the current slot of a level >= 1, so
+      the order of levels does not matter here. */
+   for(level = TIMINGWHEEL_LEVELS - 1;level >= 1;level--) {
+      slot = timingWheelSlotOf(horizon, level);
+      if(timingWheel->Occupied[level] & ((uint64_t)1 << slot)) {
+         timingWheel->Occupied[level] &= ~((uint64_t)1 << slot);
+         timingWheelCascade(timingWheel, &timingWheel->Slot[level][slot]);
+      }
+   }
+}
+
+
+/* ###### Insert node ##################################################### */
+void timingWheelInsert(struct TimingWheel*      timingWheel,
+                       struct TimingWheelNode*  node,
+                       const unsigned long long timeStamp)
+{
+   CHECK(node->Location == TIMINGWHEEL_NOT_LINKED);
+   node->Tick = timeStamp / timingWheel->Granularity;
+   CHECK(node->Tick >= timingWheel->Horizon);
+   timingWheelPlace(timingWheel, node);
+   timingWheel->Elements++;
+}
+
+
+/* ###### Remove node ##################################################### */
+void timingWheelRemove(struct TimingWheel*     timingWheel,
+                       struct TimingWheelNode* node)
+{
+   unsigned int level;
+   unsigned int slot;
+
+   CHECK(node->Location != TIMINGWHEEL_NOT_LINKED);
+   CHECK(timingWheel->Elements > 0);
+   doubleLinkedRingListRemNode(&node->ListNode);
+   if(node->Location >= TIMINGWHEEL_FIRST_SLOT) {
+      level = (node->Location - TIMINGWHEEL_FIRST_SLOT) / TIMINGWHEEL_SLOTS;
+      slot  = (node->Location - TIMINGWHEEL_FIRST_SLOT) % TIMINGWHEEL_SLOTS;
+      if(timingWheelListIsEmpty(&timingWheel->Slot[level][slot])) {
+         timingWheel->Occupied[level] &= ~((uint64_t)1 << slot);
+      }
+   }
+   node->Location = TIMINGWHEEL_NOT_LINKED;
+   timingWheel->Elements--;
+}
+
+
+/* ###### Find the next occupied tick #################################### */
+/*
+   Cascades the upper levels until the next occupied tick is in level 0.
+   Returns the slot of this tick, or -1 if the wheel is empty.
+*/
+static int timingWheelFindNextTick(struct TimingWheel* timingWheel)
+{
+   struct DoubleLinkedRingListNode* listNode;
+   struct TimingWheelNode*          node;
+   unsigned long long               horizon;
+   unsigned int                     level;
+   unsigned int                     slot;
+
+   if(timingWheel->Elements == 0) {
+      return(-1);
+   }
+
+   for(;;) {
+      /* ====== Level 0 slots are single ticks ============================ */
+      if(timingWheel->Occupied[0] != 0) {
+         return((int)timingWheelLowestBit(timingWheel->Occupied[0]));
+      }
+
+      /* ====== Jump to the first occupied slot of the upper levels ======= */
+      for(level = 1;level < TIMINGWHEEL_LEVELS;level++) {
+         if(timingWheel->Occupied[level] != 0) {
+            slot    = timingWheelLowestBit(timingWheel->Occupied[level]);
+            horizon = ((timingWheel->Horizon >> (TIMINGWHEEL_SLOTBITS * (level + 1)))
+                          << (TIMINGWHEEL_SLOTBITS * (level + 1))) |
+                      ((unsigned long long)slot << (TIMINGWHEEL_SLOTBITS * level));
+            timingWheelSetHorizon(timingWheel, horizon);
+            break;
+         }
+      }
+
+      /* ====== Jump to the earliest overflow timer ======================= */
+      if(level >= TIMINGWHEEL_LEVELS) {
+         CHECK(!timingWheelListIsEmpty(&timingWheel->Overflow));
+         listNode = timingWheel->Overflow.Node.Next;
+         horizon  = ((struct TimingWheelNode*)listNode)->Tick;
+         while(listNode != &timingWheel->Overflow.Node) {
+            node = (struct TimingWheelNode*)listNode;
+            if(node->Tick < horizon) {
+               horizon = node->Tick;
+            }
+            listNode = listNode->Next;
+         }
+         timingWheelSetHorizon(timingWheel, horizon);
+      }
+   }
+}
+
+
+/* ###### Move all nodes of given level 0 slot into given list ########### */
+static size_t timingWheelTakeTick(struct TimingWheel*          timingWheel,
+                                  const unsigned int           slot,
+                                  struct DoubleLinkedRingList* dueList)
+{
+   struct DoubleLinkedRingList*     list = &timingWheel->Slot[0][slot];
+   struct DoubleLinkedRingListNode* listNode;
+   struct TimingWheelNode*          node;
+   const unsigned long long         tick = ((timingWheel->Horizon >> TIMINGWHEEL_SLOTBITS) << TIMINGWHEEL_SLOTBITS) | slot;
+   size_t                           count = 0;
+
+   while(!timingWheelListIsEmpty(list)) {
+      listNode = list->Node.Next;
+      node = (struct TimingWheelNode*)listNode;
+      CHECK(node->Tick == tick);
+      doubleLinkedRingListRemNode(listNode);
+      node->Location = TIMINGWHEEL_NOT_LINKED;
+      doubleLinkedRingListAddTail(dueList, listNode);
+      count++;
+   }
+   timingWheel->Occupied[0] &= ~((uint64_t)1 << slot);
+   timingWheel->Elements -= count;
+   timingWheelSetHorizon(timingWheel, tick + 1);
+   return(count);
+}
+
+
+/* ###### Move all nodes of the next tick into given list ################# */
+size_t timingWheelAdvance(struct TimingWheel*          timingWheel,
+                          struct DoubleLinkedRingList* dueList)
+{
+   const int slot = timingWheelFindNextTick(timingWheel);
+   if(slot < 0) {
+      return(0);
+   }
+   return(timingWheelTakeTick(timingWheel, (unsigned int)slot, dueList));
+}
+
+
+/* ###### Move all nodes of the expired ticks into given list ############# */
+/*
+   Moves the nodes of all ticks which are entirely at or before timeStamp
+   into dueList, tick by tick; within a tick, in insertion order. Nodes of
+   the tick containing timeStamp remain in the wheel, since some of them
+   may not have expired yet.
+*/
+size_t timingWheelAdvanceExpired(struct TimingWheel*          timingWheel,
+                                 struct DoubleLinkedRingList* dueList,
+                                 const unsigned long long     timeStamp)
+{
+   const unsigned long long lastTick = timeStamp / timingWheel->Granularity;
+   const int                lastTickExpired =
+      (timeStamp % timingWheel->Granularity == timingWheel->Granularity - 1);
+   unsigned long long       tick;
+   size_t                   count = 0;
+   int                      slot;
+
+   while(timingWheel->Elements > 0) {
+      /* Do not cascade timers behind timeStamp into level 0 */
+      if((timingWheel->Horizon > lastTick) ||
+         ((timingWheel->Horizon == lastTick) && (!lastTickExpired))) {
+         break;
+      }
+      slot = timingWheelFindNextTick(timingWheel);
+      CHECK(slot >= 0);
+      tick = ((timingWheel->Horizon >> TIMINGWHEEL_SLOTBITS) << TIMINGWHEEL_SLOTBITS) | (unsigned int)slot;
+      if((tick > lastTick) || ((tick == lastTick) && (!lastTickExpired))) {
+         break;
+      }
+      count += timingWheelTakeTick(timingWheel, (unsigned int)slot, dueList);
+   }
+   return(count);
+}
+
+
+/* ###### Verify structure ################################################ */
+void timingWheelVerify(const struct TimingWheel* timingWheel)
+{
+   const struct DoubleLinkedRingListNode* listNode;
+   const struct TimingWheelNode*          node;
+   unsigned int                           level;
+   unsigned int                           slot;
+   size_t                                 elements = 0;
+
+   for(level = 0;level < TIMINGWHEEL_LEVELS;level++) {
+      for(slot = 0;slot < TIMINGWHEEL_SLOTS;slot++) {
+         const struct DoubleLinkedRingList* list = &timingWheel->Slot[level][slot];
+         CHECK(((timingWheel->Occupied[level] & ((uint64_t)1 << slot)) != 0) ==
+               !timingWheelListIsEmpty(list));
+         for(listNode = list->Node.Next;listNode != &list->Node;listNode = listNode->Next) {
+            node = (const struct TimingWheelNode*)listNode;
+            CHECK(listNode->Next->Prev == listNode);
+            CHECK(node->Location == TIMINGWHEEL_FIRST_SLOT + (level * TIMINGWHEEL_SLOTS) + slot);
+            CHECK(node->Tick >= timingWheel->Horizon);
+            CHECK(timingWheelSlotOf(node->Tick, level) == slot);
+            CHECK(timingWheelSameWindow(node->Tick, timingWheel->Horizon, level));
+            CHECK((level == 0) ||
+                  (!timingWheelSameWindow(node->Tick, timingWheel->Horizon, level - 1)));
+            elements++;
+         }
+      }
+   }
+   for(listNode = timingWheel->Overflow.Node.Next;
+       listNode != &timingWheel->Overflow.Node;
+       listNode = listNode->Next) {
+      node = (const struct TimingWheelNode*)listNode;
+      CHECK(node->Location == TIMINGWHEEL_OVERFLOW);
+      CHECK(!timingWheelSameWindow(node->Tick, timingWheel->Horizon, TIMINGWHEEL_LEVELS - 1));
+      elements++;
+   }
+   CHECK(elements == timingWheel->Elements);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
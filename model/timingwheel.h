@@ -0,0 +1,117 @@
+/* --------------------------------------------------------------------------
+ *
+ *              //===//   //=====   //===//   //=====  //   //      //
+ *             //    //  //        //    //  //       //   //=/  /=//
+ *            //===//   //=====   //===//   //====   //   //  //  //
+ *           //   \\         //  //             //  //   //  //  //
+ *          //     \\  =====//  //        =====//  //   //      //  Version V
+ *
+ * ------------- An Open Source RSerPool Simulation for OMNeT++ -------------
+ *
+ * Copyright (C) 2003-2026 by Thomas Dreibholz
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: thomas.dreibholz@gmail.com
+ */
+
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "doublelinkedringlist.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+   Hierarchical timing wheel for timers which are not yet due. Time stamps
+   are mapped to ticks of Granularity time units; each level has
+   TIMINGWHEEL_SLOTS slots covering TIMINGWHEEL_SLOTS times the range of
+   a slot of the level below. Timers beyond the top level are kept in an
+   overflow list. Insert and remove are O(1); timingWheelAdvance() moves
+   all timers of the next tick into a given list and advances the horizon
+   behind this tick, timingWheelAdvanceExpired() does so for all ticks
+   up to a given time stamp. Timers before the horizon are not accepted by the
+   wheel; they have to be kept in a sorted storage by the caller.
+*/
+#define TIMINGWHEEL_LEVELS              4
+#define TIMINGWHEEL_SLOTBITS            6
+#define TIMINGWHEEL_SLOTS               (1 << TIMINGWHEEL_SLOTBITS)
+#define TIMINGWHEEL_DEFAULT_GRANULARITY 1000   /* 1ms for microsecond time stamps */
+
+#define TIMINGWHEEL_NOT_LINKED          0
+#define TIMINGWHEEL_OVERFLOW            1
+#define TIMINGWHEEL_FIRST_SLOT          2
+
+
+struct TimingWheelNode
+{
+   struct DoubleLinkedRingListNode ListNode;
+   unsigned long long              Tick;
+   unsigned int                    Location;   /* TIMINGWHEEL_FIRST_SLOT + level * TIMINGWHEEL_SLOTS + slot */
+};
+
+struct TimingWheel
+{
+   struct DoubleLinkedRingList Slot[TIMINGWHEEL_LEVELS][TIMINGWHEEL_SLOTS];
+   struct DoubleLinkedRingList Overflow;
+   uint64_t                    Occupied[TIMINGWHEEL_LEVELS];   /* Bit i <=> Slot[level][i] is not empty */
+   unsigned long long          Granularity;
+   unsigned long long          Horizon;                        /* First tick accepted by the wheel      */
+   size_t                      Elements;
+};
+
+
+void timingWheelNodeNew(struct TimingWheelNode* node);
+void timingWheelNodeDelete(struct TimingWheelNode* node);
+int timingWheelNodeIsLinked(const struct TimingWheelNode* node);
+
+void timingWheelNew(struct TimingWheel*      timingWheel,
+                    const unsigned long long granularity);
+void timingWheelDelete(struct TimingWheel* timingWheel);
+int timingWheelAccepts(const struct TimingWheel* timingWheel,
+                       const unsigned long long  timeStamp);
+void timingWheelInsert(struct TimingWheel*      timingWheel,
+                       struct TimingWheelNode*  node,
+                       const unsigned long long timeStamp);
+void timingWheelRemove(struct TimingWheel*     timingWheel,
+                       struct TimingWheelNode* node);
+size_t timingWheelAdvance(struct TimingWheel*          timingWheel,
+                          struct DoubleLinkedRingList* dueList);
+size_t timingWheelAdvanceExpired(struct TimingWheel*          timingWheel,
+                                 struct DoubleLinkedRingList* dueList,
+                                 const unsigned long long     timeStamp);
+void timingWheelVerify(const struct TimingWheel* timingWheel);
+
+inline static size_t timingWheelGetElements(const struct TimingWheel* timingWheel)
+{
+   return(timingWheel->Elements);
+}
+
+inline static int timingWheelIsEmpty(const struct TimingWheel* timingWheel)
+{
+   return(timingWheel->Elements == 0);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -117,9 +117,13 @@ struct TP_DEFINITION(TreapNode)* TP_FUNCTION(TreapGetNearestNext)(
                                     const struct TP_DEFINITION(Treap)*     treap,
                                     const struct TP_DEFINITION(TreapNode)* cmpNode);
 size_t TP_FUNCTION(TreapGetElements)(const struct TP_DEFINITION(Treap)* treap);
+size_t TP_FUNCTION(TreapGetMemoryUsage)(const struct TP_DEFINITION(Treap)* treap);
 struct TP_DEFINITION(TreapNode)* TP_FUNCTION(TreapInsert)(
                                     struct TP_DEFINITION(Treap)*     treap,
                                     struct TP_DEFINITION(TreapNode)* node);
+void TP_FUNCTION(TreapBuild)(struct TP_DEFINITION(Treap)*      treap,
+                             struct TP_DEFINITION(TreapNode)** nodeArray,
+                             const size_t                      nodes);
 struct TP_DEFINITION(TreapNode)* TP_FUNCTION(TreapRemove)(
                                     struct TP_DEFINITION(Treap)*     treap,
                                     struct TP_DEFINITION(TreapNode)* node);
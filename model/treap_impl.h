@@ -433,6 +433,15 @@ size_t TP_FUNCTION(TreapGetElements)(
 }
 
 
+/* ###### Get number of bytes allocated besides the nodes ################# */
+/* The treap only links the nodes embedded into the elements. */
+size_t TP_FUNCTION(TreapGetMemoryUsage)(
+          const struct TP_DEFINITION(Treap)* treap)
+{
+   return(0);
+}
+
+
 /* ###### Get prev node by walking through the tree (does *not* use list!) */
 static struct TP_DEFINITION(TreapNode)* TP_FUNCTION(TreapInternalFindPrev)(
                                            const struct TP_DEFINITION(Treap)*     treap,
@@ -705,13 +714,87 @@ struct TP_DEFINITION(TreapNode)* TP_FUNCTION(TreapInsert)(
 #ifdef DEBUG
    TP_FUNCTION(TreapPrint)(treap, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
    TP_FUNCTION(TreapVerify)(treap);
 #endif
    return(node);
 }
 
 
+/* ###### Build treap from sorted node array ############################ */
+/*
+   nodeArray has to be sorted by the comparison function, without
+   duplicates. It has to contain all nodes currently in the treap.
+   Nodes already linked keep their priority. The treap is constructed
+   as Cartesian tree in linear time, using the right spine as stack.
+*/
+void TP_FUNCTION(TreapBuild)(struct TP_DEFINITION(Treap)*      treap,
+                             struct TP_DEFINITION(TreapNode)** nodeArray,
+                             const size_t                      nodes)
+{
+   struct TP_DEFINITION(TreapNode)* node;
+   struct TP_DEFINITION(TreapNode)* last;
+   struct TP_DEFINITION(TreapNode)* parent;
+   struct TP_DEFINITION(TreapNode)* popped;
+   size_t                           i;
+
+#ifdef USE_LEAFLINKED
+   doubleLinkedRingListNew(&treap->List);
+#endif
+   treap->Root = NULL;
+   last        = NULL;
+   for(i = 0;i < nodes;i++) {
+      node = nodeArray[i];
+      if(node->Priority == 0) {
+         node->Priority = 1 + (random32() % 0xffffffff);
+         /* Note: Priority may never be 0 -> necessary for TP_FUNCTION(IsLinked)! */
+      }
+      node->LeftSubtree  = NULL;
+      node->RightSubtree = NULL;
+
+      /* ====== Pop spine nodes with higher priority ====================== */
+      parent = last;
+      popped = NULL;
+      while((parent != NULL) && (parent->Priority > node->Priority)) {
+         TP_FUNCTION(TreapUpdateValueSum)(treap, parent);
+         popped = parent;
+         parent = parent->Parent;
+      }
+
+      /* ====== Link node into right spine ================================ */
+      node->LeftSubtree = popped;
+      if(popped != NULL) {
+         popped->Parent = node;
+      }
+      node->Parent = parent;
+      if(parent != NULL) {
+         parent->RightSubtree = node;
+      }
+      else {
+         treap->Root = node;
+      }
+      last = node;
+#ifdef USE_LEAFLINKED
+      doubleLinkedRingListAddTail(&treap->List, &node->ListNode);
+#endif
+   }
+
+   /* ====== Update value sums of remaining spine ======================== */
+   while(last != NULL) {
+      TP_FUNCTION(TreapUpdateValueSum)(treap, last);
+      last = last->Parent;
+   }
+   treap->Elements = nodes;
+
+#ifdef DEBUG
+   TP_FUNCTION(TreapPrint)(treap, stdout);
+#endif
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
+   TP_FUNCTION(TreapVerify)(treap);
+#endif
+}
+
+
 /* ###### Remove ######################################################### */
 struct TP_DEFINITION(TreapNode)* TP_FUNCTION(TreapRemove)(
                                     struct TP_DEFINITION(Treap)*     treap,
@@ -775,7 +858,7 @@ struct TP_DEFINITION(TreapNode)* TP_FUNCTION(TreapRemove)(
 printf("=> output-rem: t=%p   %p\n",treap,treap->Root);
     TP_FUNCTION(TreapPrint)(treap, stdout);
 #endif
-#ifdef VERIFY
+#if defined(VERIFY) && !defined(VERIFY_BUDGET)
     TP_FUNCTION(TreapVerify)(treap);
 #endif
    return(node);